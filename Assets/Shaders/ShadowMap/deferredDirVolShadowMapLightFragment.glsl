@@ -2,21 +2,26 @@
 
 layout(location = 0) out vec3 out_color;
 
+layout (std140) uniform ViewBlock
+{
+	mat4 viewMatrix;
+	mat4 projectionMatrix;
+	mat4 viewProjectionMatrix;
+	mat4 inverseViewProjectionMatrix;
+	vec3 cameraPosition;
+};
+
 uniform sampler2D gPositionMap;
 uniform sampler2D gNormalMap;
 uniform sampler2D gDiffuseMap;
 uniform sampler2D gSpecularMap;
 
 uniform mat4 modelMatrix;
-uniform mat4 viewMatrix;
 uniform mat4 modelViewMatrix;
-uniform mat4 viewProjectionMatrix;
 uniform mat4 modelViewProjectionMatrix;
 uniform mat3 normalMatrix;
 uniform mat3 normalWorldMatrix;
 
-uniform vec3 cameraPosition;
-
 uniform vec3 sceneAmbient;
 
 uniform vec3 lightPosition;
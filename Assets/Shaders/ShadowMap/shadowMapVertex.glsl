@@ -1,19 +1,56 @@
-#version 330 core
+#version 430 core
 
 layout(location = 0) in vec3 in_position;
 layout(location = 1) in vec3 in_normal;
 layout(location = 2) in vec2 in_texcoord;
+layout(location = 7) in uint in_drawID;
 
-uniform mat4 modelMatrix;
-uniform mat4 viewMatrix;
-uniform mat4 modelViewMatrix;
-uniform mat4 modelViewProjectionMatrix;
-uniform mat3 normalMatrix;
-uniform mat3 normalWorldMatrix;
+layout (std140) uniform ViewBlock
+{
+	mat4 viewMatrix;
+	mat4 projectionMatrix;
+	mat4 viewProjectionMatrix;
+	mat4 inverseViewProjectionMatrix;
+	vec3 cameraPosition;
+};
+
+/*
+ * Object matrices, one entry per draw of a multi draw and one entry per
+ * object for the other draws
+*/
+
+struct DrawData
+{
+	mat4 modelMatrix;
+	mat4 normalMatrix;
+};
+
+layout (std430, binding = 0) readonly buffer DrawDataBlock
+{
+	DrawData drawsData [];
+};
+
+layout (std430, binding = 1) readonly buffer ObjectDataBlock
+{
+	DrawData objectsData [];
+};
+
+uniform int indirectDraw;
+uniform int objectIndex;
 
 out vec3 vert_position;
 
+DrawData GetDrawData ()
+{
+	return indirectDraw == 1 ? drawsData [in_drawID] : objectsData [objectIndex];
+}
+
+mat4 GetModelViewProjectionMatrix ()
+{
+	return viewProjectionMatrix * GetDrawData ().modelMatrix;
+}
+
 void main()
 {
-	gl_Position =  modelViewProjectionMatrix * vec4 (in_position, 1);
+	gl_Position =  GetModelViewProjectionMatrix () * vec4 (in_position, 1);
 }
@@ -2,21 +2,26 @@
 
 layout(location = 0) out vec3 out_color;
 
+layout (std140) uniform ViewBlock
+{
+	mat4 viewMatrix;
+	mat4 projectionMatrix;
+	mat4 viewProjectionMatrix;
+	mat4 inverseViewProjectionMatrix;
+	vec3 cameraPosition;
+};
+
 uniform sampler2D gPositionMap;
 uniform sampler2D gNormalMap;
 uniform sampler2D gDiffuseMap;
 uniform sampler2D gSpecularMap;
 
 uniform mat4 modelMatrix;
-uniform mat4 viewMatrix;
 uniform mat4 modelViewMatrix;
-uniform mat4 viewProjectionMatrix;
 uniform mat4 modelViewProjectionMatrix;
 uniform mat3 normalMatrix;
 uniform mat3 normalWorldMatrix;
 
-uniform vec3 cameraPosition;
-
 uniform vec3 sceneAmbient;
 
 uniform vec3 lightPosition;
@@ -35,14 +40,23 @@ uniform mat4 lightSpaceMatrices[CASCADED_SHADOW_MAP_LEVELS];
 
 uniform float clipZLevels[CASCADED_SHADOW_MAP_LEVELS];
 
-uniform sampler3D volumeTexture;
-
-const float VOXEL_MIPMAP_COUNT = 6;
-
-uniform vec3 minVertex;
-uniform vec3 maxVertex;
 uniform ivec3 volumeSize;
 uniform int volumeMipmapLevel;
+uniform int volumeMipmapLevels;
+
+/*
+ * Cascades of the voxel clipmap, from the finest one. Without clipmap
+ * the volume fitted to the scene is the only cascade.
+*/
+
+const int VOXEL_CLIPMAP_MAX_CASCADES = 4;
+
+uniform int volumeCascades;
+
+uniform sampler3D cascadeTextures[VOXEL_CLIPMAP_MAX_CASCADES];
+uniform vec3 cascadeMinVertices[VOXEL_CLIPMAP_MAX_CASCADES];
+uniform vec3 cascadeMaxVertices[VOXEL_CLIPMAP_MAX_CASCADES];
+uniform ivec3 cascadeOrigins[VOXEL_CLIPMAP_MAX_CASCADES];
 
 vec2 CalcTexCoord()
 {
@@ -114,24 +128,78 @@ float CalcShadowContribution (vec3 in_position)
 	return shadow;
 }
 
-float GetInterpolatedComp (float comp, float minValue, float maxValue)
+/*
+ * Extent of a cascade and the side of its voxels, in world units
+*/
+
+float GetCascadeExtent (int cascade)
+{
+	return cascadeMaxVertices [cascade].x - cascadeMinVertices [cascade].x;
+}
+
+float GetCascadeVoxelSize (int cascade)
 {
-	return ((comp - minValue) / (maxValue - minValue));
+	return GetCascadeExtent (cascade) / volumeSize.x;
 }
 
-vec3 GetPositionInVolume (vec3 origin)
+/*
+ * Finest cascade that holds a sample of the given diameter. Only the
+ * last cascade may be sampled up to its bounds, or past its mipmaps.
+ * Returns -1 when the sample is out of every cascade.
+*/
+
+int GetCascade (vec3 position, float diameter)
 {
-	vec3 positionInVolume;
+	for (int cascade = 0; cascade < VOXEL_CLIPMAP_MAX_CASCADES; cascade++) {
+		if (cascade + 1 >= volumeCascades) {
+			bool isInside = all (greaterThanEqual (position, cascadeMinVertices [cascade]))
+				&& all (lessThanEqual (position, cascadeMaxVertices [cascade]));
 
-	positionInVolume.x = GetInterpolatedComp (origin.x, minVertex.x, maxVertex.x);
-	positionInVolume.y = GetInterpolatedComp (origin.y, minVertex.y, maxVertex.y);
-	positionInVolume.z = GetInterpolatedComp (origin.z, minVertex.z, maxVertex.z);
+			return isInside ? cascade : -1;
+		}
 
-	return positionInVolume + vec3 (1.0 / volumeSize.x);
+		bool isInside = all (greaterThanEqual (position - vec3 (diameter), cascadeMinVertices [cascade]))
+			&& all (lessThanEqual (position + vec3 (diameter), cascadeMaxVertices [cascade]));
+
+		float maxDiameter = GetCascadeVoxelSize (cascade) * exp2 (volumeMipmapLevels - 1.0);
+
+		if (isInside && diameter <= maxDiameter) {
+			return cascade;
+		}
+	}
+
+	return -1;
 }
 
-float minVoxelDiameter = 1.0 / volumeSize.x;
-float minVoxelDiameterInv = volumeSize.x;
+/*
+ * The texture of a cascade starts at the texel of its origin and wraps
+ * around, the texture of the scene volume has its origin at zero
+*/
+
+vec4 SampleCascade (int cascade, vec3 position, float diameter)
+{
+	vec3 positionInVolume = (position - cascadeMinVertices [cascade]) / GetCascadeExtent (cascade);
+
+	vec3 texCoords = positionInVolume + (vec3 (cascadeOrigins [cascade]) + vec3 (1.0)) / vec3 (volumeSize);
+
+	// convert diameter to LOD
+	// for example:
+	// log2(1/256 * 256) = 0
+	// log2(1/128 * 256) = 1
+	// log2(1/64 * 256) = 2
+	float sampleLOD = min (log2 (diameter / GetCascadeVoxelSize (cascade)), volumeMipmapLevels - 1.0);
+
+	// samplers of an array are indexed by constants only
+	if (cascade == 0) {
+		return textureLod (cascadeTextures [0], texCoords, sampleLOD);
+	} else if (cascade == 1) {
+		return textureLod (cascadeTextures [1], texCoords, sampleLOD);
+	} else if (cascade == 2) {
+		return textureLod (cascadeTextures [2], texCoords, sampleLOD);
+	}
+
+	return textureLod (cascadeTextures [3], texCoords, sampleLOD);
+}
 
 /*
  * Calculate  a vector that is orthogonal to u.
@@ -146,17 +214,16 @@ vec3 Orthogonal(vec3 u)
 	return abs(dot(u, v)) > 0.99 ? cross(u, vec3(0, 0, 1)) : cross(u, v);
 }
 
-// origin, dir, and maxDist are in texture space
+// origin, dir, and maxDist are in world space
 // dir should be normalized
 // coneRatio is the cone diameter to height ratio (2.0 for 90-degree cone)
 vec4 voxelTraceCone(vec3 origin, vec3 dir, float coneRatio, float maxDist)
 {
-	vec3 samplePos = origin;
 	vec3 accum = vec3(0.0);
 	float alpha = 0.0;
 
-	// the starting sample diameter
-	float minDiameter = minVoxelDiameter;
+	// the starting sample diameter, a voxel of the finest cascade
+	float minDiameter = GetCascadeVoxelSize (0);
 
 	// push out the starting point to avoid self-intersection
 	float startDist = minDiameter * 10;
@@ -170,16 +237,16 @@ vec4 voxelTraceCone(vec3 origin, vec3 dir, float coneRatio, float maxDist)
 		// cones - otherwise lots of overlapped samples)
 		float sampleDiameter = max(minDiameter, coneRatio * dist);
 		
-		// convert diameter to LOD
-		// for example:
-		// log2(1/256 * 256) = 0
-		// log2(1/128 * 256) = 1
-		// log2(1/64 * 256) = 2
-		float sampleLOD = log2(sampleDiameter * minVoxelDiameterInv);
-		
 		vec3 samplePos = origin + dir * dist;
+
+		// farther samples are taken from coarser cascades
+		int cascade = GetCascade (samplePos, sampleDiameter);
+
+		if (cascade < 0) {
+			break;
+		}
 		
-		vec4 sampleValue = textureLod (volumeTexture, samplePos, min (sampleLOD, VOXEL_MIPMAP_COUNT - 1.0));
+		vec4 sampleValue = SampleCascade (cascade, samplePos, sampleDiameter);
 		
 		accum = accum + (1.0 - alpha) * sampleValue.a * sampleValue.rgb;
 		alpha = alpha + (1.0 - alpha) * sampleValue.a;
@@ -196,24 +263,23 @@ vec4 voxelTraceCone(vec3 origin, vec3 dir, float coneRatio, float maxDist)
 // Calculates indirect diffuse light using voxel cone tracing.
 vec3 CalcIndirectDiffuseLight(vec3 in_position, vec3 in_normal)
 {
-	vec3 voxelPos = GetPositionInVolume (in_position);
-
 	vec3 tangent = normalize(Orthogonal(in_normal));
 	vec3 bitangent = normalize(cross(tangent, in_normal));
 
 	vec3 iblDiffuse = vec3(0.0);
 
+	// distances are fractions of the finest cascade
 	float iblConeRatio = 1;
-	float iblMaxDist = .3;
+	float iblMaxDist = .3 * GetCascadeExtent (0);
 
 	// this sample gets full weight (dot(normal, normal) == 1)
-	iblDiffuse += voxelTraceCone(voxelPos, in_normal, iblConeRatio, iblMaxDist).xyz;
+	iblDiffuse += voxelTraceCone(in_position, in_normal, iblConeRatio, iblMaxDist).xyz;
 
 	// these samples get partial weight
-	iblDiffuse += .707 * voxelTraceCone(voxelPos, normalize(in_normal + tangent), iblConeRatio, iblMaxDist).xyz;
-	iblDiffuse += .707 * voxelTraceCone(voxelPos, normalize(in_normal - tangent), iblConeRatio, iblMaxDist).xyz;
-	iblDiffuse += .707 * voxelTraceCone(voxelPos, normalize(in_normal + bitangent), iblConeRatio, iblMaxDist).xyz;
-	iblDiffuse += .707 * voxelTraceCone(voxelPos, normalize(in_normal - bitangent), iblConeRatio, iblMaxDist).xyz;
+	iblDiffuse += .707 * voxelTraceCone(in_position, normalize(in_normal + tangent), iblConeRatio, iblMaxDist).xyz;
+	iblDiffuse += .707 * voxelTraceCone(in_position, normalize(in_normal - tangent), iblConeRatio, iblMaxDist).xyz;
+	iblDiffuse += .707 * voxelTraceCone(in_position, normalize(in_normal + bitangent), iblConeRatio, iblMaxDist).xyz;
+	iblDiffuse += .707 * voxelTraceCone(in_position, normalize(in_normal - bitangent), iblConeRatio, iblMaxDist).xyz;
 
 	// Return result.
 	return iblDiffuse;
@@ -227,10 +293,9 @@ vec3 CalcIndirectSpecularLight (vec3 in_position, vec3 in_normal)
 	vec3 eyeToFragment = normalize (in_position - cameraPosition);
 	vec3 reflectionDir = reflect (eyeToFragment, in_normal);
 		
-	vec3 reflectTraceOrigin = GetPositionInVolume (in_position);
 	float coneRatio = .2;
-	float maxDist = .3;
-	specularLight = voxelTraceCone (reflectTraceOrigin, reflectionDir, coneRatio, maxDist).xyz;
+	float maxDist = .3 * GetCascadeExtent (0);
+	specularLight = voxelTraceCone (in_position, reflectionDir, coneRatio, maxDist).xyz;
 
 	return specularLight;
 }
@@ -251,12 +316,11 @@ vec3 CalcDirectDiffuseLight (vec3 in_position, vec3 in_normal, vec3 in_diffuse)
 
 float voxelTraceConeOcclusion(vec3 origin, vec3 dir, float coneRatio, float maxDist)
 {
-	vec3 samplePos = origin;
 	float occlusion = 0.0;
 	float alpha = 0.0;
 
 	// the starting sample diameter
-	float minDiameter = minVoxelDiameter;
+	float minDiameter = GetCascadeVoxelSize (0);
 
 	// push out the starting point to avoid self-intersection
 	float startDist = minDiameter * 1.5;
@@ -266,13 +330,17 @@ float voxelTraceConeOcclusion(vec3 origin, vec3 dir, float coneRatio, float maxD
 	{
 		float sampleDiameter = max(minDiameter, coneRatio * dist);
 		
-		float sampleLOD = log2(sampleDiameter * minVoxelDiameterInv);
-		
 		vec3 samplePos = origin + dir * dist;
+
+		int cascade = GetCascade (samplePos, sampleDiameter);
+
+		if (cascade < 0) {
+			break;
+		}
 		
-		vec4 sampleValue = textureLod (volumeTexture, samplePos, min (sampleLOD, VOXEL_MIPMAP_COUNT - 1.0));
+		vec4 sampleValue = SampleCascade (cascade, samplePos, sampleDiameter);
 
-		occlusion += ((1.0 - alpha) * sampleValue.a) / (1.0 + 0.03 * sampleDiameter);
+		occlusion += ((1.0 - alpha) * sampleValue.a) / (1.0 + 0.03 * sampleDiameter / GetCascadeExtent (0));
 
 		alpha = alpha + (1.0 - alpha) * sampleValue.a;
 
@@ -284,24 +352,22 @@ float voxelTraceConeOcclusion(vec3 origin, vec3 dir, float coneRatio, float maxD
 
 float CalcOcclusion (vec3 in_position, vec3 in_normal)
 {
-	vec3 voxelPos = GetPositionInVolume (in_position);
-
 	vec3 tangent = normalize(Orthogonal(in_normal));
 	vec3 bitangent = normalize(cross(in_normal, tangent));
 
 	float occlusion = 0.0;
 
 	float iblConeRatio = 0.2;
-	float iblMaxDist = .04;
+	float iblMaxDist = .04 * GetCascadeExtent (0);
 
 	// this sample gets full weight (dot(normal, normal) == 1)
-	occlusion += 1.0 - voxelTraceConeOcclusion(voxelPos, in_normal, iblConeRatio, iblMaxDist);
+	occlusion += 1.0 - voxelTraceConeOcclusion(in_position, in_normal, iblConeRatio, iblMaxDist);
 
 	// these samples get partial weight
-	occlusion += 0.55 * (1.0 - voxelTraceConeOcclusion(voxelPos, normalize(in_normal + tangent), iblConeRatio, iblMaxDist));
-	occlusion += 0.55 * (1.0 - voxelTraceConeOcclusion(voxelPos, normalize(in_normal - tangent), iblConeRatio, iblMaxDist));
-	occlusion += 0.55 * (1.0 - voxelTraceConeOcclusion(voxelPos, normalize(in_normal + bitangent), iblConeRatio, iblMaxDist));
-	occlusion += 0.55 * (1.0 - voxelTraceConeOcclusion(voxelPos, normalize(in_normal - bitangent), iblConeRatio, iblMaxDist));
+	occlusion += 0.55 * (1.0 - voxelTraceConeOcclusion(in_position, normalize(in_normal + tangent), iblConeRatio, iblMaxDist));
+	occlusion += 0.55 * (1.0 - voxelTraceConeOcclusion(in_position, normalize(in_normal - tangent), iblConeRatio, iblMaxDist));
+	occlusion += 0.55 * (1.0 - voxelTraceConeOcclusion(in_position, normalize(in_normal + bitangent), iblConeRatio, iblMaxDist));
+	occlusion += 0.55 * (1.0 - voxelTraceConeOcclusion(in_position, normalize(in_normal - bitangent), iblConeRatio, iblMaxDist));
 
 	// Return result.
 	return occlusion / 3.2;
@@ -3,6 +3,8 @@ layout (local_size_x = 4, local_size_y = 4, local_size_z = 4) in;
 
 uniform int SrcMipLevel;
 uniform int DstMipRes;
+uniform ivec3 DstOffset;
+uniform ivec3 DstSize;
 
 uniform ivec3 volumeSize;
 uniform sampler3D volumeTexture;
@@ -11,11 +13,11 @@ layout(binding = 0, rgba8) uniform writeonly image3D dstImageMip;
 
 void main() 
 {
-	if (gl_GlobalInvocationID.x < DstMipRes
-		&& gl_GlobalInvocationID.y < DstMipRes
-		&& gl_GlobalInvocationID.z < DstMipRes) {
+	ivec3 dstPos = DstOffset + ivec3(gl_GlobalInvocationID);
+
+	if (all (lessThan (ivec3(gl_GlobalInvocationID), DstSize))
+		&& all (lessThan (dstPos, ivec3(DstMipRes)))) {
 
-		ivec3 dstPos = ivec3(gl_GlobalInvocationID);
   
 		vec4 voxelColor = texelFetch (volumeTexture, dstPos, SrcMipLevel);
 
@@ -11,6 +11,8 @@ layout (local_size_x = 4, local_size_y = 4, local_size_z = 4) in;
 
 uniform int SrcMipLevel;
 uniform int DstMipRes;
+uniform ivec3 DstOffset;
+uniform ivec3 DstSize;
 
 uniform sampler3D volumeTexture;
 
@@ -29,11 +31,11 @@ vec4[8] fetchTexels(ivec3 pos) {
 
 void main() 
 {
-	if (gl_GlobalInvocationID.x < DstMipRes
-		&& gl_GlobalInvocationID.y < DstMipRes
-		&& gl_GlobalInvocationID.z < DstMipRes) {
+	ivec3 dstPos = DstOffset + ivec3(gl_GlobalInvocationID);
+
+	if (all (lessThan (ivec3(gl_GlobalInvocationID), DstSize))
+		&& all (lessThan (dstPos, ivec3(DstMipRes)))) {
 
-		ivec3 dstPos = ivec3(gl_GlobalInvocationID);
 		ivec3 srcPos = dstPos * 2;
   
 		vec4 values[8] = fetchTexels(srcPos);
@@ -9,6 +9,14 @@ uniform sampler3D volumeTexture;
 uniform vec3 minVertex;
 uniform vec3 maxVertex;
 uniform ivec3 volumeSize;
+uniform ivec3 volumeOrigin;
+
+/*
+ * Part of the volume to process
+*/
+
+uniform ivec3 DstOffset;
+uniform ivec3 DstSize;
 
 /*
  * Input shadow map volume and light space properties
@@ -84,15 +92,10 @@ bool IsInShadow (vec3 worldPos)
 
 void main() 
 {
-	if (gl_GlobalInvocationID.x < volumeSize.x
-		&& gl_GlobalInvocationID.y < volumeSize.y
-		&& gl_GlobalInvocationID.z < volumeSize.z) {
+	ivec3 voxelPos = DstOffset + ivec3(gl_GlobalInvocationID);
 
-		/*
-		 * Get voxel position in 3D texture
-		*/
-
-		ivec3 voxelPos = ivec3(gl_GlobalInvocationID);
+	if (all (lessThan (ivec3(gl_GlobalInvocationID), DstSize))
+		&& all (lessThan (voxelPos, volumeSize))) {
 
 		/*
 		 * Extract voxel color
@@ -105,10 +108,13 @@ void main()
 		}
 
 		/*
-		 * Compute voxel position in world space
+		 * Compute voxel position in world space, the texels of a cascade
+		 * start at its origin
 		*/
 
-		vec3 voxelWorldPos = GetVoxelPosInWorld (vec3 (voxelPos));
+		ivec3 windowPos = (voxelPos - volumeOrigin + volumeSize) % volumeSize;
+
+		vec3 voxelWorldPos = GetVoxelPosInWorld (vec3 (windowPos));
 		
 		/*
 		 * Do nothing is the voxel is not in the shadow
@@ -2,7 +2,14 @@
 
 in vec2 geom_RayCoordinates;
 
-uniform vec3 cameraPosition;
+layout (std140) uniform ViewBlock
+{
+	mat4 viewMatrix;
+	mat4 projectionMatrix;
+	mat4 viewProjectionMatrix;
+	mat4 inverseViewProjectionMatrix;
+	vec3 cameraPosition;
+};
 
 uniform sampler3D volumeTexture;
 
@@ -10,10 +17,9 @@ uniform vec3 minVertex;
 uniform vec3 maxVertex;
 uniform ivec3 volumeSize;
 uniform int volumeMipmapLevel;
+uniform ivec3 volumeOrigin;
 
 
-uniform mat4 inverseViewProjectionMatrix;
-
 layout(location = 0) out vec4 outputColor;
 
 vec3 RayBoundingBoxTest(vec3 rayOrigin, vec3 rayDir, vec3 vertexMin, vec3 vertexMax)
@@ -133,7 +139,7 @@ void main ()
 	while (all(greaterThanEqual(voxelPos, vec3(0.0))) && all(lessThan(voxelPos, mipmapVolumeSize)))
 	{
 		// Sample 3D texture at current position.
-		vec3 texCoords = voxelPos / mipmapVolumeSize;
+		vec3 texCoords = (voxelPos + vec3 (volumeOrigin >> volumeMipmapLevel)) / mipmapVolumeSize;
 		vec4 color = textureLod (volumeTexture, texCoords, volumeMipmapLevel);
 
 
@@ -1,17 +1,41 @@
-#version 420 core
+#version 430 core
+
+layout (std140) uniform ViewBlock
+{
+	mat4 viewMatrix;
+	mat4 projectionMatrix;
+	mat4 viewProjectionMatrix;
+	mat4 inverseViewProjectionMatrix;
+	vec3 cameraPosition;
+};
 
 uniform layout (binding = 0, r32ui) coherent volatile uimage3D volumeTexture;
 
 layout (location = 0) out vec4 fragColor;
 
 uniform mat4 modelMatrix;
-uniform mat4 viewMatrix;
 uniform mat4 modelViewMatrix;
 uniform mat4 modelViewProjectionMatrix;
 uniform mat3 normalMatrix;
 uniform mat3 normalWorldMatrix;
 
-uniform vec3 MaterialDiffuse;
+/*
+ * Materials of the scene, one entry per material identifier. The
+ * shininess is the last component of the specular color.
+*/
+
+struct MaterialData
+{
+	vec4 diffuseColor;
+	vec4 specularColor;
+};
+
+layout (std430, binding = 2) readonly buffer MaterialBlock
+{
+	MaterialData materialsData [];
+};
+
+uniform int materialIndex;
 
 uniform sampler2D DiffuseMap;
 
@@ -22,6 +46,19 @@ uniform vec3 maxPosition;
 
 uniform ivec3 volumeSize;
 
+/*
+ * Texel of the first voxel of the window of a cascade
+*/
+
+uniform ivec3 volumeOrigin;
+
+/*
+ * Voxels outside this box are kept from previous frames
+*/
+
+uniform ivec3 UpdateMin;
+uniform ivec3 UpdateMax;
+
 in vec3 geom_worldPosition;
 in vec3 geom_worldNormal;
 in vec2 geom_texcoord;
@@ -76,7 +113,7 @@ void main()
 	 * Get color of all used texture maps
 	*/
 
-	vec3 diffuseMap = MaterialDiffuse * vec3 (texture2D (DiffuseMap, geom_texcoord.xy));
+	vec3 diffuseMap = materialsData [materialIndex].diffuseColor.rgb * vec3 (texture2D (DiffuseMap, geom_texcoord.xy));
 
 	vec3 fragmentColor = diffuseMap;
 
@@ -86,9 +123,23 @@ void main()
 	
 	vec3 coords = geom_swizzleMatrixInv * vec3(gl_FragCoord.xy, gl_FragCoord.z * volumeSize.z);
 
+	if (any (lessThan (coords, vec3 (0.0))) || any (greaterThanEqual (ivec3 (coords), volumeSize))) {
+		discard;
+	}
+
+	/*
+	 * Voxels of a cascade wrap around the texture
+	*/
+
+	ivec3 texelCoords = (ivec3 (coords) + volumeOrigin) % volumeSize;
+
+	if (any (lessThan (texelCoords, UpdateMin)) || any (greaterThanEqual (texelCoords, UpdateMax))) {
+		discard;
+	}
+
 	/*
 	 * Save in texture
 	*/
 
-	ImageAtomicAverageRGBA8 (volumeTexture, ivec3 (coords), fragmentColor);
+	ImageAtomicAverageRGBA8 (volumeTexture, texelCoords, fragmentColor);
 }
\ No newline at end of file
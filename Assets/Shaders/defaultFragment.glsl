@@ -2,8 +2,16 @@
 
 layout(location = 0) out vec4 out_color;
 
+layout (std140) uniform ViewBlock
+{
+	mat4 viewMatrix;
+	mat4 projectionMatrix;
+	mat4 viewProjectionMatrix;
+	mat4 inverseViewProjectionMatrix;
+	vec3 cameraPosition;
+};
+
 uniform mat4 modelMatrix;
-uniform mat4 viewMatrix;
 uniform mat4 modelViewMatrix;
 uniform mat4 modelViewProjectionMatrix;
 uniform mat3 normalMatrix;
@@ -20,8 +28,6 @@ uniform sampler2D DiffuseMap;
 uniform sampler2D SpecularMap;
 uniform sampler2D AlphaMap;
 
-uniform vec3 cameraPosition;
-
 struct LightSource
 {
   vec4 position;
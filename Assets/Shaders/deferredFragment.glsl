@@ -1,28 +1,47 @@
-#version 330 core
+#version 430 core
 
 layout (location = 0) out vec4 out_position;
 layout (location = 1) out vec4 out_normal;
 layout (location = 2) out vec4 out_diffuse;
 layout (location = 3) out vec4 out_specular;
 
+layout (std140) uniform ViewBlock
+{
+	mat4 viewMatrix;
+	mat4 projectionMatrix;
+	mat4 viewProjectionMatrix;
+	mat4 inverseViewProjectionMatrix;
+	vec3 cameraPosition;
+};
+
 uniform mat4 modelMatrix;
-uniform mat4 viewMatrix;
 uniform mat4 modelViewMatrix;
 uniform mat4 modelViewProjectionMatrix;
 uniform mat3 normalMatrix;
 uniform mat3 normalWorldMatrix;
 
-uniform vec3 MaterialDiffuse;
-uniform vec3 MaterialSpecular;
+/*
+ * Materials of the scene, one entry per material identifier. The
+ * shininess is the last component of the specular color.
+*/
 
-uniform float MaterialShininess;
+struct MaterialData
+{
+	vec4 diffuseColor;
+	vec4 specularColor;
+};
+
+layout (std430, binding = 2) readonly buffer MaterialBlock
+{
+	MaterialData materialsData [];
+};
+
+uniform int materialIndex;
 
 uniform sampler2D DiffuseMap;
 uniform sampler2D SpecularMap;
 uniform sampler2D AlphaMap;
 
-uniform vec3 cameraPosition;
-
 uniform vec3 sceneAmbient;
 
 const vec3 nullInAlphaMap = vec3 (0.0);
@@ -37,8 +56,8 @@ void main()
 	 * Get color of all used texture maps
 	*/
 
-	vec3 diffuseMap = MaterialDiffuse * vec3 (texture2D (DiffuseMap, 	geom_texcoord.xy));
-	vec3 specularMap = MaterialSpecular * vec3 (texture2D (SpecularMap, geom_texcoord.xy));
+	vec3 diffuseMap = materialsData [materialIndex].diffuseColor.rgb * vec3 (texture2D (DiffuseMap, 	geom_texcoord.xy));
+	vec3 specularMap = materialsData [materialIndex].specularColor.rgb * vec3 (texture2D (SpecularMap, geom_texcoord.xy));
 	vec3 alphaMap = vec3 (texture2D (AlphaMap, geom_texcoord.xy));
 
 	/*
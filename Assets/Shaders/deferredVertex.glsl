@@ -1,34 +1,81 @@
-#version 330 core
+#version 430 core
 
 layout(location = 0) in vec3 in_position;
 layout(location = 1) in vec3 in_normal;
 layout(location = 2) in vec2 in_texcoord;
+layout(location = 7) in uint in_drawID;
 
-uniform mat4 modelMatrix;
-uniform mat4 viewMatrix;
-uniform mat4 modelViewMatrix;
-uniform mat4 modelViewProjectionMatrix;
-uniform mat3 normalMatrix;
-uniform mat3 normalWorldMatrix;
+layout (std140) uniform ViewBlock
+{
+	mat4 viewMatrix;
+	mat4 projectionMatrix;
+	mat4 viewProjectionMatrix;
+	mat4 inverseViewProjectionMatrix;
+	vec3 cameraPosition;
+};
+
+/*
+ * Object matrices, one entry per draw of a multi draw and one entry per
+ * object for the other draws
+*/
+
+struct DrawData
+{
+	mat4 modelMatrix;
+	mat4 normalMatrix;
+};
+
+layout (std430, binding = 0) readonly buffer DrawDataBlock
+{
+	DrawData drawsData [];
+};
+
+layout (std430, binding = 1) readonly buffer ObjectDataBlock
+{
+	DrawData objectsData [];
+};
+
+uniform int indirectDraw;
+uniform int objectIndex;
 
 out vec3 vert_position;
 out vec3 vert_normal;
 out vec2 vert_texcoord;
 
+DrawData GetDrawData ()
+{
+	return indirectDraw == 1 ? drawsData [in_drawID] : objectsData [objectIndex];
+}
+
+mat4 GetModelViewProjectionMatrix ()
+{
+	return viewProjectionMatrix * GetDrawData ().modelMatrix;
+}
+
+mat4 GetModelMatrix ()
+{
+	return GetDrawData ().modelMatrix;
+}
+
+mat3 GetNormalMatrix ()
+{
+	return mat3 (GetDrawData ().normalMatrix);
+}
+
 void main()
 {
 	/*
 	 * Emit position for rasterizer
 	*/
 
-	gl_Position = modelViewProjectionMatrix * vec4 (in_position, 1);
+	gl_Position = GetModelViewProjectionMatrix () * vec4 (in_position, 1);
 
 	/*
 	 * Emit position on the world
 	*/
 
-	vert_position = vec3 (modelMatrix * vec4 (in_position, 1));
-	vert_normal = normalMatrix * in_normal;
+	vert_position = vec3 (GetModelMatrix () * vec4 (in_position, 1));
+	vert_normal = GetNormalMatrix () * in_normal;
 
 	vert_texcoord = in_texcoord;
 }
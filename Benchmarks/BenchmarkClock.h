@@ -0,0 +1,33 @@
+#ifndef BENCHMARKCLOCK_H
+#define BENCHMARKCLOCK_H
+
+#include <chrono>
+#include <vector>
+#include <algorithm>
+
+/*
+ * Median of the times a function takes over a few runs, in milliseconds.
+ * The median keeps a run slowed down by the rest of the machine out.
+*/
+
+template <class Function>
+double MeasureMS (std::size_t runsCount, Function function)
+{
+	std::vector<double> times;
+
+	for (std::size_t run = 0; run < runsCount; run++) {
+		std::chrono::high_resolution_clock::time_point start = std::chrono::high_resolution_clock::now ();
+
+		function ();
+
+		std::chrono::duration<double, std::milli> duration = std::chrono::high_resolution_clock::now () - start;
+
+		times.push_back (duration.count ());
+	}
+
+	std::sort (times.begin (), times.end ());
+
+	return times [times.size () / 2];
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,184 @@
+#include <cstdio>
+#include <vector>
+#include <random>
+
+#include "Core/Intersections/BoundingVolumeHierarchy.h"
+#include "Core/Intersections/Intersection.h"
+#include "Core/Intersections/AABBVolume.h"
+
+#include "Core/Math/glm/gtc/matrix_transform.hpp"
+
+#include "BenchmarkClock.h"
+
+/*
+ * Culling of the scene objects through the bounding volume hierarchy
+ * against the loop over every object it replaced, which tested the box
+ * of each object through the intersection primitives once for every
+ * view. Random boxes over a wide world, a perspective camera and the
+ * four orthographic cascades of a directional light.
+*/
+
+#define BENCHMARK_RUNS_COUNT 5
+#define BENCHMARK_WORLD_SIZE 2000.0f
+#define BENCHMARK_CASCADES_COUNT 4
+#define BENCHMARK_REFIT_PERCENT 1
+
+static std::size_t CullLinear (const std::vector<FrustumVolume*>& frustums, const std::vector<AABBVolume*>& volumes,
+	std::vector<std::vector<std::size_t>>& visibleItems)
+{
+	std::size_t visibleCount = 0;
+
+	visibleItems.resize (frustums.size ());
+
+	for (std::size_t view = 0; view < frustums.size (); view++) {
+		visibleItems [view].clear ();
+
+		for (std::size_t item = 0; item < volumes.size (); item++) {
+			if (Intersection::Instance ()->CheckFrustumVsPrimitive (frustums [view], volumes [item])) {
+				visibleItems [view].push_back (item);
+			}
+		}
+
+		visibleCount += visibleItems [view].size ();
+	}
+
+	return visibleCount;
+}
+
+static std::size_t CountVisible (const std::vector<std::vector<std::size_t>>& visibleItems)
+{
+	std::size_t visibleCount = 0;
+
+	for (const std::vector<std::size_t>& items : visibleItems) {
+		visibleCount += items.size ();
+	}
+
+	return visibleCount;
+}
+
+int main ()
+{
+	glm::mat4 view = glm::lookAt (glm::vec3 (0.0f, 10.0f, 0.0f), glm::vec3 (1.0f, 10.0f, 0.3f), glm::vec3 (0.0f, 1.0f, 0.0f));
+
+	FrustumVolume camera (glm::perspective (glm::radians (60.0f), 16.0f / 9.0f, 0.1f, 300.0f) * view);
+
+	/*
+	 * Cascades grow away from the camera, the last one covers most of
+	 * the world
+	*/
+
+	std::vector<FrustumVolume*> cascades;
+
+	glm::mat4 lightView = glm::lookAt (glm::vec3 (0.0f), glm::vec3 (0.3f, -1.0f, 0.2f), glm::vec3 (0.0f, 1.0f, 0.0f));
+
+	for (std::size_t cascade = 0; cascade < BENCHMARK_CASCADES_COUNT; cascade++) {
+		float size = 25.0f * (float) (1 << (cascade * 2));
+
+		cascades.push_back (new FrustumVolume (glm::ortho (-size, size, -size, size, -BENCHMARK_WORLD_SIZE, BENCHMARK_WORLD_SIZE) * lightView));
+	}
+
+	std::vector<FrustumVolume*> cameraFrustums (1, &camera);
+	std::vector<FrustumVolume*> allFrustums (1, &camera);
+
+	allFrustums.insert (allFrustums.end (), cascades.begin (), cascades.end ());
+
+	std::printf ("Scene culling, milliseconds, a camera and %d cascades\n", BENCHMARK_CASCADES_COUNT);
+	std::printf ("%8s %9s %11s %11s %11s %11s %9s %8s\n", "objects", "build",
+		"camera bvh", "linear", "5 views bvh", "linear", "refit 1%", "visible");
+
+	std::vector<std::size_t> objectsCounts = {10000, 100000, 1000000};
+
+	for (std::size_t objectsCount : objectsCounts) {
+		std::mt19937 generator (5);
+		std::uniform_real_distribution<float> position (-BENCHMARK_WORLD_SIZE / 2, BENCHMARK_WORLD_SIZE / 2);
+		std::uniform_real_distribution<float> height (0.0f, 50.0f);
+		std::uniform_real_distribution<float> extent (0.5f, 4.0f);
+
+		std::vector<std::size_t> items (objectsCount);
+		std::vector<glm::vec3> minVertices (objectsCount);
+		std::vector<glm::vec3> maxVertices (objectsCount);
+
+		std::vector<AABBVolume::AABBVolumeInformation> volumesData (objectsCount);
+		std::vector<AABBVolume*> volumes (objectsCount);
+
+		for (std::size_t item = 0; item < objectsCount; item++) {
+			glm::vec3 center (position (generator), height (generator), position (generator));
+			glm::vec3 halfSize (extent (generator), extent (generator), extent (generator));
+
+			items [item] = item;
+			minVertices [item] = center - halfSize;
+			maxVertices [item] = center + halfSize;
+
+			volumesData [item].minVertex = minVertices [item];
+			volumesData [item].maxVertex = maxVertices [item];
+			volumes [item] = new AABBVolume (&volumesData [item]);
+		}
+
+		BoundingVolumeHierarchy hierarchy;
+
+		double buildTime = MeasureMS (BENCHMARK_RUNS_COUNT, [&] () {
+			hierarchy.Build (items, minVertices, maxVertices);
+		});
+
+		std::vector<std::vector<std::size_t>> visibleItems;
+		std::size_t visibleCount = 0;
+
+		double cameraTime = MeasureMS (BENCHMARK_RUNS_COUNT, [&] () {
+			hierarchy.Query (cameraFrustums, visibleItems);
+		});
+
+		double cameraLinearTime = MeasureMS (BENCHMARK_RUNS_COUNT, [&] () {
+			CullLinear (cameraFrustums, volumes, visibleItems);
+		});
+
+		double viewsTime = MeasureMS (BENCHMARK_RUNS_COUNT, [&] () {
+			hierarchy.Query (allFrustums, visibleItems);
+		});
+
+		visibleCount = CountVisible (visibleItems);
+
+		double viewsLinearTime = MeasureMS (BENCHMARK_RUNS_COUNT, [&] () {
+			CullLinear (allFrustums, volumes, visibleItems);
+		});
+
+		/*
+		 * Both ways see the same boxes
+		*/
+
+		if (CountVisible (visibleItems) != visibleCount) {
+			std::printf ("Culling differs: %zu visible through the hierarchy, %zu through the loop\n",
+				visibleCount, CountVisible (visibleItems));
+
+			return 1;
+		}
+
+		/*
+		 * The moving objects are refit in place, they move a little
+		*/
+
+		std::size_t movingCount = objectsCount * BENCHMARK_REFIT_PERCENT / 100;
+
+		double refitTime = MeasureMS (BENCHMARK_RUNS_COUNT, [&] () {
+			for (std::size_t moving = 0; moving < movingCount; moving++) {
+				std::size_t item = moving * 100 / BENCHMARK_REFIT_PERCENT;
+
+				glm::vec3 offset (0.1f, 0.0f, 0.0f);
+
+				hierarchy.Refit (item, minVertices [item] + offset, maxVertices [item] + offset);
+			}
+		});
+
+		std::printf ("%8zu %9.2f %11.3f %11.3f %11.3f %11.3f %9.3f %8zu\n", objectsCount, buildTime,
+			cameraTime, cameraLinearTime, viewsTime, viewsLinearTime, refitTime, visibleCount);
+
+		for (AABBVolume* volume : volumes) {
+			delete volume;
+		}
+	}
+
+	for (FrustumVolume* cascade : cascades) {
+		delete cascade;
+	}
+
+	return 0;
+}
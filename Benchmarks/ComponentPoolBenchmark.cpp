@@ -0,0 +1,242 @@
+#include <cstdio>
+#include <vector>
+#include <random>
+#include <algorithm>
+
+#include "Systems/Components/Component.h"
+#include "Systems/Components/ComponentPool.h"
+#include "Systems/Components/ComponentManager.h"
+
+#include "Systems/Physics/PhysicsSystem.h"
+#include "Systems/Physics/Physics.h"
+#include "Systems/Physics/Rigidbody.h"
+
+#include "SceneGraph/Scene.h"
+#include "SceneGraph/SceneObject.h"
+
+#include "Systems/Time/Time.h"
+
+#include "BenchmarkClock.h"
+
+/*
+ * A frame of the update phase over many objects. Components are updated
+ * from their pools, bound to their type, against the components they
+ * were before: heap objects, created among other allocations, called
+ * one by one through the virtual table. Gravity moves the packed bodies
+ * of the physics system against the walk over every scene object, which
+ * read the rigidbody of each one through its pointer.
+*/
+
+#define BENCHMARK_RUNS_COUNT 5
+#define BENCHMARK_FRAMES_COUNT 10
+#define BENCHMARK_GRAVITY_PERCENT 75
+#define BENCHMARK_DELTA_TIME_MS 16
+
+class SpinComponent : public Component
+{
+protected:
+	float _angle;
+	float _speed;
+
+public:
+	SpinComponent () : _angle (0.0f), _speed (0.01f) {}
+
+	void Update ()
+	{
+		_angle += _speed;
+
+		if (_angle > 6.2831853f) {
+			_angle -= 6.2831853f;
+		}
+	}
+
+	float GetAngle () const { return _angle; }
+};
+
+class PulseComponent : public Component
+{
+protected:
+	float _time;
+	float _scale;
+
+public:
+	PulseComponent () : _time (0.0f), _scale (1.0f) {}
+
+	void Update ()
+	{
+		_time += 0.016f;
+
+		_scale = 1.0f + 0.1f * (_time - (float) (int) _time);
+	}
+
+	float GetScale () const { return _scale; }
+};
+
+/*
+ * Heap components, their order in the update list has nothing to do
+ * with their addresses
+*/
+
+static std::vector<Component*> CreateHeapComponents (std::size_t componentsCount)
+{
+	std::vector<Component*> components;
+
+	for (std::size_t index = 0; index < componentsCount; index++) {
+		if (index % 2 == 0) {
+			components.push_back (new SpinComponent ());
+		} else {
+			components.push_back (new PulseComponent ());
+		}
+	}
+
+	std::shuffle (components.begin (), components.end (), std::mt19937 (3));
+
+	return components;
+}
+
+static void UpdateHeapComponents (const std::vector<Component*>& components)
+{
+	for (Component* component : components) {
+		component->Update ();
+	}
+}
+
+/*
+ * Pool components are started by the first update of the manager
+*/
+
+static std::vector<Component*> CreatePoolComponents (std::size_t componentsCount)
+{
+	std::vector<Component*> components;
+
+	for (std::size_t index = 0; index < componentsCount; index++) {
+		Component* component = nullptr;
+
+		if (index % 2 == 0) {
+			component = ComponentPool<SpinComponent>::Instance ()->Create ();
+		} else {
+			component = ComponentPool<PulseComponent>::Instance ()->Create ();
+		}
+
+		ComponentManager::Instance ()->Register (component);
+
+		components.push_back (component);
+	}
+
+	ComponentManager::Instance ()->Update ();
+
+	return components;
+}
+
+/*
+ * Scene object with nothing but its transform and rigidbody
+*/
+
+class BodyObject : public SceneObject
+{
+public:
+	void Update () {}
+};
+
+/*
+ * Gravity as the rigidbodies applied it, object by object
+*/
+
+static void UpdateWalkPhysics (Scene& scene)
+{
+	glm::vec3 step = Physics::Instance ().GetGravityVector () * Time::GetDeltaTime ();
+
+	for (SceneObject* sceneObject : scene) {
+		Rigidbody* rigidbody = sceneObject->GetRigidbody ();
+
+		if (!rigidbody->GetGravityUse ()) {
+			continue;
+		}
+
+		Transform* transform = sceneObject->GetTransform ();
+
+		transform->SetPosition (transform->GetPosition () + step);
+	}
+}
+
+static void BuildScene (Scene& scene, std::size_t objectsCount)
+{
+	for (std::size_t index = 0; index < objectsCount; index++) {
+		SceneObject* sceneObject = new BodyObject ();
+
+		sceneObject->GetTransform ()->SetPosition (glm::vec3 ((float) index, 100.0f, 0.0f));
+
+		if (index % 100 >= BENCHMARK_GRAVITY_PERCENT) {
+			sceneObject->GetRigidbody ()->SetGravityUse (false);
+		}
+
+		scene.AttachObject (sceneObject);
+	}
+
+	PhysicsSystem::Instance ().Init (&scene);
+}
+
+int main ()
+{
+	Time::SetFixedDeltaTimeMS (BENCHMARK_DELTA_TIME_MS);
+	Time::Init ();
+	Time::UpdateFrame ();
+
+	std::printf ("Update phase, nanoseconds per object per frame, %d%% of the bodies with gravity\n", BENCHMARK_GRAVITY_PERCENT);
+	std::printf ("%8s %15s %15s %13s %13s\n", "objects", "heap components", "pool components", "walk physics", "packed physics");
+
+	std::vector<std::size_t> objectsCounts = {1000, 10000, 100000};
+
+	for (std::size_t objectsCount : objectsCounts) {
+		double nsPerObject = 1000000.0 / (BENCHMARK_FRAMES_COUNT * objectsCount);
+
+		std::vector<Component*> heapComponents = CreateHeapComponents (objectsCount);
+
+		double heapTime = MeasureMS (BENCHMARK_RUNS_COUNT, [&] () {
+			for (std::size_t frame = 0; frame < BENCHMARK_FRAMES_COUNT; frame++) {
+				UpdateHeapComponents (heapComponents);
+			}
+		}) * nsPerObject;
+
+		for (Component* component : heapComponents) {
+			delete component;
+		}
+
+		std::vector<Component*> poolComponents = CreatePoolComponents (objectsCount);
+
+		double poolTime = MeasureMS (BENCHMARK_RUNS_COUNT, [&] () {
+			for (std::size_t frame = 0; frame < BENCHMARK_FRAMES_COUNT; frame++) {
+				ComponentManager::Instance ()->Update ();
+			}
+		}) * nsPerObject;
+
+		for (Component* component : poolComponents) {
+			ComponentManager::Instance ()->Unregister (component);
+		}
+
+		Scene* scene = new Scene ();
+
+		BuildScene (*scene, objectsCount);
+
+		double walkTime = MeasureMS (BENCHMARK_RUNS_COUNT, [&] () {
+			for (std::size_t frame = 0; frame < BENCHMARK_FRAMES_COUNT; frame++) {
+				UpdateWalkPhysics (*scene);
+			}
+		}) * nsPerObject;
+
+		double packedTime = MeasureMS (BENCHMARK_RUNS_COUNT, [&] () {
+			for (std::size_t frame = 0; frame < BENCHMARK_FRAMES_COUNT; frame++) {
+				PhysicsSystem::Instance ().UpdateScene ();
+			}
+		}) * nsPerObject;
+
+		PhysicsSystem::Instance ().Init (NULL);
+
+		delete scene;
+
+		std::printf ("%8zu %15.2f %15.2f %13.2f %13.2f\n", objectsCount,
+			heapTime, poolTime, walkTime, packedTime);
+	}
+
+	return 0;
+}
@@ -0,0 +1,236 @@
+#include <cstdio>
+#include <string>
+#include <vector>
+#include <algorithm>
+
+#include "Wrappers/OpenGL/GL.h"
+#include "Wrappers/OpenGL/GLNullBackend.h"
+
+#include "Renderer/DrawList.h"
+#include "Renderer/Renderer.h"
+#include "Renderer/Pipeline.h"
+#include "Shader/Shader.h"
+#include "Cameras/PerspectiveCamera.h"
+
+#include "Managers/MaterialManager.h"
+
+#include "SceneGraph/Transform.h"
+#include "SceneGraph/TransformHierarchy.h"
+
+#include "BenchmarkClock.h"
+
+/*
+ * The geometry pass through the sorted draw list against the renderer
+ * loop it replaced, which drew every renderer in priority order and sent
+ * the material of each polygon group after looking it up by name. Both
+ * go through the same pipeline and the null backend, which counts the
+ * calls; only the order and the state kept between packets differ.
+*/
+
+#define BENCHMARK_RUNS_COUNT 3
+#define BENCHMARK_FRAMES_COUNT 5
+#define BENCHMARK_GROUPS_COUNT 4
+#define BENCHMARK_MATERIALS_COUNT 40
+#define BENCHMARK_SHADERS_COUNT 3
+#define BENCHMARK_INDEX_COUNT 384
+
+struct BenchmarkGroup
+{
+	std::string materialName;
+	std::size_t materialID;
+	unsigned int vertexArray;
+};
+
+/*
+ * A model renderer made of a few polygon groups, drawn the way
+ * Model3DRenderer was
+*/
+
+class GroupsRenderer : public Renderer
+{
+protected:
+	Shader* _shader;
+	std::vector<BenchmarkGroup> _groups;
+
+public:
+	GroupsRenderer (Transform* transform, Shader* shader, const std::vector<BenchmarkGroup>& groups) :
+		Renderer (transform),
+		_shader (shader),
+		_groups (groups)
+	{
+		_priority = 1;
+	}
+
+	void Draw ()
+	{
+		GL::DepthMask (GL_TRUE);
+
+		Pipeline::SetObjectTransform (_transform);
+
+		for (const BenchmarkGroup& group : _groups) {
+			Material* material = MaterialManager::Instance ().GetMaterial (group.materialName);
+
+			GL::BlendFunc (material->blending.first, material->blending.second);
+
+			Pipeline::SendMaterial (material, _shader);
+
+			GL::BindVertexArray (group.vertexArray);
+			GL::DrawElements (GL_TRIANGLES, BENCHMARK_INDEX_COUNT, GL_UNSIGNED_INT, 0);
+		}
+	}
+
+	void Collect (DrawList* drawList)
+	{
+		for (const BenchmarkGroup& group : _groups) {
+			drawList->AddPacket (this, _shader, group.materialID, group.vertexArray,
+				BENCHMARK_INDEX_COUNT, GL_UNSIGNED_INT);
+		}
+	}
+};
+
+static bool CompareRenderers (Renderer* a, Renderer* b)
+{
+	return a->GetPriority () < b->GetPriority ();
+}
+
+static void DrawRendererLoopFrame (Camera* camera, std::vector<Renderer*> renderers)
+{
+	Pipeline::SendCamera (camera);
+	Pipeline::CreateProjection (camera);
+
+	std::stable_sort (renderers.begin (), renderers.end (), CompareRenderers);
+
+	for (Renderer* renderer : renderers) {
+		renderer->Draw ();
+	}
+
+	GL::EndFrame ();
+}
+
+static void DrawListFrame (Camera* camera, const std::vector<Renderer*>& renderers, DrawList& drawList)
+{
+	Pipeline::SendCamera (camera);
+	Pipeline::CreateProjection (camera);
+
+	drawList.Begin (camera);
+
+	for (Renderer* renderer : renderers) {
+		renderer->Collect (&drawList);
+	}
+
+	drawList.Sort ();
+	drawList.Submit ();
+
+	GL::EndFrame ();
+}
+
+int main ()
+{
+	GLNullBackend* backend = new GLNullBackend ();
+
+	GL::SetBackend (backend);
+
+	/*
+	 * The wrapper filter of redundant binds is off, the state changes
+	 * skipped are the ones of the draw list
+	*/
+
+	GL::SetStateCaching (false);
+
+	std::vector<Shader*> shaders;
+
+	for (std::size_t index = 0; index < BENCHMARK_SHADERS_COUNT; index++) {
+		shaders.push_back (new Shader ("Shader" + std::to_string (index), GL::CreateProgram ()));
+	}
+
+	std::vector<std::string> materialNames;
+
+	for (std::size_t index = 0; index < BENCHMARK_MATERIALS_COUNT; index++) {
+		Material* material = new Material ();
+
+		material->name = "Material" + std::to_string (index);
+		material->diffuseColor = glm::vec3 (0.02f * index, 0.5f, 0.5f);
+		material->shininess = 8.0f + index;
+
+		MaterialManager::Instance ().AddMaterial (material);
+
+		materialNames.push_back (material->name);
+	}
+
+	PerspectiveCamera camera;
+
+	camera.SetPosition (glm::vec3 (0.0f, 5.0f, -20.0f));
+
+	std::printf ("Geometry pass, %d groups per object, %d materials, %d shaders\n",
+		BENCHMARK_GROUPS_COUNT, BENCHMARK_MATERIALS_COUNT, BENCHMARK_SHADERS_COUNT);
+	std::printf ("%8s %13s %13s %13s %13s %11s %11s\n", "objects", "loop calls", "list calls",
+		"loop material", "list material", "loop ms", "list ms");
+
+	std::vector<std::size_t> objectsCounts = {100, 500, 2000};
+
+	for (std::size_t objectsCount : objectsCounts) {
+		std::vector<Transform*> transforms;
+		std::vector<Renderer*> renderers;
+
+		for (std::size_t index = 0; index < objectsCount; index++) {
+			Transform* transform = new Transform ();
+
+			transform->SetPosition (glm::vec3 ((float) (index % 50), 0.0f, (float) (index / 50)));
+
+			std::vector<BenchmarkGroup> groups (BENCHMARK_GROUPS_COUNT);
+
+			for (std::size_t group = 0; group < BENCHMARK_GROUPS_COUNT; group++) {
+				groups [group].materialName = materialNames [(index * 7 + group * 3) % BENCHMARK_MATERIALS_COUNT];
+				groups [group].materialID = MaterialManager::Instance ().GetMaterialID (groups [group].materialName);
+				groups [group].vertexArray = (unsigned int) (index * BENCHMARK_GROUPS_COUNT + group + 1);
+			}
+
+			transforms.push_back (transform);
+			renderers.push_back (new GroupsRenderer (transform, shaders [(index / 5) % BENCHMARK_SHADERS_COUNT], groups));
+		}
+
+		TransformHierarchy::Instance ()->Update ();
+
+		double loopTime = MeasureMS (BENCHMARK_RUNS_COUNT, [&] () {
+			for (std::size_t frame = 0; frame < BENCHMARK_FRAMES_COUNT; frame++) {
+				DrawRendererLoopFrame (&camera, renderers);
+			}
+		}) / BENCHMARK_FRAMES_COUNT;
+
+		std::size_t loopCallsCount = backend->GetFrameStatistics ().callsCount;
+
+		DrawList drawList;
+
+		double listTime = MeasureMS (BENCHMARK_RUNS_COUNT, [&] () {
+			for (std::size_t frame = 0; frame < BENCHMARK_FRAMES_COUNT; frame++) {
+				DrawListFrame (&camera, renderers, drawList);
+			}
+		}) / BENCHMARK_FRAMES_COUNT;
+
+		std::size_t listCallsCount = backend->GetFrameStatistics ().callsCount;
+
+		/*
+		 * Materials sent, the loop sends one for every group
+		*/
+
+		std::printf ("%8zu %13zu %13zu %13zu %13zu %11.3f %11.3f\n", objectsCount,
+			loopCallsCount, listCallsCount, objectsCount * BENCHMARK_GROUPS_COUNT,
+			drawList.GetStatistics ().materialChangesCount, loopTime, listTime);
+
+		for (Renderer* renderer : renderers) {
+			delete renderer;
+		}
+
+		for (Transform* transform : transforms) {
+			delete transform;
+		}
+	}
+
+	for (Shader* shader : shaders) {
+		delete shader;
+	}
+
+	GL::SetBackend (nullptr);
+
+	return 0;
+}
@@ -0,0 +1,82 @@
+#include <cstdio>
+#include <vector>
+#include <random>
+
+#include "Core/Intersections/FrustumCulling.h"
+
+#include "Core/Math/glm/gtc/matrix_transform.hpp"
+
+#include "BenchmarkClock.h"
+
+/*
+ * Boxes culled per second by every culling path the processor supports,
+ * against the six planes of a frustum
+*/
+
+#define BENCHMARK_RUNS_COUNT 21
+#define BENCHMARK_REPEATS_COUNT 20
+
+int main ()
+{
+	std::mt19937 generator (3);
+	std::uniform_real_distribution<float> position (-100.0f, 100.0f);
+	std::uniform_real_distribution<float> extent (0.1f, 5.0f);
+
+	FrustumVolume frustum (glm::perspective (glm::radians (60.0f), 16.0f / 9.0f, 0.1f, 150.0f) *
+		glm::lookAt (glm::vec3 (0.0f), glm::vec3 (1.0f, 0.0f, 0.0f), glm::vec3 (0.0f, 1.0f, 0.0f)));
+
+	std::vector<std::size_t> boxesCounts = {1000, 10000, 100000, 1000000};
+
+	std::vector<FrustumCullingISA> isas = {
+		FrustumCullingISA::SCALAR, FrustumCullingISA::SSE, FrustumCullingISA::AVX2
+	};
+
+	FrustumCullingISA defaultISA = FrustumCulling::GetISA ();
+
+	std::printf ("Frustum culling, millions of boxes per second\n");
+	std::printf ("%10s", "boxes");
+
+	for (FrustumCullingISA isa : isas) {
+		std::printf (" %10s", FrustumCulling::GetISAName (isa).c_str ());
+	}
+
+	std::printf ("\n");
+
+	for (std::size_t boxesCount : boxesCounts) {
+		AABBBatch boxes;
+		boxes.Resize (boxesCount);
+
+		for (std::size_t index = 0; index < boxesCount; index++) {
+			glm::vec3 center (position (generator), position (generator), position (generator));
+			glm::vec3 halfSize (extent (generator));
+
+			boxes.Set (index, center - halfSize, center + halfSize);
+		}
+
+		std::vector<std::uint32_t> visibilityMask ((boxesCount + 31) / 32);
+
+		std::printf ("%10zu", boxesCount);
+
+		for (FrustumCullingISA isa : isas) {
+			if (!FrustumCulling::SetISA (isa)) {
+				std::printf (" %10s", "-");
+				continue;
+			}
+
+			double time = MeasureMS (BENCHMARK_RUNS_COUNT, [&frustum, &boxes, &visibilityMask, boxesCount] () {
+				for (std::size_t repeat = 0; repeat < BENCHMARK_REPEATS_COUNT; repeat++) {
+					FrustumCulling::CheckFrustumVsAABBs (frustum.GetVolumeInformation (), 0x3F,
+						boxes, 0, boxesCount, visibilityMask.data ());
+				}
+			});
+
+			std::printf (" %10.1f", boxesCount * BENCHMARK_REPEATS_COUNT / (time * 1000.0));
+		}
+
+		std::printf ("\n");
+	}
+
+	FrustumCulling::SetISA (defaultISA);
+
+	return 0;
+}
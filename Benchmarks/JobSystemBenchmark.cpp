@@ -0,0 +1,113 @@
+#include <cstdio>
+#include <set>
+#include <vector>
+#include <thread>
+#include <cmath>
+#include <algorithm>
+
+#include "Utils/Threads/JobSystem.h"
+#include "Utils/Threads/FrameGraph.h"
+
+#include "BenchmarkClock.h"
+
+/*
+ * Scaling of the job system with its workers count. A parallel for over
+ * a fixed amount of arithmetic, and a frame graph shaped like the frame
+ * of the engine with small nodes, where the scheduling itself shows.
+*/
+
+#define BENCHMARK_RUNS_COUNT 7
+#define BENCHMARK_ELEMENTS_COUNT (1 << 18)
+#define BENCHMARK_GRAIN_SIZE 4096
+#define BENCHMARK_FRAMES_COUNT 200
+#define BENCHMARK_SYSTEM_ELEMENTS_COUNT 1024
+
+static void Transform (std::vector<float>& values, std::size_t begin, std::size_t end)
+{
+	for (std::size_t index = begin; index < end; index++) {
+		float value = values [index];
+
+		for (std::size_t iteration = 0; iteration < 16; iteration++) {
+			value = std::sqrt (value * value + 1.0f) * 0.5f;
+		}
+
+		values [index] = value;
+	}
+}
+
+/*
+ * Input, then four systems that each fan out to a few jobs, then the
+ * render on the main thread
+*/
+
+static void BuildFrameGraph (FrameGraph& graph, std::vector<float>& values)
+{
+	std::size_t input = graph.AddNode ("Input", [] () {}, true);
+	std::size_t render = graph.AddNode ("Render", [] () {}, true);
+
+	for (std::size_t system = 0; system < 4; system++) {
+		std::size_t update = graph.AddNode ("Update", [&values, system] () {
+			std::size_t offset = system * BENCHMARK_SYSTEM_ELEMENTS_COUNT;
+
+			JobSystem::Instance ()->ParallelFor (BENCHMARK_SYSTEM_ELEMENTS_COUNT, 128, [&values, offset] (std::size_t begin, std::size_t end) {
+				Transform (values, offset + begin, offset + end);
+			});
+		}, false);
+
+		graph.AddDependency (update, input);
+		graph.AddDependency (render, update);
+	}
+}
+
+int main ()
+{
+	std::vector<float> values (BENCHMARK_ELEMENTS_COUNT, 1.0f);
+
+	std::printf ("Job system, %d elements in grains of %d, %d frames of a graph\n",
+		BENCHMARK_ELEMENTS_COUNT, BENCHMARK_GRAIN_SIZE, BENCHMARK_FRAMES_COUNT);
+	std::printf ("%8s %16s %9s %16s %9s\n", "workers", "for (ms)", "speedup", "graph (us/frame)", "speedup");
+
+	std::size_t maxWorkersCount = std::max (std::thread::hardware_concurrency (), 2u) - 1;
+
+	std::set<std::size_t> workersCounts = {0, 1, 3, 7, maxWorkersCount};
+
+	double baseForTime = 0;
+	double baseGraphTime = 0;
+
+	for (std::size_t workersCount : workersCounts) {
+		if (workersCount > maxWorkersCount) {
+			continue;
+		}
+
+		JobSystem::Instance ()->Start (workersCount);
+
+		double forTime = MeasureMS (BENCHMARK_RUNS_COUNT, [&values] () {
+			JobSystem::Instance ()->ParallelFor (values.size (), BENCHMARK_GRAIN_SIZE,
+				[&values] (std::size_t begin, std::size_t end) {
+					Transform (values, begin, end);
+				});
+		});
+
+		FrameGraph graph;
+
+		BuildFrameGraph (graph, values);
+
+		double graphTime = MeasureMS (BENCHMARK_RUNS_COUNT, [&graph] () {
+			for (std::size_t frame = 0; frame < BENCHMARK_FRAMES_COUNT; frame++) {
+				graph.Execute ();
+			}
+		}) * 1000.0 / BENCHMARK_FRAMES_COUNT;
+
+		JobSystem::Instance ()->Stop ();
+
+		if (workersCount == 0) {
+			baseForTime = forTime;
+			baseGraphTime = graphTime;
+		}
+
+		std::printf ("%8zu %16.2f %9.2f %16.1f %9.2f\n", workersCount,
+			forTime, baseForTime / forTime, graphTime, baseGraphTime / graphTime);
+	}
+
+	return 0;
+}
@@ -0,0 +1,375 @@
+#include <cstdio>
+#include <string>
+#include <vector>
+#include <fstream>
+#include <algorithm>
+
+#include "Resources/WavefrontObjectLoader.h"
+#include "Mesh/Model.h"
+
+#include "Utils/Files/MappedFile.h"
+#include "Utils/Threads/JobSystem.h"
+
+#include "Core/Math/glm/detail/func_geometric.hpp"
+
+#include "BenchmarkClock.h"
+#include "WavefrontModelGenerator.h"
+
+/*
+ * Memory and latency of the flat model layout. The model given as
+ * argument is loaded, Sponza for one, or a generated one without it.
+ *
+ * The layout before it, one allocation per attribute and an index
+ * array per polygon, is loaded from the same parsed chunks and measured
+ * on the same work: the load with its triangulation, the bounding box,
+ * a copy and the smooth normals.
+*/
+
+#define BENCHMARK_FILENAME "ModelBenchmark.obj"
+#define BENCHMARK_RUNS_COUNT 5
+
+struct PointerPolygon
+{
+	std::vector<int> vertices;
+	std::vector<int> normals;
+	std::vector<int> texcoords;
+};
+
+struct PointerModel
+{
+	std::vector<glm::vec3*> vertices;
+	std::vector<glm::vec3*> normals;
+	std::vector<glm::vec3*> texcoords;
+	std::vector<PointerPolygon*> polygons;
+
+	~PointerModel ()
+	{
+		for (glm::vec3* vertex : vertices) delete vertex;
+		for (glm::vec3* normal : normals) delete normal;
+		for (glm::vec3* texcoord : texcoords) delete texcoord;
+		for (PointerPolygon* polygon : polygons) delete polygon;
+	}
+};
+
+/*
+ * Resident memory of the process, in KB
+*/
+
+static long GetResidentMemoryKB ()
+{
+	std::ifstream stream ("/proc/self/status");
+	std::string line;
+
+	while (std::getline (stream, line)) {
+		if (line.compare (0, 6, "VmRSS:") == 0) {
+			return std::stol (line.substr (6));
+		}
+	}
+
+	return 0;
+}
+
+/*
+ * Loads the model the way it was stored before, every element on the
+ * heap and every polygon with its own index arrays. The file is parsed
+ * by the same chunks, only the model they go to differs. The generated
+ * model and Sponza have no relative indices, so those are not resolved.
+*/
+
+class PointerObjectLoader : public WavefrontObjectLoader
+{
+public:
+	PointerModel* LoadPointerModel (const std::string& filename)
+	{
+		MappedFile objFile;
+
+		if (!objFile.Open (filename)) {
+			return nullptr;
+		}
+
+		std::vector<WavefrontObjectChunk> chunks = SplitChunks (objFile.GetData (), objFile.GetSize ());
+
+		JobSystem::Instance ()->ParallelFor (chunks.size (), 1,
+			[this, &chunks] (std::size_t begin, std::size_t end) {
+				for (std::size_t i = begin; i < end; i++) {
+					ParseChunk (&chunks [i]);
+				}
+			});
+
+		PointerModel* pointerModel = new PointerModel ();
+
+		for (const WavefrontObjectChunk& chunk : chunks) {
+			for (std::size_t i = 0; i < chunk.positions.size (); i += 3) {
+				pointerModel->vertices.push_back (new glm::vec3 (chunk.positions [i], chunk.positions [i + 1], chunk.positions [i + 2]));
+			}
+
+			for (std::size_t i = 0; i < chunk.normals.size (); i += 3) {
+				pointerModel->normals.push_back (new glm::vec3 (chunk.normals [i], chunk.normals [i + 1], chunk.normals [i + 2]));
+			}
+
+			for (std::size_t i = 0; i < chunk.texcoords.size (); i += 2) {
+				pointerModel->texcoords.push_back (new glm::vec3 (chunk.texcoords [i], chunk.texcoords [i + 1], 0.0f));
+			}
+
+			for (std::size_t i = 0; i < chunk.faces.size (); i++) {
+				const WavefrontObjectFace& face = chunk.faces [i];
+
+				std::size_t vertexEnd = i + 1 < chunk.faces.size () ? chunk.faces [i + 1].vertexOffset : chunk.faceVertices.size ();
+				std::size_t normalEnd = i + 1 < chunk.faces.size () ? chunk.faces [i + 1].normalOffset : chunk.faceNormals.size ();
+				std::size_t texcoordEnd = i + 1 < chunk.faces.size () ? chunk.faces [i + 1].texcoordOffset : chunk.faceTexcoords.size ();
+
+				PointerPolygon* polygon = new PointerPolygon ();
+
+				polygon->vertices.assign (chunk.faceVertices.begin () + face.vertexOffset, chunk.faceVertices.begin () + vertexEnd);
+				polygon->normals.assign (chunk.faceNormals.begin () + face.normalOffset, chunk.faceNormals.begin () + normalEnd);
+				polygon->texcoords.assign (chunk.faceTexcoords.begin () + face.texcoordOffset, chunk.faceTexcoords.begin () + texcoordEnd);
+
+				pointerModel->polygons.push_back (polygon);
+			}
+		}
+
+		objFile.Close ();
+
+		TriangulatePointerModel (pointerModel);
+
+		return pointerModel;
+	}
+
+protected:
+
+	/*
+	 * Every polygon is replaced by the triangles of its fan, each a new
+	 * polygon, as the convex triangulation did
+	*/
+
+	void TriangulatePointerModel (PointerModel* pointerModel)
+	{
+		std::vector<PointerPolygon*> triangles;
+
+		for (PointerPolygon* polygon : pointerModel->polygons) {
+			bool hasNormals = polygon->normals.size () == polygon->vertices.size ();
+			bool hasTexcoords = polygon->texcoords.size () == polygon->vertices.size ();
+
+			for (std::size_t i = 2; i < polygon->vertices.size (); i++) {
+				PointerPolygon* triangle = new PointerPolygon ();
+
+				for (std::size_t corner : { (std::size_t) 0, i - 1, i }) {
+					triangle->vertices.push_back (polygon->vertices [corner]);
+
+					if (hasNormals) {
+						triangle->normals.push_back (polygon->normals [corner]);
+					}
+
+					if (hasTexcoords) {
+						triangle->texcoords.push_back (polygon->texcoords [corner]);
+					}
+				}
+
+				triangles.push_back (triangle);
+			}
+
+			delete polygon;
+		}
+
+		pointerModel->polygons.swap (triangles);
+	}
+};
+
+static PointerModel* CopyPointerModel (const PointerModel* other)
+{
+	PointerModel* pointerModel = new PointerModel ();
+
+	for (glm::vec3* vertex : other->vertices) {
+		pointerModel->vertices.push_back (new glm::vec3 (*vertex));
+	}
+
+	for (glm::vec3* normal : other->normals) {
+		pointerModel->normals.push_back (new glm::vec3 (*normal));
+	}
+
+	for (glm::vec3* texcoord : other->texcoords) {
+		pointerModel->texcoords.push_back (new glm::vec3 (*texcoord));
+	}
+
+	for (PointerPolygon* polygon : other->polygons) {
+		pointerModel->polygons.push_back (new PointerPolygon (*polygon));
+	}
+
+	return pointerModel;
+}
+
+static BoundingBox CalculatePointerBoundingBox (const PointerModel* pointerModel)
+{
+	BoundingBox boundingBox;
+
+	for (PointerPolygon* polygon : pointerModel->polygons) {
+		for (int index : polygon->vertices) {
+			const glm::vec3& vertex = *pointerModel->vertices [index];
+
+			boundingBox.xmin = std::min (boundingBox.xmin, vertex.x);
+			boundingBox.xmax = std::max (boundingBox.xmax, vertex.x);
+			boundingBox.ymin = std::min (boundingBox.ymin, vertex.y);
+			boundingBox.ymax = std::max (boundingBox.ymax, vertex.y);
+			boundingBox.zmin = std::min (boundingBox.zmin, vertex.z);
+			boundingBox.zmax = std::max (boundingBox.zmax, vertex.z);
+		}
+	}
+
+	return boundingBox;
+}
+
+/*
+ * Smooth normals as they were generated, summed through the pointers
+ * and stored again as new allocations
+*/
+
+static void GeneratePointerSmoothNormals (PointerModel* pointerModel)
+{
+	std::vector<glm::vec3> smoothNormals (pointerModel->vertices.size (), glm::vec3 (0.0f));
+	std::vector<std::size_t> smoothNormalsCount (pointerModel->vertices.size (), 0);
+
+	for (PointerPolygon* polygon : pointerModel->polygons) {
+		for (std::size_t corner = 0; corner < polygon->vertices.size (); corner++) {
+			int vertex = polygon->vertices [corner];
+
+			smoothNormals [vertex] += *pointerModel->normals [polygon->normals [corner]];
+			smoothNormalsCount [vertex] ++;
+
+			polygon->normals [corner] = vertex;
+		}
+	}
+
+	for (std::size_t i = 0; i < smoothNormals.size (); i++) {
+		smoothNormals [i] *= (1.0f / smoothNormalsCount [i]);
+		smoothNormals [i] = glm::normalize (smoothNormals [i]);
+	}
+
+	for (glm::vec3* normal : pointerModel->normals) {
+		delete normal;
+	}
+
+	pointerModel->normals.clear ();
+	pointerModel->normals.shrink_to_fit ();
+
+	for (const glm::vec3& normal : smoothNormals) {
+		pointerModel->normals.push_back (new glm::vec3 (normal));
+	}
+}
+
+int main (int argc, char** argv)
+{
+	std::string filename = argc > 1 ? argv [1] : BENCHMARK_FILENAME;
+
+	if (argc <= 1) {
+		GenerateWavefrontModel (filename);
+	}
+
+	long residentMemory = GetResidentMemoryKB ();
+
+	Model* model = nullptr;
+
+	double loadTime = MeasureMS (1, [&model, &filename] () {
+		WavefrontObjectLoader loader;
+		loader.SetLoadMaterials (false);
+
+		model = (Model*) loader.Load (filename);
+	});
+
+	long modelMemory = GetResidentMemoryKB () - residentMemory;
+
+	std::printf ("Model %s: %zu vertices, %zu normals, %zu texcoords\n", filename.c_str (),
+		model->VertexCount (), model->NormalsCount (), model->TexcoordsCount ());
+
+	/*
+	 * The bounding box is calculated once per model, every run measures a
+	 * new copy
+	*/
+
+	std::vector<Model*> copies;
+
+	double copyTime = MeasureMS (BENCHMARK_RUNS_COUNT, [&copies, model] () {
+		copies.push_back (new Model (*model));
+	});
+
+	std::size_t copyIndex = 0;
+
+	double boundingBoxTime = MeasureMS (BENCHMARK_RUNS_COUNT, [&copies, &copyIndex] () {
+		copies [copyIndex ++]->GetBoundingBox ();
+	});
+
+	copyIndex = 0;
+
+	double smoothNormalsTime = MeasureMS (BENCHMARK_RUNS_COUNT, [&copies, &copyIndex] () {
+		copies [copyIndex ++]->GenerateSmoothNormals ();
+	});
+
+	for (Model* copy : copies) {
+		delete copy;
+	}
+
+	residentMemory = GetResidentMemoryKB ();
+
+	PointerModel* pointerModel = nullptr;
+
+	double pointerLoadTime = MeasureMS (1, [&pointerModel, &filename] () {
+		PointerObjectLoader loader;
+
+		pointerModel = loader.LoadPointerModel (filename);
+	});
+
+	long pointerModelMemory = GetResidentMemoryKB () - residentMemory;
+
+	if (pointerModel == nullptr) {
+		std::printf ("Unable to load %s\n", filename.c_str ());
+		return 1;
+	}
+
+	double pointerCopyTime = MeasureMS (BENCHMARK_RUNS_COUNT, [pointerModel] () {
+		delete CopyPointerModel (pointerModel);
+	});
+
+	BoundingBox pointerBoundingBox;
+
+	double pointerBoundingBoxTime = MeasureMS (BENCHMARK_RUNS_COUNT, [pointerModel, &pointerBoundingBox] () {
+		pointerBoundingBox = CalculatePointerBoundingBox (pointerModel);
+	});
+
+	std::vector<PointerModel*> pointerCopies;
+
+	for (std::size_t run = 0; run < BENCHMARK_RUNS_COUNT; run++) {
+		pointerCopies.push_back (CopyPointerModel (pointerModel));
+	}
+
+	copyIndex = 0;
+
+	double pointerSmoothNormalsTime = MeasureMS (BENCHMARK_RUNS_COUNT, [&pointerCopies, &copyIndex] () {
+		GeneratePointerSmoothNormals (pointerCopies [copyIndex ++]);
+	});
+
+	for (PointerModel* pointerCopy : pointerCopies) {
+		delete pointerCopy;
+	}
+
+	BoundingBox* boundingBox = model->GetBoundingBox ();
+
+	if (boundingBox->xmin != pointerBoundingBox.xmin || boundingBox->zmax != pointerBoundingBox.zmax) {
+		std::printf ("The layouts have different bounding boxes\n");
+		return 1;
+	}
+
+	std::printf ("%-16s %14s %14s\n", "", "flat", "per element");
+	std::printf ("%-16s %11.1f ms %11.1f ms\n", "load", loadTime, pointerLoadTime);
+	std::printf ("%-16s %11ld KB %11ld KB\n", "resident", modelMemory, pointerModelMemory);
+	std::printf ("%-16s %11.2f ms %11.2f ms\n", "bounding box", boundingBoxTime, pointerBoundingBoxTime);
+	std::printf ("%-16s %11.2f ms %11.2f ms\n", "copy", copyTime, pointerCopyTime);
+	std::printf ("%-16s %11.2f ms %11.2f ms\n", "smooth normals", smoothNormalsTime, pointerSmoothNormalsTime);
+
+	delete pointerModel;
+	delete model;
+
+	if (argc <= 1) {
+		std::remove (filename.c_str ());
+	}
+
+	return 0;
+}
\ No newline at end of file
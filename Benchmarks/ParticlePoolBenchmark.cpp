@@ -0,0 +1,263 @@
+#include <cstdio>
+#include <vector>
+#include <random>
+
+#include "VisualEffects/ParticleSystem/ParticlePool.h"
+#include "VisualEffects/ParticleSystem/ParticleKernels.h"
+
+#include "SceneGraph/Transform.h"
+
+#include "Utils/Curves/AnimationCurve.h"
+#include "Utils/Extensions/MathExtend.h"
+
+#include "BenchmarkClock.h"
+
+/*
+ * Frames of a particle system kept full, in the structure of arrays pool
+ * against the particles it replaced. Those were objects of their own
+ * with a heap transform, updated one by one through the curves, deleted
+ * when dead and created again by the emitter. The gather is what the
+ * renderer reads of every particle to write its instance.
+*/
+
+#define BENCHMARK_RUNS_COUNT 5
+#define BENCHMARK_FRAMES_COUNT 10
+#define BENCHMARK_DELTA_TIME (1.0f / 60.0f)
+#define BENCHMARK_MIN_LIFETIME 1.0f
+#define BENCHMARK_MAX_LIFETIME 3.0f
+
+/*
+ * A particle as it was, times in milliseconds
+*/
+
+struct HeapParticle
+{
+	Transform* transform;
+	AnimationCurve* scaleCurve;
+	AnimationCurve* tweenCurve;
+	unsigned int lifetime;
+	unsigned int timeAlive;
+	bool alive;
+	glm::vec3 initialPosition;
+	glm::vec3 finalDestination;
+	glm::vec3 initialScale;
+
+	HeapParticle () : transform (new Transform ()) {}
+	~HeapParticle () { delete transform; }
+
+	void Update (unsigned int deltaTimeMS)
+	{
+		timeAlive += deltaTimeMS;
+
+		if (timeAlive >= lifetime) {
+			alive = false;
+
+			return;
+		}
+
+		float position = tweenCurve->Evaluate (1.0f * timeAlive / lifetime);
+
+		transform->SetPosition (Extensions::MathExtend::Lerp<glm::vec3> (position, initialPosition, finalDestination));
+
+		float scale = scaleCurve->Evaluate (1.0f - 1.0f * timeAlive / lifetime);
+
+		transform->SetScale (initialScale * scale);
+	}
+};
+
+struct ParticleEmission
+{
+	std::mt19937 generator;
+	std::uniform_real_distribution<float> lifetime;
+	std::uniform_real_distribution<float> direction;
+
+	ParticleEmission () :
+		generator (9),
+		lifetime (BENCHMARK_MIN_LIFETIME, BENCHMARK_MAX_LIFETIME),
+		direction (-1.0f, 1.0f)
+	{
+
+	}
+
+	glm::vec3 GetVelocity ()
+	{
+		return glm::normalize (glm::vec3 (direction (generator), 1.0f, direction (generator))) * 2.0f;
+	}
+};
+
+static HeapParticle* EmitHeapParticle (ParticleEmission& emission, AnimationCurve* scaleCurve, AnimationCurve* tweenCurve)
+{
+	HeapParticle* particle = new HeapParticle ();
+
+	float lifetime = emission.lifetime (emission.generator);
+
+	particle->scaleCurve = scaleCurve;
+	particle->tweenCurve = tweenCurve;
+	particle->lifetime = (unsigned int) (lifetime * 1000);
+	particle->timeAlive = 0;
+	particle->alive = true;
+	particle->transform->SetPosition (glm::vec3 (0.0f));
+	particle->transform->SetScale (glm::vec3 (0.5f));
+	particle->initialPosition = particle->transform->GetPosition ();
+	particle->initialScale = particle->transform->GetScale ();
+	particle->finalDestination = particle->initialPosition + emission.GetVelocity () * lifetime;
+
+	return particle;
+}
+
+static void EmitPoolParticle (ParticleEmission& emission, ParticlePool& pool)
+{
+	pool.Add (glm::vec3 (0.0f), emission.GetVelocity (), emission.lifetime (emission.generator), 0.5f, glm::quat ());
+}
+
+static void UpdateHeapParticles (std::vector<HeapParticle*>& particles, std::size_t particlesCount,
+	ParticleEmission& emission, AnimationCurve* scaleCurve, AnimationCurve* tweenCurve)
+{
+	unsigned int deltaTimeMS = (unsigned int) (BENCHMARK_DELTA_TIME * 1000);
+
+	for (std::size_t index = 0; index < particles.size (); index++) {
+		particles [index]->Update (deltaTimeMS);
+	}
+
+	for (std::size_t index = 0; index < particles.size ();) {
+		if (!particles [index]->alive) {
+			HeapParticle* doomed = particles [index];
+
+			particles [index] = particles.back ();
+			particles.pop_back ();
+
+			delete doomed;
+		} else {
+			++ index;
+		}
+	}
+
+	while (particles.size () < particlesCount) {
+		particles.push_back (EmitHeapParticle (emission, scaleCurve, tweenCurve));
+	}
+}
+
+static void UpdatePoolParticles (ParticlePool& pool, std::size_t particlesCount, ParticleEmission& emission,
+	const ParticleCurve& scaleCurve, const ParticleCurve& tweenCurve)
+{
+	ParticleKernels::UpdateAge (pool, 0, pool.GetSize (), BENCHMARK_DELTA_TIME);
+
+	pool.RemoveDead ();
+
+	ParticleKernels::UpdateTween (pool, 0, pool.GetSize (), tweenCurve);
+	ParticleKernels::UpdateScale (pool, 0, pool.GetSize (), scaleCurve);
+
+	while (pool.GetSize () < particlesCount) {
+		EmitPoolParticle (emission, pool);
+	}
+}
+
+/*
+ * Position and scale of every particle, the old renderer concatenated
+ * a buffer per particle read through its transform
+*/
+
+static float GatherHeapParticles (const std::vector<HeapParticle*>& particles)
+{
+	std::vector<float> instances;
+
+	for (HeapParticle* particle : particles) {
+		glm::vec3 position = particle->transform->GetPosition ();
+		glm::vec3 scale = particle->transform->GetScale ();
+
+		std::vector<float> data = { position.x, position.y, position.z, scale.x };
+
+		instances.insert (instances.end (), data.begin (), data.end ());
+	}
+
+	return instances.empty () ? 0.0f : instances.back ();
+}
+
+static float GatherPoolParticles (const ParticlePool& pool, std::vector<float>& instances)
+{
+	float* instance = instances.data ();
+
+	for (std::size_t index = 0; index < pool.GetSize (); index++, instance += 4) {
+		instance [0] = pool.positionX [index];
+		instance [1] = pool.positionY [index];
+		instance [2] = pool.positionZ [index];
+		instance [3] = pool.scale [index];
+	}
+
+	return pool.GetSize () == 0 ? 0.0f : instances [pool.GetSize () * 4 - 1];
+}
+
+int main ()
+{
+	AnimationCurve scaleCurve (EaseCurve::EaseType::QUAD_EASE_OUT);
+	AnimationCurve tweenCurve (EaseCurve::EaseType::SINE_EASE_IN_OUT);
+
+	ParticleCurve sampledScaleCurve;
+	ParticleCurve sampledTweenCurve;
+
+	sampledScaleCurve.Sample (&scaleCurve);
+	sampledTweenCurve.Sample (&tweenCurve);
+
+	std::printf ("Particle system kept full, milliseconds per frame\n");
+	std::printf ("%10s %11s %11s %11s %11s\n", "particles", "old update", "new update", "old gather", "new gather");
+
+	std::vector<std::size_t> particlesCounts = {1000, 10000, 100000, 1000000};
+
+	volatile float sink = 0.0f;
+
+	for (std::size_t particlesCount : particlesCounts) {
+		ParticleEmission heapEmission;
+		ParticleEmission poolEmission;
+
+		/*
+		 * A second of frames first, so that the particles die at any
+		 * frame and not all at once
+		*/
+
+		std::vector<HeapParticle*> particles;
+
+		ParticlePool pool;
+		pool.Reserve (particlesCount);
+
+		for (std::size_t frame = 0; frame < 60; frame++) {
+			while (particles.size () < particlesCount * (frame + 1) / 60) {
+				particles.push_back (EmitHeapParticle (heapEmission, &scaleCurve, &tweenCurve));
+				EmitPoolParticle (poolEmission, pool);
+			}
+
+			UpdateHeapParticles (particles, particles.size (), heapEmission, &scaleCurve, &tweenCurve);
+			UpdatePoolParticles (pool, pool.GetSize (), poolEmission, sampledScaleCurve, sampledTweenCurve);
+		}
+
+		double oldUpdateTime = MeasureMS (BENCHMARK_RUNS_COUNT, [&] () {
+			for (std::size_t frame = 0; frame < BENCHMARK_FRAMES_COUNT; frame++) {
+				UpdateHeapParticles (particles, particlesCount, heapEmission, &scaleCurve, &tweenCurve);
+			}
+		}) / BENCHMARK_FRAMES_COUNT;
+
+		double newUpdateTime = MeasureMS (BENCHMARK_RUNS_COUNT, [&] () {
+			for (std::size_t frame = 0; frame < BENCHMARK_FRAMES_COUNT; frame++) {
+				UpdatePoolParticles (pool, particlesCount, poolEmission, sampledScaleCurve, sampledTweenCurve);
+			}
+		}) / BENCHMARK_FRAMES_COUNT;
+
+		double oldGatherTime = MeasureMS (BENCHMARK_RUNS_COUNT, [&] () {
+			sink = sink + GatherHeapParticles (particles);
+		});
+
+		std::vector<float> instances (particlesCount * 4);
+
+		double newGatherTime = MeasureMS (BENCHMARK_RUNS_COUNT, [&] () {
+			sink = sink + GatherPoolParticles (pool, instances);
+		});
+
+		std::printf ("%10zu %11.3f %11.3f %11.3f %11.3f\n", particlesCount,
+			oldUpdateTime, newUpdateTime, oldGatherTime, newGatherTime);
+
+		for (HeapParticle* particle : particles) {
+			delete particle;
+		}
+	}
+
+	return 0;
+}
@@ -0,0 +1,110 @@
+#include <cstdio>
+#include <vector>
+#include <thread>
+#include <algorithm>
+
+#include "Debug/Profiler/Profiler.h"
+#include "Debug/Profiler/ProfilerLogger.h"
+
+#include "Arguments/ArgumentsAnalyzer.h"
+
+#include "BenchmarkClock.h"
+
+/*
+ * Cost of a profiled scope, from the buffer push alone to the whole
+ * scope with the profiler on, and on more threads at once. A run records
+ * a burst of scopes, then waits for the flusher to drain them, so that
+ * bursts never fill the buffers.
+*/
+
+#define BENCHMARK_RUNS_COUNT 21
+#define BENCHMARK_SCOPES_COUNT 10000
+
+static volatile std::size_t benchmarkSink = 0;
+
+static void RecordScopes ()
+{
+	for (std::size_t index = 0; index < BENCHMARK_SCOPES_COUNT; index++) {
+		PROFILER_LOGGER ("Benchmark Scope")
+
+		benchmarkSink = benchmarkSink + index;
+	}
+}
+
+static double MeasureScopeNS (std::size_t threadsCount)
+{
+	std::vector<double> times;
+
+	for (std::size_t run = 0; run < BENCHMARK_RUNS_COUNT; run++) {
+		times.push_back (MeasureMS (1, [threadsCount] () {
+			std::vector<std::thread> threads;
+
+			for (std::size_t thread = 1; thread < threadsCount; thread++) {
+				threads.push_back (std::thread (RecordScopes));
+			}
+
+			RecordScopes ();
+
+			for (std::thread& thread : threads) {
+				thread.join ();
+			}
+		}));
+
+		std::this_thread::sleep_for (std::chrono::milliseconds (3 * PROFILER_FLUSH_INTERVAL_MS));
+	}
+
+	std::sort (times.begin (), times.end ());
+
+	return times [times.size () / 2] * 1000000.0 / BENCHMARK_SCOPES_COUNT;
+}
+
+int main ()
+{
+	char* arguments [] = { (char*) "ProfilerBenchmark", (char*) "--profiler" };
+
+	ArgumentsAnalyzer::Instance ()->ProcessArguments (2, arguments);
+
+	/*
+	 * The loop alone and the push alone
+	*/
+
+	double loopTime = MeasureMS (BENCHMARK_RUNS_COUNT, [] () {
+		for (std::size_t index = 0; index < BENCHMARK_SCOPES_COUNT; index++) {
+			benchmarkSink = benchmarkSink + index;
+		}
+	});
+
+	ProfilerBuffer buffer (0);
+	std::vector<ProfilerEvent> events;
+
+	double pushTime = MeasureMS (BENCHMARK_RUNS_COUNT, [&buffer, &events] () {
+		for (std::size_t index = 0; index < BENCHMARK_SCOPES_COUNT; index++) {
+			buffer.Push (index, 0, PROFILER_EVENT_BEGIN);
+			buffer.Push (index, 0, PROFILER_EVENT_END);
+		}
+
+		events.clear ();
+		buffer.Pop (events);
+	});
+
+	Profiler::Instance ()->Start ();
+
+	std::printf ("Profiler, ns per scope\n");
+	std::printf ("%-24s %10.1f\n", "loop", loopTime * 1000000.0 / BENCHMARK_SCOPES_COUNT);
+	std::printf ("%-24s %10.1f\n", "push pair", pushTime * 1000000.0 / BENCHMARK_SCOPES_COUNT);
+
+	std::size_t maxThreadsCount = std::max (std::thread::hardware_concurrency (), 1u);
+
+	for (std::size_t threadsCount = 1; threadsCount <= maxThreadsCount; threadsCount *= 2) {
+		std::printf ("scope, %2zu thread(s)      %10.1f\n", threadsCount, MeasureScopeNS (threadsCount));
+	}
+
+	std::printf ("%-24s %10zu\n", "dropped events", Profiler::Instance ()->GetDroppedEventsCount ());
+
+	Profiler::Instance ()->Stop ();
+
+	std::remove (PROFILER_OUTPUT_FILE);
+	std::remove (PROFILER_TRACE_FILE);
+
+	return 0;
+}
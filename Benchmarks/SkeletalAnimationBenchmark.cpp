@@ -0,0 +1,105 @@
+#include <cstdio>
+#include <vector>
+#include <thread>
+#include <algorithm>
+
+#include "Mesh/AnimationModel.h"
+#include "Mesh/SkeletalAnimation.h"
+
+#include "Systems/Animation/AnimationSystem.h"
+
+#include "Utils/Threads/JobSystem.h"
+
+#include "SkeletalAnimationGenerator.h"
+#include "BenchmarkClock.h"
+
+/*
+ * Time per frame to evaluate the poses of many instances of the same
+ * animated model. The recursive evaluator the renderer used before, the
+ * flattened skeleton on the calling thread, and the flattened skeleton
+ * in jobs the way the animation system splits them.
+*/
+
+#define BENCHMARK_RUNS_COUNT 3
+#define BENCHMARK_FRAMES_COUNT 10
+#define BENCHMARK_FRAME_SECONDS (1.0f / 60.0f)
+
+int main ()
+{
+	AnimationModel* animationModel = GenerateSkeletalAnimationModel ();
+
+	SkeletalAnimation* skeletalAnimation = animationModel->GetSkeletalAnimation ();
+	RecursiveSkeletalAnimation recursiveAnimation (animationModel);
+
+	std::size_t workersCount = std::max (std::thread::hardware_concurrency (), 2u) - 1;
+
+	JobSystem::Instance ()->Start (workersCount);
+
+	std::printf ("Skeletal animation, %d nodes, %d bones, %d keys per channel, %zu workers\n",
+		SKELETAL_ANIMATION_NODES_COUNT, SKELETAL_ANIMATION_BONES_COUNT, SKELETAL_ANIMATION_KEYS_COUNT, workersCount);
+	std::printf ("%10s %16s %16s %16s %9s\n", "instances", "recursive (ms)", "flattened (ms)", "parallel (ms)", "speedup");
+
+	std::size_t instancesCounts [] = {1, 10, 100, 1000};
+
+	for (std::size_t instancesCount : instancesCounts) {
+
+		/*
+		 * Every instance starts at its own time
+		*/
+
+		std::vector<float> offsets (instancesCount);
+
+		for (std::size_t instance = 0; instance < instancesCount; instance++) {
+			offsets [instance] = instance * 0.173f;
+		}
+
+		std::vector<std::vector<glm::mat4>> palettes (instancesCount);
+		std::vector<SkeletalAnimationPose> poses (instancesCount);
+
+		for (SkeletalAnimationPose& pose : poses) {
+			skeletalAnimation->InitPose (pose);
+		}
+
+		double recursiveTime = MeasureMS (BENCHMARK_RUNS_COUNT, [&] () {
+			for (std::size_t frame = 0; frame < BENCHMARK_FRAMES_COUNT; frame++) {
+				for (std::size_t instance = 0; instance < instancesCount; instance++) {
+					float time = frame * BENCHMARK_FRAME_SECONDS + offsets [instance];
+
+					recursiveAnimation.Evaluate (skeletalAnimation->GetAnimationTime (time), palettes [instance]);
+				}
+			}
+		}) / BENCHMARK_FRAMES_COUNT;
+
+		double flattenedTime = MeasureMS (BENCHMARK_RUNS_COUNT, [&] () {
+			for (std::size_t frame = 0; frame < BENCHMARK_FRAMES_COUNT; frame++) {
+				for (std::size_t instance = 0; instance < instancesCount; instance++) {
+					float time = frame * BENCHMARK_FRAME_SECONDS + offsets [instance];
+
+					skeletalAnimation->Evaluate (skeletalAnimation->GetAnimationTime (time), poses [instance]);
+				}
+			}
+		}) / BENCHMARK_FRAMES_COUNT;
+
+		double parallelTime = MeasureMS (BENCHMARK_RUNS_COUNT, [&] () {
+			for (std::size_t frame = 0; frame < BENCHMARK_FRAMES_COUNT; frame++) {
+				JobSystem::Instance ()->ParallelFor (instancesCount, ANIMATION_SYSTEM_INSTANCES_PER_JOB,
+					[&, frame] (std::size_t begin, std::size_t end) {
+						for (std::size_t instance = begin; instance < end; instance++) {
+							float time = frame * BENCHMARK_FRAME_SECONDS + offsets [instance];
+
+							skeletalAnimation->Evaluate (skeletalAnimation->GetAnimationTime (time), poses [instance]);
+						}
+					});
+			}
+		}) / BENCHMARK_FRAMES_COUNT;
+
+		std::printf ("%10zu %16.3f %16.3f %16.3f %9.2f\n", instancesCount,
+			recursiveTime, flattenedTime, parallelTime, recursiveTime / parallelTime);
+	}
+
+	JobSystem::Instance ()->Stop ();
+
+	delete animationModel;
+
+	return 0;
+}
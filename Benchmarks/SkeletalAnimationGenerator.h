@@ -0,0 +1,262 @@
+#ifndef SKELETALANIMATIONGENERATOR_H
+#define SKELETALANIMATIONGENERATOR_H
+
+#include <vector>
+#include <random>
+#include <algorithm>
+#include <cmath>
+
+#include "Core/Math/glm/glm.hpp"
+#include "Core/Math/glm/gtx/transform.hpp"
+
+#include "Mesh/AnimationModel.h"
+
+/*
+ * Animated model the skeletal animation benchmark and test build instead
+ * of loading one, it is always the same. Deep chains of nodes, some of
+ * them without a bone or without a channel, bones numbered in another
+ * order than the tree and channels with a single key.
+*/
+
+#define SKELETAL_ANIMATION_NODES_COUNT 60
+#define SKELETAL_ANIMATION_BONES_COUNT 51
+#define SKELETAL_ANIMATION_KEYS_COUNT 31
+#define SKELETAL_ANIMATION_DURATION 120.0f
+#define SKELETAL_ANIMATION_TICKS_PER_SECOND 30.0f
+
+inline glm::mat4 GenerateSkeletalAnimationTransform (std::mt19937& random)
+{
+	std::uniform_real_distribution<float> unit (-1.0f, 1.0f);
+
+	glm::vec3 axis = glm::normalize (glm::vec3 (unit (random), unit (random), unit (random)) + glm::vec3 (0.0f, 2.0f, 0.0f));
+
+	return glm::translate (glm::mat4 (1.0f), glm::vec3 (unit (random), unit (random), unit (random))) *
+		glm::rotate (glm::mat4 (1.0f), unit (random) * 3.0f, axis);
+}
+
+inline AnimationNode* GenerateSkeletalAnimationNode (std::mt19937& random)
+{
+	std::uniform_real_distribution<float> unit (-1.0f, 1.0f);
+
+	AnimationNode* animationNode = new AnimationNode ();
+
+	std::size_t keysCount = random () % 4 == 0 ? 1 : SKELETAL_ANIMATION_KEYS_COUNT;
+
+	for (std::size_t key = 0; key < keysCount; key++) {
+		float time = SKELETAL_ANIMATION_DURATION * key / (SKELETAL_ANIMATION_KEYS_COUNT - 1);
+
+		VectorKey positionKey;
+		positionKey.value = glm::vec3 (unit (random), unit (random), unit (random));
+		positionKey.time = time;
+		animationNode->AddPositionKey (positionKey);
+
+		QuatKey rotationKey;
+		rotationKey.value = glm::normalize (glm::quat (unit (random) + 2.0f, unit (random), unit (random), unit (random)));
+		rotationKey.time = time;
+		animationNode->AddRotationKey (rotationKey);
+
+		VectorKey scalingKey;
+		scalingKey.value = glm::vec3 (1.0f) + 0.25f * glm::vec3 (unit (random), unit (random), unit (random));
+		scalingKey.time = time;
+		animationNode->AddScalingKey (scalingKey);
+	}
+
+	return animationNode;
+}
+
+inline AnimationModel* GenerateSkeletalAnimationModel ()
+{
+	std::mt19937 random (7);
+
+	std::vector<BoneNode*> nodes;
+
+	for (std::size_t index = 0; index < SKELETAL_ANIMATION_NODES_COUNT; index++) {
+		BoneNode* parent = index == 0 ? nullptr : nodes [index - 1 - random () % std::min<std::size_t> (index, 4)];
+
+		BoneNode* boneNode = new BoneNode (parent);
+
+		boneNode->SetName ("node" + std::to_string (index));
+		boneNode->SetTransform (GenerateSkeletalAnimationTransform (random));
+
+		if (parent != nullptr) {
+			parent->AddChild (boneNode);
+		}
+
+		nodes.push_back (boneNode);
+	}
+
+	BoneTree* boneTree = new BoneTree ();
+	boneTree->SetRoot (nodes [0]);
+
+	AnimationContainer* animationContainer = new AnimationContainer ();
+
+	animationContainer->SetName ("");
+	animationContainer->SetDuration (SKELETAL_ANIMATION_DURATION);
+	animationContainer->SetTicksPerSecond (SKELETAL_ANIMATION_TICKS_PER_SECOND);
+
+	for (std::size_t index = 0; index < SKELETAL_ANIMATION_NODES_COUNT; index++) {
+		if (index % 7 != 3) {
+			animationContainer->AddAnimationNode (nodes [index]->GetName (), GenerateSkeletalAnimationNode (random));
+		}
+	}
+
+	AnimationsController* animationsController = new AnimationsController ();
+	animationsController->AddAnimationContainer (animationContainer);
+
+	AnimationModel* animationModel = new AnimationModel ();
+
+	animationModel->SetBoneTree (boneTree);
+	animationModel->SetAnimationsController (animationsController);
+
+	/*
+	 * Bones are added shuffled, the root never is one
+	*/
+
+	std::vector<std::size_t> boneNodes;
+
+	for (std::size_t index = 1; index <= SKELETAL_ANIMATION_BONES_COUNT; index++) {
+		boneNodes.push_back (index);
+	}
+
+	std::shuffle (boneNodes.begin (), boneNodes.end (), random);
+
+	for (std::size_t index : boneNodes) {
+		BoneInfo* boneInfo = new BoneInfo ();
+
+		boneInfo->SetName (nodes [index]->GetName ());
+		boneInfo->SetTransformMatrix (glm::inverse (GenerateSkeletalAnimationTransform (random)));
+
+		animationModel->AddBone (boneInfo);
+	}
+
+	return animationModel;
+}
+
+/*
+ * The evaluator the renderer used before the skeleton was flattened. It
+ * walks the bone tree and looks the channels and bones up by name every
+ * time, and searches the keys from the first one. The rotation search
+ * walks the rotation keys, the scaling ones it used to walk were a bug.
+*/
+
+class RecursiveSkeletalAnimation
+{
+protected:
+	AnimationModel* _animationModel;
+	AnimationContainer* _animationContainer;
+
+public:
+	RecursiveSkeletalAnimation (AnimationModel* animationModel) :
+		_animationModel (animationModel),
+		_animationContainer (animationModel->GetAnimationsController ()->GetAnimationContainer (""))
+	{
+
+	}
+
+	void Evaluate (float animationTime, std::vector<glm::mat4>& boneTransform)
+	{
+		boneTransform.assign (_animationModel->GetBoneCount (), glm::mat4 (1.0f));
+
+		BoneTree* boneTree = _animationModel->GetBoneTree ();
+
+		glm::mat4 globalInverse = glm::inverse (boneTree->GetRoot ()->GetTransform ());
+
+		ProcessBoneTransform (glm::mat4 (1.0f), boneTree->GetRoot (), globalInverse, animationTime, boneTransform);
+	}
+
+protected:
+	void ProcessBoneTransform (const glm::mat4& parentTransform, BoneNode* boneNode,
+		const glm::mat4& inverseGlobalMatrix, float animationTime, std::vector<glm::mat4>& boneTransform)
+	{
+		std::string nodeName = boneNode->GetName ();
+		glm::mat4 nodeTransform = boneNode->GetTransform ();
+
+		AnimationNode* animNode = _animationContainer->GetAnimationNode (nodeName);
+
+		if (animNode != nullptr) {
+			glm::mat4 scalingM = glm::scale (glm::mat4 (1.0f), CalcInterpolatedScaling (animationTime, animNode));
+			glm::mat4 rotationM = glm::mat4_cast (CalcInterpolatedRotation (animationTime, animNode));
+			glm::mat4 translationM = glm::translate (glm::mat4 (1.0f), CalcInterpolatedPosition (animationTime, animNode));
+
+			nodeTransform = translationM * rotationM * scalingM;
+		}
+
+		glm::mat4 globalTransformation = parentTransform * nodeTransform;
+
+		BoneInfo* boneInfo = _animationModel->GetBone (nodeName);
+
+		if (boneInfo != nullptr) {
+			boneTransform [boneInfo->GetID ()] = (inverseGlobalMatrix * globalTransformation) * boneInfo->GetTransformMatrix ();
+		}
+
+		for (std::size_t i=0;i<boneNode->GetChildrenCount ();i++) {
+			ProcessBoneTransform (globalTransformation, boneNode->GetChild (i),
+				inverseGlobalMatrix, animationTime, boneTransform);
+		}
+	}
+
+	static glm::quat CalcInterpolatedRotation (float animationTime, AnimationNode* animNode)
+	{
+		if (animNode->GetRotationKeysCount () == 1) {
+			return animNode->GetRotationKey (0).value;
+		}
+
+		std::size_t rotationIndex = 0;
+
+		while (rotationIndex < animNode->GetRotationKeysCount () - 1 &&
+			animNode->GetRotationKey (rotationIndex + 1).time < animationTime) {
+			++ rotationIndex;
+		}
+
+		QuatKey start = animNode->GetRotationKey (rotationIndex);
+		QuatKey end = animNode->GetRotationKey (rotationIndex + 1);
+
+		float factor = (animationTime - start.time) / (end.time - start.time);
+
+		return glm::normalize (glm::slerp (start.value, end.value, factor));
+	}
+
+	static glm::vec3 CalcInterpolatedScaling (float animationTime, AnimationNode* animNode)
+	{
+		if (animNode->GetScalingKeysCount () == 1) {
+			return animNode->GetScalingKey (0).value;
+		}
+
+		std::size_t scalingIndex = 0;
+
+		while (scalingIndex < animNode->GetScalingKeysCount () - 1 &&
+			animNode->GetScalingKey (scalingIndex + 1).time < animationTime) {
+			++ scalingIndex;
+		}
+
+		VectorKey start = animNode->GetScalingKey (scalingIndex);
+		VectorKey end = animNode->GetScalingKey (scalingIndex + 1);
+
+		float factor = (animationTime - start.time) / (end.time - start.time);
+
+		return start.value + factor * (end.value - start.value);
+	}
+
+	static glm::vec3 CalcInterpolatedPosition (float animationTime, AnimationNode* animNode)
+	{
+		if (animNode->GetPositionKeysCount () == 1) {
+			return animNode->GetPositionKey (0).value;
+		}
+
+		std::size_t positionIndex = 0;
+
+		while (positionIndex < animNode->GetPositionKeysCount () - 1 &&
+			animNode->GetPositionKey (positionIndex + 1).time < animationTime) {
+			++ positionIndex;
+		}
+
+		VectorKey start = animNode->GetPositionKey (positionIndex);
+		VectorKey end = animNode->GetPositionKey (positionIndex + 1);
+
+		float factor = (animationTime - start.time) / (end.time - start.time);
+
+		return start.value + factor * (end.value - start.value);
+	}
+};
+
+#endif
@@ -0,0 +1,225 @@
+#include <cstdio>
+#include <vector>
+
+#include "SceneGraph/Transform.h"
+#include "SceneGraph/TransformHierarchy.h"
+
+#include "Core/Math/glm/gtx/transform.hpp"
+
+#include "BenchmarkClock.h"
+
+/*
+ * A frame of the scene graph: a node is moved, then the model matrix of
+ * every node is read, as the renderers do. The transform hierarchy keeps
+ * the world matrices cached and refreshes the dirty ones once per frame.
+ * The transforms before it walked the parent chain on every read, they
+ * are rebuilt here on the same trees.
+ *
+ * A wide hierarchy is made of many small trees, a deep one of a single
+ * chain.
+*/
+
+#define BENCHMARK_RUNS_COUNT 5
+#define BENCHMARK_FRAMES_COUNT 10
+#define BENCHMARK_WIDE_NODES_COUNT 100000
+#define BENCHMARK_WIDE_CHILDREN_COUNT 9
+#define BENCHMARK_DEEP_NODES_COUNT 5000
+
+/*
+ * A transform as it was, the position and scale of the parents are
+ * added and multiplied on every read
+*/
+
+struct WalkTransform
+{
+	glm::vec3 position;
+	glm::quat rotation;
+	glm::vec3 scale;
+	WalkTransform* parent;
+
+	glm::vec3 GetPosition () const
+	{
+		glm::vec3 result (position);
+
+		for (WalkTransform* node = parent; node; node = node->parent) {
+			result += node->position;
+		}
+
+		return result;
+	}
+
+	glm::vec3 GetScale () const
+	{
+		glm::vec3 result (scale);
+
+		for (WalkTransform* node = parent; node; node = node->parent) {
+			result *= node->scale;
+		}
+
+		return result;
+	}
+
+	glm::mat4 GetModelMatrix () const
+	{
+		return glm::translate (glm::mat4 (1.0f), GetPosition ()) *
+			glm::scale (glm::mat4 (1.0f), GetScale ()) * glm::mat4_cast (rotation);
+	}
+};
+
+/*
+ * Parent of every node, -1 for the roots, parents before children
+*/
+
+static std::vector<int> BuildWideParents ()
+{
+	std::vector<int> parents;
+
+	while (parents.size () < BENCHMARK_WIDE_NODES_COUNT) {
+		int root = (int) parents.size ();
+
+		parents.push_back (-1);
+
+		for (std::size_t child = 0; child < BENCHMARK_WIDE_CHILDREN_COUNT && parents.size () < BENCHMARK_WIDE_NODES_COUNT; child++) {
+			parents.push_back (root);
+		}
+	}
+
+	return parents;
+}
+
+static std::vector<int> BuildDeepParents ()
+{
+	std::vector<int> parents;
+
+	for (std::size_t node = 0; node < BENCHMARK_DEEP_NODES_COUNT; node++) {
+		parents.push_back ((int) node - 1);
+	}
+
+	return parents;
+}
+
+static glm::vec3 GetLocalPosition (std::size_t node)
+{
+	return glm::vec3 ((float) (node % 7), 0.5f, (float) (node % 3)) * 0.01f;
+}
+
+static std::vector<WalkTransform> BuildWalkTransforms (const std::vector<int>& parents)
+{
+	std::vector<WalkTransform> transforms (parents.size ());
+
+	for (std::size_t node = 0; node < parents.size (); node++) {
+		transforms [node].position = GetLocalPosition (node);
+		transforms [node].rotation = glm::quat ();
+		transforms [node].scale = glm::vec3 (1.0f);
+		transforms [node].parent = parents [node] == -1 ? nullptr : &transforms [parents [node]];
+	}
+
+	return transforms;
+}
+
+static float RunWalkFrames (std::vector<WalkTransform>& transforms, std::size_t movedNode)
+{
+	float sum = 0.0f;
+
+	for (std::size_t frame = 0; frame < BENCHMARK_FRAMES_COUNT; frame++) {
+		transforms [movedNode].position.x += 0.1f;
+
+		for (const WalkTransform& transform : transforms) {
+			sum += transform.GetModelMatrix () [3][0];
+		}
+	}
+
+	return sum;
+}
+
+class HierarchyFrames
+{
+protected:
+	std::vector<Transform*> _transforms;
+
+public:
+	HierarchyFrames (const std::vector<int>& parents) :
+		_transforms ()
+	{
+		for (std::size_t node = 0; node < parents.size (); node++) {
+			Transform* transform = new Transform ();
+
+			if (parents [node] != -1) {
+				transform->SetParent (_transforms [parents [node]]);
+			}
+
+			transform->SetPosition (GetLocalPosition (node));
+
+			_transforms.push_back (transform);
+		}
+
+		TransformHierarchy::Instance ()->Update ();
+	}
+
+	~HierarchyFrames ()
+	{
+		for (std::size_t node = _transforms.size (); node > 0; node--) {
+			delete _transforms [node - 1];
+		}
+	}
+
+	float Run (std::size_t movedNode)
+	{
+		float sum = 0.0f;
+
+		for (std::size_t frame = 0; frame < BENCHMARK_FRAMES_COUNT; frame++) {
+			if (movedNode < _transforms.size ()) {
+				Transform* transform = _transforms [movedNode];
+
+				transform->SetPosition (transform->GetLocalPosition () + glm::vec3 (0.1f, 0.0f, 0.0f));
+			}
+
+			TransformHierarchy::Instance ()->Update ();
+
+			for (Transform* transform : _transforms) {
+				sum += transform->GetModelMatrix () [3][0];
+			}
+		}
+
+		return sum;
+	}
+};
+
+static void BenchmarkHierarchy (const char* name, const std::vector<int>& parents, std::size_t middleNode)
+{
+	volatile float sink = 0.0f;
+
+	std::vector<WalkTransform> walkTransforms = BuildWalkTransforms (parents);
+
+	double walkTime = MeasureMS (BENCHMARK_RUNS_COUNT, [&] () {
+		sink = sink + RunWalkFrames (walkTransforms, 0);
+	}) / BENCHMARK_FRAMES_COUNT;
+
+	HierarchyFrames hierarchy (parents);
+
+	double rootTime = MeasureMS (BENCHMARK_RUNS_COUNT, [&] () {
+		sink = sink + hierarchy.Run (0);
+	}) / BENCHMARK_FRAMES_COUNT;
+
+	double middleTime = MeasureMS (BENCHMARK_RUNS_COUNT, [&] () {
+		sink = sink + hierarchy.Run (middleNode);
+	}) / BENCHMARK_FRAMES_COUNT;
+
+	double stillTime = MeasureMS (BENCHMARK_RUNS_COUNT, [&] () {
+		sink = sink + hierarchy.Run (parents.size ());
+	}) / BENCHMARK_FRAMES_COUNT;
+
+	std::printf ("%10s %8zu %12.3f %12.3f %12.3f %12.3f\n", name, parents.size (),
+		walkTime, rootTime, middleTime, stillTime);
+}
+
+int main ()
+{
+	std::printf ("Transforms, milliseconds per frame to move a node and read every model matrix\n");
+	std::printf ("%10s %8s %12s %12s %12s %12s\n", "hierarchy", "nodes", "walk", "root moved", "middle moved", "none moved");
+
+	BenchmarkHierarchy ("wide", BuildWideParents (), BENCHMARK_WIDE_NODES_COUNT / 2);
+	BenchmarkHierarchy ("deep", BuildDeepParents (), BENCHMARK_DEEP_NODES_COUNT / 2);
+
+	return 0;
+}
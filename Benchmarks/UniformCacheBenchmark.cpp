@@ -0,0 +1,284 @@
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include "Wrappers/OpenGL/GL.h"
+#include "Wrappers/OpenGL/GLNullBackend.h"
+
+#include "Renderer/Pipeline.h"
+#include "Renderer/StreamingBuffer.h"
+#include "Shader/Shader.h"
+#include "Cameras/PerspectiveCamera.h"
+
+#include "SceneGraph/Transform.h"
+#include "SceneGraph/TransformHierarchy.h"
+
+#include "Core/Math/glm/gtc/matrix_transform.hpp"
+#include "Core/Math/glm/gtc/type_ptr.hpp"
+
+#include "BenchmarkClock.h"
+
+/*
+ * Uniforms sent by the geometry pass, through the null backend which
+ * counts the calls. The pipeline keeps the view matrices in a uniform
+ * buffer updated once per view, writes the object matrices to the object
+ * block once per object change, reads the materials from the material
+ * block and sends a value through the shader only when it is not the
+ * one the program already holds. The pipeline before it sent
+ * every matrix and every material value on every polygon group, and
+ * bound the program each time; it is rebuilt here on the same frames.
+*/
+
+#define BENCHMARK_RUNS_COUNT 3
+#define BENCHMARK_FRAMES_COUNT 5
+#define BENCHMARK_GROUPS_COUNT 6
+#define BENCHMARK_MATERIALS_COUNT 24
+#define BENCHMARK_SHADERS_COUNT 3
+#define BENCHMARK_VIEWS_COUNT 2
+
+struct BenchmarkMaterial
+{
+	glm::vec3 diffuseColor;
+	glm::vec3 specularColor;
+	float shininess;
+	int diffuseMap;
+	int specularMap;
+	int normalMap;
+	int alphaMap;
+};
+
+struct BenchmarkObject
+{
+	Transform* transform;
+	Shader* shader;
+	std::size_t materials [BENCHMARK_GROUPS_COUNT];
+};
+
+/*
+ * The pipeline as it was, everything is sent on every group
+*/
+
+struct UncachedPipeline
+{
+	glm::mat4 modelMatrix;
+	glm::mat4 viewMatrix;
+	glm::mat4 projectionMatrix;
+	glm::vec3 cameraPosition;
+
+	void SendCamera (Camera* camera)
+	{
+		cameraPosition = camera->GetPosition ();
+		viewMatrix = glm::translate (glm::mat4_cast (camera->GetRotation ()), cameraPosition * -1.0f);
+	}
+
+	void UpdateMatrices (Shader* shader)
+	{
+		glm::mat4 modelViewMatrix = viewMatrix * modelMatrix;
+		glm::mat4 viewProjectionMatrix = projectionMatrix * viewMatrix;
+		glm::mat4 modelViewProjectionMatrix = projectionMatrix * viewMatrix * modelMatrix;
+
+		glm::mat3 normalWorldMatrix = glm::transpose (glm::inverse (glm::mat3 (modelViewMatrix)));
+		glm::mat3 normalMatrix = glm::transpose (glm::inverse (glm::mat3 (modelMatrix)));
+
+		glm::mat4 inverseViewProjectionMatrix = glm::inverse (modelViewProjectionMatrix);
+
+		GL::UniformMatrix4fv (shader->GetUniformLocation ("modelMatrix"), 1, GL_FALSE, glm::value_ptr (modelMatrix));
+		GL::UniformMatrix4fv (shader->GetUniformLocation ("viewMatrix"), 1, GL_FALSE, glm::value_ptr (viewMatrix));
+		GL::UniformMatrix4fv (shader->GetUniformLocation ("modelViewMatrix"), 1, GL_FALSE, glm::value_ptr (modelViewMatrix));
+		GL::UniformMatrix4fv (shader->GetUniformLocation ("projectionMatrix"), 1, GL_FALSE, glm::value_ptr (projectionMatrix));
+		GL::UniformMatrix4fv (shader->GetUniformLocation ("viewProjectionMatrix"), 1, GL_FALSE, glm::value_ptr (viewProjectionMatrix));
+		GL::UniformMatrix4fv (shader->GetUniformLocation ("modelViewProjectionMatrix"), 1, GL_FALSE, glm::value_ptr (modelViewProjectionMatrix));
+		GL::UniformMatrix3fv (shader->GetUniformLocation ("normalMatrix"), 1, GL_FALSE, glm::value_ptr (normalMatrix));
+		GL::UniformMatrix3fv (shader->GetUniformLocation ("normalWorldMatrix"), 1, GL_FALSE, glm::value_ptr (normalWorldMatrix));
+		GL::UniformMatrix4fv (shader->GetUniformLocation ("inverseViewProjectionMatrix"), 1, GL_FALSE, glm::value_ptr (inverseViewProjectionMatrix));
+		GL::Uniform3fv (shader->GetUniformLocation ("cameraPosition"), 1, glm::value_ptr (cameraPosition));
+	}
+
+	void SendMaterial (const BenchmarkMaterial& material, Shader* shader)
+	{
+		GL::UseProgram (shader->GetProgram ());
+
+		UpdateMatrices (shader);
+
+		GL::Uniform3fv (shader->GetUniformLocation ("MaterialDiffuse"), 1, glm::value_ptr (material.diffuseColor));
+		GL::Uniform3fv (shader->GetUniformLocation ("MaterialSpecular"), 1, glm::value_ptr (material.specularColor));
+		GL::Uniform1f (shader->GetUniformLocation ("MaterialShininess"), material.shininess);
+		GL::Uniform1i (shader->GetUniformLocation ("DiffuseMap"), material.diffuseMap);
+		GL::Uniform1i (shader->GetUniformLocation ("SpecularMap"), material.specularMap);
+		GL::Uniform1i (shader->GetUniformLocation ("NormalMap"), material.normalMap);
+		GL::Uniform1i (shader->GetUniformLocation ("AlphaMap"), material.alphaMap);
+	}
+};
+
+/*
+ * The material uniforms as Pipeline::SendMaterial sends them now, the
+ * colors are in the material block already
+*/
+
+static void SendCachedMaterial (std::size_t materialID, const BenchmarkMaterial& material, Shader* shader)
+{
+	Pipeline::SetShader (shader);
+	Pipeline::UpdateMatrices (shader);
+
+	shader->SetUniform (shader->GetUniformLocation ("materialIndex"), (int) materialID);
+	shader->SetUniform (shader->GetUniformLocation ("DiffuseMap"), material.diffuseMap);
+	shader->SetUniform (shader->GetUniformLocation ("SpecularMap"), material.specularMap);
+	shader->SetUniform (shader->GetUniformLocation ("NormalMap"), material.normalMap);
+	shader->SetUniform (shader->GetUniformLocation ("AlphaMap"), material.alphaMap);
+}
+
+static void DrawUncachedFrame (UncachedPipeline& pipeline, const std::vector<Camera*>& views,
+	const std::vector<BenchmarkObject>& objects, const std::vector<BenchmarkMaterial>& materials)
+{
+	for (Camera* view : views) {
+		pipeline.SendCamera (view);
+		pipeline.projectionMatrix = view->GetProjectionMatrix ();
+
+		for (const BenchmarkObject& object : objects) {
+			pipeline.modelMatrix = object.transform->GetModelMatrix ();
+
+			for (std::size_t group = 0; group < BENCHMARK_GROUPS_COUNT; group++) {
+				pipeline.SendMaterial (materials [object.materials [group]], object.shader);
+
+				GL::DrawElements (GL_TRIANGLES, 36, GL_UNSIGNED_INT, nullptr);
+			}
+		}
+	}
+
+	GL::EndFrame ();
+}
+
+static void DrawCachedFrame (const std::vector<Camera*>& views,
+	const std::vector<BenchmarkObject>& objects, const std::vector<BenchmarkMaterial>& materials)
+{
+	StreamingBuffer::Instance ()->BeginFrame ();
+
+	for (Camera* view : views) {
+		Pipeline::SendCamera (view);
+		Pipeline::CreateProjection (view);
+
+		for (const BenchmarkObject& object : objects) {
+			Pipeline::SetObjectTransform (object.transform);
+
+			for (std::size_t group = 0; group < BENCHMARK_GROUPS_COUNT; group++) {
+				SendCachedMaterial (object.materials [group], materials [object.materials [group]], object.shader);
+
+				GL::DrawElements (GL_TRIANGLES, 36, GL_UNSIGNED_INT, nullptr);
+			}
+		}
+	}
+
+	StreamingBuffer::Instance ()->EndFrame ();
+
+	GL::EndFrame ();
+}
+
+int main ()
+{
+	GLNullBackend* backend = new GLNullBackend ();
+
+	GL::SetBackend (backend);
+
+	/*
+	 * The wrapper filter of redundant binds is off, the program binds
+	 * skipped are the ones of the pipeline
+	*/
+
+	GL::SetStateCaching (false);
+
+	std::vector<Shader*> shaders;
+
+	for (std::size_t index = 0; index < BENCHMARK_SHADERS_COUNT; index++) {
+		shaders.push_back (new Shader ("Shader" + std::to_string (index), GL::CreateProgram ()));
+	}
+
+	std::vector<BenchmarkMaterial> materials (BENCHMARK_MATERIALS_COUNT);
+
+	for (std::size_t index = 0; index < BENCHMARK_MATERIALS_COUNT; index++) {
+		materials [index].diffuseColor = glm::vec3 (0.1f * (index % 10), 0.5f, 0.5f);
+		materials [index].specularColor = glm::vec3 (0.2f);
+		materials [index].shininess = 8.0f + index;
+		materials [index].diffuseMap = 1;
+		materials [index].specularMap = (int) (index % 2) * 2;
+		materials [index].normalMap = 0;
+		materials [index].alphaMap = 0;
+	}
+
+	/*
+	 * A second view stands for the reflection or the shadow pass of a
+	 * frame, it draws the same objects
+	*/
+
+	std::vector<Camera*> views;
+
+	for (std::size_t index = 0; index < BENCHMARK_VIEWS_COUNT; index++) {
+		Camera* view = new PerspectiveCamera ();
+
+		view->SetPosition (glm::vec3 (0.0f, 5.0f + 10.0f * index, -20.0f));
+		view->SetRotation (glm::vec3 (0.3f * index, 0.1f, 0.0f));
+
+		views.push_back (view);
+	}
+
+	std::printf ("Geometry pass uniforms, %d groups per object, %d materials, %d shaders, %d views\n",
+		BENCHMARK_GROUPS_COUNT, BENCHMARK_MATERIALS_COUNT, BENCHMARK_SHADERS_COUNT, BENCHMARK_VIEWS_COUNT);
+	std::printf ("%8s %13s %13s %11s %11s\n", "objects", "before calls", "after calls", "before ms", "after ms");
+
+	std::vector<std::size_t> objectsCounts = {30, 300, 1000};
+
+	for (std::size_t objectsCount : objectsCounts) {
+		std::vector<BenchmarkObject> objects (objectsCount);
+
+		for (std::size_t index = 0; index < objectsCount; index++) {
+			objects [index].transform = new Transform ();
+			objects [index].transform->SetPosition (glm::vec3 ((float) (index % 50), 0.0f, (float) (index / 50)));
+			objects [index].shader = shaders [index % BENCHMARK_SHADERS_COUNT];
+
+			for (std::size_t group = 0; group < BENCHMARK_GROUPS_COUNT; group++) {
+				objects [index].materials [group] = (index * 7 + group) % BENCHMARK_MATERIALS_COUNT;
+			}
+		}
+
+		TransformHierarchy::Instance ()->Update ();
+
+		UncachedPipeline uncachedPipeline;
+
+		double beforeTime = MeasureMS (BENCHMARK_RUNS_COUNT, [&] () {
+			for (std::size_t frame = 0; frame < BENCHMARK_FRAMES_COUNT; frame++) {
+				DrawUncachedFrame (uncachedPipeline, views, objects, materials);
+			}
+		}) / BENCHMARK_FRAMES_COUNT;
+
+		std::size_t beforeCallsCount = backend->GetFrameStatistics ().callsCount;
+
+		double afterTime = MeasureMS (BENCHMARK_RUNS_COUNT, [&] () {
+			for (std::size_t frame = 0; frame < BENCHMARK_FRAMES_COUNT; frame++) {
+				DrawCachedFrame (views, objects, materials);
+			}
+		}) / BENCHMARK_FRAMES_COUNT;
+
+		std::size_t afterCallsCount = backend->GetFrameStatistics ().callsCount;
+
+		std::printf ("%8zu %13zu %13zu %11.3f %11.3f\n", objectsCount,
+			beforeCallsCount, afterCallsCount, beforeTime, afterTime);
+
+		for (BenchmarkObject& object : objects) {
+			delete object.transform;
+		}
+	}
+
+	for (Camera* view : views) {
+		delete view;
+	}
+
+	for (Shader* shader : shaders) {
+		delete shader;
+	}
+
+	/*
+	 * The null backend stays, the streaming buffer deletes its buffer
+	 * when the program exits
+	*/
+
+	return 0;
+}
@@ -0,0 +1,71 @@
+#ifndef WAVEFRONTMODELGENERATOR_H
+#define WAVEFRONTMODELGENERATOR_H
+
+#include <string>
+#include <fstream>
+#include <random>
+#include <cstdio>
+
+/*
+ * Model the benchmarks load instead of a scene, it is always the same.
+ * Every number format the loader reads is in it and polygons with three
+ * to five corners. Returns the size of the file.
+*/
+
+#define WAVEFRONT_MODEL_OBJECTS_COUNT 40
+#define WAVEFRONT_MODEL_VERTICES_COUNT 3000
+#define WAVEFRONT_MODEL_FACES_COUNT 3000
+
+inline std::size_t GenerateWavefrontModel (const std::string& filename)
+{
+	std::ofstream stream (filename);
+
+	std::mt19937 random (3);
+	std::uniform_real_distribution<float> coordinate (-3000.0f, 3000.0f);
+	std::uniform_real_distribution<float> unit (0.0f, 1.0f);
+
+	const char* formats [] = {"%.6f", "%.8f", "%g", "%.3e"};
+
+	std::size_t verticesCount = 0;
+	char line [256];
+
+	for (std::size_t object = 0; object < WAVEFRONT_MODEL_OBJECTS_COUNT; object++) {
+		stream << "o object" << object << "\n";
+
+		for (std::size_t vertex = 0; vertex < WAVEFRONT_MODEL_VERTICES_COUNT; vertex++) {
+			const char* format = formats [random () % 4];
+
+			std::string vertexFormat = std::string ("v ") + format + " " + format + " " + format + "\n";
+			std::snprintf (line, sizeof (line), vertexFormat.c_str (), coordinate (random), coordinate (random), coordinate (random));
+			stream << line;
+
+			std::snprintf (line, sizeof (line), "vn %.6f %.6f %.6f\n", unit (random), unit (random), unit (random));
+			stream << line;
+
+			std::snprintf (line, sizeof (line), "vt %.6f %.6f\n", unit (random), unit (random));
+			stream << line;
+
+			verticesCount ++;
+		}
+
+		stream << "g group" << object << "\nusemtl material" << object % 5 << "\n";
+
+		for (std::size_t face = 0; face < WAVEFRONT_MODEL_FACES_COUNT; face++) {
+			std::size_t cornersCount = 3 + random () % 3;
+
+			stream << "f";
+
+			for (std::size_t corner = 0; corner < cornersCount; corner++) {
+				std::size_t index = 1 + random () % verticesCount;
+
+				stream << " " << index << "/" << index << "/" << index;
+			}
+
+			stream << "\n";
+		}
+	}
+
+	return (std::size_t) stream.tellp ();
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,57 @@
+#include <cstdio>
+#include <string>
+#include <set>
+#include <thread>
+#include <algorithm>
+
+#include "Resources/WavefrontObjectLoader.h"
+#include "Mesh/Model.h"
+
+#include "Utils/Threads/JobSystem.h"
+
+#include "BenchmarkClock.h"
+#include "WavefrontModelGenerator.h"
+
+/*
+ * Parse throughput of the Wavefront loader over job system sizes, on a
+ * generated model
+*/
+
+#define BENCHMARK_FILENAME "WavefrontObjectLoaderBenchmark.obj"
+#define BENCHMARK_RUNS_COUNT 3
+
+int main ()
+{
+	std::size_t size = GenerateWavefrontModel (BENCHMARK_FILENAME);
+	double sizeMB = size / (1024.0 * 1024.0);
+
+	std::printf ("Wavefront loader, %.1f MB model\n", sizeMB);
+	std::printf ("%8s %12s %10s\n", "workers", "time (ms)", "MB/s");
+
+	std::size_t maxWorkersCount = std::max (std::thread::hardware_concurrency (), 2u) - 1;
+
+	std::set<std::size_t> workersCounts = {0, 1, 3, maxWorkersCount};
+
+	for (std::size_t workersCount : workersCounts) {
+		if (workersCount > maxWorkersCount) {
+			continue;
+		}
+
+		JobSystem::Instance ()->Start (workersCount);
+
+		double time = MeasureMS (BENCHMARK_RUNS_COUNT, [] () {
+			WavefrontObjectLoader loader;
+			loader.SetLoadMaterials (false);
+
+			delete (Model*) loader.Load (BENCHMARK_FILENAME);
+		});
+
+		JobSystem::Instance ()->Stop ();
+
+		std::printf ("%8zu %12.1f %10.1f\n", workersCount, time, sizeMB / (time / 1000.0));
+	}
+
+	std::remove (BENCHMARK_FILENAME);
+
+	return 0;
+}
\ No newline at end of file
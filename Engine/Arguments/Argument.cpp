@@ -1,5 +1,10 @@
 #include "Argument.h"
 
+#include <cerrno>
+#include <cstdlib>
+
+#include "Core/Console/Console.h"
+
 Argument::Argument (const std::string& name, const std::string& arg) :
 	_name (name)
 {
@@ -20,4 +25,28 @@ const std::string& Argument::GetName ()
 const std::vector<std::string>& Argument::GetArgs ()
 {
 	return _args;
+}
+
+bool Argument::GetIntValue (long& value)
+{
+	if (_args.empty () || _args [0] == "") {
+		return false;
+	}
+
+	const char* text = _args [0].c_str ();
+	char* end = nullptr;
+
+	errno = 0;
+
+	long result = std::strtol (text, &end, 10);
+
+	if (end == text || *end != '\0' || errno == ERANGE) {
+		Console::LogWarning ("Argument " + _name + " needs a whole number, " + _args [0] + " is ignored");
+
+		return false;
+	}
+
+	value = result;
+
+	return true;
 }
\ No newline at end of file
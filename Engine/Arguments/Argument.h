@@ -16,6 +16,13 @@ public:
 
 	const std::string& GetName ();
 	const std::vector<std::string>& GetArgs ();
+
+	/*
+	 * The value as a whole number. A value that is not one is logged and
+	 * left out, as if the option had been given no value.
+	*/
+
+	bool GetIntValue (long& value);
 };
 
 #endif
\ No newline at end of file
@@ -16,6 +16,10 @@
 
 #include "Settings/GeneralSettings.h"
 
+#include "RenderPasses/VoxelVolumeConfiguration.h"
+
+#include "Renderer/StaticGeometryArena.h"
+
 void RenderModulesController::Start ()
 {
 	_sun = SceneManager::Instance ()->Current ()->GetObject ("Sun");
@@ -28,12 +32,13 @@ void RenderModulesController::Start ()
 	GeneralSettings::Instance ()->SetIntValue ("RadianceInjection", 1);
 	GeneralSettings::Instance ()->SetIntValue ("VoxelVolumeMipmapLevel", 0);
 	GeneralSettings::Instance ()->SetIntValue ("ContinousVoxelizationPass", 1);
+	GeneralSettings::Instance ()->SetIntValue ("IncrementalVoxelization", 1);
 
 	Font* font = Resources::LoadBitmapFont ("Assets/Fonts/Fonts/sans.fnt");
 
-	_textGUI = new TextGUI* [3];
+	_textGUI = new TextGUI* [6];
 
-	for (std::size_t index = 0; index < 3; index++) {
+	for (std::size_t index = 0; index < 6; index++) {
 		_textGUI [index] = new TextGUI ("", font, glm::vec2 (0.0f, 0.0f + index * 0.05f));
 		_textGUI [index]->GetTransform ()->SetScale (glm::vec3 (0.7f , 0.7f, 0.0f));
 		SceneManager::Instance ()->Current ()->AttachObject (_textGUI [index]);
@@ -98,7 +103,7 @@ void RenderModulesController::Update ()
 		}
 
 		if (modifier != 0) {
-			const int maxMipmapLevel = 6;
+			const int maxMipmapLevel = VoxelVolumeConfiguration::FromSettings ().mipmapLevels - 1;
 
 			int currentMipmapLevel = GeneralSettings::Instance ()->GetIntValue ("VoxelVolumeMipmapLevel");
 			int nextMipmapLevel = Extensions::MathExtend::Clamp (currentMipmapLevel + modifier, 0, maxMipmapLevel);
@@ -107,6 +112,35 @@ void RenderModulesController::Update ()
 		}
 	}
 
+	/*
+	 * Change voxel volume resolution, the volume is reallocated on the
+	 * next voxelization
+	*/
+
+	if (Input::GetKeyDown (InputKey::HOME) || Input::GetKeyDown (InputKey::END)) {
+		VoxelVolumeConfiguration configuration = VoxelVolumeConfiguration::FromSettings ();
+
+		std::size_t nextVolumeSize = Input::GetKeyDown (InputKey::HOME) ?
+			configuration.volumeSize * 2 : configuration.volumeSize / 2;
+
+		configuration = VoxelVolumeConfiguration (nextVolumeSize, configuration.mipmapLevels,
+			configuration.clipmapCascades, configuration.clipmapExtent);
+
+		GeneralSettings::Instance ()->SetIntValue (VOXEL_VOLUME_SIZE_SETTING, configuration.volumeSize);
+	}
+
+	/*
+	 * Cycle between the volume fitted to the scene and clipmaps with more
+	 * cascades around the camera
+	*/
+
+	if (Input::GetKeyDown (InputKey::B)) {
+		int currentClipmapCascades = VoxelVolumeConfiguration::FromSettings ().clipmapCascades;
+		int nextClipmapCascades = (currentClipmapCascades + 1) % (VOXEL_CLIPMAP_MAX_CASCADES + 1);
+
+		GeneralSettings::Instance ()->SetIntValue (VOXEL_CLIPMAP_CASCADES_SETTING, nextClipmapCascades);
+	}
+
 	/*
 	 * Change radiance injection settings
 	*/
@@ -129,6 +163,28 @@ void RenderModulesController::Update ()
 		GeneralSettings::Instance ()->SetIntValue ("ContinousVoxelizationPass", nextContinousVoxelization);
 	}
 
+	/*
+	 * Revoxelize only what changed, or everything on every frame
+	*/
+
+	if (Input::GetKeyDown (InputKey::V)) {
+		int currentIncrementalVoxelization = GeneralSettings::Instance ()->GetIntValue ("IncrementalVoxelization");
+		int nextIncrementalVoxelization = !currentIncrementalVoxelization;
+
+		GeneralSettings::Instance ()->SetIntValue ("IncrementalVoxelization", nextIncrementalVoxelization);
+	}
+
+	/*
+	 * Switch the static geometry between multi draw and a draw per group
+	*/
+
+	if (Input::GetKeyDown (InputKey::M)) {
+		int currentIndirectDraw = GeneralSettings::Instance ()->GetIntValue (INDIRECT_DRAW_SETTING);
+		int nextIndirectDraw = !currentIndirectDraw;
+
+		GeneralSettings::Instance ()->SetIntValue (INDIRECT_DRAW_SETTING, nextIndirectDraw);
+	}
+
 	std::string renderModule;
 
 	switch (RenderManager::Instance ()->GetRenderMode ()) 
@@ -146,6 +202,14 @@ void RenderModulesController::Update ()
 
 	std::string voxelRadianceInjection = GeneralSettings::Instance ()->GetIntValue ("RadianceInjection") == 1 ? "ON" : " OFF";
 	std::string continouseVoxelizationPass = GeneralSettings::Instance ()->GetIntValue ("ContinousVoxelizationPass") == 1 ? "ON" : "OFF";
+	std::string incrementalVoxelization = GeneralSettings::Instance ()->GetIntValue ("IncrementalVoxelization") == 1 ? "ON" : "OFF";
+	std::string indirectDraw = GeneralSettings::Instance ()->GetIntValue (INDIRECT_DRAW_SETTING) == 1 ? "ON" : "OFF";
+
+	VoxelVolumeConfiguration voxelVolumeConfiguration = VoxelVolumeConfiguration::FromSettings ();
+	std::string voxelVolumeResolution = std::to_string (voxelVolumeConfiguration.volumeSize) + "^3, " +
+		std::to_string (voxelVolumeConfiguration.mipmapLevels) + " mipmaps, " +
+		(voxelVolumeConfiguration.clipmapCascades == 0 ? std::string ("fitted to scene") :
+			std::to_string (voxelVolumeConfiguration.clipmapCascades) + " cascades");
 
 	static bool activateText = false;
 
@@ -157,8 +221,11 @@ void RenderModulesController::Update ()
 		_textGUI [0]->SetText ("Render Module: " + renderModule);
 		_textGUI [1]->SetText ("Voxel Radiance Injection: " + voxelRadianceInjection);
 		_textGUI [2]->SetText ("Continous Voxelization: " + continouseVoxelizationPass);
+		_textGUI [3]->SetText ("Voxel Volume: " + voxelVolumeResolution);
+		_textGUI [4]->SetText ("Incremental Voxelization: " + incrementalVoxelization);
+		_textGUI [5]->SetText ("Indirect Draw: " + indirectDraw);
 	} else {
-		for (std::size_t index = 0; index < 3; index++) {
+		for (std::size_t index = 0; index < 6; index++) {
 			_textGUI [index]->SetText ("");
 		}
 	}
@@ -6,6 +6,7 @@
 #include "Debug/Statistics/StatisticsManager.h"
 #include "Debug/Statistics/StatisticsObject.h"
 #include "Debug/Statistics/DrawnObjectsCountStat.h"
+#include "Debug/Statistics/DrawListStat.h"
 
 void StatisticsView::Start ()
 {
@@ -14,6 +15,10 @@ void StatisticsView::Start ()
 	_textGUI = new TextGUI ("", font, glm::vec2 (0.0f, 0.0f));
 	_textGUI->GetTransform ()->SetScale (glm::vec3 (0.7f, 0.7f, 0.0f));
 	SceneManager::Instance ()->Current ()->AttachObject (_textGUI);
+
+	_drawListTextGUI = new TextGUI ("", font, glm::vec2 (0.0f, 0.05f));
+	_drawListTextGUI->GetTransform ()->SetScale (glm::vec3 (0.7f, 0.7f, 0.0f));
+	SceneManager::Instance ()->Current ()->AttachObject (_drawListTextGUI);
 }
 
 void StatisticsView::Update ()
@@ -22,4 +27,18 @@ void StatisticsView::Update ()
 	std::size_t drawnObjectsCount = dynamic_cast<DrawnObjectsCountStat*> (stat)->GetDrawnObjectsCount ();
 
 	_textGUI->SetText ("Total objects drawn: " + std::to_string (drawnObjectsCount));	
+
+	DrawListStat* drawListStat = dynamic_cast<DrawListStat*> (StatisticsManager::Instance ()->GetStatisticsObject ("DrawList"));
+
+	if (drawListStat == nullptr) {
+		return;
+	}
+
+	const DrawListStatistics& drawListStatistics = drawListStat->GetDrawListStatistics ();
+
+	_drawListTextGUI->SetText ("Draws: " + std::to_string (drawListStatistics.drawsCount) +
+		", shader changes: " + std::to_string (drawListStatistics.shaderChangesCount) +
+		", material changes: " + std::to_string (drawListStatistics.materialChangesCount) +
+		", indirect commands: " + std::to_string (drawListStatistics.indirectCommandsCount) +
+		", submit: " + std::to_string (drawListStatistics.submitTime) + " ms");
 }
@@ -10,6 +10,7 @@ class StatisticsView : public Component
 {
 protected:
 	TextGUI* _textGUI;
+	TextGUI* _drawListTextGUI;
 
 public:
 	void Start ();
@@ -5,18 +5,30 @@
 #include "Console.h"
 
 std::ofstream Console::_outStream("Console.log");
+std::mutex Console::_mutex;
+
+/*
+ * Resources are loaded on worker threads too, so every line is written
+ * under the lock
+*/
 
 void Console::Log (std::string message)
 {
+	std::lock_guard<std::mutex> lock (_mutex);
+
 	_outStream << message << std::endl;
 }
 
 void Console::LogError (std::string message)
 {
+	std::lock_guard<std::mutex> lock (_mutex);
+
 	_outStream << "Error: " << message << std::endl;
 }
 
 void Console::LogWarning (std::string message)
 {
+	std::lock_guard<std::mutex> lock (_mutex);
+
 	_outStream << "Warning: " << message << std::endl;
 }
\ No newline at end of file
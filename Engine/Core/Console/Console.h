@@ -3,6 +3,7 @@
 
 #include <string>
 #include <fstream>
+#include <mutex>
 
 // TODO: Make this to redirect to file
 
@@ -10,6 +11,7 @@ class Console
 {
 private:
 	static std::ofstream _outStream;
+	static std::mutex _mutex;
 
 public:
 	static void Log (std::string message);
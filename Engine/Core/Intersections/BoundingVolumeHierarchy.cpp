@@ -0,0 +1,417 @@
+#include "BoundingVolumeHierarchy.h"
+
+#include <algorithm>
+#include <limits>
+
+BoundingVolumeHierarchy::BoundingVolumeHierarchy () :
+	_nodes (),
+	_items (),
+	_itemsMinVertex (),
+	_itemsMaxVertex (),
+	_itemsLeaf (),
+	_itemsPosition (),
+	_leavesBoxes ()
+{
+
+}
+
+void BoundingVolumeHierarchy::Build (const std::vector<std::size_t>& items,
+	const std::vector<glm::vec3>& minVertices, const std::vector<glm::vec3>& maxVertices)
+{
+	Clear ();
+
+	if (items.empty ()) {
+		return;
+	}
+
+	std::size_t itemsRange = *std::max_element (items.begin (), items.end ()) + 1;
+
+	_itemsMinVertex.resize (itemsRange);
+	_itemsMaxVertex.resize (itemsRange);
+	_itemsLeaf.assign (itemsRange, -1);
+
+	for (std::size_t index = 0; index < items.size (); index++) {
+		_itemsMinVertex [items [index]] = minVertices [index];
+		_itemsMaxVertex [items [index]] = maxVertices [index];
+	}
+
+	_items = items;
+
+	/*
+	 * A binary tree with at least one item per leaf has less than twice
+	 * as many nodes as items
+	*/
+
+	_nodes.reserve (2 * items.size ());
+	_nodes.push_back (Node ());
+
+	BuildNode (0, -1, 0, _items.size ());
+
+	_itemsPosition.resize (itemsRange);
+	_leavesBoxes.Resize (_items.size ());
+
+	for (std::size_t position = 0; position < _items.size (); position++) {
+		_itemsPosition [_items [position]] = position;
+		_leavesBoxes.Set (position, _itemsMinVertex [_items [position]], _itemsMaxVertex [_items [position]]);
+	}
+}
+
+void BoundingVolumeHierarchy::Clear ()
+{
+	_nodes.clear ();
+	_items.clear ();
+	_itemsMinVertex.clear ();
+	_itemsMaxVertex.clear ();
+	_itemsLeaf.clear ();
+	_itemsPosition.clear ();
+	_leavesBoxes.Resize (0);
+}
+
+bool BoundingVolumeHierarchy::Contains (std::size_t item) const
+{
+	return item < _itemsLeaf.size () && _itemsLeaf [item] != -1;
+}
+
+/*
+ * Ancestors are updated until one of them keeps its box
+*/
+
+void BoundingVolumeHierarchy::Refit (std::size_t item, const glm::vec3& minVertex, const glm::vec3& maxVertex)
+{
+	if (!Contains (item)) {
+		return;
+	}
+
+	_itemsMinVertex [item] = minVertex;
+	_itemsMaxVertex [item] = maxVertex;
+
+	_leavesBoxes.Set (_itemsPosition [item], minVertex, maxVertex);
+
+	int nodeIndex = _itemsLeaf [item];
+
+	while (nodeIndex != -1) {
+		Node& node = _nodes [nodeIndex];
+
+		glm::vec3 lastMinVertex = node.minVertex;
+		glm::vec3 lastMaxVertex = node.maxVertex;
+
+		UpdateNodeBox (node);
+
+		if (node.minVertex == lastMinVertex && node.maxVertex == lastMaxVertex) {
+			break;
+		}
+
+		nodeIndex = node.parent;
+	}
+}
+
+/*
+ * Items visible from each frustum are returned in the list of the same
+ * index, frustums over BVH_MAX_QUERY_VIEWS get no items
+*/
+
+void BoundingVolumeHierarchy::Query (const std::vector<FrustumVolume*>& frustums,
+	std::vector<std::vector<std::size_t>>& visibleItems) const
+{
+	visibleItems.resize (frustums.size ());
+
+	for (std::size_t index = 0; index < visibleItems.size (); index++) {
+		visibleItems [index].clear ();
+	}
+
+	if (_nodes.empty ()) {
+		return;
+	}
+
+	FrustumVolume::FrustumVolumeInformation* frustumsData [BVH_MAX_QUERY_VIEWS];
+	std::uint8_t planeMasks [BVH_MAX_QUERY_VIEWS];
+
+	std::uint32_t views = GetFrustumsData (frustums, frustumsData);
+
+	for (std::size_t index = 0; index < BVH_MAX_QUERY_VIEWS; index++) {
+		planeMasks [index] = (1 << FrustumVolume::FrustumVolumeInformation::PLANESCOUNT) - 1;
+	}
+
+	QueryNode (_nodes [0], frustumsData, views, planeMasks, visibleItems);
+}
+
+/*
+ * Walks the tree down to the given depth and keeps the subtrees there,
+ * and the leaves above it, that some frustum may see. Querying all of
+ * them in order gives the items in the same order as a single query.
+*/
+
+void BoundingVolumeHierarchy::SplitQuery (const std::vector<FrustumVolume*>& frustums, std::size_t depth,
+	std::vector<QuerySubtree>& subtrees) const
+{
+	subtrees.clear ();
+
+	if (_nodes.empty ()) {
+		return;
+	}
+
+	FrustumVolume::FrustumVolumeInformation* frustumsData [BVH_MAX_QUERY_VIEWS];
+	std::uint8_t planeMasks [BVH_MAX_QUERY_VIEWS];
+
+	std::uint32_t views = GetFrustumsData (frustums, frustumsData);
+
+	for (std::size_t index = 0; index < BVH_MAX_QUERY_VIEWS; index++) {
+		planeMasks [index] = (1 << FrustumVolume::FrustumVolumeInformation::PLANESCOUNT) - 1;
+	}
+
+	SplitQueryNode (0, frustumsData, views, planeMasks, depth, subtrees);
+}
+
+/*
+ * The items are added to the lists, which are not cleared
+*/
+
+void BoundingVolumeHierarchy::Query (const std::vector<FrustumVolume*>& frustums, const QuerySubtree& subtree,
+	std::vector<std::vector<std::size_t>>& visibleItems) const
+{
+	visibleItems.resize (frustums.size ());
+
+	FrustumVolume::FrustumVolumeInformation* frustumsData [BVH_MAX_QUERY_VIEWS];
+
+	GetFrustumsData (frustums, frustumsData);
+
+	QueryNode (_nodes [subtree.node], frustumsData, subtree.views, subtree.planeMasks, visibleItems);
+}
+
+std::size_t BoundingVolumeHierarchy::GetItemsCount () const
+{
+	return _items.size ();
+}
+
+std::size_t BoundingVolumeHierarchy::GetNodesCount () const
+{
+	return _nodes.size ();
+}
+
+/*
+ * The children of a node are next to each other, the right one follows
+ * the left one
+*/
+
+void BoundingVolumeHierarchy::BuildNode (std::size_t nodeIndex, int parent, std::size_t firstItem, std::size_t itemsCount)
+{
+	Node& node = _nodes [nodeIndex];
+
+	node.parent = parent;
+	node.left = -1;
+	node.firstItem = firstItem;
+	node.itemsCount = itemsCount;
+
+	UpdateNodeBox (node);
+
+	if (itemsCount <= BVH_LEAF_ITEMS_COUNT) {
+		for (std::size_t index = firstItem; index < firstItem + itemsCount; index++) {
+			_itemsLeaf [_items [index]] = (int) nodeIndex;
+		}
+
+		return;
+	}
+
+	/*
+	 * Split at the median of the centers on the longest axis of the
+	 * centers bounds
+	*/
+
+	glm::vec3 minCenter (std::numeric_limits<float>::max ());
+	glm::vec3 maxCenter (-std::numeric_limits<float>::max ());
+
+	for (std::size_t index = firstItem; index < firstItem + itemsCount; index++) {
+		glm::vec3 center = _itemsMinVertex [_items [index]] + _itemsMaxVertex [_items [index]];
+
+		minCenter = glm::min (minCenter, center);
+		maxCenter = glm::max (maxCenter, center);
+	}
+
+	glm::vec3 extent = maxCenter - minCenter;
+
+	int axis = extent.x >= extent.y && extent.x >= extent.z ? 0 : (extent.y >= extent.z ? 1 : 2);
+
+	std::size_t middleItem = firstItem + itemsCount / 2;
+
+	std::nth_element (_items.begin () + firstItem, _items.begin () + middleItem,
+		_items.begin () + firstItem + itemsCount,
+		[this, axis] (std::size_t a, std::size_t b) {
+			return _itemsMinVertex [a][axis] + _itemsMaxVertex [a][axis] <
+				_itemsMinVertex [b][axis] + _itemsMaxVertex [b][axis];
+		});
+
+	int left = (int) _nodes.size ();
+
+	_nodes [nodeIndex].left = left;
+
+	_nodes.push_back (Node ());
+	_nodes.push_back (Node ());
+
+	BuildNode (left, (int) nodeIndex, firstItem, middleItem - firstItem);
+	BuildNode (left + 1, (int) nodeIndex, middleItem, firstItem + itemsCount - middleItem);
+}
+
+void BoundingVolumeHierarchy::UpdateNodeBox (Node& node)
+{
+	if (node.left != -1) {
+		const Node& left = _nodes [node.left];
+		const Node& right = _nodes [node.left + 1];
+
+		node.minVertex = glm::min (left.minVertex, right.minVertex);
+		node.maxVertex = glm::max (left.maxVertex, right.maxVertex);
+
+		return;
+	}
+
+	node.minVertex = glm::vec3 (std::numeric_limits<float>::max ());
+	node.maxVertex = glm::vec3 (-std::numeric_limits<float>::max ());
+
+	for (std::size_t index = node.firstItem; index < node.firstItem + node.itemsCount; index++) {
+		node.minVertex = glm::min (node.minVertex, _itemsMinVertex [_items [index]]);
+		node.maxVertex = glm::max (node.maxVertex, _itemsMaxVertex [_items [index]]);
+	}
+}
+
+std::uint32_t BoundingVolumeHierarchy::GetFrustumsData (const std::vector<FrustumVolume*>& frustums,
+	FrustumVolume::FrustumVolumeInformation** frustumsData) const
+{
+	std::size_t viewsCount = std::min (frustums.size (), (std::size_t) BVH_MAX_QUERY_VIEWS);
+
+	std::uint32_t views = 0;
+
+	for (std::size_t index = 0; index < viewsCount; index++) {
+		frustumsData [index] = frustums [index]->GetVolumeInformation ();
+
+		views |= 1 << index;
+	}
+
+	return views;
+}
+
+/*
+ * Returns the views that may see the node, with their planes the node
+ * still crosses
+*/
+
+std::uint32_t BoundingVolumeHierarchy::CheckNode (const Node& node, FrustumVolume::FrustumVolumeInformation* const* frustums,
+	std::uint32_t views, const std::uint8_t* planeMasks, std::uint8_t* nodePlaneMasks) const
+{
+	std::uint32_t nodeViews = 0;
+
+	for (std::size_t view = 0; view < BVH_MAX_QUERY_VIEWS; view++) {
+		if ((views & (1 << view)) == 0) {
+			continue;
+		}
+
+		nodePlaneMasks [view] = planeMasks [view];
+
+		if (CheckFrustumPlanes (frustums [view], node.minVertex, node.maxVertex, nodePlaneMasks [view])) {
+			nodeViews |= 1 << view;
+		}
+	}
+
+	return nodeViews;
+}
+
+void BoundingVolumeHierarchy::SplitQueryNode (std::size_t nodeIndex, FrustumVolume::FrustumVolumeInformation* const* frustums,
+	std::uint32_t views, const std::uint8_t* planeMasks, std::size_t depth,
+	std::vector<QuerySubtree>& subtrees) const
+{
+	const Node& node = _nodes [nodeIndex];
+
+	if (depth == 0 || node.left == -1) {
+		QuerySubtree subtree;
+
+		subtree.node = nodeIndex;
+		subtree.views = views;
+
+		for (std::size_t view = 0; view < BVH_MAX_QUERY_VIEWS; view++) {
+			subtree.planeMasks [view] = planeMasks [view];
+		}
+
+		subtrees.push_back (subtree);
+
+		return;
+	}
+
+	std::uint8_t nodePlaneMasks [BVH_MAX_QUERY_VIEWS];
+	std::uint32_t nodeViews = CheckNode (node, frustums, views, planeMasks, nodePlaneMasks);
+
+	if (nodeViews == 0) {
+		return;
+	}
+
+	SplitQueryNode (node.left, frustums, nodeViews, nodePlaneMasks, depth - 1, subtrees);
+	SplitQueryNode (node.left + 1, frustums, nodeViews, nodePlaneMasks, depth - 1, subtrees);
+}
+
+void BoundingVolumeHierarchy::QueryNode (const Node& node, FrustumVolume::FrustumVolumeInformation* const* frustums,
+	std::uint32_t views, const std::uint8_t* planeMasks,
+	std::vector<std::vector<std::size_t>>& visibleItems) const
+{
+	std::uint8_t nodePlaneMasks [BVH_MAX_QUERY_VIEWS];
+	std::uint32_t nodeViews = CheckNode (node, frustums, views, planeMasks, nodePlaneMasks);
+
+	if (nodeViews == 0) {
+		return;
+	}
+
+	if (node.left != -1) {
+		QueryNode (_nodes [node.left], frustums, nodeViews, nodePlaneMasks, visibleItems);
+		QueryNode (_nodes [node.left + 1], frustums, nodeViews, nodePlaneMasks, visibleItems);
+
+		return;
+	}
+
+	for (std::size_t view = 0; view < BVH_MAX_QUERY_VIEWS; view++) {
+		if ((nodeViews & (1 << view)) == 0) {
+			continue;
+		}
+
+		std::uint32_t visibilityMask;
+
+		FrustumCulling::CheckFrustumVsAABBs (frustums [view], nodePlaneMasks [view], _leavesBoxes,
+			node.firstItem, node.itemsCount, &visibilityMask);
+
+		for (std::size_t index = 0; index < node.itemsCount; index++) {
+			if ((visibilityMask & (1u << index)) != 0) {
+				visibleItems [view].push_back (_items [node.firstItem + index]);
+			}
+		}
+	}
+}
+
+/*
+ * Returns false if the box is behind one of the planes of the mask. The
+ * planes the box is fully in front of are removed from the mask.
+*/
+
+bool BoundingVolumeHierarchy::CheckFrustumPlanes (const FrustumVolume::FrustumVolumeInformation* frustum,
+	const glm::vec3& minVertex, const glm::vec3& maxVertex, std::uint8_t& planeMask)
+{
+	for (std::size_t index = 0; index < FrustumVolume::FrustumVolumeInformation::PLANESCOUNT; index++) {
+		if ((planeMask & (1 << index)) == 0) {
+			continue;
+		}
+
+		const glm::vec4& plane = frustum->plane [index];
+
+		glm::vec3 pVertex (plane.x < 0 ? minVertex.x : maxVertex.x,
+			plane.y < 0 ? minVertex.y : maxVertex.y,
+			plane.z < 0 ? minVertex.z : maxVertex.z);
+
+		if (glm::dot (glm::vec3 (plane), pVertex) < -plane.w) {
+			return false;
+		}
+
+		glm::vec3 nVertex (plane.x < 0 ? maxVertex.x : minVertex.x,
+			plane.y < 0 ? maxVertex.y : minVertex.y,
+			plane.z < 0 ? maxVertex.z : minVertex.z);
+
+		if (glm::dot (glm::vec3 (plane), nVertex) >= -plane.w) {
+			planeMask &= ~(1 << index);
+		}
+	}
+
+	return true;
+}
@@ -0,0 +1,108 @@
+#ifndef BOUNDINGVOLUMEHIERARCHY_H
+#define BOUNDINGVOLUMEHIERARCHY_H
+
+#include <vector>
+#include <cstdint>
+
+#include "FrustumVolume.h"
+#include "FrustumCulling.h"
+
+#include "Core/Math/glm/glm.hpp"
+
+/*
+ * Maximum number of items in a leaf of the hierarchy, at most 32 for the
+ * visibility mask of a leaf to fit in a word
+*/
+
+#define BVH_LEAF_ITEMS_COUNT 8
+
+/*
+ * Maximum number of frustums tested in a single traversal
+*/
+
+#define BVH_MAX_QUERY_VIEWS 8
+
+/*
+ * Bounding volume hierarchy of axis aligned boxes identified by an item
+ * index. It is built top-down by splitting the items at the median of the
+ * longest axis, the boxes of moving items are refit in place without
+ * changing the tree. The boxes of the items are also kept in leaf order
+ * to test a whole leaf at once with the batch culling kernel.
+ *
+ * A query walks the tree once for several frustums. Each frustum keeps a
+ * mask of the planes the current node still crosses, a node fully inside
+ * a plane is not tested against it again in its subtree.
+ *
+ * A query can also be split in the subtrees found at a given depth, which
+ * are independent of each other and can be walked on several threads.
+*/
+
+class BoundingVolumeHierarchy
+{
+protected:
+	struct Node
+	{
+		glm::vec3 minVertex;
+		glm::vec3 maxVertex;
+		int parent;
+		int left;
+		std::size_t firstItem;
+		std::size_t itemsCount;
+	};
+
+	std::vector<Node> _nodes;
+	std::vector<std::size_t> _items;
+	std::vector<glm::vec3> _itemsMinVertex;
+	std::vector<glm::vec3> _itemsMaxVertex;
+	std::vector<int> _itemsLeaf;
+	std::vector<std::size_t> _itemsPosition;
+	AABBBatch _leavesBoxes;
+
+public:
+	struct QuerySubtree
+	{
+		std::size_t node;
+		std::uint32_t views;
+		std::uint8_t planeMasks [BVH_MAX_QUERY_VIEWS];
+	};
+
+	BoundingVolumeHierarchy ();
+
+	void Build (const std::vector<std::size_t>& items,
+		const std::vector<glm::vec3>& minVertices, const std::vector<glm::vec3>& maxVertices);
+	void Clear ();
+
+	bool Contains (std::size_t item) const;
+	void Refit (std::size_t item, const glm::vec3& minVertex, const glm::vec3& maxVertex);
+
+	void Query (const std::vector<FrustumVolume*>& frustums,
+		std::vector<std::vector<std::size_t>>& visibleItems) const;
+
+	void SplitQuery (const std::vector<FrustumVolume*>& frustums, std::size_t depth,
+		std::vector<QuerySubtree>& subtrees) const;
+	void Query (const std::vector<FrustumVolume*>& frustums, const QuerySubtree& subtree,
+		std::vector<std::vector<std::size_t>>& visibleItems) const;
+
+	std::size_t GetItemsCount () const;
+	std::size_t GetNodesCount () const;
+protected:
+	void BuildNode (std::size_t nodeIndex, int parent, std::size_t firstItem, std::size_t itemsCount);
+	void UpdateNodeBox (Node& node);
+
+	std::uint32_t GetFrustumsData (const std::vector<FrustumVolume*>& frustums,
+		FrustumVolume::FrustumVolumeInformation** frustumsData) const;
+
+	std::uint32_t CheckNode (const Node& node, FrustumVolume::FrustumVolumeInformation* const* frustums,
+		std::uint32_t views, const std::uint8_t* planeMasks, std::uint8_t* nodePlaneMasks) const;
+	void SplitQueryNode (std::size_t nodeIndex, FrustumVolume::FrustumVolumeInformation* const* frustums,
+		std::uint32_t views, const std::uint8_t* planeMasks, std::size_t depth,
+		std::vector<QuerySubtree>& subtrees) const;
+	void QueryNode (const Node& node, FrustumVolume::FrustumVolumeInformation* const* frustums,
+		std::uint32_t views, const std::uint8_t* planeMasks,
+		std::vector<std::vector<std::size_t>>& visibleItems) const;
+
+	static bool CheckFrustumPlanes (const FrustumVolume::FrustumVolumeInformation* frustum,
+		const glm::vec3& minVertex, const glm::vec3& maxVertex, std::uint8_t& planeMask);
+};
+
+#endif
@@ -0,0 +1,262 @@
+#include "FrustumCulling.h"
+
+#include <algorithm>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+	#define FRUSTUM_CULLING_X86
+#endif
+
+#ifdef FRUSTUM_CULLING_X86
+	#include <immintrin.h>
+
+	#ifdef _MSC_VER
+		#include <intrin.h>
+
+		#define FRUSTUM_CULLING_TARGET_SSE
+		#define FRUSTUM_CULLING_TARGET_AVX2
+	#else
+		#define FRUSTUM_CULLING_TARGET_SSE __attribute__ ((target ("sse2")))
+		#define FRUSTUM_CULLING_TARGET_AVX2 __attribute__ ((target ("avx2")))
+	#endif
+#endif
+
+void AABBBatch::Resize (std::size_t size)
+{
+	minX.resize (size);
+	minY.resize (size);
+	minZ.resize (size);
+	maxX.resize (size);
+	maxY.resize (size);
+	maxZ.resize (size);
+}
+
+void AABBBatch::Set (std::size_t index, const glm::vec3& minVertex, const glm::vec3& maxVertex)
+{
+	minX [index] = minVertex.x;
+	minY [index] = minVertex.y;
+	minZ [index] = minVertex.z;
+	maxX [index] = maxVertex.x;
+	maxY [index] = maxVertex.y;
+	maxZ [index] = maxVertex.z;
+}
+
+std::size_t AABBBatch::Size () const
+{
+	return minX.size ();
+}
+
+FrustumCullingISA FrustumCulling::_isa (FrustumCulling::DetectISA ());
+
+void FrustumCulling::CheckFrustumVsAABBs (const FrustumVolume::FrustumVolumeInformation* frustum,
+	std::uint8_t planeMask, const AABBBatch& boxes, std::size_t first, std::size_t count,
+	std::uint32_t* visibilityMask)
+{
+	std::fill (visibilityMask, visibilityMask + (count + 31) / 32, 0);
+
+	CullingPlane planes [FrustumVolume::FrustumVolumeInformation::PLANESCOUNT];
+	std::size_t planesCount = 0;
+
+	for (std::size_t index = 0; index < FrustumVolume::FrustumVolumeInformation::PLANESCOUNT; index++) {
+		if ((planeMask & (1 << index)) == 0) {
+			continue;
+		}
+
+		const glm::vec4& plane = frustum->plane [index];
+
+		CullingPlane& cullingPlane = planes [planesCount ++];
+
+		cullingPlane.x = (plane.x < 0 ? boxes.minX.data () : boxes.maxX.data ()) + first;
+		cullingPlane.y = (plane.y < 0 ? boxes.minY.data () : boxes.maxY.data ()) + first;
+		cullingPlane.z = (plane.z < 0 ? boxes.minZ.data () : boxes.maxZ.data ()) + first;
+		cullingPlane.plane = plane;
+	}
+
+	switch (_isa) {
+		case FrustumCullingISA::AVX2 :
+			CheckPlanesAVX2 (planes, planesCount, 0, count, visibilityMask);
+			break;
+		case FrustumCullingISA::SSE :
+			CheckPlanesSSE (planes, planesCount, 0, count, visibilityMask);
+			break;
+		default :
+			CheckPlanesScalar (planes, planesCount, 0, count, visibilityMask);
+			break;
+	}
+}
+
+FrustumCullingISA FrustumCulling::GetISA ()
+{
+	return _isa;
+}
+
+bool FrustumCulling::SetISA (FrustumCullingISA isa)
+{
+	if (!IsISASupported (isa)) {
+		return false;
+	}
+
+	_isa = isa;
+
+	return true;
+}
+
+bool FrustumCulling::IsISASupported (FrustumCullingISA isa)
+{
+	if (isa == FrustumCullingISA::SCALAR) {
+		return true;
+	}
+
+#if defined(FRUSTUM_CULLING_X86) && defined(_MSC_VER)
+	int cpuInfo [4];
+
+	__cpuid (cpuInfo, 1);
+
+	if (isa == FrustumCullingISA::SSE) {
+		return (cpuInfo [3] & (1 << 26)) != 0;
+	}
+
+	/*
+	 * AVX registers must also be saved by the operating system
+	*/
+
+	bool isAVXEnabled = (cpuInfo [2] & (1 << 27)) != 0 && (cpuInfo [2] & (1 << 28)) != 0 &&
+		(_xgetbv (0) & 6) == 6;
+
+	__cpuidex (cpuInfo, 7, 0);
+
+	return isAVXEnabled && (cpuInfo [1] & (1 << 5)) != 0;
+#elif defined(FRUSTUM_CULLING_X86)
+	__builtin_cpu_init ();
+
+	if (isa == FrustumCullingISA::SSE) {
+		return __builtin_cpu_supports ("sse2");
+	}
+
+	return __builtin_cpu_supports ("avx2");
+#else
+	return false;
+#endif
+}
+
+std::string FrustumCulling::GetISAName (FrustumCullingISA isa)
+{
+	switch (isa) {
+		case FrustumCullingISA::AVX2 :
+			return "AVX2";
+		case FrustumCullingISA::SSE :
+			return "SSE";
+		default :
+			return "Scalar";
+	}
+}
+
+FrustumCullingISA FrustumCulling::DetectISA ()
+{
+	if (IsISASupported (FrustumCullingISA::AVX2)) {
+		return FrustumCullingISA::AVX2;
+	}
+
+	if (IsISASupported (FrustumCullingISA::SSE)) {
+		return FrustumCullingISA::SSE;
+	}
+
+	return FrustumCullingISA::SCALAR;
+}
+
+void FrustumCulling::CheckPlanesScalar (const CullingPlane* planes, std::size_t planesCount,
+	std::size_t begin, std::size_t count, std::uint32_t* visibilityMask)
+{
+	for (std::size_t index = begin; index < count; index++) {
+		bool isVisible = true;
+
+		for (std::size_t planeIndex = 0; planeIndex < planesCount && isVisible; planeIndex++) {
+			const CullingPlane& cullingPlane = planes [planeIndex];
+
+			float distance = cullingPlane.plane.x * cullingPlane.x [index] +
+				cullingPlane.plane.y * cullingPlane.y [index] +
+				cullingPlane.plane.z * cullingPlane.z [index];
+
+			isVisible = distance >= -cullingPlane.plane.w;
+		}
+
+		if (isVisible) {
+			visibilityMask [index / 32] |= 1u << (index % 32);
+		}
+	}
+}
+
+/*
+ * The vector paths test 4 or 8 boxes at once and leave the rest to the
+ * narrower paths. A group never crosses a 32 bit word of the mask.
+*/
+
+#ifdef FRUSTUM_CULLING_X86
+
+FRUSTUM_CULLING_TARGET_SSE
+void FrustumCulling::CheckPlanesSSE (const CullingPlane* planes, std::size_t planesCount,
+	std::size_t begin, std::size_t count, std::uint32_t* visibilityMask)
+{
+	std::size_t index = begin;
+
+	for (; index + 4 <= count; index += 4) {
+		__m128 visibility = _mm_castsi128_ps (_mm_set1_epi32 (-1));
+
+		for (std::size_t planeIndex = 0; planeIndex < planesCount; planeIndex++) {
+			const CullingPlane& cullingPlane = planes [planeIndex];
+
+			__m128 distance = _mm_add_ps (_mm_add_ps (
+				_mm_mul_ps (_mm_set1_ps (cullingPlane.plane.x), _mm_loadu_ps (cullingPlane.x + index)),
+				_mm_mul_ps (_mm_set1_ps (cullingPlane.plane.y), _mm_loadu_ps (cullingPlane.y + index))),
+				_mm_mul_ps (_mm_set1_ps (cullingPlane.plane.z), _mm_loadu_ps (cullingPlane.z + index)));
+
+			visibility = _mm_and_ps (visibility, _mm_cmpge_ps (distance, _mm_set1_ps (-cullingPlane.plane.w)));
+		}
+
+		visibilityMask [index / 32] |= (std::uint32_t) _mm_movemask_ps (visibility) << (index % 32);
+	}
+
+	CheckPlanesScalar (planes, planesCount, index, count, visibilityMask);
+}
+
+FRUSTUM_CULLING_TARGET_AVX2
+void FrustumCulling::CheckPlanesAVX2 (const CullingPlane* planes, std::size_t planesCount,
+	std::size_t begin, std::size_t count, std::uint32_t* visibilityMask)
+{
+	std::size_t index = begin;
+
+	for (; index + 8 <= count; index += 8) {
+		__m256 visibility = _mm256_castsi256_ps (_mm256_set1_epi32 (-1));
+
+		for (std::size_t planeIndex = 0; planeIndex < planesCount; planeIndex++) {
+			const CullingPlane& cullingPlane = planes [planeIndex];
+
+			__m256 distance = _mm256_add_ps (_mm256_add_ps (
+				_mm256_mul_ps (_mm256_set1_ps (cullingPlane.plane.x), _mm256_loadu_ps (cullingPlane.x + index)),
+				_mm256_mul_ps (_mm256_set1_ps (cullingPlane.plane.y), _mm256_loadu_ps (cullingPlane.y + index))),
+				_mm256_mul_ps (_mm256_set1_ps (cullingPlane.plane.z), _mm256_loadu_ps (cullingPlane.z + index)));
+
+			visibility = _mm256_and_ps (visibility,
+				_mm256_cmp_ps (distance, _mm256_set1_ps (-cullingPlane.plane.w), _CMP_GE_OQ));
+		}
+
+		visibilityMask [index / 32] |= (std::uint32_t) _mm256_movemask_ps (visibility) << (index % 32);
+	}
+
+	CheckPlanesSSE (planes, planesCount, index, count, visibilityMask);
+}
+
+#else
+
+void FrustumCulling::CheckPlanesSSE (const CullingPlane* planes, std::size_t planesCount,
+	std::size_t begin, std::size_t count, std::uint32_t* visibilityMask)
+{
+	CheckPlanesScalar (planes, planesCount, begin, count, visibilityMask);
+}
+
+void FrustumCulling::CheckPlanesAVX2 (const CullingPlane* planes, std::size_t planesCount,
+	std::size_t begin, std::size_t count, std::uint32_t* visibilityMask)
+{
+	CheckPlanesScalar (planes, planesCount, begin, count, visibilityMask);
+}
+
+#endif
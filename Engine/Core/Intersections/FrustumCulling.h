@@ -0,0 +1,83 @@
+#ifndef FRUSTUMCULLING_H
+#define FRUSTUMCULLING_H
+
+#include <vector>
+#include <string>
+#include <cstdint>
+
+#include "FrustumVolume.h"
+
+#include "Core/Math/glm/glm.hpp"
+
+/*
+ * Axis aligned boxes stored as one array per coordinate, so that a
+ * vector register loads the same coordinate of consecutive boxes
+*/
+
+struct AABBBatch
+{
+	std::vector<float> minX;
+	std::vector<float> minY;
+	std::vector<float> minZ;
+	std::vector<float> maxX;
+	std::vector<float> maxY;
+	std::vector<float> maxZ;
+
+	void Resize (std::size_t size);
+	void Set (std::size_t index, const glm::vec3& minVertex, const glm::vec3& maxVertex);
+	std::size_t Size () const;
+};
+
+enum class FrustumCullingISA
+{
+	SCALAR,
+	SSE,
+	AVX2
+};
+
+/*
+ * Tests a range of boxes against the planes of a frustum. Bit i of the
+ * visibility mask is set when box (first + i) is not behind any of the
+ * planes in the plane mask. The widest instruction set supported by the
+ * processor is picked at startup.
+*/
+
+class FrustumCulling
+{
+private:
+	/*
+	 * Plane with the coordinates of the box corner farthest along its
+	 * normal, the p-vertex
+	*/
+
+	struct CullingPlane
+	{
+		const float* x;
+		const float* y;
+		const float* z;
+		glm::vec4 plane;
+	};
+
+	static FrustumCullingISA _isa;
+
+public:
+	static void CheckFrustumVsAABBs (const FrustumVolume::FrustumVolumeInformation* frustum,
+		std::uint8_t planeMask, const AABBBatch& boxes, std::size_t first, std::size_t count,
+		std::uint32_t* visibilityMask);
+
+	static FrustumCullingISA GetISA ();
+	static bool SetISA (FrustumCullingISA isa);
+	static bool IsISASupported (FrustumCullingISA isa);
+	static std::string GetISAName (FrustumCullingISA isa);
+private:
+	static FrustumCullingISA DetectISA ();
+
+	static void CheckPlanesScalar (const CullingPlane* planes, std::size_t planesCount,
+		std::size_t begin, std::size_t count, std::uint32_t* visibilityMask);
+	static void CheckPlanesSSE (const CullingPlane* planes, std::size_t planesCount,
+		std::size_t begin, std::size_t count, std::uint32_t* visibilityMask);
+	static void CheckPlanesAVX2 (const CullingPlane* planes, std::size_t planesCount,
+		std::size_t begin, std::size_t count, std::uint32_t* visibilityMask);
+};
+
+#endif
@@ -0,0 +1,408 @@
+#include "Benchmark.h"
+
+#include <algorithm>
+#include <fstream>
+#include <cmath>
+#include <cstdio>
+
+#include "Systems/Time/Time.h"
+#include "Systems/Camera/Camera.h"
+
+#include "Debug/Statistics/StatisticsManager.h"
+#include "Debug/Statistics/DrawnObjectsCountStat.h"
+#include "Debug/Statistics/DrawListStat.h"
+
+#include "Renderer/GPUTimers.h"
+
+#include "Wrappers/OpenGL/GL.h"
+#include "Wrappers/OpenGL/GLNullBackend.h"
+
+#include "Core/Random/Random.h"
+#include "Core/Console/Console.h"
+
+static std::string EscapeString (const std::string& text)
+{
+	std::string escaped;
+
+	for (char c : text) {
+		if (c == '"' || c == '\\') {
+			escaped += '\\';
+		}
+
+		escaped += c;
+	}
+
+	return escaped;
+}
+
+/*
+ * Nearest rank of the sorted times
+*/
+
+static double GetPercentile (const std::vector<double>& sortedTimes, double percentile)
+{
+	if (sortedTimes.empty ()) {
+		return 0.0;
+	}
+
+	std::size_t rank = (std::size_t) std::ceil (percentile * sortedTimes.size ());
+
+	return sortedTimes [std::max (rank, (std::size_t) 1) - 1];
+}
+
+BenchmarkSettings::BenchmarkSettings () :
+	sceneFilename (""),
+	pathFilename (""),
+	reportFilename (BENCHMARK_REPORT_FILE),
+	framesCount (BENCHMARK_FRAMES_COUNT),
+	deltaTimeMS (BENCHMARK_DELTA_TIME_MS),
+	seed (0)
+{
+
+}
+
+BenchmarkCounters::BenchmarkCounters () :
+	drawnObjectsCount (0),
+	packetsCount (0),
+	drawsCount (0),
+	shaderChangesCount (0),
+	materialChangesCount (0),
+	vertexArrayChangesCount (0),
+	transformChangesCount (0),
+	indirectCommandsCount (0),
+	callsCount (0),
+	bindsCount (0),
+	redundantBindsCount (0),
+	stateChangesCount (0),
+	uploadedBytesCount (0)
+{
+
+}
+
+Benchmark::Benchmark () :
+	_settings (),
+	_cameraPath (),
+	_isActive (false),
+	_frame (0),
+	_frameStart (),
+	_frameTimes (),
+	_counters (),
+	_countersHash (BENCHMARK_HASH_OFFSET),
+	_stateCacheStatistics ()
+{
+
+}
+
+Benchmark::~Benchmark ()
+{
+
+}
+
+/*
+ * The clock and the random numbers are fixed before anything uses them,
+ * so this is called before the scene is loaded
+*/
+
+bool Benchmark::Start (const BenchmarkSettings& settings)
+{
+	if (settings.framesCount == 0 || settings.deltaTimeMS == 0) {
+		Console::LogError ("Benchmark needs at least a frame and a time step");
+		return false;
+	}
+
+	if (!_cameraPath.Load (settings.pathFilename)) {
+		return false;
+	}
+
+	_settings = settings;
+
+	_frame = 0;
+	_frameTimes.clear ();
+	_frameTimes.reserve (_settings.framesCount);
+	_counters = BenchmarkCounters ();
+	_countersHash = BENCHMARK_HASH_OFFSET;
+	_stateCacheStatistics = GL::GetStateCacheStatistics ();
+
+	Time::SetFixedDeltaTimeMS (_settings.deltaTimeMS);
+	Random::Instance ().SetSeed (_settings.seed);
+
+	_isActive = true;
+
+	Console::Log ("Benchmark of " + std::to_string (_settings.framesCount) +
+		" frames on " + _settings.pathFilename);
+
+	return true;
+}
+
+void Benchmark::BeginFrame ()
+{
+	if (!_isActive) {
+		return;
+	}
+
+	_frameStart = std::chrono::high_resolution_clock::now ();
+}
+
+/*
+ * Called once the components are updated, the camera controllers of the
+ * scene do not get to move the camera away from the path
+*/
+
+void Benchmark::UpdateCamera ()
+{
+	if (!_isActive) {
+		return;
+	}
+
+	float time = Time::GetTimeMS () / 1000.0f;
+
+	Camera::Main ()->SetPosition (_cameraPath.GetPosition (time));
+	Camera::Main ()->SetRotation (_cameraPath.GetRotation (time));
+}
+
+void Benchmark::EndFrame ()
+{
+	if (!_isActive || IsDone ()) {
+		return;
+	}
+
+	std::chrono::duration<double, std::milli> frameTime =
+		std::chrono::high_resolution_clock::now () - _frameStart;
+
+	_frameTimes.push_back (frameTime.count ());
+
+	AddCounters (GetFrameCounters ());
+
+	_frame ++;
+
+	if (IsDone ()) {
+		if (ExportReport ()) {
+			Console::Log ("Benchmark report written to " + _settings.reportFilename);
+		} else {
+			Console::LogError ("Benchmark report could not be written to " + _settings.reportFilename);
+		}
+	}
+}
+
+bool Benchmark::IsActive () const
+{
+	return _isActive;
+}
+
+bool Benchmark::IsDone () const
+{
+	return _isActive && _frame >= _settings.framesCount;
+}
+
+const BenchmarkCounters& Benchmark::GetCounters () const
+{
+	return _counters;
+}
+
+std::uint64_t Benchmark::GetCountersHash () const
+{
+	return _countersHash;
+}
+
+BenchmarkCounters Benchmark::GetFrameCounters () const
+{
+	BenchmarkCounters counters;
+
+	DrawnObjectsCountStat* drawnObjectsStat = dynamic_cast<DrawnObjectsCountStat*> (
+		StatisticsManager::Instance ()->GetStatisticsObject ("DrawnObjectsCount"));
+
+	if (drawnObjectsStat != nullptr) {
+		counters.drawnObjectsCount = drawnObjectsStat->GetDrawnObjectsCount ();
+	}
+
+	DrawListStat* drawListStat = dynamic_cast<DrawListStat*> (
+		StatisticsManager::Instance ()->GetStatisticsObject ("DrawList"));
+
+	if (drawListStat != nullptr) {
+		const DrawListStatistics& statistics = drawListStat->GetDrawListStatistics ();
+
+		counters.packetsCount = statistics.packetsCount;
+		counters.drawsCount = statistics.drawsCount;
+		counters.shaderChangesCount = statistics.shaderChangesCount;
+		counters.materialChangesCount = statistics.materialChangesCount;
+		counters.vertexArrayChangesCount = statistics.vertexArrayChangesCount;
+		counters.transformChangesCount = statistics.transformChangesCount;
+		counters.indirectCommandsCount = statistics.indirectCommandsCount;
+	}
+
+	GLNullBackend* nullBackend = dynamic_cast<GLNullBackend*> (GL::GetBackend ());
+
+	if (nullBackend != nullptr) {
+		const GLFrameStatistics& statistics = nullBackend->GetFrameStatistics ();
+
+		counters.callsCount = statistics.callsCount;
+		counters.bindsCount = statistics.bindsCount;
+		counters.redundantBindsCount = statistics.redundantBindsCount;
+		counters.stateChangesCount = statistics.stateChangesCount;
+		counters.uploadedBytesCount = statistics.uploadedBytesCount;
+	}
+
+	return counters;
+}
+
+/*
+ * The camera goes in the hash too, a path that is sampled differently
+ * shows up even when it draws the same objects
+*/
+
+void Benchmark::AddCounters (const BenchmarkCounters& counters)
+{
+	_counters.drawnObjectsCount += counters.drawnObjectsCount;
+	_counters.packetsCount += counters.packetsCount;
+	_counters.drawsCount += counters.drawsCount;
+	_counters.shaderChangesCount += counters.shaderChangesCount;
+	_counters.materialChangesCount += counters.materialChangesCount;
+	_counters.vertexArrayChangesCount += counters.vertexArrayChangesCount;
+	_counters.transformChangesCount += counters.transformChangesCount;
+	_counters.indirectCommandsCount += counters.indirectCommandsCount;
+	_counters.callsCount += counters.callsCount;
+	_counters.bindsCount += counters.bindsCount;
+	_counters.redundantBindsCount += counters.redundantBindsCount;
+	_counters.stateChangesCount += counters.stateChangesCount;
+	_counters.uploadedBytesCount += counters.uploadedBytesCount;
+
+	glm::vec3 position = Camera::Main ()->GetPosition ();
+	glm::quat rotation = Camera::Main ()->GetRotation ();
+
+	_countersHash = HashFrame (_countersHash, _frame, Time::GetTimeMS (), counters, position, rotation);
+}
+
+/*
+ * The hash of a frame goes on from the hash of the frames before it, the
+ * same frames in another order give another hash
+*/
+
+std::uint64_t Benchmark::HashFrame (std::uint64_t hash, std::uint64_t frame, std::uint64_t timeMS,
+	const BenchmarkCounters& counters, const glm::vec3& position, const glm::quat& rotation)
+{
+	hash = AddHash (hash, &frame, sizeof (frame));
+	hash = AddHash (hash, &timeMS, sizeof (timeMS));
+	hash = AddHash (hash, &counters.drawnObjectsCount, sizeof (counters.drawnObjectsCount));
+	hash = AddHash (hash, &counters.packetsCount, sizeof (counters.packetsCount));
+	hash = AddHash (hash, &counters.drawsCount, sizeof (counters.drawsCount));
+	hash = AddHash (hash, &counters.shaderChangesCount, sizeof (counters.shaderChangesCount));
+	hash = AddHash (hash, &counters.materialChangesCount, sizeof (counters.materialChangesCount));
+	hash = AddHash (hash, &counters.vertexArrayChangesCount, sizeof (counters.vertexArrayChangesCount));
+	hash = AddHash (hash, &counters.transformChangesCount, sizeof (counters.transformChangesCount));
+	hash = AddHash (hash, &counters.indirectCommandsCount, sizeof (counters.indirectCommandsCount));
+	hash = AddHash (hash, &counters.callsCount, sizeof (counters.callsCount));
+	hash = AddHash (hash, &counters.bindsCount, sizeof (counters.bindsCount));
+	hash = AddHash (hash, &counters.redundantBindsCount, sizeof (counters.redundantBindsCount));
+	hash = AddHash (hash, &counters.stateChangesCount, sizeof (counters.stateChangesCount));
+	hash = AddHash (hash, &counters.uploadedBytesCount, sizeof (counters.uploadedBytesCount));
+	hash = AddHash (hash, &position.x, 3 * sizeof (float));
+	hash = AddHash (hash, &rotation.x, 4 * sizeof (float));
+
+	return hash;
+}
+
+std::uint64_t Benchmark::AddHash (std::uint64_t hash, const void* data, std::size_t size)
+{
+	const unsigned char* bytes = (const unsigned char*) data;
+
+	for (std::size_t index = 0; index < size; index++) {
+		hash ^= bytes [index];
+		hash *= BENCHMARK_HASH_PRIME;
+	}
+
+	return hash;
+}
+
+/*
+ * Times are in milliseconds. The GPU times of the passes cover the last
+ * samples their timers keep, the frame times cover all the frames.
+*/
+
+bool Benchmark::ExportReport () const
+{
+	std::ofstream outStream (_settings.reportFilename, std::ofstream::out);
+
+	if (!outStream.is_open ()) {
+		return false;
+	}
+
+	std::vector<double> sortedTimes (_frameTimes);
+	std::sort (sortedTimes.begin (), sortedTimes.end ());
+
+	double totalTime = 0.0;
+
+	for (double frameTime : _frameTimes) {
+		totalTime += frameTime;
+	}
+
+	double framesCount = (double) std::max (_frame, (std::size_t) 1);
+
+	char hash [17];
+	std::snprintf (hash, sizeof (hash), "%016llx", (unsigned long long) _countersHash);
+
+	const GLStateCacheStatistics& stateCacheStatistics = GL::GetStateCacheStatistics ();
+
+	outStream << "{\n";
+
+	outStream << "\"scene\":\"" << EscapeString (_settings.sceneFilename) << "\",\n";
+	outStream << "\"path\":\"" << EscapeString (_settings.pathFilename) << "\",\n";
+	outStream << "\"frames\":" << _frame << ",\n";
+	outStream << "\"deltaTime\":" << _settings.deltaTimeMS << ",\n";
+	outStream << "\"seed\":" << _settings.seed << ",\n";
+
+	outStream << "\"frameTime\":{"
+		<< "\"mean\":" << std::to_string (totalTime / framesCount)
+		<< ",\"min\":" << std::to_string (sortedTimes.empty () ? 0.0 : sortedTimes.front ())
+		<< ",\"max\":" << std::to_string (sortedTimes.empty () ? 0.0 : sortedTimes.back ())
+		<< ",\"p50\":" << std::to_string (GetPercentile (sortedTimes, 0.50))
+		<< ",\"p90\":" << std::to_string (GetPercentile (sortedTimes, 0.90))
+		<< ",\"p95\":" << std::to_string (GetPercentile (sortedTimes, 0.95))
+		<< ",\"p99\":" << std::to_string (GetPercentile (sortedTimes, 0.99))
+		<< "},\n";
+
+	outStream << "\"passes\":[";
+
+	for (std::size_t timer = 0; timer < GPUTimers::Instance ()->GetTimersCount (); timer++) {
+		GPUTimerStatistics statistics = GPUTimers::Instance ()->GetStatistics (timer);
+
+		outStream << (timer == 0 ? "\n" : ",\n");
+
+		outStream << "{\"name\":\"" << EscapeString (statistics.name) << "\""
+			<< ",\"samples\":" << statistics.samplesCount
+			<< ",\"mean\":" << std::to_string (statistics.mean)
+			<< ",\"min\":" << std::to_string (statistics.min)
+			<< ",\"max\":" << std::to_string (statistics.max)
+			<< "}";
+	}
+
+	outStream << "\n],\n";
+
+	outStream << "\"draws\":{"
+		<< "\"drawnObjects\":" << _counters.drawnObjectsCount
+		<< ",\"packets\":" << _counters.packetsCount
+		<< ",\"draws\":" << _counters.drawsCount
+		<< ",\"shaderChanges\":" << _counters.shaderChangesCount
+		<< ",\"materialChanges\":" << _counters.materialChangesCount
+		<< ",\"vertexArrayChanges\":" << _counters.vertexArrayChangesCount
+		<< ",\"transformChanges\":" << _counters.transformChangesCount
+		<< ",\"indirectCommands\":" << _counters.indirectCommandsCount
+		<< ",\"drawsPerFrame\":" << std::to_string (_counters.drawsCount / framesCount)
+		<< "},\n";
+
+	outStream << "\"gl\":{"
+		<< "\"calls\":" << _counters.callsCount
+		<< ",\"binds\":" << _counters.bindsCount
+		<< ",\"redundantBinds\":" << _counters.redundantBindsCount
+		<< ",\"stateChanges\":" << _counters.stateChangesCount
+		<< ",\"uploadedBytes\":" << _counters.uploadedBytesCount
+		<< ",\"filteredBinds\":" << stateCacheStatistics.filteredBindsCount - _stateCacheStatistics.filteredBindsCount
+		<< ",\"filteredStateChanges\":" << stateCacheStatistics.filteredStateChangesCount - _stateCacheStatistics.filteredStateChangesCount
+		<< ",\"cachedQueries\":" << stateCacheStatistics.cachedQueriesCount - _stateCacheStatistics.cachedQueriesCount
+		<< "},\n";
+
+	outStream << "\"countersHash\":\"" << hash << "\"\n";
+
+	outStream << "}\n";
+
+	return true;
+}
\ No newline at end of file
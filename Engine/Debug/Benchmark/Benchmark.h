@@ -0,0 +1,118 @@
+#ifndef BENCHMARK_H
+#define BENCHMARK_H
+
+#include "Core/Singleton/Singleton.h"
+
+#include <string>
+#include <vector>
+#include <chrono>
+#include <cstdint>
+
+#include "CameraPath.h"
+
+#include "Wrappers/OpenGL/GLStateCache.h"
+
+#define BENCHMARK_REPORT_FILE "Benchmark.json"
+#define BENCHMARK_FRAMES_COUNT 1000
+#define BENCHMARK_DELTA_TIME_MS 16
+
+/*
+ * FNV-1a, 64 bits
+*/
+
+#define BENCHMARK_HASH_OFFSET 14695981039346656037ull
+#define BENCHMARK_HASH_PRIME 1099511628211ull
+
+struct BenchmarkSettings
+{
+	std::string sceneFilename;
+	std::string pathFilename;
+	std::string reportFilename;
+	std::size_t framesCount;
+	unsigned int deltaTimeMS;
+	unsigned int seed;
+
+	BenchmarkSettings ();
+};
+
+/*
+ * What the CPU gave the GPU in a frame. None of it depends on how long
+ * the frame took, so the same scene, path and seed give the same
+ * counters on every run. The GL calls are only counted by the null
+ * backend.
+*/
+
+struct BenchmarkCounters
+{
+	std::uint64_t drawnObjectsCount;
+	std::uint64_t packetsCount;
+	std::uint64_t drawsCount;
+	std::uint64_t shaderChangesCount;
+	std::uint64_t materialChangesCount;
+	std::uint64_t vertexArrayChangesCount;
+	std::uint64_t transformChangesCount;
+	std::uint64_t indirectCommandsCount;
+	std::uint64_t callsCount;
+	std::uint64_t bindsCount;
+	std::uint64_t redundantBindsCount;
+	std::uint64_t stateChangesCount;
+	std::uint64_t uploadedBytesCount;
+
+	BenchmarkCounters ();
+};
+
+/*
+ * Runs a fixed number of frames with the simulated clock stepping by the
+ * same delta time and the main camera on a path, then writes a report.
+ * The report has the distribution of the CPU frame times, the GPU time
+ * of the render passes over their last samples, the draw counters and a
+ * hash of the counters of every frame and of the camera, which is what
+ * two runs compare to tell they drew the same. The calls the GL state
+ * cache filtered during the run are reported too.
+*/
+
+class Benchmark : public Singleton<Benchmark>
+{
+	friend Singleton<Benchmark>;
+
+private:
+	BenchmarkSettings _settings;
+	CameraPath _cameraPath;
+	bool _isActive;
+	std::size_t _frame;
+	std::chrono::high_resolution_clock::time_point _frameStart;
+	std::vector<double> _frameTimes;
+	BenchmarkCounters _counters;
+	std::uint64_t _countersHash;
+	GLStateCacheStatistics _stateCacheStatistics;
+
+public:
+	bool Start (const BenchmarkSettings& settings);
+
+	void BeginFrame ();
+	void UpdateCamera ();
+	void EndFrame ();
+
+	bool IsActive () const;
+	bool IsDone () const;
+
+	const BenchmarkCounters& GetCounters () const;
+	std::uint64_t GetCountersHash () const;
+
+	static std::uint64_t HashFrame (std::uint64_t hash, std::uint64_t frame, std::uint64_t timeMS,
+		const BenchmarkCounters& counters, const glm::vec3& position, const glm::quat& rotation);
+private:
+	Benchmark ();
+	~Benchmark ();
+	Benchmark (const Benchmark&);
+	Benchmark& operator=(const Benchmark&);
+
+	BenchmarkCounters GetFrameCounters () const;
+	void AddCounters (const BenchmarkCounters& counters);
+
+	static std::uint64_t AddHash (std::uint64_t hash, const void* data, std::size_t size);
+
+	bool ExportReport () const;
+};
+
+#endif
\ No newline at end of file
@@ -0,0 +1,198 @@
+#include "CameraPath.h"
+
+#include <algorithm>
+
+#include "Utils/Extensions/MathExtend.h"
+
+#include "Core/Console/Console.h"
+
+CameraPath::CameraPath () :
+	_points ()
+{
+
+}
+
+bool CameraPath::Load (const std::string& filename)
+{
+	TiXmlDocument doc;
+	if (!doc.LoadFile (filename.c_str ())) {
+		Console::LogError (filename + " has error in its syntax. Could not preceed further.");
+		return false;
+	}
+
+	TiXmlElement* root = doc.FirstChildElement ("CameraPath");
+
+	if (root == nullptr) {
+		Console::LogError (filename + " is not a camera path.");
+		return false;
+	}
+
+	_points.clear ();
+
+	TiXmlElement* content = root->FirstChildElement ("Point");
+
+	while (content) {
+		const char* time = content->Attribute ("time");
+
+		glm::vec3 position (0.0f);
+		glm::quat rotation;
+
+		TiXmlElement* pointContent = content->FirstChildElement ();
+
+		while (pointContent) {
+			std::string name = pointContent->Value ();
+
+			if (name == "Position") {
+				position = GetVector (pointContent);
+			}
+			else if (name == "Rotation") {
+				rotation = glm::quat (GetVector (pointContent) * DEG2RAD);
+			}
+
+			pointContent = pointContent->NextSiblingElement ();
+		}
+
+		AddPoint (time ? std::stof (time) : 0.0f, position, rotation);
+
+		content = content->NextSiblingElement ("Point");
+	}
+
+	if (_points.empty ()) {
+		Console::LogError (filename + " has no points.");
+		return false;
+	}
+
+	return true;
+}
+
+/*
+ * Keys with the same time keep the order they were added in
+*/
+
+void CameraPath::AddPoint (float time, const glm::vec3& position, const glm::quat& rotation)
+{
+	CameraPathPoint point;
+
+	point.time = time;
+	point.position = position;
+	point.rotation = rotation;
+
+	auto it = std::upper_bound (_points.begin (), _points.end (), time,
+		[] (float time, const CameraPathPoint& point) {
+			return time < point.time;
+		});
+
+	_points.insert (it, point);
+}
+
+/*
+ * The keys before and after the segment shape its tangents, the first
+ * and the last key stand in for the ones the path does not have
+*/
+
+glm::vec3 CameraPath::GetPosition (float time) const
+{
+	if (_points.empty ()) {
+		return glm::vec3 (0.0f);
+	}
+
+	float t = 0.0f;
+	std::size_t segment = GetSegment (time, t);
+
+	std::size_t last = _points.size () - 1;
+
+	const glm::vec3& p0 = _points [segment > 0 ? segment - 1 : 0].position;
+	const glm::vec3& p1 = _points [segment].position;
+	const glm::vec3& p2 = _points [std::min (segment + 1, last)].position;
+	const glm::vec3& p3 = _points [std::min (segment + 2, last)].position;
+
+	float t2 = t * t;
+	float t3 = t2 * t;
+
+	return 0.5f * ((2.0f * p1) +
+		(p2 - p0) * t +
+		(2.0f * p0 - 5.0f * p1 + 4.0f * p2 - p3) * t2 +
+		(3.0f * p1 - p0 - 3.0f * p2 + p3) * t3);
+}
+
+glm::quat CameraPath::GetRotation (float time) const
+{
+	if (_points.empty ()) {
+		return glm::quat ();
+	}
+
+	float t = 0.0f;
+	std::size_t segment = GetSegment (time, t);
+
+	std::size_t next = std::min (segment + 1, _points.size () - 1);
+
+	return glm::slerp (_points [segment].rotation, _points [next].rotation, t);
+}
+
+float CameraPath::GetDuration () const
+{
+	if (_points.empty ()) {
+		return 0.0f;
+	}
+
+	return _points.back ().time - _points.front ().time;
+}
+
+std::size_t CameraPath::GetPointsCount () const
+{
+	return _points.size ();
+}
+
+/*
+ * The key the segment of the time starts at, the factor is how far
+ * between it and the next key the time is
+*/
+
+std::size_t CameraPath::GetSegment (float time, float& factor) const
+{
+	factor = 0.0f;
+
+	if (time <= _points.front ().time) {
+		return 0;
+	}
+
+	if (time >= _points.back ().time) {
+		return _points.size () - 1;
+	}
+
+	auto it = std::upper_bound (_points.begin (), _points.end (), time,
+		[] (float time, const CameraPathPoint& point) {
+			return time < point.time;
+		});
+
+	std::size_t segment = (std::size_t) (it - _points.begin ()) - 1;
+
+	float length = _points [segment + 1].time - _points [segment].time;
+
+	factor = (time - _points [segment].time) / length;
+
+	return segment;
+}
+
+glm::vec3 CameraPath::GetVector (TiXmlElement* xmlElem)
+{
+	glm::vec3 vector3 (0.0f);
+
+	const char* x = xmlElem->Attribute ("x");
+	const char* y = xmlElem->Attribute ("y");
+	const char* z = xmlElem->Attribute ("z");
+
+	if (x) {
+		vector3.x = std::stof (x);
+	}
+
+	if (y) {
+		vector3.y = std::stof (y);
+	}
+
+	if (z) {
+		vector3.z = std::stof (z);
+	}
+
+	return vector3;
+}
\ No newline at end of file
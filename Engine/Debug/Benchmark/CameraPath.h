@@ -0,0 +1,60 @@
+#ifndef CAMERAPATH_H
+#define CAMERAPATH_H
+
+#include <string>
+#include <vector>
+
+#include "Core/Math/glm/vec3.hpp"
+#include "Core/Math/glm/gtc/quaternion.hpp"
+
+#include "Core/Parsers/XML/TinyXml/tinyxml.h"
+
+struct CameraPathPoint
+{
+	float time;
+	glm::vec3 position;
+	glm::quat rotation;
+};
+
+/*
+ * Camera keys in seconds. Positions go through a Catmull-Rom spline that
+ * passes by every key, rotations are slerped between two keys. Before the
+ * first key and after the last one the camera stays on them.
+ *
+ * The file holds the keys as
+ *
+ * <CameraPath>
+ *     <Point time="0">
+ *         <Position x="0" y="2" z="0" />
+ *         <Rotation x="0" y="90" z="0" />
+ *     </Point>
+ * </CameraPath>
+ *
+ * with the rotation in degrees, as in the scenes. The keys are sorted by
+ * time when loaded.
+*/
+
+class CameraPath
+{
+protected:
+	std::vector<CameraPathPoint> _points;
+
+public:
+	CameraPath ();
+
+	bool Load (const std::string& filename);
+
+	void AddPoint (float time, const glm::vec3& position, const glm::quat& rotation);
+
+	glm::vec3 GetPosition (float time) const;
+	glm::quat GetRotation (float time) const;
+
+	float GetDuration () const;
+	std::size_t GetPointsCount () const;
+private:
+	std::size_t GetSegment (float time, float& factor) const;
+
+	static glm::vec3 GetVector (TiXmlElement* xmlElem);
+};
+
+#endif
\ No newline at end of file
@@ -1,25 +1,36 @@
 #include "Profiler.h"
 
+#include <chrono>
+
+#include "ProfilerTrace.h"
+
 #include "Arguments/ArgumentsAnalyzer.h"
 
-ProfilerLoggerContainer::ProfilerLoggerContainer () :
-	Name (),
-	Duration (0),
-	NestDepth (0)
-{
+#include "Core/Console/Console.h"
 
-}
+thread_local ProfilerBuffer* Profiler::_buffer (nullptr);
 
 Profiler::Profiler () :
 	_isActive (ArgumentsAnalyzer::Instance ()->GetArgument (PROFILER_ARGUMENT_FLAG) != nullptr),
-	_eventsQueue ()
+	_names (),
+	_namesIndices (),
+	_buffers (),
+	_mutex (),
+	_flusher (),
+	_flusherCondition (),
+	_isFlusherStopping (false),
+	_frameCount (0)
 {
 
 }
 
 Profiler::~Profiler ()
 {
+	Stop ();
 
+	for (ProfilerBuffer* buffer : _buffers) {
+		delete buffer;
+	}
 }
 
 bool Profiler::IsActive () const
@@ -27,29 +38,196 @@ bool Profiler::IsActive () const
 	return _isActive;
 }
 
-void Profiler::AddEventAt (const ProfilerLoggerContainer& eventContainer, std::size_t index)
+void Profiler::Start ()
+{
+	if (!_isActive || _flusher.joinable ()) {
+		return;
+	}
+
+	_isFlusherStopping = false;
+
+	_flusher = std::thread (&Profiler::RunFlusher, this);
+}
+
+/*
+ * The flusher drains the buffers a last time before it returns, the
+ * scopes still open are left out of the trace
+*/
+
+void Profiler::Stop ()
+{
+	if (!_flusher.joinable ()) {
+		return;
+	}
+
+	{
+		std::lock_guard<std::mutex> lock (_mutex);
+		_isFlusherStopping = true;
+	}
+
+	_flusherCondition.notify_one ();
+
+	_flusher.join ();
+
+	Export ();
+}
+
+/*
+ * Called once by every call site, the scope keeps the index
+*/
+
+std::uint32_t Profiler::Intern (const std::string& name)
 {
-	if (_eventsQueue.size () <= index) {
-		Allocate (index - _eventsQueue.size () + 1);
+	std::lock_guard<std::mutex> lock (_mutex);
+
+	auto it = _namesIndices.find (name);
+
+	if (it != _namesIndices.end ()) {
+		return it->second;
 	}
 
-	_eventsQueue [index] = eventContainer;
+	std::uint32_t index = (std::uint32_t) _names.size ();
+
+	_names.push_back (name);
+	_namesIndices [name] = index;
+
+	return index;
+}
+
+/*
+ * Returns false if the buffer of the thread had no room for the event
+*/
+
+bool Profiler::Record (std::uint32_t name, ProfilerEventType type)
+{
+	return GetBuffer ()->Push (GetTime (), name, type);
 }
 
-const std::vector<ProfilerLoggerContainer>& Profiler::GetEvents () const
+/*
+ * Frame markers keep the number of the frame in place of the name
+*/
+
+void Profiler::RecordFrame ()
 {
-	return _eventsQueue;
+	std::size_t frame = _frameCount.fetch_add (1) + 1;
+
+	GetBuffer ()->Push (GetTime (), (std::uint32_t) frame, PROFILER_EVENT_FRAME);
 }
 
-void Profiler::Clear ()
+std::vector<std::string> Profiler::GetNames ()
 {
-	_eventsQueue.clear ();
-	_eventsQueue.shrink_to_fit ();
+	std::lock_guard<std::mutex> lock (_mutex);
+
+	return _names;
 }
 
-void Profiler::Allocate (std::size_t count)
+std::size_t Profiler::GetDroppedEventsCount ()
 {
-	for (std::size_t i=0;i<count;i++) {
-		_eventsQueue.push_back (ProfilerLoggerContainer ());
+	std::lock_guard<std::mutex> lock (_mutex);
+
+	std::size_t droppedEventsCount = 0;
+
+	for (ProfilerBuffer* buffer : _buffers) {
+		droppedEventsCount += buffer->GetDroppedEventsCount ();
 	}
+
+	return droppedEventsCount;
+}
+
+/*
+ * The buffer of a thread is created the first time it records, it lives
+ * as long as the profiler, after the thread is gone too
+*/
+
+ProfilerBuffer* Profiler::GetBuffer ()
+{
+	if (_buffer != nullptr) {
+		return _buffer;
+	}
+
+	std::lock_guard<std::mutex> lock (_mutex);
+
+	_buffer = new ProfilerBuffer ((std::uint16_t) _buffers.size ());
+
+	_buffers.push_back (_buffer);
+
+	return _buffer;
+}
+
+void Profiler::Flush (std::ofstream& outStream)
+{
+	std::vector<ProfilerEvent> events;
+
+	{
+		std::lock_guard<std::mutex> lock (_mutex);
+
+		for (ProfilerBuffer* buffer : _buffers) {
+			buffer->Pop (events);
+		}
+	}
+
+	if (events.empty ()) {
+		return;
+	}
+
+	outStream.write ((const char*) events.data (), events.size () * sizeof (ProfilerEvent));
+}
+
+void Profiler::RunFlusher ()
+{
+	std::ofstream outStream (PROFILER_OUTPUT_FILE, std::ofstream::out | std::ofstream::binary);
+
+	if (!outStream.is_open ()) {
+		Console::LogWarning ("Profiler output file " + std::string (PROFILER_OUTPUT_FILE) + " could not be opened");
+	}
+
+	while (true) {
+		{
+			std::unique_lock<std::mutex> lock (_mutex);
+
+			_flusherCondition.wait_for (lock, std::chrono::milliseconds (PROFILER_FLUSH_INTERVAL_MS),
+				[this] { return _isFlusherStopping.load (); });
+		}
+
+		Flush (outStream);
+
+		if (_isFlusherStopping.load ()) {
+			break;
+		}
+	}
+
+	outStream.close ();
+}
+
+void Profiler::Export ()
+{
+	ProfilerTrace trace (GetNames ());
+
+	if (!trace.Load (PROFILER_OUTPUT_FILE)) {
+		Console::LogWarning ("Profiler output file " + std::string (PROFILER_OUTPUT_FILE) + " could not be read");
+
+		return;
+	}
+
+	if (!trace.ExportChromeTrace (PROFILER_TRACE_FILE)) {
+		Console::LogWarning ("Profiler trace file " + std::string (PROFILER_TRACE_FILE) + " could not be written");
+	}
+
+	Console::Log ("Profiler: " + std::to_string (trace.GetFramesCount ()) + " frames, " +
+		std::to_string (trace.GetScopes ().size ()) + " scopes, " +
+		std::to_string (GetDroppedEventsCount ()) + " dropped events");
+
+	for (const ProfilerScopeSummary& scope : trace.GetSummary ()) {
+		Console::Log ("Profiler: " + scope.name +
+			" -> Count: " + std::to_string (scope.count) +
+			" Mean: " + std::to_string (scope.mean) +
+			" P50: " + std::to_string (scope.p50) +
+			" P99: " + std::to_string (scope.p99) + " (ms)");
+	}
+}
+
+std::uint64_t Profiler::GetTime ()
+{
+	return (std::uint64_t) std::chrono::duration_cast<std::chrono::nanoseconds> (
+		std::chrono::steady_clock::now ().time_since_epoch ()).count ();
 }
\ No newline at end of file
@@ -5,7 +5,14 @@
 
 #include <string>
 #include <vector>
+#include <unordered_map>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <fstream>
 
+#include "ProfilerBuffer.h"
 #include "ProfilerLogger.h"
 #include "ProfilerFrame.h"
 
@@ -15,14 +22,22 @@
 
 #define PROFILER_ARGUMENT_FLAG "profiler"
 
-struct ProfilerLoggerContainer
-{
-	std::string Name;
-	float Duration;
-	std::size_t NestDepth;
+#define PROFILER_OUTPUT_FILE "Profiler.prof"
+#define PROFILER_TRACE_FILE "Profiler.json"
 
-	ProfilerLoggerContainer ();
-};
+/*
+ * Time the flusher sleeps between two drains of the buffers
+*/
+
+#define PROFILER_FLUSH_INTERVAL_MS 10
+
+/*
+ * Records the scopes of every thread in buffers of their own, without
+ * locks. A background thread drains the buffers into a binary file, so
+ * the measured frames never wait for I/O. When the profiler stops the
+ * file is exported as a Chrome trace and a summary of the scopes is
+ * logged.
+*/
 
 class Profiler : public Singleton<Profiler>
 {
@@ -30,22 +45,44 @@ class Profiler : public Singleton<Profiler>
 
 private:
 	bool _isActive;
-	std::vector<ProfilerLoggerContainer> _eventsQueue;
+	std::vector<std::string> _names;
+	std::unordered_map<std::string, std::uint32_t> _namesIndices;
+	std::vector<ProfilerBuffer*> _buffers;
+	std::mutex _mutex;
+	std::thread _flusher;
+	std::condition_variable _flusherCondition;
+	std::atomic<bool> _isFlusherStopping;
+	std::atomic<std::size_t> _frameCount;
+
+	static thread_local ProfilerBuffer* _buffer;
 
 public:
 	bool IsActive () const;
 
-	void AddEventAt (const ProfilerLoggerContainer&, std::size_t);
-	const std::vector<ProfilerLoggerContainer>& GetEvents () const;
+	void Start ();
+	void Stop ();
+
+	std::uint32_t Intern (const std::string& name);
+
+	bool Record (std::uint32_t name, ProfilerEventType type);
+	void RecordFrame ();
 
-	void Clear ();
+	std::vector<std::string> GetNames ();
+	std::size_t GetDroppedEventsCount ();
 private:
 	Profiler ();
 	~Profiler ();
 	Profiler (const Profiler&);
 	Profiler& operator=(const Profiler&);
 
-	void Allocate (std::size_t);
+	ProfilerBuffer* GetBuffer ();
+
+	void Flush (std::ofstream& outStream);
+	void RunFlusher ();
+
+	void Export ();
+
+	static std::uint64_t GetTime ();
 };
 
 #endif
\ No newline at end of file
@@ -0,0 +1,70 @@
+#include "ProfilerBuffer.h"
+
+ProfilerBuffer::ProfilerBuffer (std::uint16_t thread) :
+	_events (PROFILER_BUFFER_EVENTS_COUNT),
+	_writeIndex (0),
+	_readIndex (0),
+	_droppedEventsCount (0),
+	_thread (thread)
+{
+
+}
+
+/*
+ * A begin needs the reserved room to be free, an end only needs a free
+ * slot. Returns false if the event was dropped.
+*/
+
+bool ProfilerBuffer::Push (std::uint64_t time, std::uint32_t name, ProfilerEventType type)
+{
+	std::size_t writeIndex = _writeIndex.load (std::memory_order_relaxed);
+	std::size_t readIndex = _readIndex.load (std::memory_order_acquire);
+
+	std::size_t freeEventsCount = PROFILER_BUFFER_EVENTS_COUNT - (writeIndex - readIndex);
+	std::size_t neededEventsCount = type == PROFILER_EVENT_END ? 1 : PROFILER_BUFFER_RESERVED_EVENTS_COUNT;
+
+	if (freeEventsCount < neededEventsCount) {
+		_droppedEventsCount.fetch_add (1, std::memory_order_relaxed);
+
+		return false;
+	}
+
+	ProfilerEvent& event = _events [writeIndex & (PROFILER_BUFFER_EVENTS_COUNT - 1)];
+
+	event.time = time;
+	event.name = name;
+	event.thread = _thread;
+	event.type = (std::uint16_t) type;
+
+	_writeIndex.store (writeIndex + 1, std::memory_order_release);
+
+	return true;
+}
+
+/*
+ * Appends the events recorded so far, returns their count
+*/
+
+std::size_t ProfilerBuffer::Pop (std::vector<ProfilerEvent>& events)
+{
+	std::size_t readIndex = _readIndex.load (std::memory_order_relaxed);
+	std::size_t writeIndex = _writeIndex.load (std::memory_order_acquire);
+
+	for (std::size_t index = readIndex; index < writeIndex; index++) {
+		events.push_back (_events [index & (PROFILER_BUFFER_EVENTS_COUNT - 1)]);
+	}
+
+	_readIndex.store (writeIndex, std::memory_order_release);
+
+	return writeIndex - readIndex;
+}
+
+std::uint16_t ProfilerBuffer::GetThread () const
+{
+	return _thread;
+}
+
+std::size_t ProfilerBuffer::GetDroppedEventsCount () const
+{
+	return _droppedEventsCount.load (std::memory_order_relaxed);
+}
\ No newline at end of file
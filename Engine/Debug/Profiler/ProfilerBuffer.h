@@ -0,0 +1,70 @@
+#ifndef PROFILERBUFFER_H
+#define PROFILERBUFFER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include <atomic>
+
+/*
+ * Events a thread may record before the flusher drains them, a power of
+ * two
+*/
+
+#define PROFILER_BUFFER_EVENTS_COUNT (1 << 16)
+
+/*
+ * Room kept free for the ends of the scopes already begun, so that a full
+ * buffer drops whole scopes only
+*/
+
+#define PROFILER_BUFFER_RESERVED_EVENTS_COUNT 256
+
+enum ProfilerEventType
+{
+	PROFILER_EVENT_BEGIN = 0,
+	PROFILER_EVENT_END,
+	PROFILER_EVENT_FRAME
+};
+
+/*
+ * Time is in nanoseconds of a steady clock, name is the index of an
+ * interned scope name
+*/
+
+struct ProfilerEvent
+{
+	std::uint64_t time;
+	std::uint32_t name;
+	std::uint16_t thread;
+	std::uint16_t type;
+};
+
+/*
+ * Lock-free ring of the events of one thread. Only that thread pushes,
+ * only the flusher pops.
+*/
+
+class ProfilerBuffer
+{
+protected:
+	std::vector<ProfilerEvent> _events;
+	std::atomic<std::size_t> _writeIndex;
+	std::atomic<std::size_t> _readIndex;
+	std::atomic<std::size_t> _droppedEventsCount;
+	std::uint16_t _thread;
+
+public:
+	ProfilerBuffer (std::uint16_t thread);
+
+	bool Push (std::uint64_t time, std::uint32_t name, ProfilerEventType type);
+	std::size_t Pop (std::vector<ProfilerEvent>& events);
+
+	std::uint16_t GetThread () const;
+	std::size_t GetDroppedEventsCount () const;
+private:
+	ProfilerBuffer (const ProfilerBuffer&);
+	ProfilerBuffer& operator=(const ProfilerBuffer&);
+};
+
+#endif
\ No newline at end of file
@@ -1,23 +1,17 @@
 #ifndef PROFILERFRAME_H
 #define PROFILERFRAME_H
 
-#include <cstddef>
-#include <string>
-
 #define PROFILER_FRAME ProfilerFrame profilerFrameTemporalObject;
 
-#define PROFILER_OUTPUT_FILE "Profiler.prof"
+/*
+ * Marks the start of a frame in the trace
+*/
 
 class ProfilerFrame
 {
-private:
-	static std::size_t _frameCount;
-
 public:
 	ProfilerFrame ();
 	~ProfilerFrame ();
-private:
-	void LogFrame ();
 };
 
 #endif
\ No newline at end of file
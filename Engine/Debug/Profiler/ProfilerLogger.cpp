@@ -1,12 +1,8 @@
 #include "Debug/Profiler/Profiler.h"
 
-std::size_t ProfilerLogger::_nestDepth (0);
-std::size_t ProfilerLogger::_currentEntryOrder (0);
-
-ProfilerLogger::ProfilerLogger (const std::string& name) :
+ProfilerLogger::ProfilerLogger (std::uint32_t name) :
 	_name (name),
-	_startMoment (std::chrono::high_resolution_clock::now ()),
-	_entryOrder ()
+	_isRecorded (false)
 {
 	/*
 	 * TODO: Find a way to avoid usage of guards here.
@@ -16,32 +12,14 @@ ProfilerLogger::ProfilerLogger (const std::string& name) :
 		return;
 	}
 
-	if (Profiler::Instance ()->GetEvents ().size () == 0 && _nestDepth == 0) {
-		_currentEntryOrder = 0;
-	}
-
-	_entryOrder = _currentEntryOrder;
-
-	_nestDepth ++;
-	_currentEntryOrder ++;
+	_isRecorded = Profiler::Instance ()->Record (_name, PROFILER_EVENT_BEGIN);
 }
 
 ProfilerLogger::~ProfilerLogger ()
 {
-	if (!Profiler::Instance ()->IsActive ()) {
+	if (!_isRecorded) {
 		return;
 	}
 
-	std::chrono::time_point<std::chrono::high_resolution_clock> endMoment = std::chrono::high_resolution_clock::now ();
-
-	std::chrono::duration<float, std::milli> duration = endMoment - _startMoment;
-
-	ProfilerLoggerContainer container;
-	container.Name = _name;
-	container.Duration = duration.count ();
-	container.NestDepth = _nestDepth;
-
-	Profiler::Instance ()->AddEventAt (container, _entryOrder);
-
-	_nestDepth --;
-} 
\ No newline at end of file
+	Profiler::Instance ()->Record (_name, PROFILER_EVENT_END);
+}
\ No newline at end of file
@@ -1,25 +1,31 @@
 #ifndef PROFILERLOGGER_H
 #define PROFILERLOGGER_H
 
-#include <string>
-#include <chrono>
+#include <cstdint>
 
 #include "Debug/Profiler/Profiler.h"
 
-#define PROFILER_LOGGER(NAME) ProfilerLogger profilerLoggerTemporalObject(#NAME); 
+/*
+ * The name of a scope is interned once, the first time its call site is
+ * reached
+*/
+
+#define PROFILER_LOGGER(NAME) static const std::uint32_t profilerLoggerName = Profiler::Instance ()->Intern (NAME); \
+	ProfilerLogger profilerLoggerTemporalObject (profilerLoggerName);
+
+/*
+ * Records the begin and end of a scope in the buffer of the calling
+ * thread. A scope whose begin did not fit in the buffer records no end.
+*/
 
 class ProfilerLogger
 {
 private:
-	static std::size_t _nestDepth;
-	static std::size_t _currentEntryOrder;
-
-	std::string _name;
-	std::chrono::time_point<std::chrono::high_resolution_clock> _startMoment;
-	std::size_t _entryOrder;
+	std::uint32_t _name;
+	bool _isRecorded;
 
 public:
-	ProfilerLogger (const std::string&);
+	ProfilerLogger (std::uint32_t name);
 	~ProfilerLogger ();
 };
 
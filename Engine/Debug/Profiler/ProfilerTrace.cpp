@@ -0,0 +1,223 @@
+#include "ProfilerTrace.h"
+
+#include <fstream>
+#include <algorithm>
+#include <limits>
+
+/*
+ * Events read from the trace file at once
+*/
+
+#define PROFILER_TRACE_LOAD_EVENTS_COUNT 4096
+
+ProfilerTrace::ProfilerTrace (const std::vector<std::string>& names) :
+	_names (names),
+	_scopes (),
+	_frames (),
+	_openScopes (),
+	_unmatchedEventsCount (0)
+{
+
+}
+
+bool ProfilerTrace::Load (const std::string& filename)
+{
+	std::ifstream inStream (filename, std::ifstream::in | std::ifstream::binary);
+
+	if (!inStream.is_open ()) {
+		return false;
+	}
+
+	std::vector<ProfilerEvent> events (PROFILER_TRACE_LOAD_EVENTS_COUNT);
+
+	while (inStream) {
+		inStream.read ((char*) events.data (), events.size () * sizeof (ProfilerEvent));
+
+		std::size_t eventsCount = (std::size_t) inStream.gcount () / sizeof (ProfilerEvent);
+
+		if (eventsCount == 0) {
+			break;
+		}
+
+		AddEvents (std::vector<ProfilerEvent> (events.begin (), events.begin () + eventsCount));
+	}
+
+	return true;
+}
+
+void ProfilerTrace::AddEvents (const std::vector<ProfilerEvent>& events)
+{
+	for (const ProfilerEvent& event : events) {
+		if (event.type == PROFILER_EVENT_FRAME) {
+			_frames.push_back (event);
+
+			continue;
+		}
+
+		std::vector<ProfilerEvent>& openScopes = _openScopes [event.thread];
+
+		if (event.type == PROFILER_EVENT_BEGIN) {
+			openScopes.push_back (event);
+
+			continue;
+		}
+
+		if (openScopes.empty () || openScopes.back ().name != event.name) {
+			_unmatchedEventsCount ++;
+
+			continue;
+		}
+
+		ProfilerScope scope;
+
+		scope.name = event.name;
+		scope.thread = event.thread;
+		scope.depth = openScopes.size () - 1;
+		scope.begin = openScopes.back ().time;
+		scope.end = event.time;
+
+		_scopes.push_back (scope);
+
+		openScopes.pop_back ();
+	}
+}
+
+/*
+ * Complete events of the Chrome trace format, which Perfetto reads too.
+ * Times are in microseconds from the first event of the trace.
+*/
+
+bool ProfilerTrace::ExportChromeTrace (const std::string& filename) const
+{
+	std::ofstream outStream (filename, std::ofstream::out);
+
+	if (!outStream.is_open ()) {
+		return false;
+	}
+
+	std::uint64_t startTime = std::numeric_limits<std::uint64_t>::max ();
+
+	for (const ProfilerScope& scope : _scopes) {
+		startTime = std::min (startTime, scope.begin);
+	}
+
+	for (const ProfilerEvent& frame : _frames) {
+		startTime = std::min (startTime, frame.time);
+	}
+
+	outStream << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+
+	bool isFirst = true;
+
+	for (const ProfilerScope& scope : _scopes) {
+		outStream << (isFirst ? "\n" : ",\n");
+
+		outStream << "{\"name\":\"" << EscapeName (GetName (scope.name)) << "\",\"cat\":\"engine\",\"ph\":\"X\""
+			<< ",\"ts\":" << std::to_string ((scope.begin - startTime) / 1000.0)
+			<< ",\"dur\":" << std::to_string ((scope.end - scope.begin) / 1000.0)
+			<< ",\"pid\":1,\"tid\":" << scope.thread << "}";
+
+		isFirst = false;
+	}
+
+	for (const ProfilerEvent& frame : _frames) {
+		outStream << (isFirst ? "\n" : ",\n");
+
+		outStream << "{\"name\":\"Frame " << frame.name << "\",\"cat\":\"engine\",\"ph\":\"i\",\"s\":\"g\""
+			<< ",\"ts\":" << std::to_string ((frame.time - startTime) / 1000.0)
+			<< ",\"pid\":1,\"tid\":" << frame.thread << "}";
+
+		isFirst = false;
+	}
+
+	outStream << "\n]}\n";
+
+	return true;
+}
+
+/*
+ * Sorted by total time, the scopes the frame spends most in first
+*/
+
+std::vector<ProfilerScopeSummary> ProfilerTrace::GetSummary () const
+{
+	std::map<std::uint32_t, std::vector<double>> durations;
+
+	for (const ProfilerScope& scope : _scopes) {
+		durations [scope.name].push_back ((scope.end - scope.begin) / 1000000.0);
+	}
+
+	std::vector<ProfilerScopeSummary> summary;
+
+	for (auto& scopeDurations : durations) {
+		std::vector<double>& values = scopeDurations.second;
+
+		std::sort (values.begin (), values.end ());
+
+		ProfilerScopeSummary scopeSummary;
+
+		scopeSummary.name = GetName (scopeDurations.first);
+		scopeSummary.count = values.size ();
+		scopeSummary.total = 0;
+
+		for (double value : values) {
+			scopeSummary.total += value;
+		}
+
+		scopeSummary.mean = scopeSummary.total / values.size ();
+		scopeSummary.p50 = values [(values.size () - 1) * 50 / 100];
+		scopeSummary.p99 = values [(values.size () - 1) * 99 / 100];
+
+		summary.push_back (scopeSummary);
+	}
+
+	std::sort (summary.begin (), summary.end (),
+		[] (const ProfilerScopeSummary& a, const ProfilerScopeSummary& b) {
+			return a.total > b.total;
+		});
+
+	return summary;
+}
+
+const std::vector<ProfilerScope>& ProfilerTrace::GetScopes () const
+{
+	return _scopes;
+}
+
+std::size_t ProfilerTrace::GetFramesCount () const
+{
+	return _frames.size ();
+}
+
+std::size_t ProfilerTrace::GetUnmatchedEventsCount () const
+{
+	return _unmatchedEventsCount;
+}
+
+std::string ProfilerTrace::GetName (std::uint32_t name) const
+{
+	if (name >= _names.size ()) {
+		return "Unknown";
+	}
+
+	return _names [name];
+}
+
+std::string ProfilerTrace::EscapeName (const std::string& name)
+{
+	std::string escapedName;
+
+	for (char character : name) {
+		if (character == '"' || character == '\\') {
+			escapedName += '\\';
+		}
+
+		if ((unsigned char) character < 0x20) {
+			continue;
+		}
+
+		escapedName += character;
+	}
+
+	return escapedName;
+}
\ No newline at end of file
@@ -0,0 +1,72 @@
+#ifndef PROFILERTRACE_H
+#define PROFILERTRACE_H
+
+#include <string>
+#include <vector>
+#include <map>
+
+#include "ProfilerBuffer.h"
+
+/*
+ * A scope of a thread, from its begin to its end event. Depth 0 is a
+ * scope no other scope of its thread was open around.
+*/
+
+struct ProfilerScope
+{
+	std::uint32_t name;
+	std::uint16_t thread;
+	std::size_t depth;
+	std::uint64_t begin;
+	std::uint64_t end;
+};
+
+/*
+ * Durations of all the scopes with the same name, in milliseconds
+*/
+
+struct ProfilerScopeSummary
+{
+	std::string name;
+	std::size_t count;
+	double total;
+	double mean;
+	double p50;
+	double p99;
+};
+
+/*
+ * Recorded events turned back into scopes. The events of every thread
+ * are matched in the order they were recorded, an end closes the last
+ * open scope of its thread. Ends that do not match it, of scopes whose
+ * begin was dropped, are skipped.
+*/
+
+class ProfilerTrace
+{
+protected:
+	std::vector<std::string> _names;
+	std::vector<ProfilerScope> _scopes;
+	std::vector<ProfilerEvent> _frames;
+	std::map<std::uint16_t, std::vector<ProfilerEvent>> _openScopes;
+	std::size_t _unmatchedEventsCount;
+
+public:
+	ProfilerTrace (const std::vector<std::string>& names);
+
+	bool Load (const std::string& filename);
+	void AddEvents (const std::vector<ProfilerEvent>& events);
+
+	bool ExportChromeTrace (const std::string& filename) const;
+	std::vector<ProfilerScopeSummary> GetSummary () const;
+
+	const std::vector<ProfilerScope>& GetScopes () const;
+	std::size_t GetFramesCount () const;
+	std::size_t GetUnmatchedEventsCount () const;
+protected:
+	std::string GetName (std::uint32_t name) const;
+
+	static std::string EscapeName (const std::string& name);
+};
+
+#endif
\ No newline at end of file
@@ -0,0 +1,23 @@
+#include "DrawListStat.h"
+
+DrawListStat::DrawListStat () :
+	_drawListStatistics ()
+{
+
+}
+
+DrawListStat::DrawListStat (const DrawListStatistics& drawListStatistics) :
+	_drawListStatistics (drawListStatistics)
+{
+
+}
+
+const DrawListStatistics& DrawListStat::GetDrawListStatistics () const
+{
+	return _drawListStatistics;
+}
+
+void DrawListStat::SetDrawListStatistics (const DrawListStatistics& drawListStatistics)
+{
+	_drawListStatistics = drawListStatistics;
+}
\ No newline at end of file
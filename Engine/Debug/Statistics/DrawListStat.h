@@ -0,0 +1,22 @@
+#ifndef DRAWLISTSTAT_H
+#define DRAWLISTSTAT_H
+
+#include "StatisticsObject.h"
+
+#include "Renderer/DrawList.h"
+
+class DrawListStat : public StatisticsObject
+{
+private:
+	DrawListStatistics _drawListStatistics;
+
+public:
+	DrawListStat ();
+	DrawListStat (const DrawListStatistics& drawListStatistics);
+
+	const DrawListStatistics& GetDrawListStatistics () const;
+
+	void SetDrawListStatistics (const DrawListStatistics& drawListStatistics);
+};
+
+#endif
\ No newline at end of file
@@ -3,12 +3,15 @@
 #include "Systems/Time/Time.h"
 #include "Systems/Input/Input.h"
 #include "Systems/Window/Window.h"
-#include "Systems/Physics/PhysicsSystem.h"
-#include "Systems/Components/ComponentManager.h"
+#include "Systems/Simulation/SimulationSystem.h"
+#include "Systems/Animation/AnimationSystem.h"
 
 #include "Debug/Profiler/Profiler.h"
+#include "Debug/Benchmark/Benchmark.h"
 
 #include "Renderer/RenderManager.h"
+#include "Renderer/StreamingBuffer.h"
+#include "Renderer/GPUTimers.h"
 
 #include "Managers/SceneManager.h"
 
@@ -16,9 +19,10 @@
 #define TICKS_PER_FRAME (1000 / FRAMES_PER_SECOND)
 #define MILLISECONDS_PER_FRAME (1.0 / FRAMES_PER_SECOND)
 
-Game::Game ()
+Game::Game () :
+	_frameGraph ()
 {
-
+	BuildFrameGraph ();
 }
 
 Game::~Game ()
@@ -39,6 +43,8 @@ void Game::Start ()
 		PROFILER_FRAME
 		PROFILER_LOGGER("Frame")
 
+		Benchmark::Instance ()->BeginFrame ();
+
 		Time::UpdateFrame();
 		Input::UpdateState ();
 
@@ -55,30 +61,81 @@ void Game::Start ()
 			Window::Resize (Input::GetResizeEvent ());
 		}
 
-		UpdateScene ();
-		DisplayScene ();
+		_frameGraph.Execute ();
 
 		Window::SwapBuffers ();			
 
+		Benchmark::Instance ()->EndFrame ();
+
+		if (Benchmark::Instance ()->IsDone ()) {
+			running = false;
+		}
+
 		// if(TICKS_PER_FRAME > Time::GetElapsedTimeMS () - Time::GetTimeMS ()) {
 		// 	SDL_Delay(TICKS_PER_FRAME - (Time::GetElapsedTimeMS () - Time::GetTimeMS ()));
 		// }
 	}
 }
 	
-void Game::UpdateScene() 
+/*
+ * Phases of a frame. The components and the GL submission run on the
+ * main thread, the rest as jobs once what they read is done. Animation
+ * only reads the skeletons, so it runs next to the physics and the
+ * transforms. The benchmark moves the camera after the components.
+ *
+ * components -> physics -> transforms -> scene -> render
+ *            -> animation --------------------->
+ *            -> camera path ------------------->
+*/
+
+void Game::BuildFrameGraph ()
 {
-	PROFILER_LOGGER("Update")
+	std::size_t components = _frameGraph.AddNode ("Components", [] () {
+		SimulationSystem::Instance ()->UpdateComponents ();
+	}, true);
 
-	SceneManager::Instance ()->Current ()->Update ();
+	std::size_t physics = _frameGraph.AddNode ("Physics", [] () {
+		SimulationSystem::Instance ()->UpdatePhysics ();
+	}, false);
 
-	ComponentManager::Instance ()->Update ();
-	PhysicsSystem::Instance ().UpdateScene ();
+	std::size_t transforms = _frameGraph.AddNode ("Transforms", [] () {
+		SimulationSystem::Instance ()->UpdateTransforms ();
+	}, false);
+
+	std::size_t scene = _frameGraph.AddNode ("Scene", [] () {
+		SimulationSystem::Instance ()->UpdateScene (SceneManager::Instance ()->Current ());
+	}, false);
+
+	std::size_t animation = _frameGraph.AddNode ("Animation", [] () {
+		AnimationSystem::Instance ()->Update ();
+	}, false);
+
+	std::size_t cameraPath = _frameGraph.AddNode ("Camera path", [] () {
+		Benchmark::Instance ()->UpdateCamera ();
+	}, true);
+
+	std::size_t render = _frameGraph.AddNode ("Render", [this] () {
+		DisplayScene ();
+	}, true);
+
+	_frameGraph.AddDependency (physics, components);
+	_frameGraph.AddDependency (transforms, physics);
+	_frameGraph.AddDependency (scene, transforms);
+	_frameGraph.AddDependency (animation, components);
+	_frameGraph.AddDependency (cameraPath, components);
+	_frameGraph.AddDependency (render, scene);
+	_frameGraph.AddDependency (render, animation);
+	_frameGraph.AddDependency (render, cameraPath);
 }
 
 void Game::DisplayScene() 
 {
 	PROFILER_LOGGER("Render")
 
+	StreamingBuffer::Instance ()->BeginFrame ();
+	GPUTimers::Instance ()->BeginFrame ();
+
 	RenderManager::Instance ()->RenderScene (SceneManager::Instance ()->Current (), Camera::Main ());
+
+	StreamingBuffer::Instance ()->EndFrame ();
 }
@@ -3,11 +3,14 @@
 
 #include "Core/Singleton/Singleton.h"
 
+#include "Utils/Threads/FrameGraph.h"
+
 class Game : public Singleton<Game>
 {
 	friend Singleton<Game>;
 
 private:
+	FrameGraph _frameGraph;
 
 public:
 	void Start ();
@@ -17,7 +20,8 @@ private:
 	Game (const Game&);
 	Game& operator=(const Game&);
 
-	void UpdateScene ();
+	void BuildFrameGraph ();
+
 	void DisplayScene ();
 };
 
@@ -1,5 +1,8 @@
 #include "GameEngine.h"
 
+#include <algorithm>
+#include <thread>
+
 #include "Systems/Window/Window.h"
 #include "Systems/Screen/Screen.h"
 #include "Systems/Input/Input.h"
@@ -14,7 +17,21 @@
 
 #include "Core/Console/Console.h"
 
+#include "Settings/GeneralSettings.h"
+
+#include "RenderPasses/VoxelVolumeConfiguration.h"
+
+#include "Renderer/StaticGeometryArena.h"
+#include "Renderer/GPUTimers.h"
+
+#include "Utils/Threads/JobSystem.h"
+
+#include "Debug/Profiler/Profiler.h"
+#include "Debug/Benchmark/Benchmark.h"
+
 #include "Wrappers/OpenGL/GL.h"
+#include "Wrappers/OpenGL/GLNullBackend.h"
+#include "Utils/Extensions/StringExtend.h"
 
 // #include "Debug/Debugger.h"
 
@@ -35,11 +52,21 @@
 
 void GameEngine::Init ()
 {
+	Profiler::Instance ()->Start ();
+
+	InitBenchmark ();
+
+	InitGLBackend ();
+
 	SDLModule::Init ();
 
 	Window::Init (DEFAULT_WINDOW_WIDTH, DEFAULT_WINDOW_HEIGHT, 
 		DEFAULT_WINDOW_FULLSCREEN, DEFAULT_WINDOW_TITLE);
 
+	if (Benchmark::Instance ()->IsActive ()) {
+		Window::SetVerticalSync (false);
+	}
+
 	InitOpenGL ();
 
 	// Debugger::Init ();
@@ -48,11 +75,29 @@ void GameEngine::Init ()
 
 	Skybox::Init ();
 
+	InitSettings ();
+
+	InitJobSystem ();
+
 	InitScene ();
 }
 
 void GameEngine::Clear ()
 {
+	JobSystem::Instance ()->Stop ();
+
+	Profiler::Instance ()->Stop ();
+
+	if (Profiler::Instance ()->IsActive ()) {
+		GPUTimers::Instance ()->LogStatistics ();
+	}
+
+	const GLStateCacheStatistics& stateCacheStatistics = GL::GetStateCacheStatistics ();
+
+	Console::Log ("GL state cache filtered " + std::to_string (stateCacheStatistics.filteredBindsCount) +
+		" binds, " + std::to_string (stateCacheStatistics.filteredStateChangesCount) + " state changes and answered " +
+		std::to_string (stateCacheStatistics.cachedQueriesCount) + " queries");
+
 	ShaderManager::Instance()->Clear();
 	SceneManager::Instance()->Clear();
 
@@ -61,6 +106,126 @@ void GameEngine::Clear ()
 	SDLModule::Quit ();
 }
 
+/*
+ * A benchmark runs the start scene for a number of frames with the camera
+ * on a path, see Benchmark. It has to start before SDL does, the window
+ * may be offscreen, and before the scene is loaded, the random numbers
+ * are seeded.
+*/
+
+void GameEngine::InitBenchmark ()
+{
+	Argument* benchmarkArg = ArgumentsAnalyzer::Instance ()->GetArgument ("benchmark");
+	Argument* framesArg = ArgumentsAnalyzer::Instance ()->GetArgument ("benchmarkframes");
+	Argument* reportArg = ArgumentsAnalyzer::Instance ()->GetArgument ("benchmarkreport");
+	Argument* timeStepArg = ArgumentsAnalyzer::Instance ()->GetArgument ("timestep");
+	Argument* seedArg = ArgumentsAnalyzer::Instance ()->GetArgument ("seed");
+	Argument* sceneArg = ArgumentsAnalyzer::Instance ()->GetArgument ("startscene");
+	Argument* offscreenArg = ArgumentsAnalyzer::Instance ()->GetArgument ("offscreen");
+
+	if (offscreenArg != nullptr) {
+		Window::SetOffscreen (true);
+	}
+
+	if (benchmarkArg == nullptr || benchmarkArg->GetArgs ().size () == 0 || benchmarkArg->GetArgs () [0] == "") {
+		return;
+	}
+
+	BenchmarkSettings settings;
+
+	settings.pathFilename = benchmarkArg->GetArgs () [0];
+
+	if (sceneArg != nullptr && sceneArg->GetArgs ().size () > 0) {
+		settings.sceneFilename = sceneArg->GetArgs () [0];
+	}
+
+	long value = 0;
+
+	if (framesArg != nullptr && framesArg->GetIntValue (value)) {
+		settings.framesCount = (std::size_t) std::max (value, 0L);
+	}
+
+	if (reportArg != nullptr && reportArg->GetArgs ().size () > 0 && reportArg->GetArgs () [0] != "") {
+		settings.reportFilename = reportArg->GetArgs () [0];
+	}
+
+	if (timeStepArg != nullptr && timeStepArg->GetIntValue (value)) {
+		settings.deltaTimeMS = (unsigned int) std::max (value, 0L);
+	}
+
+	if (seedArg != nullptr && seedArg->GetIntValue (value)) {
+		settings.seed = (unsigned int) value;
+	}
+
+	if (!Benchmark::Instance ()->Start (settings)) {
+		Console::LogError ("Benchmark could not be started!");
+		exit (1);
+	}
+}
+
+/*
+ * The null backend draws nothing, it measures what the CPU sends to the
+ * GPU and can write it as a stream, see GLNullBackend. It needs no
+ * window. It is kept until the end, the singletons still call GL when
+ * they are destroyed.
+ *
+ * The extensions it reports are given as a list separated by commas,
+ * or "all", so the paths of the drivers that have them are measured
+ * rather than the fallbacks.
+*/
+
+void GameEngine::InitGLBackend ()
+{
+	Argument* backendArg = ArgumentsAnalyzer::Instance ()->GetArgument ("glbackend");
+	Argument* streamArg = ArgumentsAnalyzer::Instance ()->GetArgument ("glstream");
+	Argument* stateCacheArg = ArgumentsAnalyzer::Instance ()->GetArgument ("glstatecache");
+	Argument* extensionsArg = ArgumentsAnalyzer::Instance ()->GetArgument ("glextensions");
+
+	if (stateCacheArg != nullptr && stateCacheArg->GetArgs ().size () > 0 && stateCacheArg->GetArgs () [0] == "off") {
+		GL::SetStateCaching (false);
+
+		Console::Log ("GL state cache is off, every call reaches the backend");
+	}
+
+	if (backendArg == nullptr || backendArg->GetArgs ().size () == 0 || backendArg->GetArgs () [0] != "null") {
+		return;
+	}
+
+	if (streamArg != nullptr && streamArg->GetArgs ().size () > 0 && streamArg->GetArgs () [0] != "") {
+		GL::SetBackend (new GLNullBackend (streamArg->GetArgs () [0]));
+	} else {
+		GL::SetBackend (new GLNullBackend ());
+	}
+
+	Window::SetHeadless (true);
+
+	Console::Log ("Null GL backend, nothing is drawn");
+
+	if (extensionsArg == nullptr || extensionsArg->GetArgs ().size () == 0 || extensionsArg->GetArgs () [0] == "") {
+		return;
+	}
+
+	std::vector<std::string> extensions = Extensions::StringExtend::Split (extensionsArg->GetArgs () [0], ",");
+
+	if (extensionsArg->GetArgs () [0] == "all") {
+		extensions = GLNullBackend::GetKnownExtensions ();
+	}
+
+	for (const std::string& extension : extensions) {
+		if (extension == "") {
+			continue;
+		}
+
+		if (!GLNullBackend::SetExtension (extension, true)) {
+			Console::LogWarning ("Unknown GL extension " + extension + " is not reported");
+
+			continue;
+		}
+
+		Console::Log ("Null GL backend reports " + extension);
+	}
+}
+
 void GameEngine::InitOpenGL ()
 {
 	// GL::Viewport(0, 0, 10, 10);
@@ -77,6 +242,15 @@ void GameEngine::InitOpenGL ()
 	GL::CullFace (GL_BACK);
 	GL::BlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
 
+	/*
+	 * Without a context there is nothing for GLEW to load, only the
+	 * extensions set for the null backend are reported
+	*/
+
+	if (Window::IsHeadless ()) {
+		return;
+	}
+
 	glewExperimental = GL_TRUE;
 
 	GLenum err = glewInit();
@@ -93,6 +267,75 @@ void GameEngine::InitOpenGL ()
 	} else {
 		Console::LogError ("OpenGL 4.5 not supported");
 	}
+
+	GL::InitDebugOutput ();
+}
+
+/*
+ * Quality settings that can be given per machine
+*/
+
+void GameEngine::InitSettings ()
+{
+	Argument* voxelSizeArg = ArgumentsAnalyzer::Instance ()->GetArgument ("voxelsize");
+	Argument* voxelMipmapsArg = ArgumentsAnalyzer::Instance ()->GetArgument ("voxelmipmaps");
+	Argument* voxelCascadesArg = ArgumentsAnalyzer::Instance ()->GetArgument ("voxelcascades");
+	Argument* voxelCascadeExtentArg = ArgumentsAnalyzer::Instance ()->GetArgument ("voxelcascadeextent");
+	Argument* indirectDrawArg = ArgumentsAnalyzer::Instance ()->GetArgument ("indirectdraw");
+	Argument* jobWorkersArg = ArgumentsAnalyzer::Instance ()->GetArgument ("jobworkers");
+
+	long value = 0;
+
+	if (voxelSizeArg != nullptr && voxelSizeArg->GetIntValue (value)) {
+		GeneralSettings::Instance ()->SetIntValue (VOXEL_VOLUME_SIZE_SETTING, (int) value);
+	}
+
+	if (voxelMipmapsArg != nullptr && voxelMipmapsArg->GetIntValue (value)) {
+		GeneralSettings::Instance ()->SetIntValue (VOXEL_VOLUME_MIPMAP_LEVELS_SETTING, (int) value);
+	}
+
+	if (voxelCascadesArg != nullptr && voxelCascadesArg->GetIntValue (value)) {
+		GeneralSettings::Instance ()->SetIntValue (VOXEL_CLIPMAP_CASCADES_SETTING, (int) value);
+	}
+
+	if (voxelCascadeExtentArg != nullptr && voxelCascadeExtentArg->GetIntValue (value)) {
+		GeneralSettings::Instance ()->SetIntValue (VOXEL_CLIPMAP_EXTENT_SETTING, (int) value);
+	}
+
+	/*
+	 * Static meshes are uploaded in the shared arenas only when asked
+	 * for, they can then be drawn either way
+	*/
+
+	if (indirectDrawArg != nullptr) {
+		GeneralSettings::Instance ()->SetIntValue (STATIC_GEOMETRY_SETTING, 1);
+		GeneralSettings::Instance ()->SetIntValue (INDIRECT_DRAW_SETTING, 1);
+	}
+
+	if (jobWorkersArg != nullptr && jobWorkersArg->GetIntValue (value)) {
+		GeneralSettings::Instance ()->SetIntValue (JOB_SYSTEM_WORKERS_SETTING, (int) value);
+	}
+}
+
+/*
+ * The main thread runs jobs too while it waits, one worker less than the
+ * cores keeps all of them busy. A negative count runs every job on the
+ * main thread.
+*/
+
+void GameEngine::InitJobSystem ()
+{
+	int workersCount = GeneralSettings::Instance ()->GetIntValue (JOB_SYSTEM_WORKERS_SETTING);
+
+	if (workersCount == 0) {
+		workersCount = (int) std::max (std::thread::hardware_concurrency (), 2u) - 1;
+	}
+
+	workersCount = std::max (workersCount, 0);
+
+	JobSystem::Instance ()->Start ((std::size_t) workersCount);
+
+	Console::Log ("Job system workers: " + std::to_string (workersCount));
 }
 
 void GameEngine::InitScene ()
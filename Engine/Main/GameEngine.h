@@ -7,7 +7,11 @@ public:
 	static void Init ();
 	static void Clear ();
 private:
+	static void InitBenchmark ();
+	static void InitGLBackend ();
 	static void InitOpenGL ();
+	static void InitSettings ();
+	static void InitJobSystem ();
 	static void InitScene ();
 };
 
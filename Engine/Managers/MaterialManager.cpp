@@ -2,18 +2,23 @@
 
 #include <map>
 #include <string>
+#include <vector>
 
 #include "Resources/Resources.h"
 
 #include "Material/MaterialLibrary.h"
 
-MaterialManager::MaterialManager ()
+MaterialManager::MaterialManager () :
+	_changesCount (0)
 {
 	char defaultMaterial[] = "Assets/Materials/default.mtl";
 
 	MaterialLibrary* materialLibrary = Resources::LoadMaterialLibrary (defaultMaterial);
 
 	_default = materialLibrary->GetMaterial (0);
+	_default->id = MATERIAL_DEFAULT_ID;
+
+	_materials.push_back (nullptr);
 
 	for (std::size_t i=1;i<materialLibrary->GetMaterialsCount ();i++) {
 		delete materialLibrary->GetMaterial (i);
@@ -34,34 +39,92 @@ Material* MaterialManager::Default ()
 	return _default;
 }
 
+/*
+ * A name may already have an identifier reserved by a model that was
+ * loaded before its material library, the material takes that slot
+*/
+
 void MaterialManager::AddMaterial (Material* material)
 {
 	if (!material) {
 		return ;
 	}
 
-	if (_materials.find (material->name) != _materials.end ()) {
+	std::size_t materialID = GetMaterialID (material->name);
+
+	if (_materials [materialID] != nullptr) {
 		return ;
 	}
 
-	_materials [material->name] = material;
+	_materials [materialID] = material;
+	material->id = materialID;
+
+	_changesCount ++;
 }
 
 Material* MaterialManager::GetMaterial (std::string name)
 {
-	if (_materials.find (name) == _materials.end ()) {
+	auto it = _materialsIDs.find (name);
+
+	if (it == _materialsIDs.end ()) {
 		return NULL;
 	}
 
-	return _materials [name];
+	return _materials [it->second];
+}
+
+/*
+ * Identifiers are resolved once, when the geometry is loaded, so that
+ * drawing does not look up materials by name
+*/
+
+std::size_t MaterialManager::GetMaterialID (const std::string& name)
+{
+	auto it = _materialsIDs.find (name);
+
+	if (it != _materialsIDs.end ()) {
+		return it->second;
+	}
+
+	std::size_t materialID = _materials.size ();
+
+	_materials.push_back (nullptr);
+	_materialsIDs [name] = materialID;
+
+	_changesCount ++;
+
+	return materialID;
+}
+
+Material* MaterialManager::GetMaterial (std::size_t materialID)
+{
+	if (materialID >= _materials.size () || _materials [materialID] == nullptr) {
+		return _default;
+	}
+
+	return _materials [materialID];
+}
+
+std::size_t MaterialManager::GetMaterialsCount () const
+{
+	return _materials.size ();
+}
+
+/*
+ * Grows every time a material or an identifier is added, the copies of
+ * the materials kept elsewhere are rebuilt when it changed
+*/
+
+std::size_t MaterialManager::GetChangesCount () const
+{
+	return _changesCount;
 }
 
 MaterialManager::~MaterialManager ()
 {
 	delete _default;
 
-	std::map<std::string, Material*>::iterator it;
-	for (it = _materials.begin(); it != _materials.end(); ++it) {
-		delete it->second;
+	for (Material* material : _materials) {
+		delete material;
 	}
 }
\ No newline at end of file
@@ -3,14 +3,24 @@
 
 #include <map>
 #include <string>
+#include <vector>
 
 #include "Material/Material.h"
 
+/*
+ * Identifier of the default material, returned for any name that has no
+ * material
+*/
+
+#define MATERIAL_DEFAULT_ID 0
+
 class MaterialManager
 {
 private:
 	Material* _default;
-	std::map<std::string, Material*> _materials;
+	std::vector<Material*> _materials;
+	std::map<std::string, std::size_t> _materialsIDs;
+	std::size_t _changesCount;
 public:
 	Material* Default ();
 	~MaterialManager ();
@@ -19,8 +29,14 @@ public:
 
 	void AddMaterial (Material* material);
 	Material* GetMaterial (std::string name);
+
+	std::size_t GetMaterialID (const std::string& name);
+	Material* GetMaterial (std::size_t materialID);
+
+	std::size_t GetMaterialsCount () const;
+	std::size_t GetChangesCount () const;
 private:
 	MaterialManager ();
 };
 
-#endif
\ No newline at end of file
+#endif
@@ -117,6 +117,16 @@ GLuint ShaderManager::AddShader (const std::string& shaderName,
 
 	GL::LinkProgram (program);
 
+	/*
+	 * Bind the view uniform block if the program uses it
+	*/
+
+	GLuint viewBlockIndex = GL::GetUniformBlockIndex (program, SHADER_VIEW_UNIFORM_BLOCK);
+
+	if (viewBlockIndex != GL_INVALID_INDEX) {
+		GL::UniformBlockBinding (program, viewBlockIndex, SHADER_VIEW_UNIFORM_BLOCK_BINDING);
+	}
+
 	DrawingShader* shader = new DrawingShader (shaderName, program, vertex, fragment, geometry);
 	shader->SetVertexFilename (vertexFile);
 	shader->SetFragmentFilename (fragmentFile);
@@ -28,7 +28,8 @@ Material::Material(void) :
 	bumpTexture (0),
 	cubeTexture (0),
 	shaderName (""),
-	attributes ()
+	attributes (),
+	id (0)
 {
 	// Documentation: 
 	// http://stackoverflow.com/questions/10181201/opengl-light-changes-ambient-to-diffuse-or-specular-works-but-not-the-opposite
@@ -53,7 +54,8 @@ Material::Material(const std::string& na, glm::vec3 aC, glm::vec3 dC, glm::vec3
 	bumpTexture (bumpTex),
 	cubeTexture (cubeTex),
 	shaderName (shaderNam),
-	attributes (attr)
+	attributes (attr),
+	id (0)
 {
 	// Nothing
 }
@@ -75,7 +77,8 @@ Material::Material(const Material& other) :
 	bumpTexture (other.bumpTexture),
 	cubeTexture (other.cubeTexture),
 	shaderName (other.shaderName),
-	attributes (other.attributes)
+	attributes (other.attributes),
+	id (other.id)
 {
 
 }
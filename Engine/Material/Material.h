@@ -46,6 +46,14 @@ public:
 
 	std::vector<Attribute> attributes;
 
+	/*
+	 * Identifier given by the MaterialManager, also the index of the
+	 * material in the storage buffer the shaders read. Until the material
+	 * is added it is the one of the default material.
+	*/
+
+	std::size_t id;
+
 public:
 	Material(void);
 	Material(const std::string& na, glm::vec3 aC, glm::vec3 dC, glm::vec3 sC, float ns, float tr, int ill, unsigned int tex,
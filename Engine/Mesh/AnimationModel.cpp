@@ -5,7 +5,8 @@
 AnimationModel::AnimationModel () :
 	Model (),
 	_animController (nullptr),
-	_boneTree (nullptr)
+	_boneTree (nullptr),
+	_skeletalAnimation (nullptr)
 {
 
 }
@@ -13,7 +14,8 @@ AnimationModel::AnimationModel () :
 AnimationModel::AnimationModel (const AnimationModel& other) :
 	Model (other),
 	_animController (other._animController),
-	_boneTree (other._boneTree)
+	_boneTree (other._boneTree),
+	_skeletalAnimation (nullptr)
 {
 
 }
@@ -22,6 +24,7 @@ AnimationModel::~AnimationModel ()
 {
 	delete _animController;
 	delete _boneTree;
+	delete _skeletalAnimation;
 }
 
 void AnimationModel::SetAnimationsController (AnimationsController* animController)
@@ -90,4 +93,18 @@ BoneInfo* AnimationModel::GetBone (const std::string& name)
 BoneInfo* AnimationModel::GetBone (std::size_t index)
 {
 	return _bones [index];
+}
+
+/*
+ * The skeleton is flattened with the default animation the first time it
+ * is needed, the instances of the model share it
+*/
+
+SkeletalAnimation* AnimationModel::GetSkeletalAnimation ()
+{
+	if (_skeletalAnimation == nullptr) {
+		_skeletalAnimation = new SkeletalAnimation (this, _animController->GetAnimationContainer (""));
+	}
+
+	return _skeletalAnimation;
 }
\ No newline at end of file
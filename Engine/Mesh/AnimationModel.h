@@ -10,6 +10,7 @@
 #include "VertexBoneInfo.h"
 #include "BoneTree.h"
 #include "BoneInfo.h"
+#include "SkeletalAnimation.h"
 
 class AnimationModel : public Model
 {
@@ -19,6 +20,7 @@ protected:
 	std::vector<VertexBoneInfo*> _bonesInfo;
 	AnimationsController* _animController;
 	BoneTree* _boneTree;
+	SkeletalAnimation* _skeletalAnimation;
 
 public:
 	AnimationModel ();
@@ -38,6 +40,8 @@ public:
 	BoneInfo* GetBone (const std::string& name);
 	BoneInfo* GetBone (std::size_t index);
 
+	SkeletalAnimation* GetSkeletalAnimation ();
+
 	~AnimationModel ();
 };
 
@@ -0,0 +1,106 @@
+#include "MeshCache.h"
+
+#include <cstring>
+
+#include "Utils/Files/FileSystem.h"
+
+MeshCacheKey::MeshCacheKey () :
+	sourceSize (0),
+	sourceModificationTime (0),
+	sourceHash (0)
+{
+
+}
+
+bool MeshCacheKey::operator== (const MeshCacheKey& other) const
+{
+	return sourceSize == other.sourceSize &&
+		sourceModificationTime == other.sourceModificationTime &&
+		sourceHash == other.sourceHash;
+}
+
+MeshCacheGroup::MeshCacheGroup () :
+	vertices (nullptr),
+	verticesCount (0),
+	vertexStride (0),
+	indices (nullptr),
+	indicesCount (0),
+	indexSize (0)
+{
+
+}
+
+MeshCache::MeshCache () :
+	_file (),
+	_groups ()
+{
+
+}
+
+MappedFile& MeshCache::GetFile ()
+{
+	return _file;
+}
+
+void MeshCache::AddGroup (const MeshCacheGroup& group)
+{
+	_groups.push_back (group);
+}
+
+const MeshCacheGroup* MeshCache::GetGroup (std::size_t index) const
+{
+	if (index >= _groups.size ()) {
+		return nullptr;
+	}
+
+	return &_groups [index];
+}
+
+std::size_t MeshCache::GetGroupsCount () const
+{
+	return _groups.size ();
+}
+
+std::string MeshCache::GetCacheFilename (const std::string& sourceFilename)
+{
+	return sourceFilename + MESH_CACHE_EXTENSION;
+}
+
+/*
+ * FNV-1a over 64 bit words, the tail is hashed byte by byte
+*/
+
+bool MeshCache::ComputeKey (const std::string& sourceFilename, MeshCacheKey& key)
+{
+	const uint64_t prime = 1099511628211ull;
+
+	MappedFile sourceFile;
+
+	if (!sourceFile.Open (sourceFilename)) {
+		return false;
+	}
+
+	const char* data = sourceFile.GetData ();
+	std::size_t size = sourceFile.GetSize ();
+
+	uint64_t hash = 14695981039346656037ull;
+
+	std::size_t wordsCount = size / sizeof (uint64_t);
+
+	for (std::size_t i=0;i<wordsCount;i++) {
+		uint64_t word;
+		std::memcpy (&word, data + i * sizeof (uint64_t), sizeof (uint64_t));
+
+		hash = (hash ^ word) * prime;
+	}
+
+	for (std::size_t i=wordsCount * sizeof (uint64_t);i<size;i++) {
+		hash = (hash ^ (unsigned char) data [i]) * prime;
+	}
+
+	key.sourceSize = size;
+	key.sourceModificationTime = FileSystem::GetModificationTime (sourceFilename);
+	key.sourceHash = hash;
+
+	return true;
+}
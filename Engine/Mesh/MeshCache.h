@@ -0,0 +1,69 @@
+#ifndef MESHCACHE_H
+#define MESHCACHE_H
+
+#include <string>
+#include <vector>
+#include <cstdint>
+
+#include "Utils/Files/MappedFile.h"
+
+#define MESH_CACHE_EXTENSION ".meshcache"
+#define MESH_CACHE_MAGIC "LEMC"
+#define MESH_CACHE_VERSION 2
+
+/*
+ * Identifies the source asset a cache was baked from. The cache is
+ * valid only while all three values still match the source file.
+*/
+
+struct MeshCacheKey
+{
+	uint64_t sourceSize;
+	int64_t sourceModificationTime;
+	uint64_t sourceHash;
+
+	MeshCacheKey ();
+
+	bool operator== (const MeshCacheKey& other) const;
+};
+
+/*
+ * Final interleaved vertex and index buffers of a polygon group. The
+ * pointers reference the mapped cache file, so they can be handed to the
+ * GPU without any copy.
+*/
+
+struct MeshCacheGroup
+{
+	const void* vertices;
+	std::size_t verticesCount;
+	std::size_t vertexStride;
+
+	const void* indices;
+	std::size_t indicesCount;
+	std::size_t indexSize;
+
+	MeshCacheGroup ();
+};
+
+class MeshCache
+{
+protected:
+	MappedFile _file;
+	std::vector<MeshCacheGroup> _groups;
+
+public:
+	MeshCache ();
+
+	MappedFile& GetFile ();
+
+	void AddGroup (const MeshCacheGroup& group);
+
+	const MeshCacheGroup* GetGroup (std::size_t index) const;
+	std::size_t GetGroupsCount () const;
+
+	static std::string GetCacheFilename (const std::string& sourceFilename);
+	static bool ComputeKey (const std::string& sourceFilename, MeshCacheKey& key);
+};
+
+#endif
@@ -15,7 +15,8 @@ Model::Model() :
 	_objectModels (),
 	_normals (),
 	_texcoords (),
-	_boundingBox (nullptr)
+	_boundingBox (nullptr),
+	_meshCache (nullptr)
 {
 }
 
@@ -23,24 +24,13 @@ Model::Model(const Model& other) :
 	_haveUV (other._haveUV),
 	_name (other._name),
 	_mtllib (other._mtllib),
-	_vertices (),
+	_vertices (other._vertices),
 	_objectModels (),
-	_normals (),
-	_texcoords (),
-	_boundingBox (nullptr)
+	_normals (other._normals),
+	_texcoords (other._texcoords),
+	_boundingBox (nullptr),
+	_meshCache (nullptr)
 {
-	for (std::size_t i=0;i<other._vertices.size();i++) {
-		_vertices.push_back (new glm::vec3 (*other._vertices [i]));
-	}
-
-	for (std::size_t i=0;i<other._normals.size();i++) {
-		_normals.push_back (new glm::vec3 (*other._normals [i]));
-	}
-
-	for (std::size_t i=0;i<other._texcoords.size();i++) {
-		_texcoords.push_back (new glm::vec3 (*other._texcoords [i]));
-	}
-
 	for (std::size_t i=0;i<other._objectModels.size();i++) {
 		_objectModels.push_back (new ObjectModel (*other._objectModels [i]));
 	}
@@ -48,24 +38,6 @@ Model::Model(const Model& other) :
 
 Model::~Model()
 {
-	for (std::size_t i=0;i<_vertices.size();i++) {
-		delete _vertices[i];
-	}
-	_vertices.clear();
-	_vertices.shrink_to_fit ();
-
-	for (std::size_t i=0;i<_normals.size();i++) {
-		delete _normals[i];
-	}
-	_normals.clear();
-	_normals.shrink_to_fit ();
-
-	for (std::size_t i=0;i<_texcoords.size();i++) {
-		delete _texcoords[i];
-	}
-	_texcoords.clear();
-	_texcoords.shrink_to_fit ();
-
 	for (std::size_t i=0;i<_objectModels.size();i++) {
 		delete _objectModels[i];
 	}
@@ -75,25 +47,80 @@ Model::~Model()
 	if (_boundingBox != nullptr) {
 		delete _boundingBox;
 	}
+
+	if (_meshCache != nullptr) {
+		delete _meshCache;
+	}
 }
 
-void Model::AddVertex (glm::vec3* vertex) 
+void Model::AddVertex (const glm::vec3& vertex)
 {
 	_vertices.push_back (vertex);
 }
 
-void Model::AddNormal (glm::vec3* normal)
+void Model::AddNormal (const glm::vec3& normal)
 {
 	_normals.push_back (normal);
 }
 
-void Model::AddTexcoord (glm::vec3* texcoord)
+void Model::AddTexcoord (const glm::vec3& texcoord)
 {
 	_texcoords.push_back (texcoord);
 
 	_haveUV = true;
 }
 
+void Model::AddVertex (glm::vec3* vertex) 
+{
+	AddVertex (*vertex);
+
+	delete vertex;
+}
+
+void Model::AddNormal (glm::vec3* normal)
+{
+	AddNormal (*normal);
+
+	delete normal;
+}
+
+void Model::AddTexcoord (glm::vec3* texcoord)
+{
+	AddTexcoord (*texcoord);
+
+	delete texcoord;
+}
+
+void Model::ReserveVertices (std::size_t count)
+{
+	_vertices.reserve (count);
+}
+
+void Model::ReserveNormals (std::size_t count)
+{
+	_normals.reserve (count);
+}
+
+void Model::ReserveTexcoords (std::size_t count)
+{
+	_texcoords.reserve (count);
+}
+
+const std::vector<glm::vec3>& Model::GetVertices () const
+{
+	return _vertices;
+}
+
+const std::vector<glm::vec3>& Model::GetNormals () const
+{
+	return _normals;
+}
+
+const std::vector<glm::vec3>& Model::GetTexcoords () const
+{
+	return _texcoords;
+}
+
 void Model::AddObjectModel (ObjectModel* object)
 {
 	_objectModels.push_back (object);
@@ -111,8 +138,9 @@ void Model::SetMaterialLibrary (std::string mtllibName)
 
 void Model::SetVertex (glm::vec3* vertex, std::size_t position)
 {
-	delete _vertices [position];
-	_vertices [position] = vertex;
+	_vertices [position] = *vertex;
+
+	delete vertex;
 }
 
 bool Model::HaveUV (void) const {
@@ -122,11 +150,9 @@ bool Model::HaveUV (void) const {
 // Deprecated for the moment (26.12.2015)
 void Model::Release()
 {
-	for (std::size_t i=0;i<_vertices.size();i++) {
-		delete _vertices[i];
-		delete _normals[i];
-		delete _texcoords[i];
-	}
+	_vertices.clear ();
+	_normals.clear ();
+	_texcoords.clear ();
 
 	for (std::size_t i=0;i<_objectModels.size();i++)  {
 		delete _objectModels[i];
@@ -159,7 +185,7 @@ glm::vec3* Model::GetVertex (std::size_t position) const
 		return nullptr;
 	}
 
-	return _vertices [position];
+	return const_cast<glm::vec3*> (&_vertices [position]);
 }
 
 glm::vec3* Model::GetNormal (std::size_t position) const 
@@ -168,7 +194,7 @@ glm::vec3* Model::GetNormal (std::size_t position) const
 		return NULL;
 	}
 
-	return _normals [position];
+	return const_cast<glm::vec3*> (&_normals [position]);
 }
 
 glm::vec3* Model::GetTexcoord (std::size_t position) const 
@@ -177,7 +203,7 @@ glm::vec3* Model::GetTexcoord (std::size_t position) const
 		return NULL;
 	}
 
-	return _texcoords [position];
+	return const_cast<glm::vec3*> (&_texcoords [position]);
 }
 
 ObjectModel* Model::GetObject (std::size_t position) const 
@@ -211,6 +237,42 @@ std::string Model::GetMaterialLibrary (void) const
 	return _mtllib;
 }
 
+/*
+ * Every material library referenced by the polygon groups, so they can
+ * be registered without reading the source file again
+*/
+
+std::vector<std::string> Model::GetMaterialLibraries () const
+{
+	std::vector<std::string> materialLibraries;
+
+	if (_mtllib != "") {
+		materialLibraries.push_back (_mtllib);
+	}
+
+	for (std::size_t i=0;i<_objectModels.size ();i++) {
+		ObjectModel* objModel = _objectModels [i];
+
+		for (std::size_t j=0;j<objModel->GetPolygonCount ();j++) {
+			std::string matName = objModel->GetPolygonGroup (j)->GetMaterialName ();
+
+			std::size_t separator = matName.find ("::");
+
+			if (separator == std::string::npos || separator == 0) {
+				continue;
+			}
+
+			std::string materialLibrary = matName.substr (0, separator);
+
+			if (std::find (materialLibraries.begin (), materialLibraries.end (), materialLibrary) == materialLibraries.end ()) {
+				materialLibraries.push_back (materialLibrary);
+			}
+		}
+	}
+
+	return materialLibraries;
+}
+
 BoundingBox* Model::GetBoundingBox ()
 {
 	if (_boundingBox == nullptr) {
@@ -220,6 +282,34 @@ BoundingBox* Model::GetBoundingBox ()
 	return _boundingBox;
 }
 
+void Model::SetBoundingBox (const BoundingBox& boundingBox)
+{
+	if (_boundingBox == nullptr) {
+		_boundingBox = new BoundingBox ();
+	}
+
+	*_boundingBox = boundingBox;
+}
+
+MeshCache* Model::GetMeshCache () const
+{
+	return _meshCache;
+}
+
+/*
+ * The model takes the ownership of the cache. Polygon groups keep
+ * pointers into it, so it lives as long as the model does.
+*/
+
+void Model::SetMeshCache (MeshCache* meshCache)
+{
+	if (_meshCache != nullptr) {
+		delete _meshCache;
+	}
+
+	_meshCache = meshCache;
+}
+
 void Model::ClearObjects (void) 
 {
 	for (std::size_t i=0;i<_objectModels.size();i++) {
@@ -238,19 +328,30 @@ void Model::GenerateMissingNormals()
 		for (std::size_t i=0;i<objModel->GetPolygonCount ();i++) {
 			PolygonGroup* polyGroup = objModel->GetPolygonGroup (i);
 
+			bool normalsAdded = false;
+
 			for (std::size_t j=0;j<polyGroup->GetPolygonCount ();j++) {
 				Polygon* poly = polyGroup->GetPolygon (j);
 
 				if (poly->VertexCount () > 0 && !poly->HaveNormals ()) {
-					glm::vec3* normal = CalculateNormal (poly);
-
-					_normals.push_back (normal);
+					_normals.push_back (CalculateNormal (poly));
 
 					for (std::size_t k=0;k<poly->VertexCount ();k++) {
 						poly->AddNormal ((int) _normals.size () - 1);
 					}
+
+					normalsAdded = true;
 				}
 			}
+
+			/*
+			 * Adding normals to a polygon that is not the last one moves its
+			 * range to the end of the group array
+			*/
+
+			if (normalsAdded) {
+				polyGroup->Compact ();
+			}
 		}
 	}
 }
@@ -275,7 +376,7 @@ void Model::GenerateSmoothNormals ()
 					std::size_t vertex = poly->GetVertex (l);
 					std::size_t normal = poly->GetNormal (l);
 
-					_smoothNormals [vertex] += *(_normals [normal]);
+					_smoothNormals [vertex] += _normals [normal];
 					_smoothNormalsCount [vertex] ++;
 
 					poly->SetNormal ((int) vertex, l);
@@ -289,15 +390,7 @@ void Model::GenerateSmoothNormals ()
 		_smoothNormals [i] = glm::normalize (_smoothNormals [i]);
 	}
 
-	for (std::size_t i=0;i<_normals.size ();i++) {
-		delete _normals [i];
-	}
-	_normals.clear ();
-	_normals.shrink_to_fit ();
-
-	for (std::size_t i=0;i<_smoothNormals.size ();i++) {
-		_normals.push_back ( new glm::vec3(_smoothNormals [i]));
-	}
+	_normals.swap (_smoothNormals);
 
 	_smoothNormals.clear ();
 	_smoothNormals.shrink_to_fit ();
@@ -413,7 +506,7 @@ void Model::GenerateSmoothNormals ()
 // }
 
 // TODO: Reimplement this
-glm::vec3* Model::CalculateNormal (Polygon* polygon)
+glm::vec3 Model::CalculateNormal (Polygon* polygon)
 {
 /* 
 	Set Vector U to (Triangle.p2 minus Triangle.p1)
@@ -426,26 +519,26 @@ glm::vec3* Model::CalculateNormal (Polygon* polygon)
 	Returning Normal
 */ 
 
-	glm::vec3 *first = _vertices[polygon->GetVertex(0)];
-	glm::vec3 *second = _vertices[polygon->GetVertex(1)];
-	glm::vec3 *third = _vertices[polygon->GetVertex(2)];
+	const glm::vec3& first = _vertices[polygon->GetVertex(0)];
+	const glm::vec3& second = _vertices[polygon->GetVertex(1)];
+	const glm::vec3& third = _vertices[polygon->GetVertex(2)];
 
-	glm::vec3 U = (*second) - (*first);
-	glm::vec3 V = (*third) - (*first);
+	glm::vec3 U = second - first;
+	glm::vec3 V = third - first;
 
-	glm::vec3 * normal = new glm::vec3();
+	glm::vec3 normal;
 
-	normal->x = (U.y * V.z) - (U.z * V.y);
-	normal->y = (U.z * V.x) - (U.x * V.z);
-	normal->z = (U.x * V.y) - (U.y * V.x);
+	normal.x = (U.y * V.z) - (U.z * V.y);
+	normal.y = (U.z * V.x) - (U.x * V.z);
+	normal.z = (U.x * V.y) - (U.y * V.x);
 
 	// Normalize the normal
 
-	float val = sqrt (normal->x * normal->x  + normal->y * normal->y + normal->z * normal->z);
+	float val = sqrt (normal.x * normal.x  + normal.y * normal.y + normal.z * normal.z);
 
-	normal->x /= val;
-	normal->y /= val;
-	normal->z /= val;
+	normal.x /= val;
+	normal.y /= val;
+	normal.z /= val;
 
 	return normal;
 }
@@ -460,21 +553,23 @@ BoundingBox* Model::CalculateBoundingBox ()
 		for (std::size_t i=0;i<objModel->GetPolygonCount ();i++) {
 			PolygonGroup* polyGroup = objModel->GetPolygonGroup (i);
 
-			for (std::size_t j=0;j<polyGroup->GetPolygonCount ();j++) {
-				Polygon* poly = polyGroup->GetPolygon (j);
+			/*
+			 * Walk the shared vertex indices of the group directly
+			*/
 
-				for (std::size_t k=0;k<poly->VertexCount ();k++) {
-					glm::vec3* vertex = _vertices [poly->GetVertex (k)];
+			const std::vector<int>& indices = polyGroup->GetIndices (Polygon::VERTEX_ATTRIBUTE);
 
-					boundingBox->xmin = std::min (boundingBox->xmin, vertex->x);
-					boundingBox->xmax = std::max (boundingBox->xmax, vertex->x);
+			for (std::size_t j=0;j<indices.size ();j++) {
+				const glm::vec3& vertex = _vertices [indices [j]];
 
-					boundingBox->ymin = std::min (boundingBox->ymin, vertex->y);
-					boundingBox->ymax = std::max (boundingBox->ymax, vertex->y);
+				boundingBox->xmin = std::min (boundingBox->xmin, vertex.x);
+				boundingBox->xmax = std::max (boundingBox->xmax, vertex.x);
 
-					boundingBox->zmin = std::min (boundingBox->zmin, vertex->z);
-					boundingBox->zmax = std::max (boundingBox->zmax, vertex->z);
-				}
+				boundingBox->ymin = std::min (boundingBox->ymin, vertex.y);
+				boundingBox->ymax = std::max (boundingBox->ymax, vertex.y);
+
+				boundingBox->zmin = std::min (boundingBox->zmin, vertex.z);
+				boundingBox->zmax = std::max (boundingBox->zmax, vertex.z);
 			}
 		}
 	}
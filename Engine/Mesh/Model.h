@@ -16,6 +16,7 @@
 
 #include "Polygon.h"
 #include "ObjectModel.h"
+#include "MeshCache.h"
 
 class Model : public Object
 {
@@ -24,11 +25,11 @@ protected:
 	std::string _name;
 	std::string _mtllib;
 
-	// Make this more flexible
-	std::vector<glm::vec3*> _vertices;
+	// Attributes are stored contiguously, polygons index into them
+	std::vector<glm::vec3> _vertices;
 	std::vector<ObjectModel*> _objectModels;
-	std::vector<glm::vec3*> _normals;
-	std::vector<glm::vec3*> _texcoords;
+	std::vector<glm::vec3> _normals;
+	std::vector<glm::vec3> _texcoords;
 
 	// Used for normal smoothing
 	std::vector<glm::vec3> _smoothNormals;
@@ -36,16 +37,38 @@ protected:
 
 	BoundingBox* _boundingBox;
 
+	// Baked buffers, when the model was loaded from a mesh cache
+	MeshCache* _meshCache;
+
 public: 
 	Model();			
 	Model(const Model& other);
 	void Release();					
 	bool HaveUV () const;
 
+	void AddNormal (const glm::vec3& normal);
+	void AddVertex (const glm::vec3& vertex);
+	void AddTexcoord (const glm::vec3& texcoord);
+	void AddObjectModel (ObjectModel* object);
+
+	void ReserveVertices (std::size_t count);
+	void ReserveNormals (std::size_t count);
+	void ReserveTexcoords (std::size_t count);
+
+	const std::vector<glm::vec3>& GetVertices () const;
+	const std::vector<glm::vec3>& GetNormals () const;
+	const std::vector<glm::vec3>& GetTexcoords () const;
+
+	/*
+	 * Compatibility accessors for the code written against the old per
+	 * element allocations. The added pointers are copied and released,
+	 * the returned pointers are valid only until the next attribute is
+	 * added.
+	*/
+
 	void AddNormal (glm::vec3* normal);
 	void AddVertex (glm::vec3* vertex);
 	void AddTexcoord (glm::vec3* texcoord);
-	void AddObjectModel (ObjectModel* object);
 
 	void SetName (std::string modelName);
 	void SetMaterialLibrary (std::string mtllibName);
@@ -57,6 +80,7 @@ public:
 
 	std::string GetName () const;
 	std::string GetMaterialLibrary () const;
+	std::vector<std::string> GetMaterialLibraries () const;
 
 	glm::vec3* GetVertex (std::size_t position) const;
 	glm::vec3* GetNormal (std::size_t position) const;
@@ -65,6 +89,10 @@ public:
 	ObjectModel* GetObject (std::string objectName) const;
 
 	BoundingBox* GetBoundingBox ();
+	void SetBoundingBox (const BoundingBox& boundingBox);
+
+	MeshCache* GetMeshCache () const;
+	void SetMeshCache (MeshCache* meshCache);
 
 	void SetVertex (glm::vec3* vertex, std::size_t position);
 	void ClearObjects ();
@@ -76,7 +104,7 @@ public:
 	~Model();
 
 protected:
-	glm::vec3* CalculateNormal(Polygon* poly);
+	glm::vec3 CalculateNormal(Polygon* poly);
 
 	BoundingBox* CalculateBoundingBox ();
 };
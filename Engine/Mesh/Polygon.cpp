@@ -1,108 +1,193 @@
 #include "Polygon.h"
 
-Polygon::Polygon(void)
-{
+#include <algorithm>
+
+#include "PolygonGroup.h"
 
+Polygon::Polygon(void) :
+	_polygonGroup (nullptr),
+	_indices ()
+{
+	for (std::size_t i=0;i<ATTRIBUTES_COUNT;i++) {
+		_offsets [i] = 0;
+		_counts [i] = 0;
+	}
 }
 
+/*
+ * The copy refers to the same storage as the original. A copy of a polygon
+ * that is part of a group reads the indices from that group.
+*/
+
 Polygon::Polygon(const Polygon& other) :
-	_vertices (other._vertices),
-	_normals (other._normals),
-	_texcoords (other._texcoords)
+	_polygonGroup (other._polygonGroup),
+	_indices (other._indices)
 {
-
+	for (std::size_t i=0;i<ATTRIBUTES_COUNT;i++) {
+		_offsets [i] = other._offsets [i];
+		_counts [i] = other._counts [i];
+	}
 }
 
 void Polygon::AddVertex(int position)
 {
-	_vertices.push_back(position);
+	AddIndex (VERTEX_ATTRIBUTE, position);
 }
 
 void Polygon::AddVertex(int vertPos, int texcoordPos, int normPos)
 {
-	_vertices.push_back(vertPos);
-	_normals.push_back(normPos);
+	AddIndex (VERTEX_ATTRIBUTE, vertPos);
+	AddIndex (NORMAL_ATTRIBUTE, normPos);
 
-	_texcoords.push_back(texcoordPos);
+	AddIndex (TEXCOORD_ATTRIBUTE, texcoordPos);
 }
 
 void Polygon::AddTexcoord(int position)
 {
-	_texcoords.push_back (position);
+	AddIndex (TEXCOORD_ATTRIBUTE, position);
 }
 
 void Polygon::AddNormal(int position)
 {
-	_normals.push_back (position);
+	AddIndex (NORMAL_ATTRIBUTE, position);
 }
 
 int Polygon::GetVertex(std::size_t position) const
 {
-	return _vertices[position];
+	return GetIndices (VERTEX_ATTRIBUTE) [position];
 }
 
 int Polygon::GetTexcoord(std::size_t position) const
 {
-	if (position >= _texcoords.size ()) {
+	if (position >= _counts [TEXCOORD_ATTRIBUTE]) {
 		return 0;
 	}
 
-	return _texcoords[position];
+	return GetIndices (TEXCOORD_ATTRIBUTE) [position];
 }
 
 int Polygon::GetNormal(std::size_t position) const
 {
-	return _normals[position];
+	return GetIndices (NORMAL_ATTRIBUTE) [position];
+}
+
+const int* Polygon::GetIndices (PolygonAttribute attribute) const
+{
+	if (_polygonGroup != nullptr) {
+		return _polygonGroup->_indices [attribute].data () + _offsets [attribute];
+	}
+
+	return _indices.data () + _offsets [attribute];
+}
+
+std::size_t Polygon::GetIndicesCount (PolygonAttribute attribute) const
+{
+	return _counts [attribute];
+}
+
+int* Polygon::GetMutableIndices (PolygonAttribute attribute)
+{
+	if (_polygonGroup != nullptr) {
+		return _polygonGroup->_indices [attribute].data () + _offsets [attribute];
+	}
+
+	return _indices.data () + _offsets [attribute];
 }
 
 void Polygon::SetVertex(int modelPos, std::size_t polygonPos)
 {
-	_vertices [polygonPos] = modelPos;
+	GetMutableIndices (VERTEX_ATTRIBUTE) [polygonPos] = modelPos;
 }
 
 void Polygon::SetTexcoord (int modelPos, std::size_t polygonPos)
 {
-	_texcoords [polygonPos] = modelPos;
+	GetMutableIndices (TEXCOORD_ATTRIBUTE) [polygonPos] = modelPos;
 }
 
 void Polygon::SetNormal (int modelPos, std::size_t polygonPos)
 {
-	_normals [polygonPos] = modelPos;
+	GetMutableIndices (NORMAL_ATTRIBUTE) [polygonPos] = modelPos;
 }
 
 std::size_t Polygon::VertexCount(void) const
 {
-	return _vertices.size ();
+	return _counts [VERTEX_ATTRIBUTE];
 }
 
 void Polygon::ReverseVertexOrder(void)
 {
-	for (int i=0;i<(int)_vertices.size() >> 1;i++) {
-		std::swap (_vertices [i], _vertices [_vertices.size() - 1 - i]);
-
-		if (_normals.size () > 0) {
-			std::swap (_normals [i], _normals [_vertices.size() - 1 - i]);
-		}
+	for (std::size_t i=0;i<ATTRIBUTES_COUNT;i++) {
+		int* indices = GetMutableIndices ((PolygonAttribute) i);
 
-		if (_texcoords.size() > 0) {
-			std::swap (_texcoords [i], _texcoords [_vertices.size() - 1 - i]);
-		}
+		std::reverse (indices, indices + _counts [i]);
 	}
 }
 
 void Polygon::ClearTexcoords(void)
 {
-	_texcoords.clear ();
+	if (_polygonGroup == nullptr) {
+		_indices.resize (_offsets [TEXCOORD_ATTRIBUTE]);
+	}
+
+	_counts [TEXCOORD_ATTRIBUTE] = 0;
+}
+
+std::size_t Polygon::NormalsCount(void) const
+{
+	return _counts [NORMAL_ATTRIBUTE];
+}
+
+std::size_t Polygon::TexcoordsCount(void) const
+{
+	return _counts [TEXCOORD_ATTRIBUTE];
 }
 
 bool Polygon::HaveNormals (void) const
 {
-	return _normals.size () > 0;
+	return _counts [NORMAL_ATTRIBUTE] > 0;
 }
 
 bool Polygon::HaveUV () const
 {
-	return _texcoords.size () > 0;
+	return _counts [TEXCOORD_ATTRIBUTE] > 0;
+}
+
+/*
+ * Own storage keeps the ranges in attribute order. In a group, a range
+ * can only grow at the end of the shared array, so a range that is not
+ * the last one is moved there first.
+*/
+
+void Polygon::AddIndex (PolygonAttribute attribute, int index)
+{
+	if (_polygonGroup == nullptr) {
+		_indices.insert (_indices.begin () + _offsets [attribute] + _counts [attribute], index);
+
+		for (std::size_t i=attribute + 1;i<ATTRIBUTES_COUNT;i++) {
+			_offsets [i] ++;
+		}
+
+		_counts [attribute] ++;
+
+		return;
+	}
+
+	std::vector<int>& indices = _polygonGroup->_indices [attribute];
+
+	if (_offsets [attribute] + _counts [attribute] != indices.size ()) {
+		std::size_t offset = indices.size ();
+
+		for (std::size_t i=0;i<_counts [attribute];i++) {
+			int value = indices [_offsets [attribute] + i];
+			indices.push_back (value);
+		}
+
+		_offsets [attribute] = (unsigned int) offset;
+	}
+
+	indices.push_back (index);
+
+	_counts [attribute] ++;
 }
 
 Polygon::~Polygon()
@@ -10,12 +10,29 @@
 #include <string>
 #include <vector>
 
+class PolygonGroup;
+
+/*
+ * A polygon is a range of corners. Once it is part of a polygon group, its
+ * indices live in the shared arrays of that group and the polygon keeps
+ * only the offsets. A polygon that was not added to a group yet keeps its
+ * indices in its own storage.
+*/
+
 class Polygon : public Object
 {
+	friend PolygonGroup;
+
+public:
+	enum PolygonAttribute {VERTEX_ATTRIBUTE = 0, NORMAL_ATTRIBUTE, TEXCOORD_ATTRIBUTE, ATTRIBUTES_COUNT};
+
 private:
-    std::vector<int> _vertices;
-    std::vector<int> _normals;
-    std::vector<int> _texcoords;
+	PolygonGroup* _polygonGroup;
+
+	unsigned int _offsets [ATTRIBUTES_COUNT];
+	unsigned int _counts [ATTRIBUTES_COUNT];
+
+	std::vector<int> _indices;
 
 public:
 	Polygon ();
@@ -30,17 +47,25 @@ public:
 	int GetTexcoord(std::size_t position) const;
 	int GetNormal(std::size_t position) const;
 
+	const int* GetIndices (PolygonAttribute attribute) const;
+	std::size_t GetIndicesCount (PolygonAttribute attribute) const;
+
 	void SetVertex(int modelPos, std::size_t polygonPos);
 	void SetTexcoord (int modelPos, std::size_t polygonPos);
 	void SetNormal (int modelPos, std::size_t polygonPos);
 
 	std::size_t VertexCount(void) const;
+	std::size_t NormalsCount(void) const;
+	std::size_t TexcoordsCount(void) const;
 
 	void ReverseVertexOrder(void);
 	void ClearTexcoords(void);
 	bool HaveNormals (void) const;
 	bool HaveUV () const;
     ~Polygon();
+private:
+	int* GetMutableIndices (PolygonAttribute attribute);
+	void AddIndex (PolygonAttribute attribute, int index);
 };
 
-#endif
\ No newline at end of file
+#endif
@@ -2,28 +2,122 @@
 
 #include <string>
 #include <vector>
+#include <functional>
 
 PolygonGroup::PolygonGroup(std::string name) :
 	_name (name),
-	_matName ()	// Maybe change here with global default material
+	_matName (),	// Maybe change here with global default material
+	_meshCacheGroup (nullptr)
 {
 
 }
 
 PolygonGroup::PolygonGroup (const PolygonGroup& other) :
 	_name (other._name),
-	_matName (other._matName)
+	_matName (other._matName),
+	_polygons (other._polygons),
+	_meshCacheGroup (nullptr)	// The cache belongs to the other model
 {
-	for (Polygon* polygon : other._polygons) {
-		_polygons.push_back (new Polygon (*polygon));
+	for (std::size_t i=0;i<Polygon::ATTRIBUTES_COUNT;i++) {
+		_indices [i] = other._indices [i];
+	}
+
+	for (Polygon& polygon : _polygons) {
+		polygon._polygonGroup = this;
 	}
 }
 
+/*
+ * Kept for the loaders that still build standalone polygons. The group
+ * takes the ownership of the polygon, its indices are copied into the
+ * shared arrays and the polygon itself is released right away.
+*/
+
 void PolygonGroup::AddPolygon (Polygon* polygon)
 {
+	AddPolygon (polygon->GetIndices (Polygon::VERTEX_ATTRIBUTE), polygon->VertexCount (),
+		polygon->GetIndices (Polygon::NORMAL_ATTRIBUTE), polygon->NormalsCount (),
+		polygon->GetIndices (Polygon::TEXCOORD_ATTRIBUTE), polygon->TexcoordsCount ());
+
+	delete polygon;
+}
+
+void PolygonGroup::AddPolygon (const int* vertices, std::size_t verticesCount,
+	const int* normals, std::size_t normalsCount,
+	const int* texcoords, std::size_t texcoordsCount)
+{
+	const int* indices [Polygon::ATTRIBUTES_COUNT] = { vertices, normals, texcoords };
+	std::size_t counts [Polygon::ATTRIBUTES_COUNT] = { verticesCount, normalsCount, texcoordsCount };
+
+	Polygon polygon;
+	polygon._polygonGroup = this;
+
+	for (std::size_t i=0;i<Polygon::ATTRIBUTES_COUNT;i++) {
+		polygon._offsets [i] = (unsigned int) _indices [i].size ();
+		polygon._counts [i] = (unsigned int) counts [i];
+
+		/*
+		 * The indices may come from this group, e.g. a copy of one of its
+		 * polygons, and the array may move while growing
+		*/
+
+		std::vector<int> aliased;
+
+		if (!std::less<const int*> () (indices [i], _indices [i].data ()) &&
+			std::less<const int*> () (indices [i], _indices [i].data () + _indices [i].size ())) {
+			aliased.assign (indices [i], indices [i] + counts [i]);
+			indices [i] = aliased.data ();
+		}
+
+		_indices [i].insert (_indices [i].end (), indices [i], indices [i] + counts [i]);
+	}
+
 	_polygons.push_back (polygon);
 }
 
+void PolygonGroup::Reserve (std::size_t polygonsCount, std::size_t indicesCount)
+{
+	_polygons.reserve (polygonsCount);
+
+	for (std::size_t i=0;i<Polygon::ATTRIBUTES_COUNT;i++) {
+		_indices [i].reserve (indicesCount);
+	}
+}
+
+/*
+ * A polygon that grows a range which is not the last one of its array
+ * moves it to the end and leaves the old one unused. The arrays are
+ * rebuilt in polygon order without the unused ranges.
+*/
+
+void PolygonGroup::Compact ()
+{
+	for (std::size_t i=0;i<Polygon::ATTRIBUTES_COUNT;i++) {
+		std::size_t count = 0;
+
+		for (const Polygon& polygon : _polygons) {
+			count += polygon._counts [i];
+		}
+
+		if (count == _indices [i].size ()) {
+			continue;
+		}
+
+		std::vector<int> indices;
+		indices.reserve (count);
+
+		for (Polygon& polygon : _polygons) {
+			std::vector<int>::const_iterator begin = _indices [i].begin () + polygon._offsets [i];
+
+			polygon._offsets [i] = (unsigned int) indices.size ();
+
+			indices.insert (indices.end (), begin, begin + polygon._counts [i]);
+		}
+
+		_indices [i].swap (indices);
+	}
+}
+
 std::string PolygonGroup::GetName() const
 {
 	return _name;
@@ -49,7 +143,22 @@ Polygon* PolygonGroup::GetPolygon(std::size_t index) const
 	if (index >= _polygons.size()) {
 		return NULL;
 	}
-	return _polygons [index];
+	return const_cast<Polygon*> (&_polygons [index]);
+}
+
+const std::vector<int>& PolygonGroup::GetIndices(Polygon::PolygonAttribute attribute) const
+{
+	return _indices [attribute];
+}
+
+const MeshCacheGroup* PolygonGroup::GetMeshCacheGroup() const
+{
+	return _meshCacheGroup;
+}
+
+void PolygonGroup::SetMeshCacheGroup(const MeshCacheGroup* meshCacheGroup)
+{
+	_meshCacheGroup = meshCacheGroup;
 }
 
 std::size_t PolygonGroup::GetPolygonCount() const
@@ -59,11 +168,13 @@ std::size_t PolygonGroup::GetPolygonCount() const
 
 void PolygonGroup::Clear ()
 {
-	for (std::size_t i=0;i<_polygons.size();i++) {
-		delete _polygons[i];
-	}
 	_polygons.clear ();
 	_polygons.shrink_to_fit ();
+
+	for (std::size_t i=0;i<Polygon::ATTRIBUTES_COUNT;i++) {
+		_indices [i].clear ();
+		_indices [i].shrink_to_fit ();
+	}
 }
 
 PolygonGroup::~PolygonGroup()
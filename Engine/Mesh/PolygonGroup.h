@@ -2,16 +2,26 @@
 #define POLYGONGROUP_H
 
 #include "Polygon.h"
+#include "MeshCache.h"
 
 #include <string>
 #include <vector>
 
+/*
+ * Polygons are stored by value. Their vertex, normal and texcoord indices
+ * are packed in one shared array per attribute.
+*/
+
 class PolygonGroup
 {
+	friend Polygon;
+
 private:
 	std::string _name;
 	std::string _matName;
-	std::vector<Polygon*> _polygons;
+	std::vector<Polygon> _polygons;
+	std::vector<int> _indices [Polygon::ATTRIBUTES_COUNT];
+	const MeshCacheGroup* _meshCacheGroup;
 public:
 	PolygonGroup(std::string name);
 	PolygonGroup (const PolygonGroup& other);
@@ -26,8 +36,18 @@ public:
 	Polygon* GetPolygon(std::size_t index) const;
 	std::size_t GetPolygonCount() const;
 
+	const std::vector<int>& GetIndices(Polygon::PolygonAttribute attribute) const;
+
+	const MeshCacheGroup* GetMeshCacheGroup() const;
+	void SetMeshCacheGroup(const MeshCacheGroup* meshCacheGroup);
+
 	void AddPolygon(Polygon* polygon);
+	void AddPolygon(const int* vertices, std::size_t verticesCount,
+		const int* normals, std::size_t normalsCount,
+		const int* texcoords, std::size_t texcoordsCount);
+	void Reserve(std::size_t polygonsCount, std::size_t indicesCount);
+	void Compact();
 	void Clear();
 };
 
-#endif
\ No newline at end of file
+#endif
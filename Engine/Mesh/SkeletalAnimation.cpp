@@ -0,0 +1,241 @@
+#include "SkeletalAnimation.h"
+
+#include <cmath>
+#include <algorithm>
+
+#include "AnimationModel.h"
+#include "AnimationContainer.h"
+#include "BoneTree.h"
+
+#include "Core/Math/glm/gtx/transform.hpp"
+
+SkeletalAnimationPose::SkeletalAnimationPose () :
+	positionCursors (),
+	rotationCursors (),
+	scalingCursors (),
+	globalTransforms (),
+	bonesTransforms (),
+	lastTime (0.0f)
+{
+
+}
+
+/*
+ * The tree is walked depth first with an explicit stack, the joints are
+ * numbered in the order they are reached
+*/
+
+SkeletalAnimation::SkeletalAnimation (AnimationModel* animationModel, AnimationContainer* animationContainer) :
+	_joints (),
+	_channels (),
+	_bonesOffsets (animationModel->GetBoneCount (), glm::mat4 (1.0f)),
+	_globalInverse (1.0f),
+	_duration (animationContainer->GetDuration ()),
+	_ticksPerSecond (animationContainer->GetTicksPerSecond () != 0 ? animationContainer->GetTicksPerSecond () : 25.0f)
+{
+	BoneNode* root = animationModel->GetBoneTree ()->GetRoot ();
+
+	_globalInverse = glm::inverse (root->GetTransform ());
+
+	for (std::size_t index = 0; index < _bonesOffsets.size (); index++) {
+		_bonesOffsets [index] = animationModel->GetBone (index)->GetTransformMatrix ();
+	}
+
+	std::vector<std::pair<BoneNode*, int>> stack (1, std::make_pair (root, -1));
+
+	while (!stack.empty ()) {
+		BoneNode* boneNode = stack.back ().first;
+		int parent = stack.back ().second;
+
+		stack.pop_back ();
+
+		SkeletalAnimationJoint joint;
+
+		joint.parent = parent;
+		joint.bone = -1;
+		joint.channel = -1;
+		joint.transform = boneNode->GetTransform ();
+
+		BoneInfo* boneInfo = animationModel->GetBone (boneNode->GetName ());
+
+		if (boneInfo != nullptr) {
+			joint.bone = (int) boneInfo->GetID ();
+		}
+
+		AnimationNode* animationNode = animationContainer->GetAnimationNode (boneNode->GetName ());
+
+		if (animationNode != nullptr) {
+			SkeletalAnimationChannel channel;
+
+			for (std::size_t index = 0; index < animationNode->GetPositionKeysCount (); index++) {
+				channel.positionKeys.push_back (animationNode->GetPositionKey (index));
+			}
+
+			for (std::size_t index = 0; index < animationNode->GetRotationKeysCount (); index++) {
+				channel.rotationKeys.push_back (animationNode->GetRotationKey (index));
+			}
+
+			for (std::size_t index = 0; index < animationNode->GetScalingKeysCount (); index++) {
+				channel.scalingKeys.push_back (animationNode->GetScalingKey (index));
+			}
+
+			joint.channel = (int) _channels.size ();
+
+			_channels.push_back (channel);
+		}
+
+		int jointIndex = (int) _joints.size ();
+
+		_joints.push_back (joint);
+
+		/*
+		 * Children are pushed in reverse to keep their order
+		*/
+
+		for (std::size_t index = boneNode->GetChildrenCount (); index > 0; index--) {
+			stack.push_back (std::make_pair (boneNode->GetChild (index - 1), jointIndex));
+		}
+	}
+}
+
+void SkeletalAnimation::InitPose (SkeletalAnimationPose& pose) const
+{
+	pose.positionCursors.assign (_channels.size (), 0);
+	pose.rotationCursors.assign (_channels.size (), 0);
+	pose.scalingCursors.assign (_channels.size (), 0);
+	pose.globalTransforms.assign (_joints.size (), glm::mat4 (1.0f));
+	pose.bonesTransforms.assign (_bonesOffsets.size (), glm::mat4 (1.0f));
+	pose.lastTime = 0.0f;
+}
+
+/*
+ * Going back in time, when the animation loops, restarts the key search
+ * from the first keys
+*/
+
+void SkeletalAnimation::Evaluate (float animationTime, SkeletalAnimationPose& pose) const
+{
+	if (pose.globalTransforms.size () != _joints.size ()) {
+		InitPose (pose);
+	}
+
+	if (animationTime < pose.lastTime) {
+		std::fill (pose.positionCursors.begin (), pose.positionCursors.end (), 0);
+		std::fill (pose.rotationCursors.begin (), pose.rotationCursors.end (), 0);
+		std::fill (pose.scalingCursors.begin (), pose.scalingCursors.end (), 0);
+	}
+
+	pose.lastTime = animationTime;
+
+	for (std::size_t index = 0; index < _joints.size (); index++) {
+		const SkeletalAnimationJoint& joint = _joints [index];
+
+		glm::mat4 localTransform = joint.transform;
+
+		if (joint.channel != -1) {
+			const SkeletalAnimationChannel& channel = _channels [joint.channel];
+
+			glm::vec3 scaling = Interpolate (animationTime, channel.scalingKeys, glm::vec3 (1.0f), pose.scalingCursors [joint.channel]);
+			glm::quat rotation = Interpolate (animationTime, channel.rotationKeys, pose.rotationCursors [joint.channel]);
+			glm::vec3 position = Interpolate (animationTime, channel.positionKeys, glm::vec3 (0.0f), pose.positionCursors [joint.channel]);
+
+			localTransform = glm::translate (glm::mat4 (1.0f), position) *
+				glm::mat4_cast (rotation) * glm::scale (glm::mat4 (1.0f), scaling);
+		}
+
+		glm::mat4& globalTransform = pose.globalTransforms [index];
+
+		globalTransform = joint.parent == -1 ? localTransform : pose.globalTransforms [joint.parent] * localTransform;
+
+		if (joint.bone != -1) {
+			pose.bonesTransforms [joint.bone] = (_globalInverse * globalTransform) * _bonesOffsets [joint.bone];
+		}
+	}
+}
+
+/*
+ * Time in seconds to ticks of the looping animation
+*/
+
+float SkeletalAnimation::GetAnimationTime (float time) const
+{
+	return std::fmod (time * _ticksPerSecond, _duration);
+}
+
+std::size_t SkeletalAnimation::GetJointsCount () const
+{
+	return _joints.size ();
+}
+
+std::size_t SkeletalAnimation::GetBonesCount () const
+{
+	return _bonesOffsets.size ();
+}
+
+/*
+ * Last key that starts before the time, searched from the cursor
+*/
+
+std::size_t SkeletalAnimation::FindKey (float animationTime, const std::vector<VectorKey>& keys, std::size_t cursor)
+{
+	while (cursor + 1 < keys.size () && keys [cursor + 1].time < animationTime) {
+		++ cursor;
+	}
+
+	return cursor;
+}
+
+std::size_t SkeletalAnimation::FindKey (float animationTime, const std::vector<QuatKey>& keys, std::size_t cursor)
+{
+	while (cursor + 1 < keys.size () && keys [cursor + 1].time < animationTime) {
+		++ cursor;
+	}
+
+	return cursor;
+}
+
+/*
+ * After the last key its value is kept, a channel without keys of a
+ * kind keeps the default value
+*/
+
+glm::vec3 SkeletalAnimation::Interpolate (float animationTime, const std::vector<VectorKey>& keys,
+	const glm::vec3& defaultValue, std::size_t& cursor)
+{
+	if (keys.empty ()) {
+		return defaultValue;
+	}
+
+	cursor = FindKey (animationTime, keys, cursor);
+
+	if (cursor + 1 == keys.size ()) {
+		return keys [cursor].value;
+	}
+
+	const VectorKey& start = keys [cursor];
+	const VectorKey& end = keys [cursor + 1];
+
+	float factor = (animationTime - start.time) / (end.time - start.time);
+
+	return start.value + factor * (end.value - start.value);
+}
+
+glm::quat SkeletalAnimation::Interpolate (float animationTime, const std::vector<QuatKey>& keys, std::size_t& cursor)
+{
+	if (keys.empty ()) {
+		return glm::quat ();
+	}
+
+	cursor = FindKey (animationTime, keys, cursor);
+
+	if (cursor + 1 == keys.size ()) {
+		return keys [cursor].value;
+	}
+
+	const QuatKey& start = keys [cursor];
+	const QuatKey& end = keys [cursor + 1];
+
+	float factor = (animationTime - start.time) / (end.time - start.time);
+
+	return glm::normalize (glm::slerp (start.value, end.value, factor));
+}
\ No newline at end of file
@@ -0,0 +1,86 @@
+#ifndef SKELETALANIMATION_H
+#define SKELETALANIMATION_H
+
+#include <vector>
+
+#include "Core/Math/glm/glm.hpp"
+
+#include "AnimationNode.h"
+
+class AnimationModel;
+class AnimationContainer;
+
+/*
+ * Node of the flattened skeleton. A parent always comes before its
+ * children, bone and channel are -1 when the node has none.
+*/
+
+struct SkeletalAnimationJoint
+{
+	int parent;
+	int bone;
+	int channel;
+	glm::mat4 transform;
+};
+
+struct SkeletalAnimationChannel
+{
+	std::vector<VectorKey> positionKeys;
+	std::vector<QuatKey> rotationKeys;
+	std::vector<VectorKey> scalingKeys;
+};
+
+/*
+ * State of one animated instance. The key cursors remember the last key
+ * of every channel, so that a time after the previous one only moves
+ * them forward. All the buffers keep their size between evaluations.
+*/
+
+struct SkeletalAnimationPose
+{
+	std::vector<std::size_t> positionCursors;
+	std::vector<std::size_t> rotationCursors;
+	std::vector<std::size_t> scalingCursors;
+	std::vector<glm::mat4> globalTransforms;
+	std::vector<glm::mat4> bonesTransforms;
+	float lastTime;
+
+	SkeletalAnimationPose ();
+};
+
+/*
+ * Skeleton and animation of a model flattened at load into arrays
+ * indexed by joint, with the channels remapped from bone names to
+ * joints. A pose is evaluated in a single pass over the joints.
+*/
+
+class SkeletalAnimation
+{
+protected:
+	std::vector<SkeletalAnimationJoint> _joints;
+	std::vector<SkeletalAnimationChannel> _channels;
+	std::vector<glm::mat4> _bonesOffsets;
+	glm::mat4 _globalInverse;
+	float _duration;
+	float _ticksPerSecond;
+
+public:
+	SkeletalAnimation (AnimationModel* animationModel, AnimationContainer* animationContainer);
+
+	void InitPose (SkeletalAnimationPose& pose) const;
+	void Evaluate (float animationTime, SkeletalAnimationPose& pose) const;
+
+	float GetAnimationTime (float time) const;
+
+	std::size_t GetJointsCount () const;
+	std::size_t GetBonesCount () const;
+protected:
+	static std::size_t FindKey (float animationTime, const std::vector<VectorKey>& keys, std::size_t cursor);
+	static std::size_t FindKey (float animationTime, const std::vector<QuatKey>& keys, std::size_t cursor);
+
+	static glm::vec3 Interpolate (float animationTime, const std::vector<VectorKey>& keys,
+		const glm::vec3& defaultValue, std::size_t& cursor);
+	static glm::quat Interpolate (float animationTime, const std::vector<QuatKey>& keys, std::size_t& cursor);
+};
+
+#endif
\ No newline at end of file
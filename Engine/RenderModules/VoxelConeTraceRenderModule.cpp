@@ -17,7 +17,15 @@ void VoxelConeTraceRenderModule::Init ()
 	* Initialize voxel cone trace render module as a collection of render passes
 	*/
 
-	_renderPasses.push_back (new VoxelizationRenderPass ());
+	/*
+	 * One voxelization pass for each cascade of the clipmap, the first
+	 * one also voxelizes the scene when there is no clipmap
+	*/
+
+	for (std::size_t cascade = 0; cascade < VOXEL_CLIPMAP_MAX_CASCADES; cascade++) {
+		_renderPasses.push_back (new VoxelizationRenderPass (cascade));
+	}
+
 	_renderPasses.push_back (new DirectionalShadowMapRenderPass ());
 	_renderPasses.push_back (new VoxelRadianceInjectionRenderPass ());
 	_renderPasses.push_back (new VoxelMipmapRenderPass ());
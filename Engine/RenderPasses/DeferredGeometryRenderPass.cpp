@@ -1,22 +1,22 @@
 #include "DeferredGeometryRenderPass.h"
 
-#include <algorithm>
-
 #include "Systems/Window/Window.h"
 #include "Systems/Input/Input.h"
 
-#include "Core/Intersections/Intersection.h"
-
 #include "Renderer/Pipeline.h"
 
 #include "Wrappers/OpenGL/GL.h"
 
+#include "Settings/GeneralSettings.h"
+
 #include "Debug/Profiler/Profiler.h"
 #include "Debug/Statistics/StatisticsManager.h"
 #include "Debug/Statistics/DrawnObjectsCountStat.h"
+#include "Debug/Statistics/DrawListStat.h"
 
 DeferredGeometryRenderPass::DeferredGeometryRenderPass () :
-	_frameBuffer (new GBuffer ())
+	_frameBuffer (new GBuffer ()),
+	_drawList ()
 {
 
 }
@@ -77,10 +77,6 @@ void DeferredGeometryRenderPass::PrepareDrawing ()
 	_frameBuffer->StartFrame ();
 }
 
-bool cmp (Renderer* a, Renderer* b) {
-	return a->GetPriority () < b->GetPriority ();
-}
-
 void DeferredGeometryRenderPass::GeometryPass (Scene* scene, Camera* camera)
 {
 	_frameBuffer->BindForGeomPass ();
@@ -107,42 +103,42 @@ void DeferredGeometryRenderPass::GeometryPass (Scene* scene, Camera* camera)
 	* Render scene entities to framebuffer at Deferred Rendering Stage
 	*/
 
-	std::vector<Renderer*> renderers;
+	_drawList.Begin (camera);
 
-	FrustumVolume* frustum = camera->GetFrustumVolume ();
+	/*
+	* Culling Check
+	*/
 
-	std::size_t drawnObjectsCount = 0;
+	std::vector<FrustumVolume*> frustums (1, camera->GetFrustumVolume ());
+	std::vector<std::vector<SceneObject*>> visibleObjects;
 
-	for (SceneObject* sceneObject : *scene) {
-		if (sceneObject->GetRenderer ()->GetStageType () != Renderer::StageType::DEFERRED_STAGE) {
-			continue;
-		}
+	scene->GetVisibleObjects (frustums, visibleObjects);
 
-		/*
-		* Culling Check
-		*/
-
-		if (sceneObject->GetCollider () == nullptr) {
-			continue;
-		}
+	std::size_t drawnObjectsCount = 0;
 
-		GeometricPrimitive* primitive = sceneObject->GetCollider ()->GetGeometricPrimitive ();
-		if (!Intersection::Instance ()->CheckFrustumVsPrimitive (frustum, primitive)) {
+	for (SceneObject* sceneObject : visibleObjects [0]) {
+		if (sceneObject->GetRenderer ()->GetStageType () != Renderer::StageType::DEFERRED_STAGE) {
 			continue;
 		}
 
 		drawnObjectsCount++;
 
-		renderers.push_back (sceneObject->GetRenderer ());
+		sceneObject->GetRenderer ()->Collect (&_drawList);
 	}
 
 	StatisticsManager::Instance ()->SetStatisticsObject ("DrawnObjectsCount", new DrawnObjectsCountStat (drawnObjectsCount));
 
-	std::sort (renderers.begin (), renderers.end (), cmp);
+	/*
+	* Packets are ordered by priority first, then grouped by shader and
+	* material
+	*/
 
-	for (Renderer* renderer : renderers) {
-		renderer->Draw ();
-	}
+	_drawList.Sort ();
+
+	_drawList.SetIndirectDraw (GeneralSettings::Instance ()->GetIntValue (INDIRECT_DRAW_SETTING) == 1);
+	_drawList.Submit ();
+
+	StatisticsManager::Instance ()->SetStatisticsObject ("DrawList", new DrawListStat (_drawList.GetStatistics ()));
 
 	/*
 	* Disable Stecil Test for further rendering
@@ -2,6 +2,7 @@
 #define DEFERREGEOMTRYRENDERPASS_H
 
 #include "Renderer/RenderPassI.h"
+#include "Renderer/DrawList.h"
 
 #include "GBuffer.h"
 
@@ -9,6 +10,7 @@ class DeferredGeometryRenderPass : public RenderPassI
 {
 protected:
 	GBuffer* _frameBuffer;
+	DrawList _drawList;
 
 public:
 	DeferredGeometryRenderPass ();
@@ -10,8 +10,6 @@
 
 #include "Renderer/Pipeline.h"
 
-#include "Core/Intersections/Intersection.h"
-
 #include "Settings/GeneralSettings.h"
 
 #include "Core/Console/Console.h"
@@ -112,33 +110,23 @@ void DirectionalShadowMapRenderPass::ShadowMapGeometryPass (Scene* scene, Camera
 	GL::CullFace (GL_FRONT);
 
 	/*
-	* Light camera
+	* Culling Check from light camera
 	*/
 
-	FrustumVolume* frustum = lightCamera->GetFrustumVolume ();
+	std::vector<FrustumVolume*> frustums (1, lightCamera->GetFrustumVolume ());
+	std::vector<std::vector<SceneObject*>> visibleObjects;
+
+	scene->GetVisibleObjects (frustums, visibleObjects);
 
 	/*
 	* Render scene entities to framebuffer at Deferred Rendering Stage
 	*/
 
-	for (SceneObject* sceneObject : *scene) {
+	for (SceneObject* sceneObject : visibleObjects [0]) {
 		if (sceneObject->GetRenderer ()->GetStageType () != Renderer::StageType::DEFERRED_STAGE) {
 			continue;
 		}
 
-		/*
-		* Culling Check
-		*/
-
-		if (sceneObject->GetCollider () == nullptr) {
-			continue;
-		}
-
-		GeometricPrimitive* primitive = sceneObject->GetCollider ()->GetGeometricPrimitive ();
-		if (!Intersection::Instance ()->CheckFrustumVsPrimitive (frustum, primitive)) {
-			continue;
-		}
-
 		/*
 		* Lock shader based on scene object layer
 		*/
@@ -55,32 +55,53 @@ void VoxelBorderRenderPass::StartVoxelBordering ()
 	Pipeline::SetShader (ShaderManager::Instance ()->GetShader ("VOXEL_BORDER_PASS_COMPUTE_SHADER"));
 }
 
-#define MIPMAP_LEVELS 6
-
 void VoxelBorderRenderPass::BorderVoxelVolume (RenderVolumeCollection* rvc)
 {
-	std::size_t dstMipRes = 256;
+	/*
+	 * Every cascade of the clipmap is a volume of its own
+	*/
+
+	for (std::size_t cascade = 0; cascade < VOXEL_CLIPMAP_MAX_CASCADES; cascade++) {
+		VoxelVolume* voxelVolume = (VoxelVolume*) rvc->GetRenderVolume (VoxelVolume::GetCascadeName (cascade));
+
+		if (voxelVolume == nullptr) {
+			break;
+		}
+
+		BorderVoxelVolume (rvc, voxelVolume);
+	}
+}
+
+void VoxelBorderRenderPass::BorderVoxelVolume (RenderVolumeCollection* rvc, VoxelVolume* voxelVolume)
+{
 	Shader* computeShader = ShaderManager::Instance ()->GetShader ("VOXEL_BORDER_PASS_COMPUTE_SHADER");
 
-	VoxelVolume* voxelVolume = (VoxelVolume*) rvc->GetRenderVolume ("VoxelVolume");
+	std::size_t mipmapLevels = voxelVolume->GetMipmapLevels ();
 
 	voxelVolume->BindForReading ();
 
-	for (int mipLevel = 0; mipLevel < MIPMAP_LEVELS; mipLevel++) {
+	for (std::size_t mipLevel = 0; mipLevel < mipmapLevels; mipLevel++) {
 
 		Pipeline::SendCustomAttributes ("VOXEL_BORDER_PASS_COMPUTE_SHADER",
-			rvc->GetRenderVolume ("VoxelVolume")->GetCustomAttributes ());
+			voxelVolume->GetCustomAttributes ());
 
 		GL::Uniform1i (computeShader->GetUniformLocation ("SrcMipLevel"), mipLevel);
-		GL::Uniform1i (computeShader->GetUniformLocation ("DstMipRes"), dstMipRes);
+		GL::Uniform1i (computeShader->GetUniformLocation ("DstMipRes"),
+			voxelVolume->GetConfiguration ().GetLevelSize (mipLevel));
 
 		voxelVolume->BindForWriting (mipLevel);
 
-		int numWorkGroups = glm::ceil (dstMipRes / 4.0);
-		GL::DispatchCompute (numWorkGroups, numWorkGroups, numWorkGroups);
+		for (const VoxelBrickRegion& region : voxelVolume->GetUpdateRegions (mipLevel, 1)) {
+			GL::Uniform3i (computeShader->GetUniformLocation ("DstOffset"),
+				region.offset.x, region.offset.y, region.offset.z);
+			GL::Uniform3i (computeShader->GetUniformLocation ("DstSize"),
+				region.size.x, region.size.y, region.size.z);
+
+			glm::ivec3 workGroupsCount = VoxelVolumeConfiguration::GetWorkGroupsCount (region.size);
+			GL::DispatchCompute (workGroupsCount.x, workGroupsCount.y, workGroupsCount.z);
+		}
 
 		GL::MemoryBarrier (GL_TEXTURE_FETCH_BARRIER_BIT | GL_SHADER_IMAGE_ACCESS_BARRIER_BIT);
-		dstMipRes >>= 1;
 	}
 }
 
@@ -3,6 +3,8 @@
 
 #include "Renderer/RenderPassI.h"
 
+#include "VoxelVolume.h"
+
 class VoxelBorderRenderPass : public RenderPassI
 {
 public:
@@ -13,6 +15,7 @@ public:
 protected:
 	void StartVoxelBordering ();
 	void BorderVoxelVolume (RenderVolumeCollection*);
+	void BorderVoxelVolume (RenderVolumeCollection*, VoxelVolume*);
 	void EndVoxelBordering ();
 };
 
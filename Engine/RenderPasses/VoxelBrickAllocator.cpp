@@ -0,0 +1,265 @@
+#include "VoxelBrickAllocator.h"
+
+#include <algorithm>
+
+VoxelBrickAllocator::VoxelBrickAllocator () :
+	_volumeSize (0),
+	_brickSize (0),
+	_capacity (0),
+	_bricksCount (),
+	_pageTable (),
+	_marks (),
+	_freeSlots (),
+	_changes (),
+	_droppedBricksCount (0)
+{
+
+}
+
+/*
+ * Levels are split in whole bricks, so every level must be at least one
+ * brick large
+*/
+
+void VoxelBrickAllocator::Init (std::size_t volumeSize, std::size_t levelsCount, const glm::ivec3& brickSize, std::size_t capacity)
+{
+	_volumeSize = volumeSize;
+	_brickSize = brickSize;
+	_capacity = capacity;
+
+	_bricksCount.clear ();
+	_pageTable.clear ();
+	_marks.clear ();
+	_changes.clear ();
+	_droppedBricksCount = 0;
+
+	for (std::size_t level=0;level<levelsCount;level++) {
+		int levelSize = (int) std::max ((std::size_t) 1, volumeSize >> level);
+
+		glm::ivec3 bricksCount = glm::max (glm::ivec3 (levelSize) / _brickSize, glm::ivec3 (1));
+
+		_bricksCount.push_back (bricksCount);
+		_pageTable.push_back (std::vector<int> (bricksCount.x * bricksCount.y * bricksCount.z, VOXEL_BRICK_EMPTY));
+		_marks.push_back (std::vector<bool> (bricksCount.x * bricksCount.y * bricksCount.z, false));
+	}
+
+	/*
+	 * Slots are handed out from the back, lowest slot first
+	*/
+
+	_freeSlots.resize (_capacity);
+
+	for (std::size_t i=0;i<_capacity;i++) {
+		_freeSlots [i] = (int) (_capacity - i - 1);
+	}
+}
+
+void VoxelBrickAllocator::BeginUpdate ()
+{
+	for (std::size_t level=0;level<_marks.size ();level++) {
+		std::fill (_marks [level].begin (), _marks [level].end (), false);
+	}
+}
+
+/*
+ * The region is given in voxels of the first level. It is marked on every
+ * level, since the mipmaps of an occupied voxel are occupied as well.
+*/
+
+void VoxelBrickAllocator::MarkRegion (const glm::vec3& minVoxel, const glm::vec3& maxVoxel)
+{
+	for (std::size_t level=0;level<_marks.size ();level++) {
+		glm::vec3 levelBrickSize = glm::vec3 (_brickSize) * (float) (1 << level);
+
+		glm::ivec3 minBrick = glm::ivec3 (glm::floor (minVoxel / levelBrickSize));
+		glm::ivec3 maxBrick = glm::ivec3 (glm::floor (maxVoxel / levelBrickSize));
+
+		minBrick = glm::clamp (minBrick, glm::ivec3 (0), _bricksCount [level] - 1);
+		maxBrick = glm::clamp (maxBrick, glm::ivec3 (0), _bricksCount [level] - 1);
+
+		for (int z=minBrick.z;z<=maxBrick.z;z++) {
+			for (int y=minBrick.y;y<=maxBrick.y;y++) {
+				for (int x=minBrick.x;x<=maxBrick.x;x++) {
+					_marks [level][GetBrickIndex (level, glm::ivec3 (x, y, z))] = true;
+				}
+			}
+		}
+	}
+}
+
+/*
+ * The brick is given on the first level, the bricks of the coarser
+ * levels that hold it are marked with it
+*/
+
+void VoxelBrickAllocator::MarkBrick (const glm::ivec3& position)
+{
+	for (std::size_t level=0;level<_marks.size ();level++) {
+		glm::ivec3 levelPosition = glm::clamp (position / (1 << level), glm::ivec3 (0), _bricksCount [level] - 1);
+
+		_marks [level][GetBrickIndex (level, levelPosition)] = true;
+	}
+}
+
+/*
+ * Returns false when the pool could not hold every marked brick
+*/
+
+bool VoxelBrickAllocator::EndUpdate ()
+{
+	_changes.clear ();
+	_droppedBricksCount = 0;
+
+	/*
+	 * Release the bricks that are not needed anymore first, so their slots
+	 * can be reused by the new ones
+	*/
+
+	for (std::size_t level=0;level<_pageTable.size ();level++) {
+		for (std::size_t index=0;index<_pageTable [level].size ();index++) {
+			if (_pageTable [level][index] == VOXEL_BRICK_EMPTY || _marks [level][index]) {
+				continue;
+			}
+
+			_freeSlots.push_back (_pageTable [level][index]);
+			_pageTable [level][index] = VOXEL_BRICK_EMPTY;
+
+			VoxelBrickChange change;
+			change.level = level;
+			change.position = GetBrickPosition (level, index);
+			change.isAllocated = false;
+
+			_changes.push_back (change);
+		}
+	}
+
+	for (std::size_t level=_pageTable.size ();level-->0;) {
+		for (std::size_t index=0;index<_pageTable [level].size ();index++) {
+			if (_pageTable [level][index] != VOXEL_BRICK_EMPTY || !_marks [level][index]) {
+				continue;
+			}
+
+			if (_freeSlots.empty ()) {
+				_droppedBricksCount ++;
+				continue;
+			}
+
+			_pageTable [level][index] = _freeSlots.back ();
+			_freeSlots.pop_back ();
+
+			VoxelBrickChange change;
+			change.level = level;
+			change.position = GetBrickPosition (level, index);
+			change.isAllocated = true;
+
+			_changes.push_back (change);
+		}
+	}
+
+	return _droppedBricksCount == 0;
+}
+
+int VoxelBrickAllocator::GetSlot (std::size_t level, const glm::ivec3& position) const
+{
+	if (level >= _pageTable.size () ||
+		glm::any (glm::lessThan (position, glm::ivec3 (0))) ||
+		glm::any (glm::greaterThanEqual (position, _bricksCount [level]))) {
+		return VOXEL_BRICK_EMPTY;
+	}
+
+	return _pageTable [level][GetBrickIndex (level, position)];
+}
+
+/*
+ * Neighbour bricks on the same row are merged into one region, which
+ * keeps the number of clears and dispatches down
+*/
+
+std::vector<VoxelBrickRegion> VoxelBrickAllocator::GetRegions (std::size_t level) const
+{
+	std::vector<VoxelBrickRegion> regions;
+
+	if (level >= _pageTable.size ()) {
+		return regions;
+	}
+
+	glm::ivec3 bricksCount = _bricksCount [level];
+	int levelSize = (int) std::max ((std::size_t) 1, _volumeSize >> level);
+
+	for (int z=0;z<bricksCount.z;z++) {
+		for (int y=0;y<bricksCount.y;y++) {
+			int x = 0;
+
+			while (x < bricksCount.x) {
+				if (_pageTable [level][GetBrickIndex (level, glm::ivec3 (x, y, z))] == VOXEL_BRICK_EMPTY) {
+					x ++;
+					continue;
+				}
+
+				int runStart = x;
+
+				while (x < bricksCount.x && _pageTable [level][GetBrickIndex (level, glm::ivec3 (x, y, z))] != VOXEL_BRICK_EMPTY) {
+					x ++;
+				}
+
+				VoxelBrickRegion region;
+				region.level = level;
+				region.offset = glm::ivec3 (runStart, y, z) * _brickSize;
+				region.size = glm::ivec3 (x - runStart, 1, 1) * _brickSize;
+				region.size = glm::min (region.size, glm::ivec3 (levelSize) - region.offset);
+
+				regions.push_back (region);
+			}
+		}
+	}
+
+	return regions;
+}
+
+const std::vector<VoxelBrickChange>& VoxelBrickAllocator::GetChanges () const
+{
+	return _changes;
+}
+
+std::size_t VoxelBrickAllocator::GetLevelsCount () const
+{
+	return _pageTable.size ();
+}
+
+glm::ivec3 VoxelBrickAllocator::GetBrickSize () const
+{
+	return _brickSize;
+}
+
+glm::ivec3 VoxelBrickAllocator::GetBricksCount (std::size_t level) const
+{
+	return _bricksCount [level];
+}
+
+std::size_t VoxelBrickAllocator::GetCapacity () const
+{
+	return _capacity;
+}
+
+std::size_t VoxelBrickAllocator::GetAllocatedBricksCount () const
+{
+	return _capacity - _freeSlots.size ();
+}
+
+std::size_t VoxelBrickAllocator::GetDroppedBricksCount () const
+{
+	return _droppedBricksCount;
+}
+
+std::size_t VoxelBrickAllocator::GetBrickIndex (std::size_t level, const glm::ivec3& position) const
+{
+	return position.x + _bricksCount [level].x * (position.y + _bricksCount [level].y * position.z);
+}
+
+glm::ivec3 VoxelBrickAllocator::GetBrickPosition (std::size_t level, std::size_t index) const
+{
+	glm::ivec3 bricksCount = _bricksCount [level];
+
+	return glm::ivec3 (index % bricksCount.x, (index / bricksCount.x) % bricksCount.y,
+		index / (bricksCount.x * bricksCount.y));
+}
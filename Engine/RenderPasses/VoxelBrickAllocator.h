@@ -0,0 +1,86 @@
+#ifndef VOXELBRICKALLOCATOR_H
+#define VOXELBRICKALLOCATOR_H
+
+#include <vector>
+#include <cstddef>
+
+#include "Core/Math/glm/glm.hpp"
+
+#define VOXEL_BRICK_EMPTY -1
+
+/*
+ * Box of voxels of one mipmap level, used to clear or dispatch only the
+ * allocated part of the volume
+*/
+
+struct VoxelBrickRegion
+{
+	std::size_t level;
+	glm::ivec3 offset;
+	glm::ivec3 size;
+};
+
+/*
+ * Brick that was allocated or released by the last update
+*/
+
+struct VoxelBrickChange
+{
+	std::size_t level;
+	glm::ivec3 position;
+	bool isAllocated;
+};
+
+/*
+ * CPU side bookkeeping of a bricked voxel volume. Every mipmap level is
+ * split in bricks, the page table of each level keeps the pool slot of
+ * the occupied bricks. The allocator only works with indices, it does
+ * not touch the GPU.
+ *
+ * An update marks the bricks needed for the current frame. Bricks that
+ * are no longer marked go back to the pool and the new ones are taken
+ * from it, coarse levels first, for as long as the pool has free slots.
+*/
+
+class VoxelBrickAllocator
+{
+protected:
+	std::size_t _volumeSize;
+	glm::ivec3 _brickSize;
+	std::size_t _capacity;
+
+	std::vector<glm::ivec3> _bricksCount;
+	std::vector<std::vector<int>> _pageTable;
+	std::vector<std::vector<bool>> _marks;
+
+	std::vector<int> _freeSlots;
+	std::vector<VoxelBrickChange> _changes;
+	std::size_t _droppedBricksCount;
+
+public:
+	VoxelBrickAllocator ();
+
+	void Init (std::size_t volumeSize, std::size_t levelsCount, const glm::ivec3& brickSize, std::size_t capacity);
+
+	void BeginUpdate ();
+	void MarkRegion (const glm::vec3& minVoxel, const glm::vec3& maxVoxel);
+	void MarkBrick (const glm::ivec3& position);
+	bool EndUpdate ();
+
+	int GetSlot (std::size_t level, const glm::ivec3& position) const;
+
+	std::vector<VoxelBrickRegion> GetRegions (std::size_t level) const;
+	const std::vector<VoxelBrickChange>& GetChanges () const;
+
+	std::size_t GetLevelsCount () const;
+	glm::ivec3 GetBrickSize () const;
+	glm::ivec3 GetBricksCount (std::size_t level) const;
+	std::size_t GetCapacity () const;
+	std::size_t GetAllocatedBricksCount () const;
+	std::size_t GetDroppedBricksCount () const;
+protected:
+	std::size_t GetBrickIndex (std::size_t level, const glm::ivec3& position) const;
+	glm::ivec3 GetBrickPosition (std::size_t level, std::size_t index) const;
+};
+
+#endif
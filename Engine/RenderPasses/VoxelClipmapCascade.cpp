@@ -0,0 +1,226 @@
+#include "VoxelClipmapCascade.h"
+
+#include <algorithm>
+#include <cmath>
+
+VoxelClipmapCascade::VoxelClipmapCascade () :
+	_volumeSize (0),
+	_snapSize (1),
+	_voxelSize (1.0f),
+	_origin (0),
+	_isPlaced (false),
+	_updateRegions (),
+	_isFullUpdate (false)
+{
+
+}
+
+/*
+ * The window snaps to the texels of the coarsest level, but never more
+ * than an eighth of the window, so the camera stays near its center
+*/
+
+void VoxelClipmapCascade::Init (const VoxelVolumeConfiguration& configuration, std::size_t cascade)
+{
+	_volumeSize = configuration.volumeSize;
+	_voxelSize = configuration.GetCascadeVoxelSize (cascade);
+
+	_snapSize = std::min ((std::size_t) 1 << (configuration.mipmapLevels - 1), std::max (_volumeSize / 8, (std::size_t) 1));
+
+	_origin = glm::ivec3 (0);
+	_isPlaced = false;
+
+	_updateRegions.clear ();
+	_isFullUpdate = false;
+}
+
+/*
+ * Moves the window to the center. The voxels that entered the window
+ * are split in up to three slabs, one for each axis the window moved
+ * on, that do not overlap. The slabs are kept as texture regions.
+*/
+
+void VoxelClipmapCascade::Update (const glm::vec3& center)
+{
+	glm::ivec3 lastOrigin = _origin;
+	glm::ivec3 volumeSize = glm::ivec3 ((int) _volumeSize);
+
+	_origin = GetSnappedOrigin (center);
+
+	_updateRegions.clear ();
+	_isFullUpdate = false;
+
+	/*
+	 * Nothing of the last window is left
+	*/
+
+	if (!_isPlaced || glm::any (glm::greaterThanEqual (glm::abs (_origin - lastOrigin), volumeSize))) {
+		VoxelBrickRegion region;
+		region.level = 0;
+		region.offset = glm::ivec3 (0);
+		region.size = volumeSize;
+
+		_updateRegions.push_back (region);
+		_isFullUpdate = true;
+		_isPlaced = true;
+
+		return;
+	}
+
+	/*
+	 * Part of the new window that is not covered by a slab yet
+	*/
+
+	glm::ivec3 remainingMin = _origin;
+	glm::ivec3 remainingMax = _origin + volumeSize;
+
+	for (int axis = 0; axis < 3; axis ++) {
+		int offset = _origin [axis] - lastOrigin [axis];
+
+		if (offset == 0) {
+			continue;
+		}
+
+		glm::ivec3 slabMin = remainingMin;
+		glm::ivec3 slabMax = remainingMax;
+
+		if (offset > 0) {
+			slabMin [axis] = lastOrigin [axis] + volumeSize [axis];
+			remainingMax [axis] = slabMin [axis];
+		} else {
+			slabMax [axis] = lastOrigin [axis];
+			remainingMin [axis] = slabMax [axis];
+		}
+
+		std::vector<VoxelBrickRegion> slabRegions = GetTextureRegions (slabMin - _origin, slabMax - _origin);
+
+		_updateRegions.insert (_updateRegions.end (), slabRegions.begin (), slabRegions.end ());
+	}
+}
+
+bool VoxelClipmapCascade::IsFullUpdate () const
+{
+	return _isFullUpdate;
+}
+
+const std::vector<VoxelBrickRegion>& VoxelClipmapCascade::GetUpdateRegions () const
+{
+	return _updateRegions;
+}
+
+std::size_t VoxelClipmapCascade::GetUpdateVoxelsCount () const
+{
+	std::size_t voxelsCount = 0;
+
+	for (const VoxelBrickRegion& region : _updateRegions) {
+		voxelsCount += (std::size_t) region.size.x * region.size.y * region.size.z;
+	}
+
+	return voxelsCount;
+}
+
+/*
+ * Texture regions of a box of window voxels, the maximum is exclusive.
+ * The box is clamped to the window and split where it wraps around the
+ * texture, in up to eight regions.
+*/
+
+std::vector<VoxelBrickRegion> VoxelClipmapCascade::GetTextureRegions (const glm::ivec3& minVoxel, const glm::ivec3& maxVoxel) const
+{
+	std::vector<VoxelBrickRegion> regions;
+
+	glm::ivec3 volumeSize = glm::ivec3 ((int) _volumeSize);
+
+	glm::ivec3 windowMin = glm::clamp (minVoxel, glm::ivec3 (0), volumeSize);
+	glm::ivec3 windowMax = glm::clamp (maxVoxel, glm::ivec3 (0), volumeSize);
+
+	if (glm::any (glm::lessThanEqual (windowMax, windowMin))) {
+		return regions;
+	}
+
+	/*
+	 * Texture ranges of every axis, one or two of them
+	*/
+
+	glm::ivec3 textureOffset = GetTextureOffset ();
+
+	int rangesCount [3];
+	int rangesMin [3][2];
+	int rangesMax [3][2];
+
+	for (int axis = 0; axis < 3; axis ++) {
+		int textureMin = Wrap (windowMin [axis] + textureOffset [axis], volumeSize [axis]);
+		int textureMax = textureMin + windowMax [axis] - windowMin [axis];
+
+		rangesCount [axis] = 1;
+		rangesMin [axis][0] = textureMin;
+		rangesMax [axis][0] = std::min (textureMax, volumeSize [axis]);
+
+		if (textureMax > volumeSize [axis]) {
+			rangesCount [axis] = 2;
+			rangesMin [axis][1] = 0;
+			rangesMax [axis][1] = textureMax - volumeSize [axis];
+		}
+	}
+
+	for (int x = 0; x < rangesCount [0]; x ++) {
+		for (int y = 0; y < rangesCount [1]; y ++) {
+			for (int z = 0; z < rangesCount [2]; z ++) {
+				VoxelBrickRegion region;
+				region.level = 0;
+				region.offset = glm::ivec3 (rangesMin [0][x], rangesMin [1][y], rangesMin [2][z]);
+				region.size = glm::ivec3 (rangesMax [0][x], rangesMax [1][y], rangesMax [2][z]) - region.offset;
+
+				regions.push_back (region);
+			}
+		}
+	}
+
+	return regions;
+}
+
+/*
+ * First voxel of the window, counted in voxels of the cascade from the
+ * world origin
+*/
+
+glm::ivec3 VoxelClipmapCascade::GetOrigin () const
+{
+	return _origin;
+}
+
+glm::ivec3 VoxelClipmapCascade::GetTextureOffset () const
+{
+	int volumeSize = (int) _volumeSize;
+
+	return glm::ivec3 (Wrap (_origin.x, volumeSize), Wrap (_origin.y, volumeSize), Wrap (_origin.z, volumeSize));
+}
+
+glm::vec3 VoxelClipmapCascade::GetMinVertex () const
+{
+	return glm::vec3 (_origin) * _voxelSize;
+}
+
+glm::vec3 VoxelClipmapCascade::GetMaxVertex () const
+{
+	return glm::vec3 (_origin + glm::ivec3 ((int) _volumeSize)) * _voxelSize;
+}
+
+float VoxelClipmapCascade::GetVoxelSize () const
+{
+	return _voxelSize;
+}
+
+glm::ivec3 VoxelClipmapCascade::GetSnappedOrigin (const glm::vec3& center) const
+{
+	glm::vec3 snapExtent = glm::vec3 (_snapSize * _voxelSize);
+
+	glm::ivec3 snappedCenter = glm::ivec3 (glm::floor (center / snapExtent)) * (int) _snapSize;
+
+	return snappedCenter - glm::ivec3 ((int) _volumeSize / 2);
+}
+
+int VoxelClipmapCascade::Wrap (int value, int size)
+{
+	return ((value % size) + size) % size;
+}
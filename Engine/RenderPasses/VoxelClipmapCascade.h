@@ -0,0 +1,60 @@
+#ifndef VOXELCLIPMAPCASCADE_H
+#define VOXELCLIPMAPCASCADE_H
+
+#include <vector>
+#include <cstddef>
+
+#include "Core/Math/glm/glm.hpp"
+
+#include "VoxelBrickAllocator.h"
+#include "VoxelVolumeConfiguration.h"
+
+/*
+ * Placement of one clipmap cascade around the camera. The window of the
+ * cascade moves on a grid of whole voxels, snapped so the texels of the
+ * mipmap levels keep covering the same voxels. The volume texture is
+ * addressed toroidally: a voxel of the window keeps its texel while the
+ * window moves, so only the slabs that enter the window are voxelized.
+ *
+ * Window voxels start at the minimum of the window, texture voxels at
+ * the first texel. The texture offset is the texel of the first window
+ * voxel.
+*/
+
+class VoxelClipmapCascade
+{
+protected:
+	std::size_t _volumeSize;
+	std::size_t _snapSize;
+	float _voxelSize;
+
+	glm::ivec3 _origin;
+	bool _isPlaced;
+
+	std::vector<VoxelBrickRegion> _updateRegions;
+	bool _isFullUpdate;
+
+public:
+	VoxelClipmapCascade ();
+
+	void Init (const VoxelVolumeConfiguration& configuration, std::size_t cascade);
+	void Update (const glm::vec3& center);
+
+	bool IsFullUpdate () const;
+	const std::vector<VoxelBrickRegion>& GetUpdateRegions () const;
+	std::size_t GetUpdateVoxelsCount () const;
+
+	std::vector<VoxelBrickRegion> GetTextureRegions (const glm::ivec3& minVoxel, const glm::ivec3& maxVoxel) const;
+
+	glm::ivec3 GetOrigin () const;
+	glm::ivec3 GetTextureOffset () const;
+	glm::vec3 GetMinVertex () const;
+	glm::vec3 GetMaxVertex () const;
+	float GetVoxelSize () const;
+protected:
+	glm::ivec3 GetSnappedOrigin (const glm::vec3& center) const;
+
+	static int Wrap (int value, int size);
+};
+
+#endif
@@ -48,8 +48,6 @@ void VoxelConeTraceLightPass::DirectionalLightPass (Scene* scene, Camera* camera
 	GL::Disable (GL_DEPTH_TEST);
 	GL::BlendFunc (GL_ONE, GL_ZERO);
 
-	VoxelVolume* voxelVolume = (VoxelVolume*) rvc->GetRenderVolume ("VoxelVolume");
-
 	for (std::size_t i = 0; i<LightsManager::Instance ()->GetDirectionalLightsCount (); i++) {
 		VolumetricLight* volumetricLight = LightsManager::Instance ()->GetDirectionalLight (i);
 
@@ -57,7 +55,19 @@ void VoxelConeTraceLightPass::DirectionalLightPass (Scene* scene, Camera* camera
 			continue;
 		}
 
-		voxelVolume->BindForReading ();
+		/*
+		 * Cones are traced through every cascade
+		*/
+
+		for (std::size_t cascade = 0; cascade < VOXEL_CLIPMAP_MAX_CASCADES; cascade++) {
+			RenderVolumeI* voxelVolume = rvc->GetRenderVolume (VoxelVolume::GetCascadeName (cascade));
+
+			if (voxelVolume == nullptr) {
+				break;
+			}
+
+			voxelVolume->BindForReading ();
+		}
 
 		volumetricLight->GetLightRenderer ()->Draw (scene, camera, rvc);
 	}
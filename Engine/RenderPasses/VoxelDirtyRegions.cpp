@@ -0,0 +1,193 @@
+#include "VoxelDirtyRegions.h"
+
+#include <algorithm>
+
+VoxelDirtyRegions::VoxelDirtyRegions () :
+	_volumeSize (0),
+	_regions (),
+	_isFull (false)
+{
+
+}
+
+void VoxelDirtyRegions::Init (std::size_t volumeSize)
+{
+	_volumeSize = volumeSize;
+
+	Clear ();
+}
+
+void VoxelDirtyRegions::Clear ()
+{
+	_regions.clear ();
+	_isFull = false;
+}
+
+void VoxelDirtyRegions::AddAll ()
+{
+	_regions.clear ();
+	_isFull = true;
+
+	VoxelBrickRegion region;
+	region.level = 0;
+	region.offset = glm::ivec3 (0);
+	region.size = glm::ivec3 ((int) _volumeSize);
+
+	_regions.push_back (region);
+}
+
+/*
+ * The maximum voxel is exclusive. Boxes are clamped to the volume.
+*/
+
+void VoxelDirtyRegions::AddRegion (const glm::ivec3& minVoxel, const glm::ivec3& maxVoxel)
+{
+	if (_isFull) {
+		return;
+	}
+
+	glm::ivec3 regionMin = glm::clamp (minVoxel, glm::ivec3 (0), glm::ivec3 ((int) _volumeSize));
+	glm::ivec3 regionMax = glm::clamp (maxVoxel, glm::ivec3 (0), glm::ivec3 ((int) _volumeSize));
+
+	if (glm::any (glm::lessThanEqual (regionMax, regionMin))) {
+		return;
+	}
+
+	VoxelBrickRegion region;
+	region.level = 0;
+	region.offset = regionMin;
+	region.size = regionMax - regionMin;
+
+	_regions.push_back (region);
+
+	MergeRegions (_regions);
+
+	if (_regions.size () == 1 && _regions [0].offset == glm::ivec3 (0) &&
+		_regions [0].size == glm::ivec3 ((int) _volumeSize)) {
+		_isFull = true;
+	}
+}
+
+bool VoxelDirtyRegions::IsEmpty () const
+{
+	return _regions.empty ();
+}
+
+bool VoxelDirtyRegions::IsFull () const
+{
+	return _isFull;
+}
+
+/*
+ * A voxel of a level is computed from the voxels of the previous one at
+ * twice its position, so the boxes grow outwards while halving. Padding
+ * is added on the level, for passes that also read the neighbours.
+*/
+
+std::vector<VoxelBrickRegion> VoxelDirtyRegions::GetRegions (std::size_t level, int padding) const
+{
+	std::vector<VoxelBrickRegion> regions;
+
+	int levelSize = (int) std::max ((std::size_t) 1, _volumeSize >> level);
+	int levelScale = 1 << level;
+
+	for (const VoxelBrickRegion& dirtyRegion : _regions) {
+		glm::ivec3 regionMin = dirtyRegion.offset / levelScale;
+		glm::ivec3 regionMax = (dirtyRegion.offset + dirtyRegion.size + levelScale - 1) / levelScale;
+
+		regionMin = glm::max (regionMin - padding, glm::ivec3 (0));
+		regionMax = glm::min (regionMax + padding, glm::ivec3 (levelSize));
+
+		VoxelBrickRegion region;
+		region.level = level;
+		region.offset = regionMin;
+		region.size = regionMax - regionMin;
+
+		regions.push_back (region);
+	}
+
+	MergeRegions (regions);
+
+	return regions;
+}
+
+std::size_t VoxelDirtyRegions::GetVoxelsCount () const
+{
+	std::size_t voxelsCount = 0;
+
+	for (const VoxelBrickRegion& region : _regions) {
+		voxelsCount += (std::size_t) region.size.x * region.size.y * region.size.z;
+	}
+
+	return voxelsCount;
+}
+
+bool VoxelDirtyRegions::Intersect (const VoxelBrickRegion& first, const VoxelBrickRegion& second, VoxelBrickRegion& result)
+{
+	glm::ivec3 regionMin = glm::max (first.offset, second.offset);
+	glm::ivec3 regionMax = glm::min (first.offset + first.size, second.offset + second.size);
+
+	if (glm::any (glm::lessThanEqual (regionMax, regionMin))) {
+		return false;
+	}
+
+	result.level = first.level;
+	result.offset = regionMin;
+	result.size = regionMax - regionMin;
+
+	return true;
+}
+
+std::vector<VoxelBrickRegion> VoxelDirtyRegions::Intersect (const std::vector<VoxelBrickRegion>& first, const std::vector<VoxelBrickRegion>& second)
+{
+	std::vector<VoxelBrickRegion> regions;
+
+	for (const VoxelBrickRegion& firstRegion : first) {
+		for (const VoxelBrickRegion& secondRegion : second) {
+			VoxelBrickRegion region;
+
+			if (Intersect (firstRegion, secondRegion, region)) {
+				regions.push_back (region);
+			}
+		}
+	}
+
+	return regions;
+}
+
+/*
+ * Overlapping boxes are replaced by the box around both of them, until
+ * no two boxes overlap. This may cover a few more voxels, but keeps every
+ * voxel in exactly one box.
+*/
+
+void VoxelDirtyRegions::MergeRegions (std::vector<VoxelBrickRegion>& regions)
+{
+	bool isMerged = true;
+
+	while (isMerged) {
+		isMerged = false;
+
+		for (std::size_t i=0;i<regions.size () && !isMerged;i++) {
+			for (std::size_t j=i+1;j<regions.size ();j++) {
+				VoxelBrickRegion overlap;
+
+				if (!Intersect (regions [i], regions [j], overlap)) {
+					continue;
+				}
+
+				glm::ivec3 regionMin = glm::min (regions [i].offset, regions [j].offset);
+				glm::ivec3 regionMax = glm::max (regions [i].offset + regions [i].size,
+					regions [j].offset + regions [j].size);
+
+				regions [i].offset = regionMin;
+				regions [i].size = regionMax - regionMin;
+
+				regions.erase (regions.begin () + j);
+
+				isMerged = true;
+				break;
+			}
+		}
+	}
+}
@@ -0,0 +1,46 @@
+#ifndef VOXELDIRTYREGIONS_H
+#define VOXELDIRTYREGIONS_H
+
+#include <vector>
+#include <cstddef>
+
+#include "Core/Math/glm/glm.hpp"
+
+#include "VoxelBrickAllocator.h"
+
+/*
+ * Parts of the voxel volume that changed since the last frame, kept as
+ * boxes of voxels of the first level. Overlapping boxes are merged. The
+ * boxes of a mipmap level cover every voxel of that level computed from
+ * a changed voxel of the first one.
+*/
+
+class VoxelDirtyRegions
+{
+protected:
+	std::size_t _volumeSize;
+	std::vector<VoxelBrickRegion> _regions;
+	bool _isFull;
+
+public:
+	VoxelDirtyRegions ();
+
+	void Init (std::size_t volumeSize);
+
+	void Clear ();
+	void AddAll ();
+	void AddRegion (const glm::ivec3& minVoxel, const glm::ivec3& maxVoxel);
+
+	bool IsEmpty () const;
+	bool IsFull () const;
+
+	std::vector<VoxelBrickRegion> GetRegions (std::size_t level, int padding = 0) const;
+	std::size_t GetVoxelsCount () const;
+
+	static bool Intersect (const VoxelBrickRegion& first, const VoxelBrickRegion& second, VoxelBrickRegion& result);
+	static std::vector<VoxelBrickRegion> Intersect (const std::vector<VoxelBrickRegion>& first, const std::vector<VoxelBrickRegion>& second);
+protected:
+	static void MergeRegions (std::vector<VoxelBrickRegion>& regions);
+};
+
+#endif
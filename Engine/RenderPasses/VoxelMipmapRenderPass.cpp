@@ -58,28 +58,55 @@ void VoxelMipmapRenderPass::StartVoxelMipmaping ()
 
 void VoxelMipmapRenderPass::GenerateMipmaps (RenderVolumeCollection* rvc)
 {
-	std::size_t dstMipRes = 256 >> 1;
+	/*
+	 * Every cascade of the clipmap is a volume of its own
+	*/
+
+	for (std::size_t cascade = 0; cascade < VOXEL_CLIPMAP_MAX_CASCADES; cascade++) {
+		VoxelVolume* voxelVolume = (VoxelVolume*) rvc->GetRenderVolume (VoxelVolume::GetCascadeName (cascade));
+
+		if (voxelVolume == nullptr) {
+			break;
+		}
+
+		GenerateMipmaps (rvc, voxelVolume);
+	}
+}
+
+void VoxelMipmapRenderPass::GenerateMipmaps (RenderVolumeCollection* rvc, VoxelVolume* voxelVolume)
+{
 	Shader* computeShader = ShaderManager::Instance ()->GetShader ("VOXEL_MIPMAP_PASS_COMPUTE_SHADER");
 
-	VoxelVolume* voxelVolume = (VoxelVolume*) rvc->GetRenderVolume ("VoxelVolume");
+	std::size_t mipmapLevels = voxelVolume->GetMipmapLevels ();
 
 	voxelVolume->BindForReading ();
 
-	for (int mipLevel = 0; mipLevel < MIPMAP_LEVELS - 1; mipLevel++) {
+	for (std::size_t mipLevel = 0; mipLevel + 1 < mipmapLevels; mipLevel++) {
 
 		Pipeline::SendCustomAttributes ("VOXEL_MIPMAP_PASS_COMPUTE_SHADER",
-			rvc->GetRenderVolume ("VoxelVolume")->GetCustomAttributes ());
+			voxelVolume->GetCustomAttributes ());
 
 		GL::Uniform1i (computeShader->GetUniformLocation ("SrcMipLevel"), mipLevel);
-		GL::Uniform1i (computeShader->GetUniformLocation ("DstMipRes"), dstMipRes);
+		GL::Uniform1i (computeShader->GetUniformLocation ("DstMipRes"),
+			voxelVolume->GetConfiguration ().GetLevelSize (mipLevel + 1));
 
 		voxelVolume->BindForWriting (mipLevel + 1);
 
-		int numWorkGroups = glm::ceil (dstMipRes / 4.0);
-		GL::DispatchCompute (numWorkGroups, numWorkGroups, numWorkGroups);
+		/*
+		 * Downsample only the allocated part of the level that changed
+		*/
+
+		for (const VoxelBrickRegion& region : voxelVolume->GetUpdateRegions (mipLevel + 1)) {
+			GL::Uniform3i (computeShader->GetUniformLocation ("DstOffset"),
+				region.offset.x, region.offset.y, region.offset.z);
+			GL::Uniform3i (computeShader->GetUniformLocation ("DstSize"),
+				region.size.x, region.size.y, region.size.z);
+
+			glm::ivec3 workGroupsCount = VoxelVolumeConfiguration::GetWorkGroupsCount (region.size);
+			GL::DispatchCompute (workGroupsCount.x, workGroupsCount.y, workGroupsCount.z);
+		}
 
 		GL::MemoryBarrier (GL_TEXTURE_FETCH_BARRIER_BIT | GL_SHADER_IMAGE_ACCESS_BARRIER_BIT);
-		dstMipRes >>= 1;
 	}
 }
 
@@ -3,7 +3,7 @@
 
 #include "Renderer/RenderPassI.h"
 
-#define MIPMAP_LEVELS 6
+#include "VoxelVolume.h"
 
 class VoxelMipmapRenderPass : public RenderPassI
 {
@@ -15,6 +15,7 @@ public:
 protected:
 	void StartVoxelMipmaping ();
 	void GenerateMipmaps (RenderVolumeCollection*);
+	void GenerateMipmaps (RenderVolumeCollection*, VoxelVolume*);
 	void EndVoxelMipmaping ();
 };
 
@@ -4,6 +4,8 @@
 
 #include "Renderer/Pipeline.h"
 
+#include "VoxelVolume.h"
+
 #include "Settings/GeneralSettings.h"
 
 #include "Debug/Profiler/Profiler.h"
@@ -58,6 +60,23 @@ void VoxelRadianceInjectionRenderPass::StartRadianceInjectionPass ()
 }
 
 void VoxelRadianceInjectionRenderPass::RadianceInjectPass (RenderVolumeCollection* rvc)
+{
+	/*
+	 * Every cascade of the clipmap is a volume of its own
+	*/
+
+	for (std::size_t cascade = 0; cascade < VOXEL_CLIPMAP_MAX_CASCADES; cascade++) {
+		VoxelVolume* voxelVolume = (VoxelVolume*) rvc->GetRenderVolume (VoxelVolume::GetCascadeName (cascade));
+
+		if (voxelVolume == nullptr) {
+			break;
+		}
+
+		RadianceInjectPass (rvc, voxelVolume);
+	}
+}
+
+void VoxelRadianceInjectionRenderPass::RadianceInjectPass (RenderVolumeCollection* rvc, VoxelVolume* voxelVolume)
 {
 	/*
 	 * Bind render volumes for reading
@@ -65,7 +84,7 @@ void VoxelRadianceInjectionRenderPass::RadianceInjectPass (RenderVolumeCollectio
 
 	rvc->GetRenderVolume ("ShadowMapVolume")->BindForReading ();
 
-	rvc->GetRenderVolume ("VoxelVolume")->BindForReading ();
+	voxelVolume->BindForReading ();
 
 	/*
 	 * Send custom attributes of render volumes to pipeline
@@ -75,20 +94,29 @@ void VoxelRadianceInjectionRenderPass::RadianceInjectPass (RenderVolumeCollectio
 		rvc->GetRenderVolume ("ShadowMapVolume")->GetCustomAttributes ());
 
 	Pipeline::SendCustomAttributes ("VOXEL_RADIANCE_INJECTION_PASS_COMPUTE_SHADER",
-		rvc->GetRenderVolume ("VoxelVolume")->GetCustomAttributes ());
+		voxelVolume->GetCustomAttributes ());
 
 	/*
 	 * Bind voxel volume for writing
 	*/
 
-	rvc->GetRenderVolume ("VoxelVolume")->BindForWriting ();
+	voxelVolume->BindForWriting ();
 
 	/*
-	 * Inject radiance
+	 * Inject radiance, only in the allocated bricks that changed
 	*/
 
-	int numWorkGroups = glm::ceil (256.0f / 4.0f);
-	GL::DispatchCompute (numWorkGroups, numWorkGroups, numWorkGroups);
+	Shader* computeShader = ShaderManager::Instance ()->GetShader ("VOXEL_RADIANCE_INJECTION_PASS_COMPUTE_SHADER");
+
+	for (const VoxelBrickRegion& region : voxelVolume->GetUpdateRegions (0)) {
+		GL::Uniform3i (computeShader->GetUniformLocation ("DstOffset"),
+			region.offset.x, region.offset.y, region.offset.z);
+		GL::Uniform3i (computeShader->GetUniformLocation ("DstSize"),
+			region.size.x, region.size.y, region.size.z);
+
+		glm::ivec3 workGroupsCount = VoxelVolumeConfiguration::GetWorkGroupsCount (region.size);
+		GL::DispatchCompute (workGroupsCount.x, workGroupsCount.y, workGroupsCount.z);
+	}
 }
 
 void VoxelRadianceInjectionRenderPass::EndRadianceInjectionPass ()
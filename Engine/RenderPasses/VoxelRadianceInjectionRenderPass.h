@@ -3,6 +3,8 @@
 
 #include "Renderer/RenderPassI.h"
 
+#include "VoxelVolume.h"
+
 class VoxelRadianceInjectionRenderPass : public RenderPassI
 {
 public:
@@ -13,6 +15,7 @@ public:
 protected:
 	void StartRadianceInjectionPass ();
 	void RadianceInjectPass (RenderVolumeCollection*);
+	void RadianceInjectPass (RenderVolumeCollection*, VoxelVolume*);
 	void EndRadianceInjectionPass ();
 };
 
@@ -1,13 +1,25 @@
 #include "VoxelVolume.h"
 
+#include <algorithm>
+#include <string>
+
 #include "Renderer/Pipeline.h"
 
 #include "Settings/GeneralSettings.h"
 
-VoxelVolume::VoxelVolume() :
+#include "Core/Console/Console.h"
+
+VoxelVolume::VoxelVolume(std::size_t cascade) :
 	_volumeTexture(0),
 	_volumeFbo(0),
-	_volumeSize(0)
+	_cascade(cascade),
+	_configuration(),
+	_volumeSize(0),
+	_mipmapLevels(0),
+	_isSparse(false),
+	_brickAllocator(),
+	_dirtyRegions(),
+	_textureOffset(0)
 {
 
 }
@@ -17,7 +29,7 @@ VoxelVolume::~VoxelVolume()
 	Clear();
 }
 
-void VoxelVolume::Init(std::size_t volumeSize)
+void VoxelVolume::Init(const VoxelVolumeConfiguration& configuration)
 {
 	/*
 	* Clear current volume if needed
@@ -26,31 +38,155 @@ void VoxelVolume::Init(std::size_t volumeSize)
 	Clear();
 
 	/*
-	* Keep new current volume size
+	* Keep new current volume size and mipmap chain
 	*/
 
-	_volumeSize = volumeSize;
+	_configuration = configuration;
+	_volumeSize = configuration.volumeSize;
+	_mipmapLevels = configuration.mipmapLevels;
+	_textureOffset = glm::ivec3 (0);
 
 	/*
-	* Create the 3D texture to keep the voxel volume
+	 * Use a bricked volume when possible, the bricks of a cascade would
+	 * move with its window
+	*/
+
+	_isSparse = !IsToroidal () && InitSparseVolume ();
+
+	if (!_isSparse) {
+		InitDenseVolume ();
+	}
+
+	/*
+	 * A new volume needs to be voxelized as a whole
+	*/
+
+	_dirtyRegions.Init (_volumeSize);
+	_dirtyRegions.AddAll ();
+
+	Console::Log (GetCascadeName (_cascade) + " " + std::to_string (_volumeSize) + "^3 with " +
+		std::to_string (_mipmapLevels) + " mipmap levels is " +
+		(_isSparse ? "sparse" : "dense") + ", " +
+		std::to_string (GetMemorySize () / (1024 * 1024)) + " MB resident");
+}
+
+/*
+ * Frees the memory of a cascade that is not used anymore
+*/
+
+void VoxelVolume::Release ()
+{
+	Clear ();
+
+	_isSparse = false;
+}
+
+/*
+ * Needs the second revision of sparse textures, so the unallocated bricks
+ * read as empty voxels while cone tracing
+*/
+
+bool VoxelVolume::InitSparseVolume ()
+{
+	if (!GLEW_ARB_sparse_texture || !GLEW_ARB_sparse_texture2 || !GLEW_ARB_clear_texture) {
+		return false;
+	}
+
+	GLint maxSparseSize = 0;
+	GL::GetIntegerv (GL_MAX_SPARSE_3D_TEXTURE_SIZE_ARB, &maxSparseSize);
+
+	glm::ivec3 brickSize (0);
+
+	GL::GetInternalformativ (GL_TEXTURE_3D, GL_RGBA8, GL_VIRTUAL_PAGE_SIZE_X_ARB, 1, &brickSize.x);
+	GL::GetInternalformativ (GL_TEXTURE_3D, GL_RGBA8, GL_VIRTUAL_PAGE_SIZE_Y_ARB, 1, &brickSize.y);
+	GL::GetInternalformativ (GL_TEXTURE_3D, GL_RGBA8, GL_VIRTUAL_PAGE_SIZE_Z_ARB, 1, &brickSize.z);
+
+	if ((std::size_t) maxSparseSize < _volumeSize || glm::any (glm::lessThanEqual (brickSize, glm::ivec3 (0))) ||
+		_volumeSize % brickSize.x != 0 || _volumeSize % brickSize.y != 0 || _volumeSize % brickSize.z != 0) {
+		return false;
+	}
+
+	/*
+	 * Create the 3D texture to keep the voxel volume, no memory is
+	 * committed yet
 	*/
 
 	GL::GenTextures (1, &_volumeTexture);
 	GL::BindTexture (GL_TEXTURE_3D, _volumeTexture);
-	GL::TexImage3D (GL_TEXTURE_3D, 0, GL_RGBA8, _volumeSize, _volumeSize, _volumeSize,
-		0, GL_RGBA, GL_UNSIGNED_BYTE, 0);
+	GL::TexParameteri (GL_TEXTURE_3D, GL_TEXTURE_SPARSE_ARB, GL_TRUE);
+	GL::TexParameteri (GL_TEXTURE_3D, GL_VIRTUAL_PAGE_SIZE_INDEX_ARB, 0);
+	GL::TexStorage3D (GL_TEXTURE_3D, _mipmapLevels, GL_RGBA8, _volumeSize, _volumeSize, _volumeSize);
 	GL::TexParameteri (GL_TEXTURE_3D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
 	GL::TexParameteri (GL_TEXTURE_3D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
 	GL::TexParameteri (GL_TEXTURE_3D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_BORDER);
 	GL::TexParameteri (GL_TEXTURE_3D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_BORDER);
 	GL::TexParameteri (GL_TEXTURE_3D, GL_TEXTURE_WRAP_R, GL_CLAMP_TO_BORDER);
 
+	GLint sparseLevels = 0;
+	GL::GetTexParameteriv (GL_TEXTURE_3D, GL_NUM_SPARSE_LEVELS_ARB, &sparseLevels);
+
+	sparseLevels = std::min (sparseLevels, (GLint) _mipmapLevels);
+
+	/*
+	 * The pool holds as many bricks as fit in its memory
+	*/
+
+	std::size_t brickMemory = (std::size_t) brickSize.x * brickSize.y * brickSize.z * 4;
+
+	_brickAllocator.Init (_volumeSize, sparseLevels, brickSize, VOXEL_BRICK_POOL_MEMORY / brickMemory);
+
+	/*
+	 * Levels past the sparse ones form the mip tail, which is committed
+	 * as a whole
+	*/
+
+	for (std::size_t level = sparseLevels; level < _mipmapLevels; level++) {
+		std::size_t levelSize = GetLevelSize (level);
+
+		GL::TexPageCommitment (GL_TEXTURE_3D, level, 0, 0, 0, levelSize, levelSize, levelSize, GL_TRUE);
+		GL::ClearTexSubImage (_volumeTexture, level, 0, 0, 0, levelSize, levelSize, levelSize,
+			GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+	}
+
+	GL::BindTexture (GL_TEXTURE_3D, 0);
+
+	return true;
+}
+
+void VoxelVolume::InitDenseVolume ()
+{
+	/*
+	 * Samples of a cascade wrap around the texture like its voxels
+	*/
+
+	GLint wrapMode = IsToroidal () ? GL_REPEAT : GL_CLAMP_TO_BORDER;
+
+	/*
+	* Create the 3D texture to keep the voxel volume
+	*/
+
+	GL::GenTextures (1, &_volumeTexture);
+	GL::BindTexture (GL_TEXTURE_3D, _volumeTexture);
+	GL::TexImage3D (GL_TEXTURE_3D, 0, GL_RGBA8, _volumeSize, _volumeSize, _volumeSize,
+		0, GL_RGBA, GL_UNSIGNED_BYTE, 0);
+	GL::TexParameteri (GL_TEXTURE_3D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
+	GL::TexParameteri (GL_TEXTURE_3D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+	GL::TexParameteri (GL_TEXTURE_3D, GL_TEXTURE_WRAP_S, wrapMode);
+	GL::TexParameteri (GL_TEXTURE_3D, GL_TEXTURE_WRAP_T, wrapMode);
+	GL::TexParameteri (GL_TEXTURE_3D, GL_TEXTURE_WRAP_R, wrapMode);
+
 	/*
 	* Initialize mipmaps
 	*/
 
 	GL::GenerateMipmap (GL_TEXTURE_3D);
 
+	/*
+	 * Only the configured levels are computed by the mipmap pass
+	*/
+
+	GL::TexParameteri (GL_TEXTURE_3D, GL_TEXTURE_MAX_LEVEL, _mipmapLevels - 1);
+
 	/*
 	* Create an fbo for clearing the 3D texture.
 	*/
@@ -69,7 +205,7 @@ void VoxelVolume::BindForWriting ()
 
 void VoxelVolume::BindForReading ()
 {
-	GL::ActiveTexture (GL_TEXTURE10);
+	GL::ActiveTexture (GL_TEXTURE10 + _cascade);
 	GL::BindTexture (GL_TEXTURE_3D, _volumeTexture);
 }
 
@@ -82,40 +218,117 @@ std::vector<PipelineAttribute> VoxelVolume::GetCustomAttributes ()
 	PipelineAttribute maxVertex;
 	PipelineAttribute volumeSize;
 	PipelineAttribute volumeMipmapLevel;
+	PipelineAttribute volumeMipmapLevels;
+	PipelineAttribute volumeOrigin;
 
 	volumeTexture.type = PipelineAttribute::AttrType::ATTR_1I;
 	minVertex.type = PipelineAttribute::AttrType::ATTR_3F;
 	maxVertex.type = PipelineAttribute::AttrType::ATTR_3F;
 	volumeSize.type = PipelineAttribute::AttrType::ATTR_3I;
 	volumeMipmapLevel.type = PipelineAttribute::AttrType::ATTR_1I;
+	volumeMipmapLevels.type = PipelineAttribute::AttrType::ATTR_1I;
+	volumeOrigin.type = PipelineAttribute::AttrType::ATTR_3I;
 
 	volumeTexture.name = "volumeTexture";
 	minVertex.name = "minVertex";
 	maxVertex.name = "maxVertex";
 	volumeSize.name = "volumeSize";
 	volumeMipmapLevel.name = "volumeMipmapLevel";
+	volumeMipmapLevels.name = "volumeMipmapLevels";
+	volumeOrigin.name = "volumeOrigin";
 
-	volumeTexture.value.x = 10;
+	volumeTexture.value.x = 10 + _cascade;
 	minVertex.value = _minVertex;
 	maxVertex.value = _maxVertex;
 	volumeSize.value = glm::vec3 ((float) _volumeSize);
 	volumeMipmapLevel.value.x = GeneralSettings::Instance ()->GetIntValue ("VoxelVolumeMipmapLevel");
+	volumeMipmapLevels.value.x = _mipmapLevels;
+	volumeOrigin.value = glm::vec3 (_textureOffset);
 
 	attributes.push_back (volumeTexture);
 	attributes.push_back (minVertex);
 	attributes.push_back (maxVertex);
 	attributes.push_back (volumeSize);
 	attributes.push_back (volumeMipmapLevel);
+	attributes.push_back (volumeMipmapLevels);
+	attributes.push_back (volumeOrigin);
+
+	/*
+	 * The cone tracer reads every cascade, by index
+	*/
+
+	PipelineAttribute cascadeMinVertex;
+	PipelineAttribute cascadeMaxVertex;
+	PipelineAttribute cascadeOrigin;
+
+	cascadeMinVertex.type = PipelineAttribute::AttrType::ATTR_3F;
+	cascadeMaxVertex.type = PipelineAttribute::AttrType::ATTR_3F;
+	cascadeOrigin.type = PipelineAttribute::AttrType::ATTR_3I;
+
+	cascadeMinVertex.name = "cascadeMinVertices[" + std::to_string (_cascade) + "]";
+	cascadeMaxVertex.name = "cascadeMaxVertices[" + std::to_string (_cascade) + "]";
+	cascadeOrigin.name = "cascadeOrigins[" + std::to_string (_cascade) + "]";
+
+	cascadeMinVertex.value = _minVertex;
+	cascadeMaxVertex.value = _maxVertex;
+	cascadeOrigin.value = glm::vec3 (_textureOffset);
+
+	attributes.push_back (cascadeMinVertex);
+	attributes.push_back (cascadeMaxVertex);
+	attributes.push_back (cascadeOrigin);
+
+	/*
+	 * Every cascade has its own texture unit, even the unused ones, so
+	 * their samplers never share a unit with a 2D texture
+	*/
+
+	if (_cascade == 0) {
+		PipelineAttribute volumeCascades;
+
+		volumeCascades.type = PipelineAttribute::AttrType::ATTR_1I;
+		volumeCascades.name = "volumeCascades";
+		volumeCascades.value.x = _configuration.GetCascadesCount ();
+
+		attributes.push_back (volumeCascades);
+
+		for (std::size_t cascade = 0; cascade < VOXEL_CLIPMAP_MAX_CASCADES; cascade++) {
+			PipelineAttribute cascadeTexture;
+
+			cascadeTexture.type = PipelineAttribute::AttrType::ATTR_1I;
+			cascadeTexture.name = "cascadeTextures[" + std::to_string (cascade) + "]";
+			cascadeTexture.value.x = 10 + cascade;
+
+			attributes.push_back (cascadeTexture);
+		}
+	}
 
 	return attributes;
 }
 
+/*
+ * Only the dirty regions are cleared. Without ARB_clear_texture a dense
+ * volume is cleared as a whole, and so it is voxelized as a whole.
+*/
+
 void VoxelVolume::ClearVoxels()
 {
-	GL::BindFramebuffer(GL_FRAMEBUFFER, _volumeFbo);
-	GL::ClearColor(0, 0, 0, 0);
-	GL::Clear(GL_COLOR_BUFFER_BIT);
-	GL::BindFramebuffer(GL_FRAMEBUFFER, 0);
+	if (!_isSparse && !GLEW_ARB_clear_texture) {
+		_dirtyRegions.AddAll ();
+	}
+
+	if (!_isSparse && _dirtyRegions.IsFull ()) {
+		GL::BindFramebuffer(GL_FRAMEBUFFER, _volumeFbo);
+		GL::ClearColor(0, 0, 0, 0);
+		GL::Clear(GL_COLOR_BUFFER_BIT);
+		GL::BindFramebuffer(GL_FRAMEBUFFER, 0);
+
+		return;
+	}
+
+	for (const VoxelBrickRegion& region : GetUpdateRegions (0)) {
+		GL::ClearTexSubImage (_volumeTexture, 0, region.offset.x, region.offset.y, region.offset.z,
+			region.size.x, region.size.y, region.size.z, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+	}
 }
 
 void VoxelVolume::UpdateBoundingBox(const glm::vec3& minVertex, const glm::vec3& maxVertex)
@@ -147,6 +360,200 @@ void VoxelVolume::UpdateBoundingBox(const glm::vec3& minVertex, const glm::vec3&
 	_maxVertex += glm::vec3(difX / 2.0f, difY / 2.0f, difZ / 2.0f);
 }
 
+/*
+ * Commits and releases the memory of the bricks changed by the last
+ * update of the brick allocator. Fresh bricks start empty.
+*/
+
+void VoxelVolume::UpdateBricks ()
+{
+	if (!_isSparse || _brickAllocator.GetChanges ().empty ()) {
+		return;
+	}
+
+	glm::ivec3 brickSize = _brickAllocator.GetBrickSize ();
+
+	GL::BindTexture (GL_TEXTURE_3D, _volumeTexture);
+
+	for (const VoxelBrickChange& change : _brickAllocator.GetChanges ()) {
+		glm::ivec3 offset = change.position * brickSize;
+		glm::ivec3 size = glm::min (brickSize, glm::ivec3 ((int) GetLevelSize (change.level)) - offset);
+
+		GL::TexPageCommitment (GL_TEXTURE_3D, change.level, offset.x, offset.y, offset.z,
+			size.x, size.y, size.z, change.isAllocated ? GL_TRUE : GL_FALSE);
+
+		if (change.isAllocated) {
+			GL::ClearTexSubImage (_volumeTexture, change.level, offset.x, offset.y, offset.z,
+				size.x, size.y, size.z, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+		}
+
+		/*
+		 * Fresh bricks of the first level are filled by the next update
+		*/
+
+		if (change.isAllocated && change.level == 0) {
+			_dirtyRegions.AddRegion (offset, offset + size);
+		}
+	}
+
+	GL::BindTexture (GL_TEXTURE_3D, 0);
+
+	if (_brickAllocator.GetDroppedBricksCount () > 0) {
+		Console::LogWarning ("The voxel brick pool is full, " +
+			std::to_string (_brickAllocator.GetDroppedBricksCount ()) + " bricks were not allocated");
+	}
+}
+
+/*
+ * Moves the texel of the first voxel of the window of a cascade
+*/
+
+void VoxelVolume::UpdateTextureOffset (const glm::ivec3& textureOffset)
+{
+	_textureOffset = textureOffset;
+}
+
+bool VoxelVolume::IsAllocated () const
+{
+	return _volumeTexture != 0;
+}
+
+bool VoxelVolume::IsSparse () const
+{
+	return _isSparse;
+}
+
+bool VoxelVolume::IsToroidal () const
+{
+	return _configuration.clipmapCascades > 0;
+}
+
+VoxelBrickAllocator* VoxelVolume::GetBrickAllocator ()
+{
+	return &_brickAllocator;
+}
+
+/*
+ * Parts of a level that hold voxels. The whole level for a dense volume
+ * and for the mip tail of a sparse one.
+*/
+
+std::vector<VoxelBrickRegion> VoxelVolume::GetRegions (std::size_t level) const
+{
+	if (_isSparse && level < _brickAllocator.GetLevelsCount ()) {
+		return _brickAllocator.GetRegions (level);
+	}
+
+	VoxelBrickRegion region;
+	region.level = level;
+	region.offset = glm::ivec3 (0);
+	region.size = glm::ivec3 ((int) GetLevelSize (level));
+
+	return std::vector<VoxelBrickRegion> (1, region);
+}
+
+VoxelDirtyRegions* VoxelVolume::GetDirtyRegions ()
+{
+	return &_dirtyRegions;
+}
+
+/*
+ * Parts of a level that hold voxels and changed since the last frame
+*/
+
+std::vector<VoxelBrickRegion> VoxelVolume::GetUpdateRegions (std::size_t level, int padding) const
+{
+	if (_dirtyRegions.IsEmpty ()) {
+		return std::vector<VoxelBrickRegion> ();
+	}
+
+	if (_dirtyRegions.IsFull ()) {
+		return GetRegions (level);
+	}
+
+	return VoxelDirtyRegions::Intersect (GetRegions (level), _dirtyRegions.GetRegions (level, padding));
+}
+
+const VoxelVolumeConfiguration& VoxelVolume::GetConfiguration () const
+{
+	return _configuration;
+}
+
+std::size_t VoxelVolume::GetVolumeSize () const
+{
+	return _volumeSize;
+}
+
+std::size_t VoxelVolume::GetMipmapLevels () const
+{
+	return _mipmapLevels;
+}
+
+/*
+ * Resident memory of the volume, in bytes
+*/
+
+std::size_t VoxelVolume::GetMemorySize () const
+{
+	std::size_t memorySize = 0;
+
+	if (!_isSparse) {
+		for (std::size_t levelSize = _volumeSize; levelSize > 0; levelSize >>= 1) {
+			memorySize += levelSize * levelSize * levelSize * 4;
+		}
+
+		return memorySize;
+	}
+
+	glm::ivec3 brickSize = _brickAllocator.GetBrickSize ();
+
+	memorySize += _brickAllocator.GetAllocatedBricksCount () * brickSize.x * brickSize.y * brickSize.z * 4;
+
+	for (std::size_t level = _brickAllocator.GetLevelsCount (); level < _mipmapLevels; level++) {
+		memorySize += GetLevelSize (level) * GetLevelSize (level) * GetLevelSize (level) * 4;
+	}
+
+	return memorySize;
+}
+
+glm::vec3 VoxelVolume::GetMinVertex () const
+{
+	return _minVertex;
+}
+
+glm::vec3 VoxelVolume::GetMaxVertex () const
+{
+	return _maxVertex;
+}
+
+glm::ivec3 VoxelVolume::GetTextureOffset () const
+{
+	return _textureOffset;
+}
+
+std::size_t VoxelVolume::GetCascade () const
+{
+	return _cascade;
+}
+
+/*
+ * Name of the volume of a cascade in the render volume collection
+*/
+
+std::string VoxelVolume::GetCascadeName (std::size_t cascade)
+{
+	if (cascade == 0) {
+		return "VoxelVolume";
+	}
+
+	return "VoxelVolume" + std::to_string (cascade);
+}
+
+std::size_t VoxelVolume::GetLevelSize (std::size_t level) const
+{
+	return _configuration.GetLevelSize (level);
+}
+
 void VoxelVolume::BindForWriting (std::size_t mipmap)
 {
 	GL::BindImageTexture (0, _volumeTexture, mipmap, GL_FALSE, 0, GL_WRITE_ONLY, GL_RGBA8);
@@ -156,4 +563,7 @@ void VoxelVolume::Clear()
 {
 	GL::DeleteTextures(1, &_volumeTexture);
 	GL::DeleteFramebuffers(1, &_volumeFbo);
+
+	_volumeTexture = 0;
+	_volumeFbo = 0;
 }
\ No newline at end of file
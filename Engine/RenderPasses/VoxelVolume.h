@@ -4,28 +4,58 @@
 #include "Renderer/RenderVolumeI.h"
 
 #include <vector>
+#include <string>
 
 #include "Renderer/PipelineAttribute.h"
 
+#include "VoxelBrickAllocator.h"
+#include "VoxelDirtyRegions.h"
+#include "VoxelVolumeConfiguration.h"
+
 #include "Core/Math/glm/glm.hpp"
 
-#define MIP_MAP_LEVELS 6
+/*
+ * Memory of the brick pool of a sparse volume, the size of the first level
+ * of a dense 512^3 RGBA8 volume. Surfaces of a typical interior scene fit
+ * in it up to 512^3, higher resolutions drop the finest bricks first.
+*/
+
+#define VOXEL_BRICK_POOL_MEMORY (512 * 512 * 512 * 4 / 2)
+
+/*
+ * The volume is bricked when the driver supports sparse textures. Only
+ * the bricks of the page table that hold geometry get physical memory,
+ * the levels smaller than a brick (the mip tail) stay fully resident.
+ * Without sparse textures the volume is a dense 3D texture.
+ *
+ * A cascade of the clipmap is always dense and addressed toroidally, the
+ * texture offset is the texel of the first voxel of its window.
+*/
 
 class VoxelVolume : public RenderVolumeI
 {
 protected:
 	unsigned int _volumeTexture;
 	unsigned int _volumeFbo;
+	std::size_t _cascade;
+	VoxelVolumeConfiguration _configuration;
 	std::size_t _volumeSize;
+	std::size_t _mipmapLevels;
+
+	bool _isSparse;
+	VoxelBrickAllocator _brickAllocator;
+	VoxelDirtyRegions _dirtyRegions;
 
 	glm::vec3 _minVertex;
 	glm::vec3 _maxVertex;
+	glm::ivec3 _textureOffset;
 
 public:
-	VoxelVolume ();
+	VoxelVolume (std::size_t cascade = 0);
 	virtual ~VoxelVolume ();
 
-	virtual void Init (std::size_t size);
+	virtual void Init (const VoxelVolumeConfiguration& configuration);
+	virtual void Release ();
 
 	virtual void BindForReading ();
 	virtual void BindForWriting ();
@@ -34,8 +64,35 @@ public:
 
 	virtual void ClearVoxels();
 	virtual void UpdateBoundingBox (const glm::vec3& minVertex, const glm::vec3& maxVertex);
+	virtual void UpdateBricks ();
+	virtual void UpdateTextureOffset (const glm::ivec3& textureOffset);
+
+	bool IsAllocated () const;
+	bool IsSparse () const;
+	bool IsToroidal () const;
+	VoxelBrickAllocator* GetBrickAllocator ();
+	std::vector<VoxelBrickRegion> GetRegions (std::size_t level) const;
+
+	VoxelDirtyRegions* GetDirtyRegions ();
+	std::vector<VoxelBrickRegion> GetUpdateRegions (std::size_t level, int padding = 0) const;
+
+	const VoxelVolumeConfiguration& GetConfiguration () const;
+	std::size_t GetVolumeSize () const;
+	std::size_t GetMipmapLevels () const;
+	std::size_t GetMemorySize () const;
+	glm::vec3 GetMinVertex () const;
+	glm::vec3 GetMaxVertex () const;
+	glm::ivec3 GetTextureOffset () const;
+	std::size_t GetCascade () const;
+
+	static std::string GetCascadeName (std::size_t cascade);
 protected:
 	virtual void Clear ();
+
+	bool InitSparseVolume ();
+	void InitDenseVolume ();
+
+	std::size_t GetLevelSize (std::size_t level) const;
 };
 
-#endif
\ No newline at end of file
+#endif
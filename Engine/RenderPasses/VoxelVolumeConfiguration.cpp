@@ -0,0 +1,124 @@
+#include "VoxelVolumeConfiguration.h"
+
+#include <algorithm>
+
+#include "Settings/GeneralSettings.h"
+
+VoxelVolumeConfiguration::VoxelVolumeConfiguration () :
+	VoxelVolumeConfiguration (VOXEL_VOLUME_DEFAULT_SIZE, VOXEL_VOLUME_DEFAULT_MIPMAP_LEVELS)
+{
+
+}
+
+/*
+ * Values out of range are clamped, the size is rounded down to a power
+ * of two
+*/
+
+VoxelVolumeConfiguration::VoxelVolumeConfiguration (std::size_t size, std::size_t levels,
+	std::size_t cascades, std::size_t extent) :
+	volumeSize (VOXEL_VOLUME_MIN_SIZE),
+	mipmapLevels (1),
+	clipmapCascades (std::min (cascades, (std::size_t) VOXEL_CLIPMAP_MAX_CASCADES)),
+	clipmapExtent (std::max (extent, (std::size_t) 1))
+{
+	size = std::min (std::max (size, (std::size_t) VOXEL_VOLUME_MIN_SIZE), (std::size_t) VOXEL_VOLUME_MAX_SIZE);
+
+	while (volumeSize * 2 <= size) {
+		volumeSize *= 2;
+	}
+
+	std::size_t maxLevels = 1;
+
+	while ((volumeSize >> maxLevels) > 0) {
+		maxLevels ++;
+	}
+
+	mipmapLevels = std::min (std::max (levels, (std::size_t) 1), maxLevels);
+}
+
+std::size_t VoxelVolumeConfiguration::GetLevelSize (std::size_t level) const
+{
+	return std::max ((std::size_t) 1, volumeSize >> level);
+}
+
+/*
+ * Volumes that are voxelized, the scene fitted volume counts as one
+*/
+
+std::size_t VoxelVolumeConfiguration::GetCascadesCount () const
+{
+	return std::max (clipmapCascades, (std::size_t) 1);
+}
+
+/*
+ * Side of a voxel of the first level of a cascade, in world units
+*/
+
+float VoxelVolumeConfiguration::GetCascadeVoxelSize (std::size_t cascade) const
+{
+	return (float) (clipmapExtent << cascade) / volumeSize;
+}
+
+/*
+ * Memory of all the volumes when they are dense, in bytes
+*/
+
+std::size_t VoxelVolumeConfiguration::GetMemorySize () const
+{
+	std::size_t memorySize = 0;
+
+	for (std::size_t level = 0; level < mipmapLevels; level++) {
+		std::size_t levelSize = GetLevelSize (level);
+
+		memorySize += levelSize * levelSize * levelSize * 4;
+	}
+
+	return memorySize * GetCascadesCount ();
+}
+
+bool VoxelVolumeConfiguration::operator== (const VoxelVolumeConfiguration& other) const
+{
+	return volumeSize == other.volumeSize && mipmapLevels == other.mipmapLevels &&
+		clipmapCascades == other.clipmapCascades && clipmapExtent == other.clipmapExtent;
+}
+
+bool VoxelVolumeConfiguration::operator!= (const VoxelVolumeConfiguration& other) const
+{
+	return !(*this == other);
+}
+
+/*
+ * Unset values fall back to the defaults
+*/
+
+VoxelVolumeConfiguration VoxelVolumeConfiguration::FromSettings ()
+{
+	int size = GeneralSettings::Instance ()->GetIntValue (VOXEL_VOLUME_SIZE_SETTING);
+	int levels = GeneralSettings::Instance ()->GetIntValue (VOXEL_VOLUME_MIPMAP_LEVELS_SETTING);
+	int cascades = GeneralSettings::Instance ()->GetIntValue (VOXEL_CLIPMAP_CASCADES_SETTING);
+	int extent = GeneralSettings::Instance ()->GetIntValue (VOXEL_CLIPMAP_EXTENT_SETTING);
+
+	if (size <= 0) {
+		size = VOXEL_VOLUME_DEFAULT_SIZE;
+	}
+
+	if (levels <= 0) {
+		levels = VOXEL_VOLUME_DEFAULT_MIPMAP_LEVELS;
+	}
+
+	if (cascades < 0) {
+		cascades = 0;
+	}
+
+	if (extent <= 0) {
+		extent = VOXEL_CLIPMAP_DEFAULT_EXTENT;
+	}
+
+	return VoxelVolumeConfiguration (size, levels, cascades, extent);
+}
+
+glm::ivec3 VoxelVolumeConfiguration::GetWorkGroupsCount (const glm::ivec3& size)
+{
+	return (size + VOXEL_VOLUME_WORK_GROUP_SIZE - 1) / VOXEL_VOLUME_WORK_GROUP_SIZE;
+}
@@ -0,0 +1,63 @@
+#ifndef VOXELVOLUMECONFIGURATION_H
+#define VOXELVOLUMECONFIGURATION_H
+
+#include <cstddef>
+
+#include "Core/Math/glm/glm.hpp"
+
+#define VOXEL_VOLUME_SIZE_SETTING "VoxelVolumeSize"
+#define VOXEL_VOLUME_MIPMAP_LEVELS_SETTING "VoxelVolumeMipmapLevels"
+#define VOXEL_CLIPMAP_CASCADES_SETTING "VoxelClipmapCascades"
+#define VOXEL_CLIPMAP_EXTENT_SETTING "VoxelClipmapExtent"
+
+#define VOXEL_VOLUME_DEFAULT_SIZE 256
+#define VOXEL_VOLUME_DEFAULT_MIPMAP_LEVELS 6
+
+#define VOXEL_VOLUME_MIN_SIZE 64
+#define VOXEL_VOLUME_MAX_SIZE 1024
+
+/*
+ * Clipmap cascades around the camera, the first one spans the default
+ * extent in world units and every other one doubles it
+*/
+
+#define VOXEL_CLIPMAP_MAX_CASCADES 4
+#define VOXEL_CLIPMAP_DEFAULT_EXTENT 16
+
+/*
+ * Matches the local size of the voxel compute shaders
+*/
+
+#define VOXEL_VOLUME_WORK_GROUP_SIZE 4
+
+/*
+ * Resolution and mipmap chain of the voxel volume. The resolution is a
+ * power of two between the minimum and maximum sizes, the chain never
+ * goes below one voxel. Every voxel pass reads its sizes from here.
+ * Without clipmap cascades a single volume is fitted to the scene.
+*/
+
+struct VoxelVolumeConfiguration
+{
+	std::size_t volumeSize;
+	std::size_t mipmapLevels;
+	std::size_t clipmapCascades;
+	std::size_t clipmapExtent;
+
+	VoxelVolumeConfiguration ();
+	VoxelVolumeConfiguration (std::size_t volumeSize, std::size_t mipmapLevels,
+		std::size_t clipmapCascades = 0, std::size_t clipmapExtent = VOXEL_CLIPMAP_DEFAULT_EXTENT);
+
+	std::size_t GetLevelSize (std::size_t level) const;
+	std::size_t GetCascadesCount () const;
+	float GetCascadeVoxelSize (std::size_t cascade) const;
+	std::size_t GetMemorySize () const;
+
+	bool operator== (const VoxelVolumeConfiguration& other) const;
+	bool operator!= (const VoxelVolumeConfiguration& other) const;
+
+	static VoxelVolumeConfiguration FromSettings ();
+	static glm::ivec3 GetWorkGroupsCount (const glm::ivec3& size);
+};
+
+#endif
@@ -1,8 +1,13 @@
 #include "VoxelizationRenderPass.h"
 
+#include <limits>
+#include <algorithm>
+#include <string>
+
 #include "Managers/ShaderManager.h"
 
 #include "Renderer/Pipeline.h"
+#include "Renderer/StaticGeometryArena.h"
 
 #include "Systems/Window/Window.h"
 
@@ -10,18 +15,31 @@
 
 #include "Settings/GeneralSettings.h"
 
+#include "Managers/MaterialManager.h"
+
 #include "Core/Console/Console.h"
 
 #include "Debug/Profiler/Profiler.h"
 
-/*
- * TODO: Move this to settings
-*/
-
-#define VOLUME_DIMENSTIONS 256
-
-VoxelizationRenderPass::VoxelizationRenderPass () :
-	_voxelVolume (new VoxelVolume ())
+#include "SceneNodes/GameObject.h"
+#include "SceneNodes/AnimationGameObject.h"
+#include "SceneNodes/SceneLayer.h"
+
+#include "Lighting/LightsManager.h"
+
+#include "Core/Math/glm/gtc/type_ptr.hpp"
+
+VoxelizationRenderPass::VoxelizationRenderPass (std::size_t cascade) :
+	_cascade (cascade),
+	_voxelVolume (new VoxelVolume (cascade)),
+	_clipmapCascade (),
+	_windowOrigin (0),
+	_bricksFingerprint (),
+	_brickObjects (),
+	_volumeFingerprint (),
+	_voxelizedObjects (),
+	_indirectDrawBuilder (),
+	_indirectDrawBuffer ()
 {
 
 }
@@ -34,10 +52,16 @@ VoxelizationRenderPass::~VoxelizationRenderPass ()
 void VoxelizationRenderPass::Init ()
 {
 	/*
-	 * Initialize voxel volume
+	 * Initialize voxel volume, the other cascades are allocated when
+	 * they are used
 	*/
 
-	_voxelVolume->Init (VOLUME_DIMENSTIONS);
+	if (IsCascadeActive ()) {
+		VoxelVolumeConfiguration configuration = VoxelVolumeConfiguration::FromSettings ();
+
+		_voxelVolume->Init (configuration);
+		_clipmapCascade.Init (configuration, _cascade);
+	}
 
 	/*
 	* Voxelization shader init
@@ -51,12 +75,35 @@ void VoxelizationRenderPass::Init ()
 
 RenderVolumeCollection* VoxelizationRenderPass::Execute (Scene* scene, Camera* camera, RenderVolumeCollection* rvc)
 {
+	std::string volumeName = VoxelVolume::GetCascadeName (_cascade);
+
+	/*
+	 * Release the cascade when there are fewer of them
+	*/
+
+	if (!IsCascadeActive ()) {
+		if (_voxelVolume->IsAllocated ()) {
+			_voxelVolume->Release ();
+
+			_volumeFingerprint.clear ();
+			_voxelizedObjects.clear ();
+		}
+
+		return rvc->Remove (volumeName);
+	}
+
 	if (!GeneralSettings::Instance ()->GetIntValue ("ContinousVoxelizationPass")) {
-		return rvc->Insert ("VoxelVolume", _voxelVolume);
+		return rvc->Insert (volumeName, _voxelVolume);
 	}
 
 	PROFILER_LOGGER("VOXELIZATION PASS")
 
+	/*
+	 * Reallocate voxel volume if its settings changed
+	*/
+
+	UpdateVoxelVolumeConfiguration ();
+
 	/*
 	* Voxelization start
 	*/
@@ -67,7 +114,7 @@ RenderVolumeCollection* VoxelizationRenderPass::Execute (Scene* scene, Camera* c
 	* Voxelization: voxelize geomtry
 	*/
 
-	GeometryVoxelizationPass (scene);
+	GeometryVoxelizationPass (scene, camera);
 
 	/*
 	* Clear opengl state after voxelization
@@ -79,17 +126,11 @@ RenderVolumeCollection* VoxelizationRenderPass::Execute (Scene* scene, Camera* c
 	 * Send back the collection with voxel volume attached
 	*/
 
-	return rvc->Insert ("VoxelVolume", _voxelVolume);
+	return rvc->Insert (volumeName, _voxelVolume);
 }
 
 void VoxelizationRenderPass::StartVoxelization ()
 {
-	/*
-	 * Clear voxel volume
-	*/
-
-	_voxelVolume->ClearVoxels ();
-
 	/*
 	* Render to window but mask out all color.
 	*/
@@ -98,7 +139,7 @@ void VoxelizationRenderPass::StartVoxelization ()
 
 	GL::ColorMask (GL_FALSE, GL_FALSE, GL_FALSE, GL_FALSE);
 	GL::DepthMask (GL_FALSE);
-	GL::Viewport (0, 0, VOLUME_DIMENSTIONS, VOLUME_DIMENSTIONS);
+	GL::Viewport (0, 0, _voxelVolume->GetVolumeSize (), _voxelVolume->GetVolumeSize ());
 
 	/*
 	* Lock voxelization shader for geomtry rendering
@@ -107,13 +148,32 @@ void VoxelizationRenderPass::StartVoxelization ()
 	Pipeline::LockShader (ShaderManager::Instance ()->GetShader ("VOXELIZATION_PASS_SHADER"));
 }
 
-void VoxelizationRenderPass::GeometryVoxelizationPass (Scene* scene)
+void VoxelizationRenderPass::GeometryVoxelizationPass (Scene* scene, Camera* camera)
 {
 	/*
-	* Update voxel volume based on scene bounding box
+	* Update voxel volume based on scene bounding box, or on the camera
+	* for a cascade
+	*/
+
+	UpdateVoxelVolumeBoundingBox (scene, camera);
+
+	/*
+	 * Find the parts of the volume that changed
+	*/
+
+	UpdateVoxelVolumeDirtyRegions (scene);
+
+	/*
+	 * Allocate the bricks touched by geometry
 	*/
 
-	UpdateVoxelVolumeBoundingBox (scene);
+	UpdateVoxelVolumeBricks (scene);
+
+	/*
+	 * Clear changed parts of voxel volume
+	*/
+
+	_voxelVolume->ClearVoxels ();
 
 	/*
 	* Bind voxel volume to geometry render pass
@@ -132,13 +192,129 @@ void VoxelizationRenderPass::GeometryVoxelizationPass (Scene* scene)
 	* Render geometry
 	*/
 
+	VoxelDirtyRegions* dirtyRegions = _voxelVolume->GetDirtyRegions ();
+
+	for (const VoxelBrickRegion& region : dirtyRegions->GetRegions (0)) {
+		DrawRegion (scene, region);
+	}
+}
+
+/*
+ * Voxels outside the region are discarded, so the objects that only pass
+ * through it do not add to the voxels kept from previous frames
+*/
+
+void VoxelizationRenderPass::DrawRegion (Scene* scene, const VoxelBrickRegion& region)
+{
+	SendUpdateRegion (region);
+
+	bool isFull = _voxelVolume->GetDirtyRegions ()->IsFull ();
+	bool isIndirectDraw = GeneralSettings::Instance ()->GetIntValue (INDIRECT_DRAW_SETTING) == 1;
+
+	_indirectDrawBuilder.Clear ();
+
 	for (SceneObject* sceneObject : *scene) {
 		if (sceneObject->GetRenderer ()->GetStageType () != Renderer::StageType::DEFERRED_STAGE) {
 			continue;
 		}
 
+		if (!isFull && !IsInRegion (_voxelizedObjects [sceneObject], region)) {
+			continue;
+		}
+
+		if (isIndirectDraw && sceneObject->GetRenderer ()->IsStaticGeometry ()) {
+			sceneObject->GetRenderer ()->CollectIndirect (&_indirectDrawBuilder, true);
+
+			continue;
+		}
+
 		sceneObject->GetRenderer ()->Draw ();
 	}
+
+	if (!_indirectDrawBuilder.IsEmpty ()) {
+		DrawIndirect ();
+	}
+}
+
+/*
+ * The voxels take their color from the textures of the material, there
+ * is a multi draw for every material of every static geometry arena
+*/
+
+void VoxelizationRenderPass::DrawIndirect ()
+{
+	PROFILER_LOGGER("VOXELIZATION INDIRECT DRAW")
+
+	_indirectDrawBuilder.Build ();
+	_indirectDrawBuffer.Upload (_indirectDrawBuilder);
+
+	Pipeline::SetIndirectDraw (true);
+
+	for (const IndirectDrawBatch& batch : _indirectDrawBuilder.GetBatches ()) {
+		Material* material = MaterialManager::Instance ().GetMaterial (batch.tag);
+
+		Pipeline::SendMaterial (material);
+
+		_indirectDrawBuffer.Draw (batch);
+	}
+
+	Pipeline::SetIndirectDraw (false);
+}
+
+void VoxelizationRenderPass::SendUpdateRegion (const VoxelBrickRegion& region)
+{
+	std::vector<PipelineAttribute> attributes;
+
+	PipelineAttribute updateMin;
+	PipelineAttribute updateMax;
+
+	updateMin.type = PipelineAttribute::AttrType::ATTR_3I;
+	updateMax.type = PipelineAttribute::AttrType::ATTR_3I;
+
+	updateMin.name = "UpdateMin";
+	updateMax.name = "UpdateMax";
+
+	updateMin.value = glm::vec3 (region.offset);
+	updateMax.value = glm::vec3 (region.offset + region.size);
+
+	attributes.push_back (updateMin);
+	attributes.push_back (updateMax);
+
+	Pipeline::SendCustomAttributes ("VOXELIZATION_PASS_SHADER", attributes);
+}
+
+/*
+ * Regions of a cascade are texture regions, the box of the object is
+ * wrapped around the texture the same way
+*/
+
+bool VoxelizationRenderPass::IsInRegion (const VoxelizedObject& voxelizedObject, const VoxelBrickRegion& region)
+{
+	glm::ivec3 windowMin = voxelizedObject.minVoxel - _windowOrigin;
+	glm::ivec3 windowMax = voxelizedObject.maxVoxel - _windowOrigin;
+
+	std::vector<VoxelBrickRegion> objectRegions;
+
+	if (_voxelVolume->IsToroidal ()) {
+		objectRegions = _clipmapCascade.GetTextureRegions (windowMin, windowMax);
+	} else {
+		VoxelBrickRegion objectRegion;
+		objectRegion.level = 0;
+		objectRegion.offset = windowMin;
+		objectRegion.size = windowMax - windowMin;
+
+		objectRegions.push_back (objectRegion);
+	}
+
+	VoxelBrickRegion overlap;
+
+	for (const VoxelBrickRegion& objectRegion : objectRegions) {
+		if (VoxelDirtyRegions::Intersect (objectRegion, region, overlap)) {
+			return true;
+		}
+	}
+
+	return false;
 }
 
 void VoxelizationRenderPass::EndVoxelization ()
@@ -162,8 +338,48 @@ void VoxelizationRenderPass::EndVoxelization ()
 	Pipeline::UnlockShader ();
 }
 
-void VoxelizationRenderPass::UpdateVoxelVolumeBoundingBox (Scene* scene)
+bool VoxelizationRenderPass::IsCascadeActive () const
+{
+	return _cascade < VoxelVolumeConfiguration::FromSettings ().GetCascadesCount ();
+}
+
+/*
+ * The new volume is empty, it is filled by the voxelization that follows
+*/
+
+void VoxelizationRenderPass::UpdateVoxelVolumeConfiguration ()
 {
+	VoxelVolumeConfiguration configuration = VoxelVolumeConfiguration::FromSettings ();
+
+	if (configuration == _voxelVolume->GetConfiguration () && _voxelVolume->IsAllocated ()) {
+		return;
+	}
+
+	_voxelVolume->Init (configuration);
+	_clipmapCascade.Init (configuration, _cascade);
+
+	_bricksFingerprint.clear ();
+}
+
+void VoxelizationRenderPass::UpdateVoxelVolumeBoundingBox (Scene* scene, Camera* camera)
+{
+	/*
+	 * A cascade follows the camera
+	*/
+
+	if (_voxelVolume->IsToroidal ()) {
+		_clipmapCascade.Update (camera->GetPosition ());
+
+		_voxelVolume->UpdateBoundingBox (_clipmapCascade.GetMinVertex (), _clipmapCascade.GetMaxVertex ());
+		_voxelVolume->UpdateTextureOffset (_clipmapCascade.GetTextureOffset ());
+
+		_windowOrigin = _clipmapCascade.GetOrigin ();
+
+		return;
+	}
+
+	_windowOrigin = glm::ivec3 (0);
+
 	AABBVolume* boundingBox = scene->GetBoundingBox ();
 	AABBVolume::AABBVolumeInformation* volume = boundingBox->GetVolumeInformation ();
 
@@ -172,3 +388,514 @@ void VoxelizationRenderPass::UpdateVoxelVolumeBoundingBox (Scene* scene)
 
 	_voxelVolume->UpdateBoundingBox (minVertex, maxVertex);
 }
+
+/*
+ * Only the bricks that may hold voxels are kept in memory. Every polygon
+ * marks the bricks under its bounding box, padded by one voxel for the
+ * conservative rasterization of the geometry shader. The bricks of an
+ * object are kept until it moves, so only the objects that moved go
+ * through their polygons again.
+*/
+
+void VoxelizationRenderPass::UpdateVoxelVolumeBricks (Scene* scene)
+{
+	if (!_voxelVolume->IsSparse ()) {
+		return;
+	}
+
+	/*
+	 * Bricks are counted from the corner of the volume, they all change
+	 * when the volume does
+	*/
+
+	bool isChanged = UpdateBricksFingerprint ();
+
+	if (isChanged) {
+		_brickObjects.clear ();
+	}
+
+	for (auto& brickObject : _brickObjects) {
+		brickObject.second.isVisited = false;
+	}
+
+	for (SceneObject* sceneObject : *scene) {
+		if (sceneObject->GetRenderer ()->GetStageType () != Renderer::StageType::DEFERRED_STAGE) {
+			continue;
+		}
+
+		std::vector<float> fingerprint = GetBricksFingerprint (sceneObject);
+
+		auto it = _brickObjects.find (sceneObject);
+
+		if (it != _brickObjects.end () && it->second.fingerprint == fingerprint) {
+			it->second.isVisited = true;
+
+			continue;
+		}
+
+		VoxelBrickObject& brickObject = _brickObjects [sceneObject];
+
+		brickObject.fingerprint.swap (fingerprint);
+		brickObject.isVisited = true;
+
+		GetObjectBricks (sceneObject, brickObject.bricks);
+
+		isChanged = true;
+	}
+
+	/*
+	 * Objects that left the scene give their bricks back
+	*/
+
+	for (auto it = _brickObjects.begin (); it != _brickObjects.end ();) {
+		if (it->second.isVisited) {
+			++ it;
+			continue;
+		}
+
+		it = _brickObjects.erase (it);
+
+		isChanged = true;
+	}
+
+	if (!isChanged) {
+		return;
+	}
+
+	VoxelBrickAllocator* brickAllocator = _voxelVolume->GetBrickAllocator ();
+
+	brickAllocator->BeginUpdate ();
+
+	for (const auto& brickObject : _brickObjects) {
+		for (const glm::ivec3& brick : brickObject.second.bricks) {
+			brickAllocator->MarkBrick (brick);
+		}
+	}
+
+	brickAllocator->EndUpdate ();
+
+	_voxelVolume->UpdateBricks ();
+}
+
+void VoxelizationRenderPass::GetObjectBricks (SceneObject* sceneObject, std::vector<glm::ivec3>& bricks)
+{
+	bricks.clear ();
+
+	GameObject* gameObject = dynamic_cast<GameObject*> (sceneObject);
+	bool isAnimated = dynamic_cast<AnimationGameObject*> (sceneObject) != nullptr;
+
+	/*
+	 * Skinned geometry leaves its rest pose, so the collider bounds are
+	 * used instead of the polygons
+	*/
+
+	AABBVolume* boundingBox = sceneObject->GetCollider () == nullptr ? nullptr :
+		dynamic_cast<AABBVolume*> (sceneObject->GetCollider ()->GetGeometricPrimitive ());
+
+	if (isAnimated && boundingBox != nullptr) {
+		AABBVolume::AABBVolumeInformation* volume = boundingBox->GetVolumeInformation ();
+
+		GetBoxBricks (volume->minVertex, volume->maxVertex, bricks);
+	}
+	else if (gameObject == nullptr || gameObject->GetMesh () == nullptr || isAnimated) {
+		GetBoxBricks (_voxelVolume->GetMinVertex (), _voxelVolume->GetMaxVertex (), bricks);
+	}
+	else {
+		GetModelBricks (gameObject->GetMesh (), sceneObject->GetTransform ()->GetModelMatrix (), bricks);
+	}
+
+	/*
+	 * Neighbour polygons share most of their bricks
+	*/
+
+	std::sort (bricks.begin (), bricks.end (), [] (const glm::ivec3& first, const glm::ivec3& second) {
+		return first.z != second.z ? first.z < second.z :
+			first.y != second.y ? first.y < second.y : first.x < second.x;
+	});
+
+	bricks.erase (std::unique (bricks.begin (), bricks.end ()), bricks.end ());
+}
+
+void VoxelizationRenderPass::GetModelBricks (Model* model, const glm::mat4& modelMatrix, std::vector<glm::ivec3>& bricks)
+{
+	glm::vec3 minVertex = _voxelVolume->GetMinVertex ();
+	glm::vec3 volumeScale = glm::vec3 (_voxelVolume->GetVolumeSize ()) / (_voxelVolume->GetMaxVertex () - minVertex);
+	glm::vec3 volumeSize = glm::vec3 (_voxelVolume->GetVolumeSize ());
+
+	/*
+	 * Move all vertices in voxel space once, polygons only index them
+	*/
+
+	const std::vector<glm::vec3>& vertices = model->GetVertices ();
+	std::vector<glm::vec3> voxelVertices (vertices.size ());
+
+	for (std::size_t i=0;i<vertices.size ();i++) {
+		glm::vec3 worldVertex = glm::vec3 (modelMatrix * glm::vec4 (vertices [i], 1.0f));
+
+		voxelVertices [i] = (worldVertex - minVertex) * volumeScale;
+	}
+
+	for (std::size_t i=0;i<model->ObjectsCount ();i++) {
+		ObjectModel* objModel = model->GetObject (i);
+
+		for (std::size_t j=0;j<objModel->GetPolygonCount ();j++) {
+			PolygonGroup* polyGroup = objModel->GetPolygonGroup (j);
+
+			for (std::size_t k=0;k<polyGroup->GetPolygonCount ();k++) {
+				Polygon* polygon = polyGroup->GetPolygon (k);
+
+				const int* indices = polygon->GetIndices (Polygon::VERTEX_ATTRIBUTE);
+				std::size_t indicesCount = polygon->GetIndicesCount (Polygon::VERTEX_ATTRIBUTE);
+
+				if (indicesCount == 0) {
+					continue;
+				}
+
+				glm::vec3 minVoxel = voxelVertices [indices [0]];
+				glm::vec3 maxVoxel = voxelVertices [indices [0]];
+
+				for (std::size_t l=1;l<indicesCount;l++) {
+					minVoxel = glm::min (minVoxel, voxelVertices [indices [l]]);
+					maxVoxel = glm::max (maxVoxel, voxelVertices [indices [l]]);
+				}
+
+				minVoxel -= glm::vec3 (1.0f);
+				maxVoxel += glm::vec3 (1.0f);
+
+				if (glm::any (glm::lessThan (maxVoxel, glm::vec3 (0.0f))) ||
+					glm::any (glm::greaterThanEqual (minVoxel, volumeSize))) {
+					continue;
+				}
+
+				AddRegionBricks (minVoxel, maxVoxel, bricks);
+			}
+		}
+	}
+}
+
+void VoxelizationRenderPass::GetBoxBricks (const glm::vec3& minVertex, const glm::vec3& maxVertex, std::vector<glm::ivec3>& bricks)
+{
+	glm::vec3 volumeMinVertex = _voxelVolume->GetMinVertex ();
+	glm::vec3 volumeScale = glm::vec3 (_voxelVolume->GetVolumeSize ()) / (_voxelVolume->GetMaxVertex () - volumeMinVertex);
+
+	glm::vec3 minVoxel = (minVertex - volumeMinVertex) * volumeScale - glm::vec3 (1.0f);
+	glm::vec3 maxVoxel = (maxVertex - volumeMinVertex) * volumeScale + glm::vec3 (1.0f);
+
+	AddRegionBricks (minVoxel, maxVoxel, bricks);
+}
+
+/*
+ * Bricks of the first level under a region of voxels, clamped to the
+ * volume as the allocator does
+*/
+
+void VoxelizationRenderPass::AddRegionBricks (const glm::vec3& minVoxel, const glm::vec3& maxVoxel, std::vector<glm::ivec3>& bricks)
+{
+	VoxelBrickAllocator* brickAllocator = _voxelVolume->GetBrickAllocator ();
+
+	glm::vec3 brickSize = glm::vec3 (brickAllocator->GetBrickSize ());
+	glm::ivec3 bricksCount = brickAllocator->GetBricksCount (0);
+
+	glm::ivec3 minBrick = glm::clamp (glm::ivec3 (glm::floor (minVoxel / brickSize)), glm::ivec3 (0), bricksCount - 1);
+	glm::ivec3 maxBrick = glm::clamp (glm::ivec3 (glm::floor (maxVoxel / brickSize)), glm::ivec3 (0), bricksCount - 1);
+
+	for (int z=minBrick.z;z<=maxBrick.z;z++) {
+		for (int y=minBrick.y;y<=maxBrick.y;y++) {
+			for (int x=minBrick.x;x<=maxBrick.x;x++) {
+				bricks.push_back (glm::ivec3 (x, y, z));
+			}
+		}
+	}
+}
+
+/*
+ * Returns true when the bounds of the volume changed since the bricks
+ * were last allocated
+*/
+
+bool VoxelizationRenderPass::UpdateBricksFingerprint ()
+{
+	std::vector<float> fingerprint;
+
+	glm::vec3 minVertex = _voxelVolume->GetMinVertex ();
+	glm::vec3 maxVertex = _voxelVolume->GetMaxVertex ();
+
+	fingerprint.insert (fingerprint.end (), glm::value_ptr (minVertex), glm::value_ptr (minVertex) + 3);
+	fingerprint.insert (fingerprint.end (), glm::value_ptr (maxVertex), glm::value_ptr (maxVertex) + 3);
+
+	if (fingerprint == _bricksFingerprint) {
+		return false;
+	}
+
+	_bricksFingerprint.swap (fingerprint);
+
+	return true;
+}
+
+/*
+ * Transform and collider bounds the bricks of an object depend on
+*/
+
+std::vector<float> VoxelizationRenderPass::GetBricksFingerprint (SceneObject* sceneObject)
+{
+	std::vector<float> fingerprint;
+
+	glm::mat4 modelMatrix = sceneObject->GetTransform ()->GetModelMatrix ();
+
+	fingerprint.insert (fingerprint.end (), glm::value_ptr (modelMatrix), glm::value_ptr (modelMatrix) + 16);
+
+	if (sceneObject->GetCollider () != nullptr) {
+		GeometricPrimitive* primitive = sceneObject->GetCollider ()->GetGeometricPrimitive ();
+		AABBVolume* boundingBox = dynamic_cast<AABBVolume*> (primitive);
+
+		if (boundingBox != nullptr) {
+			AABBVolume::AABBVolumeInformation* volume = boundingBox->GetVolumeInformation ();
+
+			fingerprint.insert (fingerprint.end (), glm::value_ptr (volume->minVertex), glm::value_ptr (volume->minVertex) + 3);
+			fingerprint.insert (fingerprint.end (), glm::value_ptr (volume->maxVertex), glm::value_ptr (volume->maxVertex) + 3);
+		}
+	}
+
+	return fingerprint;
+}
+
+/*
+ * Static geometry stays in the volume between frames. Only the voxels
+ * under objects that moved, were added or removed, or are tagged dynamic
+ * are voxelized again. A moving object also changes the shadow it casts,
+ * so its box is extended along the light direction up to the volume
+ * bounds. Everything is voxelized again when the volume itself changes.
+ * A cascade also voxelizes the slabs that entered its window.
+*/
+
+void VoxelizationRenderPass::UpdateVoxelVolumeDirtyRegions (Scene* scene)
+{
+	PROFILER_LOGGER("VOXELIZATION DIRTY REGIONS")
+
+	VoxelDirtyRegions* dirtyRegions = _voxelVolume->GetDirtyRegions ();
+
+	bool isIncremental = GeneralSettings::Instance ()->GetIntValue ("IncrementalVoxelization") != 0;
+	bool isVolumeChanged = UpdateVolumeFingerprint ();
+
+	glm::vec3 lightDirection (0.0f);
+	bool hasLight = GetLightDirection (lightDirection);
+
+	dirtyRegions->Clear ();
+
+	if (!isIncremental || isVolumeChanged) {
+		dirtyRegions->AddAll ();
+	}
+
+	if (_voxelVolume->IsToroidal ()) {
+		for (const VoxelBrickRegion& region : _clipmapCascade.GetUpdateRegions ()) {
+			dirtyRegions->AddRegion (region.offset, region.offset + region.size);
+		}
+	}
+
+	for (SceneObject* sceneObject : *scene) {
+		if (sceneObject->GetRenderer ()->GetStageType () != Renderer::StageType::DEFERRED_STAGE) {
+			continue;
+		}
+
+		VoxelizedObject currentObject;
+		GetObjectVoxels (sceneObject, currentObject.minVoxel, currentObject.maxVoxel);
+		currentObject.isVisited = true;
+
+		auto objectIterator = _voxelizedObjects.find (sceneObject);
+
+		if (objectIterator == _voxelizedObjects.end ()) {
+			AddDirtyRegion (currentObject.minVoxel, currentObject.maxVoxel, hasLight, lightDirection);
+
+			_voxelizedObjects [sceneObject] = currentObject;
+
+			continue;
+		}
+
+		VoxelizedObject& lastObject = objectIterator->second;
+
+		bool isDynamic = (sceneObject->GetLayers () & (SceneLayer::DYNAMIC | SceneLayer::ANIMATION)) != 0;
+		bool isMoved = currentObject.minVoxel != lastObject.minVoxel || currentObject.maxVoxel != lastObject.maxVoxel;
+
+		if (isDynamic || isMoved) {
+			AddDirtyRegion (glm::min (currentObject.minVoxel, lastObject.minVoxel),
+				glm::max (currentObject.maxVoxel, lastObject.maxVoxel), hasLight, lightDirection);
+		}
+
+		lastObject = currentObject;
+	}
+
+	/*
+	 * Objects that left the scene or were deactivated
+	*/
+
+	for (auto objectIterator = _voxelizedObjects.begin (); objectIterator != _voxelizedObjects.end ();) {
+		VoxelizedObject& voxelizedObject = objectIterator->second;
+
+		if (!voxelizedObject.isVisited) {
+			AddDirtyRegion (voxelizedObject.minVoxel, voxelizedObject.maxVoxel, hasLight, lightDirection);
+
+			objectIterator = _voxelizedObjects.erase (objectIterator);
+
+			continue;
+		}
+
+		voxelizedObject.isVisited = false;
+
+		++ objectIterator;
+	}
+}
+
+void VoxelizationRenderPass::AddDirtyRegion (const glm::ivec3& minVoxel, const glm::ivec3& maxVoxel, bool hasLight, const glm::vec3& lightDirection)
+{
+	VoxelDirtyRegions* dirtyRegions = _voxelVolume->GetDirtyRegions ();
+
+	glm::ivec3 windowMin = minVoxel - _windowOrigin;
+	glm::ivec3 windowMax = maxVoxel - _windowOrigin;
+
+	if (hasLight) {
+
+		/*
+		 * Far enough to leave the volume from any voxel
+		*/
+
+		glm::ivec3 shadowOffset = glm::ivec3 (glm::round (lightDirection * (float) (2 * _voxelVolume->GetVolumeSize ())));
+
+		windowMin = glm::min (windowMin, windowMin + shadowOffset);
+		windowMax = glm::max (windowMax, windowMax + shadowOffset);
+	}
+
+	if (!_voxelVolume->IsToroidal ()) {
+		dirtyRegions->AddRegion (windowMin, windowMax);
+
+		return;
+	}
+
+	for (const VoxelBrickRegion& region : _clipmapCascade.GetTextureRegions (windowMin, windowMax)) {
+		dirtyRegions->AddRegion (region.offset, region.offset + region.size);
+	}
+}
+
+/*
+ * Box of the object in voxels, padded by one voxel for the conservative
+ * rasterization of the geometry shader. The box is not clamped to the
+ * volume, so it does not change when the window of a cascade moves.
+*/
+
+void VoxelizationRenderPass::GetObjectVoxels (SceneObject* sceneObject, glm::ivec3& minVoxel, glm::ivec3& maxVoxel)
+{
+	glm::vec3 volumeMinVertex = _voxelVolume->GetMinVertex ();
+	glm::vec3 volumeMaxVertex = _voxelVolume->GetMaxVertex ();
+	glm::vec3 volumeScale = glm::vec3 (_voxelVolume->GetVolumeSize ()) / (volumeMaxVertex - volumeMinVertex);
+
+	/*
+	 * Voxels of a cascade are counted from the world origin
+	*/
+
+	glm::vec3 gridMinVertex = volumeMinVertex;
+
+	if (_voxelVolume->IsToroidal ()) {
+		gridMinVertex = glm::vec3 (0.0f);
+		volumeScale = glm::vec3 (1.0f / _clipmapCascade.GetVoxelSize ());
+	}
+
+	glm::vec3 minVertex = volumeMinVertex;
+	glm::vec3 maxVertex = volumeMaxVertex;
+
+	GameObject* gameObject = dynamic_cast<GameObject*> (sceneObject);
+	bool isAnimated = dynamic_cast<AnimationGameObject*> (sceneObject) != nullptr;
+
+	AABBVolume* boundingBox = sceneObject->GetCollider () == nullptr ? nullptr :
+		dynamic_cast<AABBVolume*> (sceneObject->GetCollider ()->GetGeometricPrimitive ());
+
+	if (isAnimated && boundingBox != nullptr) {
+		minVertex = boundingBox->GetVolumeInformation ()->minVertex;
+		maxVertex = boundingBox->GetVolumeInformation ()->maxVertex;
+	}
+	else if (!isAnimated && gameObject != nullptr && gameObject->GetMesh () != nullptr) {
+		BoundingBox* modelBox = gameObject->GetMesh ()->GetBoundingBox ();
+		glm::mat4 modelMatrix = sceneObject->GetTransform ()->GetModelMatrix ();
+
+		minVertex = glm::vec3 (std::numeric_limits<float>::max ());
+		maxVertex = glm::vec3 (-std::numeric_limits<float>::max ());
+
+		for (int x = 0; x <= 1; x ++) {
+			for (int y = 0; y <= 1; y ++) {
+				for (int z = 0; z <= 1; z ++) {
+					glm::vec4 corner = glm::vec4 (
+						x == 0 ? modelBox->xmin : modelBox->xmax,
+						y == 0 ? modelBox->ymin : modelBox->ymax,
+						z == 0 ? modelBox->zmin : modelBox->zmax, 1.0f);
+
+					glm::vec3 worldCorner = glm::vec3 (modelMatrix * corner);
+
+					minVertex = glm::min (minVertex, worldCorner);
+					maxVertex = glm::max (maxVertex, worldCorner);
+				}
+			}
+		}
+	}
+
+	minVoxel = glm::ivec3 (glm::floor ((minVertex - gridMinVertex) * volumeScale)) - 1;
+	maxVoxel = glm::ivec3 (glm::ceil ((maxVertex - gridMinVertex) * volumeScale)) + 1;
+}
+
+/*
+ * Direction of the light used by the radiance injection, the same one
+ * that is picked by the shadow map pass
+*/
+
+bool VoxelizationRenderPass::GetLightDirection (glm::vec3& lightDirection)
+{
+	for (std::size_t lightIndex = 0; lightIndex < LightsManager::Instance ()->GetDirectionalLightsCount (); lightIndex++) {
+		Light* dirLight = LightsManager::Instance ()->GetDirectionalLight (lightIndex);
+
+		if (dirLight->IsActive ()) {
+			lightDirection = glm::normalize (dirLight->GetTransform ()->GetPosition ()) * -1.0f;
+
+			return true;
+		}
+	}
+
+	return false;
+}
+
+/*
+ * Returns true when the whole volume needs to be voxelized again
+*/
+
+bool VoxelizationRenderPass::UpdateVolumeFingerprint ()
+{
+	std::vector<float> fingerprint;
+
+	/*
+	 * A cascade keeps its voxels while its window moves
+	*/
+
+	if (!_voxelVolume->IsToroidal ()) {
+		glm::vec3 minVertex = _voxelVolume->GetMinVertex ();
+		glm::vec3 maxVertex = _voxelVolume->GetMaxVertex ();
+
+		fingerprint.insert (fingerprint.end (), glm::value_ptr (minVertex), glm::value_ptr (minVertex) + 3);
+		fingerprint.insert (fingerprint.end (), glm::value_ptr (maxVertex), glm::value_ptr (maxVertex) + 3);
+	}
+
+	fingerprint.push_back ((float) _voxelVolume->GetVolumeSize ());
+	fingerprint.push_back ((float) _voxelVolume->GetMipmapLevels ());
+	fingerprint.push_back ((float) _voxelVolume->GetConfiguration ().clipmapCascades);
+	fingerprint.push_back ((float) _voxelVolume->GetConfiguration ().clipmapExtent);
+	fingerprint.push_back ((float) GeneralSettings::Instance ()->GetIntValue ("RadianceInjection"));
+
+	glm::vec3 lightDirection (0.0f);
+
+	if (GetLightDirection (lightDirection)) {
+		fingerprint.insert (fingerprint.end (), glm::value_ptr (lightDirection), glm::value_ptr (lightDirection) + 3);
+	}
+
+	if (fingerprint == _volumeFingerprint) {
+		return false;
+	}
+
+	_volumeFingerprint.swap (fingerprint);
+
+	return true;
+}
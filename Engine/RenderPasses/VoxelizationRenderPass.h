@@ -3,25 +3,113 @@
 
 #include "Renderer/RenderPassI.h"
 
+#include <vector>
+#include <map>
+
 #include "VoxelVolume.h"
+#include "VoxelClipmapCascade.h"
+
+#include "SceneGraph/SceneObject.h"
+#include "Renderer/IndirectDrawBuffer.h"
+#include "Renderer/IndirectDrawCommandBuilder.h"
+#include "Mesh/Model.h"
+
+/*
+ * Voxels of the first level covered by a scene object when it was last
+ * voxelized, the maximum is exclusive. The voxels of a cascade are
+ * counted from the world origin, so they stay the same while its window
+ * moves.
+*/
+
+struct VoxelizedObject
+{
+	glm::ivec3 minVoxel;
+	glm::ivec3 maxVoxel;
+	bool isVisited;
+};
+
+/*
+ * Bricks of the first level a scene object marked, and the transform
+ * and bounds it marked them for
+*/
+
+struct VoxelBrickObject
+{
+	std::vector<float> fingerprint;
+	std::vector<glm::ivec3> bricks;
+	bool isVisited;
+};
+
+/*
+ * Voxelizes one volume, the one fitted to the scene or one cascade of
+ * the clipmap around the camera
+*/
 
 class VoxelizationRenderPass : public RenderPassI
 {
 protected:
+	std::size_t _cascade;
 	VoxelVolume* _voxelVolume;
 
+	/*
+	 * Window of the cascade and its first voxel
+	*/
+
+	VoxelClipmapCascade _clipmapCascade;
+	glm::ivec3 _windowOrigin;
+
+	/*
+	 * Volume bounds the bricks were last allocated for, and the bricks of
+	 * every object in them
+	*/
+
+	std::vector<float> _bricksFingerprint;
+	std::map<SceneObject*, VoxelBrickObject> _brickObjects;
+
+	/*
+	 * Everything that invalidates the whole volume, and the objects that
+	 * are currently in it
+	*/
+
+	std::vector<float> _volumeFingerprint;
+	std::map<SceneObject*, VoxelizedObject> _voxelizedObjects;
+
+	IndirectDrawCommandBuilder _indirectDrawBuilder;
+	IndirectDrawBuffer _indirectDrawBuffer;
+
 public:
-	VoxelizationRenderPass ();
+	VoxelizationRenderPass (std::size_t cascade = 0);
 	~VoxelizationRenderPass ();
 
 	void Init ();
 	RenderVolumeCollection* Execute (Scene* scene, Camera* camera, RenderVolumeCollection* rvc);
 protected:
 	void StartVoxelization ();
-	void GeometryVoxelizationPass (Scene* scene);
+	void GeometryVoxelizationPass (Scene* scene, Camera* camera);
 	void EndVoxelization ();
 
-	void UpdateVoxelVolumeBoundingBox (Scene*);
+	bool IsCascadeActive () const;
+	void UpdateVoxelVolumeConfiguration ();
+	void UpdateVoxelVolumeBoundingBox (Scene*, Camera*);
+	void UpdateVoxelVolumeBricks (Scene*);
+	void UpdateVoxelVolumeDirtyRegions (Scene*);
+
+	void DrawRegion (Scene* scene, const VoxelBrickRegion& region);
+	void DrawIndirect ();
+	void SendUpdateRegion (const VoxelBrickRegion& region);
+	bool IsInRegion (const VoxelizedObject& voxelizedObject, const VoxelBrickRegion& region);
+
+	void AddDirtyRegion (const glm::ivec3& minVoxel, const glm::ivec3& maxVoxel, bool hasLight, const glm::vec3& lightDirection);
+	void GetObjectVoxels (SceneObject* sceneObject, glm::ivec3& minVoxel, glm::ivec3& maxVoxel);
+	bool GetLightDirection (glm::vec3& lightDirection);
+	bool UpdateVolumeFingerprint ();
+
+	void GetObjectBricks (SceneObject* sceneObject, std::vector<glm::ivec3>& bricks);
+	void GetModelBricks (Model* model, const glm::mat4& modelMatrix, std::vector<glm::ivec3>& bricks);
+	void GetBoxBricks (const glm::vec3& minVertex, const glm::vec3& maxVertex, std::vector<glm::ivec3>& bricks);
+	void AddRegionBricks (const glm::vec3& minVoxel, const glm::vec3& maxVoxel, std::vector<glm::ivec3>& bricks);
+	bool UpdateBricksFingerprint ();
+	std::vector<float> GetBricksFingerprint (SceneObject* sceneObject);
 };
 
 #endif
\ No newline at end of file
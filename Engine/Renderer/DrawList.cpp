@@ -0,0 +1,336 @@
+#include "DrawList.h"
+
+#include <chrono>
+#include <cstring>
+#include <algorithm>
+
+#include "Pipeline.h"
+
+#include "Managers/MaterialManager.h"
+
+#include "Wrappers/OpenGL/GL.h"
+
+#include "Debug/Profiler/Profiler.h"
+
+DrawListStatistics::DrawListStatistics () :
+	packetsCount (0),
+	drawsCount (0),
+	shaderChangesCount (0),
+	materialChangesCount (0),
+	vertexArrayChangesCount (0),
+	transformChangesCount (0),
+	indirectCommandsCount (0),
+	sortTime (0.0f),
+	submitTime (0.0f)
+{
+
+}
+
+DrawList::DrawList () :
+	_packets (),
+	_entries (),
+	_sortBuffer (),
+	_viewPosition (0.0f),
+	_isIndirectDraw (false),
+	_indirectDrawBuilder (),
+	_indirectDrawBuffer (),
+	_statistics ()
+{
+
+}
+
+void DrawList::Begin (Camera* camera)
+{
+	_packets.clear ();
+	_entries.clear ();
+
+	_viewPosition = camera->GetPosition ();
+
+	_statistics = DrawListStatistics ();
+}
+
+void DrawList::AddPacket (Renderer* renderer, Shader* shader, std::size_t materialID,
+	unsigned int vertexArray, std::size_t indexCount, unsigned int indexType,
+	StaticGeometryArena* arena, const StaticGeometryRange& range)
+{
+	DrawPacket packet;
+
+	packet.renderer = renderer;
+	packet.shader = shader;
+	packet.materialID = materialID;
+	packet.vertexArray = vertexArray;
+	packet.indexCount = indexCount;
+	packet.indexType = indexType;
+	packet.arena = arena;
+	packet.firstIndex = range.firstIndex;
+	packet.baseVertex = range.firstVertex;
+
+	AddEntry (packet, shader->GetProgram (), materialID);
+}
+
+void DrawList::AddRenderer (Renderer* renderer)
+{
+	DrawPacket packet;
+
+	packet.renderer = renderer;
+	packet.shader = nullptr;
+	packet.materialID = MATERIAL_DEFAULT_ID;
+	packet.vertexArray = 0;
+	packet.indexCount = 0;
+	packet.indexType = 0;
+	packet.arena = nullptr;
+	packet.firstIndex = 0;
+	packet.baseVertex = 0;
+
+	AddEntry (packet, 0, 0);
+}
+
+/*
+ * Least significant digit radix sort on bytes of the key. It is stable,
+ * so packets with equal keys keep the order they were added in. Bytes
+ * that are the same for every key, like the layer in most frames, are
+ * skipped.
+*/
+
+void DrawList::Sort ()
+{
+	std::chrono::time_point<std::chrono::high_resolution_clock> startMoment = std::chrono::high_resolution_clock::now ();
+
+	_sortBuffer.resize (_entries.size ());
+
+	for (std::size_t digit = 0; digit < sizeof (std::uint64_t); digit++) {
+		std::size_t counts [256];
+
+		std::memset (counts, 0, sizeof (counts));
+
+		for (const SortEntry& entry : _entries) {
+			counts [(entry.key >> (digit * 8)) & 0xFF] ++;
+		}
+
+		if (std::find (counts, counts + 256, _entries.size ()) != counts + 256) {
+			continue;
+		}
+
+		std::size_t offset = 0;
+
+		for (std::size_t bucket = 0; bucket < 256; bucket++) {
+			std::size_t count = counts [bucket];
+
+			counts [bucket] = offset;
+			offset += count;
+		}
+
+		for (const SortEntry& entry : _entries) {
+			_sortBuffer [counts [(entry.key >> (digit * 8)) & 0xFF] ++] = entry;
+		}
+
+		_entries.swap (_sortBuffer);
+	}
+
+	std::chrono::duration<float, std::milli> duration = std::chrono::high_resolution_clock::now () - startMoment;
+
+	_statistics.sortTime = duration.count ();
+}
+
+void DrawList::Submit ()
+{
+	std::chrono::time_point<std::chrono::high_resolution_clock> startMoment = std::chrono::high_resolution_clock::now ();
+
+	Renderer* currentRenderer = nullptr;
+	Shader* currentShader = nullptr;
+	std::size_t currentMaterialID = MATERIAL_DEFAULT_ID;
+	unsigned int currentVertexArray = 0;
+
+	GL::DepthMask (GL_TRUE);
+
+	for (const SortEntry& entry : _entries) {
+		const DrawPacket& packet = _packets [entry.packet];
+
+		if (_isIndirectDraw && packet.arena != nullptr) {
+			continue;
+		}
+
+		/*
+		 * A renderer that draws itself may change any state, nothing is
+		 * known to be bound after it
+		*/
+
+		if (packet.shader == nullptr) {
+			packet.renderer->Draw ();
+
+			currentRenderer = nullptr;
+			currentShader = nullptr;
+			currentVertexArray = 0;
+
+			_statistics.drawsCount ++;
+
+			continue;
+		}
+
+		bool isTransformChanged = packet.renderer != currentRenderer;
+
+		if (isTransformChanged) {
+			Pipeline::SetObjectTransform (packet.renderer->GetTransform ());
+			currentRenderer = packet.renderer;
+
+			_statistics.transformChangesCount ++;
+		}
+
+		if (packet.shader != currentShader || packet.materialID != currentMaterialID) {
+			Material* material = MaterialManager::Instance ().GetMaterial (packet.materialID);
+
+			GL::BlendFunc (material->blending.first, material->blending.second);
+
+			Pipeline::SendMaterial (material, packet.shader);
+
+			if (packet.shader != currentShader) {
+				_statistics.shaderChangesCount ++;
+			}
+
+			currentShader = packet.shader;
+			currentMaterialID = packet.materialID;
+
+			_statistics.materialChangesCount ++;
+		}
+		else if (isTransformChanged) {
+			Pipeline::UpdateMatrices (packet.shader);
+		}
+
+		if (packet.vertexArray != currentVertexArray) {
+			GL::BindVertexArray (packet.vertexArray);
+			currentVertexArray = packet.vertexArray;
+
+			_statistics.vertexArrayChangesCount ++;
+		}
+
+		GL::DrawElementsBaseVertex (GL_TRIANGLES, packet.indexCount, packet.indexType,
+			(void*) (sizeof (unsigned int) * packet.firstIndex), packet.baseVertex);
+
+		_statistics.drawsCount ++;
+	}
+
+	if (_isIndirectDraw) {
+		SubmitIndirect ();
+	}
+
+	std::chrono::duration<float, std::milli> duration = std::chrono::high_resolution_clock::now () - startMoment;
+
+	_statistics.submitTime = duration.count ();
+}
+
+void DrawList::SetIndirectDraw (bool isIndirectDraw)
+{
+	_isIndirectDraw = isIndirectDraw;
+}
+
+const DrawListStatistics& DrawList::GetStatistics () const
+{
+	return _statistics;
+}
+
+/*
+ * The bits of a positive float grow with its value, the top ones of the
+ * distance are an ordering that needs no depth range
+*/
+
+std::uint64_t DrawList::BuildKey (std::size_t layer, std::size_t shader, std::size_t material, float depth)
+{
+	std::uint32_t depthBits;
+
+	depth = std::max (depth, 0.0f);
+	std::memcpy (&depthBits, &depth, sizeof (depthBits));
+
+	std::uint64_t key = std::min (layer, (std::size_t) (1 << DRAW_KEY_LAYER_BITS) - 1);
+
+	key = (key << DRAW_KEY_SHADER_BITS) | (shader & ((1 << DRAW_KEY_SHADER_BITS) - 1));
+	key = (key << DRAW_KEY_MATERIAL_BITS) | (material & ((1 << DRAW_KEY_MATERIAL_BITS) - 1));
+	key = (key << DRAW_KEY_DEPTH_BITS) | (depthBits >> (31 - DRAW_KEY_DEPTH_BITS));
+
+	return key;
+}
+
+void DrawList::AddEntry (const DrawPacket& packet, std::size_t shader, std::size_t material)
+{
+	float depth = glm::distance (_viewPosition, packet.renderer->GetTransform ()->GetPosition ());
+
+	SortEntry entry;
+
+	entry.key = BuildKey (packet.renderer->GetPriority (), shader, material, depth);
+	entry.packet = (std::uint32_t) _packets.size ();
+
+	_packets.push_back (packet);
+	_entries.push_back (entry);
+
+	_statistics.packetsCount ++;
+}
+
+/*
+ * Packets are taken in the order they were added, the groups of an object
+ * are next to each other and share its matrices. The tag of a batch is
+ * the packet its material and shader are sent from.
+*/
+
+void DrawList::SubmitIndirect ()
+{
+	PROFILER_LOGGER("INDIRECT DRAW SUBMIT")
+
+	_indirectDrawBuilder.Clear ();
+
+	Renderer* currentRenderer = nullptr;
+	std::size_t object = 0;
+
+	for (std::size_t index = 0; index < _packets.size (); index++) {
+		const DrawPacket& packet = _packets [index];
+
+		if (packet.arena == nullptr) {
+			continue;
+		}
+
+		if (packet.renderer != currentRenderer) {
+			object = _indirectDrawBuilder.AddObject (packet.renderer->GetTransform ()->GetModelMatrix ());
+			currentRenderer = packet.renderer;
+		}
+
+		std::uint64_t key = IndirectDrawBuffer::BuildBatchKey (packet.arena->GetIndex (),
+			packet.materialID, packet.shader->GetProgram ());
+
+		_indirectDrawBuilder.AddDraw (key, index, object, packet.indexCount,
+			packet.firstIndex, (std::int32_t) packet.baseVertex);
+	}
+
+	if (_indirectDrawBuilder.IsEmpty ()) {
+		return;
+	}
+
+	_indirectDrawBuilder.Build ();
+	_indirectDrawBuffer.Upload (_indirectDrawBuilder);
+
+	Pipeline::SetIndirectDraw (true);
+
+	Shader* currentShader = nullptr;
+
+	for (const IndirectDrawBatch& batch : _indirectDrawBuilder.GetBatches ()) {
+		const DrawPacket& packet = _packets [batch.tag];
+
+		Material* material = MaterialManager::Instance ().GetMaterial (packet.materialID);
+
+		GL::BlendFunc (material->blending.first, material->blending.second);
+
+		Pipeline::SendMaterial (material, packet.shader);
+
+		if (packet.shader != currentShader) {
+			_statistics.shaderChangesCount ++;
+		}
+
+		currentShader = packet.shader;
+
+		_indirectDrawBuffer.Draw (batch);
+
+		_statistics.materialChangesCount ++;
+		_statistics.vertexArrayChangesCount ++;
+		_statistics.drawsCount ++;
+		_statistics.indirectCommandsCount += batch.commandsCount;
+	}
+
+	Pipeline::SetIndirectDraw (false);
+}
\ No newline at end of file
@@ -0,0 +1,112 @@
+#ifndef DRAWLIST_H
+#define DRAWLIST_H
+
+#include <vector>
+#include <cstdint>
+
+#include "Renderer.h"
+#include "StaticGeometryArena.h"
+#include "IndirectDrawBuffer.h"
+#include "IndirectDrawCommandBuilder.h"
+
+#include "Shader/Shader.h"
+#include "Systems/Camera/Camera.h"
+
+#include "Core/Math/glm/glm.hpp"
+
+/*
+ * Layout of the sort key, from the most significant bits: layer (the
+ * renderer priority), shader, material and the depth of the object.
+ * Fields wider than their bits are truncated, which only makes packets
+ * share a group, the state is still compared exactly on submit.
+*/
+
+#define DRAW_KEY_LAYER_BITS 8
+#define DRAW_KEY_SHADER_BITS 12
+#define DRAW_KEY_MATERIAL_BITS 20
+#define DRAW_KEY_DEPTH_BITS 24
+
+struct DrawPacket
+{
+	Renderer* renderer;
+	Shader* shader;
+	std::size_t materialID;
+	unsigned int vertexArray;
+	std::size_t indexCount;
+	unsigned int indexType;
+	StaticGeometryArena* arena;
+	std::size_t firstIndex;
+	std::size_t baseVertex;
+};
+
+struct DrawListStatistics
+{
+	std::size_t packetsCount;
+	std::size_t drawsCount;
+	std::size_t shaderChangesCount;
+	std::size_t materialChangesCount;
+	std::size_t vertexArrayChangesCount;
+	std::size_t transformChangesCount;
+	std::size_t indirectCommandsCount;
+	float sortTime;
+	float submitTime;
+
+	DrawListStatistics ();
+};
+
+/*
+ * Draw packets of a frame, sorted by a 64 bit key so that packets that
+ * use the same shader and material are submitted together. Only the
+ * state that differs from the previous packet is sent.
+ *
+ * With indirect draw on, the packets in a static geometry arena are
+ * drawn after the others by one multi draw per arena, shader and
+ * material.
+*/
+
+class DrawList
+{
+protected:
+	struct SortEntry
+	{
+		std::uint64_t key;
+		std::uint32_t packet;
+	};
+
+	std::vector<DrawPacket> _packets;
+	std::vector<SortEntry> _entries;
+	std::vector<SortEntry> _sortBuffer;
+
+	glm::vec3 _viewPosition;
+
+	bool _isIndirectDraw;
+	IndirectDrawCommandBuilder _indirectDrawBuilder;
+	IndirectDrawBuffer _indirectDrawBuffer;
+
+	DrawListStatistics _statistics;
+
+public:
+	DrawList ();
+
+	void Begin (Camera* camera);
+
+	void AddPacket (Renderer* renderer, Shader* shader, std::size_t materialID,
+		unsigned int vertexArray, std::size_t indexCount, unsigned int indexType,
+		StaticGeometryArena* arena = nullptr, const StaticGeometryRange& range = StaticGeometryRange ());
+	void AddRenderer (Renderer* renderer);
+
+	void Sort ();
+	void Submit ();
+
+	void SetIndirectDraw (bool isIndirectDraw);
+
+	const DrawListStatistics& GetStatistics () const;
+
+	static std::uint64_t BuildKey (std::size_t layer, std::size_t shader, std::size_t material, float depth);
+protected:
+	void AddEntry (const DrawPacket& packet, std::size_t shader, std::size_t material);
+
+	void SubmitIndirect ();
+};
+
+#endif
\ No newline at end of file
@@ -0,0 +1,210 @@
+#include "GPUTimerRing.h"
+
+#include <algorithm>
+
+GPUTimerBackend::~GPUTimerBackend ()
+{
+
+}
+
+GPUTimerStatistics::GPUTimerStatistics () :
+	name (),
+	samplesCount (0),
+	last (0),
+	mean (0),
+	min (0),
+	max (0)
+{
+
+}
+
+/*
+ * The ring starts on the last slot, the first frame moves to slot 0
+*/
+
+GPUTimerRing::GPUTimerRing (GPUTimerBackend* backend) :
+	_backend (backend),
+	_timers (),
+	_freeQueries (),
+	_queries (),
+	_frame (GPU_TIMER_FRAMES_COUNT - 1),
+	_lateSamplesCount (0)
+{
+
+}
+
+GPUTimerRing::~GPUTimerRing ()
+{
+	for (void* query : _queries) {
+		_backend->Delete (query);
+	}
+
+	delete _backend;
+}
+
+std::size_t GPUTimerRing::AddTimer (const std::string& name)
+{
+	Timer timer;
+
+	timer.name = name;
+	timer.begin = nullptr;
+	timer.samples.resize (GPU_TIMER_SAMPLES_COUNT, 0.0);
+	timer.samplesCount = 0;
+	timer.lastSample = 0;
+
+	_timers.push_back (timer);
+
+	return _timers.size () - 1;
+}
+
+/*
+ * Reads the results of the frame that used the slot before, then hands
+ * the slot to the new frame
+*/
+
+void GPUTimerRing::BeginFrame ()
+{
+	_frame = (_frame + 1) % GPU_TIMER_FRAMES_COUNT;
+
+	ReadFrame (_frame);
+
+	for (Timer& timer : _timers) {
+		if (timer.begin != nullptr) {
+			_freeQueries.push_back (timer.begin);
+			timer.begin = nullptr;
+		}
+	}
+}
+
+/*
+ * A timer begun twice keeps the last begin
+*/
+
+void GPUTimerRing::Begin (std::size_t timer)
+{
+	void* query = _timers [timer].begin;
+
+	if (query == nullptr) {
+		query = GetQuery ();
+	}
+
+	_backend->Record (query);
+
+	_timers [timer].begin = query;
+}
+
+void GPUTimerRing::End (std::size_t timer)
+{
+	if (_timers [timer].begin == nullptr) {
+		return;
+	}
+
+	Sample sample;
+
+	sample.timer = timer;
+	sample.begin = _timers [timer].begin;
+	sample.end = GetQuery ();
+
+	_backend->Record (sample.end);
+
+	_frames [_frame].push_back (sample);
+
+	_timers [timer].begin = nullptr;
+}
+
+std::size_t GPUTimerRing::GetTimersCount () const
+{
+	return _timers.size ();
+}
+
+GPUTimerStatistics GPUTimerRing::GetStatistics (std::size_t timer) const
+{
+	const Timer& timerData = _timers [timer];
+
+	GPUTimerStatistics statistics;
+
+	statistics.name = timerData.name;
+	statistics.samplesCount = timerData.samplesCount;
+
+	std::size_t samplesCount = std::min (timerData.samplesCount, (std::size_t) GPU_TIMER_SAMPLES_COUNT);
+
+	if (samplesCount == 0) {
+		return statistics;
+	}
+
+	statistics.last = timerData.samples [(timerData.lastSample + GPU_TIMER_SAMPLES_COUNT - 1) % GPU_TIMER_SAMPLES_COUNT];
+	statistics.min = timerData.samples [0];
+	statistics.max = timerData.samples [0];
+
+	double total = 0;
+
+	for (std::size_t index = 0; index < samplesCount; index++) {
+		double sample = timerData.samples [index];
+
+		total += sample;
+
+		statistics.min = std::min (statistics.min, sample);
+		statistics.max = std::max (statistics.max, sample);
+	}
+
+	statistics.mean = total / samplesCount;
+
+	return statistics;
+}
+
+std::size_t GPUTimerRing::GetLateSamplesCount () const
+{
+	return _lateSamplesCount;
+}
+
+std::size_t GPUTimerRing::GetQueriesCount () const
+{
+	return _queries.size ();
+}
+
+void* GPUTimerRing::GetQuery ()
+{
+	if (!_freeQueries.empty ()) {
+		void* query = _freeQueries.back ();
+		_freeQueries.pop_back ();
+
+		return query;
+	}
+
+	void* query = _backend->Create ();
+
+	_queries.push_back (query);
+
+	return query;
+}
+
+/*
+ * Both queries of a sample are back in the pool afterwards, recording a
+ * query again drops a result that was never read
+*/
+
+void GPUTimerRing::ReadFrame (std::size_t frame)
+{
+	for (const Sample& sample : _frames [frame]) {
+		if (_backend->IsAvailable (sample.begin) && _backend->IsAvailable (sample.end)) {
+			std::uint64_t begin = _backend->GetTimestamp (sample.begin);
+			std::uint64_t end = _backend->GetTimestamp (sample.end);
+
+			AddSample (_timers [sample.timer], end > begin ? (end - begin) / 1000000.0 : 0.0);
+		} else {
+			_lateSamplesCount ++;
+		}
+
+		_freeQueries.push_back (sample.begin);
+		_freeQueries.push_back (sample.end);
+	}
+
+	_frames [frame].clear ();
+}
+
+void GPUTimerRing::AddSample (Timer& timer, double duration)
+{
+	timer.samples [timer.lastSample] = duration;
+	timer.lastSample = (timer.lastSample + 1) % GPU_TIMER_SAMPLES_COUNT;
+	timer.samplesCount ++;
+}
\ No newline at end of file
@@ -0,0 +1,117 @@
+#ifndef GPUTIMERRING_H
+#define GPUTIMERRING_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/*
+ * Frames whose queries may be in flight at the same time. The results of
+ * a frame are read when its slot of the ring comes back, this many
+ * frames later.
+*/
+
+#define GPU_TIMER_FRAMES_COUNT 4
+
+/*
+ * Last samples of a timer its statistics are computed over
+*/
+
+#define GPU_TIMER_SAMPLES_COUNT 64
+
+/*
+ * Timestamp queries the ring records into. The GL backend uses query
+ * objects, a mock can give back scripted timestamps.
+*/
+
+class GPUTimerBackend
+{
+public:
+	virtual ~GPUTimerBackend ();
+
+	virtual void* Create () = 0;
+	virtual void Delete (void* query) = 0;
+
+	virtual void Record (void* query) = 0;
+	virtual bool IsAvailable (void* query) = 0;
+	virtual std::uint64_t GetTimestamp (void* query) = 0;
+};
+
+/*
+ * Durations of the last samples of a timer, in milliseconds
+*/
+
+struct GPUTimerStatistics
+{
+	std::string name;
+	std::size_t samplesCount;
+	double last;
+	double mean;
+	double min;
+	double max;
+
+	GPUTimerStatistics ();
+};
+
+/*
+ * Named GPU timers measured with a pair of timestamps every time they
+ * run. The queries of a frame are kept in its slot of a ring and read
+ * back only when the slot is reused, so reading never waits for the GPU.
+ * Queries still not available then are given up and counted as late.
+ *
+ * Queries are taken from a pool that grows to the most a frame needs.
+*/
+
+class GPUTimerRing
+{
+protected:
+	struct Sample
+	{
+		std::size_t timer;
+		void* begin;
+		void* end;
+	};
+
+	struct Timer
+	{
+		std::string name;
+		void* begin;
+		std::vector<double> samples;
+		std::size_t samplesCount;
+		std::size_t lastSample;
+	};
+
+	GPUTimerBackend* _backend;
+	std::vector<Timer> _timers;
+	std::vector<Sample> _frames [GPU_TIMER_FRAMES_COUNT];
+	std::vector<void*> _freeQueries;
+	std::vector<void*> _queries;
+	std::size_t _frame;
+	std::size_t _lateSamplesCount;
+
+public:
+	GPUTimerRing (GPUTimerBackend* backend);
+	~GPUTimerRing ();
+
+	std::size_t AddTimer (const std::string& name);
+
+	void BeginFrame ();
+
+	void Begin (std::size_t timer);
+	void End (std::size_t timer);
+
+	std::size_t GetTimersCount () const;
+	GPUTimerStatistics GetStatistics (std::size_t timer) const;
+	std::size_t GetLateSamplesCount () const;
+	std::size_t GetQueriesCount () const;
+private:
+	GPUTimerRing (const GPUTimerRing&);
+	GPUTimerRing& operator=(const GPUTimerRing&);
+
+	void* GetQuery ();
+	void ReadFrame (std::size_t frame);
+	void AddSample (Timer& timer, double duration);
+};
+
+#endif
\ No newline at end of file
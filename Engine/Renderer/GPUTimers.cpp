@@ -0,0 +1,123 @@
+#include "GPUTimers.h"
+
+#include "Wrappers/OpenGL/GL.h"
+
+#include "Core/Console/Console.h"
+
+void* GLGPUTimerBackend::Create ()
+{
+	GLuint query = 0;
+
+	GL::GenQueries (1, &query);
+
+	return (void*) (std::size_t) query;
+}
+
+void GLGPUTimerBackend::Delete (void* query)
+{
+	GLuint id = (GLuint) (std::size_t) query;
+
+	GL::DeleteQueries (1, &id);
+}
+
+void GLGPUTimerBackend::Record (void* query)
+{
+	GL::QueryCounter ((GLuint) (std::size_t) query, GL_TIMESTAMP);
+}
+
+bool GLGPUTimerBackend::IsAvailable (void* query)
+{
+	GLint isAvailable = GL_FALSE;
+
+	GL::GetQueryObjectiv ((GLuint) (std::size_t) query, GL_QUERY_RESULT_AVAILABLE, &isAvailable);
+
+	return isAvailable == GL_TRUE;
+}
+
+/*
+ * Timestamps are in nanoseconds
+*/
+
+std::uint64_t GLGPUTimerBackend::GetTimestamp (void* query)
+{
+	GLuint64 timestamp = 0;
+
+	GL::GetQueryObjectui64v ((GLuint) (std::size_t) query, GL_QUERY_RESULT, &timestamp);
+
+	return timestamp;
+}
+
+/*
+ * First used by the render modules, once GLEW is initialized
+*/
+
+GPUTimers::GPUTimers () :
+	_ring (new GLGPUTimerBackend ()),
+	_isSupported (GLEW_ARB_timer_query)
+{
+	if (!_isSupported) {
+		Console::LogWarning ("ARB_timer_query is not supported, the GPU time of the render passes is not measured");
+	}
+}
+
+GPUTimers::~GPUTimers ()
+{
+
+}
+
+std::size_t GPUTimers::AddTimer (const std::string& name)
+{
+	return _ring.AddTimer (name);
+}
+
+void GPUTimers::BeginFrame ()
+{
+	if (!_isSupported) {
+		return;
+	}
+
+	_ring.BeginFrame ();
+}
+
+void GPUTimers::Begin (std::size_t timer)
+{
+	if (!_isSupported) {
+		return;
+	}
+
+	_ring.Begin (timer);
+}
+
+void GPUTimers::End (std::size_t timer)
+{
+	if (!_isSupported) {
+		return;
+	}
+
+	_ring.End (timer);
+}
+
+std::size_t GPUTimers::GetTimersCount () const
+{
+	return _ring.GetTimersCount ();
+}
+
+GPUTimerStatistics GPUTimers::GetStatistics (std::size_t timer) const
+{
+	return _ring.GetStatistics (timer);
+}
+
+void GPUTimers::LogStatistics () const
+{
+	for (std::size_t timer = 0; timer < _ring.GetTimersCount (); timer++) {
+		GPUTimerStatistics statistics = _ring.GetStatistics (timer);
+
+		Console::Log ("GPU timer: " + statistics.name +
+			" -> Samples: " + std::to_string (statistics.samplesCount) +
+			" Mean: " + std::to_string (statistics.mean) +
+			" Min: " + std::to_string (statistics.min) +
+			" Max: " + std::to_string (statistics.max) + " (ms)");
+	}
+
+	Console::Log ("GPU timer: " + std::to_string (_ring.GetLateSamplesCount ()) + " late samples");
+}
\ No newline at end of file
@@ -0,0 +1,57 @@
+#ifndef GPUTIMERS_H
+#define GPUTIMERS_H
+
+#include "Core/Singleton/Singleton.h"
+
+#include <string>
+
+#include "GPUTimerRing.h"
+
+/*
+ * Timestamp queries of the timer ring as GL query objects
+*/
+
+class GLGPUTimerBackend : public GPUTimerBackend
+{
+public:
+	void* Create ();
+	void Delete (void* query);
+
+	void Record (void* query);
+	bool IsAvailable (void* query);
+	std::uint64_t GetTimestamp (void* query);
+};
+
+/*
+ * GPU time of the render passes, see GPUTimerRing. Nothing is measured
+ * without ARB_timer_query.
+*/
+
+class GPUTimers : public Singleton<GPUTimers>
+{
+	friend Singleton<GPUTimers>;
+
+private:
+	GPUTimerRing _ring;
+	bool _isSupported;
+
+public:
+	std::size_t AddTimer (const std::string& name);
+
+	void BeginFrame ();
+
+	void Begin (std::size_t timer);
+	void End (std::size_t timer);
+
+	std::size_t GetTimersCount () const;
+	GPUTimerStatistics GetStatistics (std::size_t timer) const;
+
+	void LogStatistics () const;
+private:
+	GPUTimers ();
+	~GPUTimers ();
+	GPUTimers (const GPUTimers&);
+	GPUTimers& operator=(const GPUTimers&);
+};
+
+#endif
\ No newline at end of file
@@ -0,0 +1,99 @@
+#include "IndirectDrawBuffer.h"
+
+#include "StaticGeometryArena.h"
+
+#include "Wrappers/OpenGL/GL.h"
+
+IndirectDrawBuffer::IndirectDrawBuffer () :
+	_commandsBuffer (0),
+	_drawsDataBuffer (0),
+	_drawsDataCount (0)
+{
+
+}
+
+IndirectDrawBuffer::~IndirectDrawBuffer ()
+{
+	if (_commandsBuffer == 0) {
+		return;
+	}
+
+	GL::DeleteBuffers (1, &_commandsBuffer);
+	GL::DeleteBuffers (1, &_drawsDataBuffer);
+}
+
+/*
+ * The buffers are orphaned on every upload, the draws of the previous
+ * frame may still read the old storage
+*/
+
+void IndirectDrawBuffer::Upload (const IndirectDrawCommandBuilder& builder)
+{
+	Create ();
+
+	const std::vector<DrawElementsIndirectCommand>& commands = builder.GetCommands ();
+	const std::vector<IndirectDrawData>& drawsData = builder.GetDrawsData ();
+
+	GL::BindBuffer (GL_DRAW_INDIRECT_BUFFER, _commandsBuffer);
+	GL::BufferData (GL_DRAW_INDIRECT_BUFFER, sizeof (DrawElementsIndirectCommand) * commands.size (),
+		commands.data (), GL_STREAM_DRAW);
+
+	GL::BindBuffer (GL_SHADER_STORAGE_BUFFER, _drawsDataBuffer);
+	GL::BufferData (GL_SHADER_STORAGE_BUFFER, sizeof (IndirectDrawData) * drawsData.size (),
+		drawsData.data (), GL_STREAM_DRAW);
+
+	_drawsDataCount = drawsData.size ();
+}
+
+void IndirectDrawBuffer::Draw (const IndirectDrawBatch& batch)
+{
+	StaticGeometryArena* arena = StaticGeometryArena::GetArena (GetBatchArena (batch.key));
+
+	if (arena == nullptr || batch.commandsCount == 0) {
+		return;
+	}
+
+	arena->Bind (_drawsDataCount);
+
+	GL::BindBuffer (GL_DRAW_INDIRECT_BUFFER, _commandsBuffer);
+	GL::BindBufferBase (GL_SHADER_STORAGE_BUFFER, INDIRECT_DRAW_DATA_BINDING, _drawsDataBuffer);
+
+	GL::MultiDrawElementsIndirect (GL_TRIANGLES, GL_UNSIGNED_INT,
+		(void*) (batch.firstCommand * sizeof (DrawElementsIndirectCommand)),
+		batch.commandsCount, sizeof (DrawElementsIndirectCommand));
+}
+
+std::uint64_t IndirectDrawBuffer::BuildBatchKey (std::size_t arena, std::size_t material, std::size_t shader)
+{
+	std::uint64_t key = arena & ((1 << INDIRECT_DRAW_KEY_ARENA_BITS) - 1);
+
+	key = (key << INDIRECT_DRAW_KEY_SHADER_BITS) | (shader & ((1 << INDIRECT_DRAW_KEY_SHADER_BITS) - 1));
+	key = (key << INDIRECT_DRAW_KEY_MATERIAL_BITS) | (material & 0xFFFFFFFF);
+
+	return key;
+}
+
+std::size_t IndirectDrawBuffer::GetBatchArena (std::uint64_t key)
+{
+	return (std::size_t) (key >> (INDIRECT_DRAW_KEY_SHADER_BITS + INDIRECT_DRAW_KEY_MATERIAL_BITS));
+}
+
+std::size_t IndirectDrawBuffer::GetBatchShader (std::uint64_t key)
+{
+	return (std::size_t) ((key >> INDIRECT_DRAW_KEY_MATERIAL_BITS) & ((1 << INDIRECT_DRAW_KEY_SHADER_BITS) - 1));
+}
+
+std::size_t IndirectDrawBuffer::GetBatchMaterial (std::uint64_t key)
+{
+	return (std::size_t) (key & 0xFFFFFFFF);
+}
+
+void IndirectDrawBuffer::Create ()
+{
+	if (_commandsBuffer != 0) {
+		return;
+	}
+
+	GL::GenBuffers (1, &_commandsBuffer);
+	GL::GenBuffers (1, &_drawsDataBuffer);
+}
\ No newline at end of file
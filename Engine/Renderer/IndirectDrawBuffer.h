@@ -0,0 +1,51 @@
+#ifndef INDIRECTDRAWBUFFER_H
+#define INDIRECTDRAWBUFFER_H
+
+#include <cstdint>
+
+#include "IndirectDrawCommandBuilder.h"
+
+/*
+ * Binding of the storage buffer that holds the per draw data
+*/
+
+#define INDIRECT_DRAW_DATA_BINDING 0
+
+/*
+ * Layout of the batch key, from the most significant bits: static
+ * geometry arena, shader and material. Draws of a batch share all three.
+*/
+
+#define INDIRECT_DRAW_KEY_ARENA_BITS 8
+#define INDIRECT_DRAW_KEY_SHADER_BITS 24
+#define INDIRECT_DRAW_KEY_MATERIAL_BITS 32
+
+/*
+ * GPU side of a built command buffer. The commands and the per draw data
+ * are uploaded once per build, each batch is then drawn by a single
+ * multi draw call over the vertex array of its arena.
+*/
+
+class IndirectDrawBuffer
+{
+protected:
+	unsigned int _commandsBuffer;
+	unsigned int _drawsDataBuffer;
+	std::size_t _drawsDataCount;
+
+public:
+	IndirectDrawBuffer ();
+	~IndirectDrawBuffer ();
+
+	void Upload (const IndirectDrawCommandBuilder& builder);
+	void Draw (const IndirectDrawBatch& batch);
+
+	static std::uint64_t BuildBatchKey (std::size_t arena, std::size_t material, std::size_t shader = 0);
+	static std::size_t GetBatchArena (std::uint64_t key);
+	static std::size_t GetBatchShader (std::uint64_t key);
+	static std::size_t GetBatchMaterial (std::uint64_t key);
+protected:
+	void Create ();
+};
+
+#endif
\ No newline at end of file
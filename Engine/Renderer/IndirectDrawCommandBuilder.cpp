@@ -0,0 +1,96 @@
+#include "IndirectDrawCommandBuilder.h"
+
+#include <algorithm>
+
+IndirectDrawCommandBuilder::IndirectDrawCommandBuilder () :
+	_draws (),
+	_drawsData (),
+	_commands (),
+	_batches ()
+{
+
+}
+
+void IndirectDrawCommandBuilder::Clear ()
+{
+	_draws.clear ();
+	_drawsData.clear ();
+	_commands.clear ();
+	_batches.clear ();
+}
+
+std::size_t IndirectDrawCommandBuilder::AddObject (const glm::mat4& modelMatrix)
+{
+	IndirectDrawData drawData;
+
+	drawData.modelMatrix = modelMatrix;
+	drawData.normalMatrix = glm::mat4 (glm::transpose (glm::inverse (glm::mat3 (modelMatrix))));
+
+	_drawsData.push_back (drawData);
+
+	return _drawsData.size () - 1;
+}
+
+void IndirectDrawCommandBuilder::AddDraw (std::uint64_t key, std::size_t tag, std::size_t object,
+	std::size_t indexCount, std::size_t firstIndex, std::int32_t baseVertex)
+{
+	IndirectDraw draw;
+
+	draw.key = key;
+	draw.tag = tag;
+
+	draw.command.count = (std::uint32_t) indexCount;
+	draw.command.instanceCount = 1;
+	draw.command.firstIndex = (std::uint32_t) firstIndex;
+	draw.command.baseVertex = baseVertex;
+	draw.command.baseInstance = (std::uint32_t) object;
+
+	_draws.push_back (draw);
+}
+
+void IndirectDrawCommandBuilder::Build ()
+{
+	_commands.clear ();
+	_batches.clear ();
+
+	std::stable_sort (_draws.begin (), _draws.end (),
+		[] (const IndirectDraw& a, const IndirectDraw& b) {
+			return a.key < b.key;
+		});
+
+	for (const IndirectDraw& draw : _draws) {
+		if (_batches.empty () || _batches.back ().key != draw.key) {
+			IndirectDrawBatch batch;
+
+			batch.key = draw.key;
+			batch.tag = draw.tag;
+			batch.firstCommand = _commands.size ();
+			batch.commandsCount = 0;
+
+			_batches.push_back (batch);
+		}
+
+		_commands.push_back (draw.command);
+		_batches.back ().commandsCount ++;
+	}
+}
+
+const std::vector<DrawElementsIndirectCommand>& IndirectDrawCommandBuilder::GetCommands () const
+{
+	return _commands;
+}
+
+const std::vector<IndirectDrawData>& IndirectDrawCommandBuilder::GetDrawsData () const
+{
+	return _drawsData;
+}
+
+const std::vector<IndirectDrawBatch>& IndirectDrawCommandBuilder::GetBatches () const
+{
+	return _batches;
+}
+
+bool IndirectDrawCommandBuilder::IsEmpty () const
+{
+	return _draws.empty ();
+}
\ No newline at end of file
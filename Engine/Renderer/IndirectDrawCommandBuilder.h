@@ -0,0 +1,88 @@
+#ifndef INDIRECTDRAWCOMMANDBUILDER_H
+#define INDIRECTDRAWCOMMANDBUILDER_H
+
+#include <vector>
+#include <cstdint>
+
+#include "Core/Math/glm/glm.hpp"
+
+/*
+ * Same layout as the commands read by glMultiDrawElementsIndirect
+*/
+
+struct DrawElementsIndirectCommand
+{
+	std::uint32_t count;
+	std::uint32_t instanceCount;
+	std::uint32_t firstIndex;
+	std::int32_t baseVertex;
+	std::uint32_t baseInstance;
+};
+
+/*
+ * Per object data read by the shaders from a storage buffer, in std430
+ * layout. The normal matrix is kept in a mat4 to avoid the padding rules
+ * of mat3.
+*/
+
+struct IndirectDrawData
+{
+	glm::mat4 modelMatrix;
+	glm::mat4 normalMatrix;
+};
+
+/*
+ * Range of commands that share the same batch key, drawn by a single
+ * multi draw call. The tag is the one given with its first draw.
+*/
+
+struct IndirectDrawBatch
+{
+	std::uint64_t key;
+	std::size_t tag;
+	std::size_t firstCommand;
+	std::size_t commandsCount;
+};
+
+/*
+ * Builds the command buffer of a multi draw from the visible set. Each
+ * object adds its data once, its draws point to it through the base
+ * instance of their commands. On build, the draws are grouped by batch
+ * key, keeping the order they were added in inside a batch.
+*/
+
+class IndirectDrawCommandBuilder
+{
+protected:
+	struct IndirectDraw
+	{
+		std::uint64_t key;
+		std::size_t tag;
+		DrawElementsIndirectCommand command;
+	};
+
+	std::vector<IndirectDraw> _draws;
+	std::vector<IndirectDrawData> _drawsData;
+
+	std::vector<DrawElementsIndirectCommand> _commands;
+	std::vector<IndirectDrawBatch> _batches;
+
+public:
+	IndirectDrawCommandBuilder ();
+
+	void Clear ();
+
+	std::size_t AddObject (const glm::mat4& modelMatrix);
+	void AddDraw (std::uint64_t key, std::size_t tag, std::size_t object,
+		std::size_t indexCount, std::size_t firstIndex, std::int32_t baseVertex);
+
+	void Build ();
+
+	const std::vector<DrawElementsIndirectCommand>& GetCommands () const;
+	const std::vector<IndirectDrawData>& GetDrawsData () const;
+	const std::vector<IndirectDrawBatch>& GetBatches () const;
+
+	bool IsEmpty () const;
+};
+
+#endif
\ No newline at end of file
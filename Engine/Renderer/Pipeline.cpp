@@ -7,9 +7,12 @@
 #include "Material/Material.h"
 #include "Managers/ShaderManager.h"
 #include "Managers/TextureManager.h"
+#include "Managers/MaterialManager.h"
 #include "Skybox/Skybox.h"
 
 #include "PipelineAttribute.h"
+#include "StreamingBuffer.h"
+#include "IndirectDrawCommandBuilder.h"
 
 #include "Wrappers/OpenGL/GL.h"
 
@@ -21,8 +24,72 @@ glm::mat4 Pipeline::_modelMatrix (0);
 glm::mat4 Pipeline::_viewMatrix (0);
 glm::mat4 Pipeline::_projectionMatrix (0);
 glm::vec3 Pipeline::_cameraPosition (0);
+glm::mat4 Pipeline::_modelViewMatrix (0);
+glm::mat4 Pipeline::_modelViewProjectionMatrix (0);
+glm::mat3 Pipeline::_normalMatrix (0);
+glm::mat3 Pipeline::_normalWorldMatrix (0);
+bool Pipeline::_isViewDirty (true);
+bool Pipeline::_isObjectDirty (true);
+bool Pipeline::_isIndirectDraw (false);
+unsigned int Pipeline::_viewUniformBuffer (0);
+bool Pipeline::_isObjectDataDirty (true);
+std::size_t Pipeline::_objectDataFrame (0);
+int Pipeline::_objectIndex (0);
+unsigned int Pipeline::_materialsBuffer (0);
+std::size_t Pipeline::_materialsChangesCount (0);
 std::size_t Pipeline::_textureCount (0);
 Shader* Pipeline::_lockedShader(nullptr);
+unsigned int Pipeline::_currentProgram (0);
+
+/*
+ * Uniforms sent on every draw. Their locations are kept by the shader
+ * under these indices, so that no lookup compares names.
+*/
+
+enum PipelineUniform
+{
+	MODEL_MATRIX_UNIFORM = 0,
+	MODEL_VIEW_MATRIX_UNIFORM,
+	MODEL_VIEW_PROJECTION_MATRIX_UNIFORM,
+	NORMAL_MATRIX_UNIFORM,
+	NORMAL_WORLD_MATRIX_UNIFORM,
+	INDIRECT_DRAW_UNIFORM,
+	OBJECT_INDEX_UNIFORM,
+	BONE_TRANSFORMS_UNIFORM,
+	MATERIAL_INDEX_UNIFORM,
+	MATERIAL_DIFFUSE_UNIFORM,
+	MATERIAL_SPECULAR_UNIFORM,
+	MATERIAL_SHININESS_UNIFORM,
+	DIFFUSE_MAP_UNIFORM,
+	SPECULAR_MAP_UNIFORM,
+	NORMAL_MAP_UNIFORM,
+	ALPHA_MAP_UNIFORM,
+	PIPELINE_UNIFORMS_COUNT
+};
+
+static const std::string PIPELINE_UNIFORMS_NAMES [PIPELINE_UNIFORMS_COUNT] = {
+	"modelMatrix",
+	"modelViewMatrix",
+	"modelViewProjectionMatrix",
+	"normalMatrix",
+	"normalWorldMatrix",
+	"indirectDraw",
+	"objectIndex",
+	"boneTransforms",
+	"materialIndex",
+	"MaterialDiffuse",
+	"MaterialSpecular",
+	"MaterialShininess",
+	"DiffuseMap",
+	"SpecularMap",
+	"NormalMap",
+	"AlphaMap"
+};
+
+static int GetUniformLocation (Shader* shader, PipelineUniform uniform)
+{
+	return shader->GetUniformLocation ((std::size_t) uniform, PIPELINE_UNIFORMS_NAMES [uniform]);
+}
 
 void Pipeline::SetShader (Shader* shader)
 {
@@ -32,7 +99,10 @@ void Pipeline::SetShader (Shader* shader)
 
 	_textureCount = 0;
 
-	GL::UseProgram (shader->GetProgram ());
+	if (shader->GetProgram () != _currentProgram) {
+		GL::UseProgram (shader->GetProgram ());
+		_currentProgram = shader->GetProgram ();
+	}
 }
 
 void Pipeline::LockShader (Shader* shader)
@@ -57,65 +127,230 @@ void Pipeline::CreateProjection (Camera* camera)
 
 void Pipeline::CreateProjection (glm::mat4 projectionMatrix)
 {
+	if (projectionMatrix == _projectionMatrix) {
+		return;
+	}
+
 	_projectionMatrix = projectionMatrix;
+
+	_isViewDirty = true;
+	_isObjectDirty = true;
 }
 
 void Pipeline::SendCamera (Camera* camera)
 {
-	_cameraPosition = camera->GetPosition ();
-	_viewMatrix = glm::mat4_cast (camera->GetRotation ());
+	glm::vec3 cameraPosition = camera->GetPosition ();
+	glm::mat4 viewMatrix = glm::mat4_cast (camera->GetRotation ());
 
-	_viewMatrix =  glm::translate (_viewMatrix, _cameraPosition * -1.0f);
+	viewMatrix = glm::translate (viewMatrix, cameraPosition * -1.0f);
+
+	if (viewMatrix == _viewMatrix && cameraPosition == _cameraPosition) {
+		return;
+	}
+
+	_cameraPosition = cameraPosition;
+	_viewMatrix = viewMatrix;
+
+	_isViewDirty = true;
+	_isObjectDirty = true;
 }
 
 void Pipeline::SetObjectTransform (Transform* transform)
 {
-	glm::vec3 position = transform->GetPosition ();
-	glm::vec3 scalev = transform->GetScale ();
-	glm::quat rotationq = transform->GetRotation ();
+	glm::mat4 modelMatrix = transform->GetModelMatrix ();
+
+	if (modelMatrix == _modelMatrix) {
+		return;
+	}
+
+	_modelMatrix = modelMatrix;
 
-	glm::mat4 translate = glm::translate (glm::mat4 (1.f), glm::vec3 (position.x, position.y, position.z));
-	glm::mat4 scale = glm::scale (glm::mat4 (1.f), glm::vec3 (scalev.x, scalev.y, scalev.z));
+	_isObjectDirty = true;
+	_isObjectDataDirty = true;
+}
 
-	glm::mat4 rotation = glm::mat4_cast(rotationq);
+/*
+ * While on, the shaders read the object matrices of a draw from the
+ * storage buffer of the multi draw instead of the uniforms
+*/
 
-	_modelMatrix = translate * scale * rotation;
+void Pipeline::SetIndirectDraw (bool isIndirectDraw)
+{
+	_isIndirectDraw = isIndirectDraw;
 }
 
 void Pipeline::ClearObjectTransform ()
 {
+	if (_modelMatrix == glm::mat4 (1.0)) {
+		return;
+	}
+
 	_modelMatrix = glm::mat4 (1.0);
+
+	_isObjectDirty = true;
+	_isObjectDataDirty = true;
 }
 
+/*
+ * Matrices of the view are uploaded once per view change in the uniform
+ * buffer. Those of the object are written once per object change: to
+ * the object block for the programs that declare it, which then get only
+ * the index of the entry, otherwise to the uniforms the program uses.
+*/
+
 void Pipeline::UpdateMatrices (Shader* shader)
 {
 	if (_lockedShader != nullptr) {
 		shader = _lockedShader;
 	}
 
-	glm::mat4 modelViewMatrix = _viewMatrix * _modelMatrix;
-	glm::mat4 viewProjectionMatrix = _projectionMatrix * _viewMatrix;
-	glm::mat4 modelViewProjectionMatrix = _projectionMatrix * _viewMatrix * _modelMatrix;
+	UpdateViewUniformBuffer ();
+	UpdateObjectMatrices ();
+
+	int objectIndexLocation = GetUniformLocation (shader, OBJECT_INDEX_UNIFORM);
 
-	glm::mat3 normalWorldMatrix = glm::transpose (glm::inverse (glm::mat3 (modelViewMatrix)));
-	glm::mat3 normalMatrix = glm::transpose (glm::inverse (glm::mat3 (_modelMatrix)));
+	if (objectIndexLocation != -1) {
+		if (!_isIndirectDraw) {
+			UpdateObjectData ();
 
-	glm::mat4 inverseViewProjectionMatrix = glm::inverse (modelViewProjectionMatrix);
+			shader->SetUniform (objectIndexLocation, _objectIndex);
+		}
+	} else {
+		shader->SetUniform (GetUniformLocation (shader, MODEL_MATRIX_UNIFORM), _modelMatrix);
+		shader->SetUniform (GetUniformLocation (shader, MODEL_VIEW_MATRIX_UNIFORM), _modelViewMatrix);
+		shader->SetUniform (GetUniformLocation (shader, MODEL_VIEW_PROJECTION_MATRIX_UNIFORM), _modelViewProjectionMatrix);
+		shader->SetUniform (GetUniformLocation (shader, NORMAL_MATRIX_UNIFORM), _normalMatrix);
+		shader->SetUniform (GetUniformLocation (shader, NORMAL_WORLD_MATRIX_UNIFORM), _normalWorldMatrix);
+	}
 
-	GL::UniformMatrix4fv (shader->GetUniformLocation ("modelMatrix"), 1, GL_FALSE, glm::value_ptr (_modelMatrix));
-	GL::UniformMatrix4fv (shader->GetUniformLocation ("viewMatrix"), 1, GL_FALSE, glm::value_ptr (_viewMatrix));
-	GL::UniformMatrix4fv (shader->GetUniformLocation ("modelViewMatrix"), 1, GL_FALSE, glm::value_ptr (modelViewMatrix));
-	GL::UniformMatrix4fv (shader->GetUniformLocation ("projectionMatrix"), 1, GL_FALSE, glm::value_ptr (_projectionMatrix));
-	GL::UniformMatrix4fv (shader->GetUniformLocation ("viewProjectionMatrix"), 1, GL_FALSE, glm::value_ptr (viewProjectionMatrix));
-	GL::UniformMatrix4fv (shader->GetUniformLocation ("modelViewProjectionMatrix"), 1, GL_FALSE, glm::value_ptr (modelViewProjectionMatrix));
-	GL::UniformMatrix3fv (shader->GetUniformLocation ("normalMatrix"), 1, GL_FALSE, glm::value_ptr (normalMatrix));
-	GL::UniformMatrix3fv (shader->GetUniformLocation ("normalWorldMatrix"), 1, GL_FALSE, glm::value_ptr (normalWorldMatrix));
-	GL::UniformMatrix4fv (shader->GetUniformLocation ("inverseViewProjectionMatrix"), 1, GL_FALSE, glm::value_ptr (inverseViewProjectionMatrix));
-	GL::Uniform3fv (shader->GetUniformLocation ("cameraPosition"), 1, glm::value_ptr (_cameraPosition));
+	shader->SetUniform (GetUniformLocation (shader, INDIRECT_DRAW_UNIFORM), (int) _isIndirectDraw);
 
 	// SendLights (shader);
 }
 
+void Pipeline::UpdateViewUniformBuffer ()
+{
+	if (_viewUniformBuffer == 0) {
+		GL::GenBuffers (1, &_viewUniformBuffer);
+
+		GL::BindBuffer (GL_UNIFORM_BUFFER, _viewUniformBuffer);
+		GL::BufferData (GL_UNIFORM_BUFFER, sizeof (ViewUniformBlock), nullptr, GL_DYNAMIC_DRAW);
+		GL::BindBufferBase (GL_UNIFORM_BUFFER, SHADER_VIEW_UNIFORM_BLOCK_BINDING, _viewUniformBuffer);
+
+		_isViewDirty = true;
+	}
+
+	if (!_isViewDirty) {
+		return;
+	}
+
+	ViewUniformBlock viewBlock;
+
+	viewBlock.viewMatrix = _viewMatrix;
+	viewBlock.projectionMatrix = _projectionMatrix;
+	viewBlock.viewProjectionMatrix = _projectionMatrix * _viewMatrix;
+	viewBlock.inverseViewProjectionMatrix = glm::inverse (viewBlock.viewProjectionMatrix);
+	viewBlock.cameraPosition = glm::vec4 (_cameraPosition, 1.0f);
+
+	GL::BindBuffer (GL_UNIFORM_BUFFER, _viewUniformBuffer);
+	GL::BufferSubData (GL_UNIFORM_BUFFER, 0, sizeof (ViewUniformBlock), &viewBlock);
+
+	_isViewDirty = false;
+}
+
+void Pipeline::UpdateObjectMatrices ()
+{
+	if (!_isObjectDirty) {
+		return;
+	}
+
+	_modelViewMatrix = _viewMatrix * _modelMatrix;
+	_modelViewProjectionMatrix = _projectionMatrix * _modelViewMatrix;
+
+	_normalWorldMatrix = glm::transpose (glm::inverse (glm::mat3 (_modelViewMatrix)));
+	_normalMatrix = glm::transpose (glm::inverse (glm::mat3 (_modelMatrix)));
+
+	_isObjectDirty = false;
+}
+
+/*
+ * The entry of the object goes to the region of the streaming buffer of
+ * the current frame, the region is bound as the object block once per
+ * frame. An object that did not change is written again only in a new
+ * frame, the entry of the last frame may be overwritten by then.
+*/
+
+void Pipeline::UpdateObjectData ()
+{
+	StreamingBuffer* streamingBuffer = StreamingBuffer::Instance ();
+
+	std::size_t frame = streamingBuffer->GetFramesCount ();
+
+	if (!_isObjectDataDirty && frame == _objectDataFrame) {
+		return;
+	}
+
+	StreamingAllocation allocation = streamingBuffer->Allocate (sizeof (IndirectDrawData), sizeof (IndirectDrawData));
+
+	if (allocation.data == nullptr) {
+		return;
+	}
+
+	IndirectDrawData* objectData = (IndirectDrawData*) allocation.data;
+
+	objectData->modelMatrix = _modelMatrix;
+	objectData->normalMatrix = glm::mat4 (_normalMatrix);
+
+	streamingBuffer->Commit (allocation);
+
+	std::size_t regionOffset = streamingBuffer->GetRegionOffset ();
+
+	if (frame != _objectDataFrame) {
+		GL::BindBufferRange (GL_SHADER_STORAGE_BUFFER, PIPELINE_OBJECT_DATA_BINDING,
+			streamingBuffer->GetBuffer (), regionOffset, STREAMING_BUFFER_REGION_SIZE);
+	}
+
+	_objectIndex = (int) ((allocation.offset - regionOffset) / sizeof (IndirectDrawData));
+	_objectDataFrame = frame;
+
+	_isObjectDataDirty = false;
+}
+
+/*
+ * The materials are copied to the block when they are loaded, drawing
+ * sends only the index of the material. The block is uploaded again only
+ * after new materials were added.
+*/
+
+void Pipeline::UpdateMaterialsBuffer ()
+{
+	MaterialManager& materialManager = MaterialManager::Instance ();
+
+	if (_materialsBuffer != 0 && materialManager.GetChangesCount () == _materialsChangesCount) {
+		return;
+	}
+
+	if (_materialsBuffer == 0) {
+		GL::GenBuffers (1, &_materialsBuffer);
+	}
+
+	_materialsChangesCount = materialManager.GetChangesCount ();
+
+	std::vector<MaterialBlockData> materialsData (materialManager.GetMaterialsCount ());
+
+	for (std::size_t materialID = 0; materialID < materialsData.size (); materialID++) {
+		Material* material = materialManager.GetMaterial (materialID);
+
+		materialsData [materialID].diffuseColor = glm::vec4 (material->diffuseColor, 1.0f);
+		materialsData [materialID].specularColor = glm::vec4 (material->specularColor, material->shininess);
+	}
+
+	GL::BindBuffer (GL_SHADER_STORAGE_BUFFER, _materialsBuffer);
+	GL::BufferData (GL_SHADER_STORAGE_BUFFER, sizeof (MaterialBlockData) * materialsData.size (),
+		materialsData.data (), GL_STATIC_DRAW);
+	GL::BindBufferBase (GL_SHADER_STORAGE_BUFFER, PIPELINE_MATERIALS_BINDING, _materialsBuffer);
+}
+
 void Pipeline::SendLights (Shader* shader)
 {
 	if (_lockedShader != nullptr) {
@@ -125,7 +360,7 @@ void Pipeline::SendLights (Shader* shader)
 	glm::vec3 vec = LightsManager::Instance ()->GetAmbientColorLight ();
 	Color color;
 
-	GL::Uniform3f(shader->GetUniformLocation ("sceneAmbient"), vec.x, vec.y, vec.z);
+	shader->SetUniform (shader->GetUniformLocation ("sceneAmbient"), vec);
 
 	// const int lightsLimit = 3;
 
@@ -248,59 +483,68 @@ void Pipeline::SendCustomAttributes (const std::string& shaderName, const std::v
 
 	for (std::size_t i=0;i<attr.size ();i++) {
 
-		int unifLoc = shader->GetUniformLocation (attr [i].name.c_str ());
+		int unifLoc = shader->GetUniformLocation (attr [i].name);
 
 		switch (attr [i].type) {
 			case PipelineAttribute::ATTR_1I :
-				GL::Uniform1i (unifLoc, (int) attr [i].value.x);
+				shader->SetUniform (unifLoc, (int) attr [i].value.x);
 				break;
 			case PipelineAttribute::ATTR_2I :
-				GL::Uniform2i (unifLoc, (int) attr [i].value.x,
-					(int) attr [i].value.y);
+				shader->SetUniform (unifLoc, glm::ivec2 (attr [i].value));
 				break;
 			case PipelineAttribute::ATTR_3I :
-				GL::Uniform3i (unifLoc, (int) attr [i].value.x,
-					(int) attr [i].value.y, (int) attr [i].value.z);
+				shader->SetUniform (unifLoc, glm::ivec3 (attr [i].value));
 				break;
 			case PipelineAttribute::ATTR_1F :
-				GL::Uniform1f (unifLoc, attr [i].value.x);
+				shader->SetUniform (unifLoc, attr [i].value.x);
 				break;
 			case PipelineAttribute::ATTR_2F :
-				GL::Uniform2f (unifLoc, attr [i].value.x,
-					attr [i].value.y);
+				shader->SetUniform (unifLoc, glm::vec2 (attr [i].value));
 				break;
 			case PipelineAttribute::ATTR_3F :
-				GL::Uniform3f (unifLoc, attr [i].value.x,
-					attr [i].value.y, attr [i].value.z);
+				shader->SetUniform (unifLoc, attr [i].value);
 				break;
 			case PipelineAttribute::ATTR_TEXTURE_2D :	{
 					GL::ActiveTexture (GL_TEXTURE0 + _textureCount);
 					GL::BindTexture (GL_TEXTURE_2D, (unsigned int) attr [i].value.x);
-					GL::Uniform1i (unifLoc, _textureCount);
+					shader->SetUniform (unifLoc, (int) _textureCount);
 					++ _textureCount;
 				}
 				break;
 			case PipelineAttribute::ATTR_TEXTURE_3D : {
 					GL::ActiveTexture (GL_TEXTURE0 + _textureCount);
 					GL::BindTexture (GL_TEXTURE_3D, (unsigned int) attr [i].value.x);
-					GL::Uniform1i (unifLoc, _textureCount);
+					shader->SetUniform (unifLoc, (int) _textureCount);
 					++ _textureCount;
 				}
 				break;
 			case PipelineAttribute::ATTR_TEXTURE_CUBE : {
 					GL::ActiveTexture (GL_TEXTURE0 + _textureCount);
 					GL::BindTexture (GL_TEXTURE_CUBE_MAP, (unsigned int) attr [i].value.x);
-					GL::Uniform1i (unifLoc, _textureCount);
+					shader->SetUniform (unifLoc, (int) _textureCount);
 					++ _textureCount;
 				}
 				break;
 			case PipelineAttribute::ATTR_MATRIX_4X4F :
-					GL::UniformMatrix4fv (unifLoc, 1, GL_FALSE, glm::value_ptr (attr [i].matrix));
+					shader->SetUniform (unifLoc, attr [i].matrix);
 				break;
 		}
 	}
 }
 
+/*
+ * The whole palette of the skeleton is sent as one array
+*/
+
+void Pipeline::SendBonesTransforms (const std::vector<glm::mat4>& bonesTransforms, Shader* shader)
+{
+	if (_lockedShader != nullptr) {
+		shader = _lockedShader;
+	}
+
+	shader->SetUniform (GetUniformLocation (shader, BONE_TRANSFORMS_UNIFORM), bonesTransforms);
+}
+
 void Pipeline::SendMaterial(Material* mat, Shader* shader)
 {
 	if (shader == nullptr) {
@@ -322,14 +566,23 @@ void Pipeline::SendMaterial(Material* mat, Shader* shader)
 	Pipeline::UpdateMatrices (shader);
 
 	/*
-	 * Send basic material attributes to shader
+	 * Send basic material attributes to shader, as the index of the
+	 * material for the programs that read the material block
 	*/
 
-	GL::Uniform3fv (shader->GetUniformLocation ("MaterialDiffuse"), 1, glm::value_ptr (mat->diffuseColor));
-	// GL::Uniform3fv (shader->GetUniformLocation ("MaterialAmbient"), 1, glm::value_ptr (mat->ambientColor));
-	GL::Uniform3fv (shader->GetUniformLocation ("MaterialSpecular"), 1, glm::value_ptr (mat->specularColor));
-	GL::Uniform1f (shader->GetUniformLocation ("MaterialShininess"), mat->shininess);
-	// glUniform1f (shader->GetUniformLocation ("MaterialTransparency"), mat->transparency);
+	int materialIndexLocation = GetUniformLocation (shader, MATERIAL_INDEX_UNIFORM);
+
+	if (materialIndexLocation != -1) {
+		UpdateMaterialsBuffer ();
+
+		shader->SetUniform (materialIndexLocation, (int) mat->id);
+	} else {
+		shader->SetUniform (GetUniformLocation (shader, MATERIAL_DIFFUSE_UNIFORM), mat->diffuseColor);
+		// GL::Uniform3fv (shader->GetUniformLocation ("MaterialAmbient"), 1, glm::value_ptr (mat->ambientColor));
+		shader->SetUniform (GetUniformLocation (shader, MATERIAL_SPECULAR_UNIFORM), mat->specularColor);
+		shader->SetUniform (GetUniformLocation (shader, MATERIAL_SHININESS_UNIFORM), mat->shininess);
+		// glUniform1f (shader->GetUniformLocation ("MaterialTransparency"), mat->transparency);
+	}
 
 	/*
 	 * Send maps to shader
@@ -351,37 +604,37 @@ void Pipeline::SendMaterial(Material* mat, Shader* shader)
 	if (mat->diffuseTexture) {
 		GL::ActiveTexture (GL_TEXTURE0+_textureCount);
 		GL::BindTexture (GL_TEXTURE_2D, mat->diffuseTexture);
-		GL::Uniform1i (shader->GetUniformLocation ("DiffuseMap"), _textureCount);
+		shader->SetUniform (GetUniformLocation (shader, DIFFUSE_MAP_UNIFORM), (int) _textureCount);
 		++ _textureCount;
 	} else {
-		GL::Uniform1i (shader->GetUniformLocation ("DiffuseMap"), 0);
+		shader->SetUniform (GetUniformLocation (shader, DIFFUSE_MAP_UNIFORM), 0);
 	}
 
 	if (mat->specularTexture) {
 		GL::ActiveTexture (GL_TEXTURE0 + _textureCount);
 		GL::BindTexture (GL_TEXTURE_2D, mat->specularTexture);
-		GL::Uniform1i (shader->GetUniformLocation ("SpecularMap"), _textureCount);
+		shader->SetUniform (GetUniformLocation (shader, SPECULAR_MAP_UNIFORM), (int) _textureCount);
 		++ _textureCount;
 	} else {
-		GL::Uniform1i (shader->GetUniformLocation ("SpecularMap"), 0);
+		shader->SetUniform (GetUniformLocation (shader, SPECULAR_MAP_UNIFORM), 0);
 	}
 
 	if (mat->bumpTexture) {
 		GL::ActiveTexture (GL_TEXTURE0 + _textureCount);
 		GL::BindTexture (GL_TEXTURE_2D, mat->bumpTexture);
-		GL::Uniform1i (shader->GetUniformLocation ("NormalMap"), _textureCount);
+		shader->SetUniform (GetUniformLocation (shader, NORMAL_MAP_UNIFORM), (int) _textureCount);
 		++ _textureCount;
 	} else {
-		GL::Uniform1i (shader->GetUniformLocation ("NormalMap"), 0);
+		shader->SetUniform (GetUniformLocation (shader, NORMAL_MAP_UNIFORM), 0);
 	}
 
 	 if (mat->alphaTexture) {
 	 	GL::ActiveTexture (GL_TEXTURE0 + _textureCount);
 	 	GL::BindTexture (GL_TEXTURE_2D, mat->alphaTexture);
-	 	GL::Uniform1i (shader->GetUniformLocation ("AlphaMap"), _textureCount);
+	 	shader->SetUniform (GetUniformLocation (shader, ALPHA_MAP_UNIFORM), (int) _textureCount);
 	 	++ _textureCount;
 	 } else {
-	 	GL::Uniform1i (shader->GetUniformLocation ("AlphaMap"), 0);
+	 	shader->SetUniform (GetUniformLocation (shader, ALPHA_MAP_UNIFORM), 0);
 	 }
 
 	/*
@@ -396,7 +649,7 @@ void Pipeline::SendMaterial(Material* mat, Shader* shader)
 			Texture* tex = TextureManager::Instance ()->GetTexture (mat->attributes [k].valueName);
 			unsigned int textureID = tex->GetGPUIndex ();
 			GL::BindTexture (GL_TEXTURE_2D, textureID);
-			GL::Uniform1i (shader->GetUniformLocation (mat->attributes [k].name.c_str ()), _textureCount);
+			shader->SetUniform (shader->GetUniformLocation (mat->attributes [k].name), (int) _textureCount);
 
 			++ _textureCount;
 		}
@@ -412,18 +665,17 @@ void Pipeline::SendMaterial(Material* mat, Shader* shader)
 			}
 
 			GL::BindTexture (GL_TEXTURE_CUBE_MAP, textureID);
-			GL::Uniform1i (shader->GetUniformLocation (mat->attributes [k].name.c_str ()), _textureCount);
+			shader->SetUniform (shader->GetUniformLocation (mat->attributes [k].name), (int) _textureCount);
 
 			++ _textureCount;
 		}
 		else if (mat->attributes [k].type == Attribute::AttrType::ATTR_FLOAT) {
 			float value = mat->attributes [k].values.x;
-			GL::Uniform1f (shader->GetUniformLocation (mat->attributes [k].name.c_str ()), value);
+			shader->SetUniform (shader->GetUniformLocation (mat->attributes [k].name), value);
 		}
 		else if (mat->attributes [k].type == Attribute::AttrType::ATTR_VEC3) {
 			glm::vec3 values = mat->attributes [k].values;
-			GL::Uniform3f (shader->GetUniformLocation (mat->attributes [k].name.c_str ()), 
-				values.x, values.y, values.z);
+			shader->SetUniform (shader->GetUniformLocation (mat->attributes [k].name), values);
 		}
 	}
 }
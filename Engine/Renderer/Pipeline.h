@@ -11,6 +11,39 @@
 
 #include "Shader/Shader.h"
 
+/*
+ * Bindings of the storage buffers kept by the pipeline. The object block
+ * holds the matrices of the draws outside of a multi draw, the material
+ * block one entry per material identifier.
+*/
+
+#define PIPELINE_OBJECT_DATA_BINDING 1
+#define PIPELINE_MATERIALS_BINDING 2
+
+/*
+ * Mirror of the std140 view uniform block of the shaders
+*/
+
+struct ViewUniformBlock
+{
+	glm::mat4 viewMatrix;
+	glm::mat4 projectionMatrix;
+	glm::mat4 viewProjectionMatrix;
+	glm::mat4 inverseViewProjectionMatrix;
+	glm::vec4 cameraPosition;
+};
+
+/*
+ * Mirror of the std430 material entry of the shaders, the shininess is
+ * the last component of the specular color
+*/
+
+struct MaterialBlockData
+{
+	glm::vec4 diffuseColor;
+	glm::vec4 specularColor;
+};
+
 // TODO: Refactor this
 
 class Pipeline
@@ -22,9 +55,27 @@ private:
 
 	static glm::vec3 _cameraPosition;
 
+	static glm::mat4 _modelViewMatrix;
+	static glm::mat4 _modelViewProjectionMatrix;
+	static glm::mat3 _normalMatrix;
+	static glm::mat3 _normalWorldMatrix;
+
+	static bool _isViewDirty;
+	static bool _isObjectDirty;
+	static bool _isIndirectDraw;
+	static unsigned int _viewUniformBuffer;
+
+	static bool _isObjectDataDirty;
+	static std::size_t _objectDataFrame;
+	static int _objectIndex;
+
+	static unsigned int _materialsBuffer;
+	static std::size_t _materialsChangesCount;
+
 	static std::size_t _textureCount;
 
 	static Shader* _lockedShader;
+	static unsigned int _currentProgram;
 
 public:
 	static void SetShader (Shader* shader);
@@ -36,16 +87,23 @@ public:
 	static void CreateProjection (glm::mat4 projectionMatrix);
 
 	static void SetObjectTransform (Transform *transform);
+	static void SetIndirectDraw (bool isIndirectDraw);
 	static void SendCamera (Camera* camera);
 
 	static void UpdateMatrices (Shader* shader);
 	static void SendLights (Shader* shader);
 	static void SendMaterial (Material* material, Shader* shader = nullptr);
+	static void SendBonesTransforms (const std::vector<glm::mat4>& bonesTransforms, Shader* shader);
 	// TODO: Reimplement this
 	static void SendCustomAttributes (const std::string& shadername, 
 		const std::vector<PipelineAttribute>& attrs);
 
 	static void ClearObjectTransform ();
+private:
+	static void UpdateViewUniformBuffer ();
+	static void UpdateObjectMatrices ();
+	static void UpdateObjectData ();
+	static void UpdateMaterialsBuffer ();
 };
 
 #endif
\ No newline at end of file
@@ -1,5 +1,15 @@
 #include "RenderModule.h"
 
+#include <typeinfo>
+#include <algorithm>
+
+#ifdef __GNUG__
+	#include <cxxabi.h>
+	#include <cstdlib>
+#endif
+
+#include "GPUTimers.h"
+
 RenderModule::~RenderModule ()
 {
 	/*
@@ -26,6 +36,31 @@ void RenderModule::InitModule ()
 	for (RenderPassI* renderPass : _renderPasses) {
 		renderPass->Init ();
 	}
+
+	/*
+	 * Every render pass is timed on the GPU, passes of the same type are
+	 * told apart by their order
+	*/
+
+	std::string moduleName = GetTypeName (this);
+
+	std::vector<std::string> passesNames;
+
+	for (RenderPassI* renderPass : _renderPasses) {
+		passesNames.push_back (GetTypeName (renderPass));
+	}
+
+	for (std::size_t index = 0; index < _renderPasses.size (); index++) {
+		std::string passName = passesNames [index];
+
+		std::size_t passesCount = std::count (passesNames.begin (), passesNames.end (), passName);
+
+		if (passesCount > 1) {
+			passName += " #" + std::to_string (std::count (passesNames.begin (), passesNames.begin () + index, passName));
+		}
+
+		_renderPassesTimers.push_back (GPUTimers::Instance ()->AddTimer (moduleName + "/" + passName));
+	}
 }
 
 void RenderModule::RenderScene (Scene* scene, Camera* camera)
@@ -40,7 +75,38 @@ void RenderModule::RenderScene (Scene* scene, Camera* camera)
 	 * Iterate on every pass on associated order to draw scene
 	*/
 
-	for (RenderPassI* renderPass : _renderPasses) {
-		rvc = renderPass->Execute (scene, camera, rvc);
+	for (std::size_t index = 0; index < _renderPasses.size (); index++) {
+		GPUTimers::Instance ()->Begin (_renderPassesTimers [index]);
+
+		rvc = _renderPasses [index]->Execute (scene, camera, rvc);
+
+		GPUTimers::Instance ()->End (_renderPassesTimers [index]);
 	}
 }
+
+/*
+ * Class name of the object without the decoration of the compiler
+*/
+
+std::string RenderModule::GetTypeName (Object* object)
+{
+	std::string name = typeid (*object).name ();
+
+#ifdef __GNUG__
+	int status = 0;
+
+	char* demangledName = abi::__cxa_demangle (name.c_str (), nullptr, nullptr, &status);
+
+	if (status == 0 && demangledName != nullptr) {
+		name = demangledName;
+	}
+
+	std::free (demangledName);
+#else
+	if (name.compare (0, 6, "class ") == 0) {
+		name = name.substr (6);
+	}
+#endif
+
+	return name;
+}
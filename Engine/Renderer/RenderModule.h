@@ -14,6 +14,7 @@ class RenderModule : public Object
 {
 protected:
 	std::vector<RenderPassI*> _renderPasses;
+	std::vector<std::size_t> _renderPassesTimers;
 
 public:
 	virtual ~RenderModule ();
@@ -22,6 +23,8 @@ public:
 	virtual void RenderScene (Scene*, Camera*);
 protected:
 	virtual void Init () = 0;
+
+	static std::string GetTypeName (Object* object);
 };
 
 #endif
\ No newline at end of file
@@ -7,6 +7,13 @@ RenderVolumeCollection* RenderVolumeCollection::Insert (const std::string& name,
 	return this;
 }
 
+RenderVolumeCollection* RenderVolumeCollection::Remove (const std::string& name)
+{
+	_renderVolumes.erase (name);
+
+	return this;
+}
+
 RenderVolumeI* RenderVolumeCollection::GetRenderVolume (const std::string& name)
 {
 	auto it = _renderVolumes.find (name);
@@ -17,6 +17,7 @@ protected:
 
 public:
 	RenderVolumeCollection* Insert (const std::string& name, RenderVolumeI* volume);
+	RenderVolumeCollection* Remove (const std::string& name);
 	RenderVolumeI* GetRenderVolume (const std::string& name);
 
 	RenderVolumeCollectionIterator begin ();
@@ -1,5 +1,7 @@
 #include "Renderer.h"
 
+#include "DrawList.h"
+
 Renderer::Renderer() :
 	_stage (DEFERRED_STAGE),
 	_priority (0),
@@ -50,4 +52,29 @@ void Renderer::Draw ()
 {
 	// Do nothing
 	// It is supposed to inherit the class and implement this function
+}
+
+/*
+ * Renderers that only know how to draw themselves are added as a single
+ * packet, submitted through Draw ()
+*/
+
+void Renderer::Collect (DrawList* drawList)
+{
+	drawList->AddRenderer (this);
+}
+
+/*
+ * Only renderers with all their geometry in a static geometry arena can
+ * be drawn by a multi draw, the others add nothing
+*/
+
+void Renderer::CollectIndirect (IndirectDrawCommandBuilder* builder, bool isMaterialBatched)
+{
+
+}
+
+bool Renderer::IsStaticGeometry () const
+{
+	return false;
 }
\ No newline at end of file
@@ -3,6 +3,9 @@
 
 #include "SceneGraph/Transform.h"
 
+class DrawList;
+class IndirectDrawCommandBuilder;
+
 class Renderer
 {
 public:
@@ -18,6 +21,10 @@ public:
 	virtual ~Renderer ();
 
 	virtual void Draw ();
+	virtual void Collect (DrawList* drawList);
+	virtual void CollectIndirect (IndirectDrawCommandBuilder* builder, bool isMaterialBatched);
+
+	virtual bool IsStaticGeometry () const;
 
 	StageType GetStageType () const;
 	void SetStageType (StageType stageType);
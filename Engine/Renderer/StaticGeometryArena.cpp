@@ -0,0 +1,199 @@
+#include "StaticGeometryArena.h"
+
+#include <algorithm>
+
+#include "Wrappers/OpenGL/GL.h"
+
+#include "Core/Console/Console.h"
+
+std::vector<StaticGeometryArena*> StaticGeometryArena::_arenas;
+
+StaticGeometryRange::StaticGeometryRange () :
+	firstVertex (0),
+	verticesCount (0),
+	firstIndex (0),
+	indicesCount (0)
+{
+
+}
+
+StaticGeometryArena::StaticGeometryArena (std::size_t vertexStride, const std::vector<StaticGeometryAttribute>& attributes) :
+	_index (_arenas.size ()),
+	_vertexStride (vertexStride),
+	_attributes (attributes),
+	_verticesAllocator (STATIC_GEOMETRY_ARENA_VERTICES),
+	_indicesAllocator (STATIC_GEOMETRY_ARENA_INDICES),
+	_VAO (0),
+	_VBO (0),
+	_IBO (0),
+	_drawIDBuffer (0),
+	_drawIDsCount (0)
+{
+	_arenas.push_back (this);
+}
+
+StaticGeometryArena::~StaticGeometryArena ()
+{
+	_arenas [_index] = nullptr;
+
+	if (_VAO == 0) {
+		return;
+	}
+
+	GL::DeleteBuffers (1, &_VBO);
+	GL::DeleteBuffers (1, &_IBO);
+	GL::DeleteBuffers (1, &_drawIDBuffer);
+	GL::DeleteVertexArrays (1, &_VAO);
+}
+
+/*
+ * Returns false if the arena has no room left for the mesh, the caller
+ * keeps it in buffers of its own
+*/
+
+bool StaticGeometryArena::Allocate (const void* vertices, std::size_t verticesCount,
+	const std::vector<unsigned int>& indices, StaticGeometryRange& range)
+{
+	std::size_t firstVertex = _verticesAllocator.Allocate (verticesCount);
+
+	if (firstVertex == ARENA_ALLOCATOR_INVALID_OFFSET) {
+		Console::LogWarning ("Static geometry arena is out of vertices. The mesh will be drawn on its own.");
+
+		return false;
+	}
+
+	std::size_t firstIndex = _indicesAllocator.Allocate (indices.size ());
+
+	if (firstIndex == ARENA_ALLOCATOR_INVALID_OFFSET) {
+		_verticesAllocator.Free (firstVertex);
+
+		Console::LogWarning ("Static geometry arena is out of indices. The mesh will be drawn on its own.");
+
+		return false;
+	}
+
+	/*
+	 * The index buffer is part of the vertex array state, it is bound
+	 * through it
+	*/
+
+	Create ();
+
+	GL::BindVertexArray (_VAO);
+
+	GL::BindBuffer (GL_ARRAY_BUFFER, _VBO);
+	GL::BufferSubData (GL_ARRAY_BUFFER, firstVertex * _vertexStride, verticesCount * _vertexStride, vertices);
+
+	GL::BindBuffer (GL_ELEMENT_ARRAY_BUFFER, _IBO);
+	GL::BufferSubData (GL_ELEMENT_ARRAY_BUFFER, firstIndex * sizeof (unsigned int),
+		indices.size () * sizeof (unsigned int), indices.data ());
+
+	range.firstVertex = firstVertex;
+	range.verticesCount = verticesCount;
+	range.firstIndex = firstIndex;
+	range.indicesCount = indices.size ();
+
+	return true;
+}
+
+void StaticGeometryArena::Free (const StaticGeometryRange& range)
+{
+	_verticesAllocator.Free (range.firstVertex);
+	_indicesAllocator.Free (range.firstIndex);
+}
+
+/*
+ * Binds the vertex array, with a draw ID for at least as many draws.
+ * The draw IDs are the numbers in order, a command reads the one at its
+ * base instance.
+*/
+
+void StaticGeometryArena::Bind (std::size_t drawsCount)
+{
+	Create ();
+
+	GL::BindVertexArray (_VAO);
+
+	if (drawsCount <= _drawIDsCount) {
+		return;
+	}
+
+	std::size_t drawIDsCount = std::max (_drawIDsCount, (std::size_t) 1024);
+
+	while (drawIDsCount < drawsCount) {
+		drawIDsCount *= 2;
+	}
+
+	std::vector<unsigned int> drawIDs (drawIDsCount);
+
+	for (std::size_t index = 0; index < drawIDsCount; index++) {
+		drawIDs [index] = (unsigned int) index;
+	}
+
+	GL::BindBuffer (GL_ARRAY_BUFFER, _drawIDBuffer);
+	GL::BufferData (GL_ARRAY_BUFFER, sizeof (unsigned int) * drawIDsCount, drawIDs.data (), GL_STATIC_DRAW);
+
+	_drawIDsCount = drawIDsCount;
+}
+
+std::size_t StaticGeometryArena::GetIndex () const
+{
+	return _index;
+}
+
+std::size_t StaticGeometryArena::GetVertexStride () const
+{
+	return _vertexStride;
+}
+
+unsigned int StaticGeometryArena::GetVertexArray () const
+{
+	return _VAO;
+}
+
+StaticGeometryArena* StaticGeometryArena::GetArena (std::size_t index)
+{
+	if (index >= _arenas.size ()) {
+		return nullptr;
+	}
+
+	return _arenas [index];
+}
+
+std::size_t StaticGeometryArena::GetArenasCount ()
+{
+	return _arenas.size ();
+}
+
+void StaticGeometryArena::Create ()
+{
+	if (_VAO != 0) {
+		return;
+	}
+
+	GL::GenVertexArrays (1, &_VAO);
+	GL::BindVertexArray (_VAO);
+
+	GL::GenBuffers (1, &_VBO);
+	GL::BindBuffer (GL_ARRAY_BUFFER, _VBO);
+	GL::BufferData (GL_ARRAY_BUFFER, _vertexStride * _verticesAllocator.GetCapacity (), nullptr, GL_STATIC_DRAW);
+
+	for (const StaticGeometryAttribute& attribute : _attributes) {
+		GL::EnableVertexAttribArray (attribute.index);
+		GL::VertexAttribPointer (attribute.index, attribute.size, GL_FLOAT, GL_FALSE,
+			_vertexStride, (void*) attribute.offset);
+	}
+
+	GL::GenBuffers (1, &_IBO);
+	GL::BindBuffer (GL_ELEMENT_ARRAY_BUFFER, _IBO);
+	GL::BufferData (GL_ELEMENT_ARRAY_BUFFER, sizeof (unsigned int) * _indicesAllocator.GetCapacity (), nullptr, GL_STATIC_DRAW);
+
+	GL::GenBuffers (1, &_drawIDBuffer);
+	GL::BindBuffer (GL_ARRAY_BUFFER, _drawIDBuffer);
+
+	GL::EnableVertexAttribArray (STATIC_GEOMETRY_DRAW_ID_ATTRIBUTE);
+	GL::VertexAttribIPointer (STATIC_GEOMETRY_DRAW_ID_ATTRIBUTE, 1, GL_UNSIGNED_INT, sizeof (unsigned int), (void*) 0);
+	GL::VertexAttribDivisor (STATIC_GEOMETRY_DRAW_ID_ATTRIBUTE, 1);
+
+	GL::BindVertexArray (0);
+}
\ No newline at end of file
@@ -0,0 +1,91 @@
+#ifndef STATICGEOMETRYARENA_H
+#define STATICGEOMETRYARENA_H
+
+#include <vector>
+#include <cstddef>
+
+#include "Utils/Allocators/ArenaAllocator.h"
+
+/*
+ * Static meshes are uploaded in the arena of their vertex layout when
+ * the setting is on, the multi draw path is used for them while the
+ * indirect draw setting is on
+*/
+
+#define STATIC_GEOMETRY_SETTING "StaticGeometryArena"
+#define INDIRECT_DRAW_SETTING "IndirectDraw"
+
+#define STATIC_GEOMETRY_ARENA_VERTICES (1 << 21)
+#define STATIC_GEOMETRY_ARENA_INDICES (1 << 23)
+
+/*
+ * Per instance attribute that feeds the shaders the base instance of the
+ * command, the index of the draw in the storage buffer
+*/
+
+#define STATIC_GEOMETRY_DRAW_ID_ATTRIBUTE 7
+
+struct StaticGeometryAttribute
+{
+	unsigned int index;
+	int size;
+	std::size_t offset;
+};
+
+struct StaticGeometryRange
+{
+	std::size_t firstVertex;
+	std::size_t verticesCount;
+	std::size_t firstIndex;
+	std::size_t indicesCount;
+
+	StaticGeometryRange ();
+};
+
+/*
+ * Shared vertex and index buffers for all the meshes with the same
+ * vertex layout, drawn through a single vertex array. Indices are 32 bit
+ * and relative to the first vertex of their mesh. Ranges are handed out
+ * by arena allocators, the buffers are created on first use and keep
+ * their size.
+*/
+
+class StaticGeometryArena
+{
+protected:
+	std::size_t _index;
+	std::size_t _vertexStride;
+	std::vector<StaticGeometryAttribute> _attributes;
+
+	ArenaAllocator _verticesAllocator;
+	ArenaAllocator _indicesAllocator;
+
+	unsigned int _VAO;
+	unsigned int _VBO;
+	unsigned int _IBO;
+	unsigned int _drawIDBuffer;
+	std::size_t _drawIDsCount;
+
+	static std::vector<StaticGeometryArena*> _arenas;
+
+public:
+	StaticGeometryArena (std::size_t vertexStride, const std::vector<StaticGeometryAttribute>& attributes);
+	~StaticGeometryArena ();
+
+	bool Allocate (const void* vertices, std::size_t verticesCount,
+		const std::vector<unsigned int>& indices, StaticGeometryRange& range);
+	void Free (const StaticGeometryRange& range);
+
+	void Bind (std::size_t drawsCount);
+
+	std::size_t GetIndex () const;
+	std::size_t GetVertexStride () const;
+	unsigned int GetVertexArray () const;
+
+	static StaticGeometryArena* GetArena (std::size_t index);
+	static std::size_t GetArenasCount ();
+protected:
+	void Create ();
+};
+
+#endif
\ No newline at end of file
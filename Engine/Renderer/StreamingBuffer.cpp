@@ -0,0 +1,194 @@
+#include "StreamingBuffer.h"
+
+#include "Wrappers/OpenGL/GL.h"
+
+#include "Core/Console/Console.h"
+
+/*
+ * A second without progress of the GPU is treated as a lost fence, the
+ * frame goes on instead of hanging
+*/
+
+#define STREAMING_FENCE_TIMEOUT 1000000000
+
+StreamingAllocation::StreamingAllocation () :
+	data (nullptr),
+	offset (0),
+	size (0)
+{
+
+}
+
+void* GLStreamingFence::Insert ()
+{
+	return GL::FenceSync (GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+}
+
+/*
+ * The first wait flushes the commands, so that the fence is sure to be
+ * reached
+*/
+
+bool GLStreamingFence::Wait (void* fence)
+{
+	GLenum result = GL::ClientWaitSync ((GLsync) fence, 0, 0);
+
+	if (result == GL_ALREADY_SIGNALED || result == GL_WAIT_FAILED) {
+		return false;
+	}
+
+	result = GL::ClientWaitSync ((GLsync) fence, GL_SYNC_FLUSH_COMMANDS_BIT, STREAMING_FENCE_TIMEOUT);
+
+	if (result == GL_TIMEOUT_EXPIRED) {
+		Console::LogWarning ("Streaming buffer fence timed out. Frame data may be overwritten while in use.");
+	}
+
+	return true;
+}
+
+void GLStreamingFence::Delete (void* fence)
+{
+	GL::DeleteSync ((GLsync) fence);
+}
+
+StreamingBuffer::StreamingBuffer () :
+	_ring (STREAMING_BUFFER_REGION_SIZE, new GLStreamingFence ()),
+	_buffer (0),
+	_data (nullptr),
+	_isPersistent (false),
+	_framesCount (0)
+{
+
+}
+
+StreamingBuffer::~StreamingBuffer ()
+{
+	if (_buffer == 0) {
+		return;
+	}
+
+	if (_isPersistent) {
+		GL::BindBuffer (GL_ARRAY_BUFFER, _buffer);
+		GL::UnmapBuffer (GL_ARRAY_BUFFER);
+	}
+
+	GL::DeleteBuffers (1, &_buffer);
+}
+
+void StreamingBuffer::BeginFrame ()
+{
+	_ring.BeginFrame ();
+
+	_framesCount ++;
+}
+
+void StreamingBuffer::EndFrame ()
+{
+	_ring.EndFrame ();
+}
+
+/*
+ * The data pointer of the returned allocation is null if the region of
+ * the frame is full
+*/
+
+StreamingAllocation StreamingBuffer::Allocate (std::size_t size, std::size_t alignment)
+{
+	StreamingAllocation allocation;
+
+	Create ();
+
+	std::size_t offset = _ring.Allocate (size, alignment);
+
+	if (offset == STREAMING_RING_INVALID_OFFSET) {
+		Console::LogWarning ("Streaming buffer is out of space for this frame.");
+
+		return allocation;
+	}
+
+	allocation.offset = offset;
+	allocation.size = size;
+
+	if (_isPersistent) {
+		allocation.data = _data + offset;
+
+		return allocation;
+	}
+
+	GL::BindBuffer (GL_ARRAY_BUFFER, _buffer);
+	allocation.data = GL::MapBufferRange (GL_ARRAY_BUFFER, offset, size,
+		GL_MAP_WRITE_BIT | GL_MAP_UNSYNCHRONIZED_BIT | GL_MAP_INVALIDATE_RANGE_BIT);
+
+	return allocation;
+}
+
+void StreamingBuffer::Commit (const StreamingAllocation& allocation)
+{
+	if (_isPersistent || allocation.data == nullptr) {
+		return;
+	}
+
+	GL::BindBuffer (GL_ARRAY_BUFFER, _buffer);
+	GL::UnmapBuffer (GL_ARRAY_BUFFER);
+}
+
+std::size_t StreamingBuffer::GetAvailableSize (std::size_t alignment) const
+{
+	return _ring.GetAvailableSize (alignment);
+}
+
+/*
+ * Start of the region of the current frame. Bound as a range of this
+ * region, the buffer holds the data of the frame only.
+*/
+
+std::size_t StreamingBuffer::GetRegionOffset () const
+{
+	return _ring.GetRegion () * _ring.GetRegionSize ();
+}
+
+/*
+ * Data allocated in an earlier frame is to be allocated again once this
+ * count changes
+*/
+
+std::size_t StreamingBuffer::GetFramesCount () const
+{
+	return _framesCount;
+}
+
+unsigned int StreamingBuffer::GetBuffer ()
+{
+	Create ();
+
+	return _buffer;
+}
+
+void StreamingBuffer::Create ()
+{
+	if (_buffer != 0) {
+		return;
+	}
+
+	GL::GenBuffers (1, &_buffer);
+	GL::BindBuffer (GL_ARRAY_BUFFER, _buffer);
+
+	if (!GLEW_ARB_buffer_storage) {
+		Console::LogWarning ("ARB_buffer_storage is not supported. Streaming buffer will be mapped on each allocation.");
+
+		GL::BufferData (GL_ARRAY_BUFFER, _ring.GetSize (), NULL, GL_STREAM_DRAW);
+
+		return;
+	}
+
+	GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+
+	GL::BufferStorage (GL_ARRAY_BUFFER, _ring.GetSize (), NULL, flags);
+	_data = (unsigned char*) GL::MapBufferRange (GL_ARRAY_BUFFER, 0, _ring.GetSize (), flags);
+
+	_isPersistent = _data != nullptr;
+
+	if (!_isPersistent) {
+		Console::LogError ("Streaming buffer could not be mapped persistently.");
+	}
+}
\ No newline at end of file
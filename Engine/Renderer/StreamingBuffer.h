@@ -0,0 +1,82 @@
+#ifndef STREAMINGBUFFER_H
+#define STREAMINGBUFFER_H
+
+#include "Core/Singleton/Singleton.h"
+
+#include <cstddef>
+
+#include "StreamingRing.h"
+
+/*
+ * Bytes each frame in flight may write, the buffer holds one region
+ * for every one of them
+*/
+
+#define STREAMING_BUFFER_REGION_SIZE (1 << 24)
+
+struct StreamingAllocation
+{
+	void* data;
+	std::size_t offset;
+	std::size_t size;
+
+	StreamingAllocation ();
+};
+
+/*
+ * Fences of the streaming ring as GL sync objects
+*/
+
+class GLStreamingFence : public StreamingFence
+{
+public:
+	void* Insert ();
+	bool Wait (void* fence);
+	void Delete (void* fence);
+};
+
+/*
+ * One buffer for all the data written by the CPU every frame. It is
+ * mapped once, persistent and coherent, so writes go straight to memory
+ * the GPU reads without any map or copy by the driver. Frames share it
+ * through a ring of regions, see StreamingRing.
+ *
+ * Without ARB_buffer_storage every allocation is mapped on its own,
+ * unsynchronized since the ring already keeps it away from the GPU.
+ * Commit must be called once the allocation is written, before drawing
+ * from it.
+*/
+
+class StreamingBuffer : public Singleton<StreamingBuffer>
+{
+	friend Singleton<StreamingBuffer>;
+
+private:
+	StreamingRing _ring;
+	unsigned int _buffer;
+	unsigned char* _data;
+	bool _isPersistent;
+	std::size_t _framesCount;
+
+public:
+	void BeginFrame ();
+	void EndFrame ();
+
+	StreamingAllocation Allocate (std::size_t size, std::size_t alignment);
+	void Commit (const StreamingAllocation& allocation);
+
+	std::size_t GetAvailableSize (std::size_t alignment) const;
+	std::size_t GetRegionOffset () const;
+	std::size_t GetFramesCount () const;
+
+	unsigned int GetBuffer ();
+private:
+	StreamingBuffer ();
+	~StreamingBuffer ();
+	StreamingBuffer (const StreamingBuffer&);
+	StreamingBuffer& operator=(const StreamingBuffer&);
+
+	void Create ();
+};
+
+#endif
\ No newline at end of file
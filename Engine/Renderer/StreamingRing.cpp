@@ -0,0 +1,143 @@
+#include "StreamingRing.h"
+
+StreamingFence::~StreamingFence ()
+{
+
+}
+
+/*
+ * The ring starts on the last region, the first frame moves to region 0
+*/
+
+StreamingRing::StreamingRing (std::size_t regionSize, StreamingFence* fence) :
+	_fence (fence),
+	_regionSize (regionSize),
+	_region (STREAMING_RING_REGIONS_COUNT - 1),
+	_regionUsedSize (0),
+	_isFrameActive (false),
+	_stallsCount (0)
+{
+	for (std::size_t index = 0; index < STREAMING_RING_REGIONS_COUNT; index++) {
+		_fences [index] = nullptr;
+	}
+}
+
+StreamingRing::~StreamingRing ()
+{
+	for (std::size_t index = 0; index < STREAMING_RING_REGIONS_COUNT; index++) {
+		if (_fences [index] != nullptr) {
+			_fence->Delete (_fences [index]);
+		}
+	}
+
+	delete _fence;
+}
+
+void StreamingRing::BeginFrame ()
+{
+	if (_isFrameActive) {
+		EndFrame ();
+	}
+
+	_region = (_region + 1) % STREAMING_RING_REGIONS_COUNT;
+	_regionUsedSize = 0;
+
+	if (_fences [_region] != nullptr) {
+		if (_fence->Wait (_fences [_region])) {
+			_stallsCount ++;
+		}
+
+		_fence->Delete (_fences [_region]);
+		_fences [_region] = nullptr;
+	}
+
+	_isFrameActive = true;
+}
+
+/*
+ * A region nothing was allocated from needs no fence
+*/
+
+void StreamingRing::EndFrame ()
+{
+	if (!_isFrameActive) {
+		return;
+	}
+
+	if (_regionUsedSize > 0) {
+		_fences [_region] = _fence->Insert ();
+	}
+
+	_isFrameActive = false;
+}
+
+/*
+ * The offset is aligned from the start of the buffer, so that it can be
+ * turned into a whole number of vertices or instances of that size.
+ * Returns STREAMING_RING_INVALID_OFFSET outside of a frame or when the
+ * region of the frame has no room left.
+*/
+
+std::size_t StreamingRing::Allocate (std::size_t size, std::size_t alignment)
+{
+	if (!_isFrameActive || alignment == 0) {
+		return STREAMING_RING_INVALID_OFFSET;
+	}
+
+	std::size_t regionStart = _region * _regionSize;
+	std::size_t offset = regionStart + _regionUsedSize;
+
+	offset = (offset + alignment - 1) / alignment * alignment;
+
+	if (offset + size > regionStart + _regionSize) {
+		return STREAMING_RING_INVALID_OFFSET;
+	}
+
+	_regionUsedSize = offset + size - regionStart;
+
+	return offset;
+}
+
+std::size_t StreamingRing::GetRegion () const
+{
+	return _region;
+}
+
+std::size_t StreamingRing::GetRegionSize () const
+{
+	return _regionSize;
+}
+
+std::size_t StreamingRing::GetRegionUsedSize () const
+{
+	return _regionUsedSize;
+}
+
+/*
+ * Bytes the next allocation with this alignment can take, none outside
+ * of a frame
+*/
+
+std::size_t StreamingRing::GetAvailableSize (std::size_t alignment) const
+{
+	if (!_isFrameActive || alignment == 0) {
+		return 0;
+	}
+
+	std::size_t regionEnd = (_region + 1) * _regionSize;
+	std::size_t offset = _region * _regionSize + _regionUsedSize;
+
+	offset = (offset + alignment - 1) / alignment * alignment;
+
+	return offset < regionEnd ? regionEnd - offset : 0;
+}
+
+std::size_t StreamingRing::GetSize () const
+{
+	return _regionSize * STREAMING_RING_REGIONS_COUNT;
+}
+
+std::size_t StreamingRing::GetStallsCount () const
+{
+	return _stallsCount;
+}
\ No newline at end of file
@@ -0,0 +1,72 @@
+#ifndef STREAMINGRING_H
+#define STREAMINGRING_H
+
+#include <cstddef>
+#include <limits>
+
+/*
+ * Number of frames that may write or read the streaming buffer at the
+ * same time, one region of the ring each
+*/
+
+#define STREAMING_RING_REGIONS_COUNT 3
+
+#define STREAMING_RING_INVALID_OFFSET std::numeric_limits<std::size_t>::max ()
+
+/*
+ * Fences the ring waits on before it writes a region again. The GPU
+ * backend uses sync objects, anything that can tell when the work
+ * submitted before Insert is done can stand in for it.
+*/
+
+class StreamingFence
+{
+public:
+	virtual ~StreamingFence ();
+
+	virtual void* Insert () = 0;
+	virtual bool Wait (void* fence) = 0;
+	virtual void Delete (void* fence) = 0;
+};
+
+/*
+ * Bookkeeping of a buffer split in equal regions, one per frame in
+ * flight. A frame allocates from its region only. Its end puts a fence
+ * on the region, the frame that comes back to the region waits for that
+ * fence first, so the CPU never writes data the GPU may still read.
+ *
+ * Offsets are in bytes from the start of the buffer.
+*/
+
+class StreamingRing
+{
+protected:
+	StreamingFence* _fence;
+	std::size_t _regionSize;
+	std::size_t _region;
+	std::size_t _regionUsedSize;
+	void* _fences [STREAMING_RING_REGIONS_COUNT];
+	bool _isFrameActive;
+	std::size_t _stallsCount;
+
+public:
+	StreamingRing (std::size_t regionSize, StreamingFence* fence);
+	~StreamingRing ();
+
+	void BeginFrame ();
+	void EndFrame ();
+
+	std::size_t Allocate (std::size_t size, std::size_t alignment);
+
+	std::size_t GetRegion () const;
+	std::size_t GetRegionSize () const;
+	std::size_t GetRegionUsedSize () const;
+	std::size_t GetAvailableSize (std::size_t alignment) const;
+	std::size_t GetSize () const;
+	std::size_t GetStallsCount () const;
+private:
+	StreamingRing (const StreamingRing&);
+	StreamingRing& operator=(const StreamingRing&);
+};
+
+#endif
\ No newline at end of file
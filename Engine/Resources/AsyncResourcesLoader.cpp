@@ -0,0 +1,348 @@
+#include "AsyncResourcesLoader.h"
+
+#include <algorithm>
+
+#include "Resources.h"
+#include "MaterialLibraryLoader.h"
+
+#include "Managers/TextureManager.h"
+#include "Managers/MaterialManager.h"
+
+#include "Utils/Files/FileSystem.h"
+
+#include "Core/Console/Console.h"
+
+AsyncResourceRequest::AsyncResourceRequest () :
+	type (MODEL),
+	filename (),
+	resource (nullptr),
+	requestsCount (0),
+	usesCount (0),
+	queuedMoment (),
+	startMoment (),
+	loadedMoment (),
+	readyMoment ()
+{
+
+}
+
+AsyncResourcesLoader::AsyncResourcesLoader (std::size_t maxLoadingCount) :
+	_requestsMap (),
+	_requests (),
+	_loadedRequests (),
+	_waitingRequests (),
+	_pendingCount (0),
+	_loadingCount (0),
+	_maxLoadingCount (std::max (maxLoadingCount, (std::size_t) 1)),
+	_uploadBatchesCount (0),
+	_mutex (),
+	_condition (),
+	_jobsCounter (),
+	_startMoment (std::chrono::high_resolution_clock::now ())
+{
+
+}
+
+AsyncResourcesLoader::~AsyncResourcesLoader ()
+{
+	/*
+	 * Resources that were never taken are released only after every
+	 * job is done with them
+	*/
+
+	JobSystem::Instance ()->Wait (&_jobsCounter);
+
+	for (std::size_t i=0;i<_requests.size ();i++) {
+		delete _requests [i]->resource;
+		delete _requests [i];
+	}
+}
+
+/*
+ * Only Wavefront models are parsed on the workers. The other formats may
+ * touch the GL context while they load, so GetModel () loads them on the
+ * calling thread.
+*/
+
+void AsyncResourcesLoader::RequestModel (const std::string& filename)
+{
+	if (FileSystem::GetExtension (filename) != ".obj") {
+		return;
+	}
+
+	Request (AsyncResourceRequest::MODEL, filename);
+}
+
+/*
+ * Waits for every request, uploading the decoded textures in batches as
+ * soon as they are done. Material libraries are registered at the end,
+ * when all their textures are already on the GPU.
+ *
+ * Meanwhile the calling thread runs loading jobs too, it sleeps only when
+ * the workers have taken all of them.
+*/
+
+void AsyncResourcesLoader::Finish ()
+{
+	while (true) {
+		std::vector<AsyncResourceRequest*> loadedRequests;
+		bool isDone = false;
+
+		{
+			std::lock_guard<std::mutex> lock (_mutex);
+
+			loadedRequests.swap (_loadedRequests);
+
+			isDone = _pendingCount == 0;
+		}
+
+		bool haveUploads = false;
+
+		for (std::size_t i=0;i<loadedRequests.size ();i++) {
+			if (loadedRequests [i]->type == AsyncResourceRequest::TEXTURE) {
+				UploadTexture (loadedRequests [i]);
+
+				haveUploads = true;
+			}
+		}
+
+		if (haveUploads) {
+			_uploadBatchesCount ++;
+		}
+
+		if (isDone) {
+			break;
+		}
+
+		if (!loadedRequests.empty () || JobSystem::Instance ()->RunJob ()) {
+			continue;
+		}
+
+		std::unique_lock<std::mutex> lock (_mutex);
+
+		_condition.wait (lock, [this] { return !_loadedRequests.empty () || _pendingCount == 0; });
+	}
+
+	for (std::size_t i=0;i<_requests.size ();i++) {
+		if (_requests [i]->type == AsyncResourceRequest::MATERIAL_LIBRARY) {
+			RegisterMaterialLibrary (_requests [i]);
+		}
+	}
+}
+
+/*
+ * Every user of a model owns its instance. The parsed model is copied for
+ * all the requests but the last one, which takes the model itself.
+*/
+
+Model* AsyncResourcesLoader::GetModel (const std::string& filename)
+{
+	std::map<std::string, AsyncResourceRequest*>::iterator it = _requestsMap.find (filename);
+
+	if (it == _requestsMap.end () || it->second->type != AsyncResourceRequest::MODEL ||
+		it->second->resource == nullptr) {
+		return Resources::LoadModel (filename);
+	}
+
+	AsyncResourceRequest* request = it->second;
+
+	Model* model = (Model*) request->resource;
+
+	request->usesCount ++;
+	request->readyMoment = std::chrono::high_resolution_clock::now ();
+
+	if (request->usesCount < request->requestsCount) {
+		return new Model (*model);
+	}
+
+	request->resource = nullptr;
+
+	return model;
+}
+
+void AsyncResourcesLoader::LogTimeline ()
+{
+	const std::string typeNames [] = {"Model", "Material library", "Texture"};
+
+	Console::Log ("Resources timeline, " + std::to_string (_requests.size ()) + " resources, " +
+		std::to_string (_maxLoadingCount) + " at once on " +
+		std::to_string (JobSystem::Instance ()->GetWorkersCount ()) + " workers, " +
+		std::to_string (_uploadBatchesCount) + " upload batches (ms since the loading start):");
+
+	for (std::size_t i=0;i<_requests.size ();i++) {
+		AsyncResourceRequest* request = _requests [i];
+
+		std::string requestsCount = request->requestsCount > 1 ?
+			" x" + std::to_string (request->requestsCount) : "";
+
+		Console::Log ("\t" + typeNames [request->type] + " " + request->filename + requestsCount +
+			": queued " + std::to_string (GetTime (request->queuedMoment)) +
+			", started " + std::to_string (GetTime (request->startMoment)) +
+			", loaded " + std::to_string (GetTime (request->loadedMoment)) +
+			", ready " + std::to_string (GetTime (request->readyMoment)));
+	}
+}
+
+void AsyncResourcesLoader::Request (AsyncResourceRequest::RequestType type, const std::string& filename)
+{
+	AsyncResourceRequest* request = nullptr;
+
+	{
+		std::lock_guard<std::mutex> lock (_mutex);
+
+		std::map<std::string, AsyncResourceRequest*>::iterator it = _requestsMap.find (filename);
+
+		if (it != _requestsMap.end ()) {
+			it->second->requestsCount ++;
+
+			return;
+		}
+
+		request = new AsyncResourceRequest ();
+		request->type = type;
+		request->filename = filename;
+		request->requestsCount = 1;
+		request->queuedMoment = std::chrono::high_resolution_clock::now ();
+
+		_requestsMap [filename] = request;
+		_requests.push_back (request);
+
+		_pendingCount ++;
+
+		if (_loadingCount == _maxLoadingCount) {
+			_waitingRequests.push_back (request);
+
+			return;
+		}
+
+		_loadingCount ++;
+	}
+
+	StartLoading (request);
+}
+
+void AsyncResourcesLoader::StartLoading (AsyncResourceRequest* request)
+{
+	JobSystem::Instance ()->Submit ([this, request] { Load (request); }, &_jobsCounter);
+}
+
+void AsyncResourcesLoader::Load (AsyncResourceRequest* request)
+{
+	request->startMoment = std::chrono::high_resolution_clock::now ();
+
+	switch (request->type) {
+		case AsyncResourceRequest::MODEL:
+			LoadModel (request);
+			break;
+		case AsyncResourceRequest::MATERIAL_LIBRARY:
+			LoadMaterialLibrary (request);
+			break;
+		case AsyncResourceRequest::TEXTURE:
+			LoadTexture (request);
+			break;
+	}
+
+	/*
+	 * The job goes on with the next waiting request, if any
+	*/
+
+	AsyncResourceRequest* nextRequest = nullptr;
+
+	{
+		std::lock_guard<std::mutex> lock (_mutex);
+
+		request->loadedMoment = std::chrono::high_resolution_clock::now ();
+		request->readyMoment = request->loadedMoment;
+
+		_loadedRequests.push_back (request);
+
+		_pendingCount --;
+
+		if (!_waitingRequests.empty ()) {
+			nextRequest = _waitingRequests.front ();
+			_waitingRequests.pop_front ();
+		} else {
+			_loadingCount --;
+		}
+	}
+
+	_condition.notify_all ();
+
+	if (nextRequest != nullptr) {
+		StartLoading (nextRequest);
+	}
+}
+
+/*
+ * The material libraries of the model are requested on their own, so
+ * libraries shared by several models are read only once
+*/
+
+void AsyncResourcesLoader::LoadModel (AsyncResourceRequest* request)
+{
+	Model* model = Resources::LoadModel (request->filename, false);
+
+	std::vector<std::string> materialLibraries = model->GetMaterialLibraries ();
+
+	for (std::size_t i=0;i<materialLibraries.size ();i++) {
+		Request (AsyncResourceRequest::MATERIAL_LIBRARY, materialLibraries [i]);
+	}
+
+	request->resource = model;
+}
+
+/*
+ * Only the texture names are read here, the library itself creates
+ * shaders and is loaded on the GL thread
+*/
+
+void AsyncResourcesLoader::LoadMaterialLibrary (AsyncResourceRequest* request)
+{
+	MaterialLibraryLoader materialLibraryLoader;
+
+	std::vector<std::string> textureFilenames = materialLibraryLoader.LoadTextureFilenames (request->filename);
+
+	for (std::size_t i=0;i<textureFilenames.size ();i++) {
+		Request (AsyncResourceRequest::TEXTURE, textureFilenames [i]);
+	}
+}
+
+void AsyncResourcesLoader::LoadTexture (AsyncResourceRequest* request)
+{
+	request->resource = Resources::LoadTexture (request->filename);
+}
+
+void AsyncResourcesLoader::UploadTexture (AsyncResourceRequest* request)
+{
+	Texture* texture = (Texture*) request->resource;
+
+	request->resource = nullptr;
+
+	if (TextureManager::Instance ()->GetTexture (request->filename) != nullptr) {
+		delete texture;
+	} else {
+		TextureManager::Instance ()->AddTexture (texture);
+	}
+
+	request->readyMoment = std::chrono::high_resolution_clock::now ();
+}
+
+void AsyncResourcesLoader::RegisterMaterialLibrary (AsyncResourceRequest* request)
+{
+	MaterialLibrary* mtlLibrary = Resources::LoadMaterialLibrary (request->filename);
+
+	for (std::size_t i=0;i<mtlLibrary->GetMaterialsCount ();i++) {
+		MaterialManager::Instance ().AddMaterial (mtlLibrary->GetMaterial (i));
+	}
+
+	delete mtlLibrary;
+
+	request->readyMoment = std::chrono::high_resolution_clock::now ();
+}
+
+float AsyncResourcesLoader::GetTime (const std::chrono::time_point<std::chrono::high_resolution_clock>& moment) const
+{
+	std::chrono::duration<float, std::milli> duration = moment - _startMoment;
+
+	return duration.count ();
+}
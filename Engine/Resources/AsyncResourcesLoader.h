@@ -0,0 +1,97 @@
+#ifndef ASYNCRESOURCESLOADER_H
+#define ASYNCRESOURCESLOADER_H
+
+#include <string>
+#include <vector>
+#include <map>
+#include <deque>
+#include <mutex>
+#include <condition_variable>
+#include <chrono>
+
+#include "Core/Interfaces/Object.h"
+#include "Mesh/Model.h"
+
+#include "Utils/Threads/JobSystem.h"
+
+/*
+ * One resource of the loading pipeline. Every path is requested only
+ * once, later requests for the same path share the entry.
+*/
+
+struct AsyncResourceRequest
+{
+	enum RequestType {MODEL, MATERIAL_LIBRARY, TEXTURE};
+
+	RequestType type;
+	std::string filename;
+	Object* resource;
+
+	std::size_t requestsCount;
+	std::size_t usesCount;
+
+	std::chrono::time_point<std::chrono::high_resolution_clock> queuedMoment;
+	std::chrono::time_point<std::chrono::high_resolution_clock> startMoment;
+	std::chrono::time_point<std::chrono::high_resolution_clock> loadedMoment;
+	std::chrono::time_point<std::chrono::high_resolution_clock> readyMoment;
+
+	AsyncResourceRequest ();
+};
+
+/*
+ * Loads scene resources as jobs of the job system, at most the given
+ * count at once, the others wait for a load to end. File reading, mesh
+ * parsing and image decoding happen in the jobs. Everything that needs
+ * the GL context (texture uploads, material libraries, renderer buffers)
+ * stays on the calling thread, which takes the finished resources in
+ * batches and runs loading jobs itself while the workers keep going.
+*/
+
+class AsyncResourcesLoader
+{
+protected:
+	std::map<std::string, AsyncResourceRequest*> _requestsMap;
+	std::vector<AsyncResourceRequest*> _requests;
+	std::vector<AsyncResourceRequest*> _loadedRequests;
+	std::deque<AsyncResourceRequest*> _waitingRequests;
+	std::size_t _pendingCount;
+	std::size_t _loadingCount;
+	std::size_t _maxLoadingCount;
+	std::size_t _uploadBatchesCount;
+
+	std::mutex _mutex;
+	std::condition_variable _condition;
+	JobCounter _jobsCounter;
+
+	std::chrono::time_point<std::chrono::high_resolution_clock> _startMoment;
+
+public:
+	AsyncResourcesLoader (std::size_t maxLoadingCount);
+	~AsyncResourcesLoader ();
+
+	void RequestModel (const std::string& filename);
+
+	void Finish ();
+
+	Model* GetModel (const std::string& filename);
+
+	void LogTimeline ();
+private:
+	AsyncResourcesLoader (const AsyncResourcesLoader&);
+	AsyncResourcesLoader& operator=(const AsyncResourcesLoader&);
+
+	void Request (AsyncResourceRequest::RequestType type, const std::string& filename);
+	void StartLoading (AsyncResourceRequest* request);
+
+	void Load (AsyncResourceRequest* request);
+	void LoadModel (AsyncResourceRequest* request);
+	void LoadMaterialLibrary (AsyncResourceRequest* request);
+	void LoadTexture (AsyncResourceRequest* request);
+
+	void UploadTexture (AsyncResourceRequest* request);
+	void RegisterMaterialLibrary (AsyncResourceRequest* request);
+
+	float GetTime (const std::chrono::time_point<std::chrono::high_resolution_clock>& moment) const;
+};
+
+#endif
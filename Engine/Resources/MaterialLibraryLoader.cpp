@@ -1,6 +1,7 @@
 #include "MaterialLibraryLoader.h"
 
 #include <string>
+#include <vector>
 #include <limits>
 #include <fstream>
 
@@ -56,6 +57,47 @@ Object* MaterialLibraryLoader::Load(const std::string& filename)
 	return materialLibrary;
 }
 
+/*
+ * Only collects the 2D textures a material library references, so they
+ * can be decoded ahead of the library itself, away from the GL thread
+*/
+
+std::vector<std::string> MaterialLibraryLoader::LoadTextureFilenames(const std::string& filename)
+{
+	std::vector<std::string> textureFilenames;
+
+	std::ifstream mtlFile (filename);
+
+	if (!mtlFile.is_open()) {
+		return textureFilenames;
+	}
+
+	std::string lineType;
+
+	while (mtlFile >> lineType) {
+		if (lineType.substr (0, 4) == "map_") {
+			textureFilenames.push_back (ReadTextureFilename (mtlFile, filename));
+			continue;
+		}
+
+		if (lineType == "attribute") {
+			std::string attrType;
+			std::string attrName;
+
+			mtlFile >> attrType >> attrName;
+
+			if (attrType == "TEXTURE2D") {
+				textureFilenames.push_back (ReadTextureFilename (mtlFile, filename));
+				continue;
+			}
+		}
+
+		ProcessComment (mtlFile);
+	}
+
+	return textureFilenames;
+}
+
 void MaterialLibraryLoader::ProcessComment(std::ifstream &file)
 {
 	file.ignore (std::numeric_limits<std::streamsize>::max(), '\n');	
@@ -104,13 +146,7 @@ void MaterialLibraryLoader::ProcessCustomAttributes(std::ifstream &file, Materia
 	if (attrType == "TEXTURE2D") {
 		attribute.type = Attribute::AttrType::ATTR_TEXTURE2D;
 
-		std::string attrTextureName;
-		std::getline (file, attrTextureName);
-
-		Extensions::StringExtend::Trim (attrTextureName);
-
-		attrTextureName = FileSystem::GetDirectory (filename) + attrTextureName;
-		attrTextureName = FileSystem::FormatFilename (attrTextureName);	
+		std::string attrTextureName = ReadTextureFilename (file, filename);
 
 		Texture* texture = TextureManager::Instance ()->GetTexture (attrTextureName);
 
@@ -124,13 +160,7 @@ void MaterialLibraryLoader::ProcessCustomAttributes(std::ifstream &file, Materia
 	else if (attrType == "TEXTURE2D_ATLAS") {
 		attribute.type = Attribute::AttrType::ATTR_TEXTURE2D_ATLAS;
 
-		std::string attrTextureName;
-		std::getline (file, attrTextureName);
-
-		Extensions::StringExtend::Trim (attrTextureName);
-
-		attrTextureName = FileSystem::GetDirectory (filename) + attrTextureName;
-		attrTextureName = FileSystem::FormatFilename (attrTextureName);	
+		std::string attrTextureName = ReadTextureFilename (file, filename);
 
 		Texture* texture = TextureManager::Instance ()->GetTexture (attrTextureName);
 		TextureAtlas* textureAtlas = dynamic_cast<TextureAtlas*> (texture);
@@ -251,13 +281,7 @@ void MaterialLibraryLoader::ProcessDefaultAttributes(std::ifstream &file, Materi
 	}
 	else if (fileType.substr (0, 4) == "map_")
 	{
-		std::string textureName;
-		std::getline (file, textureName);
-
-		Extensions::StringExtend::Trim (textureName);
-
-		textureName = FileSystem::GetDirectory (filename) + textureName;
-		textureName = FileSystem::FormatFilename (textureName);
+		std::string textureName = ReadTextureFilename (file, filename);
 
 		Texture* texture = TextureManager::Instance ()->GetTexture (textureName);
 
@@ -288,3 +312,16 @@ void MaterialLibraryLoader::ProcessDefaultAttributes(std::ifstream &file, Materi
 		}
 	}
 }
+
+std::string MaterialLibraryLoader::ReadTextureFilename(std::ifstream &file, const std::string& filename)
+{
+	std::string textureName;
+	std::getline (file, textureName);
+
+	Extensions::StringExtend::Trim (textureName);
+
+	textureName = FileSystem::GetDirectory (filename) + textureName;
+	textureName = FileSystem::FormatFilename (textureName);
+
+	return textureName;
+}
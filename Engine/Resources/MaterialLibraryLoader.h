@@ -4,6 +4,7 @@
 #include "ResourceLoader.h"
 
 #include <string>
+#include <vector>
 
 #include "Material/MaterialLibrary.h"
 
@@ -11,12 +12,16 @@ class MaterialLibraryLoader : public ResourceLoader
 {
 public:
 	Object* Load(const std::string& filename);
+
+	std::vector<std::string> LoadTextureFilenames(const std::string& filename);
 private:
 	void ProcessComment(std::ifstream &file);
 	Material* SignalNewMaterial(std::ifstream &file, std::string filename, MaterialLibrary* materialLibrary);
 	void ProcessShaders(std::ifstream &file, Material* currentMaterial, std::string filename);
 	void ProcessCustomAttributes(std::ifstream &file, Material* currentMaterial, std::string filename);
 	void ProcessDefaultAttributes(std::ifstream &file, Material* currentMaterial, std::string filename, std::string lineType);
+
+	std::string ReadTextureFilename(std::ifstream &file, const std::string& filename);
 };
 
 #endif
\ No newline at end of file
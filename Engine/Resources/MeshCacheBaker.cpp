@@ -0,0 +1,112 @@
+#include "MeshCacheBaker.h"
+
+#include <algorithm>
+
+#include "Core/Parsers/XML/TinyXml/tinyxml.h"
+
+#include "WavefrontObjectLoader.h"
+#include "MeshCacheLoader.h"
+#include "MeshCacheSaver.h"
+
+#include "Mesh/MeshCache.h"
+#include "Mesh/Model.h"
+
+#include "Utils/Files/FileSystem.h"
+
+#include "Core/Console/Console.h"
+
+std::size_t MeshCacheBaker::BakeScene (const std::string& filename)
+{
+	std::vector<std::string> meshPaths = GetScenePaths (filename);
+
+	std::size_t bakedCount = 0;
+
+	for (const std::string& meshPath : meshPaths) {
+		if (BakeModel (meshPath)) {
+			bakedCount ++;
+		}
+	}
+
+	Console::Log ("Mesh caches baked for " + filename + ": " + std::to_string (bakedCount) +
+		" of " + std::to_string (meshPaths.size ()));
+
+	return bakedCount;
+}
+
+/*
+ * Returns false only when the cache could not be produced. A cache that is
+ * still up to date is left untouched.
+*/
+
+bool MeshCacheBaker::BakeModel (const std::string& filename)
+{
+	MeshCacheKey key;
+
+	if (!MeshCache::ComputeKey (filename, key)) {
+		Console::LogError ("Unable to open file \"" + filename + "\" !");
+		return false;
+	}
+
+	if (MeshCacheLoader::IsValid (filename, key)) {
+		Console::Log ("Mesh cache for " + filename + " is up to date");
+		return true;
+	}
+
+	WavefrontObjectLoader wavefrontObjectLoader;
+	wavefrontObjectLoader.SetLoadMaterials (false);
+
+	Model* model = (Model*) wavefrontObjectLoader.Load (filename);
+
+	MeshCacheSaver meshCacheSaver;
+	bool saved = meshCacheSaver.Save (model, filename, key);
+
+	delete model;
+
+	if (!saved) {
+		Console::LogError ("Unable to write the mesh cache for \"" + filename + "\"");
+	}
+
+	return saved;
+}
+
+/*
+ * Every Wavefront model referenced by the scene, without duplicates
+*/
+
+std::vector<std::string> MeshCacheBaker::GetScenePaths (const std::string& filename)
+{
+	std::vector<std::string> meshPaths;
+
+	TiXmlDocument doc;
+	if(!doc.LoadFile(filename.c_str ())) {
+		Console::LogError (filename + " has error in its syntax. Could not preceed further.");
+		return meshPaths;
+	}
+
+	TiXmlElement* root = doc.FirstChildElement ("Scene");
+
+	if (root == NULL) {
+		return meshPaths;
+	}
+
+	TiXmlElement* content = root->FirstChildElement ();
+
+	while (content) {
+		std::string name = content->Value ();
+
+		if (name == "GameObject" || name == "NormalMapGameObject") {
+			const char* meshPath = content->Attribute ("meshpath");
+
+			if (meshPath != NULL && FileSystem::GetExtension (meshPath) == ".obj" &&
+				std::find (meshPaths.begin (), meshPaths.end (), meshPath) == meshPaths.end ()) {
+				meshPaths.push_back (meshPath);
+			}
+		}
+
+		content = content->NextSiblingElement ();
+	}
+
+	doc.Clear ();
+
+	return meshPaths;
+}
@@ -0,0 +1,21 @@
+#ifndef MESHCACHEBAKER_H
+#define MESHCACHEBAKER_H
+
+#include <string>
+#include <vector>
+
+/*
+ * Offline baking of the mesh caches used by a scene. It runs without a
+ * graphic context, so no material or texture is loaded on the way.
+*/
+
+class MeshCacheBaker
+{
+public:
+	static std::size_t BakeScene (const std::string& filename);
+	static bool BakeModel (const std::string& filename);
+private:
+	static std::vector<std::string> GetScenePaths (const std::string& filename);
+};
+
+#endif
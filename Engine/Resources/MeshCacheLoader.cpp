@@ -0,0 +1,356 @@
+#include "MeshCacheLoader.h"
+
+#include <cstring>
+
+#include "Managers/MaterialManager.h"
+#include "Material/MaterialLibrary.h"
+
+#include "Utils/MeshOptimizer/MeshOptimizer.h"
+
+#include "Resources.h"
+
+#include "Core/Console/Console.h"
+
+MeshCacheLoader::MeshCacheLoader () :
+	_key (),
+	_loadMaterials (true),
+	_cursor (nullptr),
+	_end (nullptr)
+{
+
+}
+
+Object* MeshCacheLoader::Load (const std::string& filename)
+{
+	MeshCache* meshCache = new MeshCache ();
+
+	if (!meshCache->GetFile ().Open (MeshCache::GetCacheFilename (filename))) {
+		delete meshCache;
+		return nullptr;
+	}
+
+	_cursor = meshCache->GetFile ().GetData ();
+	_end = _cursor + meshCache->GetFile ().GetSize ();
+
+	Model* model = new Model ();
+	model->SetName (filename);
+
+	if (!ReadModel (model, meshCache)) {
+		Console::LogWarning ("Mesh cache for \"" + filename + "\" is outdated. It will be rebuilt.");
+
+		delete model;
+		delete meshCache;
+
+		return nullptr;
+	}
+
+	model->SetMeshCache (meshCache);
+
+	return model;
+}
+
+void MeshCacheLoader::SetKey (const MeshCacheKey& key)
+{
+	_key = key;
+}
+
+void MeshCacheLoader::SetLoadMaterials (bool loadMaterials)
+{
+	_loadMaterials = loadMaterials;
+}
+
+/*
+ * Checks only the header, without loading anything
+*/
+
+bool MeshCacheLoader::IsValid (const std::string& filename, const MeshCacheKey& key)
+{
+	MappedFile cacheFile;
+
+	if (!cacheFile.Open (MeshCache::GetCacheFilename (filename))) {
+		return false;
+	}
+
+	MeshCacheLoader meshCacheLoader;
+	meshCacheLoader._cursor = cacheFile.GetData ();
+	meshCacheLoader._end = meshCacheLoader._cursor + cacheFile.GetSize ();
+
+	MeshCacheKey cacheKey;
+	uint32_t vertexStride;
+
+	return meshCacheLoader.ReadHeader (cacheKey, vertexStride) && cacheKey == key;
+}
+
+bool MeshCacheLoader::ReadModel (Model* model, MeshCache* meshCache)
+{
+	MeshCacheKey cacheKey;
+	uint32_t vertexStride;
+
+	if (!ReadHeader (cacheKey, vertexStride) || !(cacheKey == _key)) {
+		return false;
+	}
+
+	float boundingBoxValues [6];
+
+	if (!Read (boundingBoxValues, sizeof (boundingBoxValues))) {
+		return false;
+	}
+
+	std::string modelMaterialLibrary;
+	uint32_t materialLibrariesCount;
+
+	if (!ReadString (modelMaterialLibrary) || !ReadUInt (materialLibrariesCount)) {
+		return false;
+	}
+
+	std::vector<std::string> materialLibraries (materialLibrariesCount);
+
+	for (std::size_t i=0;i<materialLibrariesCount;i++) {
+		if (!ReadString (materialLibraries [i])) {
+			return false;
+		}
+	}
+
+	if (!ReadVectors (model, &Model::ReserveVertices, &Model::AddVertex) ||
+		!ReadVectors (model, &Model::ReserveNormals, &Model::AddNormal) ||
+		!ReadVectors (model, &Model::ReserveTexcoords, &Model::AddTexcoord)) {
+		return false;
+	}
+
+	uint32_t objectsCount;
+
+	if (!ReadUInt (objectsCount)) {
+		return false;
+	}
+
+	/*
+	 * Groups are linked to their cache entries only after the whole file
+	 * was read, the entries vector may still grow until then
+	*/
+
+	std::vector<PolygonGroup*> polyGroups;
+
+	for (std::size_t i=0;i<objectsCount;i++) {
+		std::string objectName;
+		uint32_t polyGroupsCount;
+
+		if (!ReadString (objectName) || !ReadUInt (polyGroupsCount)) {
+			return false;
+		}
+
+		ObjectModel* objModel = new ObjectModel (objectName);
+		model->AddObjectModel (objModel);
+
+		for (std::size_t j=0;j<polyGroupsCount;j++) {
+			std::string polyGroupName, matName;
+			uint32_t polygonsCount;
+
+			if (!ReadString (polyGroupName) || !ReadString (matName) || !ReadUInt (polygonsCount)) {
+				return false;
+			}
+
+			PolygonGroup* polyGroup = new PolygonGroup (polyGroupName);
+			polyGroup->SetMaterialName (matName);
+			objModel->AddPolygonGroup (polyGroup);
+
+			polyGroup->Reserve (polygonsCount, polygonsCount * 3);
+
+			std::vector<int> vertices, normals, texcoords;
+
+			for (std::size_t k=0;k<polygonsCount;k++) {
+				if (!ReadIndices (vertices) || !ReadIndices (normals) || !ReadIndices (texcoords)) {
+					return false;
+				}
+
+				polyGroup->AddPolygon (vertices.data (), vertices.size (),
+					normals.data (), normals.size (), texcoords.data (), texcoords.size ());
+			}
+
+			MeshCacheGroup meshCacheGroup;
+			uint32_t verticesCount, indicesCount;
+
+			if (!ReadUInt (verticesCount)) {
+				return false;
+			}
+
+			meshCacheGroup.vertexStride = vertexStride;
+			meshCacheGroup.verticesCount = verticesCount;
+			meshCacheGroup.vertices = ReadBlock ((std::size_t) verticesCount * vertexStride);
+
+			if (meshCacheGroup.vertices == nullptr || !ReadUInt (indicesCount)) {
+				return false;
+			}
+
+			meshCacheGroup.indicesCount = indicesCount;
+			meshCacheGroup.indexSize = MeshOptimizer::GetIndexSize (verticesCount);
+			meshCacheGroup.indices = ReadBlock ((std::size_t) indicesCount * meshCacheGroup.indexSize);
+
+			if (meshCacheGroup.indices == nullptr) {
+				return false;
+			}
+
+			meshCache->AddGroup (meshCacheGroup);
+			polyGroups.push_back (polyGroup);
+		}
+	}
+
+	for (std::size_t i=0;i<polyGroups.size ();i++) {
+		polyGroups [i]->SetMeshCacheGroup (meshCache->GetGroup (i));
+	}
+
+	BoundingBox boundingBox;
+
+	boundingBox.xmin = boundingBoxValues [0];
+	boundingBox.xmax = boundingBoxValues [1];
+	boundingBox.ymin = boundingBoxValues [2];
+	boundingBox.ymax = boundingBoxValues [3];
+	boundingBox.zmin = boundingBoxValues [4];
+	boundingBox.zmax = boundingBoxValues [5];
+
+	model->SetBoundingBox (boundingBox);
+
+	model->SetMaterialLibrary (modelMaterialLibrary);
+
+	if (_loadMaterials) {
+		for (const std::string& materialLibrary : materialLibraries) {
+			LoadMaterialLibrary (materialLibrary);
+		}
+	}
+
+	return true;
+}
+
+bool MeshCacheLoader::ReadHeader (MeshCacheKey& key, uint32_t& vertexStride)
+{
+	char magic [4];
+	uint32_t version;
+
+	if (!Read (magic, 4) || std::memcmp (magic, MESH_CACHE_MAGIC, 4) != 0) {
+		return false;
+	}
+
+	if (!ReadUInt (version) || version != MESH_CACHE_VERSION) {
+		return false;
+	}
+
+	if (!Read (&key.sourceSize, sizeof (uint64_t)) ||
+		!Read (&key.sourceModificationTime, sizeof (int64_t)) ||
+		!Read (&key.sourceHash, sizeof (uint64_t))) {
+		return false;
+	}
+
+	return ReadUInt (vertexStride);
+}
+
+bool MeshCacheLoader::Read (void* value, std::size_t size)
+{
+	if ((std::size_t) (_end - _cursor) < size) {
+		return false;
+	}
+
+	std::memcpy (value, _cursor, size);
+	_cursor += size;
+
+	return true;
+}
+
+bool MeshCacheLoader::ReadUInt (uint32_t& value)
+{
+	return Read (&value, sizeof (uint32_t));
+}
+
+bool MeshCacheLoader::ReadString (std::string& value)
+{
+	uint32_t size;
+
+	if (!ReadUInt (size)) {
+		return false;
+	}
+
+	const char* data = ReadBlock (size);
+
+	if (data == nullptr) {
+		return false;
+	}
+
+	value.assign (data, size);
+
+	return true;
+}
+
+bool MeshCacheLoader::ReadVectors (Model* model, void (Model::*reserveVectors) (std::size_t),
+	void (Model::*addVector) (const glm::vec3&))
+{
+	uint32_t vectorsCount;
+
+	if (!ReadUInt (vectorsCount)) {
+		return false;
+	}
+
+	const char* data = ReadBlock ((std::size_t) vectorsCount * sizeof (float) * 3);
+
+	if (data == nullptr) {
+		return false;
+	}
+
+	(model->*reserveVectors) (vectorsCount);
+
+	for (std::size_t i=0;i<vectorsCount;i++) {
+		float values [3];
+		std::memcpy (values, data + i * sizeof (values), sizeof (values));
+
+		(model->*addVector) (glm::vec3 (values [0], values [1], values [2]));
+	}
+
+	return true;
+}
+
+bool MeshCacheLoader::ReadIndices (std::vector<int>& indices)
+{
+	uint32_t indicesCount;
+
+	if (!ReadUInt (indicesCount)) {
+		return false;
+	}
+
+	const char* data = ReadBlock ((std::size_t) indicesCount * sizeof (int32_t));
+
+	if (data == nullptr) {
+		return false;
+	}
+
+	indices.resize (indicesCount);
+
+	if (indicesCount > 0) {
+		std::memcpy (indices.data (), data, indicesCount * sizeof (int32_t));
+	}
+
+	return true;
+}
+
+/*
+ * Returns the block in place and skips its padding
+*/
+
+const char* MeshCacheLoader::ReadBlock (std::size_t size)
+{
+	std::size_t paddedSize = (size + 3) & ~((std::size_t) 3);
+
+	if ((std::size_t) (_end - _cursor) < paddedSize) {
+		return nullptr;
+	}
+
+	const char* block = _cursor;
+	_cursor += paddedSize;
+
+	return block;
+}
+
+void MeshCacheLoader::LoadMaterialLibrary (const std::string& filename)
+{
+	MaterialLibrary* mtlLibrary = Resources::LoadMaterialLibrary (filename);
+
+	for (std::size_t i=0;i<mtlLibrary->GetMaterialsCount ();i++) {
+		MaterialManager::Instance ().AddMaterial (mtlLibrary->GetMaterial (i));
+	}
+}
@@ -0,0 +1,55 @@
+#ifndef MESHCACHELOADER_H
+#define MESHCACHELOADER_H
+
+#include "ResourceLoader.h"
+
+#include <string>
+#include <vector>
+#include <cstdint>
+
+#include "Mesh/Model.h"
+#include "Mesh/MeshCache.h"
+
+/*
+ * Loads a model from the binary cache baked next to its source file. The
+ * cache file stays mapped for the lifetime of the model, the polygon groups
+ * reference their final buffers directly from the mapping.
+ *
+ * Load returns nullptr when the cache is missing, stale or damaged, the
+ * caller is expected to fall back to the source file.
+*/
+
+class MeshCacheLoader : public ResourceLoader
+{
+protected:
+	MeshCacheKey _key;
+	bool _loadMaterials;
+
+	const char* _cursor;
+	const char* _end;
+
+public:
+	MeshCacheLoader ();
+
+	Object* Load (const std::string& filename);
+
+	void SetKey (const MeshCacheKey& key);
+	void SetLoadMaterials (bool loadMaterials);
+
+	static bool IsValid (const std::string& filename, const MeshCacheKey& key);
+private:
+	bool ReadModel (Model* model, MeshCache* meshCache);
+	bool ReadHeader (MeshCacheKey& key, uint32_t& vertexStride);
+
+	bool Read (void* value, std::size_t size);
+	bool ReadUInt (uint32_t& value);
+	bool ReadString (std::string& value);
+	bool ReadVectors (Model* model, void (Model::*reserveVectors) (std::size_t),
+		void (Model::*addVector) (const glm::vec3&));
+	bool ReadIndices (std::vector<int>& indices);
+	const char* ReadBlock (std::size_t size);
+
+	void LoadMaterialLibrary (const std::string& filename);
+};
+
+#endif
@@ -0,0 +1,182 @@
+#include "MeshCacheSaver.h"
+
+#include <cstdio>
+
+#include "SceneNodes/NormalMapModel3DRenderer.h"
+
+#include "Utils/MeshOptimizer/MeshOptimizer.h"
+
+#include "Core/Console/Console.h"
+
+bool MeshCacheSaver::Save (Model* model, const std::string& sourceFilename, const MeshCacheKey& key)
+{
+	std::string cacheFilename = MeshCache::GetCacheFilename (sourceFilename);
+
+	/*
+	 * Write into a temporary file first, a half written cache would
+	 * otherwise be picked up by the next run
+	*/
+
+	std::string temporaryFilename = cacheFilename + ".tmp";
+
+	std::ofstream file (temporaryFilename, std::ios::out | std::ios::binary | std::ios::trunc);
+
+	if (!file.is_open ()) {
+		return false;
+	}
+
+	file.write (MESH_CACHE_MAGIC, 4);
+	WriteUInt (file, MESH_CACHE_VERSION);
+
+	file.write ((const char*) &key.sourceSize, sizeof (uint64_t));
+	file.write ((const char*) &key.sourceModificationTime, sizeof (int64_t));
+	file.write ((const char*) &key.sourceHash, sizeof (uint64_t));
+
+	WriteUInt (file, sizeof (NormalMapVertexData));
+
+	BoundingBox* boundingBox = model->GetBoundingBox ();
+
+	float boundingBoxValues [6] = {
+		boundingBox->xmin, boundingBox->xmax,
+		boundingBox->ymin, boundingBox->ymax,
+		boundingBox->zmin, boundingBox->zmax
+	};
+
+	file.write ((const char*) boundingBoxValues, sizeof (boundingBoxValues));
+
+	WriteString (file, model->GetMaterialLibrary ());
+
+	std::vector<std::string> materialLibraries = model->GetMaterialLibraries ();
+
+	WriteUInt (file, materialLibraries.size ());
+	for (const std::string& materialLibrary : materialLibraries) {
+		WriteString (file, materialLibrary);
+	}
+
+	WriteVectors (file, model->GetVertices ());
+	WriteVectors (file, model->GetNormals ());
+	WriteVectors (file, model->GetTexcoords ());
+
+	WriteUInt (file, model->ObjectsCount ());
+
+	for (std::size_t i=0;i<model->ObjectsCount ();i++) {
+		ObjectModel* objModel = model->GetObject (i);
+
+		WriteString (file, objModel->GetName ());
+		WriteUInt (file, objModel->GetPolygonCount ());
+
+		for (std::size_t j=0;j<objModel->GetPolygonCount ();j++) {
+			PolygonGroup* polyGroup = objModel->GetPolygonGroup (j);
+
+			WriteString (file, polyGroup->GetName ());
+			WriteString (file, polyGroup->GetMaterialName ());
+
+			WriteUInt (file, polyGroup->GetPolygonCount ());
+
+			for (std::size_t k=0;k<polyGroup->GetPolygonCount ();k++) {
+				Polygon* polygon = polyGroup->GetPolygon (k);
+
+				WriteIndices (file, polygon->GetIndices (Polygon::VERTEX_ATTRIBUTE), polygon->VertexCount ());
+				WriteIndices (file, polygon->GetIndices (Polygon::NORMAL_ATTRIBUTE), polygon->NormalsCount ());
+				WriteIndices (file, polygon->GetIndices (Polygon::TEXCOORD_ATTRIBUTE), polygon->TexcoordsCount ());
+			}
+
+			/*
+			 * Final buffers, in the layout the renderers upload
+			*/
+
+			std::vector<NormalMapVertexData> vertexBuffer;
+			std::vector<unsigned int> indexBuffer;
+
+			NormalMapModel3DRenderer::BuildVertexData (model, polyGroup, vertexBuffer, indexBuffer);
+
+			MeshOptimizer::Optimize (vertexBuffer, indexBuffer);
+
+			WriteUInt (file, vertexBuffer.size ());
+			file.write ((const char*) vertexBuffer.data (), sizeof (NormalMapVertexData) * vertexBuffer.size ());
+			WritePadding (file, sizeof (NormalMapVertexData) * vertexBuffer.size ());
+
+			/*
+			 * The index size follows from the vertices count
+			*/
+
+			WriteUInt (file, indexBuffer.size ());
+
+			if (MeshOptimizer::GetIndexSize (vertexBuffer.size ()) == sizeof (unsigned short)) {
+				std::vector<unsigned short> shortBuffer (indexBuffer.begin (), indexBuffer.end ());
+
+				file.write ((const char*) shortBuffer.data (), sizeof (unsigned short) * shortBuffer.size ());
+				WritePadding (file, sizeof (unsigned short) * shortBuffer.size ());
+			} else {
+				file.write ((const char*) indexBuffer.data (), sizeof (unsigned int) * indexBuffer.size ());
+			}
+		}
+	}
+
+	file.close ();
+
+	if (file.fail ()) {
+		std::remove (temporaryFilename.c_str ());
+		return false;
+	}
+
+	std::remove (cacheFilename.c_str ());
+
+	if (std::rename (temporaryFilename.c_str (), cacheFilename.c_str ()) != 0) {
+		std::remove (temporaryFilename.c_str ());
+		return false;
+	}
+
+	Console::Log ("Mesh cache written: " + cacheFilename);
+
+	return true;
+}
+
+void MeshCacheSaver::WriteUInt (std::ofstream& file, uint32_t value)
+{
+	file.write ((const char*) &value, sizeof (uint32_t));
+}
+
+void MeshCacheSaver::WriteString (std::ofstream& file, const std::string& value)
+{
+	WriteUInt (file, value.size ());
+	file.write (value.data (), value.size ());
+	WritePadding (file, value.size ());
+}
+
+void MeshCacheSaver::WriteVectors (std::ofstream& file, const std::vector<glm::vec3>& vectors)
+{
+	WriteUInt (file, vectors.size ());
+
+	for (const glm::vec3& vector : vectors) {
+		file.write ((const char*) &vector.x, sizeof (float));
+		file.write ((const char*) &vector.y, sizeof (float));
+		file.write ((const char*) &vector.z, sizeof (float));
+	}
+}
+
+void MeshCacheSaver::WriteIndices (std::ofstream& file, const int* indices, std::size_t indicesCount)
+{
+	WriteUInt (file, indicesCount);
+
+	for (std::size_t i=0;i<indicesCount;i++) {
+		int32_t value = indices [i];
+		file.write ((const char*) &value, sizeof (int32_t));
+	}
+}
+
+/*
+ * Keep every block 4 bytes aligned, so the mapped buffers can be used
+ * in place
+*/
+
+void MeshCacheSaver::WritePadding (std::ofstream& file, std::size_t size)
+{
+	static const char padding [4] = {0, 0, 0, 0};
+
+	std::size_t remainder = size % 4;
+
+	if (remainder != 0) {
+		file.write (padding, 4 - remainder);
+	}
+}
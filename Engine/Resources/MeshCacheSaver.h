@@ -0,0 +1,30 @@
+#ifndef MESHCACHESAVER_H
+#define MESHCACHESAVER_H
+
+#include <string>
+#include <fstream>
+#include <vector>
+#include <cstdint>
+
+#include "Mesh/Model.h"
+#include "Mesh/MeshCache.h"
+
+/*
+ * Writes the binary mesh cache of a freshly parsed model. Next to the
+ * topology it stores the final vertex and index buffers of every polygon
+ * group, so a cached load skips the parsing and the vertex expansion.
+*/
+
+class MeshCacheSaver
+{
+public:
+	bool Save (Model* model, const std::string& sourceFilename, const MeshCacheKey& key);
+private:
+	void WriteUInt (std::ofstream& file, uint32_t value);
+	void WriteString (std::ofstream& file, const std::string& value);
+	void WriteVectors (std::ofstream& file, const std::vector<glm::vec3>& vectors);
+	void WriteIndices (std::ofstream& file, const int* indices, std::size_t indicesCount);
+	void WritePadding (std::ofstream& file, std::size_t size);
+};
+
+#endif
@@ -285,18 +285,18 @@ void ParticleSystemLoader::ProcessParticleRigidbody (TiXmlElement* xmlElem, Part
 		std::string name = content->Value ();
 
 		if (name == "Gravity") {
-			ProcessParticleGravity (content, prototype->GetRigidbody ());
+			ProcessParticleGravity (content, prototype);
 		}
 
 		content = content->NextSiblingElement ();
 	}
 }
 
-void ParticleSystemLoader::ProcessParticleGravity (TiXmlElement* xmlElem, Rigidbody* rigidbody)
+void ParticleSystemLoader::ProcessParticleGravity (TiXmlElement* xmlElem, Particle* prototype)
 {
 	bool useGravity = Extensions::StringExtend::ToBool (xmlElem->Attribute ("use"));
 
-	rigidbody->SetGravityUse (useGravity);
+	prototype->SetGravityUse (useGravity);
 }
 
 void ParticleSystemLoader::ProcessTransform (TiXmlElement* xmlElem, Emiter* emiter)
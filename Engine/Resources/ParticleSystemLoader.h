@@ -26,7 +26,7 @@ private:
 	void ProcessParticleMesh (TiXmlElement* xmlElem, Particle* particle, const std::string& filename);
 	void ProcessMeshMaterial (TiXmlElement* xmlElem, Model* mesh, const std::string& filename);
 	void ProcessParticleRigidbody (TiXmlElement* xmlElem, Particle* particle);
-	void ProcessParticleGravity (TiXmlElement* xmlElem, Rigidbody* rigidbody);
+	void ProcessParticleGravity (TiXmlElement* xmlElem, Particle* particle);
 	void ProcessTransform (TiXmlElement* xmlElem, Emiter* emiter);
 	void ProcessEmisShape (TiXmlElement* xmlElem, Emiter* emiter);
 	void ProcessScaleCurve (TiXmlElement* xmlElem, Emiter* emiter);
@@ -5,6 +5,8 @@
 #include "Utils/Files/FileSystem.h"
 
 #include "WavefrontObjectLoader.h"
+#include "MeshCacheLoader.h"
+#include "MeshCacheSaver.h"
 #include "StanfordObjectLoader.h"
 #include "GenericObjectModelLoader.h"
 #include "AnimationModelLoader.h"
@@ -17,12 +19,17 @@
 #include "BitmapFontLoader.h"
 #include "LightLoader.h"
 
-Model* Resources::LoadModel (const std::string& filename)
+/*
+ * Only Wavefront models can skip their materials. Their material libraries
+ * are then left to the caller, see Model::GetMaterialLibraries ().
+*/
+
+Model* Resources::LoadModel (const std::string& filename, bool loadMaterials)
 {
 	std::string extension = FileSystem::GetExtension(filename);
 
 	if (extension == ".obj") {
-		return LoadWavefrontModel (filename);
+		return LoadWavefrontModel (filename, loadMaterials);
 	}
 	else if (extension == ".ply") {
 		return LoadStanfordModel (filename);
@@ -35,14 +42,45 @@ Model* Resources::LoadModel (const std::string& filename)
 	return NULL;
 }
 
-Model* Resources::LoadWavefrontModel(const std::string& filename)
+/*
+ * Wavefront models are baked into a binary mesh cache on their first load.
+ * The cache is used for as long as it matches the source file.
+*/
+
+Model* Resources::LoadWavefrontModel(const std::string& filename, bool loadMaterials)
 {
+	MeshCacheKey key;
+	bool haveKey = MeshCache::ComputeKey (filename, key);
+
+	if (haveKey) {
+		MeshCacheLoader* meshCacheLoader = new MeshCacheLoader ();
+		meshCacheLoader->SetKey (key);
+		meshCacheLoader->SetLoadMaterials (loadMaterials);
+
+		Model* model = (Model*)meshCacheLoader->Load (filename);
+
+		delete meshCacheLoader;
+
+		if (model != nullptr) {
+			return model;
+		}
+	}
+
 	WavefrontObjectLoader* wavefrontObjectLoader = new WavefrontObjectLoader();
+	wavefrontObjectLoader->SetLoadMaterials (loadMaterials);
 
 	Model* model = (Model*)wavefrontObjectLoader->Load(filename);
 
 	delete wavefrontObjectLoader;
 
+	if (haveKey) {
+		MeshCacheSaver meshCacheSaver;
+
+		if (!meshCacheSaver.Save (model, filename, key)) {
+			Console::LogWarning ("Unable to write the mesh cache for \"" + filename + "\"");
+		}
+	}
+
 	return model;
 }
 
@@ -18,7 +18,7 @@
 class Resources
 {
 public:
-	static Model* LoadModel (const std::string& filename);
+	static Model* LoadModel (const std::string& filename, bool loadMaterials = true);
 	static AnimationModel* LoadAnimatedModel (const std::string& filename);
 //	static int SaveModel (Model* model, char* filename);
 	
@@ -35,7 +35,7 @@ public:
 	static Light* LoadLight (const std::string& filename);
 
 private:
-	static Model* LoadWavefrontModel (const std::string& filename);
+	static Model* LoadWavefrontModel (const std::string& filename, bool loadMaterials);
 	static Model* LoadStanfordModel (const std::string& filename);
 	static Model* LoadGenericModel (const std::string& filename);
 
@@ -1,6 +1,9 @@
 #include "SceneLoader.h"
 
 #include <string>
+#include <thread>
+#include <chrono>
+#include <algorithm>
 
 #include "SceneNodes/GameObject.h"
 #include "SceneNodes/AnimationGameObject.h"
@@ -14,12 +17,15 @@
 
 #include "Resources/Resources.h"
 
+#include "Arguments/ArgumentsAnalyzer.h"
+
 #include "Utils/Extensions/StringExtend.h"
 #include "Utils/Extensions/MathExtend.h"
 
 #include "Core/Console/Console.h"
 
-SceneLoader::SceneLoader ()
+SceneLoader::SceneLoader () :
+	_asyncLoader (nullptr)
 {
 
 }
@@ -33,6 +39,8 @@ SceneLoader& SceneLoader::Instance ()
 
 Scene* SceneLoader::Load (const std::string& filename)
 {
+	std::chrono::time_point<std::chrono::high_resolution_clock> startMoment = std::chrono::high_resolution_clock::now ();
+
 	TiXmlDocument doc;
 	if(!doc.LoadFile(filename.c_str ())) {
 		Console::LogError (filename + " has error in its syntax. Could not preceed further.");
@@ -45,6 +53,22 @@ Scene* SceneLoader::Load (const std::string& filename)
 		return NULL;
 	}
 
+	/*
+	 * The resources of the scene are loaded as jobs first. The scene
+	 * objects are created afterwards, in file order, from the loaded
+	 * resources.
+	*/
+
+	std::size_t loadingCount = GetLoadingCount ();
+
+	if (loadingCount > 0) {
+		_asyncLoader = new AsyncResourcesLoader (loadingCount);
+
+		RequestResources (root);
+
+		_asyncLoader->Finish ();
+	}
+
 	Scene* scene = new Scene ();
 
 	TiXmlElement* content = root->FirstChildElement ();
@@ -76,9 +100,62 @@ Scene* SceneLoader::Load (const std::string& filename)
 
 	doc.Clear ();
 
+	if (_asyncLoader != nullptr) {
+		_asyncLoader->LogTimeline ();
+
+		delete _asyncLoader;
+		_asyncLoader = nullptr;
+	}
+
+	std::chrono::duration<float, std::milli> loadDuration = std::chrono::high_resolution_clock::now () - startMoment;
+
+	Console::Log ("Scene " + filename + " loaded in " + std::to_string (loadDuration.count ()) + " ms, " +
+		(loadingCount > 0 ? std::to_string (loadingCount) + " resources at once" : std::string ("one by one on the calling thread")));
+
 	return scene;
 }
 
+std::size_t SceneLoader::GetLoadingCount ()
+{
+	Argument* arg = ArgumentsAnalyzer::Instance ()->GetArgument (SCENE_LOADER_THREADS_ARGUMENT);
+
+	long value = 0;
+
+	if (arg != nullptr && arg->GetIntValue (value)) {
+		return (std::size_t) std::max (value, 0L);
+	}
+
+	return std::max (1u, std::thread::hardware_concurrency ());
+}
+
+void SceneLoader::RequestResources (TiXmlElement* xmlElem)
+{
+	TiXmlElement* content = xmlElem->FirstChildElement ();
+
+	while (content) {
+		std::string name = content->Value ();
+
+		if (name == "GameObject" || name == "NormalMapGameObject") {
+			const char* meshPath = content->Attribute ("meshpath");
+
+			if (meshPath != NULL) {
+				_asyncLoader->RequestModel (meshPath);
+			}
+		}
+
+		content = content->NextSiblingElement ();
+	}
+}
+
+Model* SceneLoader::LoadModel (const std::string& filename)
+{
+	if (_asyncLoader == nullptr) {
+		return Resources::LoadModel (filename);
+	}
+
+	return _asyncLoader->GetModel (filename);
+}
+
 void SceneLoader::ProcessSkybox (TiXmlElement* xmlElem, Scene* scene)
 {
 	std::string skyboxPath = xmlElem->Attribute ("path");
@@ -101,7 +178,7 @@ void SceneLoader::ProcessGameObject (TiXmlElement* xmlElem, Scene* scene)
 	gameObject->SetInstanceID (std::stoi (instanceID));
 	gameObject->SetActive (Extensions::StringExtend::ToBool (isActive));
 
-	Model* mesh = Resources::LoadModel (meshPath);
+	Model* mesh = LoadModel (meshPath);
 
 	TiXmlElement* content = xmlElem->FirstChildElement ();
 
@@ -189,7 +266,7 @@ void SceneLoader::ProcessNormalMapGameObject (TiXmlElement* xmlElem, Scene* scen
 	normalMapGameObject->SetInstanceID (std::stoi (instanceID));
 	normalMapGameObject->SetActive (Extensions::StringExtend::ToBool (isActive));
 
-	Model* mesh = Resources::LoadModel (meshPath);
+	Model* mesh = LoadModel (meshPath);
 
 	TiXmlElement* content = xmlElem->FirstChildElement ();
 
@@ -309,9 +386,9 @@ void SceneLoader::ProcessTransform (TiXmlElement* xmlElem, Scene* scene, SceneOb
 		sceneObject->GetTransform ()->SetParent (parent->GetTransform ());
 	}	
 
-	sceneObject->GetTransform ()->SetPosition (transform.GetPosition ());
-	sceneObject->GetTransform ()->SetRotation (transform.GetRotation ());
-	sceneObject->GetTransform ()->SetScale (transform.GetScale ());
+	sceneObject->GetTransform ()->SetPosition (transform.GetLocalPosition ());
+	sceneObject->GetTransform ()->SetRotation (transform.GetLocalRotation ());
+	sceneObject->GetTransform ()->SetScale (transform.GetLocalScale ());
 }
 
 glm::vec3 SceneLoader::GetPosition (TiXmlElement* xmlElem)
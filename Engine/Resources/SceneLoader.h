@@ -11,8 +11,20 @@
 #include "SceneGraph/Scene.h"
 #include "SceneGraph/Transform.h"
 
+#include "AsyncResourcesLoader.h"
+
+/*
+ * Number of scene resources loaded at once, as jobs of the job system.
+ * With 0 every resource is loaded serially, on the calling thread.
+*/
+
+#define SCENE_LOADER_THREADS_ARGUMENT "loadthreads"
+
 class SceneLoader
 {
+private:
+	AsyncResourcesLoader* _asyncLoader;
+
 public:
 	static SceneLoader& Instance ();
 
@@ -20,6 +32,10 @@ public:
 private:
 	SceneLoader ();
 
+	std::size_t GetLoadingCount ();
+	void RequestResources (TiXmlElement* xmlElem);
+	Model* LoadModel (const std::string& filename);
+
 	void ProcessLight (TiXmlElement* xmlElem, Scene* scene);
 	void ProcessSkybox (TiXmlElement* xmlElem, Scene* scene);
 	void ProcessGameObject (TiXmlElement* xmlElem, Scene* scene);
@@ -1,43 +1,74 @@
 #include "WavefrontObjectLoader.h"
 
-#include <fstream>
 #include <string>
-#include <limits>
+#include <cstring>
+#include <cctype>
+#include <cstdint>
+#include <cfloat>
+#include <chrono>
+#include <sstream>
+#include <locale>
+#include <algorithm>
 
 #include "Managers/MaterialManager.h"
 #include "Utils/Triangulation/Triangulation.h"
 
 #include "Utils/Files/FileSystem.h"
+#include "Utils/Files/MappedFile.h"
 
 #include "Mesh/Polygon.h"
 #include "Material/MaterialLibrary.h"
 
 #include "Utils/Extensions/StringExtend.h"
 
+#include "Utils/Threads/JobSystem.h"
+
 #include "Resources.h"
 
 #include "Core/Console/Console.h"
 
-Object* WavefrontObjectLoader::Load(const std::string& filename)
+/*
+ * Chunks smaller than this are not worth a job
+*/
+
+#define WAVEFRONT_MIN_CHUNK_SIZE (256 * 1024)
+
+WavefrontObjectChunk::WavefrontObjectChunk () :
+	begin (nullptr),
+	end (nullptr),
+	indexNormalization (false)
 {
-	Model * model = new Model ();
 
-	// Add default object models (the syntax can miss)
-	ObjectModel* currentObjModel = new ObjectModel ("DEFAULT");
-	PolygonGroup* currentPolyGroup = new PolygonGroup ("DEFAULT");
+}
 
-	model->AddObjectModel (currentObjModel);
-	currentObjModel->AddPolygonGroup (currentPolyGroup);
+WavefrontObjectLoader::WavefrontObjectLoader () :
+	_loadMaterials (true)
+{
+
+}
+
+/*
+ * Materials need a graphic context, a model baked offline is loaded
+ * without them
+*/
+
+void WavefrontObjectLoader::SetLoadMaterials (bool loadMaterials)
+{
+	_loadMaterials = loadMaterials;
+}
+
+Object* WavefrontObjectLoader::Load(const std::string& filename)
+{
+	Model * model = new Model ();
 
 	// Initialization part
-	std::string currentMatName, lineType;
 	bool indexNormalization = false;
 
-	std::ifstream objFile (filename.c_str());
+	MappedFile objFile;
 
 	// Can't open the model. Abort -> TODO: Make the game to not crash if can't load a model.
-	if (!objFile.is_open())													// If obj file is open, continue
-	{ 
+	if (!objFile.Open (filename))
+	{
 		Console::LogError ("Unable to open file \"" + filename + "\" !");
 
 		exit (1);
@@ -45,44 +76,43 @@ Object* WavefrontObjectLoader::Load(const std::string& filename)
 
 	model->SetName (filename);
 
-	// Read data stream
-	while (objFile >> lineType)											 	
-	{
-		if (lineType == "#") {
-			ProcessComment(objFile);
-		}
-		else if (lineType == "mtllib") {
-			LoadMaterialLibrary (objFile, filename, model);
-		}
-		else if (lineType == "v") {
-			ReadVertex (objFile, model);
-		}
-		else if (lineType == "vn") {
-			ReadNormal (objFile, model);
-		}
-		else if (lineType == "vt") {
-			ReadTexcoord (objFile, model);
-		}
-		else if (lineType == "usemtl") {
-			ReadCurrentMtlName (objFile, currentMatName);
-		}
-		else if (lineType == "f") {
-			ReadFace (objFile, model, currentPolyGroup, indexNormalization, currentMatName);
-		}
-		else if (lineType == "o") {
-			std::pair<ObjectModel*, PolygonGroup*> result = ReadObject (objFile, model);
+	std::chrono::time_point<std::chrono::high_resolution_clock> startMoment = std::chrono::high_resolution_clock::now ();
 
-			currentObjModel = result.first;
-			currentPolyGroup = result.second;
-		}
-		else if (lineType == "g") {
-			currentPolyGroup = ReadPolygonGroup (objFile, currentObjModel);
-		} else {
-			ProcessComment (objFile);
-		}
-	}
+	/*
+	 * Parse every line aligned chunk of the file as a job. Models are
+	 * loaded on the workers of the scene loader too, the job system keeps
+	 * the threads to one per core however many models load at once.
+	*/
+
+	std::vector<WavefrontObjectChunk> chunks = SplitChunks (objFile.GetData (), objFile.GetSize ());
+
+	JobSystem::Instance ()->ParallelFor (chunks.size (), 1,
+		[this, &chunks] (std::size_t begin, std::size_t end) {
+			for (std::size_t i=begin;i<end;i++) {
+				ParseChunk (&chunks [i]);
+			}
+		});
 
-	objFile.close();
+	std::chrono::duration<float, std::milli> parseDuration = std::chrono::high_resolution_clock::now () - startMoment;
+
+	/*
+	 * Merge the chunks in file order. State statements (materials,
+	 * objects, groups) are applied here, on the calling thread.
+	*/
+
+	MergeChunks (chunks, filename, model, indexNormalization);
+
+	std::chrono::duration<float, std::milli> loadDuration = std::chrono::high_resolution_clock::now () - startMoment;
+
+	float sizeMB = objFile.GetSize () / (1024.0f * 1024.0f);
+
+	Console::Log ("Wavefront model " + filename + ": " + std::to_string (sizeMB) + " MB in " +
+		std::to_string (chunks.size ()) + " chunks, parse " + std::to_string (parseDuration.count ()) +
+		" ms (" + std::to_string (sizeMB / (parseDuration.count () / 1000.0f)) + " MB/s), total " +
+		std::to_string (loadDuration.count ()) + " ms (" +
+		std::to_string (sizeMB / (loadDuration.count () / 1000.0f)) + " MB/s)");
+
+	objFile.Close ();
 
 	// Really need this parameter?
 	if (indexNormalization) {
@@ -95,167 +125,335 @@ Object* WavefrontObjectLoader::Load(const std::string& filename)
 	// major priority TODO: Investigate this
 	Triangulation::ConvexTriangulation (model);
 
-	return model;	
+	return model;
 }
 
-void WavefrontObjectLoader::ProcessComment(std::ifstream& file)
+std::vector<WavefrontObjectChunk> WavefrontObjectLoader::SplitChunks (const char* data, std::size_t size)
 {
-	file.ignore (std::numeric_limits<std::streamsize>::max(), '\n');	
-}
+	std::vector<WavefrontObjectChunk> chunks;
 
-void WavefrontObjectLoader::LoadMaterialLibrary(std::ifstream& file, const std::string& filename, Model* model)
-{
-	std::string mtlfilename;
-	std::getline (file, mtlfilename);
-	Extensions::StringExtend::Trim (mtlfilename);
+	if (size == 0) {
+		return chunks;
+	}
 
-	std::string fullMtlFilename = FileSystem::GetDirectory(filename) + mtlfilename;
-	fullMtlFilename = FileSystem::FormatFilename (fullMtlFilename);
+	/*
+	 * One chunk per thread that runs jobs, the calling one included
+	*/
 
-	Console::Log ("Material name: " + mtlfilename);
+	std::size_t chunksCount = JobSystem::Instance ()->GetWorkersCount () + 1;
+	chunksCount = std::min (chunksCount, size / WAVEFRONT_MIN_CHUNK_SIZE + 1);
 
-	model->SetMaterialLibrary (fullMtlFilename);
+	std::size_t chunkSize = size / chunksCount;
 
-	MaterialLibrary* mtlLibrary = Resources::LoadMaterialLibrary(fullMtlFilename);
+	const char* it = data;
+	const char* end = data + size;
 
-	for (std::size_t i=0;i<mtlLibrary->GetMaterialsCount ();i++) {
-		MaterialManager::Instance ().AddMaterial (mtlLibrary->GetMaterial (i));
-	}	
-}
+	for (std::size_t i=0;i<chunksCount && it != end;i++) {
+		const char* chunkEnd = end;
 
-void WavefrontObjectLoader::ReadVertex(std::ifstream& file, Model* model)
-{
-	float x, y, z;
-	file >> x >> y >> z;
+		/*
+		 * Move every boundary after the next line end, so no line is
+		 * split between two chunks
+		*/
 
-	model->AddVertex ( new glm::vec3 (x, y, z));
-}
+		if (i + 1 < chunksCount && (std::size_t) (end - it) > chunkSize) {
+			const char* lineEnd = (const char*) std::memchr (it + chunkSize, '\n', end - it - chunkSize);
 
-void WavefrontObjectLoader::ReadNormal(std::ifstream& file, Model* model)
-{
-	float x, y, z;
-	file >> x >> y >> z;
+			if (lineEnd != nullptr) {
+				chunkEnd = lineEnd + 1;
+			}
+		}
 
-	model->AddNormal ( new glm::vec3 (x, y, z));	
-}
+		WavefrontObjectChunk chunk;
+		chunk.begin = it;
+		chunk.end = chunkEnd;
 
-void WavefrontObjectLoader::ReadTexcoord(std::ifstream& file, Model* model)
-{
-	float x, y;
-	file >> x >> y;
-	file.ignore (std::numeric_limits<std::streamsize>::max(), '\n');
+		chunks.push_back (chunk);
 
-	model->AddTexcoord ( new glm::vec3 (x, 1.0f-y, 0.0f));
+		it = chunkEnd;
+	}
+
+	return chunks;
 }
 
-void WavefrontObjectLoader::ReadCurrentMtlName(std::ifstream& file, std::string& mtlName)
+void WavefrontObjectLoader::ParseChunk (WavefrontObjectChunk* chunk)
 {
-	std::getline (file, mtlName);
+	const char* it = chunk->begin;
+	const char* end = chunk->end;
 
-	Extensions::StringExtend::Trim (mtlName);
+	while (true) {
+		while (it != end && std::isspace ((unsigned char) *it)) {
+			++ it;
+		}
+
+		if (it == end) {
+			break;
+		}
+
+		const char* token = it;
+		while (it != end && !std::isspace ((unsigned char) *it)) {
+			++ it;
+		}
+
+		std::size_t tokenLength = it - token;
+
+		if (tokenLength == 1 && token [0] == 'v') {
+			float x, y, z;
+			if (ReadFloat (it, end, x) && ReadFloat (it, end, y) && ReadFloat (it, end, z)) {
+				chunk->positions.push_back (x);
+				chunk->positions.push_back (y);
+				chunk->positions.push_back (z);
+			}
+		}
+		else if (tokenLength == 2 && token [0] == 'v' && token [1] == 'n') {
+			float x, y, z;
+			if (ReadFloat (it, end, x) && ReadFloat (it, end, y) && ReadFloat (it, end, z)) {
+				chunk->normals.push_back (x);
+				chunk->normals.push_back (y);
+				chunk->normals.push_back (z);
+			}
+		}
+		else if (tokenLength == 2 && token [0] == 'v' && token [1] == 't') {
+			float x, y;
+			if (ReadFloat (it, end, x) && ReadFloat (it, end, y)) {
+				chunk->texcoords.push_back (x);
+				chunk->texcoords.push_back (1.0f - y);
+			}
+		}
+		else if (tokenLength == 1 && token [0] == 'f') {
+			ReadFace (it, end, chunk);
+		}
+		else if ((tokenLength == 1 && (token [0] == 'o' || token [0] == 'g')) ||
+			(tokenLength == 6 && (std::strncmp (token, "mtllib", 6) == 0 || std::strncmp (token, "usemtl", 6) == 0))) {
+
+			WavefrontObjectDirective directive;
+			directive.faceIndex = chunk->faces.size ();
+			directive.value = ReadLine (it, end);
+
+			if (token [0] == 'o') {
+				directive.type = WavefrontObjectDirective::OBJECT;
+			}
+			else if (token [0] == 'g') {
+				directive.type = WavefrontObjectDirective::POLYGON_GROUP;
+			}
+			else if (token [0] == 'm') {
+				directive.type = WavefrontObjectDirective::MATERIAL_LIBRARY;
+			} else {
+				directive.type = WavefrontObjectDirective::MATERIAL;
+			}
+
+			chunk->directives.push_back (directive);
+		}
+
+		it = SkipLine (it, end);
+	}
 }
 
-std::pair<ObjectModel*, PolygonGroup*> WavefrontObjectLoader::ReadObject (std::ifstream& file, Model* model)
+void WavefrontObjectLoader::MergeChunks (const std::vector<WavefrontObjectChunk>& chunks,
+	const std::string& filename, Model* model, bool& indexNormalization)
 {
-	std::string objName;
-	std::getline (file, objName);
+	// Add default object models (the syntax can miss)
+	ObjectModel* currentObjModel = new ObjectModel ("DEFAULT");
+	PolygonGroup* currentPolyGroup = new PolygonGroup ("DEFAULT");
+
+	model->AddObjectModel (currentObjModel);
+	currentObjModel->AddPolygonGroup (currentPolyGroup);
+
+	std::string currentMatName;
+
+	std::size_t verticesCount = 0, normalsCount = 0, texcoordsCount = 0;
+
+	for (const WavefrontObjectChunk& chunk : chunks) {
+		verticesCount += chunk.positions.size () / 3;
+		normalsCount += chunk.normals.size () / 3;
+		texcoordsCount += chunk.texcoords.size () / 2;
+	}
+
+	model->ReserveVertices (verticesCount);
+	model->ReserveNormals (normalsCount);
+	model->ReserveTexcoords (texcoordsCount);
+
+	for (const WavefrontObjectChunk& chunk : chunks) {
+		for (std::size_t i=0;i<chunk.positions.size ();i+=3) {
+			model->AddVertex (glm::vec3 (chunk.positions [i], chunk.positions [i + 1], chunk.positions [i + 2]));
+		}
+
+		for (std::size_t i=0;i<chunk.normals.size ();i+=3) {
+			model->AddNormal (glm::vec3 (chunk.normals [i], chunk.normals [i + 1], chunk.normals [i + 2]));
+		}
+
+		for (std::size_t i=0;i<chunk.texcoords.size ();i+=2) {
+			model->AddTexcoord (glm::vec3 (chunk.texcoords [i], chunk.texcoords [i + 1], 0.0f));
+		}
+
+		indexNormalization = indexNormalization || chunk.indexNormalization;
+
+		std::size_t directiveIndex = 0;
+
+		for (std::size_t i=0;i<=chunk.faces.size ();i++) {
+
+			/*
+			 * Apply the statements that precede this face
+			*/
 
-	ObjectModel* objModel = new ObjectModel (objName);
-	model->AddObjectModel (objModel);
+			for (;directiveIndex < chunk.directives.size () &&
+				chunk.directives [directiveIndex].faceIndex == i;directiveIndex++) {
+				const WavefrontObjectDirective& directive = chunk.directives [directiveIndex];
 
-	PolygonGroup* polyGroup = new PolygonGroup ("DEFAULT");
-	objModel->AddPolygonGroup (polyGroup);
+				if (directive.type == WavefrontObjectDirective::MATERIAL_LIBRARY) {
+					LoadMaterialLibrary (directive.value, filename, model);
+				}
+				else if (directive.type == WavefrontObjectDirective::MATERIAL) {
+					currentMatName = directive.value;
+					Extensions::StringExtend::Trim (currentMatName);
+				}
+				else if (directive.type == WavefrontObjectDirective::OBJECT) {
+					currentObjModel = new ObjectModel (directive.value);
+					model->AddObjectModel (currentObjModel);
+
+					currentPolyGroup = new PolygonGroup ("DEFAULT");
+					currentObjModel->AddPolygonGroup (currentPolyGroup);
+				}
+				else if (directive.type == WavefrontObjectDirective::POLYGON_GROUP) {
+					currentPolyGroup = new PolygonGroup (directive.value);
+					currentObjModel->AddPolygonGroup (currentPolyGroup);
+				}
+			}
 
-	return std::make_pair (objModel, polyGroup);
+			if (i == chunk.faces.size ()) {
+				break;
+			}
+
+			const WavefrontObjectFace& face = chunk.faces [i];
+
+			std::size_t vertexEnd = i + 1 < chunk.faces.size () ? chunk.faces [i + 1].vertexOffset : chunk.faceVertices.size ();
+			std::size_t normalEnd = i + 1 < chunk.faces.size () ? chunk.faces [i + 1].normalOffset : chunk.faceNormals.size ();
+			std::size_t texcoordEnd = i + 1 < chunk.faces.size () ? chunk.faces [i + 1].texcoordOffset : chunk.faceTexcoords.size ();
+
+			currentPolyGroup->SetMaterialName (model->GetMaterialLibrary () + "::" + currentMatName);
+
+			currentPolyGroup->AddPolygon (chunk.faceVertices.data () + face.vertexOffset, vertexEnd - face.vertexOffset,
+				chunk.faceNormals.data () + face.normalOffset, normalEnd - face.normalOffset,
+				chunk.faceTexcoords.data () + face.texcoordOffset, texcoordEnd - face.texcoordOffset);
+		}
+	}
 }
 
-PolygonGroup* WavefrontObjectLoader::ReadPolygonGroup (std::ifstream& file, ObjectModel* objModel)
+void WavefrontObjectLoader::LoadMaterialLibrary(const std::string& mtlfilename, const std::string& filename, Model* model)
 {
-	std::string polyName;
-	std::getline (file, polyName);
+	std::string mtlName = mtlfilename;
+	Extensions::StringExtend::Trim (mtlName);
+
+	std::string fullMtlFilename = FileSystem::GetDirectory(filename) + mtlName;
+	fullMtlFilename = FileSystem::FormatFilename (fullMtlFilename);
+
+	Console::Log ("Material name: " + mtlName);
+
+	model->SetMaterialLibrary (fullMtlFilename);
+
+	if (!_loadMaterials) {
+		return;
+	}
 
-	PolygonGroup* polyGroup = new PolygonGroup (polyName);
-	objModel->AddPolygonGroup (polyGroup);
+	MaterialLibrary* mtlLibrary = Resources::LoadMaterialLibrary(fullMtlFilename);
 
-	return polyGroup;
+	for (std::size_t i=0;i<mtlLibrary->GetMaterialsCount ();i++) {
+		MaterialManager::Instance ().AddMaterial (mtlLibrary->GetMaterial (i));
+	}
 }
 
-void WavefrontObjectLoader::ReadFace(std::ifstream& file, Model* model, PolygonGroup* currentPolyGroup, bool& indexNormalization, const std::string& curMatName)
+void WavefrontObjectLoader::ReadFace(const char*& it, const char* end, WavefrontObjectChunk* chunk)
 {
-	std::string line;
+	const char* line = it;
+	const char* lineEnd = SkipLine (it, end);
 
-	std::getline(file, line);
-	Polygon * face = new Polygon();
+	if (lineEnd != line && *(lineEnd - 1) == '\n') {
+		-- lineEnd;
+	}
+
+	std::size_t lineSize = lineEnd - line;
+
+	/*
+	 * Past the end of the line behaves like a string terminator
+	*/
 
-	for (std::size_t i=0;i<line.size();i++) 
+	auto at = [line, lineSize] (std::size_t index) -> char {
+		return index < lineSize ? line [index] : '\0';
+	};
+
+	WavefrontObjectFace face;
+	face.vertexOffset = chunk->faceVertices.size ();
+	face.normalOffset = chunk->faceNormals.size ();
+	face.texcoordOffset = chunk->faceTexcoords.size ();
+
+	for (std::size_t i=0;i<lineSize;i++)
 	{
-		if (!isdigit(line[i]) && line[i] != '-') {
+		if (!std::isdigit((unsigned char) at (i)) && at (i) != '-') {
 			continue;
 		}
 
 		int vertexPosition = 0, vertexTexturePosition = 0, vertexNormalPosition = 0;
 		int vertexSign = 1, uvSign = 1, normalSign = 1;
-		if (line[i] == '-' || isdigit(line[i])) {
-			if (line [i] == '-') {
-				vertexSign = -1;
-				indexNormalization = true;
-				i ++;
-			}
 
-			for (;isdigit(line[i]);i++) {
-				vertexPosition = vertexPosition * 10 + line[i]-'0';
-			}
+		if (at (i) == '-') {
+			vertexSign = -1;
+			chunk->indexNormalization = true;
+			i ++;
+		}
 
-			vertexPosition *= vertexSign;
+		for (;std::isdigit((unsigned char) at (i));i++) {
+			vertexPosition = vertexPosition * 10 + at (i) - '0';
 		}
 
-		if (line[i] == '/') {
+		vertexPosition *= vertexSign;
+
+		if (at (i) == '/') {
 
 			i ++;
 
-			if (line [i] == '-') {
+			if (at (i) == '-') {
 				uvSign = -1;
-				indexNormalization = true;
+				chunk->indexNormalization = true;
 				++ i;
 			}
 
-			for (;isdigit(line[i]);i++) {
-				vertexTexturePosition = vertexTexturePosition * 10 + line[i] - '0';
+			for (;std::isdigit((unsigned char) at (i));i++) {
+				vertexTexturePosition = vertexTexturePosition * 10 + at (i) - '0';
 			}
 
 			vertexTexturePosition *= uvSign;
 
-			if (line[i] == '/') {
+			if (at (i) == '/') {
 				i++;
 
-				if (line [i] == '-') {
+				if (at (i) == '-') {
 					normalSign = -1;
-					indexNormalization = true;
+					chunk->indexNormalization = true;
 					++ i;
 				}
 
-				for (;isdigit(line[i]);i++) {
-					vertexNormalPosition = vertexNormalPosition * 10 + line[i] - '0';
+				for (;std::isdigit((unsigned char) at (i));i++) {
+					vertexNormalPosition = vertexNormalPosition * 10 + at (i) - '0';
 				}
 
 				vertexNormalPosition *= normalSign;
 			}
 		}
 
-		face->AddVertex (vertexPosition-1);
+		chunk->faceVertices.push_back (vertexPosition-1);
 
 		if (vertexNormalPosition != 0) {
-			face->AddNormal (vertexNormalPosition-1);
+			chunk->faceNormals.push_back (vertexNormalPosition-1);
 		}
-		
+
 		if (vertexTexturePosition != 0) {
-			face->AddTexcoord (vertexTexturePosition-1);
+			chunk->faceTexcoords.push_back (vertexTexturePosition-1);
 		}
 	}
 
-	currentPolyGroup->SetMaterialName (model->GetMaterialLibrary () + "::" + curMatName);
+	chunk->faces.push_back (face);
 
-	currentPolyGroup->AddPolygon (face);
+	it = lineEnd;
 }
 
 // If faces are declared by the absolute positions (-1 = latest position,
@@ -295,3 +493,150 @@ void WavefrontObjectLoader::IndexNormalization (Model* model)
 		}
 	}
 }
+
+const char* WavefrontObjectLoader::SkipLine (const char* it, const char* end)
+{
+	const char* lineEnd = (const char*) std::memchr (it, '\n', end - it);
+
+	return lineEnd != nullptr ? lineEnd + 1 : end;
+}
+
+const char* WavefrontObjectLoader::SkipBlanks (const char* it, const char* end)
+{
+	while (it != end && *it != '\n' && std::isspace ((unsigned char) *it)) {
+		++ it;
+	}
+
+	return it;
+}
+
+/*
+ * Everything from the current position until the end of the line,
+ * without the line terminator
+*/
+
+std::string WavefrontObjectLoader::ReadLine (const char*& it, const char* end)
+{
+	const char* lineEnd = (const char*) std::memchr (it, '\n', end - it);
+
+	if (lineEnd == nullptr) {
+		lineEnd = end;
+	}
+
+	std::string line (it, lineEnd);
+
+	it = lineEnd;
+
+	return line;
+}
+
+/*
+ * Locale independent float parsing. Decimals with at most 19 significant
+ * digits and a small exponent are converted exactly in double precision
+ * and then narrowed. The narrowing is skipped when the double lands on a
+ * midpoint between two floats, since rounding twice could differ from the
+ * correctly rounded result. Those and all other cases fall back to the
+ * classic locale stream conversion, so the values are always identical to
+ * the ones std::ifstream produces.
+*/
+
+bool WavefrontObjectLoader::ReadFloat (const char*& it, const char* end, float& value)
+{
+	static const double powersOfTen [] = {
+		1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+		1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+	};
+
+	it = SkipBlanks (it, end);
+
+	const char* start = it;
+
+	bool negative = false;
+	if (it != end && (*it == '-' || *it == '+')) {
+		negative = *it == '-';
+		++ it;
+	}
+
+	uint64_t mantissa = 0;
+	int significantDigits = 0;
+	int exponent = 0;
+	bool haveDigits = false;
+	bool truncated = false;
+
+	for (;it != end && std::isdigit ((unsigned char) *it);++ it) {
+		haveDigits = true;
+
+		if (significantDigits < 19) {
+			mantissa = mantissa * 10 + (*it - '0');
+			significantDigits += mantissa != 0;
+		} else {
+			truncated = truncated || *it != '0';
+			++ exponent;
+		}
+	}
+
+	if (it != end && *it == '.') {
+		++ it;
+
+		for (;it != end && std::isdigit ((unsigned char) *it);++ it) {
+			haveDigits = true;
+
+			if (significantDigits < 19) {
+				mantissa = mantissa * 10 + (*it - '0');
+				significantDigits += mantissa != 0;
+				-- exponent;
+			} else {
+				truncated = truncated || *it != '0';
+			}
+		}
+	}
+
+	if (!haveDigits) {
+		it = start;
+		return false;
+	}
+
+	if (it != end && (*it == 'e' || *it == 'E')) {
+		const char* exponentStart = it;
+		++ it;
+
+		int exponentSign = 1;
+		if (it != end && (*it == '-' || *it == '+')) {
+			exponentSign = *it == '-' ? -1 : 1;
+			++ it;
+		}
+
+		if (it != end && std::isdigit ((unsigned char) *it)) {
+			int explicitExponent = 0;
+
+			for (;it != end && std::isdigit ((unsigned char) *it);++ it) {
+				explicitExponent = std::min (explicitExponent * 10 + (*it - '0'), 100000);
+			}
+
+			exponent += exponentSign * explicitExponent;
+		} else {
+			it = exponentStart;
+		}
+	}
+
+	if (!truncated && mantissa <= (1ull << 53) && exponent >= -22 && exponent <= 22) {
+		double result = (double) mantissa;
+		result = exponent < 0 ? result / powersOfTen [-exponent] : result * powersOfTen [exponent];
+
+		uint64_t bits;
+		std::memcpy (&bits, &result, sizeof (bits));
+
+		bool midpoint = (bits & 0x1FFFFFFFull) == 0x10000000ull;
+
+		if (result == 0.0 || (result >= FLT_MIN && result <= FLT_MAX && !midpoint)) {
+			value = (float) (negative ? -result : result);
+			return true;
+		}
+	}
+
+	std::istringstream stream (std::string (start, it));
+	stream.imbue (std::locale::classic ());
+	stream >> value;
+
+	return !stream.fail ();
+}
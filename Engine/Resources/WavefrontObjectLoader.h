@@ -4,26 +4,88 @@
 #include "ResourceLoader.h"
 
 #include <string>
+#include <vector>
 
 #include "Mesh/Model.h"
 #include "Mesh/PolygonGroup.h"
 #include "Mesh/ObjectModel.h"
 
+/*
+ * Statements that change the loader state. They are replayed in file
+ * order while the parsed chunks are merged.
+*/
+
+struct WavefrontObjectDirective
+{
+	enum DirectiveType {MATERIAL_LIBRARY, MATERIAL, OBJECT, POLYGON_GROUP};
+
+	DirectiveType type;
+	std::size_t faceIndex;
+	std::string value;
+};
+
+/*
+ * Face corners are stored flat, every face keeps only the offsets where
+ * its indices start. The ranges end where the next face starts.
+*/
+
+struct WavefrontObjectFace
+{
+	std::size_t vertexOffset;
+	std::size_t normalOffset;
+	std::size_t texcoordOffset;
+};
+
+/*
+ * Line aligned slice of the file together with everything that was
+ * parsed from it. Attributes are kept as flat arrays.
+*/
+
+struct WavefrontObjectChunk
+{
+	const char* begin;
+	const char* end;
+
+	std::vector<float> positions;
+	std::vector<float> normals;
+	std::vector<float> texcoords;
+
+	std::vector<WavefrontObjectFace> faces;
+	std::vector<int> faceVertices;
+	std::vector<int> faceNormals;
+	std::vector<int> faceTexcoords;
+
+	std::vector<WavefrontObjectDirective> directives;
+
+	bool indexNormalization;
+
+	WavefrontObjectChunk ();
+};
+
 class WavefrontObjectLoader : public ResourceLoader
 {
+protected:
+	bool _loadMaterials;
+
 public:
+	WavefrontObjectLoader();
+
 	Object* Load(const std::string& fileName);
-private:
-	void ProcessComment(std::ifstream& file);
-	void LoadMaterialLibrary(std::ifstream& file, const std::string& filename, Model* model);
-	void ReadVertex(std::ifstream& file, Model* model);
-	void ReadNormal(std::ifstream& file, Model* model);
-	void ReadTexcoord(std::ifstream& file, Model* model);
-	void ReadCurrentMtlName(std::ifstream& file, std::string& mtlName);
-	void ReadFace(std::ifstream& file, Model* model, PolygonGroup* polyGroup, bool& indexNorm, const std::string& curMatName);
-	std::pair<ObjectModel*, PolygonGroup*> ReadObject(std::ifstream& file, Model* model);
-	PolygonGroup* ReadPolygonGroup(std::ifstream& file, ObjectModel* objModel);
+
+	void SetLoadMaterials(bool loadMaterials);
+protected:
+	std::vector<WavefrontObjectChunk> SplitChunks(const char* data, std::size_t size);
+	void ParseChunk(WavefrontObjectChunk* chunk);
+	void MergeChunks(const std::vector<WavefrontObjectChunk>& chunks, const std::string& filename, Model* model, bool& indexNorm);
+
+	void LoadMaterialLibrary(const std::string& mtlfilename, const std::string& filename, Model* model);
+	void ReadFace(const char*& it, const char* end, WavefrontObjectChunk* chunk);
 	void IndexNormalization(Model* model);
+
+	static const char* SkipLine(const char* it, const char* end);
+	static const char* SkipBlanks(const char* it, const char* end);
+	static std::string ReadLine(const char*& it, const char* end);
+	static bool ReadFloat(const char*& it, const char* end, float& value);
 };
 
-#endif
\ No newline at end of file
+#endif
@@ -8,10 +8,14 @@
 
 #include "Systems/Physics/PhysicsSystem.h"
 
+#include "Utils/Threads/JobSystem.h"
+
 #include "Core/Console/Console.h"
 
 Scene::Scene () :
 	_sceneObjects (),
+	_boundingVolumeHierarchy (),
+	_isBoundingVolumeHierarchyDirty (true),
 	_name (""),
 	_boundingBox (new AABBVolume (new AABBVolume::AABBVolumeInformation ()))
 {
@@ -46,6 +50,10 @@ void Scene::AttachObject (SceneObject* object)
 	*/
 
 	UpdateBoundingBox (object);
+
+	_isBoundingVolumeHierarchyDirty = true;
+
+	PhysicsSystem::Instance ().SetDirty ();
 }
 
 void Scene::DetachObject (SceneObject* object)
@@ -60,7 +68,11 @@ void Scene::DetachObject (SceneObject* object)
 
 	_sceneObjects.erase (it);
 
-	(*it)->OnDetachedFromScene ();
+	object->OnDetachedFromScene ();
+
+	_isBoundingVolumeHierarchyDirty = true;
+
+	PhysicsSystem::Instance ().SetDirty ();
 
 	// TODO: Recalculate Bounding Box when detach object
 }
@@ -88,10 +100,107 @@ AABBVolume* Scene::GetBoundingBox () const
 	return _boundingBox;
 }
 
+/*
+ * Objects refresh their collider on update when their transform changed,
+ * their boxes are refit in the hierarchy afterwards
+*/
+
 void Scene::Update()
 {
-	for (SceneObject* sceneObject : *this) {
+	for (std::size_t index = 0; index < _sceneObjects.size (); index++) {
+		SceneObject* sceneObject = _sceneObjects [index];
+
+		if (!sceneObject->IsActive ()) {
+			continue;
+		}
+
+		bool isDirty = sceneObject->GetTransform ()->IsDirty ();
+
 		sceneObject->Update ();
+
+		if (!isDirty || sceneObject->GetCollider () == nullptr ||
+			_isBoundingVolumeHierarchyDirty) {
+			continue;
+		}
+
+		AABBVolume* boundingBox = dynamic_cast<AABBVolume*> (sceneObject->GetCollider ()->GetGeometricPrimitive ());
+
+		if (boundingBox == nullptr) {
+			continue;
+		}
+
+		AABBVolume::AABBVolumeInformation* volume = boundingBox->GetVolumeInformation ();
+
+		_boundingVolumeHierarchy.Refit (index, volume->minVertex, volume->maxVertex);
+	}
+}
+
+/*
+ * Active objects with a collider visible from each frustum, in the list of
+ * the same index. All the frustums are tested in a single traversal of
+ * the hierarchy, split over the job system when the hierarchy is large.
+*/
+
+void Scene::GetVisibleObjects (const std::vector<FrustumVolume*>& frustums,
+	std::vector<std::vector<SceneObject*>>& visibleObjects)
+{
+	UpdateBoundingVolumeHierarchy ();
+
+	std::vector<std::vector<std::size_t>> visibleItems;
+
+	if (_boundingVolumeHierarchy.GetNodesCount () < SCENE_PARALLEL_QUERY_NODES_COUNT) {
+		_boundingVolumeHierarchy.Query (frustums, visibleItems);
+	} else {
+		QueryParallel (frustums, visibleItems);
+	}
+
+	visibleObjects.resize (frustums.size ());
+
+	for (std::size_t view = 0; view < frustums.size (); view++) {
+		visibleObjects [view].clear ();
+
+		/*
+		 * Keep the order of the scene
+		*/
+
+		std::sort (visibleItems [view].begin (), visibleItems [view].end ());
+
+		for (std::size_t item : visibleItems [view]) {
+			if (_sceneObjects [item]->IsActive ()) {
+				visibleObjects [view].push_back (_sceneObjects [item]);
+			}
+		}
+	}
+}
+
+/*
+ * Every subtree is walked into its own lists, which are joined in the
+ * order of the subtrees
+*/
+
+void Scene::QueryParallel (const std::vector<FrustumVolume*>& frustums,
+	std::vector<std::vector<std::size_t>>& visibleItems)
+{
+	std::vector<BoundingVolumeHierarchy::QuerySubtree> subtrees;
+
+	_boundingVolumeHierarchy.SplitQuery (frustums, SCENE_PARALLEL_QUERY_DEPTH, subtrees);
+
+	std::vector<std::vector<std::vector<std::size_t>>> subtreesItems (subtrees.size ());
+
+	JobSystem::Instance ()->ParallelFor (subtrees.size (), 1,
+		[this, &frustums, &subtrees, &subtreesItems] (std::size_t begin, std::size_t end) {
+			for (std::size_t index = begin; index < end; index++) {
+				_boundingVolumeHierarchy.Query (frustums, subtrees [index], subtreesItems [index]);
+			}
+		});
+
+	visibleItems.assign (frustums.size (), std::vector<std::size_t> ());
+
+	for (std::size_t index = 0; index < subtrees.size (); index++) {
+		for (std::size_t view = 0; view < frustums.size (); view++) {
+			visibleItems [view].insert (visibleItems [view].end (),
+				subtreesItems [index][view].begin (), subtreesItems [index][view].end ());
+		}
 	}
 }
 
@@ -147,6 +256,44 @@ void Scene::UpdateBoundingBox (SceneObject* sceneObject)
 	DEBUG_LOG ("Max vertex: " + glm::to_string (volume->maxVertex));
 }
 
+/*
+ * The hierarchy is built again only when objects were attached or
+ * detached, moving objects are refit on update
+*/
+
+void Scene::UpdateBoundingVolumeHierarchy ()
+{
+	if (!_isBoundingVolumeHierarchyDirty) {
+		return;
+	}
+
+	std::vector<std::size_t> items;
+	std::vector<glm::vec3> minVertices;
+	std::vector<glm::vec3> maxVertices;
+
+	for (std::size_t index = 0; index < _sceneObjects.size (); index++) {
+		if (_sceneObjects [index]->GetCollider () == nullptr) {
+			continue;
+		}
+
+		AABBVolume* boundingBox = dynamic_cast<AABBVolume*> (_sceneObjects [index]->GetCollider ()->GetGeometricPrimitive ());
+
+		if (boundingBox == nullptr) {
+			continue;
+		}
+
+		AABBVolume::AABBVolumeInformation* volume = boundingBox->GetVolumeInformation ();
+
+		items.push_back (index);
+		minVertices.push_back (volume->minVertex);
+		maxVertices.push_back (volume->maxVertex);
+	}
+
+	_boundingVolumeHierarchy.Build (items, minVertices, maxVertices);
+
+	_isBoundingVolumeHierarchyDirty = false;
+}
+
 SceneIterator Scene::begin ()
 {
 	return SceneIterator (this, 0);
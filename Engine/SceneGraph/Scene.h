@@ -8,9 +8,20 @@
 #include "Skybox/Skybox.h"
 
 #include "Core/Intersections/AABBVolume.h"
+#include "Core/Intersections/FrustumVolume.h"
+#include "Core/Intersections/BoundingVolumeHierarchy.h"
 
 #include "SceneIterator.h"
 
+/*
+ * Hierarchies with fewer nodes are queried by the calling thread alone,
+ * larger ones are split in the subtrees at the given depth, walked as
+ * jobs
+*/
+
+#define SCENE_PARALLEL_QUERY_NODES_COUNT 2048
+#define SCENE_PARALLEL_QUERY_DEPTH 5
+
 class SceneIterator;
 
 class Scene
@@ -19,6 +30,8 @@ class Scene
 
 private:
 	std::vector<SceneObject*> _sceneObjects;
+	BoundingVolumeHierarchy _boundingVolumeHierarchy;
+	bool _isBoundingVolumeHierarchyDirty;
 protected:
 	std::string _name;
 	Skybox* _skybox;
@@ -44,12 +57,19 @@ public:
 	std::size_t GetObjectsCount () const;	
 	AABBVolume* GetBoundingBox () const;
 
+	void GetVisibleObjects (const std::vector<FrustumVolume*>& frustums,
+		std::vector<std::vector<SceneObject*>>& visibleObjects);
+
 	SceneIterator begin ();
 	SceneIterator end ();
 
 	void Update ();
 private:
 	void UpdateBoundingBox (SceneObject* object);
+	void UpdateBoundingVolumeHierarchy ();
+
+	void QueryParallel (const std::vector<FrustumVolume*>& frustums,
+		std::vector<std::vector<std::size_t>>& visibleItems);
 };
 
 #endif
\ No newline at end of file
@@ -1,5 +1,9 @@
 #include "Transform.h"
 
+#include "TransformHierarchy.h"
+
+#include "Core/Math/glm/gtc/matrix_inverse.hpp"
+
 Transform* Transform::Default ()
 {
 	static Transform* defaultTransform = new Transform ();
@@ -13,7 +17,8 @@ Transform::Transform () :
 	_scale (1.0f),
 	_parent (NULL),
 	_children (),
-	_isDirty (false)
+	_isDirty (false),
+	_index (TransformHierarchy::Instance ()->Add (this))
 {
 
 }
@@ -25,19 +30,56 @@ Transform::Transform(const Transform& other) :
 	_scale (other._scale),
 	_parent (NULL),
 	_children (),
-	_isDirty (false)
+	_isDirty (false),
+	_index (TransformHierarchy::Instance ()->Add (this))
 {
+	Invalidate ();
 
+	_isDirty = false;
 }
 
+/*
+ * Children keep their place in the world and become roots
+*/
+
+Transform::~Transform ()
+{
+	DetachParent ();
+
+	while (!_children.empty ()) {
+		_children.back ()->DetachParent ();
+	}
+
+	TransformHierarchy::Instance ()->Remove (_index);
+}
+
+/*
+ * The node keeps its place in the world, its local state is moved in
+ * the space of the new parent
+*/
+
 void Transform::SetParent (Transform* parent)
 {
+	if (parent == NULL) {
+		DetachParent ();
+
+		return;
+	}
+
+	glm::vec3 position = GetPosition ();
+	glm::quat rotation = GetRotation ();
+	glm::vec3 scale = GetScale ();
+
+	if (_parent != NULL) {
+		_parent->DetachChild (this);
+	}
+
 	_parent = parent;
 	_parent->AttachChild (this);
 
-	_position -= _parent->GetPosition ();
+	TransformHierarchy::Instance ()->SetParent (_index, _parent->_index);
 
-	_isDirty = true;
+	SetWorld (position, rotation, scale);
 }
 
 void Transform::DetachParent ()
@@ -46,61 +88,83 @@ void Transform::DetachParent ()
 		return ;
 	}
 
-	_parent->DetachChild (this);
+	glm::vec3 position = GetPosition ();
+	glm::quat rotation = GetRotation ();
+	glm::vec3 scale = GetScale ();
 
-	_position += _parent->GetPosition ();
+	_parent->DetachChild (this);
 
 	_parent = NULL;
 
-	_isDirty = true;
+	TransformHierarchy::Instance ()->SetParent (_index, TRANSFORM_HIERARCHY_INVALID_INDEX);
+
+	SetWorld (position, rotation, scale);
 }
 
-glm::vec3 Transform::GetPosition () const
+Transform* Transform::GetParent () const
 {
-	glm::vec3 position (_position);
+	return _parent;
+}
 
-	for (Transform* parent = _parent; parent;parent = parent->_parent) {
-		position += parent->_position;
-	}
+const std::vector<Transform*>& Transform::GetChildren () const
+{
+	return _children;
+}
 
-	return position;
+glm::vec3 Transform::GetPosition () const
+{
+	return glm::vec3 (TransformHierarchy::Instance ()->GetWorldMatrix (_index) [3]);
 }
 
 glm::quat Transform::GetRotation () const
 {
-	return _rotation;
+	return TransformHierarchy::Instance ()->GetWorldRotation (_index);
 }
 
 glm::vec3 Transform::GetScale () const
 {
-	glm::vec3 scale (_scale);
+	return TransformHierarchy::Instance ()->GetWorldScale (_index);
+}
 
-	for (Transform* parent = _parent;parent;parent = parent->_parent) {
-		scale *= parent->_scale;
-	}
+glm::mat4 Transform::GetModelMatrix () const
+{
+	return TransformHierarchy::Instance ()->GetWorldMatrix (_index);
+}
+
+glm::vec3 Transform::GetLocalPosition () const
+{
+	return _position;
+}
 
-	return scale;
+glm::quat Transform::GetLocalRotation () const
+{
+	return _rotation;
+}
+
+glm::vec3 Transform::GetLocalScale () const
+{
+	return _scale;
 }
 
 void Transform::SetPosition (const glm::vec3& position)
 {
 	_position = position;
 
-	_isDirty = true;
+	Invalidate ();
 }
 
 void Transform::SetRotation (const glm::quat& rotation)
 {
 	_rotation = rotation;
 
-	_isDirty = true;
+	Invalidate ();
 }
 
 void Transform::SetScale (const glm::vec3& scale)
 {
 	_scale = scale;
 
-	_isDirty = true;
+	Invalidate ();
 }
 
 Transform & Transform::operator=(const Transform& other)
@@ -109,7 +173,7 @@ Transform & Transform::operator=(const Transform& other)
 	_rotation = other._rotation;
 	_scale = other._scale;
 
-	_isDirty = true;
+	Invalidate ();
 
 	return *this;
 }
@@ -126,17 +190,69 @@ void Transform::SetIsDirty (bool isDirty)
 
 void Transform::AttachChild (Transform* transform)
 {
-	_children.push_back (this);
+	_children.push_back (transform);
 }
 
 void Transform::DetachChild (Transform* transform)
 {
 	for (std::size_t i=0;i<_children.size ();i++) {
-		if (_children [i] == this) {
+		if (_children [i] == transform) {
 			_children [i] = _children.back ();
 			_children.pop_back ();
 
 			break;
 		}
 	}
+}
+
+/*
+ * Local state that puts the node at the given world state under its
+ * current parent
+*/
+
+void Transform::SetWorld (const glm::vec3& position, const glm::quat& rotation, const glm::vec3& scale)
+{
+	if (_parent == NULL) {
+		_position = position;
+		_rotation = rotation;
+		_scale = scale;
+	} else {
+		glm::mat4 parentInverse = glm::inverse (_parent->GetModelMatrix ());
+
+		_position = glm::vec3 (parentInverse * glm::vec4 (position, 1.0f));
+		_rotation = glm::inverse (_parent->GetRotation ()) * rotation;
+		_scale = scale / _parent->GetScale ();
+	}
+
+	Invalidate ();
+}
+
+/*
+ * The world state of the whole subtree is stale
+*/
+
+void Transform::Invalidate ()
+{
+	TransformHierarchy* hierarchy = TransformHierarchy::Instance ();
+
+	hierarchy->SetLocal (_index, _position, _rotation, _scale);
+
+	if (_children.empty ()) {
+		_isDirty = true;
+		hierarchy->SetWorldDirty (_index);
+
+		return;
+	}
+
+	std::vector<Transform*> stack (1, this);
+
+	while (!stack.empty ()) {
+		Transform* transform = stack.back ();
+		stack.pop_back ();
+
+		transform->_isDirty = true;
+		hierarchy->SetWorldDirty (transform->_index);
+
+		stack.insert (stack.end (), transform->_children.begin (), transform->_children.end ());
+	}
 }
\ No newline at end of file
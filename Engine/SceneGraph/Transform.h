@@ -4,10 +4,22 @@
 #include <vector>
 
 #include "Core/Math/glm/vec3.hpp"
+#include "Core/Math/glm/mat4x4.hpp"
 #include "Core/Math/glm/gtc/quaternion.hpp"
 
+/*
+ * Local position, rotation and scale of a node in its parent space. The
+ * world state is cached in the transform hierarchy and computed again
+ * only after the node or one of its ancestors changed.
+ *
+ * The dirty flag tells that the world state changed since the owner last
+ * cleared it, it is set on the whole subtree of a changed node.
+*/
+
 class Transform
 {
+	friend class TransformHierarchy;
+
 private:
 	glm::vec3 _position;
 	glm::quat _rotation;
@@ -18,19 +30,27 @@ private:
 
 	bool _isDirty;
 
+	std::size_t _index;
+
 public:
 	Transform ();
 	Transform (const Transform& other);
+	~Transform ();
 
 	static Transform* Default ();
 
 	void SetParent (Transform* parent);
 	void DetachParent ();
 
+	Transform* GetParent () const;
+	const std::vector<Transform*>& GetChildren () const;
+
 	glm::vec3 GetPosition () const;
 	glm::quat GetRotation () const;
 	glm::vec3 GetScale () const;
 
+	glm::mat4 GetModelMatrix () const;
+
 	glm::vec3 GetLocalPosition () const;
 	glm::quat GetLocalRotation () const;
 	glm::vec3 GetLocalScale () const;
@@ -46,6 +66,9 @@ public:
 private:
 	void AttachChild (Transform* transform);
 	void DetachChild (Transform* transform);
+
+	void SetWorld (const glm::vec3& position, const glm::quat& rotation, const glm::vec3& scale);
+	void Invalidate ();
 };
 
 #endif
\ No newline at end of file
@@ -0,0 +1,287 @@
+#include "TransformHierarchy.h"
+
+#include "Transform.h"
+
+
+TransformHierarchy::TransformHierarchy () :
+	_owners (),
+	_parents (),
+	_localMatrices (),
+	_localRotations (),
+	_localScales (),
+	_worldMatrices (),
+	_worldRotations (),
+	_worldScales (),
+	_isWorldDirty (),
+	_isOrderDirty (false),
+	_scratch ()
+{
+
+}
+
+TransformHierarchy::~TransformHierarchy ()
+{
+
+}
+
+/*
+ * A new node has no parent, it is in order at the end of the arrays
+*/
+
+std::size_t TransformHierarchy::Add (Transform* owner)
+{
+	_owners.push_back (owner);
+	_parents.push_back (TRANSFORM_HIERARCHY_INVALID_INDEX);
+
+	_localMatrices.push_back (glm::mat4 (1.0f));
+	_localRotations.push_back (glm::quat ());
+	_localScales.push_back (glm::vec3 (1.0f));
+
+	_worldMatrices.push_back (glm::mat4 (1.0f));
+	_worldRotations.push_back (glm::quat ());
+	_worldScales.push_back (glm::vec3 (1.0f));
+
+	_isWorldDirty.push_back (0);
+
+	return _owners.size () - 1;
+}
+
+/*
+ * The node must have no parent and no children left. Free slots at the
+ * end are dropped, the others are left empty until the next sort.
+*/
+
+void TransformHierarchy::Remove (std::size_t index)
+{
+	_owners [index] = nullptr;
+	_parents [index] = TRANSFORM_HIERARCHY_INVALID_INDEX;
+	_isWorldDirty [index] = 0;
+
+	if (index + 1 != _owners.size ()) {
+		_isOrderDirty = true;
+
+		return;
+	}
+
+	while (!_owners.empty () && _owners.back () == nullptr) {
+		_owners.pop_back ();
+		_parents.pop_back ();
+		_localMatrices.pop_back ();
+		_localRotations.pop_back ();
+		_localScales.pop_back ();
+		_worldMatrices.pop_back ();
+		_worldRotations.pop_back ();
+		_worldScales.pop_back ();
+		_isWorldDirty.pop_back ();
+	}
+}
+
+/*
+ * The order breaks only if the parent comes after the node, the subtree
+ * of the node is already after it
+*/
+
+void TransformHierarchy::SetParent (std::size_t index, std::size_t parentIndex)
+{
+	_parents [index] = parentIndex;
+
+	if (parentIndex != TRANSFORM_HIERARCHY_INVALID_INDEX && parentIndex > index) {
+		_isOrderDirty = true;
+	}
+}
+
+/*
+ * Same matrix as translate * scale * rotation, without the products of
+ * full matrices
+*/
+
+void TransformHierarchy::SetLocal (std::size_t index, const glm::vec3& position,
+	const glm::quat& rotation, const glm::vec3& scale)
+{
+	glm::mat3 rotationMatrix = glm::mat3_cast (rotation);
+	glm::mat4& localMatrix = _localMatrices [index];
+
+	for (int column = 0; column < 3; column++) {
+		localMatrix [column] = glm::vec4 (scale * rotationMatrix [column], 0.0f);
+	}
+
+	localMatrix [3] = glm::vec4 (position, 1.0f);
+
+	_localRotations [index] = rotation;
+	_localScales [index] = scale;
+}
+
+void TransformHierarchy::SetWorldDirty (std::size_t index)
+{
+	_isWorldDirty [index] = 1;
+}
+
+const glm::mat4& TransformHierarchy::GetWorldMatrix (std::size_t index)
+{
+	Clean (index);
+
+	return _worldMatrices [index];
+}
+
+const glm::quat& TransformHierarchy::GetWorldRotation (std::size_t index)
+{
+	Clean (index);
+
+	return _worldRotations [index];
+}
+
+const glm::vec3& TransformHierarchy::GetWorldScale (std::size_t index)
+{
+	Clean (index);
+
+	return _worldScales [index];
+}
+
+/*
+ * The parent of a node is before it, a single pass in array order sees
+ * every parent clean before its children
+*/
+
+void TransformHierarchy::Update ()
+{
+	if (_isOrderDirty) {
+		Sort ();
+	}
+
+	for (std::size_t index = 0; index < _owners.size (); index++) {
+		if (_isWorldDirty [index] == 0) {
+			continue;
+		}
+
+		ComputeWorld (index);
+	}
+}
+
+std::size_t TransformHierarchy::GetSize () const
+{
+	return _owners.size ();
+}
+
+/*
+ * A dirty node has all its descendants dirty as well, so its clean
+ * ancestors are still valid. Only the dirty part of the chain above the
+ * node is computed, from the top down.
+*/
+
+void TransformHierarchy::Clean (std::size_t index)
+{
+	if (_isWorldDirty [index] == 0) {
+		return;
+	}
+
+	_scratch.clear ();
+
+	for (std::size_t current = index; current != TRANSFORM_HIERARCHY_INVALID_INDEX &&
+		_isWorldDirty [current] != 0; current = _parents [current]) {
+		_scratch.push_back (current);
+	}
+
+	for (std::size_t chainIndex = _scratch.size (); chainIndex > 0; chainIndex--) {
+		ComputeWorld (_scratch [chainIndex - 1]);
+	}
+}
+
+/*
+ * The parent of the node must be clean. World scale and rotation do not
+ * take the shear of non uniform parent scales into account.
+*/
+
+void TransformHierarchy::ComputeWorld (std::size_t index)
+{
+	std::size_t parentIndex = _parents [index];
+
+	if (parentIndex == TRANSFORM_HIERARCHY_INVALID_INDEX) {
+		_worldMatrices [index] = _localMatrices [index];
+		_worldRotations [index] = _localRotations [index];
+		_worldScales [index] = _localScales [index];
+	} else {
+		_worldMatrices [index] = _worldMatrices [parentIndex] * _localMatrices [index];
+		_worldRotations [index] = _worldRotations [parentIndex] * _localRotations [index];
+		_worldScales [index] = _worldScales [parentIndex] * _localScales [index];
+	}
+
+	_isWorldDirty [index] = 0;
+}
+
+/*
+ * Depth first order from the roots, free slots are dropped
+*/
+
+void TransformHierarchy::Sort ()
+{
+	std::vector<Transform*> owners;
+	std::vector<std::size_t> parents;
+	std::vector<glm::mat4> localMatrices;
+	std::vector<glm::quat> localRotations;
+	std::vector<glm::vec3> localScales;
+	std::vector<glm::mat4> worldMatrices;
+	std::vector<glm::quat> worldRotations;
+	std::vector<glm::vec3> worldScales;
+	std::vector<unsigned char> isWorldDirty;
+
+	owners.reserve (_owners.size ());
+	parents.reserve (_owners.size ());
+	localMatrices.reserve (_owners.size ());
+	localRotations.reserve (_owners.size ());
+	localScales.reserve (_owners.size ());
+	worldMatrices.reserve (_owners.size ());
+	worldRotations.reserve (_owners.size ());
+	worldScales.reserve (_owners.size ());
+	isWorldDirty.reserve (_owners.size ());
+
+	std::vector<Transform*> stack;
+
+	for (std::size_t rootIndex = 0; rootIndex < _owners.size (); rootIndex++) {
+		if (_owners [rootIndex] == nullptr || _parents [rootIndex] != TRANSFORM_HIERARCHY_INVALID_INDEX) {
+			continue;
+		}
+
+		stack.push_back (_owners [rootIndex]);
+
+		while (!stack.empty ()) {
+			Transform* transform = stack.back ();
+			stack.pop_back ();
+
+			std::size_t index = transform->_index;
+
+			owners.push_back (transform);
+			localMatrices.push_back (_localMatrices [index]);
+			localRotations.push_back (_localRotations [index]);
+			localScales.push_back (_localScales [index]);
+			worldMatrices.push_back (_worldMatrices [index]);
+			worldRotations.push_back (_worldRotations [index]);
+			worldScales.push_back (_worldScales [index]);
+			isWorldDirty.push_back (_isWorldDirty [index]);
+
+			/*
+			 * The parent was already moved, its index is the new one
+			*/
+
+			parents.push_back (transform->_parent == nullptr ?
+				TRANSFORM_HIERARCHY_INVALID_INDEX : transform->_parent->_index);
+
+			transform->_index = owners.size () - 1;
+
+			for (std::size_t childIndex = transform->_children.size (); childIndex > 0; childIndex--) {
+				stack.push_back (transform->_children [childIndex - 1]);
+			}
+		}
+	}
+
+	_owners.swap (owners);
+	_parents.swap (parents);
+	_localMatrices.swap (localMatrices);
+	_localRotations.swap (localRotations);
+	_localScales.swap (localScales);
+	_worldMatrices.swap (worldMatrices);
+	_worldRotations.swap (worldRotations);
+	_worldScales.swap (worldScales);
+	_isWorldDirty.swap (isWorldDirty);
+
+	_isOrderDirty = false;
+}
\ No newline at end of file
@@ -0,0 +1,77 @@
+#ifndef TRANSFORMHIERARCHY_H
+#define TRANSFORMHIERARCHY_H
+
+#include "Core/Singleton/Singleton.h"
+
+#include <vector>
+#include <limits>
+#include <cstddef>
+
+#include "Core/Math/glm/vec3.hpp"
+#include "Core/Math/glm/mat4x4.hpp"
+#include "Core/Math/glm/gtc/quaternion.hpp"
+
+#define TRANSFORM_HIERARCHY_INVALID_INDEX std::numeric_limits<std::size_t>::max ()
+
+class Transform;
+
+/*
+ * World state of all the transforms, in flat arrays where every parent
+ * comes before its children. A node is marked dirty with its subtree
+ * when it changes. Reading a dirty node computes it and its dirty
+ * ancestors only, the update of each frame refreshes all dirty nodes in
+ * a single pass in array order.
+ *
+ * Nodes are moved when the order has to be restored, a transform keeps
+ * its index up to date through the owner of the node.
+*/
+
+class TransformHierarchy : public Singleton<TransformHierarchy>
+{
+	friend Singleton<TransformHierarchy>;
+
+private:
+	std::vector<Transform*> _owners;
+	std::vector<std::size_t> _parents;
+
+	std::vector<glm::mat4> _localMatrices;
+	std::vector<glm::quat> _localRotations;
+	std::vector<glm::vec3> _localScales;
+
+	std::vector<glm::mat4> _worldMatrices;
+	std::vector<glm::quat> _worldRotations;
+	std::vector<glm::vec3> _worldScales;
+
+	std::vector<unsigned char> _isWorldDirty;
+
+	bool _isOrderDirty;
+
+	std::vector<std::size_t> _scratch;
+
+public:
+	std::size_t Add (Transform* owner);
+	void Remove (std::size_t index);
+
+	void SetParent (std::size_t index, std::size_t parentIndex);
+	void SetLocal (std::size_t index, const glm::vec3& position, const glm::quat& rotation, const glm::vec3& scale);
+	void SetWorldDirty (std::size_t index);
+
+	const glm::mat4& GetWorldMatrix (std::size_t index);
+	const glm::quat& GetWorldRotation (std::size_t index);
+	const glm::vec3& GetWorldScale (std::size_t index);
+
+	void Update ();
+
+	std::size_t GetSize () const;
+private:
+	TransformHierarchy ();
+	~TransformHierarchy ();
+	TransformHierarchy (const TransformHierarchy&);
+	TransformHierarchy& operator=(const TransformHierarchy&);
+
+	void Clean (std::size_t index);
+	void ComputeWorld (std::size_t index);
+	void Sort ();
+};
+
+#endif
\ No newline at end of file
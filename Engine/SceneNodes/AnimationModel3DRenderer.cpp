@@ -3,7 +3,6 @@
 #include <vector>
 
 #include "Core/Math/glm/vec3.hpp"
-#include "Core/Math/glm/gtx/transform.hpp"
 
 #include "Renderer/Pipeline.h"
 
@@ -17,10 +16,11 @@
 #include "Managers/MaterialManager.h"
 
 #include "Wrappers/OpenGL/GL.h"
-#include "Systems/Time/Time.h"
 
 #include "Utils/Conversions/Matrices.h"
 
+#include "Systems/Animation/AnimationSystem.h"
+
 AnimatedVertexData::AnimatedVertexData () : VertexData ()
 {
 	for (std::size_t i=0;i<4;i++) {
@@ -29,13 +29,50 @@ AnimatedVertexData::AnimatedVertexData () : VertexData ()
 	}
 }
 
+AnimationModel3DRenderer::AnimationModel3DRenderer () :
+	Model3DRenderer (),
+	_animationModel (nullptr),
+	_skeletalAnimation (nullptr),
+	_pose ()
+{
+
+}
+
+AnimationModel3DRenderer::AnimationModel3DRenderer (Transform* transform) :
+	Model3DRenderer (transform),
+	_animationModel (nullptr),
+	_skeletalAnimation (nullptr),
+	_pose ()
+{
+
+}
+
+AnimationModel3DRenderer::~AnimationModel3DRenderer ()
+{
+	AnimationSystem::Instance ()->Unregister (this);
+}
+
 void AnimationModel3DRenderer::Attach (Model* model)
 {
+	_optimizerStatistics = MeshOptimizerStatistics ();
+
 	for (std::size_t i=0;i<model->ObjectsCount ();i++) {
 		ProcessObjectModel (model, model->GetObject (i));
 	}
 
+	LogOptimizerStatistics (model);
+
 	_animationModel = dynamic_cast<AnimationModel*> (model);
+
+	/*
+	 * The pose is evaluated with the other animated instances, once per
+	 * frame
+	*/
+
+	_skeletalAnimation = _animationModel->GetSkeletalAnimation ();
+	_skeletalAnimation->InitPose (_pose);
+
+	AnimationSystem::Instance ()->Register (this);
 }
 
 void AnimationModel3DRenderer::Draw ()
@@ -43,30 +80,44 @@ void AnimationModel3DRenderer::Draw ()
 	GL::DepthMask (GL_TRUE);
 
 	Pipeline::SetObjectTransform (_transform);
-	
-	for (std::size_t i=0;i<_drawableObjects.size ();i++) {
-		Material* mat = MaterialManager::Instance ().GetMaterial (_drawableObjects [i].MAT_NAME);
 
-		if (mat == nullptr) {
-			mat = MaterialManager::Instance ().Default ();
-		}
+	/*
+	 * The skeleton pose is the same for all the polygon groups
+	*/
+
+	for (std::size_t i=0;i<_drawableObjects.size ();i++) {
+		Material* mat = MaterialManager::Instance ().GetMaterial (_drawableObjects [i].MAT_ID);
 
 		GL::BlendFunc (mat->blending.first, mat->blending.second);
 
-		Pipeline::SendMaterial (mat, ShaderManager::Instance ()->GetShader ("DEFAULT_ANIMATED"));
+		Shader* shader = ShaderManager::Instance ()->GetShader ("DEFAULT_ANIMATED");
 
-		std::vector<PipelineAttribute> customAttributes = GetCustomAttributes ();
-		Pipeline::SendCustomAttributes ("DEFAULT_ANIMATED", customAttributes);
+		Pipeline::SendMaterial (mat, shader);
+
+		Pipeline::SendBonesTransforms (_pose.bonesTransforms, shader);
 
 		//bind pe containerul de stare de geometrie (vertex array object)
 		GL::BindVertexArray(_drawableObjects [i].VAO_INDEX);
 		//comanda desenare
-		GL::DrawElements (GL_TRIANGLES, _drawableObjects [i].INDEX_COUNT, GL_UNSIGNED_INT, 0);
+		GL::DrawElements (GL_TRIANGLES, _drawableObjects [i].INDEX_COUNT, _drawableObjects [i].INDEX_TYPE, 0);
 	}
 }
 
-// For the moment I clone the vertex/normal/texture tuple for every one
-// Maybe will be a good idea to delete the duplicates, low priority TODO:
+/*
+ * The bones are sent after the material of every polygon group, the
+ * model is drawn as a whole
+*/
+
+void AnimationModel3DRenderer::Collect (DrawList* drawList)
+{
+	Renderer::Collect (drawList);
+}
+
+void AnimationModel3DRenderer::UpdatePose (float time)
+{
+	_skeletalAnimation->Evaluate (_skeletalAnimation->GetAnimationTime (time), _pose);
+}
+
 BufferObject AnimationModel3DRenderer::ProcessPolygonGroup (Model* model, PolygonGroup* polyGroup)
 {
 	AnimationModel* animModel = dynamic_cast<AnimationModel*> (model);
@@ -113,177 +164,17 @@ BufferObject AnimationModel3DRenderer::ProcessPolygonGroup (Model* model, Polygo
 		indexBuffer.push_back (3 * (unsigned int) i + 2);
 	}
 
+	_optimizerStatistics += MeshOptimizer::Optimize (vertexBuffer, indexBuffer);
+
 	BufferObject bufObj = BindVertexData (vertexBuffer, indexBuffer);
 	bufObj.MAT_NAME = polyGroup->GetMaterialName ();
 
 	return bufObj;
 }
 
-std::vector<PipelineAttribute> AnimationModel3DRenderer::GetCustomAttributes ()
-{
-	// Calculate attribute
-	std::vector<glm::mat4> boneTransform (_animationModel->GetBoneCount ());
-
-	BoneTree* boneTree = _animationModel->GetBoneTree ();
-	AnimationsController* animController = _animationModel->GetAnimationsController ();
-	// AnimationContainer* animContainer = animController->GetAnimationContainer ("combinedAnim_0");
-	AnimationContainer* animContainer = animController->GetAnimationContainer ("");
-	glm::mat4 rootMatrix (1.0f);
-
-	glm::mat4 globalInverse = boneTree->GetRoot ()->GetTransform ();
-	globalInverse = glm::inverse (globalInverse);
-
-	float animationTime = Time::GetTime () / 1000;
-	float ticksPerSecond = animContainer->GetTicksPerSecond () != 0 ? animContainer->GetTicksPerSecond () : 25.0f;
-	float timeInTicks = animationTime * ticksPerSecond;
-	animationTime = std::fmod (timeInTicks, animContainer->GetDuration ());
-
-	ProcessBoneTransform (_animationModel, rootMatrix, animContainer, boneTree->GetRoot (), globalInverse, animationTime, boneTransform);
-
-	// Create attribute
-	std::vector<PipelineAttribute> attributes;
-
-	for (std::size_t i=0;i<boneTransform.size ();i++) {
-
-		PipelineAttribute boneTransformAttr;
-
-		boneTransformAttr.type = PipelineAttribute::AttrType::ATTR_MATRIX_4X4F;
-
-		boneTransformAttr.name = "boneTransforms[" + std::to_string (i) + "]";
-
-		boneTransformAttr.matrix = boneTransform [i];
-
-		attributes.push_back (boneTransformAttr);
-	}
-
-	return attributes;
-}
-
-void AnimationModel3DRenderer::ProcessBoneTransform (AnimationModel* animModel, const glm::mat4& parentTransform, 
-	AnimationContainer* animContainer, BoneNode* boneNode, const glm::mat4& inverseGlobalMatrix,
-	float animationTime, std::vector<glm::mat4>& boneTransform)
-{
-	std::string nodeName = boneNode->GetName ();
-	glm::mat4 nodeTransform = boneNode->GetTransform ();
-
-	AnimationNode* animNode = animContainer->GetAnimationNode (nodeName);
-
-	if (animNode != nullptr) {
-		glm::vec3 scaling;
-		CalcInterpolatedScaling (scaling, animationTime, animNode);
-		glm::mat4 scalingM = glm::scale (glm::mat4 (1.0f), scaling);
-
-		glm::quat rotationQ;
-		CalcInterpolatedRotation(rotationQ, animationTime, animNode);
-		glm::mat4 rotationM = glm::mat4_cast (rotationQ);
-
-		glm::vec3 translation;
-		CalcInterpolatedPosition(translation, animationTime, animNode);
-		glm::mat4 translationM = glm::translate (glm::mat4 (1), translation);
-
-		nodeTransform = translationM * rotationM * scalingM;
-	}
-
-	glm::mat4 globalTransformation = parentTransform * nodeTransform;
-
-	BoneInfo* boneInfo = animModel->GetBone (nodeName);
-
-	if (boneInfo != nullptr) {
-		boneTransform [boneInfo->GetID ()] = (inverseGlobalMatrix * globalTransformation) * boneInfo->GetTransformMatrix ();
-	}
-
-	for (std::size_t i=0;i<boneNode->GetChildrenCount ();i++) {
-		ProcessBoneTransform (animModel, globalTransformation, animContainer, boneNode->GetChild (i), 
-			inverseGlobalMatrix, animationTime, boneTransform);
-	}
-}
-
-void AnimationModel3DRenderer::CalcInterpolatedRotation(glm::quat& rotationQ, float animationTime, AnimationNode* animNode)
-{
-	if (animNode->GetRotationKeysCount () == 1) {
-		rotationQ = animNode->GetRotationKey (0).value;
-		return ;
-	}	
-
-	std::size_t rotationIndex = 0;
-	std::size_t nextRotationIndex = 0;
-
-	while (rotationIndex < animNode->GetScalingKeysCount () - 1 &&
-		animNode->GetScalingKey (rotationIndex + 1).time < animationTime) {
-		++ rotationIndex;
-	}
-
-	nextRotationIndex = rotationIndex + 1;
-
-	float deltaTime = animNode->GetRotationKey (nextRotationIndex).time - animNode->GetRotationKey (rotationIndex).time;
-	float factor = (animationTime - animNode->GetRotationKey (rotationIndex).time) / deltaTime;
-
-	const glm::quat& start = animNode->GetRotationKey (rotationIndex).value;
-	const glm::quat& end = animNode->GetRotationKey (nextRotationIndex).value;
-
-	rotationQ = glm::slerp(start, end, (float)factor);
-	rotationQ = glm::normalize (rotationQ);
-}
-
-void AnimationModel3DRenderer::CalcInterpolatedScaling (glm::vec3& scalingV, float animationTime, AnimationNode* animNode)
-{
-	if (animNode->GetScalingKeysCount () == 1) {
-		scalingV = animNode->GetScalingKey (0).value;
-		return ;
-	}	
-
-	std::size_t scalingIndex = 0;
-	std::size_t nextScalingIndex = 0;
-
-	while (scalingIndex < animNode->GetScalingKeysCount () - 1 &&
-		animNode->GetScalingKey (scalingIndex + 1).time < animationTime) {
-		++ scalingIndex;
-	}
-
-	nextScalingIndex = scalingIndex + 1;
-
-	float deltaTime = animNode->GetScalingKey (nextScalingIndex).time - animNode->GetScalingKey (scalingIndex).time;
-	float factor = (animationTime - animNode->GetScalingKey (scalingIndex).time) / deltaTime;
-
-	const glm::vec3& start = animNode->GetScalingKey (scalingIndex).value;
-	const glm::vec3& end = animNode->GetScalingKey (nextScalingIndex).value;
-
-	glm::vec3 delta = end - start;
-
-	scalingV = start + factor * delta;
-} 
-
-void AnimationModel3DRenderer::CalcInterpolatedPosition (glm::vec3& positionV, float animationTime, AnimationNode* animNode)
-{
-	if (animNode->GetPositionKeysCount () == 1) {
-		positionV = animNode->GetPositionKey (0).value;
-		return ;
-	}
-
-	std::size_t positionIndex = 0;
-	std::size_t nextPositionIndex = 0;
-
-	while (positionIndex < animNode->GetPositionKeysCount () - 1 &&
-		animNode->GetPositionKey (positionIndex + 1).time < animationTime) {
-		++ positionIndex;
-	}
-
-	nextPositionIndex = positionIndex + 1;
-
-	float deltaTime = animNode->GetPositionKey (nextPositionIndex).time - animNode->GetPositionKey (positionIndex).time;
-	float factor = (animationTime - (float)animNode->GetPositionKey (positionIndex).time) / deltaTime;
-
-	const glm::vec3& start = animNode->GetPositionKey (positionIndex).value;
-	const glm::vec3& end = animNode->GetPositionKey (nextPositionIndex).value;
- 
-	glm::vec3 delta = end - start;
-
-	positionV = start + factor * delta;
-}
-
 BufferObject AnimationModel3DRenderer::BindVertexData (const std::vector<AnimatedVertexData>& vBuf, const std::vector<unsigned int>& iBuf)
 {
-	unsigned int VAO, VBO, IBO;
+	unsigned int VAO, VBO;
 
 	//creaza vao
 	GL::GenVertexArrays(1 , &VAO);
@@ -294,10 +185,10 @@ BufferObject AnimationModel3DRenderer::BindVertexData (const std::vector<Animate
 	GL::BindBuffer(GL_ARRAY_BUFFER, VBO);
 	GL::BufferData(GL_ARRAY_BUFFER, sizeof(AnimatedVertexData)*vBuf.size(), &vBuf[0], GL_STATIC_DRAW);
 	
+	BufferObject bufferObject;
+
 	//creeaza ibo
-	GL::GenBuffers(1, &IBO);
-	GL::BindBuffer(GL_ELEMENT_ARRAY_BUFFER, IBO);
-	GL::BufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(unsigned int)*iBuf.size(), &iBuf[0], GL_STATIC_DRAW);
+	BindIndexData (iBuf, vBuf.size (), bufferObject);
 	
 	// metoda 1: seteaza atribute folosind pipe-urile interne ce fac legatura OpenGL - GLSL, in shader folosim layout(location = pipe_index)
 	// metoda cea mai buna, specificare explicita prin qualificator layout)
@@ -312,15 +203,9 @@ BufferObject AnimationModel3DRenderer::BindVertexData (const std::vector<Animate
 	GL::EnableVertexAttribArray(4);
 	GL::VertexAttribPointer(4,4,GL_FLOAT,GL_FALSE,sizeof(AnimatedVertexData),(void*)(sizeof(float) * 12));
 
-	//numar de indecsi
-	std::size_t indexCount = iBuf.size();
-
-	BufferObject bufferObject;
 	bufferObject.VAO_INDEX = VAO;
 	bufferObject.VBO_INDEX = VBO;
-	bufferObject.IBO_INDEX = IBO;
 	bufferObject.VBO_INSTANCE_INDEX = 0;
-	bufferObject.INDEX_COUNT = indexCount;
 
 	return bufferObject;
 }
\ No newline at end of file
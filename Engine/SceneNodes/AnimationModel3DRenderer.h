@@ -22,27 +22,24 @@ class AnimationModel3DRenderer : public Model3DRenderer
 {
 protected:
 	AnimationModel* _animationModel;
+	SkeletalAnimation* _skeletalAnimation;
+	SkeletalAnimationPose _pose;
 
 public:
-	using Model3DRenderer::Model3DRenderer;	
+	AnimationModel3DRenderer ();
+	AnimationModel3DRenderer (Transform* transform);
+	~AnimationModel3DRenderer ();
 
 	void Attach (Model* model);
 
 	void Draw ();
+	void Collect (DrawList* drawList);
+
+	void UpdatePose (float time);
 
 protected:
 	BufferObject ProcessPolygonGroup (Model* model, PolygonGroup* polyGroup);
 
-	std::vector<PipelineAttribute> GetCustomAttributes ();
-
-	void ProcessBoneTransform (AnimationModel* animModel, const glm::mat4& parentTransform,
-		AnimationContainer* animContainer, BoneNode* boneNode, const glm::mat4& inverseGlobalMatrix,
-		float animationTime, std::vector<glm::mat4>& boneTransform);
-
-	void CalcInterpolatedScaling (glm::vec3& scaling, float animTime, AnimationNode* animNode);
-	void CalcInterpolatedPosition (glm::vec3& position, float animTime, AnimationNode* animNode);
-	void CalcInterpolatedRotation (glm::quat& rotation, float animTime, AnimationNode* animNode);
-
 	BufferObject BindVertexData (const std::vector<AnimatedVertexData>& vBuf, const std::vector<unsigned int>& iBuf);
 };
 
@@ -3,22 +3,46 @@
 #include <string>
 #include <vector>
 #include <algorithm>
+#include <cstring>
 
 #include "Core/Math/glm/vec3.hpp"
 
 #include "Renderer/Pipeline.h"
+#include "Renderer/DrawList.h"
+#include "Renderer/IndirectDrawBuffer.h"
+#include "Renderer/IndirectDrawCommandBuilder.h"
 
 #include "Material/Material.h"
 #include "Managers/MaterialManager.h"
+#include "Managers/ShaderManager.h"
 #include "Mesh/Polygon.h"
 
+#include "Settings/GeneralSettings.h"
+
 #include "Wrappers/OpenGL/GL.h"
 
+#include "Core/Console/Console.h"
+
 inline bool BufferObjectSorter::operator() (const BufferObject& object1, const BufferObject& object2)
 {
     return object1.MAT_NAME < object2.MAT_NAME;
 }
 
+BufferObject::BufferObject () :
+	VAO_INDEX (0),
+	VBO_INDEX (0),
+	VBO_INSTANCE_INDEX (0),
+	IBO_INDEX (0),
+	MAT_NAME (),
+	MAT_ID (MATERIAL_DEFAULT_ID),
+	INDEX_COUNT (0),
+	INDEX_TYPE (GL_UNSIGNED_INT),
+	ARENA (nullptr),
+	ARENA_RANGE ()
+{
+
+}
+
 VertexData::VertexData ()
 {
 	for (std::size_t i=0;i<3;i++) {
@@ -35,10 +59,14 @@ Model3DRenderer::~Model3DRenderer ()
 
 void Model3DRenderer::Attach (Model* model)
 {
+	_optimizerStatistics = MeshOptimizerStatistics ();
+
 	for (std::size_t i=0;i<model->ObjectsCount ();i++) {
 		ProcessObjectModel (model, model->GetObject (i));
 	}
 
+	LogOptimizerStatistics (model);
+
 	// std::sort (_drawableObjects.begin (), _drawableObjects.end (), BufferObjectSorter());
 }
 
@@ -49,28 +77,117 @@ void Model3DRenderer::Draw ()
 	Pipeline::SetObjectTransform (_transform);
 
 	for (std::size_t i=0;i<_drawableObjects.size ();i++) {
-		// if (i == 0 || _drawableObjects [i].MAT_NAME != _drawableObjects [i-1].MAT_NAME) {
-			Material* mat = MaterialManager::Instance ().GetMaterial (_drawableObjects [i].MAT_NAME);
-
-			if (mat == NULL) {
-				mat = MaterialManager::Instance ().Default ();
-			}
+		if (i == 0 || _drawableObjects [i].MAT_ID != _drawableObjects [i-1].MAT_ID) {
+			Material* mat = MaterialManager::Instance ().GetMaterial (_drawableObjects [i].MAT_ID);
 
 			GL::BlendFunc (mat->blending.first, mat->blending.second);
 
-			Pipeline::SendMaterial (mat);
-		// }
+			Pipeline::SendMaterial (mat, GetShader (mat));
+		}
 
 		//bind pe containerul de stare de geometrie (vertex array object)
 		GL::BindVertexArray(_drawableObjects [i].VAO_INDEX);
 		//comanda desenare
-		GL::DrawElements (GL_TRIANGLES, _drawableObjects [i].INDEX_COUNT, GL_UNSIGNED_INT, 0);
+		if (_drawableObjects [i].ARENA != nullptr) {
+			GL::DrawElementsBaseVertex (GL_TRIANGLES, _drawableObjects [i].INDEX_COUNT, _drawableObjects [i].INDEX_TYPE,
+				(void*) (sizeof (unsigned int) * _drawableObjects [i].ARENA_RANGE.firstIndex), _drawableObjects [i].ARENA_RANGE.firstVertex);
+		} else {
+			GL::DrawElements (GL_TRIANGLES, _drawableObjects [i].INDEX_COUNT, _drawableObjects [i].INDEX_TYPE, 0);
+		}
+	}
+}
+
+/*
+ * Every polygon group is a separate packet, the draw list orders them
+ * together with the groups of the other objects
+*/
+
+void Model3DRenderer::Collect (DrawList* drawList)
+{
+	for (std::size_t i=0;i<_drawableObjects.size ();i++) {
+		Material* mat = MaterialManager::Instance ().GetMaterial (_drawableObjects [i].MAT_ID);
+
+		drawList->AddPacket (this, GetShader (mat), _drawableObjects [i].MAT_ID,
+			_drawableObjects [i].VAO_INDEX, _drawableObjects [i].INDEX_COUNT, _drawableObjects [i].INDEX_TYPE,
+			_drawableObjects [i].ARENA, _drawableObjects [i].ARENA_RANGE);
+	}
+}
+
+/*
+ * The object matrices are added once, all the groups point to them. The
+ * passes that keep a single shader and need no textures batch the groups
+ * by arena only.
+*/
+
+void Model3DRenderer::CollectIndirect (IndirectDrawCommandBuilder* builder, bool isMaterialBatched)
+{
+	std::size_t object = builder->AddObject (_transform->GetModelMatrix ());
+
+	for (std::size_t i=0;i<_drawableObjects.size ();i++) {
+		const BufferObject& bufferObject = _drawableObjects [i];
+
+		std::uint64_t key = IndirectDrawBuffer::BuildBatchKey (bufferObject.ARENA->GetIndex (),
+			isMaterialBatched ? bufferObject.MAT_ID : MATERIAL_DEFAULT_ID);
+
+		builder->AddDraw (key, bufferObject.MAT_ID, object, bufferObject.INDEX_COUNT,
+			bufferObject.ARENA_RANGE.firstIndex, (std::int32_t) bufferObject.ARENA_RANGE.firstVertex);
+	}
+}
+
+bool Model3DRenderer::IsStaticGeometry () const
+{
+	if (_drawableObjects.empty ()) {
+		return false;
+	}
+
+	for (std::size_t i=0;i<_drawableObjects.size ();i++) {
+		if (_drawableObjects [i].ARENA == nullptr) {
+			return false;
+		}
 	}
+
+	return true;
+}
+
+/*
+ * Same shader the pipeline picks for the material when none is given
+*/
+
+Shader* Model3DRenderer::GetShader (Material* material)
+{
+	Shader* shader = ShaderManager::Instance ()->GetShader (material->shaderName);
+
+	if (shader == nullptr) {
+		shader = ShaderManager::Instance ()->GetShader ("DEFAULT");
+	}
+
+	return shader;
+}
+
+/*
+ * Meshes with the VertexData layout share a single arena
+*/
+
+StaticGeometryArena* Model3DRenderer::GetStaticGeometryArena ()
+{
+	static StaticGeometryArena* arena = new StaticGeometryArena (sizeof (VertexData), {
+		{0, 3, 0},
+		{1, 3, sizeof (float) * 3},
+		{2, 2, sizeof (float) * 6}
+	});
+
+	return arena;
 }
 
 void Model3DRenderer::Clear ()
 {
 	for (std::size_t i=0;i<_drawableObjects.size ();i++) {
+		if (_drawableObjects [i].ARENA != nullptr) {
+			_drawableObjects [i].ARENA->Free (_drawableObjects [i].ARENA_RANGE);
+
+			continue;
+		}
+
 		GL::DeleteBuffers(1, &_drawableObjects[i].VBO_INDEX);
 		GL::DeleteBuffers(1, &_drawableObjects[i].VBO_INSTANCE_INDEX);
 		GL::DeleteBuffers(1, &_drawableObjects[i].IBO_INDEX);
@@ -85,15 +202,25 @@ void Model3DRenderer::ProcessObjectModel (Model* model, ObjectModel* objModel)
 {
 	for (std::size_t i=0;i<objModel->GetPolygonCount ();i++) {
 		BufferObject bufObj = ProcessPolygonGroup (model, objModel->GetPolygonGroup (i));
+		bufObj.MAT_ID = MaterialManager::Instance ().GetMaterialID (bufObj.MAT_NAME);
 
 		_drawableObjects.push_back (bufObj);
 	}
 }
 
-// For the moment I clone the vertex/normal/texture tuple for every one
-// Maybe will be a good idea to delete the duplicates, low priority TODO:
 BufferObject Model3DRenderer::ProcessPolygonGroup (Model* model, PolygonGroup* polyGroup)
 {
+	/*
+	 * Baked buffers are already expanded, upload them as they are
+	*/
+
+	if (polyGroup->GetMeshCacheGroup () != nullptr) {
+		BufferObject bufObj = BindMeshCacheGroup (polyGroup->GetMeshCacheGroup ());
+		bufObj.MAT_NAME = polyGroup->GetMaterialName ();
+
+		return bufObj;
+	}
+
 	std::vector<VertexData> vertexBuffer;
 	std::vector<unsigned int> indexBuffer;
 
@@ -129,6 +256,8 @@ BufferObject Model3DRenderer::ProcessPolygonGroup (Model* model, PolygonGroup* p
 		indexBuffer.push_back(3 * (unsigned int)i + 2);
 	}
 
+	_optimizerStatistics += MeshOptimizer::Optimize (vertexBuffer, indexBuffer);
+
 	BufferObject bufObj = BindVertexData (vertexBuffer, indexBuffer);
 	bufObj.MAT_NAME = polyGroup->GetMaterialName ();
 
@@ -137,7 +266,13 @@ BufferObject Model3DRenderer::ProcessPolygonGroup (Model* model, PolygonGroup* p
 
 BufferObject Model3DRenderer::BindVertexData (const std::vector<VertexData>& vBuf, const std::vector<unsigned int>& iBuf)
 {
-	unsigned int VAO, VBO, IBO;
+	BufferObject staticBufferObject;
+
+	if (BindStaticGeometry (vBuf.data (), vBuf.size (), sizeof (VertexData), iBuf, staticBufferObject)) {
+		return staticBufferObject;
+	}
+
+	unsigned int VAO, VBO;
 
 	//creaza vao
 	GL::GenVertexArrays(1 , &VAO);
@@ -148,10 +283,10 @@ BufferObject Model3DRenderer::BindVertexData (const std::vector<VertexData>& vBu
 	GL::BindBuffer(GL_ARRAY_BUFFER, VBO);
 	GL::BufferData(GL_ARRAY_BUFFER, sizeof(VertexData)*vBuf.size(), vBuf.data(), GL_STATIC_DRAW);
 	
+	BufferObject bufferObject;
+
 	//creeaza ibo
-	GL::GenBuffers(1, &IBO);
-	GL::BindBuffer(GL_ELEMENT_ARRAY_BUFFER, IBO);
-	GL::BufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(unsigned int)*iBuf.size(), iBuf.data(), GL_STATIC_DRAW);
+	BindIndexData (iBuf, vBuf.size (), bufferObject);
 	
 	// metoda 1: seteaza atribute folosind pipe-urile interne ce fac legatura OpenGL - GLSL, in shader folosim layout(location = pipe_index)
 	// metoda cea mai buna, specificare explicita prin qualificator layout)
@@ -162,15 +297,157 @@ BufferObject Model3DRenderer::BindVertexData (const std::vector<VertexData>& vBu
 	GL::EnableVertexAttribArray(2);																	//activare pipe 2
 	GL::VertexAttribPointer(2,2,GL_FLOAT,GL_FALSE,sizeof(VertexData),(void*)(sizeof(float) * 6));		//trimite texcoorduri pe pipe 2
 
-	//numar de indecsi
-	std::size_t indexCount = iBuf.size();
+	bufferObject.VAO_INDEX = VAO;
+	bufferObject.VBO_INDEX = VBO;
+	bufferObject.VBO_INSTANCE_INDEX = 0;
+
+	return bufferObject;
+}
+
+BufferObject Model3DRenderer::BindMeshCacheGroup (const MeshCacheGroup* meshCacheGroup)
+{
+	unsigned int VAO, VBO, IBO;
+	std::size_t stride = meshCacheGroup->vertexStride;
+
+	/*
+	 * The arena only keeps 32 bit indices
+	*/
+
+	StaticGeometryArena* arena = GetStaticGeometryArena ();
+
+	if (GeneralSettings::Instance ()->GetIntValue (STATIC_GEOMETRY_SETTING) != 0 &&
+		arena != nullptr && arena->GetVertexStride () <= stride) {
+		BufferObject staticBufferObject;
+		std::vector<unsigned int> indices (meshCacheGroup->indicesCount);
+
+		for (std::size_t i=0;i<meshCacheGroup->indicesCount;i++) {
+			indices [i] = meshCacheGroup->indexSize == sizeof (unsigned short) ?
+				((const unsigned short*) meshCacheGroup->indices) [i] : ((const unsigned int*) meshCacheGroup->indices) [i];
+		}
+
+		/*
+		 * The cache keeps the widest layout, the arena layout is at the
+		 * start of every baked vertex
+		*/
+
+		std::size_t arenaStride = arena->GetVertexStride ();
+		const void* vertices = meshCacheGroup->vertices;
+		std::vector<unsigned char> repackedVertices;
+
+		if (arenaStride != stride) {
+			repackedVertices.resize (arenaStride * meshCacheGroup->verticesCount);
+
+			for (std::size_t i=0;i<meshCacheGroup->verticesCount;i++) {
+				std::memcpy (repackedVertices.data () + i * arenaStride,
+					(const unsigned char*) meshCacheGroup->vertices + i * stride, arenaStride);
+			}
+
+			vertices = repackedVertices.data ();
+		}
+
+		if (BindStaticGeometry (vertices, meshCacheGroup->verticesCount, arenaStride, indices, staticBufferObject)) {
+			return staticBufferObject;
+		}
+	}
+
+	GL::GenVertexArrays(1 , &VAO);
+	GL::BindVertexArray(VAO);
+
+	GL::GenBuffers(1, &VBO);
+	GL::BindBuffer(GL_ARRAY_BUFFER, VBO);
+	GL::BufferData(GL_ARRAY_BUFFER, stride * meshCacheGroup->verticesCount, meshCacheGroup->vertices, GL_STATIC_DRAW);
+
+	GL::GenBuffers(1, &IBO);
+	GL::BindBuffer(GL_ELEMENT_ARRAY_BUFFER, IBO);
+	GL::BufferData(GL_ELEMENT_ARRAY_BUFFER, meshCacheGroup->indexSize * meshCacheGroup->indicesCount, meshCacheGroup->indices, GL_STATIC_DRAW);
+
+	/*
+	 * Baked vertices start with the VertexData layout, any extra
+	 * attributes are placed after it and skipped by the stride
+	*/
+
+	GL::EnableVertexAttribArray(0);
+	GL::VertexAttribPointer(0,3,GL_FLOAT,GL_FALSE,stride,(void*)0);
+	GL::EnableVertexAttribArray(1);
+	GL::VertexAttribPointer(1,3,GL_FLOAT,GL_FALSE,stride,(void*)(sizeof(float) * 3));
+	GL::EnableVertexAttribArray(2);
+	GL::VertexAttribPointer(2,2,GL_FLOAT,GL_FALSE,stride,(void*)(sizeof(float) * 6));
 
 	BufferObject bufferObject;
 	bufferObject.VAO_INDEX = VAO;
 	bufferObject.VBO_INDEX = VBO;
 	bufferObject.IBO_INDEX = IBO;
 	bufferObject.VBO_INSTANCE_INDEX = 0;
-	bufferObject.INDEX_COUNT = indexCount;
+	bufferObject.INDEX_COUNT = meshCacheGroup->indicesCount;
+	bufferObject.INDEX_TYPE = meshCacheGroup->indexSize == sizeof (unsigned short) ? GL_UNSIGNED_SHORT : GL_UNSIGNED_INT;
 
 	return bufferObject;
 }
+
+/*
+ * Uploads the index buffer of the bound vertex array, with 16 bit indices
+ * whenever the vertices allow it
+*/
+
+void Model3DRenderer::BindIndexData (const std::vector<unsigned int>& iBuf, std::size_t verticesCount, BufferObject& bufferObject)
+{
+	unsigned int IBO;
+
+	GL::GenBuffers(1, &IBO);
+	GL::BindBuffer(GL_ELEMENT_ARRAY_BUFFER, IBO);
+
+	if (MeshOptimizer::GetIndexSize (verticesCount) == sizeof (unsigned short)) {
+		std::vector<unsigned short> shortBuf (iBuf.begin (), iBuf.end ());
+
+		GL::BufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(unsigned short)*shortBuf.size(), shortBuf.data(), GL_STATIC_DRAW);
+
+		bufferObject.INDEX_TYPE = GL_UNSIGNED_SHORT;
+	} else {
+		GL::BufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(unsigned int)*iBuf.size(), iBuf.data(), GL_STATIC_DRAW);
+
+		bufferObject.INDEX_TYPE = GL_UNSIGNED_INT;
+	}
+
+	bufferObject.IBO_INDEX = IBO;
+	bufferObject.INDEX_COUNT = iBuf.size ();
+}
+
+/*
+ * Uploads the group in the static geometry arena when the setting is on
+ * and the vertex layout matches the one of the arena. Returns false if
+ * the group needs buffers of its own.
+*/
+
+bool Model3DRenderer::BindStaticGeometry (const void* vertices, std::size_t verticesCount, std::size_t vertexStride,
+	const std::vector<unsigned int>& indices, BufferObject& bufferObject)
+{
+	if (GeneralSettings::Instance ()->GetIntValue (STATIC_GEOMETRY_SETTING) == 0) {
+		return false;
+	}
+
+	StaticGeometryArena* arena = GetStaticGeometryArena ();
+
+	if (arena == nullptr || arena->GetVertexStride () != vertexStride) {
+		return false;
+	}
+
+	if (!arena->Allocate (vertices, verticesCount, indices, bufferObject.ARENA_RANGE)) {
+		return false;
+	}
+
+	bufferObject.VAO_INDEX = arena->GetVertexArray ();
+	bufferObject.INDEX_COUNT = indices.size ();
+	bufferObject.INDEX_TYPE = GL_UNSIGNED_INT;
+	bufferObject.ARENA = arena;
+
+	return true;
+}
+
+void Model3DRenderer::LogOptimizerStatistics (Model* model)
+{
+	if (_optimizerStatistics.verticesBefore == 0) {
+		return;
+	}
+
+	Console::Log ("Mesh " + model->GetName () + " optimized: " + _optimizerStatistics.ToString ());
+}
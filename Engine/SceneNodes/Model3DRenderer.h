@@ -9,6 +9,14 @@
 #include "Mesh/Model.h"
 #include "Mesh/ObjectModel.h"
 #include "Mesh/PolygonGroup.h"
+#include "Mesh/MeshCache.h"
+
+#include "Material/Material.h"
+#include "Shader/Shader.h"
+
+#include "Renderer/StaticGeometryArena.h"
+
+#include "Utils/MeshOptimizer/MeshOptimizer.h"
 
 struct BufferObject
 {
@@ -17,7 +25,13 @@ struct BufferObject
 	unsigned int VBO_INSTANCE_INDEX;
 	unsigned int IBO_INDEX;
 	std::string MAT_NAME;
+	std::size_t MAT_ID;
 	std::size_t INDEX_COUNT;
+	unsigned int INDEX_TYPE;
+	StaticGeometryArena* ARENA;
+	StaticGeometryRange ARENA_RANGE;
+
+	BufferObject ();
 };
 
 struct BufferObjectSorter
@@ -38,6 +52,7 @@ class Model3DRenderer : public Renderer
 {
 protected:
 	std::vector<BufferObject> _drawableObjects;
+	MeshOptimizerStatistics _optimizerStatistics;
 
 public:
 	using Renderer::Renderer;
@@ -47,13 +62,26 @@ public:
 	virtual void Attach (Model* mesh);
 
 	virtual void Draw ();
+	virtual void Collect (DrawList* drawList);
+	virtual void CollectIndirect (IndirectDrawCommandBuilder* builder, bool isMaterialBatched);
+
+	virtual bool IsStaticGeometry () const;
 
 	void Clear ();
 protected:
+	virtual Shader* GetShader (Material* material);
+	virtual StaticGeometryArena* GetStaticGeometryArena ();
+
 	void ProcessObjectModel (Model* model, ObjectModel* objModel);
 	virtual BufferObject ProcessPolygonGroup (Model* model, PolygonGroup* polyGroup);
 
 	virtual BufferObject BindVertexData (const std::vector<VertexData>& vBuf, const std::vector<unsigned int>& iBuf);
+	virtual BufferObject BindMeshCacheGroup (const MeshCacheGroup* meshCacheGroup);
+	void BindIndexData (const std::vector<unsigned int>& iBuf, std::size_t verticesCount, BufferObject& bufferObject);
+	bool BindStaticGeometry (const void* vertices, std::size_t verticesCount, std::size_t vertexStride,
+		const std::vector<unsigned int>& indices, BufferObject& bufferObject);
+
+	void LogOptimizerStatistics (Model* model);
 
 	void ClearCurrentData ();
 };
@@ -18,37 +18,62 @@ NormalMapVertexData::NormalMapVertexData () : VertexData ()
 	}
 }
 
-void NormalMapModel3DRenderer::Draw ()
+Shader* NormalMapModel3DRenderer::GetShader (Material* material)
 {
-	GL::DepthMask (GL_TRUE);
-
-	Pipeline::SetObjectTransform (_transform);
+	return ShaderManager::Instance ()->GetShader ("DEFAULT_NORMAL_MAP");
+}
 
-	for (std::size_t i = 0; i<_drawableObjects.size (); i++) {
-		Material* mat = MaterialManager::Instance ().GetMaterial (_drawableObjects [i].MAT_NAME);
+/*
+ * Meshes with tangents have an arena of their own
+*/
 
-		if (mat == nullptr) {
-			mat = MaterialManager::Instance ().Default ();
-		}
+StaticGeometryArena* NormalMapModel3DRenderer::GetStaticGeometryArena ()
+{
+	static StaticGeometryArena* arena = new StaticGeometryArena (sizeof (NormalMapVertexData), {
+		{0, 3, 0},
+		{1, 3, sizeof (float) * 3},
+		{2, 2, sizeof (float) * 6},
+		{3, 3, sizeof (float) * 8}
+	});
+
+	return arena;
+}
 
-		GL::BlendFunc (mat->blending.first, mat->blending.second);
+BufferObject NormalMapModel3DRenderer::ProcessPolygonGroup (Model* model, PolygonGroup* polyGroup)
+{
+	/*
+	 * Baked buffers are already expanded, upload them as they are
+	*/
 
-		Pipeline::SendMaterial (mat, ShaderManager::Instance ()->GetShader ("DEFAULT_NORMAL_MAP"));
+	if (polyGroup->GetMeshCacheGroup () != nullptr) {
+		BufferObject bufObj = BindMeshCacheGroup (polyGroup->GetMeshCacheGroup ());
+		bufObj.MAT_NAME = polyGroup->GetMaterialName ();
 
-		//bind pe containerul de stare de geometrie (vertex array object)
-		GL::BindVertexArray (_drawableObjects [i].VAO_INDEX);
-		//comanda desenare
-		GL::DrawElements (GL_TRIANGLES, _drawableObjects [i].INDEX_COUNT, GL_UNSIGNED_INT, 0);
+		return bufObj;
 	}
-}
 
-// For the moment I clone the vertex/normal/texture tuple for every one
-// Maybe will be a good idea to delete the duplicates, low priority TODO:
-BufferObject NormalMapModel3DRenderer::ProcessPolygonGroup (Model* model, PolygonGroup* polyGroup)
-{
 	std::vector<NormalMapVertexData> vertexBuffer;
 	std::vector<unsigned int> indexBuffer;
 
+	BuildVertexData (model, polyGroup, vertexBuffer, indexBuffer);
+
+	_optimizerStatistics += MeshOptimizer::Optimize (vertexBuffer, indexBuffer);
+
+	BufferObject bufObj = BindVertexData (vertexBuffer, indexBuffer);
+	bufObj.MAT_NAME = polyGroup->GetMaterialName ();
+
+	return bufObj;
+}
+
+/*
+ * Expand the polygon group into interleaved vertices, one for every
+ * corner. Duplicates are welded later by the mesh optimizer. It does not
+ * touch the GPU, the mesh cache bakes its buffers through it as well.
+*/
+
+void NormalMapModel3DRenderer::BuildVertexData (Model* model, PolygonGroup* polyGroup,
+	std::vector<NormalMapVertexData>& vertexBuffer, std::vector<unsigned int>& indexBuffer)
+{
 	for (std::size_t i = 0; i<polyGroup->GetPolygonCount (); i++) {
 		Polygon* polygon = polyGroup->GetPolygon (i);
 
@@ -93,16 +118,17 @@ BufferObject NormalMapModel3DRenderer::ProcessPolygonGroup (Model* model, Polygo
 		indexBuffer.push_back (3 * (unsigned int) i + 1);
 		indexBuffer.push_back (3 * (unsigned int) i + 2);
 	}
-
-	BufferObject bufObj = BindVertexData (vertexBuffer, indexBuffer);
-	bufObj.MAT_NAME = polyGroup->GetMaterialName ();
-
-	return bufObj;
 }
 
 BufferObject NormalMapModel3DRenderer::BindVertexData (const std::vector<NormalMapVertexData>& vBuf, const std::vector<unsigned int>& iBuf)
 {
-	unsigned int VAO, VBO, IBO;
+	BufferObject staticBufferObject;
+
+	if (BindStaticGeometry (vBuf.data (), vBuf.size (), sizeof (NormalMapVertexData), iBuf, staticBufferObject)) {
+		return staticBufferObject;
+	}
+
+	unsigned int VAO, VBO;
 
 	//creaza vao
 	GL::GenVertexArrays (1, &VAO);
@@ -113,10 +139,10 @@ BufferObject NormalMapModel3DRenderer::BindVertexData (const std::vector<NormalM
 	GL::BindBuffer (GL_ARRAY_BUFFER, VBO);
 	GL::BufferData (GL_ARRAY_BUFFER, sizeof (NormalMapVertexData)*vBuf.size (), &vBuf [0], GL_STATIC_DRAW);
 
+	BufferObject bufferObject;
+
 	//creeaza ibo
-	GL::GenBuffers (1, &IBO);
-	GL::BindBuffer (GL_ELEMENT_ARRAY_BUFFER, IBO);
-	GL::BufferData (GL_ELEMENT_ARRAY_BUFFER, sizeof (unsigned int)*iBuf.size (), &iBuf [0], GL_STATIC_DRAW);
+	BindIndexData (iBuf, vBuf.size (), bufferObject);
 
 	// metoda 1: seteaza atribute folosind pipe-urile interne ce fac legatura OpenGL - GLSL, in shader folosim layout(location = pipe_index)
 	// metoda cea mai buna, specificare explicita prin qualificator layout)
@@ -129,15 +155,27 @@ BufferObject NormalMapModel3DRenderer::BindVertexData (const std::vector<NormalM
 	GL::EnableVertexAttribArray (3);																			//activare pipe 2
 	GL::VertexAttribPointer (3, 3, GL_FLOAT, GL_FALSE, sizeof (NormalMapVertexData), (void*) (sizeof (float) * 8));	//trimite texcoorduri pe pipe 2
 
-	//numar de indecsi
-	std::size_t indexCount = iBuf.size ();
-
-	BufferObject bufferObject;
 	bufferObject.VAO_INDEX = VAO;
 	bufferObject.VBO_INDEX = VBO;
-	bufferObject.IBO_INDEX = IBO;
 	bufferObject.VBO_INSTANCE_INDEX = 0;
-	bufferObject.INDEX_COUNT = indexCount;
+
+	return bufferObject;
+}
+
+BufferObject NormalMapModel3DRenderer::BindMeshCacheGroup (const MeshCacheGroup* meshCacheGroup)
+{
+	BufferObject bufferObject = Model3DRenderer::BindMeshCacheGroup (meshCacheGroup);
+
+	if (bufferObject.ARENA != nullptr) {
+		return bufferObject;
+	}
+
+	/*
+	 * The vertex array and buffer are still bound, add the tangents
+	*/
+
+	GL::EnableVertexAttribArray (3);
+	GL::VertexAttribPointer (3, 3, GL_FLOAT, GL_FALSE, meshCacheGroup->vertexStride, (void*) (sizeof (float) * 8));
 
 	return bufferObject;
 }
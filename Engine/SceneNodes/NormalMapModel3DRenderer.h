@@ -18,15 +18,20 @@ class NormalMapModel3DRenderer : public Model3DRenderer
 public:
 	using Model3DRenderer::Model3DRenderer;
 
-	void Draw ();
+	static void BuildVertexData (Model* model, PolygonGroup* polyGroup,
+		std::vector<NormalMapVertexData>& vBuf, std::vector<unsigned int>& iBuf);
 
 protected:
+	Shader* GetShader (Material* material);
+	StaticGeometryArena* GetStaticGeometryArena ();
+
 	BufferObject ProcessPolygonGroup (Model* model, PolygonGroup* polyGroup);
 
 	BufferObject BindVertexData (const std::vector<NormalMapVertexData>& vBuf, const std::vector<unsigned int>& iBuf);
+	BufferObject BindMeshCacheGroup (const MeshCacheGroup* meshCacheGroup);
 
-	glm::vec3 CalculateNormal (Model* model, Polygon* poly);
-	glm::vec3 CalculateTangent (Model* model, Polygon* poly);
+	static glm::vec3 CalculateNormal (Model* model, Polygon* poly);
+	static glm::vec3 CalculateTangent (Model* model, Polygon* poly);
 };
 
 #endif
\ No newline at end of file
@@ -1,10 +1,13 @@
 #include "TextGUIRenderer.h"
 
+#include <cstring>
+
 #include "Wrappers/OpenGL/GL.h"
 
 #include "Core/Math/glm/glm.hpp"
 
 #include "Renderer/Pipeline.h"
+#include "Renderer/StreamingBuffer.h"
 #include "Systems/Screen/Screen.h"
 
 #include "Managers/TextManager.h"
@@ -31,6 +34,29 @@ TextGUIRenderer::~TextGUIRenderer ()
 
 void TextGUIRenderer::Draw ()
 {
+	if (_isDirty) {
+		UpdateText ();
+
+		_isDirty = false;
+	}
+
+	/*
+	 * The vertices are streamed every frame, the data of the previous
+	 * frame may still be in use
+	*/
+
+	std::size_t vertexSize = 4 * sizeof (float);
+
+	StreamingAllocation allocation = StreamingBuffer::Instance ()->Allocate (_buffer.GetBytesCount (), vertexSize);
+
+	if (allocation.data == nullptr) {
+		return;
+	}
+
+	std::memcpy (allocation.data, _buffer.GetPointer (), _buffer.GetBytesCount ());
+
+	StreamingBuffer::Instance ()->Commit (allocation);
+
 	bool cull, depth, blend;
 	GL::IsEnabled (GL_CULL_FACE, &cull);
 	GL::IsEnabled (GL_DEPTH_TEST, &depth);
@@ -43,20 +69,14 @@ void TextGUIRenderer::Draw ()
 
 	std::vector<PipelineAttribute> uniformAttributes = GetUniformAttributes (_font);
 
-	if (_isDirty) {
-		UpdateText ();
-		FeedVBO (_bufferObject, _buffer, _iBuf);
-
-		_isDirty = false;
-	}
-
 	std::string shaderName = TextManager::Instance ()->GetShaderName ();
 
 	Pipeline::SetShader (ShaderManager::Instance ()->GetShader (shaderName));
 	Pipeline::SendCustomAttributes (shaderName, uniformAttributes);
 	
 	GL::BindVertexArray (_bufferObject.VAO_INDEX);
-	GL::DrawElements(GL_TRIANGLES, _bufferObject.INDEX_COUNT, GL_UNSIGNED_INT, 0);
+	GL::DrawElementsBaseVertex (GL_TRIANGLES, _bufferObject.INDEX_COUNT, GL_UNSIGNED_INT, 0,
+		(GLint) (allocation.offset / vertexSize));
 	
 	if (cull) {
 		GL::Enable (GL_CULL_FACE);
@@ -67,23 +87,29 @@ void TextGUIRenderer::Draw ()
 	}
 }
 
+/*
+ * Every char is a quad with the same index pattern, the index buffer is
+ * filled once for the most chars a text may have. The vertices are read
+ * from the streaming buffer.
+*/
+
 void TextGUIRenderer::CreateVBO (BufferObject& bufferObject, const std::vector<BufferAttribute>& bufferAttributes)
 {
 	std::size_t charLimit = TextManager::Instance ()->GetCharLimits ();
 
+	Buffer<unsigned int> iBuf = CharIndexData (charLimit);
+
 	// Create VAO
 	GL::GenVertexArrays (1, &bufferObject.VAO_INDEX);
 	GL::BindVertexArray (bufferObject.VAO_INDEX);
 
-	// Create VBO
-	GL::GenBuffers(1, &bufferObject.VBO_INDEX);
-	GL::BindBuffer(GL_ARRAY_BUFFER, bufferObject.VBO_INDEX);
-	GL::BufferData(GL_ARRAY_BUFFER, bufferAttributes [0].stride * charLimit, NULL, GL_DYNAMIC_DRAW);
+	// Bind streaming buffer
+	GL::BindBuffer(GL_ARRAY_BUFFER, StreamingBuffer::Instance ()->GetBuffer ());
 
 	// Create IBO
 	GL::GenBuffers(1, &bufferObject.IBO_INDEX);
 	GL::BindBuffer(GL_ELEMENT_ARRAY_BUFFER, bufferObject.IBO_INDEX);
-	GL::BufferData(GL_ELEMENT_ARRAY_BUFFER, bufferAttributes [0].stride * charLimit, NULL, GL_DYNAMIC_DRAW);
+	GL::BufferData(GL_ELEMENT_ARRAY_BUFFER, iBuf.GetBytesCount (), iBuf.GetPointer (), GL_STATIC_DRAW);
 
 	for (BufferAttribute attr : bufferAttributes) {
 		GL::EnableVertexAttribArray (attr.index);
@@ -91,21 +117,6 @@ void TextGUIRenderer::CreateVBO (BufferObject& bufferObject, const std::vector<B
 	}
 }
 
-void TextGUIRenderer::FeedVBO (BufferObject& bufferObject, const Buffer<float>& buffer, const Buffer<unsigned int>& iBuf)
-{
-	GL::BindVertexArray(bufferObject.VAO_INDEX);
-
-	// VBO Update
-	GL::BindBuffer(GL_ARRAY_BUFFER, bufferObject.VBO_INDEX);
-	GL::BufferSubData(GL_ARRAY_BUFFER, 0, buffer.GetBytesCount (), buffer.GetPointer ());
-
-	// IBO Update
-	GL::BindBuffer (GL_ELEMENT_ARRAY_BUFFER, bufferObject.IBO_INDEX);
-	GL::BufferSubData (GL_ELEMENT_ARRAY_BUFFER, 0, iBuf.GetBytesCount (), iBuf.GetPointer ());
-
-	bufferObject.INDEX_COUNT = iBuf.GetSize ();
-}
-
 std::vector<BufferAttribute> TextGUIRenderer::GetBufferAttributes ()
 {
 	std::vector<BufferAttribute> attributes;
@@ -143,12 +154,20 @@ std::vector<PipelineAttribute> TextGUIRenderer::GetUniformAttributes (Font* font
 	return attributes;
 }
 
+/*
+ * Chars over the limit have no indices, they are dropped
+*/
+
 void TextGUIRenderer::UpdateText ()
 {
 	this->Clear ();
 
-	_buffer = CharBufferData (_text, _font, glm::vec2 (_transform->GetScale ().x, _transform->GetScale ().y));
-	_iBuf = CharIndexData (_text.size ());
+	std::size_t charLimit = TextManager::Instance ()->GetCharLimits ();
+	std::string text = _text.substr (0, charLimit);
+
+	_buffer = CharBufferData (text, _font, glm::vec2 (_transform->GetScale ().x, _transform->GetScale ().y));
+
+	_bufferObject.INDEX_COUNT = text.size () * 6;
 }
 
 Buffer<float> TextGUIRenderer::CharBufferData (const std::string& text, Font* font, const glm::vec2& scale)
@@ -230,5 +249,4 @@ void TextGUIRenderer::UpdateText (const std::string& text, Font* font,
 void TextGUIRenderer::Clear ()
 {
 	_buffer.Clear ();
-	_iBuf.Clear ();
 }
\ No newline at end of file
@@ -26,7 +26,6 @@ protected:
 	float _lineLength;
 
 	Buffer<float> _buffer;
-	Buffer<unsigned int> _iBuf;
 	BufferObject _bufferObject;
 
 public:
@@ -40,7 +39,6 @@ public:
 		glm::vec2 screenPos, float lineLength);
 private:
 	void CreateVBO (BufferObject&, const std::vector<BufferAttribute>&);
-	void FeedVBO (BufferObject&, const Buffer<float>&, const Buffer<unsigned int>&);
 
 	std::vector<BufferAttribute> GetBufferAttributes ();
 	std::vector<PipelineAttribute> GetUniformAttributes (Font* font);
@@ -1,9 +1,15 @@
 #include "Shader.h"
 
+#include <cstring>
+
+#include "Core/Math/glm/gtc/type_ptr.hpp"
+
 Shader::Shader (const std::string& name, unsigned int program) :
 	_name(name),
 	_program(program),
-	_uniforms ()
+	_uniforms (),
+	_uniformValues (),
+	_indexedUniforms ()
 {
 
 }
@@ -37,3 +43,115 @@ int Shader::GetUniformLocation (const std::string& name)
 
 	return uniformLocation;
 }
+
+/*
+ * Location of a uniform sent on every draw, kept under an index chosen by
+ * the caller so that it is found without comparing names. The name is
+ * read only by the first lookup.
+*/
+
+int Shader::GetUniformLocation (std::size_t index, const std::string& name)
+{
+	if (index >= _indexedUniforms.size ()) {
+		_indexedUniforms.resize (index + 1, SHADER_UNRESOLVED_UNIFORM);
+	}
+
+	if (_indexedUniforms [index] == SHADER_UNRESOLVED_UNIFORM) {
+		_indexedUniforms [index] = GetUniformLocation (name);
+	}
+
+	return _indexedUniforms [index];
+}
+
+/*
+ * The program must be in use, as for GL::Uniform*
+*/
+
+void Shader::SetUniform (int location, int value)
+{
+	if (UpdateUniformValue (location, &value, sizeof (value))) {
+		GL::Uniform1i (location, value);
+	}
+}
+
+void Shader::SetUniform (int location, const glm::ivec2& value)
+{
+	if (UpdateUniformValue (location, glm::value_ptr (value), sizeof (value))) {
+		GL::Uniform2iv (location, 1, glm::value_ptr (value));
+	}
+}
+
+void Shader::SetUniform (int location, const glm::ivec3& value)
+{
+	if (UpdateUniformValue (location, glm::value_ptr (value), sizeof (value))) {
+		GL::Uniform3iv (location, 1, glm::value_ptr (value));
+	}
+}
+
+void Shader::SetUniform (int location, float value)
+{
+	if (UpdateUniformValue (location, &value, sizeof (value))) {
+		GL::Uniform1f (location, value);
+	}
+}
+
+void Shader::SetUniform (int location, const glm::vec2& value)
+{
+	if (UpdateUniformValue (location, glm::value_ptr (value), sizeof (value))) {
+		GL::Uniform2fv (location, 1, glm::value_ptr (value));
+	}
+}
+
+void Shader::SetUniform (int location, const glm::vec3& value)
+{
+	if (UpdateUniformValue (location, glm::value_ptr (value), sizeof (value))) {
+		GL::Uniform3fv (location, 1, glm::value_ptr (value));
+	}
+}
+
+void Shader::SetUniform (int location, const glm::mat3& value)
+{
+	if (UpdateUniformValue (location, glm::value_ptr (value), sizeof (value))) {
+		GL::UniformMatrix3fv (location, 1, GL_FALSE, glm::value_ptr (value));
+	}
+}
+
+void Shader::SetUniform (int location, const glm::mat4& value)
+{
+	if (UpdateUniformValue (location, glm::value_ptr (value), sizeof (value))) {
+		GL::UniformMatrix4fv (location, 1, GL_FALSE, glm::value_ptr (value));
+	}
+}
+
+void Shader::SetUniform (int location, const std::vector<glm::mat4>& values)
+{
+	if (values.empty ()) {
+		return;
+	}
+
+	if (UpdateUniformValue (location, values.data (), sizeof (glm::mat4) * values.size ())) {
+		GL::UniformMatrix4fv (location, values.size (), GL_FALSE, glm::value_ptr (values [0]));
+	}
+}
+
+/*
+ * Store the value of the uniform, returns false when the location is not
+ * active in the program or it already holds the same value
+*/
+
+bool Shader::UpdateUniformValue (int location, const void* value, std::size_t size)
+{
+	if (location == -1) {
+		return false;
+	}
+
+	std::vector<unsigned char>& uniformValue = _uniformValues [location];
+
+	if (uniformValue.size () == size && std::memcmp (uniformValue.data (), value, size) == 0) {
+		return false;
+	}
+
+	uniformValue.assign ((const unsigned char*) value, (const unsigned char*) value + size);
+
+	return true;
+}
@@ -4,16 +4,43 @@
 #include "Core/Interfaces/Object.h"
 
 #include <string>
+#include <vector>
 #include <map>
 
+#include "Core/Math/glm/glm.hpp"
+
 #include "Wrappers/OpenGL/GL.h"
 
+/*
+ * Uniform block with the matrices of the current view, shared by all the
+ * programs that declare it
+*/
+
+#define SHADER_VIEW_UNIFORM_BLOCK "ViewBlock"
+#define SHADER_VIEW_UNIFORM_BLOCK_BINDING 0
+
+/*
+ * Indexed location not looked up yet, -1 stays the one of an inactive
+ * uniform
+*/
+
+#define SHADER_UNRESOLVED_UNIFORM -2
+
+/*
+ * The uniforms set through SetUniform keep their last value on the CPU
+ * so that a value that did not change since the last draw is not sent
+ * again. A location must be set either only through SetUniform or only
+ * through GL::Uniform* for the cache to stay in sync with the program.
+*/
+
 class Shader : public Object
 {
 protected:
 	std::string _name;
 	GLuint _program;
 	std::map<std::string, int> _uniforms;
+	std::map<int, std::vector<unsigned char>> _uniformValues;
+	std::vector<int> _indexedUniforms;
 
 public:
 	Shader (const std::string& name, GLuint program);
@@ -23,6 +50,19 @@ public:
 	GLuint GetProgram () const;
 
 	int GetUniformLocation (const std::string& name);
+	int GetUniformLocation (std::size_t index, const std::string& name);
+
+	void SetUniform (int location, int value);
+	void SetUniform (int location, const glm::ivec2& value);
+	void SetUniform (int location, const glm::ivec3& value);
+	void SetUniform (int location, float value);
+	void SetUniform (int location, const glm::vec2& value);
+	void SetUniform (int location, const glm::vec3& value);
+	void SetUniform (int location, const glm::mat3& value);
+	void SetUniform (int location, const glm::mat4& value);
+	void SetUniform (int location, const std::vector<glm::mat4>& values);
+protected:
+	bool UpdateUniformValue (int location, const void* value, std::size_t size);
 };
 
-#endif
\ No newline at end of file
+#endif
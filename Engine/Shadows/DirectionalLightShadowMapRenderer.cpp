@@ -11,17 +11,24 @@
 
 #include "Managers/ShaderManager.h"
 
-#include "Core/Intersections/Intersection.h"
-
 #include "Wrappers/OpenGL/GL.h"
 #include "Renderer/Pipeline.h"
+#include "Renderer/StaticGeometryArena.h"
+
+#include "SceneNodes/SceneLayer.h"
+
+#include "Settings/GeneralSettings.h"
+
+#include "Debug/Profiler/Profiler.h"
 
 #include "Core/Console/Console.h"
 
 DirectionalLightShadowMapRenderer::DirectionalLightShadowMapRenderer (Light* light) :
 	LightShadowMapRenderer (light),
 	_lightCameras (new OrthographicCamera* [CASCADED_SHADOW_MAP_LEVELS]),
-	_shadowMapZEnd (new float [CASCADED_SHADOW_MAP_LEVELS + 1])
+	_shadowMapZEnd (new float [CASCADED_SHADOW_MAP_LEVELS + 1]),
+	_indirectDrawBuilder (),
+	_indirectDrawBuffer ()
 {
 	_shaderName = "SHADOW_MAP_DIRECTIONAL_LIGHT";
 
@@ -57,13 +64,27 @@ void DirectionalLightShadowMapRenderer::ShadowMapRender (Scene* scene, Camera* c
 	UpdateCascadeLevelsLimits (camera);
 	UpdateLightCameras (camera);
 
+	/*
+	 * Cull the scene for all the cascades at once
+	*/
+
+	std::vector<FrustumVolume*> frustums;
+
+	for (std::size_t index = 0; index < CASCADED_SHADOW_MAP_LEVELS; index++) {
+		frustums.push_back (_lightCameras [index]->GetFrustumVolume ());
+	}
+
+	std::vector<std::vector<SceneObject*>> visibleObjects;
+
+	scene->GetVisibleObjects (frustums, visibleObjects);
+
 	for (std::size_t index = 0; index < CASCADED_SHADOW_MAP_LEVELS; index++) {
 		_volume->BindForShadowMapCatch (index);
 
 		OrthographicCamera* lightCamera = _lightCameras [index];
 
 		SendLightCamera (lightCamera);
-		RenderScene (scene, lightCamera);
+		RenderScene (visibleObjects [index], lightCamera);
 	}
 }
 
@@ -151,7 +172,7 @@ void DirectionalLightShadowMapRenderer::UpdateLightCameras (Camera* viewCamera)
 	}
 }
 
-void DirectionalLightShadowMapRenderer::RenderScene (Scene* scene, OrthographicCamera* lightCamera)
+void DirectionalLightShadowMapRenderer::RenderScene (const std::vector<SceneObject*>& sceneObjects, OrthographicCamera* lightCamera)
 {
 	/*
 	 * Shadow map is a depth test
@@ -174,30 +195,25 @@ void DirectionalLightShadowMapRenderer::RenderScene (Scene* scene, OrthographicC
 	GL::CullFace (GL_FRONT);
 
 	/*
-	 * Light camera
+	 * Render visible scene entities at Deferred Rendering Stage
 	*/
 
-	FrustumVolume* frustum = lightCamera->GetFrustumVolume ();
+	bool isIndirectDraw = GeneralSettings::Instance ()->GetIntValue (INDIRECT_DRAW_SETTING) == 1;
 
-	/*
-	* Render scene entities to framebuffer at Deferred Rendering Stage
-	*/
+	_indirectDrawBuilder.Clear ();
 
-	for (SceneObject* sceneObject : *scene) {
+	for (SceneObject* sceneObject : sceneObjects) {
 		if (sceneObject->GetRenderer ()->GetStageType () != Renderer::StageType::DEFERRED_STAGE) {
 			continue;
 		}
 
 		/*
-		 * Culling Check
+		 * Static geometry is drawn at the end, all at once
 		*/
 
-		if (sceneObject->GetCollider () == nullptr) {
-			continue;
-		}
+		if (isIndirectDraw && sceneObject->GetRenderer ()->IsStaticGeometry ()) {
+			sceneObject->GetRenderer ()->CollectIndirect (&_indirectDrawBuilder, false);
 
-		GeometricPrimitive* primitive = sceneObject->GetCollider ()->GetGeometricPrimitive ();
-		if (!Intersection::Instance ()->CheckFrustumVsPrimitive (frustum, primitive)) {
 			continue;
 		}
 
@@ -213,6 +229,34 @@ void DirectionalLightShadowMapRenderer::RenderScene (Scene* scene, OrthographicC
 
 		sceneObject->GetRenderer ()->Draw ();
 	}
+
+	if (!_indirectDrawBuilder.IsEmpty ()) {
+		RenderIndirect ();
+	}
+}
+
+/*
+ * Depth needs no material, there is a single multi draw for every static
+ * geometry arena
+*/
+
+void DirectionalLightShadowMapRenderer::RenderIndirect ()
+{
+	PROFILER_LOGGER("SHADOW MAP INDIRECT DRAW")
+
+	_indirectDrawBuilder.Build ();
+	_indirectDrawBuffer.Upload (_indirectDrawBuilder);
+
+	_volume->LockShader (SceneLayer::STATIC);
+
+	Pipeline::SetIndirectDraw (true);
+	Pipeline::UpdateMatrices (nullptr);
+
+	for (const IndirectDrawBatch& batch : _indirectDrawBuilder.GetBatches ()) {
+		_indirectDrawBuffer.Draw (batch);
+	}
+
+	Pipeline::SetIndirectDraw (false);
 }
 
 std::vector<PipelineAttribute> DirectionalLightShadowMapRenderer::GetCustomAttributes ()
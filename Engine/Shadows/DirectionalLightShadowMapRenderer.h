@@ -5,6 +5,9 @@
 
 #include "Cameras/OrthographicCamera.h"
 
+#include "Renderer/IndirectDrawBuffer.h"
+#include "Renderer/IndirectDrawCommandBuilder.h"
+
 #define CASCADED_SHADOW_MAP_LEVELS 4
 
 class DirectionalLightShadowMapRenderer : public LightShadowMapRenderer
@@ -13,6 +16,9 @@ protected:
 	OrthographicCamera** _lightCameras;
 	float* _shadowMapZEnd;
 
+	IndirectDrawCommandBuilder _indirectDrawBuilder;
+	IndirectDrawBuffer _indirectDrawBuffer;
+
 public:
 	DirectionalLightShadowMapRenderer (Light* light);
 	~DirectionalLightShadowMapRenderer ();
@@ -25,7 +31,8 @@ protected:
 	void UpdateCascadeLevelsLimits (Camera* camera);
 	void UpdateLightCameras (Camera* camera);
 
-	void RenderScene (Scene* scene, OrthographicCamera* lightCamera);
+	void RenderScene (const std::vector<SceneObject*>& sceneObjects, OrthographicCamera* lightCamera);
+	void RenderIndirect ();
 };
 
 #endif
\ No newline at end of file
@@ -50,7 +50,7 @@ void SkyboxRenderer::Draw ()
 		//bind pe containerul de stare de geometrie (vertex array object)
 		GL::BindVertexArray(_drawableObjects [i].VAO_INDEX);
 		//comanda desenare
-		GL::DrawElements(GL_TRIANGLES, _drawableObjects [i].INDEX_COUNT, GL_UNSIGNED_INT, 0);
+		GL::DrawElements(GL_TRIANGLES, _drawableObjects [i].INDEX_COUNT, _drawableObjects [i].INDEX_TYPE, 0);
 	}
 
 	if (cull) {
@@ -0,0 +1,57 @@
+#include "AnimationSystem.h"
+
+#include <algorithm>
+
+#include "SceneNodes/AnimationModel3DRenderer.h"
+
+#include "Systems/Time/Time.h"
+
+#include "Utils/Threads/JobSystem.h"
+
+#include "Debug/Profiler/Profiler.h"
+
+AnimationSystem::AnimationSystem () :
+	_renderers ()
+{
+
+}
+
+AnimationSystem::~AnimationSystem ()
+{
+
+}
+
+void AnimationSystem::Update ()
+{
+	PROFILER_LOGGER("Animation")
+
+	float time = Time::GetTime () / 1000;
+
+	JobSystem::Instance ()->ParallelFor (_renderers.size (), ANIMATION_SYSTEM_INSTANCES_PER_JOB,
+		[this, time] (std::size_t begin, std::size_t end) {
+			for (std::size_t index = begin; index < end; index++) {
+				_renderers [index]->UpdatePose (time);
+			}
+		});
+}
+
+void AnimationSystem::Register (AnimationModel3DRenderer* renderer)
+{
+	_renderers.push_back (renderer);
+}
+
+void AnimationSystem::Unregister (AnimationModel3DRenderer* renderer)
+{
+	auto it = std::find (_renderers.begin (), _renderers.end (), renderer);
+
+	if (it == _renderers.end ()) {
+		return;
+	}
+
+	_renderers.erase (it);
+}
+
+std::size_t AnimationSystem::GetInstancesCount () const
+{
+	return _renderers.size ();
+}
\ No newline at end of file
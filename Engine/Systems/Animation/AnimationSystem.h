@@ -0,0 +1,45 @@
+#ifndef ANIMATIONSYSTEM_H
+#define ANIMATIONSYSTEM_H
+
+#include "Core/Singleton/Singleton.h"
+
+#include <vector>
+
+/*
+ * Animated instances evaluated by a single job, few enough that the jobs
+ * of a frame are spread over all the workers
+*/
+
+#define ANIMATION_SYSTEM_INSTANCES_PER_JOB 16
+
+class AnimationModel3DRenderer;
+
+/*
+ * Evaluates the skeleton pose of every animated instance once per frame,
+ * before rendering. The instances are split in jobs of the job system,
+ * the calling thread runs jobs too until all of them are done. Every
+ * instance only writes its own pose.
+*/
+
+class AnimationSystem : public Singleton<AnimationSystem>
+{
+	friend Singleton<AnimationSystem>;
+
+private:
+	std::vector<AnimationModel3DRenderer*> _renderers;
+
+public:
+	void Update ();
+
+	void Register (AnimationModel3DRenderer* renderer);
+	void Unregister (AnimationModel3DRenderer* renderer);
+
+	std::size_t GetInstancesCount () const;
+private:
+	AnimationSystem ();
+	~AnimationSystem ();
+	AnimationSystem (const AnimationSystem&);
+	AnimationSystem& operator=(const AnimationSystem&);
+};
+
+#endif
\ No newline at end of file
@@ -1,8 +1,9 @@
 #include "Component.h"
 
-#include "ComponentManager.h"
+#include "ComponentPool.h"
 
-Component::Component ()
+Component::Component () :
+	_pool (nullptr)
 {
 
 }
@@ -30,4 +31,18 @@ void Component::Update ()
 void Component::LateUpdate ()
 {
 
+}
+
+/*
+ * Null for components that were not created by a pool
+*/
+
+ComponentPoolI* Component::GetPool () const
+{
+	return _pool;
+}
+
+ComponentPoolI::~ComponentPoolI ()
+{
+
 }
\ No newline at end of file
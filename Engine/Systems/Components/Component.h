@@ -3,8 +3,15 @@
 
 #include "Core/Interfaces/Object.h"
 
+class ComponentPoolI;
+
 class Component : public Object
 {
+	template <class T> friend class ComponentPool;
+
+protected:
+	ComponentPoolI* _pool;
+
 public:
 	Component ();
 	virtual ~Component ();
@@ -14,6 +21,8 @@ public:
 
 	virtual void Update ();
 	virtual void LateUpdate ();
+
+	ComponentPoolI* GetPool () const;
 };
 
 #endif
\ No newline at end of file
@@ -2,6 +2,8 @@
 
 #include <algorithm>
 
+#include "ComponentPool.h"
+
 ComponentManager::ComponentManager ()
 {
 
@@ -14,6 +16,10 @@ ComponentManager::~ComponentManager ()
 
 void ComponentManager::Update ()
 {
+	for (auto pool : _pools) {
+		pool->Update ();
+	}
+
 	for (auto component : _components) {
 		component->Update ();
 	}
@@ -21,6 +27,12 @@ void ComponentManager::Update ()
 	for (auto component : _newComponents) {
 		component->Start ();
 
+		if (component->GetPool () != nullptr) {
+			component->GetPool ()->Activate (component);
+
+			continue;
+		}
+
 		_components.push_back (component);
 	}
 
@@ -36,15 +48,47 @@ void ComponentManager::Register (Component* component)
 
 void ComponentManager::Unregister (Component* component)
 {
-	auto it = std::find (_components.begin (), _components.end (), component);
+	auto it = std::find (_newComponents.begin (), _newComponents.end (), component);
+
+	if (it != _newComponents.end ()) {
+		_newComponents.erase (it);
+
+		Destroy (component);
+
+		return;
+	}
+
+	if (component->GetPool () != nullptr) {
+		Destroy (component);
+
+		return;
+	}
+
+	it = std::find (_components.begin (), _components.end (), component);
 
 	if (it == _components.end ()) {
 		return ;
 	}
 
-	delete *it;
-
 	_components.erase (it);
+
+	Destroy (component);
+}
+
+void ComponentManager::RegisterPool (ComponentPoolI* pool)
+{
+	_pools.push_back (pool);
+}
+
+void ComponentManager::Destroy (Component* component)
+{
+	if (component->GetPool () != nullptr) {
+		component->GetPool ()->Destroy (component);
+
+		return;
+	}
+
+	delete component;
 }
 
 void ComponentManager::Clear ()
@@ -54,7 +98,11 @@ void ComponentManager::Clear ()
 	}
 
 	for (auto component : _newComponents) {
-		delete component;
+		Destroy (component);
+	}
+
+	for (auto pool : _pools) {
+		pool->Clear ();
 	}
 
 	_components.clear ();
@@ -7,11 +7,20 @@
 
 #include "Component.h"
 
+class ComponentPoolI;
+
+/*
+ * Components are updated pool by pool, all the components of a type
+ * together. Components created outside of a pool are updated one by one
+ * after them.
+*/
+
 class ComponentManager : public Singleton<ComponentManager>
 {
 	friend Singleton<ComponentManager>;
 
 private:
+	std::vector<ComponentPoolI*> _pools;
 	std::vector<Component*> _components;
 	std::vector<Component*> _newComponents;
 
@@ -20,12 +29,15 @@ public:
 
 	void Register (Component*);
 	void Unregister (Component*);
+
+	void RegisterPool (ComponentPoolI* pool);
 private:
 	ComponentManager ();
 	~ComponentManager ();
 	ComponentManager (const ComponentManager&);
 	ComponentManager& operator=(const ComponentManager&);
 
+	void Destroy (Component*);
 	void Clear ();
 };
 
@@ -0,0 +1,213 @@
+#ifndef COMPONENTPOOL_H
+#define COMPONENTPOOL_H
+
+#include <vector>
+#include <new>
+#include <algorithm>
+#include <functional>
+#include <cstddef>
+
+#include "Component.h"
+#include "ComponentManager.h"
+
+/*
+ * Components of a pool are constructed in blocks of this many objects,
+ * blocks are never moved so the components keep their address
+*/
+
+#define COMPONENT_POOL_BLOCK_SIZE 256
+
+class ComponentPoolI
+{
+public:
+	virtual ~ComponentPoolI ();
+
+	virtual void Update () = 0;
+
+	virtual void Activate (Component* component) = 0;
+	virtual void Destroy (Component* component) = 0;
+	virtual void Clear () = 0;
+
+	virtual std::size_t GetSize () const = 0;
+};
+
+/*
+ * Update of all the started components of one type, in the order of
+ * their storage. The call is bound to the type, it is not dispatched
+ * through the virtual table. A component type may specialize it to
+ * update all of its components together.
+*/
+
+template <class T>
+class ComponentBatch
+{
+public:
+	static void Update (T* const* components, std::size_t count)
+	{
+		for (std::size_t index = 0; index < count; index++) {
+			components [index]->T::Update ();
+		}
+	}
+};
+
+/*
+ * Contiguous storage for the components of one concrete type. Slots of
+ * destroyed components are reused by the next ones.
+*/
+
+template <class T>
+class ComponentPool : public ComponentPoolI
+{
+protected:
+	std::vector<T*> _blocks;
+	std::vector<T*> _freeSlots;
+	std::vector<T*> _activeComponents;
+	std::size_t _size;
+
+public:
+	static ComponentPool<T>* Instance ();
+
+	T* Create ();
+
+	void Update ();
+
+	void Activate (Component* component);
+	void Destroy (Component* component);
+	void Clear ();
+
+	std::size_t GetSize () const;
+protected:
+	ComponentPool ();
+	~ComponentPool ();
+	ComponentPool (const ComponentPool&);
+	ComponentPool& operator=(const ComponentPool&);
+};
+
+/*
+ * The pool of a type is created with its first component and lives
+ * until the end of the program, the manager updates it every frame
+*/
+
+template <class T>
+ComponentPool<T>* ComponentPool<T>::Instance ()
+{
+	static ComponentPool<T>* pool = nullptr;
+
+	if (pool == nullptr) {
+		pool = new ComponentPool<T> ();
+
+		ComponentManager::Instance ()->RegisterPool (pool);
+	}
+
+	return pool;
+}
+
+template <class T>
+ComponentPool<T>::ComponentPool () :
+	_blocks (),
+	_freeSlots (),
+	_activeComponents (),
+	_size (0)
+{
+
+}
+
+template <class T>
+ComponentPool<T>::~ComponentPool ()
+{
+	Clear ();
+}
+
+template <class T>
+T* ComponentPool<T>::Create ()
+{
+	if (_freeSlots.empty ()) {
+		T* block = static_cast<T*> (::operator new (sizeof (T) * COMPONENT_POOL_BLOCK_SIZE));
+
+		_blocks.push_back (block);
+
+		for (std::size_t index = COMPONENT_POOL_BLOCK_SIZE; index > 0; index--) {
+			_freeSlots.push_back (block + index - 1);
+		}
+	}
+
+	T* slot = _freeSlots.back ();
+	_freeSlots.pop_back ();
+
+	T* component = new (slot) T ();
+	component->_pool = this;
+
+	++ _size;
+
+	return component;
+}
+
+template <class T>
+void ComponentPool<T>::Update ()
+{
+	ComponentBatch<T>::Update (_activeComponents.data (), _activeComponents.size ());
+}
+
+/*
+ * Started components are kept sorted by address, the update walks the
+ * blocks forward
+*/
+
+template <class T>
+void ComponentPool<T>::Activate (Component* component)
+{
+	T* typedComponent = static_cast<T*> (component);
+
+	_activeComponents.insert (std::lower_bound (_activeComponents.begin (),
+		_activeComponents.end (), typedComponent, std::less<T*> ()), typedComponent);
+}
+
+template <class T>
+void ComponentPool<T>::Destroy (Component* component)
+{
+	T* typedComponent = static_cast<T*> (component);
+
+	auto it = std::lower_bound (_activeComponents.begin (), _activeComponents.end (),
+		typedComponent, std::less<T*> ());
+
+	if (it != _activeComponents.end () && *it == typedComponent) {
+		_activeComponents.erase (it);
+	}
+
+	typedComponent->~T ();
+
+	_freeSlots.push_back (typedComponent);
+
+	-- _size;
+}
+
+/*
+ * Only components that are still alive may be left, the slots do not
+ * tell which ones are
+*/
+
+template <class T>
+void ComponentPool<T>::Clear ()
+{
+	for (T* component : _activeComponents) {
+		component->~T ();
+	}
+
+	for (T* block : _blocks) {
+		::operator delete (block);
+	}
+
+	_blocks.clear ();
+	_freeSlots.clear ();
+	_activeComponents.clear ();
+
+	_size = 0;
+}
+
+template <class T>
+std::size_t ComponentPool<T>::GetSize () const
+{
+	return _size;
+}
+
+#endif
\ No newline at end of file
@@ -12,6 +12,7 @@
 #include <map>
 
 #include "Component.h"
+#include "ComponentPool.h"
 
 #define REGISTER_COMPONENT(COMPONENT) static RegisterComponent<COMPONENT> dummy (#COMPONENT);
 
@@ -41,7 +42,7 @@ class RegisterComponent
 public:
 	static Component* CreateInstance()
 	{
-		return new ManufacturedType;
+		return ComponentPool<ManufacturedType>::Instance ()->Create ();
 	}
 
 	RegisterComponent(const std::string& id)
@@ -2,9 +2,16 @@
 
 #include "SceneGraph/SceneObject.h"
 #include "Rigidbody.h"
+#include "Physics.h"
+
+#include "Systems/Time/Time.h"
+
+#include "Core/Math/glm/gtc/matrix_inverse.hpp"
 
 PhysicsSystem::PhysicsSystem () :
-	_currentScene (NULL)
+	_currentScene (NULL),
+	_bodies (),
+	_isDirty (true)
 {
 
 }
@@ -19,13 +26,67 @@ PhysicsSystem& PhysicsSystem::Instance ()
 void PhysicsSystem::Init (Scene* scene)
 {
 	_currentScene = scene;
+
+	_isDirty = true;
 }
 
+/*
+ * Gravity moves the bodies in world space, the step is brought in the
+ * space of the parent for child transforms
+*/
+
 void PhysicsSystem::UpdateScene ()
 {
+	if (_currentScene == NULL) {
+		return;
+	}
+
+	if (_isDirty) {
+		UpdateBodies ();
+	}
+
+	glm::vec3 step = Physics::Instance ().GetGravityVector () * Time::GetDeltaTime ();
+
+	for (const PhysicsBody& body : _bodies) {
+		Transform* parent = body.transform->GetParent ();
+
+		glm::vec3 localStep = step;
+
+		if (parent != NULL) {
+			localStep = glm::vec3 (glm::inverse (parent->GetModelMatrix ()) * glm::vec4 (step, 0.0f));
+		}
+
+		body.transform->SetPosition (body.transform->GetLocalPosition () + localStep);
+	}
+}
+
+void PhysicsSystem::SetDirty ()
+{
+	_isDirty = true;
+}
+
+std::size_t PhysicsSystem::GetBodiesCount () const
+{
+	return _bodies.size ();
+}
+
+void PhysicsSystem::UpdateBodies ()
+{
+	_bodies.clear ();
+
 	for (SceneObject* sceneObject : *_currentScene) {
 		Rigidbody* rigidbody = sceneObject->GetRigidbody ();
 
-		rigidbody->Update ();
+		if (!rigidbody->GetGravityUse ()) {
+			continue;
+		}
+
+		PhysicsBody body;
+
+		body.transform = sceneObject->GetTransform ();
+
+		_bodies.push_back (body);
 	}
+
+	_isDirty = false;
 }
\ No newline at end of file
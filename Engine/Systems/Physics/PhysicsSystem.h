@@ -1,12 +1,32 @@
 #ifndef PHYSICSSYSTEM_H
 #define PHYSICSSYSTEM_H
 
+#include <vector>
+
 #include "SceneGraph/Scene.h"
+#include "SceneGraph/Transform.h"
+
+/*
+ * Transform of a rigidbody that uses gravity
+*/
+
+struct PhysicsBody
+{
+	Transform* transform;
+};
+
+/*
+ * Bodies of the current scene that use gravity are packed in one array
+ * and moved in a single pass. The array is built again on the next update
+ * after an object of the scene or the gravity use of a rigidbody changed.
+*/
 
 class PhysicsSystem
 {
 protected:
 	Scene* _currentScene;
+	std::vector<PhysicsBody> _bodies;
+	bool _isDirty;
 
 public:
 	static PhysicsSystem& Instance ();
@@ -14,8 +34,14 @@ public:
 	void Init (Scene* scene);
 
 	void UpdateScene ();
+
+	void SetDirty ();
+
+	std::size_t GetBodiesCount () const;
 private:
 	PhysicsSystem ();
+
+	void UpdateBodies ();
 };
 
 #endif
\ No newline at end of file
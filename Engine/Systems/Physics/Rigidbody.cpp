@@ -1,8 +1,6 @@
 #include "Rigidbody.h"
 
-#include "Physics.h"
-
-#include "Systems/Time/Time.h"
+#include "PhysicsSystem.h"
 
 Rigidbody::Rigidbody (Transform* transform) :
 	_transform (transform),
@@ -19,17 +17,6 @@ bool Rigidbody::GetGravityUse () const
 void Rigidbody::SetGravityUse (bool useGravity)
 {
 	_useGravity = useGravity;
-}
-
-void Rigidbody::Update ()
-{
-	if (!_useGravity) {
-		return;
-	}
-
-	glm::vec3 currentPosition = _transform->GetPosition ();
-	glm::vec3 nextPosition = currentPosition + 
-		Physics::Instance ().GetGravityVector () * Time::GetDeltaTime ();
 
-	_transform->SetPosition (nextPosition);
+	PhysicsSystem::Instance ().SetDirty ();
 }
\ No newline at end of file
@@ -17,8 +17,6 @@ public:
 	bool GetGravityUse () const;
 
 	void SetGravityUse (bool useGravity);
-
-	void Update ();
 };
 
 #endif
\ No newline at end of file
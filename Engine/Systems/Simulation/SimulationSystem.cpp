@@ -0,0 +1,48 @@
+#include "SimulationSystem.h"
+
+#include "Systems/Components/ComponentManager.h"
+#include "Systems/Physics/PhysicsSystem.h"
+
+#include "SceneGraph/TransformHierarchy.h"
+
+#include "Debug/Profiler/Profiler.h"
+
+SimulationSystem::SimulationSystem ()
+{
+
+}
+
+SimulationSystem::~SimulationSystem ()
+{
+
+}
+
+void SimulationSystem::Update (Scene* scene)
+{
+	PROFILER_LOGGER("Simulation")
+
+	UpdateComponents ();
+	UpdatePhysics ();
+	UpdateTransforms ();
+	UpdateScene (scene);
+}
+
+void SimulationSystem::UpdateComponents ()
+{
+	ComponentManager::Instance ()->Update ();
+}
+
+void SimulationSystem::UpdatePhysics ()
+{
+	PhysicsSystem::Instance ().UpdateScene ();
+}
+
+void SimulationSystem::UpdateTransforms ()
+{
+	TransformHierarchy::Instance ()->Update ();
+}
+
+void SimulationSystem::UpdateScene (Scene* scene)
+{
+	scene->Update ();
+}
\ No newline at end of file
@@ -0,0 +1,42 @@
+#ifndef SIMULATIONSYSTEM_H
+#define SIMULATIONSYSTEM_H
+
+#include "Core/Singleton/Singleton.h"
+
+#include "SceneGraph/Scene.h"
+
+/*
+ * The update phase of a frame, run before the animation and rendering.
+ * Its steps run in this order:
+ *
+ * 1. Components, type by type. They may move objects and attach new
+ * ones to the scene.
+ * 2. Physics, in one pass over the bodies of the scene.
+ * 3. World matrices of the transforms that moved.
+ * 4. Scene objects. The colliders of moved objects are rebuilt and the
+ * bounding volume hierarchy is refit, all in the same frame the objects
+ * moved.
+ *
+ * The steps are also run one by one, as the nodes of the frame graph.
+ * Only the components need the main thread.
+*/
+
+class SimulationSystem : public Singleton<SimulationSystem>
+{
+	friend Singleton<SimulationSystem>;
+
+public:
+	void Update (Scene* scene);
+
+	void UpdateComponents ();
+	void UpdatePhysics ();
+	void UpdateTransforms ();
+	void UpdateScene (Scene* scene);
+private:
+	SimulationSystem ();
+	~SimulationSystem ();
+	SimulationSystem (const SimulationSystem&);
+	SimulationSystem& operator=(const SimulationSystem&);
+};
+
+#endif
\ No newline at end of file
@@ -2,6 +2,7 @@
 
 uint32_t Time::_currentTimeMS (0);
 uint32_t Time::_deltaTimeMS (0);
+uint32_t Time::_fixedDeltaTimeMS (0);
 
 float Time::GetDeltaTime()
 {
@@ -15,17 +16,42 @@ float Time::GetTime()
 
 void Time::Init() 
 {
-	_currentTimeMS = SDL_GetTicks();
+	_currentTimeMS = _fixedDeltaTimeMS > 0 ? 0 : SDL_GetTicks();
 }
 
+/*
+ * With a fixed delta time the clock of the game is simulated, every frame
+ * advances it by the same step no matter how long the frame took. The
+ * same frames then see the same times on every run.
+*/
+
 void Time::UpdateFrame()
 {
 	uint32_t lastTimeMS = _currentTimeMS;
-	_currentTimeMS = SDL_GetTicks();
+
+	if (_fixedDeltaTimeMS > 0) {
+		_currentTimeMS += _fixedDeltaTimeMS;
+	} else {
+		_currentTimeMS = SDL_GetTicks();
+	}
 
 	_deltaTimeMS = _currentTimeMS - lastTimeMS;
 }
 
+/*
+ * Zero goes back to the real clock
+*/
+
+void Time::SetFixedDeltaTimeMS (unsigned int fixedDeltaTimeMS)
+{
+	_fixedDeltaTimeMS = fixedDeltaTimeMS;
+}
+
+unsigned int Time::GetFixedDeltaTimeMS ()
+{
+	return _fixedDeltaTimeMS;
+}
+
 unsigned int Time::GetDeltaTimeMS ()
 {
 	return _deltaTimeMS;
@@ -13,10 +13,14 @@ class Time
 private:
 	static uint32_t _currentTimeMS;
 	static uint32_t _deltaTimeMS;
+	static uint32_t _fixedDeltaTimeMS;
 public:
 	static void Init();
 	static void UpdateFrame();
 
+	static void SetFixedDeltaTimeMS (unsigned int fixedDeltaTimeMS);
+	static unsigned int GetFixedDeltaTimeMS ();
+
 	static float GetDeltaTime();
 	static float GetTime();
 
@@ -12,6 +12,8 @@ std::size_t Window::_width (0);
 std::size_t Window::_height (0);
 std::string Window::_title ("");
 bool Window::_fullscreen (true);
+bool Window::_offscreen (false);
+bool Window::_headless (false);
 
 SDL_Window* Window::_window (nullptr);
 SDL_GLContext Window::_glContext;
@@ -23,6 +25,14 @@ bool Window::Init (std::size_t width, std::size_t height, bool fullscreen, std::
 	_fullscreen = fullscreen;
 	_title = title;
 
+	if (_headless) {
+		GL::Viewport (0, 0, _width, _height);
+
+		Window::UpdateCamera ();
+
+		return true;
+	}
+
 	/*
 	 * Create Window with SDL so MUST include SDL_WINDOW_OPENGL to use OpenGL
 	*/
@@ -57,6 +67,12 @@ void Window::SwapBuffers ()
 {
 	PROFILER_LOGGER("Swap buffers")
 
+	GL::EndFrame ();
+
+	if (_window == nullptr) {
+		return;
+	}
+
 	SDL_GL_SwapWindow(_window);
 }
 
@@ -65,7 +81,9 @@ void Window::Resize (const glm::ivec2& dimensions)
 	_width = (std::size_t)dimensions.x;
 	_height = (std::size_t)dimensions.y;
 
-	SDL_SetWindowSize (_window, _width, _height);
+	if (_window != nullptr) {
+		SDL_SetWindowSize (_window, _width, _height);
+	}
 
 	GL::Viewport (0, 0, _width, _height);
 
@@ -83,6 +101,10 @@ void Window::Close ()
 	 * Once finished with OpenGL functions, the SDL_GLContext can be deleted.
 	*/
 
+	if (_window == nullptr) {
+		return;
+	}
+
 	SDL_GL_DeleteContext(_glContext);
 
 	SDL_DestroyWindow (_window);
@@ -112,8 +134,63 @@ std::string Window::GetTitle ()
 	return _title;
 }
 
+/*
+ * Offscreen windows use the offscreen video driver of SDL, which gets its
+ * context from EGL without a display, so it has to be chosen before SDL
+ * is initialized. The window is never shown.
+*/
+
+void Window::SetOffscreen (bool offscreen)
+{
+	_offscreen = offscreen;
+
+	if (_offscreen) {
+		SDL_setenv ("SDL_VIDEODRIVER", "offscreen", 1);
+	}
+}
+
+bool Window::IsOffscreen ()
+{
+	return _offscreen;
+}
+
+/*
+ * A headless window is not created and has no context, for a GL backend
+ * that needs none. SDL runs on its dummy video driver, so the events
+ * still work.
+*/
+
+void Window::SetHeadless (bool headless)
+{
+	_headless = headless;
+
+	if (_headless) {
+		SDL_setenv ("SDL_VIDEODRIVER", "dummy", 1);
+	}
+}
+
+bool Window::IsHeadless ()
+{
+	return _headless;
+}
+
+void Window::SetVerticalSync (bool verticalSync)
+{
+	if (_window == nullptr) {
+		return;
+	}
+
+	if (SDL_GL_SetSwapInterval (verticalSync ? 1 : 0) < 0) {
+		Console::LogWarning ("Vertical sync could not be changed");
+	}
+}
+
 unsigned int Window::GetWindowFlags ()
 {
+	if (_offscreen) {
+		return SDL_WINDOW_OPENGL | SDL_WINDOW_HIDDEN;
+	}
+
 	unsigned int windowFlags = _fullscreen ? 
 		SDL_WINDOW_OPENGL | SDL_WINDOW_FULLSCREEN | SDL_WINDOW_RESIZABLE:
 		SDL_WINDOW_OPENGL | SDL_WINDOW_RESIZABLE | SDL_WINDOW_SHOWN;
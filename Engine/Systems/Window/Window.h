@@ -15,6 +15,8 @@ private:
 	static std::size_t _height;
 	static std::string _title;
 	static bool _fullscreen;
+	static bool _offscreen;
+	static bool _headless;
 
 	static SDL_Window* _window;
 	static SDL_GLContext _glContext;
@@ -26,10 +28,15 @@ public:
 	static void SwapBuffers ();
 	static void Resize (const glm::ivec2&);
 	static void SetFullscreen (bool fullscreen);
+	static void SetOffscreen (bool offscreen);
+	static void SetHeadless (bool headless);
+	static void SetVerticalSync (bool verticalSync);
 
 	static std::size_t GetWidth ();
 	static std::size_t GetHeight ();
 	static bool IsFullscreen ();
+	static bool IsOffscreen ();
+	static bool IsHeadless ();
 	static std::string GetTitle ();
 
 	static void Clear ();
@@ -0,0 +1,156 @@
+#include "ArenaAllocator.h"
+
+#include <iterator>
+#include <algorithm>
+
+ArenaAllocator::ArenaAllocator () :
+	_capacity (0),
+	_usedSize (0),
+	_freeBlocks (),
+	_allocatedBlocks ()
+{
+
+}
+
+ArenaAllocator::ArenaAllocator (std::size_t capacity) :
+	_capacity (0),
+	_usedSize (0),
+	_freeBlocks (),
+	_allocatedBlocks ()
+{
+	Grow (capacity);
+}
+
+std::size_t ArenaAllocator::Allocate (std::size_t size, std::size_t alignment)
+{
+	if (size == 0 || alignment == 0) {
+		return ARENA_ALLOCATOR_INVALID_OFFSET;
+	}
+
+	for (auto it = _freeBlocks.begin (); it != _freeBlocks.end (); ++it) {
+		std::size_t blockOffset = it->first;
+		std::size_t blockSize = it->second;
+
+		std::size_t offset = (blockOffset + alignment - 1) / alignment * alignment;
+		std::size_t paddingSize = offset - blockOffset;
+
+		if (blockSize < paddingSize + size) {
+			continue;
+		}
+
+		std::size_t remainingSize = blockSize - paddingSize - size;
+
+		_freeBlocks.erase (it);
+
+		if (paddingSize > 0) {
+			_freeBlocks [blockOffset] = paddingSize;
+		}
+
+		if (remainingSize > 0) {
+			_freeBlocks [offset + size] = remainingSize;
+		}
+
+		_allocatedBlocks [offset] = size;
+		_usedSize += size;
+
+		return offset;
+	}
+
+	return ARENA_ALLOCATOR_INVALID_OFFSET;
+}
+
+bool ArenaAllocator::Free (std::size_t offset)
+{
+	auto it = _allocatedBlocks.find (offset);
+
+	if (it == _allocatedBlocks.end ()) {
+		return false;
+	}
+
+	std::size_t size = it->second;
+
+	_allocatedBlocks.erase (it);
+	_usedSize -= size;
+
+	AddFreeBlock (offset, size);
+
+	return true;
+}
+
+/*
+ * Ranges already handed out keep their offsets, the new space is added
+ * at the end
+*/
+
+void ArenaAllocator::Grow (std::size_t capacity)
+{
+	if (capacity <= _capacity) {
+		return;
+	}
+
+	std::size_t offset = _capacity;
+
+	_capacity = capacity;
+
+	AddFreeBlock (offset, capacity - offset);
+}
+
+void ArenaAllocator::Clear ()
+{
+	_freeBlocks.clear ();
+	_allocatedBlocks.clear ();
+
+	_usedSize = 0;
+
+	if (_capacity > 0) {
+		_freeBlocks [0] = _capacity;
+	}
+}
+
+std::size_t ArenaAllocator::GetCapacity () const
+{
+	return _capacity;
+}
+
+std::size_t ArenaAllocator::GetUsedSize () const
+{
+	return _usedSize;
+}
+
+std::size_t ArenaAllocator::GetFreeBlocksCount () const
+{
+	return _freeBlocks.size ();
+}
+
+std::size_t ArenaAllocator::GetLargestFreeBlock () const
+{
+	std::size_t largestFreeBlock = 0;
+
+	for (auto it : _freeBlocks) {
+		largestFreeBlock = std::max (largestFreeBlock, it.second);
+	}
+
+	return largestFreeBlock;
+}
+
+void ArenaAllocator::AddFreeBlock (std::size_t offset, std::size_t size)
+{
+	auto next = _freeBlocks.lower_bound (offset);
+
+	if (next != _freeBlocks.end () && offset + size == next->first) {
+		size += next->second;
+		next = _freeBlocks.erase (next);
+	}
+
+	if (next != _freeBlocks.begin ()) {
+		auto previous = std::prev (next);
+
+		if (previous->first + previous->second == offset) {
+			previous->second += size;
+
+			return;
+		}
+	}
+
+	_freeBlocks [offset] = size;
+}
\ No newline at end of file
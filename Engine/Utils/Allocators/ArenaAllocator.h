@@ -0,0 +1,43 @@
+#ifndef ARENAALLOCATOR_H
+#define ARENAALLOCATOR_H
+
+#include <map>
+#include <cstddef>
+
+#define ARENA_ALLOCATOR_INVALID_OFFSET ((std::size_t) -1)
+
+/*
+ * Hands out ranges of a buffer that lives somewhere else, like a GPU
+ * buffer, as offsets in elements. Free ranges are kept sorted by offset,
+ * a range is taken from the first one that fits and a freed range is
+ * merged with the free ranges next to it. The space skipped to align
+ * the start of a range stays free.
+*/
+
+class ArenaAllocator
+{
+protected:
+	std::size_t _capacity;
+	std::size_t _usedSize;
+	std::map<std::size_t, std::size_t> _freeBlocks;
+	std::map<std::size_t, std::size_t> _allocatedBlocks;
+
+public:
+	ArenaAllocator ();
+	ArenaAllocator (std::size_t capacity);
+
+	std::size_t Allocate (std::size_t size, std::size_t alignment = 1);
+	bool Free (std::size_t offset);
+
+	void Grow (std::size_t capacity);
+	void Clear ();
+
+	std::size_t GetCapacity () const;
+	std::size_t GetUsedSize () const;
+	std::size_t GetFreeBlocksCount () const;
+	std::size_t GetLargestFreeBlock () const;
+protected:
+	void AddFreeBlock (std::size_t offset, std::size_t size);
+};
+
+#endif
\ No newline at end of file
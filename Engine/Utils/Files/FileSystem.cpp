@@ -2,6 +2,7 @@
 
 #include <string>
 #include <algorithm>
+#include <sys/stat.h>
 
 #include "Utils/Extensions/StringExtend.h"
 
@@ -57,6 +58,35 @@ std::string FileSystem::FormatFilename (const std::string& filename)
 	return formated;
 }
 
+bool FileSystem::FileExists (const std::string& filename)
+{
+	struct stat fileStat;
+
+	return stat (filename.c_str (), &fileStat) == 0;
+}
+
+std::size_t FileSystem::GetFileSize (const std::string& filename)
+{
+	struct stat fileStat;
+
+	if (stat (filename.c_str (), &fileStat) != 0) {
+		return 0;
+	}
+
+	return (std::size_t) fileStat.st_size;
+}
+
+long long FileSystem::GetModificationTime (const std::string& filename)
+{
+	struct stat fileStat;
+
+	if (stat (filename.c_str (), &fileStat) != 0) {
+		return 0;
+	}
+
+	return (long long) fileStat.st_mtime;
+}
+
 // TODO: Implement this
 std::string FileSystem::SwitchSlashesWindows (const std::string& filename)
 {
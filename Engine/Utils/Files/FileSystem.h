@@ -12,6 +12,10 @@ public:
 	static std::string GetExtension(const std::string& filename);
 
 	static std::string FormatFilename (const std::string& filename);
+
+	static bool FileExists (const std::string& filename);
+	static std::size_t GetFileSize (const std::string& filename);
+	static long long GetModificationTime (const std::string& filename);
 private:
 	// TODO: reimplement this when implement platforming
 	static std::string SwitchSlashesWindows (const std::string& filename);
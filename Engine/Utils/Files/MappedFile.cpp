@@ -0,0 +1,177 @@
+#include "MappedFile.h"
+
+#ifdef _WIN32
+	#include <windows.h>
+#else
+	#include <sys/mman.h>
+	#include <sys/stat.h>
+	#include <fcntl.h>
+	#include <unistd.h>
+#endif
+
+MappedFile::MappedFile () :
+	_data (nullptr),
+	_size (0),
+	_isOpen (false),
+#ifdef _WIN32
+	_fileHandle (INVALID_HANDLE_VALUE),
+	_mappingHandle (nullptr)
+#else
+	_fileDescriptor (-1)
+#endif
+{
+
+}
+
+MappedFile::~MappedFile ()
+{
+	Close ();
+}
+
+#ifdef _WIN32
+
+bool MappedFile::Open (const std::string& filename)
+{
+	Close ();
+
+	_fileHandle = CreateFileA (filename.c_str (), GENERIC_READ, FILE_SHARE_READ,
+		nullptr, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+
+	if (_fileHandle == INVALID_HANDLE_VALUE) {
+		return false;
+	}
+
+	LARGE_INTEGER fileSize;
+	if (!GetFileSizeEx (_fileHandle, &fileSize)) {
+		Close ();
+		return false;
+	}
+
+	_size = (std::size_t) fileSize.QuadPart;
+	_isOpen = true;
+
+	/*
+	 * Empty files cannot be mapped, but they are still valid files
+	*/
+
+	if (_size == 0) {
+		return true;
+	}
+
+	_mappingHandle = CreateFileMappingA (_fileHandle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+
+	if (_mappingHandle == nullptr) {
+		Close ();
+		return false;
+	}
+
+	_data = (const char*) MapViewOfFile (_mappingHandle, FILE_MAP_READ, 0, 0, 0);
+
+	if (_data == nullptr) {
+		Close ();
+		return false;
+	}
+
+	return true;
+}
+
+void MappedFile::Close ()
+{
+	if (_data != nullptr) {
+		UnmapViewOfFile (_data);
+	}
+
+	if (_mappingHandle != nullptr) {
+		CloseHandle (_mappingHandle);
+	}
+
+	if (_fileHandle != INVALID_HANDLE_VALUE) {
+		CloseHandle (_fileHandle);
+	}
+
+	_data = nullptr;
+	_size = 0;
+	_isOpen = false;
+	_fileHandle = INVALID_HANDLE_VALUE;
+	_mappingHandle = nullptr;
+}
+
+#else
+
+bool MappedFile::Open (const std::string& filename)
+{
+	Close ();
+
+	_fileDescriptor = open (filename.c_str (), O_RDONLY);
+
+	if (_fileDescriptor == -1) {
+		return false;
+	}
+
+	struct stat fileStat;
+	if (fstat (_fileDescriptor, &fileStat) == -1) {
+		Close ();
+		return false;
+	}
+
+	_size = (std::size_t) fileStat.st_size;
+	_isOpen = true;
+
+	/*
+	 * Empty files cannot be mapped, but they are still valid files
+	*/
+
+	if (_size == 0) {
+		return true;
+	}
+
+	void* data = mmap (nullptr, _size, PROT_READ, MAP_PRIVATE, _fileDescriptor, 0);
+
+	if (data == MAP_FAILED) {
+		Close ();
+		return false;
+	}
+
+	/*
+	 * The content is always scanned from front to back
+	*/
+
+	madvise (data, _size, MADV_SEQUENTIAL);
+
+	_data = (const char*) data;
+
+	return true;
+}
+
+void MappedFile::Close ()
+{
+	if (_data != nullptr) {
+		munmap ((void*) _data, _size);
+	}
+
+	if (_fileDescriptor != -1) {
+		close (_fileDescriptor);
+	}
+
+	_data = nullptr;
+	_size = 0;
+	_isOpen = false;
+	_fileDescriptor = -1;
+}
+
+#endif
+
+bool MappedFile::IsOpen () const
+{
+	return _isOpen;
+}
+
+const char* MappedFile::GetData () const
+{
+	return _data;
+}
+
+std::size_t MappedFile::GetSize () const
+{
+	return _size;
+}
@@ -0,0 +1,43 @@
+#ifndef MAPPEDFILE_H
+#define MAPPEDFILE_H
+
+#include <string>
+#include <cstddef>
+
+/*
+ * Read-only memory mapping of a whole file. The content is exposed as a
+ * raw character range, so loaders can parse it in place without copying
+ * it through a stream.
+*/
+
+class MappedFile
+{
+private:
+	const char* _data;
+	std::size_t _size;
+	bool _isOpen;
+
+#ifdef _WIN32
+	void* _fileHandle;
+	void* _mappingHandle;
+#else
+	int _fileDescriptor;
+#endif
+
+public:
+	MappedFile ();
+	~MappedFile ();
+
+	bool Open (const std::string& filename);
+	void Close ();
+
+	bool IsOpen () const;
+
+	const char* GetData () const;
+	std::size_t GetSize () const;
+private:
+	MappedFile (const MappedFile&);
+	MappedFile& operator= (const MappedFile&);
+};
+
+#endif
@@ -0,0 +1,292 @@
+#include "MeshOptimizer.h"
+
+#include <cstring>
+#include <cstdint>
+#include <limits>
+
+MeshOptimizerStatistics::MeshOptimizerStatistics () :
+	verticesBefore (0),
+	verticesAfter (0),
+	trianglesCount (0),
+	cacheMissesBefore (0),
+	cacheMissesAfter (0),
+	bytesBefore (0),
+	bytesAfter (0)
+{
+
+}
+
+MeshOptimizerStatistics& MeshOptimizerStatistics::operator+= (const MeshOptimizerStatistics& other)
+{
+	verticesBefore += other.verticesBefore;
+	verticesAfter += other.verticesAfter;
+	trianglesCount += other.trianglesCount;
+	cacheMissesBefore += other.cacheMissesBefore;
+	cacheMissesAfter += other.cacheMissesAfter;
+	bytesBefore += other.bytesBefore;
+	bytesAfter += other.bytesAfter;
+
+	return *this;
+}
+
+std::string MeshOptimizerStatistics::ToString () const
+{
+	float acmrBefore = trianglesCount > 0 ? (float) cacheMissesBefore / trianglesCount : 0.0f;
+	float acmrAfter = trianglesCount > 0 ? (float) cacheMissesAfter / trianglesCount : 0.0f;
+
+	return "vertices " + std::to_string (verticesBefore) + " -> " + std::to_string (verticesAfter) +
+		", ACMR " + std::to_string (acmrBefore) + " -> " + std::to_string (acmrAfter) +
+		", " + std::to_string ((long long) bytesBefore - (long long) bytesAfter) + " bytes saved";
+}
+
+/*
+ * 16 bit indices are enough while every vertex can be addressed
+*/
+
+std::size_t MeshOptimizer::GetIndexSize (std::size_t verticesCount)
+{
+	if (verticesCount <= std::numeric_limits<unsigned short>::max () + (std::size_t) 1) {
+		return sizeof (unsigned short);
+	}
+
+	return sizeof (unsigned int);
+}
+
+/*
+ * Simulates a FIFO post transform cache. The ACMR is the number of
+ * misses divided by the number of triangles.
+*/
+
+std::size_t MeshOptimizer::CountCacheMisses (const std::vector<unsigned int>& indices, std::size_t verticesCount)
+{
+	std::vector<std::size_t> cacheTime (verticesCount, 0);
+	std::size_t timeStamp = MESH_OPTIMIZER_CACHE_SIZE + 1;
+	std::size_t cacheMisses = 0;
+
+	for (std::size_t i=0;i<indices.size ();i++) {
+		unsigned int index = indices [i];
+
+		if (timeStamp - cacheTime [index] > MESH_OPTIMIZER_CACHE_SIZE) {
+			cacheTime [index] = timeStamp ++;
+			cacheMisses ++;
+		}
+	}
+
+	return cacheMisses;
+}
+
+/*
+ * Open addressing hash table over the vertex bytes
+*/
+
+std::size_t MeshOptimizer::WeldVertices (const unsigned char* vertices, std::size_t verticesCount,
+	std::size_t vertexSize, std::vector<unsigned int>& remap)
+{
+	std::size_t tableSize = 1;
+	while (tableSize < verticesCount * 2) {
+		tableSize *= 2;
+	}
+
+	std::vector<unsigned int> table (tableSize, MESH_OPTIMIZER_INVALID_INDEX);
+
+	remap.assign (verticesCount, MESH_OPTIMIZER_INVALID_INDEX);
+
+	std::size_t uniqueCount = 0;
+
+	for (std::size_t i=0;i<verticesCount;i++) {
+		const unsigned char* vertex = vertices + i * vertexSize;
+
+		uint64_t hash = 14695981039346656037ull;
+		for (std::size_t j=0;j<vertexSize;j++) {
+			hash = (hash ^ vertex [j]) * 1099511628211ull;
+		}
+
+		std::size_t slot = (std::size_t) hash & (tableSize - 1);
+
+		while (table [slot] != MESH_OPTIMIZER_INVALID_INDEX &&
+			std::memcmp (vertices + table [slot] * vertexSize, vertex, vertexSize) != 0) {
+			slot = (slot + 1) & (tableSize - 1);
+		}
+
+		if (table [slot] == MESH_OPTIMIZER_INVALID_INDEX) {
+			table [slot] = (unsigned int) i;
+			remap [i] = (unsigned int) uniqueCount ++;
+		} else {
+			remap [i] = remap [table [slot]];
+		}
+	}
+
+	return uniqueCount;
+}
+
+/*
+ * Tipsify (Sander, Nehab and Barczak, "Fast Triangle Reordering for Vertex
+ * Locality and Reduced Overdraw"). Triangles are emitted as fans around a
+ * vertex, the next fan is the vertex that is still in cache and has the
+ * fewest triangles left. Runs in linear time.
+*/
+
+void MeshOptimizer::OptimizeVertexCache (std::vector<unsigned int>& indices, std::size_t verticesCount)
+{
+	std::size_t trianglesCount = indices.size () / 3;
+
+	if (trianglesCount == 0) {
+		return;
+	}
+
+	/*
+	 * Vertex to triangles adjacency
+	*/
+
+	std::vector<unsigned int> liveTriangles (verticesCount, 0);
+
+	for (std::size_t i=0;i<trianglesCount * 3;i++) {
+		liveTriangles [indices [i]] ++;
+	}
+
+	std::vector<std::size_t> adjacencyOffsets (verticesCount + 1, 0);
+
+	for (std::size_t i=0;i<verticesCount;i++) {
+		adjacencyOffsets [i + 1] = adjacencyOffsets [i] + liveTriangles [i];
+	}
+
+	std::vector<unsigned int> adjacency (adjacencyOffsets [verticesCount]);
+	std::vector<std::size_t> adjacencyFill (adjacencyOffsets.begin (), adjacencyOffsets.end () - 1);
+
+	for (std::size_t i=0;i<trianglesCount * 3;i++) {
+		adjacency [adjacencyFill [indices [i]] ++] = (unsigned int) (i / 3);
+	}
+
+	std::vector<std::size_t> cacheTime (verticesCount, 0);
+	std::vector<bool> emitted (trianglesCount, false);
+	std::vector<unsigned int> deadEnd;
+	std::vector<unsigned int> candidates;
+
+	std::vector<unsigned int> result;
+	result.reserve (trianglesCount * 3);
+
+	std::size_t timeStamp = MESH_OPTIMIZER_CACHE_SIZE + 1;
+	std::size_t cursor = 0;
+
+	unsigned int fanning = MESH_OPTIMIZER_INVALID_INDEX;
+
+	while (cursor < verticesCount && fanning == MESH_OPTIMIZER_INVALID_INDEX) {
+		if (liveTriangles [cursor] > 0) {
+			fanning = (unsigned int) cursor;
+		}
+
+		cursor ++;
+	}
+
+	while (fanning != MESH_OPTIMIZER_INVALID_INDEX) {
+		candidates.clear ();
+
+		for (std::size_t i=adjacencyOffsets [fanning];i<adjacencyOffsets [fanning + 1];i++) {
+			unsigned int triangle = adjacency [i];
+
+			if (emitted [triangle]) {
+				continue;
+			}
+
+			for (std::size_t j=0;j<3;j++) {
+				unsigned int vertex = indices [triangle * 3 + j];
+
+				result.push_back (vertex);
+				deadEnd.push_back (vertex);
+				candidates.push_back (vertex);
+
+				liveTriangles [vertex] --;
+
+				if (timeStamp - cacheTime [vertex] > MESH_OPTIMIZER_CACHE_SIZE) {
+					cacheTime [vertex] = timeStamp ++;
+				}
+			}
+
+			emitted [triangle] = true;
+		}
+
+		/*
+		 * Prefer the candidate that stays longest in cache
+		*/
+
+		unsigned int next = MESH_OPTIMIZER_INVALID_INDEX;
+		std::size_t bestPriority = 0;
+
+		for (unsigned int vertex : candidates) {
+			if (liveTriangles [vertex] == 0) {
+				continue;
+			}
+
+			std::size_t priority = 0;
+
+			if (timeStamp - cacheTime [vertex] + 2 * liveTriangles [vertex] <= MESH_OPTIMIZER_CACHE_SIZE) {
+				priority = timeStamp - cacheTime [vertex];
+			}
+
+			if (next == MESH_OPTIMIZER_INVALID_INDEX || priority > bestPriority) {
+				next = vertex;
+				bestPriority = priority;
+			}
+		}
+
+		/*
+		 * Dead end, restart from a recently used vertex or from the
+		 * next vertex in input order
+		*/
+
+		while (next == MESH_OPTIMIZER_INVALID_INDEX && !deadEnd.empty ()) {
+			unsigned int vertex = deadEnd.back ();
+			deadEnd.pop_back ();
+
+			if (liveTriangles [vertex] > 0) {
+				next = vertex;
+			}
+		}
+
+		while (next == MESH_OPTIMIZER_INVALID_INDEX && cursor < verticesCount) {
+			if (liveTriangles [cursor] > 0) {
+				next = (unsigned int) cursor;
+			}
+
+			cursor ++;
+		}
+
+		fanning = next;
+	}
+
+	/*
+	 * A trailing incomplete triangle is kept as it was
+	*/
+
+	for (std::size_t i=trianglesCount * 3;i<indices.size ();i++) {
+		result.push_back (indices [i]);
+	}
+
+	indices.swap (result);
+}
+
+/*
+ * Renumbers the vertices in the order the index buffer fetches them.
+ * Returns the number of referenced vertices, remap holds the new position
+ * of every vertex or an invalid index when it is no longer used.
+*/
+
+std::size_t MeshOptimizer::OptimizeVertexFetch (std::vector<unsigned int>& indices, std::size_t verticesCount,
+	std::vector<unsigned int>& remap)
+{
+	remap.assign (verticesCount, MESH_OPTIMIZER_INVALID_INDEX);
+
+	std::size_t usedCount = 0;
+
+	for (std::size_t i=0;i<indices.size ();i++) {
+		unsigned int& index = indices [i];
+
+		if (remap [index] == MESH_OPTIMIZER_INVALID_INDEX) {
+			remap [index] = (unsigned int) usedCount ++;
+		}
+
+		index = remap [index];
+	}
+
+	return usedCount;
+}
@@ -0,0 +1,112 @@
+#ifndef MESHOPTIMIZER_H
+#define MESHOPTIMIZER_H
+
+#include <string>
+#include <vector>
+
+/*
+ * Size of the simulated post transform cache. Tipsify optimizes for it
+ * and the ACMR is measured against it.
+*/
+
+#define MESH_OPTIMIZER_CACHE_SIZE 16
+
+#define MESH_OPTIMIZER_INVALID_INDEX ((unsigned int) -1)
+
+struct MeshOptimizerStatistics
+{
+	std::size_t verticesBefore;
+	std::size_t verticesAfter;
+	std::size_t trianglesCount;
+	std::size_t cacheMissesBefore;
+	std::size_t cacheMissesAfter;
+	std::size_t bytesBefore;
+	std::size_t bytesAfter;
+
+	MeshOptimizerStatistics ();
+
+	MeshOptimizerStatistics& operator+= (const MeshOptimizerStatistics& other);
+
+	std::string ToString () const;
+};
+
+/*
+ * Turns the expanded triangle lists built by the model renderers into
+ * indexed meshes. Identical vertices are welded, triangles are reordered
+ * for the post transform cache (Tipsify) and vertices are reordered in
+ * the order they are first fetched.
+ *
+ * Vertices are compared byte by byte, the vertex structures must be
+ * tightly packed and fully initialized.
+*/
+
+class MeshOptimizer
+{
+public:
+	template <class T>
+	static MeshOptimizerStatistics Optimize (std::vector<T>& vertices, std::vector<unsigned int>& indices);
+
+	static std::size_t GetIndexSize (std::size_t verticesCount);
+	static std::size_t CountCacheMisses (const std::vector<unsigned int>& indices, std::size_t verticesCount);
+
+private:
+	static std::size_t WeldVertices (const unsigned char* vertices, std::size_t verticesCount,
+		std::size_t vertexSize, std::vector<unsigned int>& remap);
+	static void OptimizeVertexCache (std::vector<unsigned int>& indices, std::size_t verticesCount);
+	static std::size_t OptimizeVertexFetch (std::vector<unsigned int>& indices, std::size_t verticesCount,
+		std::vector<unsigned int>& remap);
+};
+
+template <class T>
+MeshOptimizerStatistics MeshOptimizer::Optimize (std::vector<T>& vertices, std::vector<unsigned int>& indices)
+{
+	MeshOptimizerStatistics statistics;
+
+	statistics.verticesBefore = vertices.size ();
+	statistics.trianglesCount = indices.size () / 3;
+	statistics.cacheMissesBefore = CountCacheMisses (indices, vertices.size ());
+	statistics.bytesBefore = sizeof (T) * vertices.size () + sizeof (unsigned int) * indices.size ();
+
+	/*
+	 * Weld identical vertices, every unique vertex keeps its first occurrence
+	*/
+
+	std::vector<unsigned int> remap;
+
+	std::size_t uniqueCount = WeldVertices ((const unsigned char*) vertices.data (),
+		vertices.size (), sizeof (T), remap);
+
+	std::vector<T> uniqueVertices (uniqueCount);
+
+	for (std::size_t i=0;i<vertices.size ();i++) {
+		uniqueVertices [remap [i]] = vertices [i];
+	}
+
+	for (std::size_t i=0;i<indices.size ();i++) {
+		indices [i] = remap [indices [i]];
+	}
+
+	OptimizeVertexCache (indices, uniqueCount);
+
+	/*
+	 * Vertices that are no longer referenced are dropped here
+	*/
+
+	std::size_t usedCount = OptimizeVertexFetch (indices, uniqueCount, remap);
+
+	vertices.resize (usedCount);
+
+	for (std::size_t i=0;i<uniqueCount;i++) {
+		if (remap [i] != MESH_OPTIMIZER_INVALID_INDEX) {
+			vertices [remap [i]] = uniqueVertices [i];
+		}
+	}
+
+	statistics.verticesAfter = vertices.size ();
+	statistics.cacheMissesAfter = CountCacheMisses (indices, vertices.size ());
+	statistics.bytesAfter = sizeof (T) * vertices.size () + GetIndexSize (vertices.size ()) * indices.size ();
+
+	return statistics;
+}
+
+#endif
@@ -0,0 +1,135 @@
+#include "FrameGraph.h"
+
+#include <mutex>
+
+/*
+ * Main thread nodes that are ready are only queued by jobs, the lock is
+ * taken once per node
+*/
+
+static std::mutex mainThreadNodesMutex;
+
+FrameGraph::FrameGraph () :
+	_nodes (),
+	_mainThreadNodes (),
+	_mainThreadNodesCount (0),
+	_counter ()
+{
+
+}
+
+FrameGraph::~FrameGraph ()
+{
+	for (FrameGraphNode* node : _nodes) {
+		delete node;
+	}
+}
+
+std::size_t FrameGraph::AddNode (const std::string& name, const std::function<void ()>& function, bool isMainThread)
+{
+	FrameGraphNode* node = new FrameGraphNode ();
+
+	node->name = name;
+	node->function = function;
+	node->isMainThread = isMainThread;
+	node->dependenciesCount = 0;
+	node->pendingDependenciesCount = 0;
+
+	_nodes.push_back (node);
+
+	if (isMainThread) {
+		_mainThreadNodesCount ++;
+	}
+
+	return _nodes.size () - 1;
+}
+
+void FrameGraph::AddDependency (std::size_t node, std::size_t dependency)
+{
+	_nodes [dependency]->successors.push_back (node);
+	_nodes [node]->dependenciesCount ++;
+}
+
+/*
+ * Returns once every node of the frame is done
+*/
+
+void FrameGraph::Execute ()
+{
+	_counter.Add (_nodes.size ());
+
+	for (FrameGraphNode* node : _nodes) {
+		node->pendingDependenciesCount = node->dependenciesCount;
+	}
+
+	for (std::size_t index = 0; index < _nodes.size (); index++) {
+		if (_nodes [index]->dependenciesCount == 0) {
+			Start (index);
+		}
+	}
+
+	std::size_t mainThreadNodesDone = 0;
+
+	while (!_counter.IsDone ()) {
+		std::size_t node = _nodes.size ();
+
+		if (mainThreadNodesDone < _mainThreadNodesCount) {
+			std::lock_guard<std::mutex> lock (mainThreadNodesMutex);
+
+			if (!_mainThreadNodes.empty ()) {
+				node = _mainThreadNodes.front ();
+				_mainThreadNodes.erase (_mainThreadNodes.begin ());
+			}
+		}
+
+		if (node < _nodes.size ()) {
+			Run (node);
+
+			mainThreadNodesDone ++;
+
+			continue;
+		}
+
+		if (!JobSystem::Instance ()->RunJob ()) {
+			std::this_thread::yield ();
+		}
+	}
+}
+
+std::size_t FrameGraph::GetNodesCount () const
+{
+	return _nodes.size ();
+}
+
+void FrameGraph::Start (std::size_t node)
+{
+	if (_nodes [node]->isMainThread) {
+		std::lock_guard<std::mutex> lock (mainThreadNodesMutex);
+
+		_mainThreadNodes.push_back (node);
+
+		return;
+	}
+
+	JobSystem::Instance ()->Submit ([this, node] () { Run (node); }, nullptr);
+}
+
+/*
+ * The frame counter is released last, after the successors are started,
+ * so that Execute returns only when nothing of the graph is running
+*/
+
+void FrameGraph::Run (std::size_t node)
+{
+	FrameGraphNode* frameNode = _nodes [node];
+
+	frameNode->function ();
+
+	for (std::size_t successor : frameNode->successors) {
+		if (_nodes [successor]->pendingDependenciesCount.fetch_sub (1) == 1) {
+			Start (successor);
+		}
+	}
+
+	_counter.Done ();
+}
\ No newline at end of file
@@ -0,0 +1,56 @@
+#ifndef FRAMEGRAPH_H
+#define FRAMEGRAPH_H
+
+#include <string>
+#include <vector>
+#include <atomic>
+#include <functional>
+
+#include "JobSystem.h"
+
+struct FrameGraphNode
+{
+	std::string name;
+	std::function<void ()> function;
+	bool isMainThread;
+	std::vector<std::size_t> successors;
+	std::size_t dependenciesCount;
+	std::atomic<std::size_t> pendingDependenciesCount;
+};
+
+/*
+ * Phases of a frame and the order they depend on each other. A node
+ * starts once all the nodes it depends on are done, as a job, or on the
+ * main thread if it has to, like GL submission does.
+ *
+ * The graph is built once and executed every frame from the main thread,
+ * which helps with the jobs while it waits.
+*/
+
+class FrameGraph
+{
+protected:
+	std::vector<FrameGraphNode*> _nodes;
+	std::vector<std::size_t> _mainThreadNodes;
+	std::size_t _mainThreadNodesCount;
+	JobCounter _counter;
+
+public:
+	FrameGraph ();
+	~FrameGraph ();
+
+	std::size_t AddNode (const std::string& name, const std::function<void ()>& function, bool isMainThread);
+	void AddDependency (std::size_t node, std::size_t dependency);
+
+	void Execute ();
+
+	std::size_t GetNodesCount () const;
+private:
+	FrameGraph (const FrameGraph&);
+	FrameGraph& operator=(const FrameGraph&);
+
+	void Start (std::size_t node);
+	void Run (std::size_t node);
+};
+
+#endif
\ No newline at end of file
@@ -0,0 +1,305 @@
+#include "JobSystem.h"
+
+#include <algorithm>
+
+/*
+ * Threads that are not workers share the queue of the main thread
+*/
+
+thread_local std::size_t JobSystem::_queueIndex (0);
+
+JobCounter::JobCounter () :
+	_count (0)
+{
+
+}
+
+void JobCounter::Add (std::size_t count)
+{
+	_count.fetch_add (count);
+}
+
+void JobCounter::Done ()
+{
+	_count.fetch_sub (1);
+}
+
+bool JobCounter::IsDone () const
+{
+	return _count.load () == 0;
+}
+
+void JobQueue::Push (const Job& job)
+{
+	std::lock_guard<std::mutex> lock (_mutex);
+
+	_jobs.push_back (job);
+}
+
+bool JobQueue::Pop (Job& job)
+{
+	std::lock_guard<std::mutex> lock (_mutex);
+
+	if (_jobs.empty ()) {
+		return false;
+	}
+
+	job = std::move (_jobs.back ());
+	_jobs.pop_back ();
+
+	return true;
+}
+
+bool JobQueue::Steal (Job& job)
+{
+	std::lock_guard<std::mutex> lock (_mutex);
+
+	if (_jobs.empty ()) {
+		return false;
+	}
+
+	job = std::move (_jobs.front ());
+	_jobs.pop_front ();
+
+	return true;
+}
+
+/*
+ * The main thread queue always exists, jobs submitted before the workers
+ * start are run by the threads that wait for them
+*/
+
+JobSystem::JobSystem () :
+	_threads (),
+	_queues (1, new JobQueue ()),
+	_pendingJobsCount (0),
+	_sleepingWorkersCount (0),
+	_isStopping (false),
+	_sleepMutex (),
+	_sleepCondition ()
+{
+
+}
+
+JobSystem::~JobSystem ()
+{
+	Stop ();
+
+	for (JobQueue* queue : _queues) {
+		delete queue;
+	}
+}
+
+/*
+ * Workers that already run are stopped first, their jobs are finished
+*/
+
+void JobSystem::Start (std::size_t workersCount)
+{
+	Stop ();
+
+	_isStopping = false;
+
+	for (std::size_t index = 0; index < workersCount; index++) {
+		_queues.push_back (new JobQueue ());
+	}
+
+	for (std::size_t index = 0; index < workersCount; index++) {
+		_threads.push_back (std::thread (&JobSystem::Run, this, index + 1));
+	}
+}
+
+void JobSystem::Stop ()
+{
+	if (_threads.empty ()) {
+		return;
+	}
+
+	{
+		std::lock_guard<std::mutex> lock (_sleepMutex);
+		_isStopping = true;
+	}
+
+	_sleepCondition.notify_all ();
+
+	for (std::size_t index = 0; index < _threads.size (); index++) {
+		_threads [index].join ();
+	}
+
+	_threads.clear ();
+
+	/*
+	 * Jobs left in the queues of the workers are moved to the main one
+	*/
+
+	Job job;
+
+	for (std::size_t index = 1; index < _queues.size (); index++) {
+		while (_queues [index]->Steal (job)) {
+			_queues [0]->Push (job);
+		}
+
+		delete _queues [index];
+	}
+
+	_queues.resize (1);
+}
+
+void JobSystem::Submit (const std::function<void ()>& function, JobCounter* counter)
+{
+	Job job;
+
+	job.function = function;
+	job.counter = counter;
+
+	if (counter != nullptr) {
+		counter->Add (1);
+	}
+
+	_queues [_queueIndex]->Push (job);
+
+	_pendingJobsCount.fetch_add (1);
+
+	/*
+	 * A worker that goes to sleep checks the pending jobs after it is
+	 * counted as sleeping, the lock makes sure it is waiting already
+	*/
+
+	if (_sleepingWorkersCount.load () > 0) {
+		{
+			std::lock_guard<std::mutex> lock (_sleepMutex);
+		}
+
+		_sleepCondition.notify_one ();
+	}
+}
+
+void JobSystem::Wait (JobCounter* counter)
+{
+	while (!counter->IsDone ()) {
+		if (!RunJob ()) {
+			std::this_thread::yield ();
+		}
+	}
+}
+
+/*
+ * Calls the function over ranges of at most grainSize indices. The first
+ * range is run by the calling thread, which returns once all are done.
+*/
+
+void JobSystem::ParallelFor (std::size_t count, std::size_t grainSize,
+	const std::function<void (std::size_t, std::size_t)>& function)
+{
+	if (count == 0) {
+		return;
+	}
+
+	grainSize = std::max (grainSize, (std::size_t) 1);
+
+	if (count <= grainSize) {
+		function (0, count);
+
+		return;
+	}
+
+	JobCounter counter;
+
+	for (std::size_t begin = grainSize; begin < count; begin += grainSize) {
+		std::size_t end = std::min (begin + grainSize, count);
+
+		Submit ([&function, begin, end] () { function (begin, end); }, &counter);
+	}
+
+	function (0, grainSize);
+
+	Wait (&counter);
+}
+
+/*
+ * Runs one job on the calling thread, returns false if no thread had a
+ * job left
+*/
+
+bool JobSystem::RunJob ()
+{
+	Job job;
+
+	if (!TakeJob (job)) {
+		return false;
+	}
+
+	Execute (job);
+
+	return true;
+}
+
+std::size_t JobSystem::GetWorkersCount () const
+{
+	return _threads.size ();
+}
+
+/*
+ * Own queue first, then the others starting with the next one, so that
+ * thieves spread over the queues
+*/
+
+bool JobSystem::TakeJob (Job& job)
+{
+	if (_pendingJobsCount.load () == 0) {
+		return false;
+	}
+
+	std::size_t queuesCount = _queues.size ();
+	std::size_t queueIndex = std::min (_queueIndex, queuesCount - 1);
+
+	if (_queues [queueIndex]->Pop (job)) {
+		_pendingJobsCount.fetch_sub (1);
+
+		return true;
+	}
+
+	for (std::size_t offset = 1; offset < queuesCount; offset++) {
+		if (_queues [(queueIndex + offset) % queuesCount]->Steal (job)) {
+			_pendingJobsCount.fetch_sub (1);
+
+			return true;
+		}
+	}
+
+	return false;
+}
+
+void JobSystem::Execute (Job& job)
+{
+	job.function ();
+
+	if (job.counter != nullptr) {
+		job.counter->Done ();
+	}
+}
+
+void JobSystem::Run (std::size_t queueIndex)
+{
+	_queueIndex = queueIndex;
+
+	while (true) {
+		if (RunJob ()) {
+			continue;
+		}
+
+		std::unique_lock<std::mutex> lock (_sleepMutex);
+
+		_sleepingWorkersCount.fetch_add (1);
+
+		_sleepCondition.wait (lock, [this] {
+			return _isStopping.load () || _pendingJobsCount.load () > 0;
+		});
+
+		_sleepingWorkersCount.fetch_sub (1);
+
+		if (_isStopping.load () && _pendingJobsCount.load () == 0) {
+			return;
+		}
+	}
+}
\ No newline at end of file
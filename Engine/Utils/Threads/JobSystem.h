@@ -0,0 +1,116 @@
+#ifndef JOBSYSTEM_H
+#define JOBSYSTEM_H
+
+#include "Core/Singleton/Singleton.h"
+
+#include <vector>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <functional>
+
+/*
+ * Number of worker threads, the calling thread also runs jobs while it
+ * waits
+*/
+
+#define JOB_SYSTEM_WORKERS_SETTING "JobWorkers"
+
+/*
+ * Jobs not finished yet of a group. A job submitted with a counter
+ * increments it and decrements it when done.
+*/
+
+class JobCounter
+{
+protected:
+	std::atomic<std::size_t> _count;
+
+public:
+	JobCounter ();
+
+	void Add (std::size_t count);
+	void Done ();
+
+	bool IsDone () const;
+private:
+	JobCounter (const JobCounter&);
+	JobCounter& operator=(const JobCounter&);
+};
+
+struct Job
+{
+	std::function<void ()> function;
+	JobCounter* counter;
+};
+
+/*
+ * Jobs of one thread. The owner pushes and pops at the back, so it runs
+ * its most recent jobs first while their data is still in cache. Other
+ * threads steal from the front, the oldest jobs, which are usually the
+ * largest ones left.
+*/
+
+class JobQueue
+{
+protected:
+	std::deque<Job> _jobs;
+	std::mutex _mutex;
+
+public:
+	void Push (const Job& job);
+	bool Pop (Job& job);
+	bool Steal (Job& job);
+};
+
+/*
+ * Work stealing scheduler. Every worker and the main thread have their
+ * own queue. A thread runs the jobs of its queue and steals from the
+ * others when it is empty. Idle workers sleep until a job is submitted.
+ *
+ * Waiting on a counter runs other jobs meanwhile, so jobs may submit and
+ * wait for jobs of their own without blocking a worker.
+*/
+
+class JobSystem : public Singleton<JobSystem>
+{
+	friend Singleton<JobSystem>;
+
+private:
+	std::vector<std::thread> _threads;
+	std::vector<JobQueue*> _queues;
+	std::atomic<std::size_t> _pendingJobsCount;
+	std::atomic<std::size_t> _sleepingWorkersCount;
+	std::atomic<bool> _isStopping;
+	std::mutex _sleepMutex;
+	std::condition_variable _sleepCondition;
+
+	static thread_local std::size_t _queueIndex;
+
+public:
+	void Start (std::size_t workersCount);
+	void Stop ();
+
+	void Submit (const std::function<void ()>& function, JobCounter* counter);
+	void Wait (JobCounter* counter);
+
+	void ParallelFor (std::size_t count, std::size_t grainSize,
+		const std::function<void (std::size_t, std::size_t)>& function);
+
+	bool RunJob ();
+
+	std::size_t GetWorkersCount () const;
+private:
+	JobSystem ();
+	~JobSystem ();
+	JobSystem (const JobSystem&);
+	JobSystem& operator=(const JobSystem&);
+
+	bool TakeJob (Job& job);
+	void Execute (Job& job);
+	void Run (std::size_t queueIndex);
+};
+
+#endif
\ No newline at end of file
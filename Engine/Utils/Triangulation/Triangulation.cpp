@@ -36,13 +36,13 @@ std::vector<Polygon*> Triangulation::ConvexTriangulation (Polygon* polygon)
 		newPoly->AddVertex (polygon->GetVertex (i-1));
 		newPoly->AddVertex (polygon->GetVertex (i));
 
-		if (polygon->HaveNormals ()) {
+		if (polygon->NormalsCount () == polygon->VertexCount ()) {
 			newPoly->AddNormal (polygon->GetNormal (0));
 			newPoly->AddNormal (polygon->GetNormal (i-1));
 			newPoly->AddNormal (polygon->GetNormal (i));
 		}
 
-		if (polygon->HaveUV ()) {
+		if (polygon->TexcoordsCount () == polygon->VertexCount ()) {
 			newPoly->AddTexcoord (polygon->GetTexcoord (0));
 			newPoly->AddTexcoord (polygon->GetTexcoord (i-1));
 			newPoly->AddTexcoord (polygon->GetTexcoord (i));
@@ -54,20 +54,50 @@ std::vector<Polygon*> Triangulation::ConvexTriangulation (Polygon* polygon)
 	return result;
 }
 
+/*
+ * Fans are written straight into the shared arrays of the new group. A
+ * polygon has normals or texcoords for all its corners or none, as with
+ * "f v", "f v/vt" and "f v//vn". A stream of another size is dropped
+ * rather than read past its end.
+*/
+
 PolygonGroup* Triangulation::ConvexTriangulation (PolygonGroup* polyGroup)
 {
 	PolygonGroup* resultPolyGroup = new PolygonGroup (polyGroup->GetName ());
 	resultPolyGroup->SetMaterialName (polyGroup->GetMaterialName ());
 
+	resultPolyGroup->Reserve (polyGroup->GetPolygonCount (), polyGroup->GetIndices (Polygon::VERTEX_ATTRIBUTE).size ());
+
 	for (std::size_t i=0;i<polyGroup->GetPolygonCount ();i++) {
 		Polygon* poly = polyGroup->GetPolygon (i);
 
-		std::vector<Polygon*> newPoly = ConvexTriangulation (poly);
+		const int* vertices = poly->GetIndices (Polygon::VERTEX_ATTRIBUTE);
+		const int* normals = poly->GetIndices (Polygon::NORMAL_ATTRIBUTE);
+		const int* texcoords = poly->GetIndices (Polygon::TEXCOORD_ATTRIBUTE);
+
+		std::size_t normalsCount = poly->NormalsCount () == poly->VertexCount () ? 3 : 0;
+		std::size_t texcoordsCount = poly->TexcoordsCount () == poly->VertexCount () ? 3 : 0;
+
+		for (std::size_t j=2;j<poly->VertexCount ();j++) {
+			int fanVertices [3] = { vertices [0], vertices [j-1], vertices [j] };
+			int fanNormals [3] = { 0, 0, 0 };
+			int fanTexcoords [3] = { 0, 0, 0 };
 
-		for (std::size_t j=0;j<newPoly.size ();j++) {
-			resultPolyGroup->AddPolygon (newPoly [j]);
+			if (normalsCount > 0) {
+				fanNormals [0] = normals [0];
+				fanNormals [1] = normals [j-1];
+				fanNormals [2] = normals [j];
+			}
+
+			if (texcoordsCount > 0) {
+				fanTexcoords [0] = texcoords [0];
+				fanTexcoords [1] = texcoords [j-1];
+				fanTexcoords [2] = texcoords [j];
+			}
+
+			resultPolyGroup->AddPolygon (fanVertices, 3, fanNormals, normalsCount, fanTexcoords, texcoordsCount);
 		}
 	}
 
 	return resultPolyGroup;
-}
\ No newline at end of file
+}
@@ -8,22 +8,5 @@ BillboardParticle::BillboardParticle () :
 	Particle ()
 {
 	delete _renderer;
-
-	BillboardParticleRenderer* billboardRenderer = 
-		new BillboardParticleRenderer (_transform);
-
-	billboardRenderer->SetLifetime (&_lifetime);
-	billboardRenderer->SetTimeAlive (&_timeAlive);
-
-	_renderer = billboardRenderer;	
-}
-
-Particle* BillboardParticle::Clone ()
-{
-	BillboardParticle* clone = new BillboardParticle ();
-
-	clone->GetRigidbody ()->SetGravityUse (_rigidbody->GetGravityUse ());
-	clone->SetMesh (_mesh);
-
-	return clone;
+	_renderer = new BillboardParticleRenderer ();
 }
\ No newline at end of file
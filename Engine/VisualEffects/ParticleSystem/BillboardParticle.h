@@ -7,8 +7,6 @@ class BillboardParticle : public Particle
 {
 public:
 	BillboardParticle ();
-
-	Particle* Clone ();
 };
 
 #endif
\ No newline at end of file
@@ -2,40 +2,57 @@
 
 #include <vector>
 
-#include "SceneNodes/Model3DRenderer.h"
-
 #include "Mesh/Model.h"
 #include "Texture/TextureAtlas.h"
 #include "Texture/Texture.h"
 #include "Material/Material.h"
 
-#include "Core/Math/Matrix.h"
 #include "Core/Math/glm/glm.hpp"
 
 #include "Managers/TextureManager.h"
 #include "Managers/MaterialManager.h"
 
-void BillboardParticleRenderer::SetLifetime (unsigned int* lifetime)
+std::size_t BillboardParticleRenderer::GetInstanceSize () const
 {
-	_lifetime = lifetime;
+	return 24;
 }
 
-void BillboardParticleRenderer::SetTimeAlive (unsigned int* timeAlive)
-{
-	_timeAlive = timeAlive;
-}
+/*
+ * Each instance is the model matrix, the offsets of the two atlas areas
+ * blended at the age of the particle with their blending factor, and
+ * the scale
+*/
 
-Buffer<float> BillboardParticleRenderer::GetParticleData ()
+void BillboardParticleRenderer::WriteInstances (const ParticlePool& pool, const std::vector<std::uint32_t>& order, float* data)
 {
-	Buffer<float> buffer;
+	TextureAtlas* texAtlas = GetTextureAtlas ();
 
-	Material* mat = MaterialManager::Instance ().GetMaterial (_matName);
+	std::size_t areasCount = texAtlas->GetAreasCount ();
+
+	for (std::uint32_t index : order) {
+		WriteModelMatrix (pool, index, data);
+
+		float lifeFactor = pool.age [index] / pool.lifetime [index];
 
-	buffer.Add (this->GetModelMatrix ());
-	ManageAtlasTexcoord (mat, &buffer);
-	ManageCustomAttributes (&buffer);
+		std::size_t areaIndex = (std::size_t) (lifeFactor * (float) areasCount);
+		std::size_t nextAreaIndex = areaIndex + (areaIndex + 1 < areasCount);
+		float texBlending = lifeFactor * areasCount - areaIndex;
 
-	return buffer;	
+		glm::vec3 currTexOffset = texAtlas->GetOffset (areaIndex);
+		glm::vec3 nextTexOffset = texAtlas->GetOffset (nextAreaIndex);
+
+		data [16] = currTexOffset.x;
+		data [17] = currTexOffset.y;
+		data [18] = nextTexOffset.x;
+		data [19] = nextTexOffset.y;
+		data [20] = texBlending;
+
+		data [21] = pool.scale [index];
+		data [22] = pool.scale [index];
+		data [23] = pool.scale [index];
+
+		data += 24;
+	}
 }
 
 std::vector<BufferAttribute> BillboardParticleRenderer::GetBufferAttributes ()
@@ -59,13 +76,8 @@ std::vector<BufferAttribute> BillboardParticleRenderer::GetBufferAttributes ()
 
 std::vector<PipelineAttribute> BillboardParticleRenderer::GetUniformAttributes ()
 {
-	Material* mat = MaterialManager::Instance ().GetMaterial (_matName);
-
 	// Take area scale from the atlas
-	Attribute atlasMap = mat->GetAttribute (Attribute::AttrType::ATTR_TEXTURE2D_ATLAS);
-	Texture* tex = TextureManager::Instance ()->GetTexture (atlasMap.valueName);
-
-	TextureAtlas* texAtlas = dynamic_cast <TextureAtlas*> (tex);
+	TextureAtlas* texAtlas = GetTextureAtlas ();
 
 	// Create attribute
 	std::vector<PipelineAttribute> attributes;
@@ -96,35 +108,12 @@ void BillboardParticleRenderer::Attach (Model* model)
 	}
 }
 
-void BillboardParticleRenderer::ManageAtlasTexcoord (Material* mat, Buffer<float>* buffer)
+TextureAtlas* BillboardParticleRenderer::GetTextureAtlas ()
 {
+	Material* mat = MaterialManager::Instance ().GetMaterial (_matName);
+
 	Attribute atlasMap = mat->GetAttribute (Attribute::AttrType::ATTR_TEXTURE2D_ATLAS);
 	Texture* tex = TextureManager::Instance ()->GetTexture (atlasMap.valueName);
 
-	TextureAtlas* texAtlas = dynamic_cast <TextureAtlas*> (tex);
-
-	float lifeFactor = 1.0f * (*_timeAlive) / (*_lifetime);
-
-	std::size_t areasCount = texAtlas->GetAreasCount ();
-	std::size_t areaIndex = (std::size_t) (lifeFactor * (float) areasCount);
-	std::size_t nextAreaIndex = areaIndex + (areaIndex + 1 < areasCount);
-	float texBlending = lifeFactor * areasCount - areaIndex;
-
-	glm::vec3 currTexOffset = texAtlas->GetOffset (areaIndex);
-	glm::vec3 nextTexOffset = texAtlas->GetOffset (nextAreaIndex);
-
-	buffer->Add (currTexOffset.x); 
-	buffer->Add (currTexOffset.y);
-	buffer->Add (nextTexOffset.x);
-	buffer->Add (nextTexOffset.y);
-	buffer->Add (texBlending);
-}
-
-void BillboardParticleRenderer::ManageCustomAttributes (Buffer<float>* buffer)
-{
-	glm::vec3 scale = _transform->GetScale ();
-
-	buffer->Add (scale.x);
-	buffer->Add (scale.y);
-	buffer->Add (scale.z);
+	return dynamic_cast <TextureAtlas*> (tex);
 }
\ No newline at end of file
@@ -8,29 +8,23 @@
 #include "Material/Material.h"
 #include "Mesh/Model.h"
 
-#include "Renderer/Buffer.h"
+#include "Texture/TextureAtlas.h"
 
 class BillboardParticleRenderer : public ParticleRenderer
 {
 private:
-	unsigned int* _lifetime;
-	unsigned int* _timeAlive;
 	std::string _matName;
 
 public:
-	using ParticleRenderer::ParticleRenderer;
+	std::size_t GetInstanceSize () const;
+	void WriteInstances (const ParticlePool& pool, const std::vector<std::uint32_t>& order, float* data);
 
-	Buffer<float> GetParticleData ();
 	std::vector<BufferAttribute> GetBufferAttributes ();
 	std::vector<PipelineAttribute> GetUniformAttributes ();
 
-	void SetLifetime (unsigned int* lifetime);
-	void SetTimeAlive (unsigned int* timeAlive);
-
 	void Attach (Model* mesh);
 private:
-	void ManageAtlasTexcoord (Material* mat, Buffer<float>* data);
-	void ManageCustomAttributes (Buffer<float>* data);
+	TextureAtlas* GetTextureAtlas ();
 };
 
 #endif
\ No newline at end of file
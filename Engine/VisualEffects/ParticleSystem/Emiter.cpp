@@ -71,6 +71,16 @@ void Emiter::SetTweenCurve (AnimationCurve* tween)
 	_tweenCurve = tween;
 }
 
+AnimationCurve* Emiter::GetScaleCurve () const
+{
+	return _scaleCurve;
+}
+
+AnimationCurve* Emiter::GetTweenCurve () const
+{
+	return _tweenCurve;
+}
+
 void Emiter::SetPartLifetimeRange (unsigned int minLifetime, unsigned int maxLifetime)
 {
 	_lifetime.first = minLifetime;
@@ -89,13 +99,6 @@ void Emiter::SetPartScaleRange (float minScale, float maxScale)
 	_scale.second = maxScale;
 }
 
-Particle* Emiter::InstantiateParticle ()
-{
-	Particle* clone = _particlePrototype->Clone ();
-
-	return clone;
-}
-
 glm::vec3 Emiter::GetParticleDirection (glm::vec3 source)
 {
 	// Pick direction (see this -> http://mathworld.wolfram.com/DiskPointPicking.html)
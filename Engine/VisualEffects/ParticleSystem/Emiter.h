@@ -9,6 +9,7 @@
 #include "Utils/Curves/AnimationCurve.h"
 
 #include "Particle.h"
+#include "ParticlePool.h"
 
 // TODO: Remade this, maybe with particle prototype ?
 class Emiter : public SceneObject
@@ -36,16 +37,17 @@ public:
 	void SetScaleCurve (AnimationCurve* scale);
 	void SetTweenCurve (AnimationCurve* speed);
 
+	AnimationCurve* GetScaleCurve () const;
+	AnimationCurve* GetTweenCurve () const;
+
 	void SetPartLifetimeRange (unsigned int minLifetime, unsigned maxLifetime);
 	void SetPartSpeedRange (float minSpeed, float maxSpeed);
 	void SetPartScaleRange (float minScale, float maxScale);
 
 	void Update ();
 
-	virtual Particle* GetParticle () = 0;
+	virtual void Emit (ParticlePool* pool) = 0;
 protected:
-	Particle* InstantiateParticle ();
-
 	glm::vec3 GetParticleDirection (glm::vec3 source);
 };
 
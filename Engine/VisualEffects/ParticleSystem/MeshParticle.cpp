@@ -8,14 +8,5 @@ MeshParticle::MeshParticle () :
 	Particle ()
 {
 	delete _renderer;
-	_renderer = new MeshParticleRenderer (_transform);
-}
-
-Particle* MeshParticle::Clone ()
-{
-	MeshParticle* clone = new MeshParticle ();
-
-	clone->GetRigidbody ()->SetGravityUse (_rigidbody->GetGravityUse ());
-
-	return clone;
+	_renderer = new MeshParticleRenderer ();
 }
\ No newline at end of file
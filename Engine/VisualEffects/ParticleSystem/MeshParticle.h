@@ -7,8 +7,6 @@ class MeshParticle : public Particle
 {
 public:
 	MeshParticle ();
-
-	Particle* Clone ();
 };
 
 #endif
\ No newline at end of file
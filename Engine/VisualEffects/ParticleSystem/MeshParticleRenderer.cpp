@@ -10,13 +10,18 @@ void MeshParticleRenderer::Attach (Model* mesh)
 	// Do nothing
 }
 
-Buffer<float> MeshParticleRenderer::GetParticleData ()
+std::size_t MeshParticleRenderer::GetInstanceSize () const
 {
-	Buffer<float> buffer;
+	return 16;
+}
 
-	buffer.Add (this->GetModelMatrix ());
+void MeshParticleRenderer::WriteInstances (const ParticlePool& pool, const std::vector<std::uint32_t>& order, float* data)
+{
+	for (std::uint32_t index : order) {
+		WriteModelMatrix (pool, index, data);
 
-	return buffer;
+		data += 16;
+	}
 }
 
 std::vector<PipelineAttribute> MeshParticleRenderer::GetUniformAttributes ()
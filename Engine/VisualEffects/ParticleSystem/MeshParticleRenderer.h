@@ -8,11 +8,10 @@
 class MeshParticleRenderer : public ParticleRenderer
 {
 public:
-	using ParticleRenderer::ParticleRenderer;
-
 	virtual ~MeshParticleRenderer ();
 
-	virtual Buffer<float> GetParticleData ();
+	virtual std::size_t GetInstanceSize () const;
+	virtual void WriteInstances (const ParticlePool& pool, const std::vector<std::uint32_t>& order, float* data);
 
 	virtual std::vector<PipelineAttribute> GetUniformAttributes ();
 	virtual std::vector<BufferAttribute> GetBufferAttributes ();
@@ -1,62 +1,36 @@
 #ifndef PARTICLE_H
 #define PARTICLE_H
 
-#include "SceneGraph/SceneObject.h"
+#include "Core/Interfaces/Object.h"
 
 #include "Mesh/Model.h"
-#include "Core/Math/glm/vec3.hpp"
-#include "SceneGraph/Transform.h"
 
-#include "Utils/Curves/AnimationCurve.h"
+#include "ParticleRenderer.h"
 
-class Particle : public SceneObject
+/*
+ * Prototype of the particles of a system: the mesh drawn for each one,
+ * the layout of their instance data and whether they fall by gravity.
+ * The particles themselves only live in the pool of the system.
+*/
+
+class Particle : public Object
 {
 protected:
-	// In milliseconds
-	unsigned int _lifetime;
-	// Movement direction
-	glm::vec3* _direction;
-	// Movement speed - units per second
-	float _speed;
-
-	AnimationCurve* _scaleCurve;
-	AnimationCurve* _tweenCurve;
-
-	bool _alive;
-
-	glm::vec3 _initialPosition;
-	glm::vec3 _finalDestination;
-	glm::vec3 _initialScale;
-	unsigned int _timeAlive;
-
 	Model* _mesh;
+	ParticleRenderer* _renderer;
+	bool _useGravity;
 
 public:
 	Particle ();
-	Particle (const Particle& other);
 	virtual ~Particle ();
 
-	void SetLifetime (unsigned int lifetime);
-	void SetScaleCurve (AnimationCurve* scaleCurve);
-	void SetTweenCurve (AnimationCurve* tweenCurve);
-	void SetSpeed (float speed);
-	void SetMoveDirection (glm::vec3* direction);
-
-	void Init ();
-
 	void SetMesh (Model* mesh);
 	Model* GetMesh () const;
 
-	bool IsAlive () const;
+	void SetGravityUse (bool useGravity);
+	bool GetGravityUse () const;
 
-	void Update ();
-
-	virtual Particle* Clone ();
-protected:
-	void UpdatePosition ();
-	void UpdateScale ();
-	void UpdateRotation ();
-	void UpdatePhysics ();
+	ParticleRenderer* GetRenderer () const;
 };
 
 #endif
\ No newline at end of file
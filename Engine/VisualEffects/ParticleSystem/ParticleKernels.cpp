@@ -0,0 +1,186 @@
+#include "ParticleKernels.h"
+
+#include <algorithm>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+	#define PARTICLE_KERNELS_SSE
+
+	#include <emmintrin.h>
+#endif
+
+/*
+ * The last sample is stored twice, the interpolation at t = 1 reads one
+ * sample past the end of the curve
+*/
+
+ParticleCurve::ParticleCurve () :
+	_samples (PARTICLE_CURVE_SAMPLES + 2, 1.0f)
+{
+
+}
+
+void ParticleCurve::Sample (AnimationCurve* curve)
+{
+	for (std::size_t index = 0; index <= PARTICLE_CURVE_SAMPLES; index++) {
+		_samples [index] = curve->Evaluate ((float) index / PARTICLE_CURVE_SAMPLES);
+	}
+
+	_samples [PARTICLE_CURVE_SAMPLES + 1] = _samples [PARTICLE_CURVE_SAMPLES];
+}
+
+float ParticleCurve::Evaluate (float t) const
+{
+	float position = std::min (std::max (t, 0.0f), 1.0f) * PARTICLE_CURVE_SAMPLES;
+
+	int index = (int) position;
+	float factor = position - (float) index;
+
+	return _samples [index] + factor * (_samples [index + 1] - _samples [index]);
+}
+
+const float* ParticleCurve::GetSamples () const
+{
+	return _samples.data ();
+}
+
+#ifdef PARTICLE_KERNELS_SSE
+
+/*
+ * Same interpolation as ParticleCurve::Evaluate for four values, only
+ * the table lookups are scalar
+*/
+
+static inline __m128 EvaluateCurveSSE (const float* samples, __m128 t)
+{
+	__m128 position = _mm_mul_ps (_mm_min_ps (_mm_max_ps (t, _mm_setzero_ps ()), _mm_set1_ps (1.0f)),
+		_mm_set1_ps ((float) PARTICLE_CURVE_SAMPLES));
+
+	__m128i index = _mm_cvttps_epi32 (position);
+	__m128 factor = _mm_sub_ps (position, _mm_cvtepi32_ps (index));
+
+	int indices [4];
+
+	_mm_storeu_si128 ((__m128i*) indices, index);
+
+	__m128 start = _mm_setr_ps (samples [indices [0]], samples [indices [1]],
+		samples [indices [2]], samples [indices [3]]);
+	__m128 end = _mm_setr_ps (samples [indices [0] + 1], samples [indices [1] + 1],
+		samples [indices [2] + 1], samples [indices [3] + 1]);
+
+	return _mm_add_ps (start, _mm_mul_ps (factor, _mm_sub_ps (end, start)));
+}
+
+#endif
+
+void ParticleKernels::UpdateAge (ParticlePool& pool, std::size_t begin, std::size_t end, float deltaTime)
+{
+	float* age = pool.age.data ();
+
+	std::size_t index = begin;
+
+#ifdef PARTICLE_KERNELS_SSE
+	__m128 delta = _mm_set1_ps (deltaTime);
+
+	for (; index + 4 <= end; index += 4) {
+		_mm_storeu_ps (age + index, _mm_add_ps (_mm_loadu_ps (age + index), delta));
+	}
+#endif
+
+	for (; index < end; index++) {
+		age [index] += deltaTime;
+	}
+}
+
+/*
+ * A particle travels from its initial position along its velocity for
+ * its whole lifetime, the curve gives the part of the way done at each
+ * moment of its life
+*/
+
+void ParticleKernels::UpdateTween (ParticlePool& pool, std::size_t begin, std::size_t end,
+	const ParticleCurve& tweenCurve)
+{
+	const float* samples = tweenCurve.GetSamples ();
+
+	std::size_t index = begin;
+
+#ifdef PARTICLE_KERNELS_SSE
+	for (; index + 4 <= end; index += 4) {
+		__m128 lifetime = _mm_loadu_ps (&pool.lifetime [index]);
+		__m128 tween = EvaluateCurveSSE (samples, _mm_div_ps (_mm_loadu_ps (&pool.age [index]), lifetime));
+		__m128 distance = _mm_mul_ps (lifetime, tween);
+
+		_mm_storeu_ps (&pool.positionX [index], _mm_add_ps (_mm_loadu_ps (&pool.initialPositionX [index]),
+			_mm_mul_ps (_mm_loadu_ps (&pool.velocityX [index]), distance)));
+		_mm_storeu_ps (&pool.positionY [index], _mm_add_ps (_mm_loadu_ps (&pool.initialPositionY [index]),
+			_mm_mul_ps (_mm_loadu_ps (&pool.velocityY [index]), distance)));
+		_mm_storeu_ps (&pool.positionZ [index], _mm_add_ps (_mm_loadu_ps (&pool.initialPositionZ [index]),
+			_mm_mul_ps (_mm_loadu_ps (&pool.velocityZ [index]), distance)));
+	}
+#endif
+
+	for (; index < end; index++) {
+		float distance = pool.lifetime [index] * tweenCurve.Evaluate (pool.age [index] / pool.lifetime [index]);
+
+		pool.positionX [index] = pool.initialPositionX [index] + pool.velocityX [index] * distance;
+		pool.positionY [index] = pool.initialPositionY [index] + pool.velocityY [index] * distance;
+		pool.positionZ [index] = pool.initialPositionZ [index] + pool.velocityZ [index] * distance;
+	}
+}
+
+/*
+ * Particles that use gravity move by the gravity vector every second,
+ * like the rigidbody of a scene object does
+*/
+
+void ParticleKernels::UpdateGravity (ParticlePool& pool, std::size_t begin, std::size_t end,
+	const glm::vec3& gravity, float deltaTime)
+{
+	glm::vec3 step = gravity * deltaTime;
+
+	float* positions [3] = { pool.positionX.data (), pool.positionY.data (), pool.positionZ.data () };
+
+	for (std::size_t axis = 0; axis < 3; axis++) {
+		float* position = positions [axis];
+
+		std::size_t index = begin;
+
+#ifdef PARTICLE_KERNELS_SSE
+		__m128 delta = _mm_set1_ps (step [axis]);
+
+		for (; index + 4 <= end; index += 4) {
+			_mm_storeu_ps (position + index, _mm_add_ps (_mm_loadu_ps (position + index), delta));
+		}
+#endif
+
+		for (; index < end; index++) {
+			position [index] += step [axis];
+		}
+	}
+}
+
+/*
+ * The curve is read backwards, from the end of the life of a particle
+*/
+
+void ParticleKernels::UpdateScale (ParticlePool& pool, std::size_t begin, std::size_t end,
+	const ParticleCurve& scaleCurve)
+{
+	const float* samples = scaleCurve.GetSamples ();
+
+	std::size_t index = begin;
+
+#ifdef PARTICLE_KERNELS_SSE
+	for (; index + 4 <= end; index += 4) {
+		__m128 life = _mm_div_ps (_mm_loadu_ps (&pool.age [index]), _mm_loadu_ps (&pool.lifetime [index]));
+		__m128 scale = EvaluateCurveSSE (samples, _mm_sub_ps (_mm_set1_ps (1.0f), life));
+
+		_mm_storeu_ps (&pool.scale [index], _mm_mul_ps (_mm_loadu_ps (&pool.initialScale [index]), scale));
+	}
+#endif
+
+	for (; index < end; index++) {
+		pool.scale [index] = pool.initialScale [index] *
+			scaleCurve.Evaluate (1.0f - pool.age [index] / pool.lifetime [index]);
+	}
+}
\ No newline at end of file
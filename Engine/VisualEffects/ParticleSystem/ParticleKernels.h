@@ -0,0 +1,54 @@
+#ifndef PARTICLEKERNELS_H
+#define PARTICLEKERNELS_H
+
+#include <vector>
+
+#include "ParticlePool.h"
+
+#include "Utils/Curves/AnimationCurve.h"
+
+#include "Core/Math/glm/glm.hpp"
+
+#define PARTICLE_CURVE_SAMPLES 256
+
+/*
+ * Animation curve sampled at even steps over [0, 1] and read back by
+ * linear interpolation, so that the kernels look up a table instead of
+ * switching over the ease type of every particle
+*/
+
+class ParticleCurve
+{
+protected:
+	std::vector<float> _samples;
+
+public:
+	ParticleCurve ();
+
+	void Sample (AnimationCurve* curve);
+
+	float Evaluate (float t) const;
+
+	const float* GetSamples () const;
+};
+
+/*
+ * Update passes over the alive particles of a pool in [begin, end). Each
+ * one streams through a few arrays of the pool, four particles at a time
+ * on SSE2. Ranges that do not overlap can be updated at the same time.
+*/
+
+class ParticleKernels
+{
+public:
+	static void UpdateAge (ParticlePool& pool, std::size_t begin, std::size_t end, float deltaTime);
+
+	static void UpdateTween (ParticlePool& pool, std::size_t begin, std::size_t end,
+		const ParticleCurve& tweenCurve);
+	static void UpdateGravity (ParticlePool& pool, std::size_t begin, std::size_t end,
+		const glm::vec3& gravity, float deltaTime);
+	static void UpdateScale (ParticlePool& pool, std::size_t begin, std::size_t end,
+		const ParticleCurve& scaleCurve);
+};
+
+#endif
\ No newline at end of file
@@ -0,0 +1,118 @@
+#include "ParticlePool.h"
+
+#include <algorithm>
+
+ParticlePool::ParticlePool () :
+	positionX (),
+	positionY (),
+	positionZ (),
+	initialPositionX (),
+	initialPositionY (),
+	initialPositionZ (),
+	velocityX (),
+	velocityY (),
+	velocityZ (),
+	age (),
+	lifetime (),
+	initialScale (),
+	scale (),
+	rotation (),
+	_size (0)
+{
+
+}
+
+/*
+ * Alive particles over the new capacity are dropped
+*/
+
+void ParticlePool::Reserve (std::size_t capacity)
+{
+	positionX.resize (capacity);
+	positionY.resize (capacity);
+	positionZ.resize (capacity);
+	initialPositionX.resize (capacity);
+	initialPositionY.resize (capacity);
+	initialPositionZ.resize (capacity);
+	velocityX.resize (capacity);
+	velocityY.resize (capacity);
+	velocityZ.resize (capacity);
+	age.resize (capacity);
+	lifetime.resize (capacity);
+	initialScale.resize (capacity);
+	scale.resize (capacity);
+	rotation.resize (capacity);
+
+	_size = std::min (_size, capacity);
+}
+
+bool ParticlePool::Add (const glm::vec3& position, const glm::vec3& velocity, float particleLifetime,
+	float particleScale, const glm::quat& particleRotation)
+{
+	if (_size == GetCapacity ()) {
+		return false;
+	}
+
+	positionX [_size] = initialPositionX [_size] = position.x;
+	positionY [_size] = initialPositionY [_size] = position.y;
+	positionZ [_size] = initialPositionZ [_size] = position.z;
+	velocityX [_size] = velocity.x;
+	velocityY [_size] = velocity.y;
+	velocityZ [_size] = velocity.z;
+	age [_size] = 0.0f;
+	lifetime [_size] = particleLifetime;
+	initialScale [_size] = scale [_size] = particleScale;
+	rotation [_size] = particleRotation;
+
+	++ _size;
+
+	return true;
+}
+
+void ParticlePool::RemoveDead ()
+{
+	for (std::size_t index = 0; index < _size;) {
+		if (age [index] < lifetime [index]) {
+			++ index;
+
+			continue;
+		}
+
+		-- _size;
+
+		Move (_size, index);
+	}
+}
+
+void ParticlePool::Clear ()
+{
+	_size = 0;
+}
+
+std::size_t ParticlePool::GetSize () const
+{
+	return _size;
+}
+
+std::size_t ParticlePool::GetCapacity () const
+{
+	return age.size ();
+}
+
+void ParticlePool::Move (std::size_t from, std::size_t to)
+{
+	positionX [to] = positionX [from];
+	positionY [to] = positionY [from];
+	positionZ [to] = positionZ [from];
+	initialPositionX [to] = initialPositionX [from];
+	initialPositionY [to] = initialPositionY [from];
+	initialPositionZ [to] = initialPositionZ [from];
+	velocityX [to] = velocityX [from];
+	velocityY [to] = velocityY [from];
+	velocityZ [to] = velocityZ [from];
+	age [to] = age [from];
+	lifetime [to] = lifetime [from];
+	initialScale [to] = initialScale [from];
+	scale [to] = scale [from];
+	rotation [to] = rotation [from];
+}
\ No newline at end of file
@@ -0,0 +1,56 @@
+#ifndef PARTICLEPOOL_H
+#define PARTICLEPOOL_H
+
+#include <vector>
+
+#include "Core/Math/glm/glm.hpp"
+#include "Core/Math/glm/gtc/quaternion.hpp"
+
+/*
+ * Particles of a system kept as a structure of arrays, one array per
+ * attribute, so that the update kernels stream through contiguous
+ * floats. The arrays are sized once to the capacity of the system and
+ * the alive particles are always the first ones: a dead particle is
+ * replaced by the last alive one.
+ *
+ * Ages and lifetimes are in seconds, velocities in units per second.
+*/
+
+class ParticlePool
+{
+public:
+	std::vector<float> positionX;
+	std::vector<float> positionY;
+	std::vector<float> positionZ;
+	std::vector<float> initialPositionX;
+	std::vector<float> initialPositionY;
+	std::vector<float> initialPositionZ;
+	std::vector<float> velocityX;
+	std::vector<float> velocityY;
+	std::vector<float> velocityZ;
+	std::vector<float> age;
+	std::vector<float> lifetime;
+	std::vector<float> initialScale;
+	std::vector<float> scale;
+	std::vector<glm::quat> rotation;
+
+protected:
+	std::size_t _size;
+
+public:
+	ParticlePool ();
+
+	void Reserve (std::size_t capacity);
+
+	bool Add (const glm::vec3& position, const glm::vec3& velocity, float lifetime,
+		float scale, const glm::quat& rotation);
+	void RemoveDead ();
+	void Clear ();
+
+	std::size_t GetSize () const;
+	std::size_t GetCapacity () const;
+protected:
+	void Move (std::size_t from, std::size_t to);
+};
+
+#endif
\ No newline at end of file
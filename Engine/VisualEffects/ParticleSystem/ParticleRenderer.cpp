@@ -1,20 +1,18 @@
 #include "ParticleRenderer.h"
 
-#include <string>
-
-#include "Core/Math/glm/vec3.hpp"
-#include "Core/Math/glm/gtc/matrix_transform.hpp"
-
 ParticleRenderer::~ParticleRenderer ()
 {
 	
 }
 
-Buffer<float> ParticleRenderer::GetParticleData ()
+std::size_t ParticleRenderer::GetInstanceSize () const
 {
-	Buffer<float> data;
+	return 0;
+}
 
-	return data;
+void ParticleRenderer::WriteInstances (const ParticlePool& pool, const std::vector<std::uint32_t>& order, float* data)
+{
+	// Do nothing
 }
 
 std::vector<BufferAttribute> ParticleRenderer::GetBufferAttributes ()
@@ -36,30 +34,25 @@ void ParticleRenderer::Attach (Model* model)
 	// Do nothing
 }
 
-void ParticleRenderer::Draw ()
-{
-	// Do nothing. Don't have to implement it
-}
+/*
+ * Translation * scale * rotation, the scale of a particle is the same
+ * on all axes
+*/
 
-Buffer<float> ParticleRenderer::GetModelMatrix ()
+void ParticleRenderer::WriteModelMatrix (const ParticlePool& pool, std::size_t index, float* data)
 {
-	Buffer<float> buffer;
+	glm::mat4 modelMatrix = glm::mat4_cast (pool.rotation [index]);
 
-	glm::vec3 position = _transform->GetPosition ();
-	glm::vec3 scalev = _transform->GetScale ();
-	glm::quat rotationq = _transform->GetRotation ();
+	float scale = pool.scale [index];
 
-	glm::mat4 translate = glm::translate (glm::mat4 (1.f), glm::vec3 (position.x, position.y, position.z));
-	glm::mat4 scale = glm::scale (glm::mat4 (1.f), glm::vec3 (scalev.x, scalev.y, scalev.z));
-	glm::mat4 rotation = glm::mat4_cast(rotationq);
-
-	glm::mat4 modelMatrix = translate * scale * rotation;
+	modelMatrix [0] *= scale;
+	modelMatrix [1] *= scale;
+	modelMatrix [2] *= scale;
+	modelMatrix [3] = glm::vec4 (pool.positionX [index], pool.positionY [index], pool.positionZ [index], 1.0f);
 
 	for (short int i=0;i<4;i++) {
 		for (short int j=0;j<4;j++) {
-			buffer.Add (modelMatrix [i][j]);
+			data [i * 4 + j] = modelMatrix [i][j];
 		}
 	}
-
-	return buffer;
 }
\ No newline at end of file
@@ -1,28 +1,38 @@
 #ifndef PARTICLERENDERER_H
 #define PARTICLERENDERER_H
 
-#include "SceneNodes/Model3DRenderer.h"
+#include "Core/Interfaces/Object.h"
+
+#include <vector>
+#include <cstdint>
+
+#include "ParticlePool.h"
+
+#include "Mesh/Model.h"
 
-#include "Renderer/Buffer.h"
 #include "Renderer/BufferAttribute.h"
 #include "Renderer/PipelineAttribute.h"
 
-class ParticleRenderer : public Model3DRenderer
+/*
+ * Layout of the instance data of a kind of particle. The instances are
+ * written straight from the pool into the mapped instance buffer, in
+ * the order given by the renderer of the system.
+*/
+
+class ParticleRenderer : public Object
 {
 public:
-	using Model3DRenderer::Model3DRenderer;
+	virtual ~ParticleRenderer ();
+
+	virtual std::size_t GetInstanceSize () const;
+	virtual void WriteInstances (const ParticlePool& pool, const std::vector<std::uint32_t>& order, float* data);
 
-	virtual Buffer<float> GetParticleData ();
 	virtual std::vector<PipelineAttribute> GetUniformAttributes ();
 	virtual std::vector<BufferAttribute> GetBufferAttributes ();
 
-	virtual ~ParticleRenderer ();
-
 	virtual void Attach (Model* mesh);
-
-	void Draw ();
 protected:
-	Buffer<float> GetModelMatrix ();
+	static void WriteModelMatrix (const ParticlePool& pool, std::size_t index, float* data);
 };
 
 #endif
\ No newline at end of file
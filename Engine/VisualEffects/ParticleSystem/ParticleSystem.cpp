@@ -3,39 +3,49 @@
 #include <vector>
 
 #include "Systems/Time/Time.h"
-
-#include "Utils/Curves/EaseCurve.h"
+#include "Systems/Physics/Physics.h"
 
 #include "Emiter.h"
 #include "Particle.h"
 
 #include "ParticleSystemRenderer.h"
 
+#include "Utils/Threads/JobSystem.h"
+
+#include "Debug/Profiler/Profiler.h"
+
 ParticleSystem::ParticleSystem () :
 	_emiter (nullptr),
+	_pool (),
+	_scaleCurve (),
+	_tweenCurve (),
 	_emissionRate (40),
 	_useDepthMask (false),
 	_useGravity (true),
 	_partCount (500, 1000),
 	_timeFromLastEmission (0)
 {
+	_pool.Reserve (_partCount.second);
+
 	delete _renderer;
-	_renderer = new ParticleSystemRenderer (_transform);
+	_renderer = new ParticleSystemRenderer (_transform, &_pool);
 	_renderer->SetStageType (Renderer::FORWARD_STAGE);
 	_renderer->SetPriority (2);
+
+	ParticleSystemRenderer* renderer = dynamic_cast<ParticleSystemRenderer*> (_renderer);
+	renderer->SetParticlesCount (_partCount.second);
 }
 
 ParticleSystem::~ParticleSystem ()
 {
 	delete _emiter;
-
-	for (std::size_t i=0;i<_particles.size ();i++) {
-		delete _particles [i];
-	}
-	_particles.clear ();
-	_particles.shrink_to_fit ();
 }
 
+/*
+ * The curves of the emiter are sampled here, they are set before the
+ * emiter is attached
+*/
+
 void ParticleSystem::SetEmiter (Emiter* emiter)
 {
 	if (_emiter) {
@@ -45,6 +55,9 @@ void ParticleSystem::SetEmiter (Emiter* emiter)
 	emiter->GetTransform ()->SetParent (_transform);
 	_emiter = emiter;
 
+	_scaleCurve.Sample (emiter->GetScaleCurve ());
+	_tweenCurve.Sample (emiter->GetTweenCurve ());
+
 	ParticleSystemRenderer* renderer = dynamic_cast<ParticleSystemRenderer*> (_renderer);
 	renderer->SetInstance (emiter->GetParticlePrototype ());
 	renderer->SetDepthMaskCheck (_useDepthMask);
@@ -77,62 +90,64 @@ void ParticleSystem::SetMaximPartCount (std::size_t count)
 {
 	_partCount.second = count;
 
+	_pool.Reserve (count);
+
 	ParticleSystemRenderer* renderer = dynamic_cast<ParticleSystemRenderer*> (_renderer);
 	renderer->SetParticlesCount (count);
 }
 
+std::size_t ParticleSystem::GetParticlesCount () const
+{
+	return _pool.GetSize ();
+}
+
+/*
+ * Particles that reach their lifetime are removed before the update,
+ * the ones emitted in this frame start moving in the next one. The
+ * kernels run on chunks of the pool in parallel, removal and emission
+ * change its size and stay serial.
+*/
+
 void ParticleSystem::Update ()
 {
-	// Update particles
-	for (std::size_t i=0;i<_particles.size ();i++) {
-		_particles [i]->Update ();
-	}
+	PROFILER_LOGGER("Particles")
 
-	// Remove dead particles
-	for (std::size_t i=0;i<_particles.size ();) {
-		if (!_particles [i]->IsAlive ()) {
-			Particle* doomed = _particles [i];
+	float deltaTime = Time::GetDeltaTime ();
 
-			_particles [i] = _particles.back ();
-			_particles.pop_back ();
+	JobSystem::Instance ()->ParallelFor (_pool.GetSize (), PARTICLE_SYSTEM_PARTICLES_PER_JOB,
+		[this, deltaTime] (std::size_t begin, std::size_t end) {
+			ParticleKernels::UpdateAge (_pool, begin, end, deltaTime);
+		});
 
-			RemoveParticle (doomed);
-		} else {
-			++ i;
-		}
-	}
+	_pool.RemoveDead ();
+
+	bool useGravity = _emiter->GetParticlePrototype ()->GetGravityUse ();
+	glm::vec3 gravity = Physics::Instance ().GetGravityVector ();
+
+	JobSystem::Instance ()->ParallelFor (_pool.GetSize (), PARTICLE_SYSTEM_PARTICLES_PER_JOB,
+		[this, deltaTime, useGravity, &gravity] (std::size_t begin, std::size_t end) {
+			if (useGravity) {
+				ParticleKernels::UpdateGravity (_pool, begin, end, gravity, deltaTime);
+			} else {
+				ParticleKernels::UpdateTween (_pool, begin, end, _tweenCurve);
+			}
+
+			ParticleKernels::UpdateScale (_pool, begin, end, _scaleCurve);
+		});
 
 	// Generate particle at specified rate
-	_timeFromLastEmission += Time::GetDeltaTime ();
+	_timeFromLastEmission += deltaTime;
 
 	float timePerEmission = 1.0f / _emissionRate;
 
 	while ((_timeFromLastEmission > timePerEmission ||
-		_particles.size () < _partCount.first) &&
-		_particles.size () < _partCount.second) 
+		_pool.GetSize () < _partCount.first) &&
+		_pool.GetSize () < _partCount.second) 
 	{
-		Particle* particle = _emiter->GetParticle ();
-
-		AddParticle (particle);
+		_emiter->Emit (&_pool);
 
 		if (_timeFromLastEmission > timePerEmission) {
 			_timeFromLastEmission -= timePerEmission;
 		}
 	}
-}
-
-void ParticleSystem::AddParticle (Particle* particle)
-{
-	_particles.push_back (particle);
-
-	ParticleSystemRenderer* renderer = dynamic_cast <ParticleSystemRenderer*> (_renderer);
-	renderer->AddRenderer (dynamic_cast<ParticleRenderer*> (particle->GetRenderer ()));
-}
-
-void ParticleSystem::RemoveParticle (Particle* particle)
-{
-	ParticleSystemRenderer* renderer = dynamic_cast <ParticleSystemRenderer*> (_renderer);
-	renderer->RemoveRenderer (dynamic_cast<ParticleRenderer*> (particle->GetRenderer ()));
-
-	delete particle;
 }
\ No newline at end of file
@@ -8,12 +8,24 @@
 
 #include "Emiter.h"
 #include "Particle.h"
+#include "ParticlePool.h"
+#include "ParticleKernels.h"
+
+/*
+ * Particles updated by a single job, large enough that small systems
+ * are updated by the calling thread alone
+*/
+
+#define PARTICLE_SYSTEM_PARTICLES_PER_JOB 16384
 
 class ParticleSystem : public SceneObject
 {
 protected:
 	Emiter* _emiter;
-	std::vector<Particle*> _particles;
+	ParticlePool _pool;
+
+	ParticleCurve _scaleCurve;
+	ParticleCurve _tweenCurve;
 
 	std::size_t _emissionRate;
 	bool _useDepthMask;
@@ -34,10 +46,9 @@ public:
 	void SetDepthMaskCheck (bool check);
 	void SetGravityUse (bool use);
 
+	std::size_t GetParticlesCount () const;
+
 	void Update ();
-private:
-	void AddParticle (Particle* particle);
-	void RemoveParticle (Particle* particle);
 };
 
 #endif
\ No newline at end of file
@@ -2,34 +2,41 @@
 
 #include "ParticleSystemRenderer.h"
 
+#include <algorithm>
+#include <cstring>
+
 #include "Core/Math/glm/vec3.hpp"
-#include "Core/Math/glm/gtx/norm.hpp"
 
 #include "Systems/Camera/Camera.h"
 
 #include "Renderer/Pipeline.h"
-#include "Texture/Texture.h"
-#include "Texture/TextureAtlas.h"
+#include "Renderer/StreamingBuffer.h"
 #include "Managers/MaterialManager.h"
-#include "Managers/TextureManager.h"
 
 #include "Wrappers/OpenGL/GL.h"
 
 #include "Core/Console/Console.h"
 
-void ParticleSystemRenderer::AddRenderer (ParticleRenderer* renderer)
-{
-	_particleRenderers.push_back (renderer);
-}
 
-void ParticleSystemRenderer::RemoveRenderer (ParticleRenderer* renderer)
+ParticleSystemRenderer::ParticleSystemRenderer (Transform* transform, ParticlePool* pool) :
+	Model3DRenderer (transform),
+	_pool (pool),
+	_particleRenderer (nullptr),
+	_particlesCount (0),
+	_useDepthMask (false),
+	_isClamped (false),
+	_order (),
+	_sortBuffer (),
+	_depthKeys (),
+	_depthKeysBuffer (),
+	_instanceVAOs ()
 {
-	_toBeRemoved.insert (renderer);
+
 }
 
 void ParticleSystemRenderer::SetInstance (Particle* particle)
 {
-	_particleInstance = particle;
+	_particleRenderer = particle->GetRenderer ();
 	this->Attach (particle->GetMesh ());
 }
 
@@ -45,38 +52,89 @@ void ParticleSystemRenderer::SetDepthMaskCheck (bool check)
 
 void ParticleSystemRenderer::Draw ()
 {
-	RemoveMarked ();
+	if (_pool->GetSize () == 0) {
+		return;
+	}
 
 	GLboolean depthMaskCheck;
 	GL::GetBooleanv (GL_DEPTH_WRITEMASK, &depthMaskCheck); 
 	if (!_useDepthMask) {
 		GL::DepthMask ( GL_FALSE );
 
-		InsertionSort ();
+		SortByDepth ();
+
+		/*
+		 * Past the particles count the farthest are left out, they are
+		 * at the front of the back to front order
+		*/
+
+		if (_order.size () > _particlesCount) {
+			_order.erase (_order.begin (), _order.end () - _particlesCount);
+		}
 	} else {
 		GL::DepthMask (GL_TRUE);
+
+		_order.resize (std::min (_pool->GetSize (), _particlesCount));
+
+		for (std::size_t index = 0; index < _order.size (); index++) {
+			_order [index] = (std::uint32_t) index;
+		}
 	}
 
-	Pipeline::SetObjectTransform (_transform);
+	/*
+	 * All the groups of the mesh draw the same instances, they are
+	 * written once in the streaming buffer for this frame
+	*/
 
-	Buffer<float> instancesBuffer;
-	
-	for (ParticleRenderer* particleRenderer : _particleRenderers) {
-		instancesBuffer.Add (particleRenderer->GetParticleData ());
+	std::size_t instanceSize = _particleRenderer->GetInstanceSize () * sizeof (float);
+
+	/*
+	 * The instances that do not fit in what is left of the frame region
+	 * are not drawn. The farthest go first, they are at the front of
+	 * the back to front order.
+	*/
+
+	std::size_t availableCount = StreamingBuffer::Instance ()->GetAvailableSize (instanceSize) / instanceSize;
+
+	bool isClamped = _order.size () > availableCount;
+
+	if (isClamped) {
+		if (!_isClamped) {
+			Console::LogWarning ("Particle system has more instances than the streaming buffer can take, " +
+				std::to_string (_order.size () - availableCount) + " are not drawn.");
+		}
+
+		_order.erase (_order.begin (), _order.end () - availableCount);
 	}
 
-	if (_particleRenderers.size () == 0) {
+	_isClamped = isClamped;
+
+	if (_order.empty ()) {
+		GL::DepthMask ( depthMaskCheck );
+
 		return;
 	}
 
-	std::vector<PipelineAttribute> uniformAttributes = _particleRenderers [0]->GetUniformAttributes ();
+	StreamingAllocation allocation = StreamingBuffer::Instance ()->Allocate (_order.size () * instanceSize, instanceSize);
 
-	for (std::size_t i=0;i<_drawableObjects.size ();i++) {
-		Material* mat = MaterialManager::Instance ().GetMaterial (_drawableObjects [i].MAT_NAME);
+	if (allocation.data == nullptr) {
+		GL::DepthMask ( depthMaskCheck );
 
-		if (mat == nullptr) {
-			mat = MaterialManager::Instance ().Default ();
-		}
+		return;
+	}
+
+	_particleRenderer->WriteInstances (*_pool, _order, (float*) allocation.data);
+
+	StreamingBuffer::Instance ()->Commit (allocation);
+
+	GLuint baseInstance = (GLuint) (allocation.offset / instanceSize);
+
+	Pipeline::SetObjectTransform (_transform);
+
+	std::vector<PipelineAttribute> uniformAttributes = _particleRenderer->GetUniformAttributes ();
+
+	for (std::size_t i=0;i<_drawableObjects.size ();i++) {
+		Material* mat = MaterialManager::Instance ().GetMaterial (_drawableObjects [i].MAT_ID);
 
 		GL::Enable (GL_BLEND);
 		GL::BlendFunc (mat->blending.first, mat->blending.second);
@@ -85,89 +143,117 @@ void ParticleSystemRenderer::Draw ()
 		
 		Pipeline::SendCustomAttributes (mat->shaderName, uniformAttributes);
 
-		if (_drawableObjects [i].VBO_INSTANCE_INDEX == 0) {
-			CreateVBO (_drawableObjects [i], _particleRenderers [0]->GetBufferAttributes ());
+		if (std::find (_instanceVAOs.begin (), _instanceVAOs.end (), _drawableObjects [i].VAO_INDEX) == _instanceVAOs.end ()) {
+			CreateVBO (_drawableObjects [i], _particleRenderer->GetBufferAttributes ());
 		}
 
-		FeedVBO (_drawableObjects [i], instancesBuffer);
-
 		//bind pe containerul de stare de geometrie (vertex array object)
 		GL::BindVertexArray (_drawableObjects [i].VAO_INDEX);
 		//comanda desenare
-		GL::DrawElementsInstanced(GL_TRIANGLES, _drawableObjects [i].INDEX_COUNT, GL_UNSIGNED_INT, 0, _particleRenderers.size ());
+		GL::DrawElementsInstancedBaseInstance (GL_TRIANGLES, _drawableObjects [i].INDEX_COUNT,
+			_drawableObjects [i].INDEX_TYPE, 0, _order.size (), baseInstance);
 	}
 	
 	GL::DepthMask ( depthMaskCheck );
 }
 
-void ParticleSystemRenderer::RemoveMarked ()
+/*
+ * The instances need their own vertex array, they are never drawn from
+ * the static geometry arena
+*/
+
+StaticGeometryArena* ParticleSystemRenderer::GetStaticGeometryArena ()
 {
-	std::set<ParticleRenderer*>::iterator it;
-	for (std::size_t i=0;i<_particleRenderers.size ();) {
-		it = _toBeRemoved.find (_particleRenderers [i]);
-		if (it != _toBeRemoved.end ()) {
-			_particleRenderers [i] = _particleRenderers.back ();
-			_particleRenderers.pop_back ();
-			_toBeRemoved.erase (it);
+	return nullptr;
+}
 
-			continue;
-		}
+/*
+ * Back to front order of the particles by their view depth, quantized
+ * to 16 bits over the depth range of the camera and sorted with two
+ * passes of a least significant digit radix sort. Particles at the same
+ * quantized depth keep the order of the pool.
+*/
+
+void ParticleSystemRenderer::SortByDepth ()
+{
+	Camera* camera = Camera::Main ();
+
+	glm::vec3 cameraPosition = camera->GetPosition ();
+	glm::vec3 cameraForward = camera->GetForward ();
+
+	float zFar = camera->GetZFar ();
+	float depthScale = 65535.0f / std::max (zFar - camera->GetZNear (), 1e-6f);
+
+	std::size_t size = _pool->GetSize ();
+
+	_order.resize (size);
+	_sortBuffer.resize (size);
+	_depthKeys.resize (size);
+	_depthKeysBuffer.resize (size);
 
-		i ++;
+	for (std::size_t index = 0; index < size; index++) {
+		float depth = cameraForward.x * (_pool->positionX [index] - cameraPosition.x) +
+			cameraForward.y * (_pool->positionY [index] - cameraPosition.y) +
+			cameraForward.z * (_pool->positionZ [index] - cameraPosition.z);
+
+		float key = std::min (std::max ((zFar - depth) * depthScale, 0.0f), 65535.0f);
+
+		_depthKeys [index] = (std::uint16_t) key;
+		_order [index] = (std::uint32_t) index;
 	}
 
-	_toBeRemoved.clear ();
-}
+	for (std::size_t digit = 0; digit < sizeof (std::uint16_t); digit++) {
+		std::size_t counts [256];
 
-// The elements that will be sorted will be after
-// one framed passed. This means that them don't
-// change too much after the last sort, so will
-// use a sorting algorithm that works better in
-// almost sorted sets
-// LE: Can improve this.
-void ParticleSystemRenderer::InsertionSort ()
-{
-	glm::vec3 camPos = Camera::Main ()->GetPosition ();
+		std::memset (counts, 0, sizeof (counts));
 
-	for (std::size_t i=1;i<_particleRenderers.size ();i++) {
-		float dist = glm::distance2 (camPos, 
-			_particleRenderers [i]->GetTransform ()->GetPosition ());
+		for (std::size_t index = 0; index < size; index++) {
+			counts [(_depthKeys [index] >> (digit * 8)) & 0xFF] ++;
+		}
 
-		for (std::size_t j=i-1;j>=0;j--) {
-			float prevDist = glm::distance2 (camPos,
-				_particleRenderers [j]->GetTransform ()->GetPosition ());
+		if (std::find (counts, counts + 256, size) != counts + 256) {
+			continue;
+		}
 
-			if (dist <= prevDist) {
-				break;
-			}
+		std::size_t offset = 0;
 
-			std::swap (_particleRenderers [j+1], _particleRenderers [j]);
+		for (std::size_t bucket = 0; bucket < 256; bucket++) {
+			std::size_t count = counts [bucket];
 
-			if (j == 0) {
-				break;
-			}
+			counts [bucket] = offset;
+			offset += count;
 		}
+
+		for (std::size_t index = 0; index < size; index++) {
+			std::size_t position = counts [(_depthKeys [index] >> (digit * 8)) & 0xFF] ++;
+
+			_depthKeysBuffer [position] = _depthKeys [index];
+			_sortBuffer [position] = _order [index];
+		}
+
+		_depthKeys.swap (_depthKeysBuffer);
+		_order.swap (_sortBuffer);
 	}
 }
 
+/*
+ * The instance attributes read the streaming buffer from its start, the
+ * base instance of each draw moves them to the data of the frame. The
+ * buffer is shared, it is not kept as the instance buffer of the object
+ * so that Clear does not delete it.
+*/
+
 void ParticleSystemRenderer::CreateVBO (BufferObject& bufferObject, const std::vector<BufferAttribute>& bufferAttributes)
 {
 	GL::BindVertexArray(bufferObject.VAO_INDEX);
 
-	GL::GenBuffers(1, &bufferObject.VBO_INSTANCE_INDEX);
-	GL::BindBuffer(GL_ARRAY_BUFFER, bufferObject.VBO_INSTANCE_INDEX);
-	GL::BufferData(GL_ARRAY_BUFFER, bufferAttributes [0].stride * _particlesCount, NULL, GL_DYNAMIC_DRAW);	
+	GL::BindBuffer(GL_ARRAY_BUFFER, StreamingBuffer::Instance ()->GetBuffer ());
 
 	for (BufferAttribute attr : bufferAttributes) {
 		GL::EnableVertexAttribArray (attr.index);
 		GL::VertexAttribPointer (attr.index, attr.size, attr.type, GL_FALSE, attr.stride, (void*) attr.pointer);
 		GL::VertexAttribDivisor (attr.index, 1);
 	}
-}
 
-void ParticleSystemRenderer::FeedVBO (BufferObject& bufferObject, const Buffer<float>& buffer)
-{
-	GL::BindVertexArray(bufferObject.VAO_INDEX);
-	GL::BindBuffer(GL_ARRAY_BUFFER, bufferObject.VBO_INSTANCE_INDEX);
-	GL::BufferSubData(GL_ARRAY_BUFFER, 0, buffer.GetBytesCount (), buffer.GetPointer ());
+	_instanceVAOs.push_back (bufferObject.VAO_INDEX);
 }
\ No newline at end of file
@@ -4,29 +4,40 @@
 #include "SceneNodes/Model3DRenderer.h"
 
 #include <vector>
-#include <set>
+#include <cstdint>
 
 #include "ParticleRenderer.h"
+#include "ParticlePool.h"
 #include "Particle.h"
 
 #include "Material/Material.h"
 
 #include "Renderer/BufferAttribute.h"
 
+/*
+ * Draws all the particles of a system with one instanced draw per group
+ * of its mesh. The instances are written straight from the pool in the
+ * streaming buffer, back to front when the particles do not write depth.
+*/
+
 class ParticleSystemRenderer : public Model3DRenderer
 {
 protected:
-	std::set<ParticleRenderer*> _toBeRemoved;
-	std::vector<ParticleRenderer*> _particleRenderers;
-	Particle* _particleInstance;
+	ParticlePool* _pool;
+	ParticleRenderer* _particleRenderer;
 	std::size_t _particlesCount;
 	bool _useDepthMask;
+	bool _isClamped;
 
-public:
-	using Model3DRenderer::Model3DRenderer;
+	std::vector<std::uint32_t> _order;
+	std::vector<std::uint32_t> _sortBuffer;
+	std::vector<std::uint16_t> _depthKeys;
+	std::vector<std::uint16_t> _depthKeysBuffer;
 
-	void AddRenderer (ParticleRenderer* renderer);
-	void RemoveRenderer (ParticleRenderer* renderer);
+	std::vector<unsigned int> _instanceVAOs;
+
+public:
+	ParticleSystemRenderer (Transform* transform, ParticlePool* pool);
 
 	void SetInstance (Particle* particle);
 	void SetParticlesCount (std::size_t count);
@@ -34,9 +45,9 @@ public:
 
 	void Draw ();
 protected:
-	void RemoveMarked ();
-	void InsertionSort ();
-	void FeedVBO (BufferObject& bufObject, const Buffer<float>& data); 
+	StaticGeometryArena* GetStaticGeometryArena ();
+
+	void SortByDepth ();
 	void CreateVBO (BufferObject& bufObject, const std::vector<BufferAttribute>& attributes);
 };
 
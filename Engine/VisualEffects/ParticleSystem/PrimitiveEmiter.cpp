@@ -8,7 +8,7 @@ PrimitiveEmiter::PrimitiveEmiter () :
 
 }
 
-Particle* PrimitiveEmiter::GetParticle ()
+void PrimitiveEmiter::Emit (ParticlePool* pool)
 {
 	unsigned int lifetime = Random::Instance ().RangeI (_lifetime.first, _lifetime.second);
 	float speed = Random::Instance ().RangeF (_speed.first, _speed.second);
@@ -17,20 +17,8 @@ Particle* PrimitiveEmiter::GetParticle ()
 	glm::vec3 position = this->GetParticlePosition ();
 	glm::vec3 direction = this->GetParticleDirection (position);
 
-	Particle* particle = InstantiateParticle ();
-
-	particle->SetLifetime (lifetime);
-	particle->SetSpeed (speed);
-	particle->SetScaleCurve (_scaleCurve);
-	particle->SetTweenCurve (_tweenCurve);
-	particle->SetMoveDirection (new glm::vec3 (direction));
-	particle->GetTransform ()->SetPosition (position);
-	particle->GetTransform ()->SetScale (glm::vec3 (1.0f) * scale);
-	particle->GetTransform ()->SetRotation (this->GetTransform ()->GetRotation ());
-
-	particle->Init ();
-
-	return particle;
+	pool->Add (position, glm::normalize (direction) * speed, lifetime / 1000.0f,
+		scale, this->GetTransform ()->GetRotation ());
 }
 
 glm::vec3 PrimitiveEmiter::GetParticlePosition ()
@@ -5,14 +5,14 @@
 
 #include "Core/Math/glm/glm.hpp"
 
-#include "Particle.h"
+#include "ParticlePool.h"
 
 class PrimitiveEmiter : public Emiter
 {
 public:
 	PrimitiveEmiter ();
 
-	Particle* GetParticle ();
+	void Emit (ParticlePool* pool);
 protected:
 	virtual glm::vec3 GetParticlePosition ();
 };
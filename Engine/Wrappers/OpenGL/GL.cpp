@@ -1,7 +1,90 @@
 #include "GL.h"
 
+#include "GLDriverBackend.h"
+#include "GLStateCache.h"
+
 #include "Core/Console/Console.h"
 
+static GLDriverBackend driverBackend;
+
+GLBackend* GL::_backend (&driverBackend);
+GLStateCache GL::_stateCache;
+
+/*
+ * The wrapper owns the backend it is given, nullptr goes back to the
+ * driver. Nothing of the state cache holds for another backend.
+*/
+
+void GL::SetBackend (GLBackend* backend)
+{
+	if (_backend != &driverBackend) {
+		delete _backend;
+	}
+
+	_backend = backend != nullptr ? backend : &driverBackend;
+
+	_stateCache.Clear ();
+}
+
+GLBackend* GL::GetBackend ()
+{
+	return _backend;
+}
+
+void GL::EndFrame ()
+{
+	_backend->EndFrame ();
+}
+
+void GL::SetStateCaching (bool isEnabled)
+{
+	_stateCache.SetEnabled (isEnabled);
+}
+
+const GLStateCacheStatistics& GL::GetStateCacheStatistics ()
+{
+	return _stateCache.GetStatistics ();
+}
+
+#ifdef GL_ERROR_CHECK_DISABLE
+
+/*
+ * Only errors and undefined behaviour reach the console, the rest of the
+ * messages are about performance and would flood it
+*/
+
+static void GLAPIENTRY DebugOutputCallback (GLenum source, GLenum type, GLuint id,
+	GLenum severity, GLsizei length, const GLchar* message, const void* userParam)
+{
+	if (type != GL_DEBUG_TYPE_ERROR && type != GL_DEBUG_TYPE_UNDEFINED_BEHAVIOR &&
+		severity != GL_DEBUG_SEVERITY_HIGH) {
+		return;
+	}
+
+	Console::LogError ("GL debug output: " + std::string (message));
+}
+
+#endif
+
+/*
+ * With the error checks compiled out, the driver reports errors through
+ * KHR_debug instead, without a glGetError after every call
+*/
+
+void GL::InitDebugOutput ()
+{
+#ifdef GL_ERROR_CHECK_DISABLE
+	if (!GLEW_KHR_debug) {
+		Console::LogWarning ("KHR_debug is not supported. GL errors will not be reported.");
+		return;
+	}
+
+	Enable (GL_DEBUG_OUTPUT);
+
+	DebugMessageCallback (DebugOutputCallback, nullptr);
+#endif
+}
+
 #ifdef GL_DEPRECATED_PERMIT
 
 /*
@@ -10,14 +93,14 @@
 
 void GL::Begin(GLenum  mode)
 {
-	glBegin (mode);
+	_backend->Begin (mode);
 
 	ErrorCheck ("glBegin");
 }
 
 void GL::End()
 {
-	glEnd();
+	_backend->End();
 
 	ErrorCheck ("glEnd");
 }
@@ -30,7 +113,7 @@ void GL::End()
 
 void GL::Viewport(GLint x,  GLint y,  GLsizei width,  GLsizei height)
 {
-	glViewport(x, y, width, height); 
+	_backend->Viewport(x, y, width, height); 
 
 	ErrorCheck ("glViewport");
 }
@@ -41,63 +124,67 @@ void GL::Viewport(GLint x,  GLint y,  GLsizei width,  GLsizei height)
 
 void GL::Clear(GLbitfield  mask)
 {
-	glClear (mask);
+	_backend->Clear (mask);
 
 	ErrorCheck ("glClear");
 }
 
 void GL::ClearColor(GLclampf red,  GLclampf green,  GLclampf blue,  GLclampf alpha)
 {
-	glClearColor(red, green, blue, alpha);
+	_backend->ClearColor(red, green, blue, alpha);
 
 	ErrorCheck ("glClearColor");
 } 
 
 void GL::ColorMask(GLboolean red,  GLboolean green,  GLboolean blue,  GLboolean alpha)
 {
-	glColorMask (red, green, blue, alpha);
+	_backend->ColorMask (red, green, blue, alpha);
 
 	ErrorCheck ("glColorMask");
 }
 
 void GL::FramebufferTexture (GLenum target, GLenum attachment, GLuint texture, GLint level)
 {
-	glFramebufferTexture (target, attachment, texture, level);
+	_backend->FramebufferTexture (target, attachment, texture, level);
 
 	ErrorCheck ("glFramebufferTexture");
 }
 
 void GL::FramebufferTexture2D(GLenum target,  GLenum attachment,  GLenum textarget,  GLuint texture,  GLint level)
 {
-	glFramebufferTexture2D (target, attachment, textarget, texture, level);
+	_backend->FramebufferTexture2D (target, attachment, textarget, texture, level);
 
 	ErrorCheck ("glFramebufferTexture2D");
 }
 
 void GL::DrawBuffer(GLenum buf)
 {
-	glDrawBuffer (buf);
+	_backend->DrawBuffer (buf);
 
 	ErrorCheck ("glDrawBuffer");
 }
 
 void GL::DrawBuffers(GLsizei n, const GLenum *bufs)
 {
-	glDrawBuffers (n, bufs);
+	_backend->DrawBuffers (n, bufs);
 
 	ErrorCheck ("glDrawBuffers");
 }
 
 void GL::ReadBuffer(GLenum mode)
 {
-	glReadBuffer (mode);
+	_backend->ReadBuffer (mode);
 
 	ErrorCheck ("glReadBuffer");
 }
 
 void GL::BindFramebuffer(GLenum target,  GLuint framebuffer)
 {
-	glBindFramebuffer (target, framebuffer);
+	if (!_stateCache.BindFramebuffer (target, framebuffer)) {
+		return;
+	}
+
+	_backend->BindFramebuffer (target, framebuffer);
 
 	ErrorCheck ("glBindFramebuffer");
 }
@@ -105,14 +192,14 @@ void GL::BindFramebuffer(GLenum target,  GLuint framebuffer)
 void GL::BlitFramebuffer(GLint srcX0, GLint srcY0, GLint srcX1, GLint srcY1, 
 	GLint dstX0, GLint dstY0, GLint dstX1, GLint dstY1, GLbitfield mask, GLenum filter)
 {
-	glBlitFramebuffer (srcX0, srcY0, srcX1, srcY1, dstX0, dstY0, dstX1, dstY1, mask, filter);
+	_backend->BlitFramebuffer (srcX0, srcY0, srcX1, srcY1, dstX0, dstY0, dstX1, dstY1, mask, filter);
 
 	ErrorCheck ("glBlitFramebuffer");
 }
 
 GLenum GL::CheckFramebufferStatus(GLenum target)
 {
-	GLenum check = glCheckFramebufferStatus (target);
+	GLenum check = _backend->CheckFramebufferStatus (target);
 
 	ErrorCheck ("glCheckFramebufferStatus");
 
@@ -125,7 +212,7 @@ GLenum GL::CheckFramebufferStatus(GLenum target)
 
 void GL::Hint(GLenum target,  GLenum mode)
 {
-	glHint (target, mode);
+	_backend->Hint (target, mode);
 
 	ErrorCheck ("glHint");
 }
@@ -136,7 +223,7 @@ void GL::Hint(GLenum target,  GLenum mode)
 
 void GL::CullFace(GLenum mode)
 {
-	glCullFace (mode);
+	_backend->CullFace (mode);
 
 	ErrorCheck ("glCullFace");
 }
@@ -147,127 +234,242 @@ void GL::CullFace(GLenum mode)
 
 void GL::DrawArrays (GLenum mode, GLint first, GLsizei count)
 {
-	glDrawArrays (mode, first, count);
+	_backend->DrawArrays (mode, first, count);
 
 	ErrorCheck ("glDrawArrays");
 }
 
 void GL::DrawElements (GLenum mode, GLsizei count, GLenum type, const void* indices)
 {
-	glDrawElements (mode, count, type, indices);
+	_backend->DrawElements (mode, count, type, indices);
 
 	ErrorCheck ("glDrawElements");
 }
 
 void GL::DrawElementsInstanced (GLenum mode, GLsizei count, GLenum type, const void* indices, GLsizei primcount)
 {
-	glDrawElementsInstanced (mode, count, type, indices, primcount);
+	_backend->DrawElementsInstanced (mode, count, type, indices, primcount);
 
 	ErrorCheck ("glDrawElementsInstanced");
 }
 
+void GL::DrawElementsInstancedBaseInstance (GLenum mode, GLsizei count, GLenum type, const void* indices,
+	GLsizei primcount, GLuint baseinstance)
+{
+	_backend->DrawElementsInstancedBaseInstance (mode, count, type, indices, primcount, baseinstance);
+
+	ErrorCheck ("glDrawElementsInstancedBaseInstance");
+}
+
+void GL::DrawElementsBaseVertex (GLenum mode, GLsizei count, GLenum type, const void* indices, GLint basevertex)
+{
+	_backend->DrawElementsBaseVertex (mode, count, type, (void*) indices, basevertex);
+
+	ErrorCheck ("glDrawElementsBaseVertex");
+}
+
+void GL::MultiDrawElementsIndirect (GLenum mode, GLenum type, const void* indirect, GLsizei drawcount, GLsizei stride)
+{
+	_backend->MultiDrawElementsIndirect (mode, type, indirect, drawcount, stride);
+
+	ErrorCheck ("glMultiDrawElementsIndirect");
+}
+
 /*
  * Buffers
 */
 
 void GL::BufferData (GLenum target, GLsizeiptr size, const GLvoid * data, GLenum usage)
 {
-	glBufferData (target, size, data, usage);
+	_backend->BufferData (target, size, data, usage);
 
 	ErrorCheck ("glBufferData");
 }
 
 void GL::BufferSubData (GLenum target, GLintptr offset, GLsizeiptr size, const GLvoid * data)
 {
-	glBufferSubData (target, offset, size, data);
+	_backend->BufferSubData (target, offset, size, data);
 
 	ErrorCheck ("glBufferSubData");
 }
 
+void* GL::MapBufferRange (GLenum target, GLintptr offset, GLsizeiptr length, GLbitfield access)
+{
+	void* result = _backend->MapBufferRange (target, offset, length, access);
+
+	ErrorCheck ("glMapBufferRange");
+
+	return result;
+}
+
+GLboolean GL::UnmapBuffer (GLenum target)
+{
+	GLboolean result = _backend->UnmapBuffer (target);
+
+	ErrorCheck ("glUnmapBuffer");
+
+	return result;
+}
+
+void GL::BufferStorage (GLenum target, GLsizeiptr size, const GLvoid* data, GLbitfield flags)
+{
+	_backend->BufferStorage (target, size, data, flags);
+
+	ErrorCheck ("glBufferStorage");
+}
+
+/*
+ * Synchronization
+*/
+
+GLsync GL::FenceSync (GLenum condition, GLbitfield flags)
+{
+	GLsync sync = _backend->FenceSync (condition, flags);
+
+	ErrorCheck ("glFenceSync");
+
+	return sync;
+}
+
+GLenum GL::ClientWaitSync (GLsync sync, GLbitfield flags, GLuint64 timeout)
+{
+	GLenum result = _backend->ClientWaitSync (sync, flags, timeout);
+
+	ErrorCheck ("glClientWaitSync");
+
+	return result;
+}
+
+void GL::DeleteSync (GLsync sync)
+{
+	_backend->DeleteSync (sync);
+
+	ErrorCheck ("glDeleteSync");
+}
+
+/*
+ * Queries
+*/
+
+void GL::GenQueries (GLsizei n, GLuint* ids)
+{
+	_backend->GenQueries (n, ids);
+
+	ErrorCheck ("glGenQueries");
+}
+
+void GL::DeleteQueries (GLsizei n, const GLuint* ids)
+{
+	_backend->DeleteQueries (n, ids);
+
+	ErrorCheck ("glDeleteQueries");
+}
+
+void GL::QueryCounter (GLuint id, GLenum target)
+{
+	_backend->QueryCounter (id, target);
+
+	ErrorCheck ("glQueryCounter");
+}
+
+void GL::GetQueryObjectiv (GLuint id, GLenum pname, GLint* params)
+{
+	_backend->GetQueryObjectiv (id, pname, params);
+
+	ErrorCheck ("glGetQueryObjectiv");
+}
+
+void GL::GetQueryObjectui64v (GLuint id, GLenum pname, GLuint64* params)
+{
+	_backend->GetQueryObjectui64v (id, pname, params);
+
+	ErrorCheck ("glGetQueryObjectui64v");
+}
+
 /*
  * Vertex Attributes
 */
 
 void GL::EnableVertexAttribArray (GLuint index)
 {
-	glEnableVertexAttribArray (index);
+	_backend->EnableVertexAttribArray (index);
 
 	ErrorCheck ("glEnableVertexAttribArray");
 }
 
 void GL::VertexAttribPointer (GLuint index, GLint size, GLenum type, GLboolean normalized, GLsizei stride, const GLvoid * pointer)
 {
-	glVertexAttribPointer (index, size, type, normalized, stride, pointer);
+	_backend->VertexAttribPointer (index, size, type, normalized, stride, pointer);
 
 	ErrorCheck ("glVertexAttribPointer");
 }
 
 void GL::VertexAttribIPointer (GLuint index, GLint size, GLenum type, GLsizei stride, const GLvoid * pointer)
 {
-	glVertexAttribIPointer (index, size, type, stride, pointer);
+	_backend->VertexAttribIPointer (index, size, type, stride, pointer);
 
 	ErrorCheck ("glVertexAttribIPointer");
 }
 
 void GL::VertexAttribDivisor(GLuint index, GLuint divisor)
 {
-	glVertexAttribDivisor (index, divisor);
+	_backend->VertexAttribDivisor (index, divisor);
 
 	ErrorCheck ("glVertexAttribDivisor");
 }
 
 void GL::VertexAttrib1f(GLuint index,  GLfloat v0)
 {
-	glVertexAttrib1f(index, v0);
+	_backend->VertexAttrib1f(index, v0);
 
 	ErrorCheck ("glVertexAttrib1f");
 }
 
 void GL::VertexAttrib2f(GLuint index,  GLfloat v0,  GLfloat v1)
 {
-	glVertexAttrib2f (index, v0, v1);
+	_backend->VertexAttrib2f (index, v0, v1);
 
 	ErrorCheck ("glVertexAttrib2f");
 }
 
 void GL::VertexAttrib3f(GLuint index,  GLfloat v0,  GLfloat v1,  GLfloat v2)
 {
-	glVertexAttrib3f (index, v0, v1, v2);
+	_backend->VertexAttrib3f (index, v0, v1, v2);
 
 	ErrorCheck ("glVertexAttrib3f");
 }
 
 void GL::VertexAttrib4f(GLuint index,  GLfloat v0,  GLfloat v1,  GLfloat v2,  GLfloat v3)
 {
-	glVertexAttrib4f (index, v0, v1, v2, v3);
+	_backend->VertexAttrib4f (index, v0, v1, v2, v3);
 
 	ErrorCheck ("glVertexAttrib4f");
 }
 
 void GL::VertexAttrib1fv(GLuint index,  const GLfloat *v)
 {
-	glVertexAttrib1fv (index, v);
+	_backend->VertexAttrib1fv (index, v);
 
 	ErrorCheck ("glVertexAttrib1fv");
 }
 
 void GL::VertexAttrib2fv(GLuint index,  const GLfloat *v)
 {
-	glVertexAttrib2fv (index, v);
+	_backend->VertexAttrib2fv (index, v);
 
 	ErrorCheck ("glVertexAttrib2fv");
 }
 
 void GL::VertexAttrib3fv(GLuint index,  const GLfloat *v)
 {
-	glVertexAttrib3fv (index, v);
+	_backend->VertexAttrib3fv (index, v);
 
 	ErrorCheck ("glVertexAttrib3fv");
 }
 
 void GL::VertexAttrib4fv(GLuint index,  const GLfloat *v)
 {
-	glVertexAttrib4fv (index, v);
+	_backend->VertexAttrib4fv (index, v);
 
 	ErrorCheck ("glVertexAttrib4fv");
 }
@@ -278,46 +480,78 @@ void GL::VertexAttrib4fv(GLuint index,  const GLfloat *v)
 
 void GL::BindVertexArray (GLuint array)
 {
-	glBindVertexArray (array);
+	if (!_stateCache.BindVertexArray (array)) {
+		return;
+	}
+
+	_backend->BindVertexArray (array);
 
 	ErrorCheck ("glBindVertexArray");
 }
 
 void GL::BindBuffer(GLenum target, GLuint buffer)
 {
-	glBindBuffer(target, buffer);
+	if (!_stateCache.BindBuffer (target, buffer)) {
+		return;
+	}
+
+	_backend->BindBuffer(target, buffer);
 
 	ErrorCheck ("glBindBuffer");
 }
 
+void GL::BindBufferBase(GLenum target, GLuint index, GLuint buffer)
+{
+	if (!_stateCache.BindBufferBase (target, index, buffer)) {
+		return;
+	}
+
+	_backend->BindBufferBase(target, index, buffer);
+
+	ErrorCheck ("glBindBufferBase");
+}
+
+void GL::BindBufferRange(GLenum target, GLuint index, GLuint buffer, GLintptr offset, GLsizeiptr size)
+{
+	_stateCache.BindBufferRange (target, index, buffer);
+
+	_backend->BindBufferRange(target, index, buffer, offset, size);
+
+	ErrorCheck ("glBindBufferRange");
+}
+
 /*
  * Depth Buffer
 */
 
 void GL::DepthMask (GLboolean flag)
 {
-	glDepthMask (flag);
+	if (!_stateCache.DepthMask (flag)) {
+		return;
+	}
+
+	_backend->DepthMask (flag);
 
 	ErrorCheck ("glDepthMask");
 }
 
 void GL::DepthRange(GLclampd nearVal, GLclampd farVal)
 {
-	glDepthRange (nearVal, farVal);
+	_backend->DepthRange (nearVal, farVal);
 
 	ErrorCheck ("glDepthRange");
 }
 
 void GL::ClearDepth(GLclampd  depth)
 {
-	glClearDepth (depth);
+	_backend->ClearDepth (depth);
 
 	ErrorCheck ("glClearDepth");
 }
 
 void GL::DepthFunc(GLenum func)
 {
-	glDepthFunc(func);
+	_backend->DepthFunc(func);
 
 	ErrorCheck ("glDepthFunc");
 }
@@ -328,28 +562,28 @@ void GL::DepthFunc(GLenum func)
 
 void GL::StencilFunc(GLenum func, GLint ref, GLuint mask)
 {
-	glStencilFunc (func, ref, mask);
+	_backend->StencilFunc (func, ref, mask);
 
 	ErrorCheck ("glStencilFunc");
 }
 
 void GL::StencilOp(GLenum sfail, GLenum dpfail, GLenum dppass)
 {
-	glStencilOp (sfail, dpfail, dppass);
+	_backend->StencilOp (sfail, dpfail, dppass);
 
 	ErrorCheck ("glStencilOp");
 }
 
 void GL::StencilOpSeparate(GLenum face, GLenum sfail, GLenum dpfail, GLenum dppass)
 {
-	glStencilOpSeparate(face, sfail, dpfail, dppass);
+	_backend->StencilOpSeparate(face, sfail, dpfail, dppass);
 
 	ErrorCheck ("glStencilOpSeparate");
 }
 
 void GL::StencilMask(GLuint mask)
 {
-	glStencilMask (mask);
+	_backend->StencilMask (mask);
 
 	ErrorCheck ("glStencilMask");
 }
@@ -360,21 +594,21 @@ void GL::StencilMask(GLuint mask)
 
 void GL::BlendFunc (GLenum sfactor, GLenum dfactor)
 {
-	glBlendFunc (sfactor, dfactor);
+	_backend->BlendFunc (sfactor, dfactor);
 
 	ErrorCheck ("glBlendFunc");
 }
 
 void GL::BlendFunci (GLuint buf, GLenum sfactor, GLenum dfactor)
 {
-	glBlendFunci (buf, sfactor, dfactor);
+	_backend->BlendFunci (buf, sfactor, dfactor);
 
 	ErrorCheck ("glBlendFunci");
 }
 
 void GL::BlendEquation (GLenum mode)
 {
-	glBlendEquation (mode);
+	_backend->BlendEquation (mode);
 
 	ErrorCheck ("glBlendEquation");
 }
@@ -385,28 +619,28 @@ void GL::BlendEquation (GLenum mode)
 
 void GL::GenVertexArrays (GLsizei n, GLuint * arrays)
 {
-	glGenVertexArrays (n, arrays);
+	_backend->GenVertexArrays (n, arrays);
 
 	ErrorCheck ("glGenVertexArrays");
 }
 
 void GL::GenBuffers(GLsizei n,  GLuint * buffers)
 {
-	glGenBuffers (n, buffers);
+	_backend->GenBuffers (n, buffers);
 
 	ErrorCheck ("glGenBuffers");
 }
 
 void GL::GenTextures(GLsizei n,  GLuint * textures)
 {
-	glGenTextures (n, textures);
+	_backend->GenTextures (n, textures);
 
 	ErrorCheck ("glGenTextures");
 }
 
 void GL::GenFramebuffers(GLsizei n,  GLuint * framebuffers)
 {
-	glGenFramebuffers (n, framebuffers);
+	_backend->GenFramebuffers (n, framebuffers);
 
 	ErrorCheck ("glGenFramebuffers");
 }
@@ -417,231 +651,231 @@ void GL::GenFramebuffers(GLsizei n,  GLuint * framebuffers)
 
 void GL::Uniform1f(GLint location,  GLfloat v0)
 {
-	glUniform1f(location, v0);
+	_backend->Uniform1f(location, v0);
 
 	ErrorCheck ("glUniform1f");
 }
 
 void GL::Uniform2f(GLint location,  GLfloat v0,  GLfloat v1)
 {
-	glUniform2f(location, v0, v1);
+	_backend->Uniform2f(location, v0, v1);
 
 	ErrorCheck ("glUniform2f");
 }
 
 void GL::Uniform3f(GLint location,  GLfloat v0,  GLfloat v1,  GLfloat v2)
 {
-	glUniform3f(location, v0, v1, v2);
+	_backend->Uniform3f(location, v0, v1, v2);
 
 	ErrorCheck ("glUniform3f");
 }
 
 void GL::Uniform4f(GLint location,  GLfloat v0,  GLfloat v1,  GLfloat v2,  GLfloat v3)
 {
-	glUniform4f (location, v0, v1, v2, v3);
+	_backend->Uniform4f (location, v0, v1, v2, v3);
 
 	ErrorCheck ("glUniform4f");
 }
 
 void GL::Uniform1i(GLint location,  GLint v0)
 {
-	glUniform1i (location, v0); 
+	_backend->Uniform1i (location, v0); 
 
 	ErrorCheck ("glUniform1i");
 }
 
 void GL::Uniform2i(GLint location,  GLint v0,  GLint v1)
 {
-	glUniform2i(location, v0, v1);
+	_backend->Uniform2i(location, v0, v1);
 
 	ErrorCheck ("glUniform2i");
 }
 
 void GL::Uniform3i(GLint location,  GLint v0,  GLint v1,  GLint v2)
 {
-	glUniform3i(location, v0, v1, v2); 
+	_backend->Uniform3i(location, v0, v1, v2); 
 
 	ErrorCheck ("glUniform3i");
 }
 
 void GL::Uniform4i(GLint location,  GLint v0,  GLint v1,  GLint v2,  GLint v3)
 {
-	glUniform4i(location, v0, v1, v2, v3);
+	_backend->Uniform4i(location, v0, v1, v2, v3);
 
 	ErrorCheck ("glUniform4i");
 }
 
 void GL::Uniform1ui(GLint location, GLuint v0)
 {
-	glUniform1ui(location, v0);
+	_backend->Uniform1ui(location, v0);
 
 	ErrorCheck ("glUniform1ui");
 }
 
 void GL::Uniform2ui(GLint location, GLuint v0, GLuint v1)
 {
-	glUniform2ui(location, v0, v1);
+	_backend->Uniform2ui(location, v0, v1);
 
 	ErrorCheck ("glUniform2ui");
 }
 
 void GL::Uniform3ui(GLint location, GLuint v0, GLuint v1, GLuint v2)
 {
-	glUniform3ui(location, v0, v1, v2);
+	_backend->Uniform3ui(location, v0, v1, v2);
 
 	ErrorCheck ("glUniform3ui");
 }
 
 void GL::Uniform4ui(GLint location, GLuint v0, GLuint v1, GLuint v2, GLuint v3)
 {
-	glUniform4ui(location, v0, v1, v2, v3);
+	_backend->Uniform4ui(location, v0, v1, v2, v3);
 
 	ErrorCheck ("glUniform4ui");
 }
 
 void GL::Uniform1fv(GLint location, GLsizei count, const GLfloat *value)
 {
-	glUniform1fv(location, count, value);
+	_backend->Uniform1fv(location, count, value);
 
 	ErrorCheck ("glUniform1fv");
 }
 
 void GL::Uniform2fv(GLint location, GLsizei count, const GLfloat *value)
 {
-	glUniform2fv(location, count, value);
+	_backend->Uniform2fv(location, count, value);
 
 	ErrorCheck ("glUniform2fv");
 }
 
 void GL::Uniform3fv(GLint location, GLsizei count, const GLfloat *value)
 {
-	glUniform3fv(location, count, value);
+	_backend->Uniform3fv(location, count, value);
 
 	ErrorCheck ("glUniform3fv");
 }
 
 void GL::Uniform4fv(GLint location, GLsizei count, const GLfloat *value)
 {
-	glUniform4fv (location, count, value);
+	_backend->Uniform4fv (location, count, value);
 
 	ErrorCheck ("glUniform4fv");
 }
 
 void GL::Uniform1iv(GLint location, GLsizei count, const GLint *value)
 {
-	glUniform1iv (location, count, value);
+	_backend->Uniform1iv (location, count, value);
 
 	ErrorCheck ("glUniform1iv");
 }
 
 void GL::Uniform2iv(GLint location, GLsizei count, const GLint *value)
 {
-	glUniform2iv (location, count, value);
+	_backend->Uniform2iv (location, count, value);
 
 	ErrorCheck ("glUniform2iv");
 }
 
 void GL::Uniform3iv(GLint location, GLsizei count, const GLint *value)
 {
-	glUniform3iv (location, count, value);
+	_backend->Uniform3iv (location, count, value);
 
 	ErrorCheck ("glUniform3iv");
 }
 
 void GL::Uniform4iv(GLint location, GLsizei count, const GLint *value)
 {
-	glUniform4iv (location, count, value);
+	_backend->Uniform4iv (location, count, value);
 
 	ErrorCheck ("glUniform4iv");
 }
 
 void GL::Uniform1uiv(GLint location, GLsizei count, const GLuint *value)
 {
-	glUniform1uiv (location, count, value);
+	_backend->Uniform1uiv (location, count, value);
 
 	ErrorCheck ("glUniform1uiv");
 }
 
 void GL::Uniform2uiv(GLint location, GLsizei count, const GLuint *value)
 {
-	glUniform2uiv (location, count, value);
+	_backend->Uniform2uiv (location, count, value);
 
 	ErrorCheck ("glUniform2uiv");
 }
 
 void GL::Uniform3uiv(GLint location, GLsizei count, const GLuint *value)
 {
-	glUniform3uiv (location, count, value);
+	_backend->Uniform3uiv (location, count, value);
 
 	ErrorCheck ("glUniform3uiv");
 }
 
 void GL::Uniform4uiv(GLint location, GLsizei count, const GLuint *value)
 {
-	glUniform4uiv (location, count, value);
+	_backend->Uniform4uiv (location, count, value);
 
 	ErrorCheck ("glUniform4uiv");
 }
 
 void GL::UniformMatrix2fv(GLint location, GLsizei count, GLboolean transpose, const GLfloat *value)
 {
-	glUniformMatrix2fv(location, count, transpose, value);
+	_backend->UniformMatrix2fv(location, count, transpose, value);
 
 	ErrorCheck ("glUniformMatrix2fv");
 }
 
 void GL::UniformMatrix3fv(GLint location, GLsizei count, GLboolean transpose, const GLfloat *value)
 {
-	glUniformMatrix3fv(location, count, transpose, value);
+	_backend->UniformMatrix3fv(location, count, transpose, value);
 
 	ErrorCheck ("glUniformMatrix3fv");
 }
 
 void GL::UniformMatrix4fv(GLint location, GLsizei count, GLboolean transpose, const GLfloat *value)
 {
-	glUniformMatrix4fv(location, count, transpose, value); 
+	_backend->UniformMatrix4fv(location, count, transpose, value); 
 
 	ErrorCheck ("glUniformMatrix4fv");
 }
 
 void GL::UniformMatrix2x3fv(GLint location, GLsizei count, GLboolean transpose, const GLfloat *value)
 {
-	glUniformMatrix2x3fv(location, count, transpose, value); 
+	_backend->UniformMatrix2x3fv(location, count, transpose, value); 
 
 	ErrorCheck ("glUniformMatrix2x3fv");
 }
 
 void GL::UniformMatrix3x2fv(GLint location, GLsizei count, GLboolean transpose, const GLfloat *value)
 {
-	glUniformMatrix3x2fv(location, count, transpose, value);
+	_backend->UniformMatrix3x2fv(location, count, transpose, value);
 
 	ErrorCheck ("glUniformMatrix3x2fv");
 }
 
 void GL::UniformMatrix2x4fv(GLint location, GLsizei count, GLboolean transpose, const GLfloat *value)
 {
-	glUniformMatrix2x4fv(location, count, transpose, value); 
+	_backend->UniformMatrix2x4fv(location, count, transpose, value); 
 
 	ErrorCheck ("glUniformMatrix2x4fv");
 }
 
 void GL::UniformMatrix4x2fv(GLint location, GLsizei count, GLboolean transpose, const GLfloat *value)
 {
-	glUniformMatrix4x2fv(location, count, transpose, value);
+	_backend->UniformMatrix4x2fv(location, count, transpose, value);
 
 	ErrorCheck ("glUniformMatrix4x2fv");
 } 
 
 void GL::UniformMatrix3x4fv(GLint location, GLsizei count, GLboolean transpose, const GLfloat *value)
 {
-	glUniformMatrix3x4fv(location, count, transpose, value);
+	_backend->UniformMatrix3x4fv(location, count, transpose, value);
 
 	ErrorCheck ("glUniformMatrix3x4fv");
 }
 
 void GL::UniformMatrix4x3fv(GLint location, GLsizei count, GLboolean transpose, const GLfloat *value)
 {
-	glUniformMatrix4x3fv(location, count, transpose, value);
+	_backend->UniformMatrix4x3fv(location, count, transpose, value);
 
 	ErrorCheck ("glUniformMatrix4x3fv");
 }
@@ -652,34 +886,59 @@ void GL::UniformMatrix4x3fv(GLint location, GLsizei count, GLboolean transpose,
 
 void GL::MemoryBarrier (GLbitfield barriers)
 {
-	glMemoryBarrier (barriers);
+	_backend->MemoryBarrier (barriers);
 
 	ErrorCheck ("glMemoryBarrier");
 }
 
+/*
+ * Debug
+*/
+
+void GL::DebugMessageCallback (GLDEBUGPROC callback, const void* userParam)
+{
+	_backend->DebugMessageCallback (callback, userParam);
+
+	ErrorCheck ("glDebugMessageCallback");
+}
+
 /*
  * Capabilities
 */
 
 void GL::Enable (GLenum cap)
 {
-	glEnable (cap);
+	if (!_stateCache.SetCapability (cap, true)) {
+		return;
+	}
+
+	_backend->Enable (cap);
 
 	ErrorCheck ("glEnable");
 }
 
 void GL::Disable (GLenum cap)
 {
-	glDisable (cap);
+	if (!_stateCache.SetCapability (cap, false)) {
+		return;
+	}
+
+	_backend->Disable (cap);
 
 	ErrorCheck ("glDisable");
 }
 
 void GL::IsEnabled(GLenum cap, bool *val)
 {
-	*val = glIsEnabled (cap);
+	if (_stateCache.GetCapability (cap, *val)) {
+		return;
+	}
+
+	*val = _backend->IsEnabled (cap);
 
 	ErrorCheck ("glIsEnabled");
+
+	_stateCache.StoreCapability (cap, *val);
 }
 
 /*
@@ -688,14 +947,22 @@ void GL::IsEnabled(GLenum cap, bool *val)
 
 void GL::BindTexture(GLenum target, GLuint texture)
 {
-	glBindTexture (target, texture);
+	if (!_stateCache.BindTexture (target, texture)) {
+		return;
+	}
+
+	_backend->BindTexture (target, texture);
 
 	ErrorCheck ("glBindTexture");
 }
 
 void GL::ActiveTexture(GLenum texture)
 {
-	glActiveTexture (texture);
+	if (!_stateCache.ActiveTexture (texture)) {
+		return;
+	}
+
+	_backend->ActiveTexture (texture);
 
 	ErrorCheck ("glActiveTexture");
 }
@@ -705,7 +972,7 @@ void GL::TexImage2D(GLenum target,  GLint level,  GLint internalformat,
 	GLsizei width,  GLsizei height,  GLint border,  GLenum format,  
 	GLenum type,  const GLvoid * data)
 {
-	glTexImage2D (target, level, internalformat, width, height, border,
+	_backend->TexImage2D (target, level, internalformat, width, height, border,
 		format, type, data);
 
 	ErrorCheck ("glTexImage2D");
@@ -715,68 +982,110 @@ void GL::TexImage3D(GLenum target, GLint level, GLint internalFormat,
 	GLsizei width, GLsizei height, GLsizei depth, GLint border, 
 	GLenum format, GLenum type, const GLvoid * data)
 {
-	glTexImage3D(target, level, internalFormat, width, height, depth, 
+	_backend->TexImage3D(target, level, internalFormat, width, height, depth, 
 		border, format, type, data);
 
 	ErrorCheck ("glTexImage3D");
 }
 
+void GL::TexStorage3D(GLenum target, GLsizei levels, GLenum internalFormat, 
+	GLsizei width, GLsizei height, GLsizei depth)
+{
+	_backend->TexStorage3D(target, levels, internalFormat, width, height, depth);
+
+	ErrorCheck ("glTexStorage3D");
+}
+
+void GL::TexPageCommitment(GLenum target, GLint level, GLint xoffset, GLint yoffset, 
+	GLint zoffset, GLsizei width, GLsizei height, GLsizei depth, GLboolean commit)
+{
+	_backend->TexPageCommitment(target, level, xoffset, yoffset, zoffset, 
+		width, height, depth, commit);
+
+	ErrorCheck ("glTexPageCommitmentARB");
+}
+
+void GL::ClearTexSubImage(GLuint texture, GLint level, GLint xoffset, GLint yoffset, 
+	GLint zoffset, GLsizei width, GLsizei height, GLsizei depth, GLenum format, 
+	GLenum type, const void * data)
+{
+	_backend->ClearTexSubImage(texture, level, xoffset, yoffset, zoffset, 
+		width, height, depth, format, type, data);
+
+	ErrorCheck ("glClearTexSubImage");
+}
+
 void GL::TexEnvi(GLenum target,  GLenum pname,  GLint param)
 {
-	glTexEnvi (target, pname, param);
+	_backend->TexEnvi (target, pname, param);
 
 	ErrorCheck ("glTexEnvi");
 }
 
 void GL::TexEnvf(GLenum target,  GLenum pname,  GLfloat param)
 {
-	glTexEnvf (target, pname, param);
+	_backend->TexEnvf (target, pname, param);
 
 	ErrorCheck ("glTexEnvf");
 }
 
 void GL::TexParameteri(GLenum target,  GLenum pname,  GLint param)
 {
-	glTexParameteri(target, pname, param); 
+	_backend->TexParameteri(target, pname, param); 
 
 	ErrorCheck ("glTexParameteri");
 }
 
 void GL::TexParameterf(GLenum target,  GLenum pname,  GLfloat param)
 {
-	glTexParameterf (target, pname, param);
+	_backend->TexParameterf (target, pname, param);
 
 	ErrorCheck ("glTexParameterf");
 }
 
 void GL::TexParameteriv(GLenum target, GLenum pname, const GLint * params)
 {
-	glTexParameteriv(target, pname, params);
+	_backend->TexParameteriv(target, pname, params);
 
 	ErrorCheck("glTexParameteriv");
 }
 
 void GL::TexParameterfv(GLenum target, GLenum pname, const GLfloat * params)
 {
-	glTexParameterfv(target, pname, params);
+	_backend->TexParameterfv(target, pname, params);
 
 	ErrorCheck ("glTexParameterfv");
 }
 
 void GL::GenerateMipmap (GLenum target)
 {
-	glGenerateMipmap(target);
+	_backend->GenerateMipmap(target);
 
 	ErrorCheck ("glGenerateMipmap");
 }
 
+void GL::GetTexParameteriv(GLenum target, GLenum pname, GLint * params)
+{
+	_backend->GetTexParameteriv(target, pname, params);
+
+	ErrorCheck ("glGetTexParameteriv");
+}
+
+void GL::GetInternalformativ(GLenum target, GLenum internalFormat, GLenum pname, 
+	GLsizei bufSize, GLint * params)
+{
+	_backend->GetInternalformativ(target, internalFormat, pname, bufSize, params);
+
+	ErrorCheck ("glGetInternalformativ");
+}
+
 /*
  * Pixels
 */
 
 void GL::PixelStorei(GLenum pname, GLint param)
 {
-	glPixelStorei(pname, param);
+	_backend->PixelStorei(pname, param);
 
 	ErrorCheck ("glPixelStorei");
 }
@@ -787,7 +1096,7 @@ void GL::PixelStorei(GLenum pname, GLint param)
 
 void GL::BindImageTexture (GLuint unit, GLuint texture, GLint level, GLboolean layered, GLint layer, GLenum access, GLenum format)
 {
-	glBindImageTexture (unit, texture, level, layered, layer, access, format);
+	_backend->BindImageTexture (unit, texture, level, layered, layer, access, format);
 
 	ErrorCheck ("glBindImageTexture");
 }
@@ -798,7 +1107,7 @@ void GL::BindImageTexture (GLuint unit, GLuint texture, GLint level, GLboolean l
 
 GLuint GL::CreateShader (GLenum shaderType)
 {
-	GLuint shader = glCreateShader(shaderType);
+	GLuint shader = _backend->CreateShader(shaderType);
 
 	ErrorCheck ("glCreateShader");
 
@@ -807,35 +1116,35 @@ GLuint GL::CreateShader (GLenum shaderType)
 
 void GL::DeleteShader(GLuint shader)
 {
-	glDeleteShader (shader);
+	_backend->DeleteShader (shader);
 
 	ErrorCheck ("glDeleteShader");
 }
 
 void GL::ShaderSource (GLuint shader, GLsizei count, const GLchar **string, const GLint *length)
 {
-	glShaderSource(shader, count, string, length);	
+	_backend->ShaderSource(shader, count, string, length);	
 
 	ErrorCheck ("glShaderSource");
 }
 
 void GL::CompileShader(GLuint shader)
 {
-	glCompileShader (shader);
+	_backend->CompileShader (shader);
 
 	ErrorCheck ("glCompileShader");
 }
 
 void GL::GetShaderInfoLog(GLuint  shader,  GLsizei  maxLength,  GLsizei * length,  GLchar * infoLog)
 {
-	glGetShaderInfoLog(shader, maxLength, length, infoLog);
+	_backend->GetShaderInfoLog(shader, maxLength, length, infoLog);
 
 	ErrorCheck ("glGetShaderInfoLog");
 }
 
 GLuint GL::CreateProgram(void)
 {
-	GLuint program = glCreateProgram ();
+	GLuint program = _backend->CreateProgram ();
 
 	ErrorCheck ("glCreateProgram");
 
@@ -844,35 +1153,39 @@ GLuint GL::CreateProgram(void)
 
 void GL::DeleteProgram(GLuint program)
 {
-	glDeleteProgram (program);
+	_backend->DeleteProgram (program);
 
 	ErrorCheck ("glDeleteProgram");
 }
 
 void GL::UseProgram (GLuint program)
 {
-	glUseProgram (program);
+	if (!_stateCache.UseProgram (program)) {
+		return;
+	}
+
+	_backend->UseProgram (program);
 
 	ErrorCheck ("glUseProgram");
 }
 
 void GL::LinkProgram(GLuint program)
 {
-	glLinkProgram (program);
+	_backend->LinkProgram (program);
 
 	ErrorCheck ("glLinkProgram");
 }
 
 void GL::AttachShader(GLuint program, GLuint shader)
 {
-	glAttachShader(program, shader);
+	_backend->AttachShader(program, shader);
 
 	ErrorCheck ("glAttachShader");
 }
 
 void GL::DetachShader(GLuint program, GLuint shader)
 {
-	glDetachShader (program, shader);
+	_backend->DetachShader (program, shader);
 
 	ErrorCheck ("glDetachShader");
 }
@@ -880,16 +1193,32 @@ void GL::DetachShader(GLuint program, GLuint shader)
 
 GLint GL::GetUniformLocation(GLuint program, const GLchar *name)
 {
-	GLint uniformLocation = glGetUniformLocation(program, name);
+	GLint uniformLocation = _backend->GetUniformLocation(program, name);
 
 	ErrorCheck ("glGetUniformLocation");
 
 	return uniformLocation;
 }
 
+GLuint GL::GetUniformBlockIndex(GLuint program, const GLchar *uniformBlockName)
+{
+	GLuint uniformBlockIndex = _backend->GetUniformBlockIndex(program, uniformBlockName);
+
+	ErrorCheck ("glGetUniformBlockIndex");
+
+	return uniformBlockIndex;
+}
+
+void GL::UniformBlockBinding(GLuint program, GLuint uniformBlockIndex, GLuint uniformBlockBinding)
+{
+	_backend->UniformBlockBinding(program, uniformBlockIndex, uniformBlockBinding);
+
+	ErrorCheck ("glUniformBlockBinding");
+}
+
 void GL::DispatchCompute(GLuint num_groups_x, GLuint num_groups_y, GLuint num_groups_z)
 {
-	glDispatchCompute(num_groups_x, num_groups_y, num_groups_z);
+	_backend->DispatchCompute(num_groups_x, num_groups_y, num_groups_z);
 
 	ErrorCheck ("glDispatchCompute");
 }
@@ -900,28 +1229,36 @@ void GL::DispatchCompute(GLuint num_groups_x, GLuint num_groups_y, GLuint num_gr
 
 void GL::GetBooleanv(GLenum pname, GLboolean * params)
 {
-	glGetBooleanv (pname, params);
+	if (pname == GL_DEPTH_WRITEMASK && _stateCache.GetDepthMask (*params)) {
+		return;
+	}
+
+	_backend->GetBooleanv (pname, params);
 
 	ErrorCheck ("glGetBooleanv");
+
+	if (pname == GL_DEPTH_WRITEMASK) {
+		_stateCache.StoreDepthMask (*params);
+	}
 }
 
 void GL::GetFixedv(GLenum pname, GLfixed * params)
 {
-	glGetFixedv (pname, params);
+	_backend->GetFixedv (pname, params);
 
 	ErrorCheck ("glGetFixedv");
 }
 
 void GL::GetFloatv(GLenum pname, GLfloat * params)
 {
-	glGetFloatv (pname, params); 
+	_backend->GetFloatv (pname, params); 
 
 	ErrorCheck ("glGetFloatv");
 }
 
 void GL::GetIntegerv(GLenum pname, GLint * params)
 {
-	glGetIntegerv(pname, params);
+	_backend->GetIntegerv(pname, params);
 
 	ErrorCheck ("glGetIntegerv");
 }
@@ -932,28 +1269,36 @@ void GL::GetIntegerv(GLenum pname, GLint * params)
 
 void GL::DeleteVertexArrays(GLsizei n, const GLuint *arrays)
 {
-	glDeleteVertexArrays(n, arrays);
+	_backend->DeleteVertexArrays(n, arrays);
+
+	_stateCache.DeleteVertexArrays (n, arrays);
 
 	ErrorCheck ("glDeleteVertexArrays");
 }
 
 void GL::DeleteBuffers (GLsizei n, const GLuint* arrays)
 {
-	glDeleteBuffers (n, arrays);
+	_backend->DeleteBuffers (n, arrays);
+
+	_stateCache.DeleteNames (n, arrays);
 
 	ErrorCheck ("glDeleteBuffers");
 }
 
 void GL::DeleteFramebuffers(GLsizei n, const GLuint * framebuffers)
 {
-	glDeleteFramebuffers (n, framebuffers);
+	_backend->DeleteFramebuffers (n, framebuffers);
+
+	_stateCache.DeleteNames (n, framebuffers);
 
 	ErrorCheck ("glDeleteFramebuffers");
 }
 
 void GL::DeleteTextures(GLsizei n, const GLuint * textures)
 {
-	glDeleteTextures (n, textures);
+	_backend->DeleteTextures (n, textures);
+
+	_stateCache.DeleteNames (n, textures);
 
 	ErrorCheck ("glDeleteTextures");
 }
@@ -963,11 +1308,13 @@ void GL::Check ()
 	ErrorCheck ("Custom Query");
 }
 
-void GL::ErrorCheck (const std::string& methodName)
+#ifndef GL_ERROR_CHECK_DISABLE
+
+void GL::ErrorCheck (const char* methodName)
 {
 	GLenum error;
-	while ((error = glGetError()) != GL_NO_ERROR) {
-		std::string errorString = "On " + methodName + ": ";
+	while ((error = _backend->GetError ()) != GL_NO_ERROR) {
+		std::string errorString = std::string ("On ") + methodName + ": ";
 
 		switch (error) {
 			case GL_INVALID_ENUM:
@@ -995,4 +1342,6 @@ void GL::ErrorCheck (const std::string& methodName)
 
 		Console::LogError (errorString);
 	}
-}
\ No newline at end of file
+}
+
+#endif
\ No newline at end of file
@@ -4,11 +4,36 @@
 #include <GL/glew.h>
 #include <string>
 
-#define GL_DEPRECATED_PERMIT
+#include "GLBackend.h"
+#include "GLStateCache.h"
+
+/*
+ * Every OpenGL call of the engine. The calls go to the backend, which is
+ * the driver unless another one is set. Binds and state changes that set
+ * what is already set never reach the backend, the state cache filters
+ * them and answers the queries of the state it knows.
+ *
+ * Every call is followed by a glGetError check, unless
+ * GL_ERROR_CHECK_DISABLE is defined, as it is in release builds. The
+ * errors are then reported by the driver through KHR_debug.
+*/
 
 class GL
 {
+private:
+	static GLBackend* _backend;
+	static GLStateCache _stateCache;
+
 public:
+	static void SetBackend (GLBackend* backend);
+	static GLBackend* GetBackend ();
+
+	static void EndFrame ();
+
+	static void SetStateCaching (bool isEnabled);
+	static const GLStateCacheStatistics& GetStateCacheStatistics ();
+
+	static void InitDebugOutput ();
 	
 #ifdef GL_DEPRECATED_PERMIT
 	
@@ -63,10 +88,35 @@ public:
 	static void DrawArrays(GLenum mode, GLint first, GLsizei count);
 	static void DrawElements (GLenum mode, GLsizei count, GLenum type, const void* indices);
 	static void DrawElementsInstanced (GLenum mode, GLsizei count, GLenum type, const void* indices, GLsizei primcount);
+	static void DrawElementsInstancedBaseInstance (GLenum mode, GLsizei count, GLenum type, const void* indices,
+		GLsizei primcount, GLuint baseinstance);
+	static void DrawElementsBaseVertex (GLenum mode, GLsizei count, GLenum type, const void* indices, GLint basevertex);
+	static void MultiDrawElementsIndirect (GLenum mode, GLenum type, const void* indirect, GLsizei drawcount, GLsizei stride);
 
 	// Buffers
 	static void BufferData (GLenum target, GLsizeiptr size, const GLvoid * data, GLenum usage);
 	static void BufferSubData (GLenum target, GLintptr offset, GLsizeiptr size, const GLvoid *data);
+	static void* MapBufferRange (GLenum target, GLintptr offset, GLsizeiptr length, GLbitfield access);
+	static GLboolean UnmapBuffer (GLenum target);
+	static void BufferStorage (GLenum target, GLsizeiptr size, const GLvoid* data, GLbitfield flags);
+
+	/*
+	 * Synchronization
+	*/
+
+	static GLsync FenceSync (GLenum condition, GLbitfield flags);
+	static GLenum ClientWaitSync (GLsync sync, GLbitfield flags, GLuint64 timeout);
+	static void DeleteSync (GLsync sync);
+
+	/*
+	 * Queries
+	*/
+
+	static void GenQueries (GLsizei n, GLuint* ids);
+	static void DeleteQueries (GLsizei n, const GLuint* ids);
+	static void QueryCounter (GLuint id, GLenum target);
+	static void GetQueryObjectiv (GLuint id, GLenum pname, GLint* params);
+	static void GetQueryObjectui64v (GLuint id, GLenum pname, GLuint64* params);
 
 	/*
 	 * Vertex Attributes
@@ -88,6 +138,8 @@ public:
 	// Bind
 	static void BindVertexArray (GLuint array);
 	static void BindBuffer (GLenum target, GLuint buffer);
+	static void BindBufferBase (GLenum target, GLuint index, GLuint buffer);
+	static void BindBufferRange (GLenum target, GLuint index, GLuint buffer, GLintptr offset, GLsizeiptr size);
 
 	/*
 	 * Depth Buffer
@@ -126,6 +178,12 @@ public:
 		GLsizei height,  GLint border,  GLenum format,  GLenum type,  const GLvoid * data); 
 	static void TexImage3D(GLenum target, GLint level, GLint internalFormat, GLsizei width, GLsizei height, 
 		GLsizei depth, GLint border, GLenum format, GLenum type, const GLvoid * data);
+	static void TexStorage3D(GLenum target, GLsizei levels, GLenum internalFormat, GLsizei width, 
+		GLsizei height, GLsizei depth);
+	static void TexPageCommitment(GLenum target, GLint level, GLint xoffset, GLint yoffset, GLint zoffset, 
+		GLsizei width, GLsizei height, GLsizei depth, GLboolean commit);
+	static void ClearTexSubImage(GLuint texture, GLint level, GLint xoffset, GLint yoffset, GLint zoffset, 
+		GLsizei width, GLsizei height, GLsizei depth, GLenum format, GLenum type, const void * data);
 
 	static void TexEnvi(GLenum target,  GLenum pname,  GLint param);
 	static void TexEnvf(GLenum target,  GLenum pname,  GLfloat param);
@@ -134,6 +192,8 @@ public:
 	static void TexParameteriv(GLenum target, GLenum pname, const GLint * params);
 	static void TexParameterfv(GLenum target, GLenum pname, const GLfloat * params);
 	static void GenerateMipmap(GLenum target);
+	static void GetTexParameteriv(GLenum target, GLenum pname, GLint * params);
+	static void GetInternalformativ(GLenum target, GLenum internalFormat, GLenum pname, GLsizei bufSize, GLint * params);
 
 	/*
 	 * Pixels
@@ -165,6 +225,8 @@ public:
 	static void AttachShader(GLuint program, GLuint shader);
 	static void DetachShader(GLuint program, GLuint shader);
 	static GLint GetUniformLocation(GLuint program, const GLchar *name);
+	static GLuint GetUniformBlockIndex(GLuint program, const GLchar *uniformBlockName);
+	static void UniformBlockBinding(GLuint program, GLuint uniformBlockIndex, GLuint uniformBlockBinding);
 
 	static void DispatchCompute(GLuint num_groups_x,GLuint num_groups_y,GLuint num_groups_z);
 
@@ -212,6 +274,12 @@ public:
 
 	static void MemoryBarrier(GLbitfield barriers);
 
+	/*
+	 * Debug
+	*/
+
+	static void DebugMessageCallback (GLDEBUGPROC callback, const void* userParam);
+
 	/*
 	 * Capabilities
 	*/
@@ -241,8 +309,11 @@ public:
 	static void Check ();
 
 private:
-	// Maybe use this only on development mode?
-	static void ErrorCheck (const std::string& methodName);
+#ifdef GL_ERROR_CHECK_DISABLE
+	static void ErrorCheck (const char* methodName) {}
+#else
+	static void ErrorCheck (const char* methodName);
+#endif
 };
 
 #endif
\ No newline at end of file
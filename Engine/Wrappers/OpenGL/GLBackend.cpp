@@ -0,0 +1,6 @@
+#include "GLBackend.h"
+
+GLBackend::~GLBackend ()
+{
+
+}
\ No newline at end of file
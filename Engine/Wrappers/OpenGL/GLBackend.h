@@ -0,0 +1,307 @@
+#ifndef GLBACKEND_H
+#define GLBACKEND_H
+
+#include <GL/glew.h>
+
+#define GL_DEPRECATED_PERMIT
+
+/*
+ * What the GL wrapper sends its calls to. The driver backend calls
+ * OpenGL, a backend that does not can stand in for it where there is no
+ * context, every call of the engine goes through the wrapper. The names
+ * are the ones of the wrapper, IsEnabled returns the flag.
+ *
+ * EndFrame is called once the frame is submitted.
+*/
+
+class GLBackend
+{
+public:
+	virtual ~GLBackend ();
+
+	
+#ifdef GL_DEPRECATED_PERMIT
+	
+	/*
+	 * Not intended to be used
+	*/
+
+	virtual void Begin(GLenum  mode) = 0;
+	virtual void End() = 0;
+
+#endif
+
+	/*
+	 * Viewport
+	*/
+
+	virtual void Viewport(GLint x,  GLint y,  GLsizei width,  GLsizei height) = 0;
+
+	/*
+	 * Frame Buffer
+	*/
+
+	virtual void Clear(GLbitfield  mask) = 0;
+	virtual void ClearColor(GLclampf red,  GLclampf green,  GLclampf blue,  GLclampf alpha) = 0;
+	virtual void ColorMask(GLboolean red,  GLboolean green,  GLboolean blue,  GLboolean alpha) = 0;
+	virtual void FramebufferTexture (GLenum target, GLenum attachment, GLuint texture, GLint level) = 0;
+	virtual void FramebufferTexture2D(GLenum target,  GLenum attachment,  GLenum textarget,  GLuint texture,  GLint level) = 0;
+	virtual void DrawBuffer(GLenum buf) = 0;
+	virtual void DrawBuffers(GLsizei n, const GLenum *bufs) = 0;
+	virtual void ReadBuffer(GLenum mode) = 0;
+	virtual void BindFramebuffer(GLenum target,  GLuint framebuffer) = 0;
+	virtual void BlitFramebuffer(GLint srcX0, GLint srcY0, GLint srcX1, GLint srcY1, GLint dstX0, 
+		GLint dstY0, GLint dstX1, GLint dstY1, GLbitfield mask, GLenum filter) = 0;
+	virtual GLenum CheckFramebufferStatus(GLenum target) = 0;
+
+	/*
+	 * Culling
+	*/
+
+	virtual void CullFace(GLenum mode) = 0;
+
+	/*
+	 * Behaviour 
+	*/
+
+	virtual void Hint(GLenum target,  GLenum mode) = 0;
+
+	/*
+	 * Draw Calls
+	*/
+
+	virtual void DrawArrays(GLenum mode, GLint first, GLsizei count) = 0;
+	virtual void DrawElements (GLenum mode, GLsizei count, GLenum type, const void* indices) = 0;
+	virtual void DrawElementsInstanced (GLenum mode, GLsizei count, GLenum type, const void* indices, GLsizei primcount) = 0;
+	virtual void DrawElementsInstancedBaseInstance (GLenum mode, GLsizei count, GLenum type, const void* indices,
+		GLsizei primcount, GLuint baseinstance) = 0;
+	virtual void DrawElementsBaseVertex (GLenum mode, GLsizei count, GLenum type, const void* indices, GLint basevertex) = 0;
+	virtual void MultiDrawElementsIndirect (GLenum mode, GLenum type, const void* indirect, GLsizei drawcount, GLsizei stride) = 0;
+
+	// Buffers
+	virtual void BufferData (GLenum target, GLsizeiptr size, const GLvoid * data, GLenum usage) = 0;
+	virtual void BufferSubData (GLenum target, GLintptr offset, GLsizeiptr size, const GLvoid *data) = 0;
+	virtual void* MapBufferRange (GLenum target, GLintptr offset, GLsizeiptr length, GLbitfield access) = 0;
+	virtual GLboolean UnmapBuffer (GLenum target) = 0;
+	virtual void BufferStorage (GLenum target, GLsizeiptr size, const GLvoid* data, GLbitfield flags) = 0;
+
+	/*
+	 * Synchronization
+	*/
+
+	virtual GLsync FenceSync (GLenum condition, GLbitfield flags) = 0;
+	virtual GLenum ClientWaitSync (GLsync sync, GLbitfield flags, GLuint64 timeout) = 0;
+	virtual void DeleteSync (GLsync sync) = 0;
+
+	/*
+	 * Queries
+	*/
+
+	virtual void GenQueries (GLsizei n, GLuint* ids) = 0;
+	virtual void DeleteQueries (GLsizei n, const GLuint* ids) = 0;
+	virtual void QueryCounter (GLuint id, GLenum target) = 0;
+	virtual void GetQueryObjectiv (GLuint id, GLenum pname, GLint* params) = 0;
+	virtual void GetQueryObjectui64v (GLuint id, GLenum pname, GLuint64* params) = 0;
+
+	/*
+	 * Vertex Attributes
+	*/
+
+	virtual void EnableVertexAttribArray (GLuint index) = 0;
+	virtual void VertexAttribPointer (GLuint index, GLint size, GLenum type, GLboolean normalized, GLsizei stride, const GLvoid * pointer) = 0;
+	virtual void VertexAttribIPointer (GLuint index, GLint size, GLenum type, GLsizei stride, const GLvoid * pointer) = 0;	
+	virtual void VertexAttribDivisor (GLuint index, GLuint divisor) = 0;
+	virtual void VertexAttrib1f(GLuint index,  GLfloat v0) = 0;
+	virtual void VertexAttrib2f(GLuint index,  GLfloat v0,  GLfloat v1) = 0;
+	virtual void VertexAttrib3f(GLuint index,  GLfloat v0,  GLfloat v1,  GLfloat v2) = 0;
+	virtual void VertexAttrib4f(GLuint index,  GLfloat v0,  GLfloat v1,  GLfloat v2,  GLfloat v3) = 0;
+	virtual void VertexAttrib1fv(GLuint index,  const GLfloat *v) = 0;
+	virtual void VertexAttrib2fv(GLuint index,  const GLfloat *v) = 0;
+	virtual void VertexAttrib3fv(GLuint index,  const GLfloat *v) = 0;
+	virtual void VertexAttrib4fv(GLuint index,  const GLfloat *v) = 0;
+
+	// Bind
+	virtual void BindVertexArray (GLuint array) = 0;
+	virtual void BindBuffer (GLenum target, GLuint buffer) = 0;
+	virtual void BindBufferBase (GLenum target, GLuint index, GLuint buffer) = 0;
+	virtual void BindBufferRange (GLenum target, GLuint index, GLuint buffer, GLintptr offset, GLsizeiptr size) = 0;
+
+	/*
+	 * Depth Buffer
+	*/
+
+	virtual void DepthMask (GLboolean flag) = 0;
+	virtual void DepthRange(GLclampd nearVal, GLclampd farVal) = 0;
+	virtual void ClearDepth(GLclampd  depth) = 0;
+	virtual void DepthFunc(GLenum func) = 0;
+
+	/*
+	 * Stencil Buffer
+	*/
+
+	virtual void StencilFunc(GLenum func, GLint ref, GLuint mask) = 0;
+	virtual void StencilOp(GLenum sfail, GLenum dpfail, GLenum dppass) = 0;
+	virtual void StencilOpSeparate(GLenum face, GLenum sfail, GLenum dpfail, GLenum dppass) = 0;
+	virtual void StencilMask(GLuint mask) = 0;
+
+	// Blend
+	virtual void BlendFunc (GLenum sfactor, GLenum dfactor) = 0;
+	virtual void BlendFunci (GLuint buf, GLenum sfactor, GLenum dfactor) = 0;
+	virtual void BlendEquation (GLenum mode) = 0;
+
+	// Generators
+	virtual void GenVertexArrays (GLsizei n, GLuint * arrays) = 0;
+	virtual void GenBuffers(GLsizei n,  GLuint * buffers) = 0;
+	virtual void GenTextures(GLsizei n,  GLuint * textures) = 0;
+	virtual void GenFramebuffers(GLsizei n,  GLuint * framebuffers) = 0;
+
+	// Textures
+	virtual void BindTexture(GLenum target, GLuint texture) = 0;
+	virtual void ActiveTexture(GLenum texture) = 0;
+
+	virtual void TexImage2D(GLenum target,  GLint level,  GLint internalformat,  GLsizei width,  
+		GLsizei height,  GLint border,  GLenum format,  GLenum type,  const GLvoid * data) = 0;
+	virtual void TexImage3D(GLenum target, GLint level, GLint internalFormat, GLsizei width, GLsizei height, 
+		GLsizei depth, GLint border, GLenum format, GLenum type, const GLvoid * data) = 0;
+	virtual void TexStorage3D(GLenum target, GLsizei levels, GLenum internalFormat, GLsizei width, 
+		GLsizei height, GLsizei depth) = 0;
+	virtual void TexPageCommitment(GLenum target, GLint level, GLint xoffset, GLint yoffset, GLint zoffset, 
+		GLsizei width, GLsizei height, GLsizei depth, GLboolean commit) = 0;
+	virtual void ClearTexSubImage(GLuint texture, GLint level, GLint xoffset, GLint yoffset, GLint zoffset, 
+		GLsizei width, GLsizei height, GLsizei depth, GLenum format, GLenum type, const void * data) = 0;
+
+	virtual void TexEnvi(GLenum target,  GLenum pname,  GLint param) = 0;
+	virtual void TexEnvf(GLenum target,  GLenum pname,  GLfloat param) = 0;
+	virtual void TexParameteri(GLenum target,  GLenum pname,  GLint param) = 0;
+	virtual void TexParameterf(GLenum target,  GLenum pname,  GLfloat param) = 0;
+	virtual void TexParameteriv(GLenum target, GLenum pname, const GLint * params) = 0;
+	virtual void TexParameterfv(GLenum target, GLenum pname, const GLfloat * params) = 0;
+	virtual void GenerateMipmap(GLenum target) = 0;
+	virtual void GetTexParameteriv(GLenum target, GLenum pname, GLint * params) = 0;
+	virtual void GetInternalformativ(GLenum target, GLenum internalFormat, GLenum pname, GLsizei bufSize, GLint * params) = 0;
+
+	/*
+	 * Pixels
+	*/
+
+	virtual void PixelStorei(GLenum pname, GLint param) = 0;
+
+	/*
+	 * Image Textures
+	*/
+
+	virtual void BindImageTexture (GLuint unit, GLuint texture, GLint level, GLboolean layered, GLint layer, GLenum access, GLenum format) = 0;
+
+	/*
+	 * Shaders
+	*/
+
+	virtual GLuint CreateShader(GLenum shaderType) = 0;
+	virtual void DeleteShader(GLuint shader) = 0;
+	virtual void ShaderSource(GLuint shader, GLsizei count, const GLchar **string, const GLint *length) = 0;	
+	virtual void CompileShader(GLuint shader) = 0;
+	virtual void GetShaderInfoLog(GLuint  shader,  GLsizei  maxLength,  GLsizei * length,  GLchar * infoLog) = 0;
+
+	virtual GLuint CreateProgram(void) = 0;
+	virtual void DeleteProgram(GLuint program) = 0;
+	virtual void UseProgram (GLuint program) = 0;
+	virtual void LinkProgram(GLuint program) = 0;
+
+	virtual void AttachShader(GLuint program, GLuint shader) = 0;
+	virtual void DetachShader(GLuint program, GLuint shader) = 0;
+	virtual GLint GetUniformLocation(GLuint program, const GLchar *name) = 0;
+	virtual GLuint GetUniformBlockIndex(GLuint program, const GLchar *uniformBlockName) = 0;
+	virtual void UniformBlockBinding(GLuint program, GLuint uniformBlockIndex, GLuint uniformBlockBinding) = 0;
+
+	virtual void DispatchCompute(GLuint num_groups_x,GLuint num_groups_y,GLuint num_groups_z) = 0;
+
+	/*
+	 * Uniforms
+	*/
+
+	virtual void Uniform1f(GLint location,  GLfloat v0) = 0;
+	virtual void Uniform2f(GLint location,  GLfloat v0,  GLfloat v1) = 0;
+	virtual void Uniform3f(GLint location,  GLfloat v0,  GLfloat v1,  GLfloat v2) = 0;
+	virtual void Uniform4f(GLint location,  GLfloat v0,  GLfloat v1,  GLfloat v2,  GLfloat v3) = 0;
+	virtual void Uniform1i(GLint location,  GLint v0) = 0;
+	virtual void Uniform2i(GLint location,  GLint v0,  GLint v1) = 0;
+	virtual void Uniform3i(GLint location,  GLint v0,  GLint v1,  GLint v2) = 0;
+	virtual void Uniform4i(GLint location,  GLint v0,  GLint v1,  GLint v2,  GLint v3) = 0;
+	virtual void Uniform1ui(GLint location, GLuint v0) = 0;
+	virtual void Uniform2ui(GLint location, GLuint v0, GLuint v1) = 0;
+	virtual void Uniform3ui(GLint location, GLuint v0, GLuint v1, GLuint v2) = 0;
+	virtual void Uniform4ui(GLint location, GLuint v0, GLuint v1, GLuint v2, GLuint v3) = 0;
+	virtual void Uniform1fv(GLint location, GLsizei count, const GLfloat *value) = 0;
+	virtual void Uniform2fv(GLint location, GLsizei count, const GLfloat *value) = 0;
+	virtual void Uniform3fv(GLint location, GLsizei count, const GLfloat *value) = 0;
+	virtual void Uniform4fv(GLint location, GLsizei count, const GLfloat *value) = 0;
+	virtual void Uniform1iv(GLint location, GLsizei count, const GLint *value) = 0;
+	virtual void Uniform2iv(GLint location, GLsizei count, const GLint *value) = 0;
+	virtual void Uniform3iv(GLint location, GLsizei count, const GLint *value) = 0;
+	virtual void Uniform4iv(GLint location, GLsizei count, const GLint *value) = 0;
+	virtual void Uniform1uiv(GLint location, GLsizei count, const GLuint *value) = 0;
+	virtual void Uniform2uiv(GLint location, GLsizei count, const GLuint *value) = 0;
+	virtual void Uniform3uiv(GLint location, GLsizei count, const GLuint *value) = 0;
+	virtual void Uniform4uiv(GLint location, GLsizei count, const GLuint *value) = 0;
+	virtual void UniformMatrix2fv(GLint location, GLsizei count, GLboolean transpose, const GLfloat *value) = 0;
+	virtual void UniformMatrix3fv(GLint location, GLsizei count, GLboolean transpose, const GLfloat *value) = 0;
+	virtual void UniformMatrix4fv(GLint location, GLsizei count, GLboolean transpose, const GLfloat *value) = 0;
+	virtual void UniformMatrix2x3fv(GLint location, GLsizei count, GLboolean transpose, const GLfloat *value) = 0;
+	virtual void UniformMatrix3x2fv(GLint location, GLsizei count, GLboolean transpose, const GLfloat *value) = 0;
+	virtual void UniformMatrix2x4fv(GLint location, GLsizei count, GLboolean transpose, const GLfloat *value) = 0;
+	virtual void UniformMatrix4x2fv(GLint location, GLsizei count, GLboolean transpose, const GLfloat *value) = 0;
+	virtual void UniformMatrix3x4fv(GLint location, GLsizei count, GLboolean transpose, const GLfloat *value) = 0;
+	virtual void UniformMatrix4x3fv(GLint location, GLsizei count, GLboolean transpose, const GLfloat *value) = 0;
+
+	/*
+	 * Memory
+	*/
+
+	virtual void MemoryBarrier(GLbitfield barriers) = 0;
+
+	/*
+	 * Debug
+	*/
+
+	virtual void DebugMessageCallback (GLDEBUGPROC callback, const void* userParam) = 0;
+
+	/*
+	 * Capabilities
+	*/
+
+	virtual void Enable (GLenum cap) = 0;
+	virtual void Disable (GLenum cap) = 0;
+	virtual GLboolean IsEnabled(GLenum cap) = 0;
+
+	/*
+	 * Getters
+	*/
+
+	virtual void GetBooleanv(GLenum pname, GLboolean * params) = 0;
+	virtual void GetFixedv(GLenum pname, GLfixed * params) = 0;
+	virtual void GetFloatv(GLenum pname, GLfloat * params) = 0;
+	virtual void GetIntegerv(GLenum pname, GLint * params) = 0;
+
+	/*
+	 * Cleaning 
+	*/
+
+	virtual void DeleteVertexArrays (GLsizei n, const GLuint *arrays) = 0;
+	virtual void DeleteBuffers(GLsizei n, const GLuint * buffers) = 0;
+	virtual void DeleteFramebuffers(GLsizei n, const GLuint * framebuffers) = 0;
+	virtual void DeleteTextures(GLsizei n, const GLuint * textures) = 0;
+
+	/*
+	 * Errors
+	*/
+
+	virtual GLenum GetError () = 0;
+
+	/*
+	 * Frames
+	*/
+
+	virtual void EndFrame () = 0;
+};
+
+#endif
\ No newline at end of file
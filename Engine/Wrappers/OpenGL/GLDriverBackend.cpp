@@ -0,0 +1,759 @@
+#include "GLDriverBackend.h"
+
+#ifdef GL_DEPRECATED_PERMIT
+
+/*
+ * Not intended to be used
+*/
+
+void GLDriverBackend::Begin(GLenum  mode)
+{
+	glBegin (mode);
+}
+
+void GLDriverBackend::End()
+{
+	glEnd();
+}
+
+#endif
+
+void GLDriverBackend::Viewport(GLint x,  GLint y,  GLsizei width,  GLsizei height)
+{
+	glViewport(x, y, width, height);
+}
+
+void GLDriverBackend::Clear(GLbitfield  mask)
+{
+	glClear (mask);
+}
+
+void GLDriverBackend::ClearColor(GLclampf red,  GLclampf green,  GLclampf blue,  GLclampf alpha)
+{
+	glClearColor(red, green, blue, alpha);
+}
+
+void GLDriverBackend::ColorMask(GLboolean red,  GLboolean green,  GLboolean blue,  GLboolean alpha)
+{
+	glColorMask (red, green, blue, alpha);
+}
+
+void GLDriverBackend::FramebufferTexture (GLenum target, GLenum attachment, GLuint texture, GLint level)
+{
+	glFramebufferTexture (target, attachment, texture, level);
+}
+
+void GLDriverBackend::FramebufferTexture2D(GLenum target,  GLenum attachment,  GLenum textarget,  GLuint texture,  GLint level)
+{
+	glFramebufferTexture2D (target, attachment, textarget, texture, level);
+}
+
+void GLDriverBackend::DrawBuffer(GLenum buf)
+{
+	glDrawBuffer (buf);
+}
+
+void GLDriverBackend::DrawBuffers(GLsizei n, const GLenum *bufs)
+{
+	glDrawBuffers (n, bufs);
+}
+
+void GLDriverBackend::ReadBuffer(GLenum mode)
+{
+	glReadBuffer (mode);
+}
+
+void GLDriverBackend::BindFramebuffer(GLenum target,  GLuint framebuffer)
+{
+	glBindFramebuffer (target, framebuffer);
+}
+
+void GLDriverBackend::BlitFramebuffer(GLint srcX0, GLint srcY0, GLint srcX1, GLint srcY1, 
+	GLint dstX0, GLint dstY0, GLint dstX1, GLint dstY1, GLbitfield mask, GLenum filter)
+{
+	glBlitFramebuffer (srcX0, srcY0, srcX1, srcY1, dstX0, dstY0, dstX1, dstY1, mask, filter);
+}
+
+GLenum GLDriverBackend::CheckFramebufferStatus(GLenum target)
+{
+	return glCheckFramebufferStatus (target);
+}
+
+void GLDriverBackend::Hint(GLenum target,  GLenum mode)
+{
+	glHint (target, mode);
+}
+
+void GLDriverBackend::CullFace(GLenum mode)
+{
+	glCullFace (mode);
+}
+
+void GLDriverBackend::DrawArrays (GLenum mode, GLint first, GLsizei count)
+{
+	glDrawArrays (mode, first, count);
+}
+
+void GLDriverBackend::DrawElements (GLenum mode, GLsizei count, GLenum type, const void* indices)
+{
+	glDrawElements (mode, count, type, indices);
+}
+
+void GLDriverBackend::DrawElementsInstanced (GLenum mode, GLsizei count, GLenum type, const void* indices, GLsizei primcount)
+{
+	glDrawElementsInstanced (mode, count, type, indices, primcount);
+}
+
+void GLDriverBackend::DrawElementsInstancedBaseInstance (GLenum mode, GLsizei count, GLenum type, const void* indices,
+	GLsizei primcount, GLuint baseinstance)
+{
+	glDrawElementsInstancedBaseInstance (mode, count, type, indices, primcount, baseinstance);
+}
+
+void GLDriverBackend::DrawElementsBaseVertex (GLenum mode, GLsizei count, GLenum type, const void* indices, GLint basevertex)
+{
+	glDrawElementsBaseVertex (mode, count, type, (void*) indices, basevertex);
+}
+
+void GLDriverBackend::MultiDrawElementsIndirect (GLenum mode, GLenum type, const void* indirect, GLsizei drawcount, GLsizei stride)
+{
+	glMultiDrawElementsIndirect (mode, type, indirect, drawcount, stride);
+}
+
+void GLDriverBackend::BufferData (GLenum target, GLsizeiptr size, const GLvoid * data, GLenum usage)
+{
+	glBufferData (target, size, data, usage);
+}
+
+void GLDriverBackend::BufferSubData (GLenum target, GLintptr offset, GLsizeiptr size, const GLvoid * data)
+{
+	glBufferSubData (target, offset, size, data);
+}
+
+void* GLDriverBackend::MapBufferRange (GLenum target, GLintptr offset, GLsizeiptr length, GLbitfield access)
+{
+	return glMapBufferRange (target, offset, length, access);
+}
+
+GLboolean GLDriverBackend::UnmapBuffer (GLenum target)
+{
+	return glUnmapBuffer (target);
+}
+
+void GLDriverBackend::BufferStorage (GLenum target, GLsizeiptr size, const GLvoid* data, GLbitfield flags)
+{
+	glBufferStorage (target, size, data, flags);
+}
+
+GLsync GLDriverBackend::FenceSync (GLenum condition, GLbitfield flags)
+{
+	return glFenceSync (condition, flags);
+}
+
+GLenum GLDriverBackend::ClientWaitSync (GLsync sync, GLbitfield flags, GLuint64 timeout)
+{
+	return glClientWaitSync (sync, flags, timeout);
+}
+
+void GLDriverBackend::DeleteSync (GLsync sync)
+{
+	glDeleteSync (sync);
+}
+
+void GLDriverBackend::GenQueries (GLsizei n, GLuint* ids)
+{
+	glGenQueries (n, ids);
+}
+
+void GLDriverBackend::DeleteQueries (GLsizei n, const GLuint* ids)
+{
+	glDeleteQueries (n, ids);
+}
+
+void GLDriverBackend::QueryCounter (GLuint id, GLenum target)
+{
+	glQueryCounter (id, target);
+}
+
+void GLDriverBackend::GetQueryObjectiv (GLuint id, GLenum pname, GLint* params)
+{
+	glGetQueryObjectiv (id, pname, params);
+}
+
+void GLDriverBackend::GetQueryObjectui64v (GLuint id, GLenum pname, GLuint64* params)
+{
+	glGetQueryObjectui64v (id, pname, params);
+}
+
+void GLDriverBackend::EnableVertexAttribArray (GLuint index)
+{
+	glEnableVertexAttribArray (index);
+}
+
+void GLDriverBackend::VertexAttribPointer (GLuint index, GLint size, GLenum type, GLboolean normalized, GLsizei stride, const GLvoid * pointer)
+{
+	glVertexAttribPointer (index, size, type, normalized, stride, pointer);
+}
+
+void GLDriverBackend::VertexAttribIPointer (GLuint index, GLint size, GLenum type, GLsizei stride, const GLvoid * pointer)
+{
+	glVertexAttribIPointer (index, size, type, stride, pointer);
+}
+
+void GLDriverBackend::VertexAttribDivisor(GLuint index, GLuint divisor)
+{
+	glVertexAttribDivisor (index, divisor);
+}
+
+void GLDriverBackend::VertexAttrib1f(GLuint index,  GLfloat v0)
+{
+	glVertexAttrib1f(index, v0);
+}
+
+void GLDriverBackend::VertexAttrib2f(GLuint index,  GLfloat v0,  GLfloat v1)
+{
+	glVertexAttrib2f (index, v0, v1);
+}
+
+void GLDriverBackend::VertexAttrib3f(GLuint index,  GLfloat v0,  GLfloat v1,  GLfloat v2)
+{
+	glVertexAttrib3f (index, v0, v1, v2);
+}
+
+void GLDriverBackend::VertexAttrib4f(GLuint index,  GLfloat v0,  GLfloat v1,  GLfloat v2,  GLfloat v3)
+{
+	glVertexAttrib4f (index, v0, v1, v2, v3);
+}
+
+void GLDriverBackend::VertexAttrib1fv(GLuint index,  const GLfloat *v)
+{
+	glVertexAttrib1fv (index, v);
+}
+
+void GLDriverBackend::VertexAttrib2fv(GLuint index,  const GLfloat *v)
+{
+	glVertexAttrib2fv (index, v);
+}
+
+void GLDriverBackend::VertexAttrib3fv(GLuint index,  const GLfloat *v)
+{
+	glVertexAttrib3fv (index, v);
+}
+
+void GLDriverBackend::VertexAttrib4fv(GLuint index,  const GLfloat *v)
+{
+	glVertexAttrib4fv (index, v);
+}
+
+void GLDriverBackend::BindVertexArray (GLuint array)
+{
+	glBindVertexArray (array);
+}
+
+void GLDriverBackend::BindBuffer(GLenum target, GLuint buffer)
+{
+	glBindBuffer(target, buffer);
+}
+
+void GLDriverBackend::BindBufferBase(GLenum target, GLuint index, GLuint buffer)
+{
+	glBindBufferBase(target, index, buffer);
+}
+
+void GLDriverBackend::BindBufferRange(GLenum target, GLuint index, GLuint buffer, GLintptr offset, GLsizeiptr size)
+{
+	glBindBufferRange(target, index, buffer, offset, size);
+}
+
+void GLDriverBackend::DepthMask (GLboolean flag)
+{
+	glDepthMask (flag);
+}
+
+void GLDriverBackend::DepthRange(GLclampd nearVal, GLclampd farVal)
+{
+	glDepthRange (nearVal, farVal);
+}
+
+void GLDriverBackend::ClearDepth(GLclampd  depth)
+{
+	glClearDepth (depth);
+}
+
+void GLDriverBackend::DepthFunc(GLenum func)
+{
+	glDepthFunc(func);
+}
+
+void GLDriverBackend::StencilFunc(GLenum func, GLint ref, GLuint mask)
+{
+	glStencilFunc (func, ref, mask);
+}
+
+void GLDriverBackend::StencilOp(GLenum sfail, GLenum dpfail, GLenum dppass)
+{
+	glStencilOp (sfail, dpfail, dppass);
+}
+
+void GLDriverBackend::StencilOpSeparate(GLenum face, GLenum sfail, GLenum dpfail, GLenum dppass)
+{
+	glStencilOpSeparate(face, sfail, dpfail, dppass);
+}
+
+void GLDriverBackend::StencilMask(GLuint mask)
+{
+	glStencilMask (mask);
+}
+
+void GLDriverBackend::BlendFunc (GLenum sfactor, GLenum dfactor)
+{
+	glBlendFunc (sfactor, dfactor);
+}
+
+void GLDriverBackend::BlendFunci (GLuint buf, GLenum sfactor, GLenum dfactor)
+{
+	glBlendFunci (buf, sfactor, dfactor);
+}
+
+void GLDriverBackend::BlendEquation (GLenum mode)
+{
+	glBlendEquation (mode);
+}
+
+void GLDriverBackend::GenVertexArrays (GLsizei n, GLuint * arrays)
+{
+	glGenVertexArrays (n, arrays);
+}
+
+void GLDriverBackend::GenBuffers(GLsizei n,  GLuint * buffers)
+{
+	glGenBuffers (n, buffers);
+}
+
+void GLDriverBackend::GenTextures(GLsizei n,  GLuint * textures)
+{
+	glGenTextures (n, textures);
+}
+
+void GLDriverBackend::GenFramebuffers(GLsizei n,  GLuint * framebuffers)
+{
+	glGenFramebuffers (n, framebuffers);
+}
+
+void GLDriverBackend::Uniform1f(GLint location,  GLfloat v0)
+{
+	glUniform1f(location, v0);
+}
+
+void GLDriverBackend::Uniform2f(GLint location,  GLfloat v0,  GLfloat v1)
+{
+	glUniform2f(location, v0, v1);
+}
+
+void GLDriverBackend::Uniform3f(GLint location,  GLfloat v0,  GLfloat v1,  GLfloat v2)
+{
+	glUniform3f(location, v0, v1, v2);
+}
+
+void GLDriverBackend::Uniform4f(GLint location,  GLfloat v0,  GLfloat v1,  GLfloat v2,  GLfloat v3)
+{
+	glUniform4f (location, v0, v1, v2, v3);
+}
+
+void GLDriverBackend::Uniform1i(GLint location,  GLint v0)
+{
+	glUniform1i (location, v0);
+}
+
+void GLDriverBackend::Uniform2i(GLint location,  GLint v0,  GLint v1)
+{
+	glUniform2i(location, v0, v1);
+}
+
+void GLDriverBackend::Uniform3i(GLint location,  GLint v0,  GLint v1,  GLint v2)
+{
+	glUniform3i(location, v0, v1, v2);
+}
+
+void GLDriverBackend::Uniform4i(GLint location,  GLint v0,  GLint v1,  GLint v2,  GLint v3)
+{
+	glUniform4i(location, v0, v1, v2, v3);
+}
+
+void GLDriverBackend::Uniform1ui(GLint location, GLuint v0)
+{
+	glUniform1ui(location, v0);
+}
+
+void GLDriverBackend::Uniform2ui(GLint location, GLuint v0, GLuint v1)
+{
+	glUniform2ui(location, v0, v1);
+}
+
+void GLDriverBackend::Uniform3ui(GLint location, GLuint v0, GLuint v1, GLuint v2)
+{
+	glUniform3ui(location, v0, v1, v2);
+}
+
+void GLDriverBackend::Uniform4ui(GLint location, GLuint v0, GLuint v1, GLuint v2, GLuint v3)
+{
+	glUniform4ui(location, v0, v1, v2, v3);
+}
+
+void GLDriverBackend::Uniform1fv(GLint location, GLsizei count, const GLfloat *value)
+{
+	glUniform1fv(location, count, value);
+}
+
+void GLDriverBackend::Uniform2fv(GLint location, GLsizei count, const GLfloat *value)
+{
+	glUniform2fv(location, count, value);
+}
+
+void GLDriverBackend::Uniform3fv(GLint location, GLsizei count, const GLfloat *value)
+{
+	glUniform3fv(location, count, value);
+}
+
+void GLDriverBackend::Uniform4fv(GLint location, GLsizei count, const GLfloat *value)
+{
+	glUniform4fv (location, count, value);
+}
+
+void GLDriverBackend::Uniform1iv(GLint location, GLsizei count, const GLint *value)
+{
+	glUniform1iv (location, count, value);
+}
+
+void GLDriverBackend::Uniform2iv(GLint location, GLsizei count, const GLint *value)
+{
+	glUniform2iv (location, count, value);
+}
+
+void GLDriverBackend::Uniform3iv(GLint location, GLsizei count, const GLint *value)
+{
+	glUniform3iv (location, count, value);
+}
+
+void GLDriverBackend::Uniform4iv(GLint location, GLsizei count, const GLint *value)
+{
+	glUniform4iv (location, count, value);
+}
+
+void GLDriverBackend::Uniform1uiv(GLint location, GLsizei count, const GLuint *value)
+{
+	glUniform1uiv (location, count, value);
+}
+
+void GLDriverBackend::Uniform2uiv(GLint location, GLsizei count, const GLuint *value)
+{
+	glUniform2uiv (location, count, value);
+}
+
+void GLDriverBackend::Uniform3uiv(GLint location, GLsizei count, const GLuint *value)
+{
+	glUniform3uiv (location, count, value);
+}
+
+void GLDriverBackend::Uniform4uiv(GLint location, GLsizei count, const GLuint *value)
+{
+	glUniform4uiv (location, count, value);
+}
+
+void GLDriverBackend::UniformMatrix2fv(GLint location, GLsizei count, GLboolean transpose, const GLfloat *value)
+{
+	glUniformMatrix2fv(location, count, transpose, value);
+}
+
+void GLDriverBackend::UniformMatrix3fv(GLint location, GLsizei count, GLboolean transpose, const GLfloat *value)
+{
+	glUniformMatrix3fv(location, count, transpose, value);
+}
+
+void GLDriverBackend::UniformMatrix4fv(GLint location, GLsizei count, GLboolean transpose, const GLfloat *value)
+{
+	glUniformMatrix4fv(location, count, transpose, value);
+}
+
+void GLDriverBackend::UniformMatrix2x3fv(GLint location, GLsizei count, GLboolean transpose, const GLfloat *value)
+{
+	glUniformMatrix2x3fv(location, count, transpose, value);
+}
+
+void GLDriverBackend::UniformMatrix3x2fv(GLint location, GLsizei count, GLboolean transpose, const GLfloat *value)
+{
+	glUniformMatrix3x2fv(location, count, transpose, value);
+}
+
+void GLDriverBackend::UniformMatrix2x4fv(GLint location, GLsizei count, GLboolean transpose, const GLfloat *value)
+{
+	glUniformMatrix2x4fv(location, count, transpose, value);
+}
+
+void GLDriverBackend::UniformMatrix4x2fv(GLint location, GLsizei count, GLboolean transpose, const GLfloat *value)
+{
+	glUniformMatrix4x2fv(location, count, transpose, value);
+}
+
+void GLDriverBackend::UniformMatrix3x4fv(GLint location, GLsizei count, GLboolean transpose, const GLfloat *value)
+{
+	glUniformMatrix3x4fv(location, count, transpose, value);
+}
+
+void GLDriverBackend::UniformMatrix4x3fv(GLint location, GLsizei count, GLboolean transpose, const GLfloat *value)
+{
+	glUniformMatrix4x3fv(location, count, transpose, value);
+}
+
+void GLDriverBackend::MemoryBarrier (GLbitfield barriers)
+{
+	glMemoryBarrier (barriers);
+}
+
+void GLDriverBackend::DebugMessageCallback (GLDEBUGPROC callback, const void* userParam)
+{
+	glDebugMessageCallback (callback, userParam);
+}
+
+void GLDriverBackend::Enable (GLenum cap)
+{
+	glEnable (cap);
+}
+
+void GLDriverBackend::Disable (GLenum cap)
+{
+	glDisable (cap);
+}
+
+GLboolean GLDriverBackend::IsEnabled(GLenum cap)
+{
+	return glIsEnabled (cap);
+}
+
+void GLDriverBackend::BindTexture(GLenum target, GLuint texture)
+{
+	glBindTexture (target, texture);
+}
+
+void GLDriverBackend::ActiveTexture(GLenum texture)
+{
+	glActiveTexture (texture);
+}
+
+void GLDriverBackend::TexImage2D(GLenum target,  GLint level,  GLint internalformat,  
+	GLsizei width,  GLsizei height,  GLint border,  GLenum format,  
+	GLenum type,  const GLvoid * data)
+{
+	glTexImage2D (target, level, internalformat, width, height, border,
+		format, type, data);
+}
+
+void GLDriverBackend::TexImage3D(GLenum target, GLint level, GLint internalFormat, 
+	GLsizei width, GLsizei height, GLsizei depth, GLint border, 
+	GLenum format, GLenum type, const GLvoid * data)
+{
+	glTexImage3D(target, level, internalFormat, width, height, depth, 
+		border, format, type, data);
+}
+
+void GLDriverBackend::TexStorage3D(GLenum target, GLsizei levels, GLenum internalFormat, 
+	GLsizei width, GLsizei height, GLsizei depth)
+{
+	glTexStorage3D(target, levels, internalFormat, width, height, depth);
+}
+
+void GLDriverBackend::TexPageCommitment(GLenum target, GLint level, GLint xoffset, GLint yoffset, 
+	GLint zoffset, GLsizei width, GLsizei height, GLsizei depth, GLboolean commit)
+{
+	glTexPageCommitmentARB(target, level, xoffset, yoffset, zoffset, 
+		width, height, depth, commit);
+}
+
+void GLDriverBackend::ClearTexSubImage(GLuint texture, GLint level, GLint xoffset, GLint yoffset, 
+	GLint zoffset, GLsizei width, GLsizei height, GLsizei depth, GLenum format, 
+	GLenum type, const void * data)
+{
+	glClearTexSubImage(texture, level, xoffset, yoffset, zoffset, 
+		width, height, depth, format, type, data);
+}
+
+void GLDriverBackend::TexEnvi(GLenum target,  GLenum pname,  GLint param)
+{
+	glTexEnvi (target, pname, param);
+}
+
+void GLDriverBackend::TexEnvf(GLenum target,  GLenum pname,  GLfloat param)
+{
+	glTexEnvf (target, pname, param);
+}
+
+void GLDriverBackend::TexParameteri(GLenum target,  GLenum pname,  GLint param)
+{
+	glTexParameteri(target, pname, param);
+}
+
+void GLDriverBackend::TexParameterf(GLenum target,  GLenum pname,  GLfloat param)
+{
+	glTexParameterf (target, pname, param);
+}
+
+void GLDriverBackend::TexParameteriv(GLenum target, GLenum pname, const GLint * params)
+{
+	glTexParameteriv(target, pname, params);
+}
+
+void GLDriverBackend::TexParameterfv(GLenum target, GLenum pname, const GLfloat * params)
+{
+	glTexParameterfv(target, pname, params);
+}
+
+void GLDriverBackend::GenerateMipmap (GLenum target)
+{
+	glGenerateMipmap(target);
+}
+
+void GLDriverBackend::GetTexParameteriv(GLenum target, GLenum pname, GLint * params)
+{
+	glGetTexParameteriv(target, pname, params);
+}
+
+void GLDriverBackend::GetInternalformativ(GLenum target, GLenum internalFormat, GLenum pname, 
+	GLsizei bufSize, GLint * params)
+{
+	glGetInternalformativ(target, internalFormat, pname, bufSize, params);
+}
+
+void GLDriverBackend::PixelStorei(GLenum pname, GLint param)
+{
+	glPixelStorei(pname, param);
+}
+
+void GLDriverBackend::BindImageTexture (GLuint unit, GLuint texture, GLint level, GLboolean layered, GLint layer, GLenum access, GLenum format)
+{
+	glBindImageTexture (unit, texture, level, layered, layer, access, format);
+}
+
+GLuint GLDriverBackend::CreateShader (GLenum shaderType)
+{
+	return glCreateShader(shaderType);
+}
+
+void GLDriverBackend::DeleteShader(GLuint shader)
+{
+	glDeleteShader (shader);
+}
+
+void GLDriverBackend::ShaderSource (GLuint shader, GLsizei count, const GLchar **string, const GLint *length)
+{
+	glShaderSource(shader, count, string, length);
+}
+
+void GLDriverBackend::CompileShader(GLuint shader)
+{
+	glCompileShader (shader);
+}
+
+void GLDriverBackend::GetShaderInfoLog(GLuint  shader,  GLsizei  maxLength,  GLsizei * length,  GLchar * infoLog)
+{
+	glGetShaderInfoLog(shader, maxLength, length, infoLog);
+}
+
+GLuint GLDriverBackend::CreateProgram(void)
+{
+	return glCreateProgram ();
+}
+
+void GLDriverBackend::DeleteProgram(GLuint program)
+{
+	glDeleteProgram (program);
+}
+
+void GLDriverBackend::UseProgram (GLuint program)
+{
+	glUseProgram (program);
+}
+
+void GLDriverBackend::LinkProgram(GLuint program)
+{
+	glLinkProgram (program);
+}
+
+void GLDriverBackend::AttachShader(GLuint program, GLuint shader)
+{
+	glAttachShader(program, shader);
+}
+
+void GLDriverBackend::DetachShader(GLuint program, GLuint shader)
+{
+	glDetachShader (program, shader);
+}
+
+GLint GLDriverBackend::GetUniformLocation(GLuint program, const GLchar *name)
+{
+	return glGetUniformLocation(program, name);
+}
+
+GLuint GLDriverBackend::GetUniformBlockIndex(GLuint program, const GLchar *uniformBlockName)
+{
+	return glGetUniformBlockIndex(program, uniformBlockName);
+}
+
+void GLDriverBackend::UniformBlockBinding(GLuint program, GLuint uniformBlockIndex, GLuint uniformBlockBinding)
+{
+	glUniformBlockBinding(program, uniformBlockIndex, uniformBlockBinding);
+}
+
+void GLDriverBackend::DispatchCompute(GLuint num_groups_x, GLuint num_groups_y, GLuint num_groups_z)
+{
+	glDispatchCompute(num_groups_x, num_groups_y, num_groups_z);
+}
+
+void GLDriverBackend::GetBooleanv(GLenum pname, GLboolean * params)
+{
+	glGetBooleanv (pname, params);
+}
+
+void GLDriverBackend::GetFixedv(GLenum pname, GLfixed * params)
+{
+	glGetFixedv (pname, params);
+}
+
+void GLDriverBackend::GetFloatv(GLenum pname, GLfloat * params)
+{
+	glGetFloatv (pname, params);
+}
+
+void GLDriverBackend::GetIntegerv(GLenum pname, GLint * params)
+{
+	glGetIntegerv(pname, params);
+}
+
+void GLDriverBackend::DeleteVertexArrays(GLsizei n, const GLuint *arrays)
+{
+	glDeleteVertexArrays(n, arrays);
+}
+
+void GLDriverBackend::DeleteBuffers (GLsizei n, const GLuint* arrays)
+{
+	glDeleteBuffers (n, arrays);
+}
+
+void GLDriverBackend::DeleteFramebuffers(GLsizei n, const GLuint * framebuffers)
+{
+	glDeleteFramebuffers (n, framebuffers);
+}
+
+void GLDriverBackend::DeleteTextures(GLsizei n, const GLuint * textures)
+{
+	glDeleteTextures (n, textures);
+}
+
+GLenum GLDriverBackend::GetError ()
+{
+	return glGetError ();
+}
+
+void GLDriverBackend::EndFrame ()
+{
+
+}
\ No newline at end of file
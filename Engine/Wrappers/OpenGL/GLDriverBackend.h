@@ -0,0 +1,298 @@
+#ifndef GLDRIVERBACKEND_H
+#define GLDRIVERBACKEND_H
+
+#include "GLBackend.h"
+
+/*
+ * Calls of the wrapper as they are, to the OpenGL of the context
+*/
+
+class GLDriverBackend : public GLBackend
+{
+public:
+	
+#ifdef GL_DEPRECATED_PERMIT
+	
+	/*
+	 * Not intended to be used
+	*/
+
+	void Begin(GLenum  mode);
+	void End();
+
+#endif
+
+	/*
+	 * Viewport
+	*/
+
+	void Viewport(GLint x,  GLint y,  GLsizei width,  GLsizei height);
+
+	/*
+	 * Frame Buffer
+	*/
+
+	void Clear(GLbitfield  mask);
+	void ClearColor(GLclampf red,  GLclampf green,  GLclampf blue,  GLclampf alpha);
+	void ColorMask(GLboolean red,  GLboolean green,  GLboolean blue,  GLboolean alpha);
+	void FramebufferTexture (GLenum target, GLenum attachment, GLuint texture, GLint level);
+	void FramebufferTexture2D(GLenum target,  GLenum attachment,  GLenum textarget,  GLuint texture,  GLint level);
+	void DrawBuffer(GLenum buf);
+	void DrawBuffers(GLsizei n, const GLenum *bufs);
+	void ReadBuffer(GLenum mode);
+	void BindFramebuffer(GLenum target,  GLuint framebuffer);
+	void BlitFramebuffer(GLint srcX0, GLint srcY0, GLint srcX1, GLint srcY1, GLint dstX0, 
+		GLint dstY0, GLint dstX1, GLint dstY1, GLbitfield mask, GLenum filter);
+	GLenum CheckFramebufferStatus(GLenum target);
+
+	/*
+	 * Culling
+	*/
+
+	void CullFace(GLenum mode);
+
+	/*
+	 * Behaviour 
+	*/
+
+	void Hint(GLenum target,  GLenum mode);
+
+	/*
+	 * Draw Calls
+	*/
+
+	void DrawArrays(GLenum mode, GLint first, GLsizei count);
+	void DrawElements (GLenum mode, GLsizei count, GLenum type, const void* indices);
+	void DrawElementsInstanced (GLenum mode, GLsizei count, GLenum type, const void* indices, GLsizei primcount);
+	void DrawElementsInstancedBaseInstance (GLenum mode, GLsizei count, GLenum type, const void* indices,
+		GLsizei primcount, GLuint baseinstance);
+	void DrawElementsBaseVertex (GLenum mode, GLsizei count, GLenum type, const void* indices, GLint basevertex);
+	void MultiDrawElementsIndirect (GLenum mode, GLenum type, const void* indirect, GLsizei drawcount, GLsizei stride);
+
+	// Buffers
+	void BufferData (GLenum target, GLsizeiptr size, const GLvoid * data, GLenum usage);
+	void BufferSubData (GLenum target, GLintptr offset, GLsizeiptr size, const GLvoid *data);
+	void* MapBufferRange (GLenum target, GLintptr offset, GLsizeiptr length, GLbitfield access);
+	GLboolean UnmapBuffer (GLenum target);
+	void BufferStorage (GLenum target, GLsizeiptr size, const GLvoid* data, GLbitfield flags);
+
+	/*
+	 * Synchronization
+	*/
+
+	GLsync FenceSync (GLenum condition, GLbitfield flags);
+	GLenum ClientWaitSync (GLsync sync, GLbitfield flags, GLuint64 timeout);
+	void DeleteSync (GLsync sync);
+
+	/*
+	 * Queries
+	*/
+
+	void GenQueries (GLsizei n, GLuint* ids);
+	void DeleteQueries (GLsizei n, const GLuint* ids);
+	void QueryCounter (GLuint id, GLenum target);
+	void GetQueryObjectiv (GLuint id, GLenum pname, GLint* params);
+	void GetQueryObjectui64v (GLuint id, GLenum pname, GLuint64* params);
+
+	/*
+	 * Vertex Attributes
+	*/
+
+	void EnableVertexAttribArray (GLuint index);
+	void VertexAttribPointer (GLuint index, GLint size, GLenum type, GLboolean normalized, GLsizei stride, const GLvoid * pointer);
+	void VertexAttribIPointer (GLuint index, GLint size, GLenum type, GLsizei stride, const GLvoid * pointer);	
+	void VertexAttribDivisor (GLuint index, GLuint divisor);
+	void VertexAttrib1f(GLuint index,  GLfloat v0);
+	void VertexAttrib2f(GLuint index,  GLfloat v0,  GLfloat v1);
+	void VertexAttrib3f(GLuint index,  GLfloat v0,  GLfloat v1,  GLfloat v2);
+	void VertexAttrib4f(GLuint index,  GLfloat v0,  GLfloat v1,  GLfloat v2,  GLfloat v3);
+	void VertexAttrib1fv(GLuint index,  const GLfloat *v);
+	void VertexAttrib2fv(GLuint index,  const GLfloat *v);
+	void VertexAttrib3fv(GLuint index,  const GLfloat *v);
+	void VertexAttrib4fv(GLuint index,  const GLfloat *v);
+
+	// Bind
+	void BindVertexArray (GLuint array);
+	void BindBuffer (GLenum target, GLuint buffer);
+	void BindBufferBase (GLenum target, GLuint index, GLuint buffer);
+	void BindBufferRange (GLenum target, GLuint index, GLuint buffer, GLintptr offset, GLsizeiptr size);
+
+	/*
+	 * Depth Buffer
+	*/
+
+	void DepthMask (GLboolean flag);
+	void DepthRange(GLclampd nearVal, GLclampd farVal);
+	void ClearDepth(GLclampd  depth);
+	void DepthFunc(GLenum func);
+
+	/*
+	 * Stencil Buffer
+	*/
+
+	void StencilFunc(GLenum func, GLint ref, GLuint mask);
+	void StencilOp(GLenum sfail, GLenum dpfail, GLenum dppass);
+	void StencilOpSeparate(GLenum face, GLenum sfail, GLenum dpfail, GLenum dppass);
+	void StencilMask(GLuint mask);
+
+	// Blend
+	void BlendFunc (GLenum sfactor, GLenum dfactor);
+	void BlendFunci (GLuint buf, GLenum sfactor, GLenum dfactor);
+	void BlendEquation (GLenum mode);
+
+	// Generators
+	void GenVertexArrays (GLsizei n, GLuint * arrays);
+	void GenBuffers(GLsizei n,  GLuint * buffers);
+	void GenTextures(GLsizei n,  GLuint * textures);
+	void GenFramebuffers(GLsizei n,  GLuint * framebuffers);
+
+	// Textures
+	void BindTexture(GLenum target, GLuint texture);
+	void ActiveTexture(GLenum texture);
+
+	void TexImage2D(GLenum target,  GLint level,  GLint internalformat,  GLsizei width,  
+		GLsizei height,  GLint border,  GLenum format,  GLenum type,  const GLvoid * data);
+	void TexImage3D(GLenum target, GLint level, GLint internalFormat, GLsizei width, GLsizei height, 
+		GLsizei depth, GLint border, GLenum format, GLenum type, const GLvoid * data);
+	void TexStorage3D(GLenum target, GLsizei levels, GLenum internalFormat, GLsizei width, 
+		GLsizei height, GLsizei depth);
+	void TexPageCommitment(GLenum target, GLint level, GLint xoffset, GLint yoffset, GLint zoffset, 
+		GLsizei width, GLsizei height, GLsizei depth, GLboolean commit);
+	void ClearTexSubImage(GLuint texture, GLint level, GLint xoffset, GLint yoffset, GLint zoffset, 
+		GLsizei width, GLsizei height, GLsizei depth, GLenum format, GLenum type, const void * data);
+
+	void TexEnvi(GLenum target,  GLenum pname,  GLint param);
+	void TexEnvf(GLenum target,  GLenum pname,  GLfloat param);
+	void TexParameteri(GLenum target,  GLenum pname,  GLint param);
+	void TexParameterf(GLenum target,  GLenum pname,  GLfloat param);
+	void TexParameteriv(GLenum target, GLenum pname, const GLint * params);
+	void TexParameterfv(GLenum target, GLenum pname, const GLfloat * params);
+	void GenerateMipmap(GLenum target);
+	void GetTexParameteriv(GLenum target, GLenum pname, GLint * params);
+	void GetInternalformativ(GLenum target, GLenum internalFormat, GLenum pname, GLsizei bufSize, GLint * params);
+
+	/*
+	 * Pixels
+	*/
+
+	void PixelStorei(GLenum pname, GLint param);
+
+	/*
+	 * Image Textures
+	*/
+
+	void BindImageTexture (GLuint unit, GLuint texture, GLint level, GLboolean layered, GLint layer, GLenum access, GLenum format);
+
+	/*
+	 * Shaders
+	*/
+
+	GLuint CreateShader(GLenum shaderType);
+	void DeleteShader(GLuint shader);
+	void ShaderSource(GLuint shader, GLsizei count, const GLchar **string, const GLint *length);	
+	void CompileShader(GLuint shader);
+	void GetShaderInfoLog(GLuint  shader,  GLsizei  maxLength,  GLsizei * length,  GLchar * infoLog);
+
+	GLuint CreateProgram(void);
+	void DeleteProgram(GLuint program);
+	void UseProgram (GLuint program);
+	void LinkProgram(GLuint program);
+
+	void AttachShader(GLuint program, GLuint shader);
+	void DetachShader(GLuint program, GLuint shader);
+	GLint GetUniformLocation(GLuint program, const GLchar *name);
+	GLuint GetUniformBlockIndex(GLuint program, const GLchar *uniformBlockName);
+	void UniformBlockBinding(GLuint program, GLuint uniformBlockIndex, GLuint uniformBlockBinding);
+
+	void DispatchCompute(GLuint num_groups_x,GLuint num_groups_y,GLuint num_groups_z);
+
+	/*
+	 * Uniforms
+	*/
+
+	void Uniform1f(GLint location,  GLfloat v0);
+	void Uniform2f(GLint location,  GLfloat v0,  GLfloat v1);
+	void Uniform3f(GLint location,  GLfloat v0,  GLfloat v1,  GLfloat v2);
+	void Uniform4f(GLint location,  GLfloat v0,  GLfloat v1,  GLfloat v2,  GLfloat v3);
+	void Uniform1i(GLint location,  GLint v0);
+	void Uniform2i(GLint location,  GLint v0,  GLint v1);
+	void Uniform3i(GLint location,  GLint v0,  GLint v1,  GLint v2);
+	void Uniform4i(GLint location,  GLint v0,  GLint v1,  GLint v2,  GLint v3);
+	void Uniform1ui(GLint location, GLuint v0);
+	void Uniform2ui(GLint location, GLuint v0, GLuint v1);
+	void Uniform3ui(GLint location, GLuint v0, GLuint v1, GLuint v2);
+	void Uniform4ui(GLint location, GLuint v0, GLuint v1, GLuint v2, GLuint v3);
+	void Uniform1fv(GLint location, GLsizei count, const GLfloat *value);
+	void Uniform2fv(GLint location, GLsizei count, const GLfloat *value);
+	void Uniform3fv(GLint location, GLsizei count, const GLfloat *value);
+	void Uniform4fv(GLint location, GLsizei count, const GLfloat *value);
+	void Uniform1iv(GLint location, GLsizei count, const GLint *value);
+	void Uniform2iv(GLint location, GLsizei count, const GLint *value);
+	void Uniform3iv(GLint location, GLsizei count, const GLint *value);
+	void Uniform4iv(GLint location, GLsizei count, const GLint *value);
+	void Uniform1uiv(GLint location, GLsizei count, const GLuint *value);
+	void Uniform2uiv(GLint location, GLsizei count, const GLuint *value);
+	void Uniform3uiv(GLint location, GLsizei count, const GLuint *value);
+	void Uniform4uiv(GLint location, GLsizei count, const GLuint *value);
+	void UniformMatrix2fv(GLint location, GLsizei count, GLboolean transpose, const GLfloat *value);
+	void UniformMatrix3fv(GLint location, GLsizei count, GLboolean transpose, const GLfloat *value);
+	void UniformMatrix4fv(GLint location, GLsizei count, GLboolean transpose, const GLfloat *value);
+	void UniformMatrix2x3fv(GLint location, GLsizei count, GLboolean transpose, const GLfloat *value);
+	void UniformMatrix3x2fv(GLint location, GLsizei count, GLboolean transpose, const GLfloat *value);
+	void UniformMatrix2x4fv(GLint location, GLsizei count, GLboolean transpose, const GLfloat *value);
+	void UniformMatrix4x2fv(GLint location, GLsizei count, GLboolean transpose, const GLfloat *value);
+	void UniformMatrix3x4fv(GLint location, GLsizei count, GLboolean transpose, const GLfloat *value);
+	void UniformMatrix4x3fv(GLint location, GLsizei count, GLboolean transpose, const GLfloat *value);
+
+	/*
+	 * Memory
+	*/
+
+	void MemoryBarrier(GLbitfield barriers);
+
+	/*
+	 * Debug
+	*/
+
+	void DebugMessageCallback (GLDEBUGPROC callback, const void* userParam);
+
+	/*
+	 * Capabilities
+	*/
+
+	void Enable (GLenum cap);
+	void Disable (GLenum cap);
+	GLboolean IsEnabled(GLenum cap);
+
+	/*
+	 * Getters
+	*/
+
+	void GetBooleanv(GLenum pname, GLboolean * params);
+	void GetFixedv(GLenum pname, GLfixed * params);
+	void GetFloatv(GLenum pname, GLfloat * params);
+	void GetIntegerv(GLenum pname, GLint * params);
+
+	/*
+	 * Cleaning 
+	*/
+
+	void DeleteVertexArrays (GLsizei n, const GLuint *arrays);
+	void DeleteBuffers(GLsizei n, const GLuint * buffers);
+	void DeleteFramebuffers(GLsizei n, const GLuint * framebuffers);
+	void DeleteTextures(GLsizei n, const GLuint * textures);
+
+	/*
+	 * Errors
+	*/
+
+	GLenum GetError ();
+
+	/*
+	 * Frames
+	*/
+
+	void EndFrame ();
+};
+
+#endif
\ No newline at end of file
@@ -0,0 +1,1357 @@
+#include "GLNullBackend.h"
+
+#include <algorithm>
+
+#include "Core/Console/Console.h"
+
+/*
+ * The flags GLEW keeps for the extensions the engine checks for
+*/
+
+struct GLNullExtension
+{
+	const char* name;
+	GLboolean* flag;
+};
+
+static GLNullExtension GLNullExtensions [] = {
+	{ "GL_ARB_buffer_storage", &__GLEW_ARB_buffer_storage },
+	{ "GL_ARB_clear_texture", &__GLEW_ARB_clear_texture },
+	{ "GL_ARB_sparse_texture", &__GLEW_ARB_sparse_texture },
+	{ "GL_ARB_sparse_texture2", &__GLEW_ARB_sparse_texture2 },
+	{ "GL_ARB_timer_query", &__GLEW_ARB_timer_query },
+	{ "GL_KHR_debug", &__GLEW_KHR_debug }
+};
+
+GLFrameStatistics::GLFrameStatistics () :
+	callsCount (0),
+	drawsCount (0),
+	dispatchesCount (0),
+	bindsCount (0),
+	redundantBindsCount (0),
+	stateChangesCount (0),
+	redundantStateChangesCount (0),
+	uploadedBytesCount (0)
+{
+
+}
+
+GLNullBackend::GLNullBackend () :
+	_stream (),
+	_isRecording (false),
+	_commands (),
+	_callsCounts (),
+	_frameStatistics (),
+	_lastFrameStatistics (),
+	_framesCount (0),
+	_lastName (0),
+	_bindings (),
+	_capabilities (),
+	_depthMask (GL_TRUE),
+	_activeTexture (GL_TEXTURE0),
+	_uniformLocations (),
+	_buffersSizes (),
+	_buffersData (),
+	_sparseLevels ()
+{
+
+}
+
+GLNullBackend::GLNullBackend (const std::string& streamFilename) :
+	GLNullBackend ()
+{
+	_stream.open (streamFilename, std::ofstream::out);
+
+	_isRecording = _stream.is_open ();
+
+	if (!_isRecording) {
+		Console::LogError ("GL stream could not be written to " + streamFilename);
+	}
+}
+
+/*
+ * The calls after the last frame, of the cleaning, go in a frame of
+ * their own
+*/
+
+GLNullBackend::~GLNullBackend ()
+{
+	if (_frameStatistics.callsCount > 0) {
+		EndFrame ();
+	}
+}
+
+const GLFrameStatistics& GLNullBackend::GetFrameStatistics () const
+{
+	return _lastFrameStatistics;
+}
+
+std::size_t GLNullBackend::GetFramesCount () const
+{
+	return _framesCount;
+}
+
+std::vector<std::string> GLNullBackend::GetKnownExtensions ()
+{
+	std::vector<std::string> extensions;
+
+	for (const GLNullExtension& extension : GLNullExtensions) {
+		extensions.push_back (extension.name);
+	}
+
+	return extensions;
+}
+
+bool GLNullBackend::SetExtension (const std::string& name, bool isSupported)
+{
+	for (const GLNullExtension& extension : GLNullExtensions) {
+		if (name == extension.name) {
+			*extension.flag = isSupported ? GL_TRUE : GL_FALSE;
+
+			return true;
+		}
+	}
+
+	return false;
+}
+
+#ifdef GL_DEPRECATED_PERMIT
+
+/*
+ * Not intended to be used
+*/
+
+void GLNullBackend::Begin(GLenum  mode)
+{
+	Record ("Begin", {mode});
+}
+
+void GLNullBackend::End()
+{
+	Record ("End", {});
+}
+
+#endif
+
+void GLNullBackend::Viewport(GLint x,  GLint y,  GLsizei width,  GLsizei height)
+{
+	Record ("Viewport", {x, y, width, height});
+}
+
+void GLNullBackend::Clear(GLbitfield  mask)
+{
+	Record ("Clear", {mask});
+}
+
+void GLNullBackend::ClearColor(GLclampf red,  GLclampf green,  GLclampf blue,  GLclampf alpha)
+{
+	Record ("ClearColor", {});
+}
+
+void GLNullBackend::ColorMask(GLboolean red,  GLboolean green,  GLboolean blue,  GLboolean alpha)
+{
+	Record ("ColorMask", {red, green, blue, alpha});
+}
+
+void GLNullBackend::FramebufferTexture (GLenum target, GLenum attachment, GLuint texture, GLint level)
+{
+	Record ("FramebufferTexture", {target, attachment, texture, level});
+}
+
+void GLNullBackend::FramebufferTexture2D(GLenum target,  GLenum attachment,  GLenum textarget,  GLuint texture,  GLint level)
+{
+	Record ("FramebufferTexture2D", {target, attachment, textarget, texture, level});
+}
+
+void GLNullBackend::DrawBuffer(GLenum buf)
+{
+	Record ("DrawBuffer", {buf});
+}
+
+void GLNullBackend::DrawBuffers(GLsizei n, const GLenum *bufs)
+{
+	Record ("DrawBuffers", {n});
+}
+
+void GLNullBackend::ReadBuffer(GLenum mode)
+{
+	Record ("ReadBuffer", {mode});
+}
+
+void GLNullBackend::BindFramebuffer(GLenum target,  GLuint framebuffer)
+{
+	Record ("BindFramebuffer", {target, framebuffer});
+
+	if (target != GL_FRAMEBUFFER) {
+		Bind (target, 0, framebuffer);
+
+		return;
+	}
+
+	Bind (GL_DRAW_FRAMEBUFFER, 0, framebuffer);
+
+	_bindings [std::make_pair (GL_READ_FRAMEBUFFER, 0)] = framebuffer;
+}
+
+void GLNullBackend::BlitFramebuffer(GLint srcX0, GLint srcY0, GLint srcX1, GLint srcY1, 
+	GLint dstX0, GLint dstY0, GLint dstX1, GLint dstY1, GLbitfield mask, GLenum filter)
+{
+	Record ("BlitFramebuffer", {srcX0, srcY0, srcX1, srcY1, dstX0, dstY0, dstX1, dstY1, mask, filter});
+}
+
+GLenum GLNullBackend::CheckFramebufferStatus(GLenum target)
+{
+	Record ("CheckFramebufferStatus", {target});
+
+	return GL_FRAMEBUFFER_COMPLETE;
+}
+
+void GLNullBackend::Hint(GLenum target,  GLenum mode)
+{
+	Record ("Hint", {target, mode});
+}
+
+void GLNullBackend::CullFace(GLenum mode)
+{
+	Record ("CullFace", {mode});
+}
+
+void GLNullBackend::DrawArrays (GLenum mode, GLint first, GLsizei count)
+{
+	Record ("DrawArrays", {mode, first, count});
+
+	_frameStatistics.drawsCount ++;
+}
+
+void GLNullBackend::DrawElements (GLenum mode, GLsizei count, GLenum type, const void* indices)
+{
+	Record ("DrawElements", {mode, count, type, (std::int64_t) (std::intptr_t) indices});
+
+	_frameStatistics.drawsCount ++;
+}
+
+void GLNullBackend::DrawElementsInstanced (GLenum mode, GLsizei count, GLenum type, const void* indices, GLsizei primcount)
+{
+	Record ("DrawElementsInstanced", {mode, count, type, (std::int64_t) (std::intptr_t) indices, primcount});
+
+	_frameStatistics.drawsCount ++;
+}
+
+void GLNullBackend::DrawElementsInstancedBaseInstance (GLenum mode, GLsizei count, GLenum type, const void* indices,
+	GLsizei primcount, GLuint baseinstance)
+{
+	Record ("DrawElementsInstancedBaseInstance", {mode, count, type, (std::int64_t) (std::intptr_t) indices, primcount, baseinstance});
+
+	_frameStatistics.drawsCount ++;
+}
+
+void GLNullBackend::DrawElementsBaseVertex (GLenum mode, GLsizei count, GLenum type, const void* indices, GLint basevertex)
+{
+	Record ("DrawElementsBaseVertex", {mode, count, type, (std::int64_t) (std::intptr_t) indices, basevertex});
+
+	_frameStatistics.drawsCount ++;
+}
+
+void GLNullBackend::MultiDrawElementsIndirect (GLenum mode, GLenum type, const void* indirect, GLsizei drawcount, GLsizei stride)
+{
+	Record ("MultiDrawElementsIndirect", {mode, type, (std::int64_t) (std::intptr_t) indirect, drawcount, stride});
+
+	_frameStatistics.drawsCount += drawcount;
+}
+
+void GLNullBackend::BufferData (GLenum target, GLsizeiptr size, const GLvoid * data, GLenum usage)
+{
+	Record ("BufferData", {target, size, usage});
+
+	SetBufferSize (target, size);
+
+	if (data != nullptr) {
+		_frameStatistics.uploadedBytesCount += size;
+	}
+}
+
+void GLNullBackend::BufferSubData (GLenum target, GLintptr offset, GLsizeiptr size, const GLvoid * data)
+{
+	Record ("BufferSubData", {target, offset, size});
+
+	_frameStatistics.uploadedBytesCount += size;
+}
+
+void* GLNullBackend::MapBufferRange (GLenum target, GLintptr offset, GLsizeiptr length, GLbitfield access)
+{
+	Record ("MapBufferRange", {target, offset, length, access});
+
+	GLuint buffer = GetBoundBuffer (target);
+
+	if (buffer == 0) {
+		return nullptr;
+	}
+
+	std::vector<unsigned char>& data = _buffersData [buffer];
+
+	std::size_t size = std::max ((std::size_t) _buffersSizes [buffer], (std::size_t) (offset + length));
+
+	if (data.size () < size) {
+		data.resize (size);
+	}
+
+	if (access & GL_MAP_WRITE_BIT) {
+		_frameStatistics.uploadedBytesCount += length;
+	}
+
+	return data.data () + offset;
+}
+
+GLboolean GLNullBackend::UnmapBuffer (GLenum target)
+{
+	Record ("UnmapBuffer", {target});
+
+	return GL_TRUE;
+}
+
+void GLNullBackend::BufferStorage (GLenum target, GLsizeiptr size, const GLvoid* data, GLbitfield flags)
+{
+	Record ("BufferStorage", {target, size, flags});
+
+	SetBufferSize (target, size);
+
+	if (data != nullptr) {
+		_frameStatistics.uploadedBytesCount += size;
+	}
+}
+
+GLsync GLNullBackend::FenceSync (GLenum condition, GLbitfield flags)
+{
+	Record ("FenceSync", {condition, flags});
+
+	return reinterpret_cast<GLsync> ((std::uintptr_t) GenName ());
+}
+
+GLenum GLNullBackend::ClientWaitSync (GLsync sync, GLbitfield flags, GLuint64 timeout)
+{
+	Record ("ClientWaitSync", {flags, (std::int64_t) timeout});
+
+	return GL_ALREADY_SIGNALED;
+}
+
+void GLNullBackend::DeleteSync (GLsync sync)
+{
+	Record ("DeleteSync", {});
+}
+
+void GLNullBackend::GenQueries (GLsizei n, GLuint* ids)
+{
+	Record ("GenQueries", {n});
+
+	GenNames (n, ids);
+}
+
+void GLNullBackend::DeleteQueries (GLsizei n, const GLuint* ids)
+{
+	Record ("DeleteQueries", {n});
+
+	DeleteNames (n, ids);
+}
+
+void GLNullBackend::QueryCounter (GLuint id, GLenum target)
+{
+	Record ("QueryCounter", {id, target});
+}
+
+void GLNullBackend::GetQueryObjectiv (GLuint id, GLenum pname, GLint* params)
+{
+	Record ("GetQueryObjectiv", {id, pname});
+
+	*params = pname == GL_QUERY_RESULT_AVAILABLE ? GL_TRUE : 0;
+}
+
+void GLNullBackend::GetQueryObjectui64v (GLuint id, GLenum pname, GLuint64* params)
+{
+	Record ("GetQueryObjectui64v", {id, pname});
+
+	*params = 0;
+}
+
+void GLNullBackend::EnableVertexAttribArray (GLuint index)
+{
+	Record ("EnableVertexAttribArray", {index});
+}
+
+void GLNullBackend::VertexAttribPointer (GLuint index, GLint size, GLenum type, GLboolean normalized, GLsizei stride, const GLvoid * pointer)
+{
+	Record ("VertexAttribPointer", {index, size, type, normalized, stride, (std::int64_t) (std::intptr_t) pointer});
+}
+
+void GLNullBackend::VertexAttribIPointer (GLuint index, GLint size, GLenum type, GLsizei stride, const GLvoid * pointer)
+{
+	Record ("VertexAttribIPointer", {index, size, type, stride, (std::int64_t) (std::intptr_t) pointer});
+}
+
+void GLNullBackend::VertexAttribDivisor(GLuint index, GLuint divisor)
+{
+	Record ("VertexAttribDivisor", {index, divisor});
+}
+
+void GLNullBackend::VertexAttrib1f(GLuint index,  GLfloat v0)
+{
+	Record ("VertexAttrib1f", {index});
+}
+
+void GLNullBackend::VertexAttrib2f(GLuint index,  GLfloat v0,  GLfloat v1)
+{
+	Record ("VertexAttrib2f", {index});
+}
+
+void GLNullBackend::VertexAttrib3f(GLuint index,  GLfloat v0,  GLfloat v1,  GLfloat v2)
+{
+	Record ("VertexAttrib3f", {index});
+}
+
+void GLNullBackend::VertexAttrib4f(GLuint index,  GLfloat v0,  GLfloat v1,  GLfloat v2,  GLfloat v3)
+{
+	Record ("VertexAttrib4f", {index});
+}
+
+void GLNullBackend::VertexAttrib1fv(GLuint index,  const GLfloat *v)
+{
+	Record ("VertexAttrib1fv", {index});
+}
+
+void GLNullBackend::VertexAttrib2fv(GLuint index,  const GLfloat *v)
+{
+	Record ("VertexAttrib2fv", {index});
+}
+
+void GLNullBackend::VertexAttrib3fv(GLuint index,  const GLfloat *v)
+{
+	Record ("VertexAttrib3fv", {index});
+}
+
+void GLNullBackend::VertexAttrib4fv(GLuint index,  const GLfloat *v)
+{
+	Record ("VertexAttrib4fv", {index});
+}
+
+void GLNullBackend::BindVertexArray (GLuint array)
+{
+	Record ("BindVertexArray", {array});
+
+	Bind (GL_VERTEX_ARRAY_BINDING, 0, array);
+}
+
+void GLNullBackend::BindBuffer(GLenum target, GLuint buffer)
+{
+	Record ("BindBuffer", {target, buffer});
+
+	Bind (target, GetBufferIndex (target), buffer);
+}
+
+void GLNullBackend::BindBufferBase(GLenum target, GLuint index, GLuint buffer)
+{
+	Record ("BindBufferBase", {target, index, buffer});
+
+	Bind (target, index, buffer);
+
+	_bindings [std::make_pair (target, GL_INVALID_INDEX)] = buffer;
+}
+
+void GLNullBackend::BindBufferRange(GLenum target, GLuint index, GLuint buffer, GLintptr offset, GLsizeiptr size)
+{
+	Record ("BindBufferRange", {target, index, buffer, offset, size});
+
+	Bind (target, index, buffer);
+
+	_bindings [std::make_pair (target, GL_INVALID_INDEX)] = buffer;
+}
+
+void GLNullBackend::DepthMask (GLboolean flag)
+{
+	Record ("DepthMask", {flag});
+
+	_frameStatistics.stateChangesCount ++;
+
+	if (_depthMask == flag) {
+		_frameStatistics.redundantStateChangesCount ++;
+	}
+
+	_depthMask = flag;
+}
+
+void GLNullBackend::DepthRange(GLclampd nearVal, GLclampd farVal)
+{
+	Record ("DepthRange", {});
+}
+
+void GLNullBackend::ClearDepth(GLclampd  depth)
+{
+	Record ("ClearDepth", {});
+}
+
+void GLNullBackend::DepthFunc(GLenum func)
+{
+	Record ("DepthFunc", {func});
+}
+
+void GLNullBackend::StencilFunc(GLenum func, GLint ref, GLuint mask)
+{
+	Record ("StencilFunc", {func, ref, mask});
+}
+
+void GLNullBackend::StencilOp(GLenum sfail, GLenum dpfail, GLenum dppass)
+{
+	Record ("StencilOp", {sfail, dpfail, dppass});
+}
+
+void GLNullBackend::StencilOpSeparate(GLenum face, GLenum sfail, GLenum dpfail, GLenum dppass)
+{
+	Record ("StencilOpSeparate", {face, sfail, dpfail, dppass});
+}
+
+void GLNullBackend::StencilMask(GLuint mask)
+{
+	Record ("StencilMask", {mask});
+}
+
+void GLNullBackend::BlendFunc (GLenum sfactor, GLenum dfactor)
+{
+	Record ("BlendFunc", {sfactor, dfactor});
+}
+
+void GLNullBackend::BlendFunci (GLuint buf, GLenum sfactor, GLenum dfactor)
+{
+	Record ("BlendFunci", {buf, sfactor, dfactor});
+}
+
+void GLNullBackend::BlendEquation (GLenum mode)
+{
+	Record ("BlendEquation", {mode});
+}
+
+void GLNullBackend::GenVertexArrays (GLsizei n, GLuint * arrays)
+{
+	Record ("GenVertexArrays", {n});
+
+	GenNames (n, arrays);
+}
+
+void GLNullBackend::GenBuffers(GLsizei n,  GLuint * buffers)
+{
+	Record ("GenBuffers", {n});
+
+	GenNames (n, buffers);
+}
+
+void GLNullBackend::GenTextures(GLsizei n,  GLuint * textures)
+{
+	Record ("GenTextures", {n});
+
+	GenNames (n, textures);
+}
+
+void GLNullBackend::GenFramebuffers(GLsizei n,  GLuint * framebuffers)
+{
+	Record ("GenFramebuffers", {n});
+
+	GenNames (n, framebuffers);
+}
+
+void GLNullBackend::Uniform1f(GLint location,  GLfloat v0)
+{
+	Record ("Uniform1f", {location});
+}
+
+void GLNullBackend::Uniform2f(GLint location,  GLfloat v0,  GLfloat v1)
+{
+	Record ("Uniform2f", {location});
+}
+
+void GLNullBackend::Uniform3f(GLint location,  GLfloat v0,  GLfloat v1,  GLfloat v2)
+{
+	Record ("Uniform3f", {location});
+}
+
+void GLNullBackend::Uniform4f(GLint location,  GLfloat v0,  GLfloat v1,  GLfloat v2,  GLfloat v3)
+{
+	Record ("Uniform4f", {location});
+}
+
+void GLNullBackend::Uniform1i(GLint location,  GLint v0)
+{
+	Record ("Uniform1i", {location, v0});
+}
+
+void GLNullBackend::Uniform2i(GLint location,  GLint v0,  GLint v1)
+{
+	Record ("Uniform2i", {location, v0, v1});
+}
+
+void GLNullBackend::Uniform3i(GLint location,  GLint v0,  GLint v1,  GLint v2)
+{
+	Record ("Uniform3i", {location, v0, v1, v2});
+}
+
+void GLNullBackend::Uniform4i(GLint location,  GLint v0,  GLint v1,  GLint v2,  GLint v3)
+{
+	Record ("Uniform4i", {location, v0, v1, v2, v3});
+}
+
+void GLNullBackend::Uniform1ui(GLint location, GLuint v0)
+{
+	Record ("Uniform1ui", {location, v0});
+}
+
+void GLNullBackend::Uniform2ui(GLint location, GLuint v0, GLuint v1)
+{
+	Record ("Uniform2ui", {location, v0, v1});
+}
+
+void GLNullBackend::Uniform3ui(GLint location, GLuint v0, GLuint v1, GLuint v2)
+{
+	Record ("Uniform3ui", {location, v0, v1, v2});
+}
+
+void GLNullBackend::Uniform4ui(GLint location, GLuint v0, GLuint v1, GLuint v2, GLuint v3)
+{
+	Record ("Uniform4ui", {location, v0, v1, v2, v3});
+}
+
+void GLNullBackend::Uniform1fv(GLint location, GLsizei count, const GLfloat *value)
+{
+	Record ("Uniform1fv", {location, count});
+}
+
+void GLNullBackend::Uniform2fv(GLint location, GLsizei count, const GLfloat *value)
+{
+	Record ("Uniform2fv", {location, count});
+}
+
+void GLNullBackend::Uniform3fv(GLint location, GLsizei count, const GLfloat *value)
+{
+	Record ("Uniform3fv", {location, count});
+}
+
+void GLNullBackend::Uniform4fv(GLint location, GLsizei count, const GLfloat *value)
+{
+	Record ("Uniform4fv", {location, count});
+}
+
+void GLNullBackend::Uniform1iv(GLint location, GLsizei count, const GLint *value)
+{
+	Record ("Uniform1iv", {location, count});
+}
+
+void GLNullBackend::Uniform2iv(GLint location, GLsizei count, const GLint *value)
+{
+	Record ("Uniform2iv", {location, count});
+}
+
+void GLNullBackend::Uniform3iv(GLint location, GLsizei count, const GLint *value)
+{
+	Record ("Uniform3iv", {location, count});
+}
+
+void GLNullBackend::Uniform4iv(GLint location, GLsizei count, const GLint *value)
+{
+	Record ("Uniform4iv", {location, count});
+}
+
+void GLNullBackend::Uniform1uiv(GLint location, GLsizei count, const GLuint *value)
+{
+	Record ("Uniform1uiv", {location, count});
+}
+
+void GLNullBackend::Uniform2uiv(GLint location, GLsizei count, const GLuint *value)
+{
+	Record ("Uniform2uiv", {location, count});
+}
+
+void GLNullBackend::Uniform3uiv(GLint location, GLsizei count, const GLuint *value)
+{
+	Record ("Uniform3uiv", {location, count});
+}
+
+void GLNullBackend::Uniform4uiv(GLint location, GLsizei count, const GLuint *value)
+{
+	Record ("Uniform4uiv", {location, count});
+}
+
+void GLNullBackend::UniformMatrix2fv(GLint location, GLsizei count, GLboolean transpose, const GLfloat *value)
+{
+	Record ("UniformMatrix2fv", {location, count, transpose});
+}
+
+void GLNullBackend::UniformMatrix3fv(GLint location, GLsizei count, GLboolean transpose, const GLfloat *value)
+{
+	Record ("UniformMatrix3fv", {location, count, transpose});
+}
+
+void GLNullBackend::UniformMatrix4fv(GLint location, GLsizei count, GLboolean transpose, const GLfloat *value)
+{
+	Record ("UniformMatrix4fv", {location, count, transpose});
+}
+
+void GLNullBackend::UniformMatrix2x3fv(GLint location, GLsizei count, GLboolean transpose, const GLfloat *value)
+{
+	Record ("UniformMatrix2x3fv", {location, count, transpose});
+}
+
+void GLNullBackend::UniformMatrix3x2fv(GLint location, GLsizei count, GLboolean transpose, const GLfloat *value)
+{
+	Record ("UniformMatrix3x2fv", {location, count, transpose});
+}
+
+void GLNullBackend::UniformMatrix2x4fv(GLint location, GLsizei count, GLboolean transpose, const GLfloat *value)
+{
+	Record ("UniformMatrix2x4fv", {location, count, transpose});
+}
+
+void GLNullBackend::UniformMatrix4x2fv(GLint location, GLsizei count, GLboolean transpose, const GLfloat *value)
+{
+	Record ("UniformMatrix4x2fv", {location, count, transpose});
+}
+
+void GLNullBackend::UniformMatrix3x4fv(GLint location, GLsizei count, GLboolean transpose, const GLfloat *value)
+{
+	Record ("UniformMatrix3x4fv", {location, count, transpose});
+}
+
+void GLNullBackend::UniformMatrix4x3fv(GLint location, GLsizei count, GLboolean transpose, const GLfloat *value)
+{
+	Record ("UniformMatrix4x3fv", {location, count, transpose});
+}
+
+void GLNullBackend::MemoryBarrier (GLbitfield barriers)
+{
+	Record ("MemoryBarrier", {barriers});
+}
+
+void GLNullBackend::DebugMessageCallback (GLDEBUGPROC callback, const void* userParam)
+{
+	Record ("DebugMessageCallback", {});
+}
+
+void GLNullBackend::Enable (GLenum cap)
+{
+	Record ("Enable", {cap});
+
+	SetState (cap, true);
+}
+
+void GLNullBackend::Disable (GLenum cap)
+{
+	Record ("Disable", {cap});
+
+	SetState (cap, false);
+}
+
+GLboolean GLNullBackend::IsEnabled(GLenum cap)
+{
+	Record ("IsEnabled", {cap});
+
+	auto it = _capabilities.find (cap);
+
+	return it != _capabilities.end () && it->second ? GL_TRUE : GL_FALSE;
+}
+
+void GLNullBackend::BindTexture(GLenum target, GLuint texture)
+{
+	Record ("BindTexture", {target, texture});
+
+	Bind (target, _activeTexture - GL_TEXTURE0, texture);
+}
+
+void GLNullBackend::ActiveTexture(GLenum texture)
+{
+	Record ("ActiveTexture", {texture});
+
+	_frameStatistics.stateChangesCount ++;
+
+	if (_activeTexture == texture) {
+		_frameStatistics.redundantStateChangesCount ++;
+	}
+
+	_activeTexture = texture;
+}
+
+void GLNullBackend::TexImage2D(GLenum target,  GLint level,  GLint internalformat,  
+	GLsizei width,  GLsizei height,  GLint border,  GLenum format,  
+	GLenum type,  const GLvoid * data)
+{
+	Record ("TexImage2D", {target, level, internalformat, width, height, border, format, type});
+
+	if (data != nullptr) {
+		_frameStatistics.uploadedBytesCount += (std::size_t) width * height * GetPixelSize (format, type);
+	}
+}
+
+void GLNullBackend::TexImage3D(GLenum target, GLint level, GLint internalFormat, 
+	GLsizei width, GLsizei height, GLsizei depth, GLint border, 
+	GLenum format, GLenum type, const GLvoid * data)
+{
+	Record ("TexImage3D", {target, level, internalFormat, width, height, depth, border, format, type});
+
+	if (data != nullptr) {
+		_frameStatistics.uploadedBytesCount += (std::size_t) width * height * depth * GetPixelSize (format, type);
+	}
+}
+
+void GLNullBackend::TexStorage3D(GLenum target, GLsizei levels, GLenum internalFormat, 
+	GLsizei width, GLsizei height, GLsizei depth)
+{
+	Record ("TexStorage3D", {target, levels, internalFormat, width, height, depth});
+
+	/*
+	 * The levels that still hold whole pages can be committed by page,
+	 * the ones past them form the mip tail
+	*/
+
+	GLint sparseLevels = 0;
+
+	while (sparseLevels < levels &&
+		(width >> sparseLevels) % GL_NULL_BACKEND_PAGE_SIZE_X == 0 && (width >> sparseLevels) > 0 &&
+		(height >> sparseLevels) % GL_NULL_BACKEND_PAGE_SIZE_Y == 0 && (height >> sparseLevels) > 0 &&
+		(depth >> sparseLevels) % GL_NULL_BACKEND_PAGE_SIZE_Z == 0 && (depth >> sparseLevels) > 0) {
+		sparseLevels ++;
+	}
+
+	_sparseLevels [GetBoundTexture (target)] = sparseLevels;
+}
+
+void GLNullBackend::TexPageCommitment(GLenum target, GLint level, GLint xoffset, GLint yoffset, 
+	GLint zoffset, GLsizei width, GLsizei height, GLsizei depth, GLboolean commit)
+{
+	Record ("TexPageCommitment", {target, level, xoffset, yoffset, zoffset, width, height, depth, commit});
+}
+
+void GLNullBackend::ClearTexSubImage(GLuint texture, GLint level, GLint xoffset, GLint yoffset, 
+	GLint zoffset, GLsizei width, GLsizei height, GLsizei depth, GLenum format, 
+	GLenum type, const void * data)
+{
+	Record ("ClearTexSubImage", {texture, level, xoffset, yoffset, zoffset, width, height, depth, format, type});
+}
+
+void GLNullBackend::TexEnvi(GLenum target,  GLenum pname,  GLint param)
+{
+	Record ("TexEnvi", {target, pname, param});
+}
+
+void GLNullBackend::TexEnvf(GLenum target,  GLenum pname,  GLfloat param)
+{
+	Record ("TexEnvf", {target, pname});
+}
+
+void GLNullBackend::TexParameteri(GLenum target,  GLenum pname,  GLint param)
+{
+	Record ("TexParameteri", {target, pname, param});
+}
+
+void GLNullBackend::TexParameterf(GLenum target,  GLenum pname,  GLfloat param)
+{
+	Record ("TexParameterf", {target, pname});
+}
+
+void GLNullBackend::TexParameteriv(GLenum target, GLenum pname, const GLint * params)
+{
+	Record ("TexParameteriv", {target, pname});
+}
+
+void GLNullBackend::TexParameterfv(GLenum target, GLenum pname, const GLfloat * params)
+{
+	Record ("TexParameterfv", {target, pname});
+}
+
+void GLNullBackend::GenerateMipmap (GLenum target)
+{
+	Record ("GenerateMipmap", {target});
+}
+
+void GLNullBackend::GetTexParameteriv(GLenum target, GLenum pname, GLint * params)
+{
+	Record ("GetTexParameteriv", {target, pname});
+
+	*params = 0;
+
+	if (pname == GL_NUM_SPARSE_LEVELS_ARB && GLEW_ARB_sparse_texture) {
+		auto it = _sparseLevels.find (GetBoundTexture (target));
+
+		if (it != _sparseLevels.end ()) {
+			*params = it->second;
+		}
+	}
+}
+
+void GLNullBackend::GetInternalformativ(GLenum target, GLenum internalFormat, GLenum pname, 
+	GLsizei bufSize, GLint * params)
+{
+	Record ("GetInternalformativ", {target, internalFormat, pname, bufSize});
+
+	for (GLsizei index = 0; index < bufSize; index++) {
+		params [index] = 0;
+	}
+
+	if (bufSize < 1 || target != GL_TEXTURE_3D || !GLEW_ARB_sparse_texture) {
+		return;
+	}
+
+	switch (pname) {
+		case GL_NUM_VIRTUAL_PAGE_SIZES_ARB:
+			params [0] = 1;
+			break;
+		case GL_VIRTUAL_PAGE_SIZE_X_ARB:
+			params [0] = GL_NULL_BACKEND_PAGE_SIZE_X;
+			break;
+		case GL_VIRTUAL_PAGE_SIZE_Y_ARB:
+			params [0] = GL_NULL_BACKEND_PAGE_SIZE_Y;
+			break;
+		case GL_VIRTUAL_PAGE_SIZE_Z_ARB:
+			params [0] = GL_NULL_BACKEND_PAGE_SIZE_Z;
+			break;
+	}
+}
+
+void GLNullBackend::PixelStorei(GLenum pname, GLint param)
+{
+	Record ("PixelStorei", {pname, param});
+}
+
+void GLNullBackend::BindImageTexture (GLuint unit, GLuint texture, GLint level, GLboolean layered, GLint layer, GLenum access, GLenum format)
+{
+	Record ("BindImageTexture", {unit, texture, level, layered, layer, access, format});
+
+	Bind (GL_IMAGE_BINDING_NAME, unit, texture);
+}
+
+GLuint GLNullBackend::CreateShader (GLenum shaderType)
+{
+	GLuint shader = GenName ();
+
+	Record ("CreateShader", {shaderType, shader});
+
+	return shader;
+}
+
+void GLNullBackend::DeleteShader(GLuint shader)
+{
+	Record ("DeleteShader", {shader});
+}
+
+void GLNullBackend::ShaderSource (GLuint shader, GLsizei count, const GLchar **string, const GLint *length)
+{
+	Record ("ShaderSource", {shader, count});
+}
+
+void GLNullBackend::CompileShader(GLuint shader)
+{
+	Record ("CompileShader", {shader});
+}
+
+void GLNullBackend::GetShaderInfoLog(GLuint  shader,  GLsizei  maxLength,  GLsizei * length,  GLchar * infoLog)
+{
+	Record ("GetShaderInfoLog", {shader, maxLength});
+
+	if (length != nullptr) {
+		*length = 0;
+	}
+
+	if (maxLength > 0) {
+		infoLog [0] = '\0';
+	}
+}
+
+GLuint GLNullBackend::CreateProgram(void)
+{
+	GLuint program = GenName ();
+
+	Record ("CreateProgram", {program});
+
+	return program;
+}
+
+void GLNullBackend::DeleteProgram(GLuint program)
+{
+	Record ("DeleteProgram", {program});
+}
+
+void GLNullBackend::UseProgram (GLuint program)
+{
+	Record ("UseProgram", {program});
+
+	Bind (GL_CURRENT_PROGRAM, 0, program);
+}
+
+void GLNullBackend::LinkProgram(GLuint program)
+{
+	Record ("LinkProgram", {program});
+}
+
+void GLNullBackend::AttachShader(GLuint program, GLuint shader)
+{
+	Record ("AttachShader", {program, shader});
+}
+
+void GLNullBackend::DetachShader(GLuint program, GLuint shader)
+{
+	Record ("DetachShader", {program, shader});
+}
+
+GLint GLNullBackend::GetUniformLocation(GLuint program, const GLchar *name)
+{
+	auto key = std::make_pair (program, std::string (name));
+
+	auto it = _uniformLocations.find (key);
+
+	if (it == _uniformLocations.end ()) {
+		it = _uniformLocations.insert (std::make_pair (key, (GLint) _uniformLocations.size ())).first;
+	}
+
+	Record ("GetUniformLocation", {program, it->second});
+
+	return it->second;
+}
+
+GLuint GLNullBackend::GetUniformBlockIndex(GLuint program, const GLchar *uniformBlockName)
+{
+	auto key = std::make_pair (program, std::string (uniformBlockName));
+
+	auto it = _uniformLocations.find (key);
+
+	if (it == _uniformLocations.end ()) {
+		it = _uniformLocations.insert (std::make_pair (key, (GLint) _uniformLocations.size ())).first;
+	}
+
+	Record ("GetUniformBlockIndex", {program, it->second});
+
+	return (GLuint) it->second;
+}
+
+void GLNullBackend::UniformBlockBinding(GLuint program, GLuint uniformBlockIndex, GLuint uniformBlockBinding)
+{
+	Record ("UniformBlockBinding", {program, uniformBlockIndex, uniformBlockBinding});
+}
+
+void GLNullBackend::DispatchCompute(GLuint num_groups_x, GLuint num_groups_y, GLuint num_groups_z)
+{
+	Record ("DispatchCompute", {num_groups_x, num_groups_y, num_groups_z});
+
+	_frameStatistics.dispatchesCount ++;
+}
+
+void GLNullBackend::GetBooleanv(GLenum pname, GLboolean * params)
+{
+	Record ("GetBooleanv", {pname});
+
+	if (pname == GL_DEPTH_WRITEMASK) {
+		*params = _depthMask;
+		return;
+	}
+
+	auto it = _capabilities.find (pname);
+
+	*params = it != _capabilities.end () && it->second ? GL_TRUE : GL_FALSE;
+}
+
+void GLNullBackend::GetFixedv(GLenum pname, GLfixed * params)
+{
+	Record ("GetFixedv", {pname});
+
+	*params = 0;
+}
+
+void GLNullBackend::GetFloatv(GLenum pname, GLfloat * params)
+{
+	Record ("GetFloatv", {pname});
+
+	*params = 0;
+}
+
+void GLNullBackend::GetIntegerv(GLenum pname, GLint * params)
+{
+	Record ("GetIntegerv", {pname});
+
+	*params = 0;
+
+	if (pname == GL_MAX_SPARSE_3D_TEXTURE_SIZE_ARB && GLEW_ARB_sparse_texture) {
+		*params = GL_NULL_BACKEND_MAX_SPARSE_SIZE;
+	}
+}
+
+void GLNullBackend::DeleteVertexArrays(GLsizei n, const GLuint *arrays)
+{
+	Record ("DeleteVertexArrays", {n});
+
+	DeleteNames (n, arrays);
+}
+
+void GLNullBackend::DeleteBuffers (GLsizei n, const GLuint* buffers)
+{
+	Record ("DeleteBuffers", {n});
+
+	DeleteNames (n, buffers);
+}
+
+void GLNullBackend::DeleteFramebuffers(GLsizei n, const GLuint * framebuffers)
+{
+	Record ("DeleteFramebuffers", {n});
+
+	DeleteNames (n, framebuffers);
+}
+
+void GLNullBackend::DeleteTextures(GLsizei n, const GLuint * textures)
+{
+	Record ("DeleteTextures", {n});
+
+	DeleteNames (n, textures);
+
+	for (GLsizei index = 0; index < n; index++) {
+		_sparseLevels.erase (textures [index]);
+	}
+}
+
+GLenum GLNullBackend::GetError ()
+{
+	return GL_NO_ERROR;
+}
+
+/*
+ * The calls are counted by function in the order of their names, so the
+ * text does not depend on where the names are in memory
+*/
+
+void GLNullBackend::EndFrame ()
+{
+	if (_isRecording) {
+		_stream << "Frame " << _framesCount << "\n";
+
+		for (const GLCommand& command : _commands) {
+			_stream << command.name;
+
+			for (std::size_t index = 0; index < command.argsCount; index++) {
+				_stream << " " << command.args [index];
+			}
+
+			_stream << "\n";
+		}
+
+		_stream << "Statistics"
+			<< " calls " << _frameStatistics.callsCount
+			<< " draws " << _frameStatistics.drawsCount
+			<< " dispatches " << _frameStatistics.dispatchesCount
+			<< " binds " << _frameStatistics.bindsCount
+			<< " redundantBinds " << _frameStatistics.redundantBindsCount
+			<< " stateChanges " << _frameStatistics.stateChangesCount
+			<< " redundantStateChanges " << _frameStatistics.redundantStateChangesCount
+			<< " uploadedBytes " << _frameStatistics.uploadedBytesCount << "\n";
+
+		std::map<std::string, std::size_t> callsCounts;
+
+		for (const auto& callsCount : _callsCounts) {
+			callsCounts [callsCount.first] += callsCount.second;
+		}
+
+		for (const auto& callsCount : callsCounts) {
+			_stream << "Calls " << callsCount.first << " " << callsCount.second << "\n";
+		}
+
+		_stream.flush ();
+	}
+
+	_lastFrameStatistics = _frameStatistics;
+	_frameStatistics = GLFrameStatistics ();
+
+	_commands.clear ();
+	_callsCounts.clear ();
+
+	_framesCount ++;
+}
+
+void GLNullBackend::Record (const char* name, std::initializer_list<std::int64_t> args)
+{
+	_frameStatistics.callsCount ++;
+	_callsCounts [name] ++;
+
+	if (!_isRecording) {
+		return;
+	}
+
+	GLCommand command;
+
+	command.name = name;
+	command.argsCount = std::min (args.size (), (std::size_t) GL_NULL_BACKEND_ARGS_COUNT);
+
+	std::copy (args.begin (), args.begin () + command.argsCount, command.args);
+
+	_commands.push_back (command);
+}
+
+/*
+ * Bind points are kept by target and index, GL_INVALID_INDEX is the
+ * binding of a target without an index. The element array buffer is kept
+ * by the vertex array it is bound to instead. Nothing is bound at first.
+ * Binding GL_FRAMEBUFFER binds the draw and the read framebuffer, it is
+ * counted as the bind of the draw one.
+*/
+
+void GLNullBackend::Bind (GLenum target, GLuint index, GLuint name)
+{
+	_frameStatistics.bindsCount ++;
+
+	GLuint& boundName = _bindings [std::make_pair (target, index)];
+
+	if (boundName == name) {
+		_frameStatistics.redundantBindsCount ++;
+	}
+
+	boundName = name;
+}
+
+void GLNullBackend::SetState (GLenum cap, bool value)
+{
+	_frameStatistics.stateChangesCount ++;
+
+	bool& state = _capabilities [cap];
+
+	if (state == value) {
+		_frameStatistics.redundantStateChangesCount ++;
+	}
+
+	state = value;
+}
+
+GLuint GLNullBackend::GenName ()
+{
+	return ++ _lastName;
+}
+
+void GLNullBackend::GenNames (GLsizei n, GLuint* names)
+{
+	for (GLsizei index = 0; index < n; index++) {
+		names [index] = GenName ();
+	}
+}
+
+/*
+ * Names are not given again, the memory of the buffers is freed and
+ * whatever was bound goes back to 0
+*/
+
+void GLNullBackend::DeleteNames (GLsizei n, const GLuint* names)
+{
+	for (GLsizei index = 0; index < n; index++) {
+		if (names [index] == 0) {
+			continue;
+		}
+
+		_buffersSizes.erase (names [index]);
+		_buffersData.erase (names [index]);
+
+		for (auto& binding : _bindings) {
+			if (binding.second == names [index]) {
+				binding.second = 0;
+			}
+		}
+	}
+}
+
+GLuint GLNullBackend::GetBufferIndex (GLenum target) const
+{
+	if (target != GL_ELEMENT_ARRAY_BUFFER) {
+		return GL_INVALID_INDEX;
+	}
+
+	auto it = _bindings.find (std::make_pair (GL_VERTEX_ARRAY_BINDING, 0));
+
+	return it != _bindings.end () ? it->second : 0;
+}
+
+GLuint GLNullBackend::GetBoundBuffer (GLenum target) const
+{
+	auto it = _bindings.find (std::make_pair (target, GetBufferIndex (target)));
+
+	return it != _bindings.end () ? it->second : 0;
+}
+
+GLuint GLNullBackend::GetBoundTexture (GLenum target) const
+{
+	auto it = _bindings.find (std::make_pair (target, (GLuint) (_activeTexture - GL_TEXTURE0)));
+
+	return it != _bindings.end () ? it->second : 0;
+}
+
+/*
+ * Giving a buffer a new size drops its data, as a new data store does
+*/
+
+void GLNullBackend::SetBufferSize (GLenum target, GLsizeiptr size)
+{
+	GLuint buffer = GetBoundBuffer (target);
+
+	if (buffer == 0) {
+		return;
+	}
+
+	_buffersSizes [buffer] = size;
+	_buffersData.erase (buffer);
+}
+
+std::size_t GLNullBackend::GetPixelSize (GLenum format, GLenum type)
+{
+	switch (type) {
+		case GL_UNSIGNED_BYTE_3_3_2:
+		case GL_UNSIGNED_BYTE_2_3_3_REV:
+			return 1;
+		case GL_UNSIGNED_SHORT_5_6_5:
+		case GL_UNSIGNED_SHORT_5_6_5_REV:
+		case GL_UNSIGNED_SHORT_4_4_4_4:
+		case GL_UNSIGNED_SHORT_4_4_4_4_REV:
+		case GL_UNSIGNED_SHORT_5_5_5_1:
+		case GL_UNSIGNED_SHORT_1_5_5_5_REV:
+			return 2;
+		case GL_UNSIGNED_INT_8_8_8_8:
+		case GL_UNSIGNED_INT_8_8_8_8_REV:
+		case GL_UNSIGNED_INT_10_10_10_2:
+		case GL_UNSIGNED_INT_2_10_10_10_REV:
+		case GL_UNSIGNED_INT_24_8:
+		case GL_UNSIGNED_INT_10F_11F_11F_REV:
+		case GL_UNSIGNED_INT_5_9_9_9_REV:
+			return 4;
+	}
+
+	std::size_t componentsCount = 4;
+
+	switch (format) {
+		case GL_RED:
+		case GL_RED_INTEGER:
+		case GL_ALPHA:
+		case GL_LUMINANCE:
+		case GL_DEPTH_COMPONENT:
+		case GL_STENCIL_INDEX:
+			componentsCount = 1;
+			break;
+		case GL_RG:
+		case GL_RG_INTEGER:
+		case GL_LUMINANCE_ALPHA:
+			componentsCount = 2;
+			break;
+		case GL_RGB:
+		case GL_BGR:
+		case GL_RGB_INTEGER:
+			componentsCount = 3;
+			break;
+	}
+
+	std::size_t componentSize = 4;
+
+	switch (type) {
+		case GL_UNSIGNED_BYTE:
+		case GL_BYTE:
+			componentSize = 1;
+			break;
+		case GL_UNSIGNED_SHORT:
+		case GL_SHORT:
+		case GL_HALF_FLOAT:
+			componentSize = 2;
+			break;
+	}
+
+	return componentsCount * componentSize;
+}
\ No newline at end of file
@@ -0,0 +1,334 @@
+#include "GLStateCache.h"
+
+GLStateCacheStatistics::GLStateCacheStatistics () :
+	filteredBindsCount (0),
+	filteredStateChangesCount (0),
+	cachedQueriesCount (0)
+{
+
+}
+
+GLStateCache::GLStateCache () :
+	_isEnabled (true),
+	_bindings (),
+	_capabilities (),
+	_isDepthMaskKnown (false),
+	_depthMask (GL_TRUE),
+	_isActiveTextureKnown (false),
+	_activeTexture (GL_TEXTURE0),
+	_statistics ()
+{
+
+}
+
+/*
+ * A disabled cache lets every call through and keeps nothing
+*/
+
+void GLStateCache::SetEnabled (bool isEnabled)
+{
+	_isEnabled = isEnabled;
+
+	Clear ();
+}
+
+bool GLStateCache::IsEnabled () const
+{
+	return _isEnabled;
+}
+
+void GLStateCache::Clear ()
+{
+	_bindings.clear ();
+	_capabilities.clear ();
+
+	_isDepthMaskKnown = false;
+	_isActiveTextureKnown = false;
+}
+
+/*
+ * The Bind and set methods return whether the call has to go to the
+ * backend
+*/
+
+bool GLStateCache::BindVertexArray (GLuint array)
+{
+	if (!SetBinding (GL_VERTEX_ARRAY_BINDING, 0, array)) {
+		return false;
+	}
+
+	ForgetBinding (GL_ELEMENT_ARRAY_BUFFER, GL_INVALID_INDEX);
+
+	return true;
+}
+
+bool GLStateCache::BindBuffer (GLenum target, GLuint buffer)
+{
+	return SetBinding (target, GL_INVALID_INDEX, buffer);
+}
+
+/*
+ * Binding an index binds the target too, the call is filtered only when
+ * both are bound already
+*/
+
+bool GLStateCache::BindBufferBase (GLenum target, GLuint index, GLuint buffer)
+{
+	if (!_isEnabled) {
+		return true;
+	}
+
+	auto indexIt = _bindings.find (GetKey (target, index));
+	auto targetIt = _bindings.find (GetKey (target, GL_INVALID_INDEX));
+
+	if (indexIt != _bindings.end () && indexIt->second == buffer &&
+		targetIt != _bindings.end () && targetIt->second == buffer) {
+		_statistics.filteredBindsCount ++;
+
+		return false;
+	}
+
+	_bindings [GetKey (target, index)] = buffer;
+	_bindings [GetKey (target, GL_INVALID_INDEX)] = buffer;
+
+	return true;
+}
+
+/*
+ * A range bind always goes through. Only the target binding it leaves is
+ * kept, the index is forgotten so that a later base bind is not filtered.
+*/
+
+void GLStateCache::BindBufferRange (GLenum target, GLuint index, GLuint buffer)
+{
+	if (!_isEnabled) {
+		return;
+	}
+
+	ForgetBinding (target, index);
+
+	_bindings [GetKey (target, GL_INVALID_INDEX)] = buffer;
+}
+
+/*
+ * GL_FRAMEBUFFER is both the draw and the read framebuffer
+*/
+
+bool GLStateCache::BindFramebuffer (GLenum target, GLuint framebuffer)
+{
+	if (target != GL_FRAMEBUFFER) {
+		return SetBinding (target, 0, framebuffer);
+	}
+
+	if (!_isEnabled) {
+		return true;
+	}
+
+	auto drawIt = _bindings.find (GetKey (GL_DRAW_FRAMEBUFFER, 0));
+	auto readIt = _bindings.find (GetKey (GL_READ_FRAMEBUFFER, 0));
+
+	if (drawIt != _bindings.end () && drawIt->second == framebuffer &&
+		readIt != _bindings.end () && readIt->second == framebuffer) {
+		_statistics.filteredBindsCount ++;
+
+		return false;
+	}
+
+	_bindings [GetKey (GL_DRAW_FRAMEBUFFER, 0)] = framebuffer;
+	_bindings [GetKey (GL_READ_FRAMEBUFFER, 0)] = framebuffer;
+
+	return true;
+}
+
+/*
+ * Textures are bound to the active unit, with no known unit the call
+ * goes through and nothing is kept
+*/
+
+bool GLStateCache::BindTexture (GLenum target, GLuint texture)
+{
+	if (!_isActiveTextureKnown) {
+		return true;
+	}
+
+	return SetBinding (target, _activeTexture - GL_TEXTURE0, texture);
+}
+
+bool GLStateCache::UseProgram (GLuint program)
+{
+	return SetBinding (GL_CURRENT_PROGRAM, 0, program);
+}
+
+bool GLStateCache::ActiveTexture (GLenum texture)
+{
+	if (!_isEnabled) {
+		return true;
+	}
+
+	if (_isActiveTextureKnown && _activeTexture == texture) {
+		_statistics.filteredStateChangesCount ++;
+
+		return false;
+	}
+
+	_isActiveTextureKnown = true;
+	_activeTexture = texture;
+
+	return true;
+}
+
+bool GLStateCache::DepthMask (GLboolean flag)
+{
+	if (!_isEnabled) {
+		return true;
+	}
+
+	if (_isDepthMaskKnown && _depthMask == flag) {
+		_statistics.filteredStateChangesCount ++;
+
+		return false;
+	}
+
+	StoreDepthMask (flag);
+
+	return true;
+}
+
+bool GLStateCache::SetCapability (GLenum cap, bool isEnabled)
+{
+	if (!_isEnabled) {
+		return true;
+	}
+
+	auto it = _capabilities.find (cap);
+
+	if (it != _capabilities.end () && it->second == isEnabled) {
+		_statistics.filteredStateChangesCount ++;
+
+		return false;
+	}
+
+	_capabilities [cap] = isEnabled;
+
+	return true;
+}
+
+/*
+ * The getters return whether the state is known
+*/
+
+bool GLStateCache::GetCapability (GLenum cap, bool& isEnabled)
+{
+	if (!_isEnabled) {
+		return false;
+	}
+
+	auto it = _capabilities.find (cap);
+
+	if (it == _capabilities.end ()) {
+		return false;
+	}
+
+	isEnabled = it->second;
+
+	_statistics.cachedQueriesCount ++;
+
+	return true;
+}
+
+bool GLStateCache::GetDepthMask (GLboolean& flag)
+{
+	if (!_isEnabled || !_isDepthMaskKnown) {
+		return false;
+	}
+
+	flag = _depthMask;
+
+	_statistics.cachedQueriesCount ++;
+
+	return true;
+}
+
+void GLStateCache::StoreCapability (GLenum cap, bool isEnabled)
+{
+	if (!_isEnabled) {
+		return;
+	}
+
+	_capabilities [cap] = isEnabled;
+}
+
+void GLStateCache::StoreDepthMask (GLboolean flag)
+{
+	if (!_isEnabled) {
+		return;
+	}
+
+	_isDepthMaskKnown = true;
+	_depthMask = flag;
+}
+
+/*
+ * Names of different kinds of objects may be the same, all the bindings
+ * of the name are forgotten
+*/
+
+void GLStateCache::DeleteNames (GLsizei n, const GLuint* names)
+{
+	for (GLsizei index = 0; index < n; index++) {
+		if (names [index] == 0) {
+			continue;
+		}
+
+		for (auto it = _bindings.begin (); it != _bindings.end ();) {
+			if (it->second == names [index]) {
+				it = _bindings.erase (it);
+			} else {
+				++ it;
+			}
+		}
+	}
+}
+
+void GLStateCache::DeleteVertexArrays (GLsizei n, const GLuint* arrays)
+{
+	DeleteNames (n, arrays);
+
+	ForgetBinding (GL_ELEMENT_ARRAY_BUFFER, GL_INVALID_INDEX);
+}
+
+const GLStateCacheStatistics& GLStateCache::GetStatistics () const
+{
+	return _statistics;
+}
+
+bool GLStateCache::SetBinding (GLenum target, GLuint index, GLuint name)
+{
+	if (!_isEnabled) {
+		return true;
+	}
+
+	auto result = _bindings.insert (std::make_pair (GetKey (target, index), name));
+
+	if (!result.second) {
+		if (result.first->second == name) {
+			_statistics.filteredBindsCount ++;
+
+			return false;
+		}
+
+		result.first->second = name;
+	}
+
+	return true;
+}
+
+void GLStateCache::ForgetBinding (GLenum target, GLuint index)
+{
+	_bindings.erase (GetKey (target, index));
+}
+
+std::uint64_t GLStateCache::GetKey (GLenum target, GLuint index)
+{
+	return ((std::uint64_t) target << 32) | index;
+}
\ No newline at end of file
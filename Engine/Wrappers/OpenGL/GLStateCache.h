@@ -0,0 +1,85 @@
+#ifndef GLSTATECACHE_H
+#define GLSTATECACHE_H
+
+#include <GL/glew.h>
+
+#include <unordered_map>
+#include <cstdint>
+
+/*
+ * Counts of the calls the cache kept from the backend. A bind or a state change that
+ * sets what is already set is filtered, a query of known state is
+ * answered from the cache.
+*/
+
+struct GLStateCacheStatistics
+{
+	std::size_t filteredBindsCount;
+	std::size_t filteredStateChangesCount;
+	std::size_t cachedQueriesCount;
+
+	GLStateCacheStatistics ();
+};
+
+/*
+ * Shadow of the GL state the wrapper sets. Nothing is known at first,
+ * the first call of every kind goes to the backend and its value is kept
+ * from then on. Whatever the cache cannot follow exactly is forgotten
+ * instead, so the worst it does is let a redundant call through.
+ *
+ * Bindings are kept by target and index, GL_INVALID_INDEX is the binding
+ * of a target without an index. The element array buffer belongs to the
+ * vertex array, it is forgotten when another vertex array is bound.
+ * Deleting an object forgets every binding of its name.
+*/
+
+class GLStateCache
+{
+protected:
+	bool _isEnabled;
+	std::unordered_map<std::uint64_t, GLuint> _bindings;
+	std::unordered_map<GLenum, bool> _capabilities;
+	bool _isDepthMaskKnown;
+	GLboolean _depthMask;
+	bool _isActiveTextureKnown;
+	GLenum _activeTexture;
+	GLStateCacheStatistics _statistics;
+
+public:
+	GLStateCache ();
+
+	void SetEnabled (bool isEnabled);
+	bool IsEnabled () const;
+
+	void Clear ();
+
+	bool BindVertexArray (GLuint array);
+	bool BindBuffer (GLenum target, GLuint buffer);
+	bool BindBufferBase (GLenum target, GLuint index, GLuint buffer);
+	void BindBufferRange (GLenum target, GLuint index, GLuint buffer);
+	bool BindFramebuffer (GLenum target, GLuint framebuffer);
+	bool BindTexture (GLenum target, GLuint texture);
+	bool UseProgram (GLuint program);
+
+	bool ActiveTexture (GLenum texture);
+	bool DepthMask (GLboolean flag);
+	bool SetCapability (GLenum cap, bool isEnabled);
+
+	bool GetCapability (GLenum cap, bool& isEnabled);
+	bool GetDepthMask (GLboolean& flag);
+
+	void StoreCapability (GLenum cap, bool isEnabled);
+	void StoreDepthMask (GLboolean flag);
+
+	void DeleteNames (GLsizei n, const GLuint* names);
+	void DeleteVertexArrays (GLsizei n, const GLuint* arrays);
+
+	const GLStateCacheStatistics& GetStatistics () const;
+private:
+	bool SetBinding (GLenum target, GLuint index, GLuint name);
+	void ForgetBinding (GLenum target, GLuint index);
+
+	static std::uint64_t GetKey (GLenum target, GLuint index);
+};
+
+#endif
\ No newline at end of file
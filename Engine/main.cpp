@@ -1,11 +1,38 @@
+#include <thread>
+#include <algorithm>
+
 #include "Main/GameEngine.h"
 #include "Main/Game.h"
 #include "Arguments/ArgumentsAnalyzer.h"
+#include "Resources/MeshCacheBaker.h"
+#include "Utils/Threads/JobSystem.h"
+#include "Core/Console/Console.h"
 
 int main(int argc, char **argv) 
 {
 	ArgumentsAnalyzer::Instance ()->ProcessArguments (argc, argv);
 
+	/*
+	 * Bake the mesh caches of the start scene and quit, no window needed
+	*/
+
+	if (ArgumentsAnalyzer::Instance ()->GetArgument ("bake") != nullptr) {
+		Argument* arg = ArgumentsAnalyzer::Instance ()->GetArgument ("startscene");
+
+		if (arg == nullptr) {
+			Console::LogError ("There is no scene to bake!");
+			return 1;
+		}
+
+		JobSystem::Instance ()->Start (std::max (std::thread::hardware_concurrency (), 2u) - 1);
+
+		MeshCacheBaker::BakeScene (arg->GetArgs () [0]);
+
+		JobSystem::Instance ()->Stop ();
+
+		return 0;
+	}
+
 	GameEngine::Init ();
 	
 	Game::Instance ()->Start ();
@@ -0,0 +1,137 @@
+#include "Utils/Allocators/ArenaAllocator.h"
+
+#include "TestCheck.h"
+
+/*
+ * Ranges handed out by the arena of the static geometry, in elements
+*/
+
+static void TestAllocate ()
+{
+	ArenaAllocator allocator (100);
+
+	CHECK (allocator.GetCapacity () == 100);
+	CHECK (allocator.GetUsedSize () == 0);
+	CHECK (allocator.GetFreeBlocksCount () == 1);
+
+	CHECK (allocator.Allocate (0) == ARENA_ALLOCATOR_INVALID_OFFSET);
+	CHECK (allocator.Allocate (101) == ARENA_ALLOCATOR_INVALID_OFFSET);
+
+	std::size_t first = allocator.Allocate (10);
+	std::size_t second = allocator.Allocate (20);
+	std::size_t third = allocator.Allocate (30);
+
+	CHECK (first == 0);
+	CHECK (second == 10);
+	CHECK (third == 30);
+	CHECK (allocator.GetUsedSize () == 60);
+	CHECK (allocator.GetLargestFreeBlock () == 40);
+
+	/*
+	 * A freed range is reused by the first allocation that fits in it
+	*/
+
+	CHECK (allocator.Free (second));
+	CHECK (!allocator.Free (second));
+	CHECK (!allocator.Free (5));
+
+	CHECK (allocator.GetFreeBlocksCount () == 2);
+	CHECK (allocator.Allocate (15) == 10);
+	CHECK (allocator.Allocate (5) == 25);
+	CHECK (allocator.GetFreeBlocksCount () == 1);
+
+	/*
+	 * Free ranges next to each other are merged back
+	*/
+
+	CHECK (allocator.Free (10));
+	CHECK (allocator.Free (25));
+	CHECK (allocator.Free (first));
+	CHECK (allocator.Free (third));
+
+	CHECK (allocator.GetUsedSize () == 0);
+	CHECK (allocator.GetFreeBlocksCount () == 1);
+	CHECK (allocator.GetLargestFreeBlock () == 100);
+}
+
+static void TestAlignment ()
+{
+	ArenaAllocator allocator (100);
+
+	CHECK (allocator.Allocate (3) == 0);
+	CHECK (allocator.Allocate (4, 0) == ARENA_ALLOCATOR_INVALID_OFFSET);
+
+	/*
+	 * The space skipped to align a range stays free and is used by
+	 * the next range that fits in it
+	*/
+
+	std::size_t aligned = allocator.Allocate (10, 16);
+
+	CHECK (aligned == 16);
+	CHECK (allocator.GetUsedSize () == 13);
+	CHECK (allocator.GetFreeBlocksCount () == 2);
+
+	CHECK (allocator.Allocate (13) == 3);
+	CHECK (allocator.GetFreeBlocksCount () == 1);
+
+	CHECK (allocator.Allocate (8, 8) == 32);
+	CHECK (allocator.Allocate (1, 64) == 64);
+	CHECK (allocator.Allocate (1, 128) == ARENA_ALLOCATOR_INVALID_OFFSET);
+
+	/*
+	 * Freeing an aligned range merges it with its padding
+	*/
+
+	CHECK (allocator.Free (aligned));
+	CHECK (allocator.Allocate (10, 16) == 16);
+}
+
+static void TestClearAndGrow ()
+{
+	ArenaAllocator allocator;
+
+	CHECK (allocator.Allocate (1) == ARENA_ALLOCATOR_INVALID_OFFSET);
+
+	allocator.Grow (50);
+
+	CHECK (allocator.Allocate (30) == 0);
+	CHECK (allocator.Allocate (30) == ARENA_ALLOCATOR_INVALID_OFFSET);
+
+	/*
+	 * Grown space is added at the end, ranges keep their offsets
+	*/
+
+	allocator.Grow (40);
+
+	CHECK (allocator.GetCapacity () == 50);
+
+	allocator.Grow (100);
+
+	CHECK (allocator.GetCapacity () == 100);
+	CHECK (allocator.GetFreeBlocksCount () == 1);
+	CHECK (allocator.Allocate (30) == 30);
+	CHECK (allocator.Allocate (40) == 60);
+
+	/*
+	 * Reset drops every range but keeps the capacity
+	*/
+
+	allocator.Clear ();
+
+	CHECK (allocator.GetCapacity () == 100);
+	CHECK (allocator.GetUsedSize () == 0);
+	CHECK (allocator.GetFreeBlocksCount () == 1);
+	CHECK (allocator.GetLargestFreeBlock () == 100);
+	CHECK (!allocator.Free (30));
+	CHECK (allocator.Allocate (100) == 0);
+}
+
+int main ()
+{
+	TestAllocate ();
+	TestAlignment ();
+	TestClearAndGrow ();
+
+	return TestResult ("ArenaAllocator");
+}
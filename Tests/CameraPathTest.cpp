@@ -0,0 +1,288 @@
+#include <vector>
+#include <fstream>
+#include <cstdio>
+#include <cmath>
+
+#include "Debug/Benchmark/CameraPath.h"
+#include "Debug/Benchmark/Benchmark.h"
+
+#include "TestCheck.h"
+
+/*
+ * The path of a benchmark has to be sampled the same way on every run,
+ * and the hash of the counters has to tell two runs apart as soon as one
+ * counter of one frame differs.
+*/
+
+#define TEST_PATH_FILENAME "./CameraPathTest.path"
+#define TEST_EPSILON 0.0001f
+#define TEST_STEP 0.001f
+#define TEST_FRAMES_COUNT 8
+
+static bool IsNear (const glm::vec3& first, const glm::vec3& second, float epsilon)
+{
+	return glm::all (glm::lessThanEqual (glm::abs (first - second), glm::vec3 (epsilon)));
+}
+
+/*
+ * A quaternion and its opposite are the same rotation
+*/
+
+static bool IsSameRotation (const glm::quat& first, const glm::quat& second)
+{
+	return std::fabs (glm::dot (first, second)) > 1.0f - TEST_EPSILON;
+}
+
+static CameraPath BuildPath (std::vector<CameraPathPoint>& points)
+{
+	points.clear ();
+
+	points.push_back ({ 1.0f, glm::vec3 (0.0f, 2.0f, 0.0f), glm::quat (glm::vec3 (0.0f)) });
+	points.push_back ({ 2.5f, glm::vec3 (4.0f, 2.0f, -3.0f), glm::quat (glm::vec3 (0.0f, 1.0f, 0.0f)) });
+	points.push_back ({ 3.0f, glm::vec3 (5.0f, 3.0f, -6.0f), glm::quat (glm::vec3 (0.2f, 2.0f, 0.0f)) });
+	points.push_back ({ 5.0f, glm::vec3 (-2.0f, 1.0f, -8.0f), glm::quat (glm::vec3 (0.0f, 3.0f, 0.1f)) });
+	points.push_back ({ 6.0f, glm::vec3 (-6.0f, 2.0f, -2.0f), glm::quat (glm::vec3 (0.0f, 0.5f, 0.0f)) });
+
+	/*
+	 * Added out of order, the path sorts them
+	*/
+
+	CameraPath path;
+
+	for (std::size_t index = points.size (); index > 0; index--) {
+		const CameraPathPoint& point = points [index - 1];
+
+		path.AddPoint (point.time, point.position, point.rotation);
+	}
+
+	return path;
+}
+
+static void TestKeys ()
+{
+	std::vector<CameraPathPoint> points;
+	CameraPath path = BuildPath (points);
+
+	CHECK (path.GetPointsCount () == points.size ());
+	CHECK (std::fabs (path.GetDuration () - 5.0f) < TEST_EPSILON);
+
+	for (const CameraPathPoint& point : points) {
+		CHECK (IsNear (path.GetPosition (point.time), point.position, TEST_EPSILON));
+		CHECK (IsSameRotation (path.GetRotation (point.time), point.rotation));
+	}
+
+	/*
+	 * Before the first key and after the last one the camera stays on
+	 * them
+	*/
+
+	const CameraPathPoint& first = points.front ();
+	const CameraPathPoint& last = points.back ();
+
+	for (float time : { -100.0f, 0.0f, first.time - TEST_STEP }) {
+		CHECK (IsNear (path.GetPosition (time), first.position, TEST_EPSILON));
+		CHECK (IsSameRotation (path.GetRotation (time), first.rotation));
+	}
+
+	for (float time : { last.time + TEST_STEP, 10.0f, 1000.0f }) {
+		CHECK (IsNear (path.GetPosition (time), last.position, TEST_EPSILON));
+		CHECK (IsSameRotation (path.GetRotation (time), last.rotation));
+	}
+
+	/*
+	 * An empty path keeps the camera at the origin
+	*/
+
+	CameraPath emptyPath;
+
+	CHECK (emptyPath.GetDuration () == 0.0f);
+	CHECK (IsNear (emptyPath.GetPosition (1.0f), glm::vec3 (0.0f), 0.0f));
+}
+
+/*
+ * No step of the samples jumps further than the camera moves in it, on
+ * both sides of every key too
+*/
+
+static void TestContinuity ()
+{
+	std::vector<CameraPathPoint> points;
+	CameraPath path = BuildPath (points);
+
+	float maxStep = 0.05f;
+
+	glm::vec3 lastPosition = path.GetPosition (0.0f);
+	glm::quat lastRotation = path.GetRotation (0.0f);
+
+	bool isContinuous = true;
+
+	for (float time = 0.0f; time < 7.0f; time += TEST_STEP) {
+		glm::vec3 position = path.GetPosition (time);
+		glm::quat rotation = path.GetRotation (time);
+
+		if (!IsNear (position, lastPosition, maxStep) ||
+			std::fabs (glm::dot (rotation, lastRotation)) < 1.0f - maxStep) {
+			std::printf ("Path jumps at %f\n", time);
+			isContinuous = false;
+		}
+
+		lastPosition = position;
+		lastRotation = rotation;
+	}
+
+	CHECK (isContinuous);
+
+	for (const CameraPathPoint& point : points) {
+		glm::vec3 before = path.GetPosition (point.time - TEST_STEP);
+		glm::vec3 after = path.GetPosition (point.time + TEST_STEP);
+
+		CHECK (IsNear (before, point.position, maxStep));
+		CHECK (IsNear (after, point.position, maxStep));
+		CHECK (IsSameRotation (path.GetRotation (point.time - TEST_EPSILON), path.GetRotation (point.time + TEST_EPSILON)));
+	}
+}
+
+static void TestLoad ()
+{
+	std::ofstream stream (TEST_PATH_FILENAME);
+
+	stream << "<CameraPath>\n"
+		<< "\t<Point time=\"2\">\n"
+		<< "\t\t<Position x=\"4\" y=\"2\" z=\"-3\" />\n"
+		<< "\t\t<Rotation x=\"0\" y=\"90\" z=\"0\" />\n"
+		<< "\t</Point>\n"
+		<< "\t<Point time=\"0\">\n"
+		<< "\t\t<Position x=\"0\" y=\"2\" z=\"0\" />\n"
+		<< "\t</Point>\n"
+		<< "</CameraPath>\n";
+
+	stream.close ();
+
+	CameraPath path;
+
+	CHECK (path.Load (TEST_PATH_FILENAME));
+	CHECK (path.GetPointsCount () == 2);
+	CHECK (std::fabs (path.GetDuration () - 2.0f) < TEST_EPSILON);
+	CHECK (IsNear (path.GetPosition (0.0f), glm::vec3 (0.0f, 2.0f, 0.0f), TEST_EPSILON));
+	CHECK (IsNear (path.GetPosition (2.0f), glm::vec3 (4.0f, 2.0f, -3.0f), TEST_EPSILON));
+	CHECK (IsSameRotation (path.GetRotation (2.0f), glm::quat (glm::vec3 (0.0f, glm::radians (90.0f), 0.0f))));
+
+	std::remove (TEST_PATH_FILENAME);
+
+	CHECK (!path.Load (TEST_PATH_FILENAME));
+}
+
+/*
+ * Counters of a run that differ from frame to frame
+*/
+
+static BenchmarkCounters GetFrameCounters (std::size_t frame)
+{
+	BenchmarkCounters counters;
+
+	counters.drawnObjectsCount = 100 + frame;
+	counters.packetsCount = 40 + frame;
+	counters.drawsCount = 120 + 2 * frame;
+	counters.shaderChangesCount = 5;
+	counters.materialChangesCount = 12 + frame % 3;
+	counters.vertexArrayChangesCount = 7;
+	counters.transformChangesCount = 100 + frame;
+	counters.indirectCommandsCount = 64;
+	counters.callsCount = 900 + frame;
+	counters.bindsCount = 300 + frame;
+	counters.redundantBindsCount = frame % 2;
+	counters.stateChangesCount = 30;
+	counters.uploadedBytesCount = 65536 + 128 * frame;
+
+	return counters;
+}
+
+static std::uint64_t HashRun (const std::vector<BenchmarkCounters>& frames, const CameraPath& path)
+{
+	std::uint64_t hash = BENCHMARK_HASH_OFFSET;
+
+	for (std::size_t frame = 0; frame < frames.size (); frame++) {
+		std::uint64_t timeMS = frame * BENCHMARK_DELTA_TIME_MS;
+		float time = timeMS / 1000.0f;
+
+		hash = Benchmark::HashFrame (hash, frame, timeMS, frames [frame],
+			path.GetPosition (time), path.GetRotation (time));
+	}
+
+	return hash;
+}
+
+static void TestCountersHash ()
+{
+	std::vector<CameraPathPoint> points;
+	CameraPath path = BuildPath (points);
+
+	std::vector<BenchmarkCounters> frames;
+
+	for (std::size_t frame = 0; frame < TEST_FRAMES_COUNT; frame++) {
+		frames.push_back (GetFrameCounters (frame));
+	}
+
+	std::uint64_t hash = HashRun (frames, path);
+
+	CHECK (hash != BENCHMARK_HASH_OFFSET);
+	CHECK (HashRun (frames, path) == hash);
+
+	/*
+	 * Any counter of any frame that changes by one changes the hash
+	*/
+
+	std::uint64_t BenchmarkCounters::* counterFields [] = {
+		&BenchmarkCounters::drawnObjectsCount,
+		&BenchmarkCounters::packetsCount,
+		&BenchmarkCounters::drawsCount,
+		&BenchmarkCounters::shaderChangesCount,
+		&BenchmarkCounters::materialChangesCount,
+		&BenchmarkCounters::vertexArrayChangesCount,
+		&BenchmarkCounters::transformChangesCount,
+		&BenchmarkCounters::indirectCommandsCount,
+		&BenchmarkCounters::callsCount,
+		&BenchmarkCounters::bindsCount,
+		&BenchmarkCounters::redundantBindsCount,
+		&BenchmarkCounters::stateChangesCount,
+		&BenchmarkCounters::uploadedBytesCount
+	};
+
+	for (std::uint64_t BenchmarkCounters::* counterField : counterFields) {
+		for (std::size_t frame : { (std::size_t) 0, (std::size_t) TEST_FRAMES_COUNT / 2, (std::size_t) TEST_FRAMES_COUNT - 1 }) {
+			std::vector<BenchmarkCounters> changedFrames (frames);
+
+			changedFrames [frame].*counterField += 1;
+
+			CHECK (HashRun (changedFrames, path) != hash);
+		}
+	}
+
+	/*
+	 * The same frames in another order, or with the camera elsewhere,
+	 * are another run
+	*/
+
+	std::vector<BenchmarkCounters> swappedFrames (frames);
+	std::swap (swappedFrames [1], swappedFrames [2]);
+
+	CHECK (HashRun (swappedFrames, path) != hash);
+
+	CameraPath movedPath;
+
+	for (const CameraPathPoint& point : points) {
+		movedPath.AddPoint (point.time, point.position + glm::vec3 (0.0f, 0.01f, 0.0f), point.rotation);
+	}
+
+	CHECK (HashRun (frames, movedPath) != hash);
+}
+
+int main ()
+{
+	TestKeys ();
+	TestContinuity ();
+	TestLoad ();
+	TestCountersHash ();
+
+	return TestResult ("CameraPath");
+}
@@ -0,0 +1,143 @@
+#include <vector>
+#include <random>
+#include <cmath>
+
+#include "Core/Intersections/FrustumCulling.h"
+
+#include "TestCheck.h"
+
+/*
+ * Every culling path against a scalar reference in double precision, on
+ * random boxes and frustums. Boxes closer to a plane than the float
+ * error can be on either side and are not compared.
+*/
+
+#define TEST_FRUSTUMS_COUNT 200
+#define TEST_BOXES_COUNT 301
+#define TEST_EPSILON 1e-3
+
+struct ReferenceVisibility
+{
+	bool isVisible;
+	bool isAmbiguous;
+};
+
+static ReferenceVisibility CheckReference (const FrustumVolume::FrustumVolumeInformation& frustum,
+	std::uint8_t planeMask, const AABBBatch& boxes, std::size_t index)
+{
+	ReferenceVisibility visibility = { true, false };
+
+	for (std::size_t planeIndex = 0; planeIndex < FrustumVolume::FrustumVolumeInformation::PLANESCOUNT; planeIndex++) {
+		if ((planeMask & (1 << planeIndex)) == 0) {
+			continue;
+		}
+
+		const glm::vec4& plane = frustum.plane [planeIndex];
+
+		double x = plane.x < 0 ? boxes.minX [index] : boxes.maxX [index];
+		double y = plane.y < 0 ? boxes.minY [index] : boxes.maxY [index];
+		double z = plane.z < 0 ? boxes.minZ [index] : boxes.maxZ [index];
+
+		double distance = (double) plane.x * x + (double) plane.y * y + (double) plane.z * z + (double) plane.w;
+
+		visibility.isAmbiguous |= std::fabs (distance) < TEST_EPSILON;
+		visibility.isVisible &= distance >= 0.0;
+	}
+
+	return visibility;
+}
+
+static void TestISA (FrustumCullingISA isa)
+{
+	if (!FrustumCulling::SetISA (isa)) {
+		std::printf ("%s is not supported, skipped\n", FrustumCulling::GetISAName (isa).c_str ());
+		return;
+	}
+
+	CHECK (FrustumCulling::GetISA () == isa);
+
+	std::mt19937 generator (12);
+	std::uniform_real_distribution<float> position (-10.0f, 10.0f);
+	std::uniform_real_distribution<float> extent (0.0f, 3.0f);
+	std::uniform_real_distribution<float> direction (-1.0f, 1.0f);
+	std::uniform_int_distribution<int> offset (0, 40);
+
+	AABBBatch boxes;
+	boxes.Resize (TEST_BOXES_COUNT);
+
+	for (std::size_t index = 0; index < TEST_BOXES_COUNT; index++) {
+		glm::vec3 center (position (generator), position (generator), position (generator));
+		glm::vec3 halfSize (extent (generator), extent (generator), extent (generator));
+
+		boxes.Set (index, center - halfSize, center + halfSize);
+	}
+
+	std::size_t mismatchesCount = 0;
+	std::size_t visibleCount = 0;
+
+	for (std::size_t frustumIndex = 0; frustumIndex < TEST_FRUSTUMS_COUNT; frustumIndex++) {
+		FrustumVolume::FrustumVolumeInformation frustum;
+
+		for (std::size_t planeIndex = 0; planeIndex < FrustumVolume::FrustumVolumeInformation::PLANESCOUNT; planeIndex++) {
+			glm::vec3 normal = glm::normalize (glm::vec3 (direction (generator), direction (generator), direction (generator)));
+
+			frustum.plane [planeIndex] = glm::vec4 (normal, position (generator));
+		}
+
+		/*
+		 * Ranges that do not start or end on a vector width
+		*/
+
+		std::uint8_t planeMask = frustumIndex % 8 == 0 ? 0 : (std::uint8_t) (generator () & 0x3F);
+		std::size_t first = offset (generator);
+		std::size_t count = TEST_BOXES_COUNT - first - offset (generator);
+
+		std::vector<std::uint32_t> visibilityMask ((count + 31) / 32, 0xFFFFFFFF);
+
+		FrustumCulling::CheckFrustumVsAABBs (&frustum, planeMask, boxes, first, count, visibilityMask.data ());
+
+		for (std::size_t index = 0; index < count; index++) {
+			bool isVisible = (visibilityMask [index / 32] & (1u << (index % 32))) != 0;
+
+			ReferenceVisibility reference = CheckReference (frustum, planeMask, boxes, first + index);
+
+			if (!reference.isAmbiguous && isVisible != reference.isVisible) {
+				mismatchesCount ++;
+			}
+
+			visibleCount += isVisible ? 1 : 0;
+		}
+
+		/*
+		 * The bits past the range are cleared
+		*/
+
+		if (count % 32 != 0) {
+			CHECK ((visibilityMask.back () >> (count % 32)) == 0);
+		}
+
+		if (planeMask == 0) {
+			for (std::size_t index = 0; index < count; index++) {
+				CHECK ((visibilityMask [index / 32] & (1u << (index % 32))) != 0);
+			}
+		}
+	}
+
+	CHECK (mismatchesCount == 0);
+	CHECK (visibleCount > 0);
+}
+
+int main ()
+{
+	FrustumCullingISA defaultISA = FrustumCulling::GetISA ();
+
+	CHECK (FrustumCulling::IsISASupported (FrustumCullingISA::SCALAR));
+
+	TestISA (FrustumCullingISA::SCALAR);
+	TestISA (FrustumCullingISA::SSE);
+	TestISA (FrustumCullingISA::AVX2);
+
+	CHECK (FrustumCulling::SetISA (defaultISA));
+
+	return TestResult ("FrustumCulling");
+}
@@ -0,0 +1,293 @@
+#include <map>
+#include <vector>
+
+#include "Wrappers/OpenGL/GL.h"
+#include "Wrappers/OpenGL/GLNullBackend.h"
+
+#include "TestCheck.h"
+
+/*
+ * The same calls go through the wrapper with the state cache on and
+ * then off, both times to the null backend. The state the backend ends
+ * up with after every call has to be the same, the cache may only keep
+ * calls that change nothing.
+*/
+
+struct GLEffectiveState
+{
+	std::map<std::pair<GLenum, GLuint>, GLuint> bindings;
+	std::map<GLenum, bool> capabilities;
+	GLboolean depthMask;
+	GLenum activeTexture;
+
+	bool operator== (const GLEffectiveState& other) const
+	{
+		return bindings == other.bindings && capabilities == other.capabilities &&
+			depthMask == other.depthMask && activeTexture == other.activeTexture;
+	}
+};
+
+/*
+ * A binding to 0 is the same as no binding and a disabled capability
+ * the same as one never set
+*/
+
+class GLStateBackend : public GLNullBackend
+{
+public:
+	GLEffectiveState GetEffectiveState () const
+	{
+		GLEffectiveState state;
+
+		for (const auto& binding : _bindings) {
+			if (binding.second != 0) {
+				state.bindings.insert (binding);
+			}
+		}
+
+		for (const auto& capability : _capabilities) {
+			if (capability.second) {
+				state.capabilities.insert (capability);
+			}
+		}
+
+		state.depthMask = _depthMask;
+		state.activeTexture = _activeTexture;
+
+		return state;
+	}
+
+	GLuint GetBinding (GLenum target, GLuint index) const
+	{
+		auto it = _bindings.find (std::make_pair (target, index));
+
+		return it != _bindings.end () ? it->second : 0;
+	}
+};
+
+struct GLScriptResult
+{
+	std::vector<GLEffectiveState> states;
+	std::vector<int> queries;
+	std::size_t callsCount;
+};
+
+/*
+ * Drivers give the names of deleted objects again, the script binds
+ * them once more after deleting them
+*/
+
+static GLScriptResult RunScript (bool isStateCaching)
+{
+	GLStateBackend* backend = new GLStateBackend ();
+
+	GL::SetBackend (backend);
+	GL::SetStateCaching (isStateCaching);
+
+	GLScriptResult result;
+
+	auto step = [&result, backend] () {
+		result.states.push_back (backend->GetEffectiveState ());
+	};
+
+	GLuint vertexArrays [2];
+	GLuint buffers [4];
+	GLuint framebuffers [2];
+	GLuint textures [2];
+
+	GL::GenVertexArrays (2, vertexArrays); step ();
+	GL::GenBuffers (4, buffers); step ();
+	GL::GenFramebuffers (2, framebuffers); step ();
+	GL::GenTextures (2, textures); step ();
+
+	/*
+	 * The element array buffer belongs to the vertex array
+	*/
+
+	GL::BindVertexArray (vertexArrays [0]); step ();
+	GL::BindBuffer (GL_ELEMENT_ARRAY_BUFFER, buffers [0]); step ();
+	GL::BindBuffer (GL_ELEMENT_ARRAY_BUFFER, buffers [0]); step ();
+	GL::BindVertexArray (vertexArrays [1]); step ();
+
+	result.queries.push_back (backend->GetBinding (GL_ELEMENT_ARRAY_BUFFER, vertexArrays [1]));
+
+	GL::BindBuffer (GL_ELEMENT_ARRAY_BUFFER, buffers [0]); step ();
+	GL::BindVertexArray (vertexArrays [0]); step ();
+	GL::BindBuffer (GL_ELEMENT_ARRAY_BUFFER, buffers [1]); step ();
+	GL::BindVertexArray (vertexArrays [0]); step ();
+	GL::BindBuffer (GL_ELEMENT_ARRAY_BUFFER, buffers [1]); step ();
+	GL::BindBuffer (GL_ARRAY_BUFFER, buffers [2]); step ();
+	GL::BindVertexArray (vertexArrays [1]); step ();
+	GL::BindBuffer (GL_ARRAY_BUFFER, buffers [2]); step ();
+
+	/*
+	 * GL_FRAMEBUFFER binds both the draw and the read framebuffer
+	*/
+
+	GL::BindFramebuffer (GL_FRAMEBUFFER, framebuffers [0]); step ();
+	GL::BindFramebuffer (GL_DRAW_FRAMEBUFFER, framebuffers [0]); step ();
+	GL::BindFramebuffer (GL_READ_FRAMEBUFFER, framebuffers [0]); step ();
+	GL::BindFramebuffer (GL_READ_FRAMEBUFFER, framebuffers [1]); step ();
+	GL::BindFramebuffer (GL_FRAMEBUFFER, framebuffers [0]); step ();
+	GL::BindFramebuffer (GL_FRAMEBUFFER, framebuffers [0]); step ();
+	GL::BindFramebuffer (GL_DRAW_FRAMEBUFFER, framebuffers [1]); step ();
+	GL::BindFramebuffer (GL_FRAMEBUFFER, framebuffers [1]); step ();
+	GL::BindFramebuffer (GL_FRAMEBUFFER, 0); step ();
+
+	/*
+	 * An indexed binding also binds the generic one
+	*/
+
+	GL::BindBufferBase (GL_UNIFORM_BUFFER, 0, buffers [2]); step ();
+	GL::BindBuffer (GL_UNIFORM_BUFFER, buffers [2]); step ();
+	GL::BindBuffer (GL_UNIFORM_BUFFER, buffers [3]); step ();
+	GL::BindBufferBase (GL_UNIFORM_BUFFER, 0, buffers [2]); step ();
+	GL::BindBufferBase (GL_UNIFORM_BUFFER, 0, buffers [2]); step ();
+	GL::BindBufferBase (GL_UNIFORM_BUFFER, 1, buffers [2]); step ();
+	GL::BindBufferBase (GL_SHADER_STORAGE_BUFFER, 0, buffers [3]); step ();
+	GL::BindBufferBase (GL_UNIFORM_BUFFER, 1, buffers [3]); step ();
+	GL::BindBuffer (GL_UNIFORM_BUFFER, buffers [3]); step ();
+
+	/*
+	 * A range bind leaves the generic binding too, a base bind of the
+	 * same buffer after it still has to go through
+	*/
+
+	GL::BindBufferBase (GL_SHADER_STORAGE_BUFFER, 1, buffers [2]); step ();
+	GL::BindBufferRange (GL_SHADER_STORAGE_BUFFER, 1, buffers [2], 256, 1024); step ();
+	GL::BindBuffer (GL_SHADER_STORAGE_BUFFER, buffers [2]); step ();
+	GL::BindBufferRange (GL_SHADER_STORAGE_BUFFER, 2, buffers [1], 0, 512); step ();
+	GL::BindBuffer (GL_SHADER_STORAGE_BUFFER, buffers [1]); step ();
+	GL::BindBufferBase (GL_SHADER_STORAGE_BUFFER, 1, buffers [2]); step ();
+
+	/*
+	 * Textures are bound to the active unit
+	*/
+
+	GL::BindTexture (GL_TEXTURE_2D, textures [0]); step ();
+	GL::ActiveTexture (GL_TEXTURE0); step ();
+	GL::BindTexture (GL_TEXTURE_2D, textures [0]); step ();
+	GL::BindTexture (GL_TEXTURE_2D, textures [0]); step ();
+	GL::ActiveTexture (GL_TEXTURE1); step ();
+	GL::BindTexture (GL_TEXTURE_2D, textures [0]); step ();
+	GL::ActiveTexture (GL_TEXTURE1); step ();
+	GL::BindTexture (GL_TEXTURE_2D, textures [1]); step ();
+	GL::ActiveTexture (GL_TEXTURE0); step ();
+	GL::BindTexture (GL_TEXTURE_2D, textures [0]); step ();
+
+	/*
+	 * Capabilities and the depth mask, set and queried
+	*/
+
+	bool isEnabled = false;
+	GLboolean depthMask = GL_FALSE;
+
+	GL::IsEnabled (GL_DEPTH_TEST, &isEnabled); step ();
+	result.queries.push_back (isEnabled);
+	GL::Enable (GL_DEPTH_TEST); step ();
+	GL::Enable (GL_DEPTH_TEST); step ();
+	GL::IsEnabled (GL_DEPTH_TEST, &isEnabled); step ();
+	result.queries.push_back (isEnabled);
+	GL::Disable (GL_DEPTH_TEST); step ();
+	GL::IsEnabled (GL_DEPTH_TEST, &isEnabled); step ();
+	result.queries.push_back (isEnabled);
+	GL::Disable (GL_BLEND); step ();
+	GL::Enable (GL_BLEND); step ();
+
+	GL::GetBooleanv (GL_DEPTH_WRITEMASK, &depthMask); step ();
+	result.queries.push_back (depthMask);
+	GL::DepthMask (GL_TRUE); step ();
+	GL::DepthMask (GL_FALSE); step ();
+	GL::GetBooleanv (GL_DEPTH_WRITEMASK, &depthMask); step ();
+	result.queries.push_back (depthMask);
+	GL::DepthMask (GL_FALSE); step ();
+	GL::DepthMask (GL_TRUE); step ();
+
+	GL::UseProgram (7); step ();
+	GL::UseProgram (7); step ();
+
+	/*
+	 * Deleting an object unbinds it everywhere
+	*/
+
+	GL::DeleteBuffers (1, &buffers [2]); step ();
+	GL::BindBuffer (GL_ARRAY_BUFFER, buffers [2]); step ();
+	GL::BindBufferBase (GL_UNIFORM_BUFFER, 0, buffers [2]); step ();
+	GL::BindBufferBase (GL_UNIFORM_BUFFER, 1, buffers [3]); step ();
+
+	GL::DeleteFramebuffers (1, &framebuffers [1]); step ();
+	GL::BindFramebuffer (GL_FRAMEBUFFER, framebuffers [1]); step ();
+
+	GL::DeleteTextures (1, &textures [0]); step ();
+	GL::BindTexture (GL_TEXTURE_2D, textures [0]); step ();
+
+	GL::DeleteBuffers (1, &buffers [1]); step ();
+	GL::BindVertexArray (vertexArrays [0]); step ();
+	GL::BindBuffer (GL_ELEMENT_ARRAY_BUFFER, buffers [1]); step ();
+
+	GL::DeleteVertexArrays (1, &vertexArrays [0]); step ();
+	GL::BindVertexArray (vertexArrays [0]); step ();
+	GL::BindBuffer (GL_ELEMENT_ARRAY_BUFFER, buffers [1]); step ();
+	GL::BindVertexArray (0); step ();
+
+	GL::EndFrame ();
+
+	result.callsCount = backend->GetFrameStatistics ().callsCount;
+
+	GL::SetStateCaching (true);
+	GL::SetBackend (nullptr);
+
+	return result;
+}
+
+static void TestSameState ()
+{
+	std::size_t filteredCount = GL::GetStateCacheStatistics ().filteredBindsCount +
+		GL::GetStateCacheStatistics ().filteredStateChangesCount;
+
+	GLScriptResult cached = RunScript (true);
+
+	filteredCount = GL::GetStateCacheStatistics ().filteredBindsCount +
+		GL::GetStateCacheStatistics ().filteredStateChangesCount - filteredCount;
+
+	GLScriptResult uncached = RunScript (false);
+
+	CHECK (cached.states.size () == uncached.states.size ());
+
+	for (std::size_t index = 0; index < cached.states.size () && index < uncached.states.size (); index++) {
+		if (!(cached.states [index] == uncached.states [index])) {
+			std::printf ("State differs after call %zu\n", index);
+			CHECK (cached.states [index] == uncached.states [index]);
+		}
+	}
+
+	CHECK (cached.queries == uncached.queries);
+
+	/*
+	 * The element array buffer of a new vertex array is not bound, the
+	 * queries give what was set
+	*/
+
+	CHECK (uncached.queries.size () == 6);
+	CHECK (uncached.queries [0] == 0);
+	CHECK (uncached.queries [1] == false);
+	CHECK (uncached.queries [2] == true);
+	CHECK (uncached.queries [3] == false);
+	CHECK (uncached.queries [4] == GL_TRUE);
+	CHECK (uncached.queries [5] == GL_FALSE);
+
+	/*
+	 * The cache kept something from the backend, each call it kept is
+	 * one less for the backend
+	*/
+
+	CHECK (filteredCount > 0);
+	CHECK (cached.callsCount < uncached.callsCount);
+}
+
+int main ()
+{
+	TestSameState ();
+
+	return TestResult ("GLStateCache");
+}
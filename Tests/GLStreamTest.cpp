@@ -0,0 +1,322 @@
+#include <string>
+#include <vector>
+#include <fstream>
+#include <cstdio>
+#include <cstring>
+#include <algorithm>
+
+#include "Wrappers/OpenGL/GL.h"
+#include "Wrappers/OpenGL/GLNullBackend.h"
+
+#include "Renderer/StaticGeometryArena.h"
+#include "Renderer/IndirectDrawBuffer.h"
+#include "Renderer/IndirectDrawCommandBuilder.h"
+#include "Renderer/StreamingBuffer.h"
+#include "Renderer/Pipeline.h"
+
+#include "RenderPasses/VoxelVolume.h"
+
+#include "Core/Math/glm/gtx/transform.hpp"
+
+#include "TestCheck.h"
+
+/*
+ * A few frames of the multi draw path recorded by the null backend,
+ * through the state cache, and diffed against the stream stored next to
+ * the test. Every extension the engine checks for is reported, so the
+ * frames also take the persistent streaming buffer and the sparse voxel
+ * volume, as on the drivers the engine is made for. Any change in the
+ * calls the renderer makes shows up here.
+ * When the change is intended, the stream is recorded again with
+ *
+ *     ./Tests/GLStreamTest.out --record
+ *
+ * and the new one is committed with the change.
+*/
+
+#define TEST_STREAM_FILENAME "Tests/GLStreamTest.glstream"
+#define TEST_RECORDED_STREAM_FILENAME "Tests/GLStreamTest.recorded.glstream"
+#define TEST_FRAMES_COUNT 3
+#define TEST_MESHES_COUNT 4
+#define TEST_MATERIALS_COUNT 3
+#define TEST_FORWARD_OBJECTS_COUNT 4
+#define TEST_VOLUME_SIZE 64
+#define TEST_VOLUME_MIPMAP_LEVELS 4
+
+struct TestMesh
+{
+	StaticGeometryArena* arena;
+	StaticGeometryRange range;
+};
+
+/*
+ * Boxes of the given vertex size, every vertex is the same, only the
+ * sizes and offsets go in the stream
+*/
+
+static TestMesh AllocateMesh (StaticGeometryArena* arena, std::size_t verticesCount, std::size_t indicesCount)
+{
+	TestMesh mesh;
+
+	mesh.arena = arena;
+
+	std::vector<unsigned char> vertices (verticesCount * arena->GetVertexStride (), 0);
+	std::vector<unsigned int> indices (indicesCount);
+
+	for (std::size_t index = 0; index < indicesCount; index++) {
+		indices [index] = (unsigned int) (index % verticesCount);
+	}
+
+	CHECK (arena->Allocate (vertices.data (), verticesCount, indices, mesh.range));
+
+	return mesh;
+}
+
+static void RecordStream (const std::string& filename)
+{
+	for (const std::string& extension : GLNullBackend::GetKnownExtensions ()) {
+		GLNullBackend::SetExtension (extension, true);
+	}
+
+	GL::SetBackend (new GLNullBackend (filename));
+	GL::SetStateCaching (true);
+
+	StreamingBuffer* streamingBuffer = StreamingBuffer::Instance ();
+
+	/*
+	 * Loading, the meshes go in the arenas of their layouts
+	*/
+
+	StaticGeometryArena* texturedArena = new StaticGeometryArena (32, {{0, 3, 0}, {1, 3, 12}, {2, 2, 24}});
+	StaticGeometryArena* positionArena = new StaticGeometryArena (12, {{0, 3, 0}});
+
+	std::vector<TestMesh> meshes;
+
+	meshes.push_back (AllocateMesh (texturedArena, 24, 36));
+	meshes.push_back (AllocateMesh (texturedArena, 81, 384));
+	meshes.push_back (AllocateMesh (positionArena, 8, 36));
+	meshes.push_back (AllocateMesh (texturedArena, 4, 6));
+
+	GLuint programs [2];
+
+	programs [0] = GL::CreateProgram ();
+	programs [1] = GL::CreateProgram ();
+
+	GLuint textures [TEST_MATERIALS_COUNT];
+
+	GL::GenTextures (TEST_MATERIALS_COUNT, textures);
+
+	GLuint framebuffer;
+
+	GL::GenFramebuffers (1, &framebuffer);
+
+	GLuint quadVAO;
+
+	GL::GenVertexArrays (1, &quadVAO);
+
+	VoxelVolume volume;
+
+	volume.Init (VoxelVolumeConfiguration (TEST_VOLUME_SIZE, TEST_VOLUME_MIPMAP_LEVELS));
+
+	CHECK (volume.IsSparse ());
+
+	GL::EndFrame ();
+
+	/*
+	 * Frames with more objects every time, the draw IDs of the arenas
+	 * grow on the way
+	*/
+
+	IndirectDrawBuffer* indirectDrawBuffer = new IndirectDrawBuffer ();
+	IndirectDrawCommandBuilder builder;
+
+	for (std::size_t frame = 0; frame < TEST_FRAMES_COUNT; frame++) {
+		streamingBuffer->BeginFrame ();
+
+		/*
+		 * The bricks around the geometry grow with the objects, the new
+		 * ones are committed and every dirty one is cleared
+		*/
+
+		VoxelBrickAllocator* brickAllocator = volume.GetBrickAllocator ();
+
+		brickAllocator->BeginUpdate ();
+		brickAllocator->MarkRegion (glm::vec3 (0.0f), glm::vec3 (16.0f * (frame + 1) - 1.0f));
+		brickAllocator->EndUpdate ();
+
+		volume.UpdateBricks ();
+		volume.ClearVoxels ();
+
+		GL::BindFramebuffer (GL_FRAMEBUFFER, framebuffer);
+		GL::Viewport (0, 0, 1280, 720);
+		GL::Clear (GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+
+		GL::Enable (GL_DEPTH_TEST);
+		GL::DepthMask (GL_TRUE);
+		GL::Disable (GL_BLEND);
+
+		builder.Clear ();
+
+		std::size_t objectsCount = 8 + frame * 700;
+
+		for (std::size_t object = 0; object < objectsCount; object++) {
+			const TestMesh& mesh = meshes [object % TEST_MESHES_COUNT];
+
+			std::size_t material = object % TEST_MATERIALS_COUNT;
+
+			std::size_t objectIndex = builder.AddObject (glm::translate (glm::mat4 (1.0f), glm::vec3 ((float) object, 0.0f, 0.0f)));
+
+			builder.AddDraw (IndirectDrawBuffer::BuildBatchKey (mesh.arena->GetIndex (), material), material, objectIndex,
+				mesh.range.indicesCount, mesh.range.firstIndex, (std::int32_t) mesh.range.firstVertex);
+		}
+
+		builder.Build ();
+
+		indirectDrawBuffer->Upload (builder);
+
+		for (const IndirectDrawBatch& batch : builder.GetBatches ()) {
+			GL::UseProgram (programs [IndirectDrawBuffer::GetBatchArena (batch.key)]);
+			GL::ActiveTexture (GL_TEXTURE0);
+			GL::BindTexture (GL_TEXTURE_2D, textures [batch.tag]);
+
+			indirectDrawBuffer->Draw (batch);
+		}
+
+		/*
+		 * Objects drawn one by one write their matrices to the streaming
+		 * buffer, bound once a frame over the region of the frame
+		*/
+
+		GL::BindBufferRange (GL_SHADER_STORAGE_BUFFER, PIPELINE_OBJECT_DATA_BINDING,
+			streamingBuffer->GetBuffer (), streamingBuffer->GetRegionOffset (), STREAMING_BUFFER_REGION_SIZE);
+
+		for (std::size_t object = 0; object < TEST_FORWARD_OBJECTS_COUNT; object++) {
+			StreamingAllocation allocation = streamingBuffer->Allocate (sizeof (IndirectDrawData), sizeof (IndirectDrawData));
+
+			CHECK (allocation.data != nullptr);
+
+			if (allocation.data != nullptr) {
+				IndirectDrawData* objectData = (IndirectDrawData*) allocation.data;
+
+				objectData->modelMatrix = glm::translate (glm::mat4 (1.0f), glm::vec3 (0.0f, (float) object, 0.0f));
+				objectData->normalMatrix = glm::mat4 (1.0f);
+			}
+
+			streamingBuffer->Commit (allocation);
+
+			GL::Uniform1i (0, (GLint) ((allocation.offset - streamingBuffer->GetRegionOffset ()) / sizeof (IndirectDrawData)));
+			GL::DrawArrays (GL_TRIANGLES, 0, 36);
+		}
+
+		/*
+		 * Light accumulation over a full screen quad
+		*/
+
+		GL::BindFramebuffer (GL_FRAMEBUFFER, 0);
+
+		GL::Disable (GL_DEPTH_TEST);
+		GL::DepthMask (GL_FALSE);
+		GL::Enable (GL_BLEND);
+		GL::BlendFunc (GL_ONE, GL_ONE);
+
+		GL::UseProgram (programs [1]);
+		GL::BindVertexArray (quadVAO);
+
+		for (std::size_t light = 0; light < 3; light++) {
+			GL::DrawArrays (GL_TRIANGLES, 0, 6);
+		}
+
+		streamingBuffer->EndFrame ();
+
+		GL::EndFrame ();
+	}
+
+	/*
+	 * Cleaning goes in the last frame
+	*/
+
+	volume.Release ();
+
+	GL::DeleteVertexArrays (1, &quadVAO);
+	GL::DeleteFramebuffers (1, &framebuffer);
+	GL::DeleteTextures (TEST_MATERIALS_COUNT, textures);
+	GL::DeleteProgram (programs [0]);
+	GL::DeleteProgram (programs [1]);
+
+	for (const TestMesh& mesh : meshes) {
+		mesh.arena->Free (mesh.range);
+	}
+
+	delete texturedArena;
+	delete positionArena;
+
+	delete indirectDrawBuffer;
+
+	GL::EndFrame ();
+
+	/*
+	 * The null backend stays, the streaming buffer deletes its buffer
+	 * when the program exits
+	*/
+}
+
+static std::vector<std::string> ReadLines (const std::string& filename)
+{
+	std::ifstream stream (filename);
+	std::vector<std::string> lines;
+	std::string line;
+
+	while (std::getline (stream, line)) {
+		lines.push_back (line);
+	}
+
+	return lines;
+}
+
+/*
+ * The first line that differs is enough to start from, the recorded
+ * stream is kept for a full diff
+*/
+
+static void TestStream ()
+{
+	RecordStream (TEST_RECORDED_STREAM_FILENAME);
+
+	std::vector<std::string> expected = ReadLines (TEST_STREAM_FILENAME);
+	std::vector<std::string> recorded = ReadLines (TEST_RECORDED_STREAM_FILENAME);
+
+	CHECK (!expected.empty ());
+
+	std::size_t linesCount = std::max (expected.size (), recorded.size ());
+
+	for (std::size_t line = 0; line < linesCount; line++) {
+		const std::string& expectedLine = line < expected.size () ? expected [line] : std::string ();
+		const std::string& recordedLine = line < recorded.size () ? recorded [line] : std::string ();
+
+		if (expectedLine != recordedLine) {
+			std::printf ("%s:%zu: expected \"%s\", recorded \"%s\" in %s\n", TEST_STREAM_FILENAME, line + 1,
+				expectedLine.c_str (), recordedLine.c_str (), TEST_RECORDED_STREAM_FILENAME);
+
+			CHECK (expectedLine == recordedLine);
+
+			return;
+		}
+	}
+
+	std::remove (TEST_RECORDED_STREAM_FILENAME);
+}
+
+int main (int argc, char** argv)
+{
+	if (argc > 1 && std::strcmp (argv [1], "--record") == 0) {
+		RecordStream (TEST_STREAM_FILENAME);
+
+		std::printf ("GLStream: recorded %s\n", TEST_STREAM_FILENAME);
+
+		return 0;
+	}
+
+	TestStream ();
+
+	return TestResult ("GLStream");
+}
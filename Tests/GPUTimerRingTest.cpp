@@ -0,0 +1,277 @@
+#include <vector>
+#include <cstdint>
+
+#include "Renderer/GPUTimerRing.h"
+
+#include "TestCheck.h"
+
+/*
+ * Timestamps of a GPU that runs a fixed count of frames behind the CPU.
+ * A query recorded on a frame is available that many frames later. The
+ * ring must never ask for a timestamp before it is available, the GL
+ * backend would stall there.
+*/
+
+class TestTimerBackend : public GPUTimerBackend
+{
+public:
+	struct Query
+	{
+		std::size_t recordFrame;
+		std::uint64_t timestamp;
+		bool isRecorded;
+	};
+
+	std::vector<Query*>& queries;
+	std::size_t latency;
+	std::size_t frame;
+	std::uint64_t clock;
+	std::size_t stallsCount;
+
+	TestTimerBackend (std::vector<Query*>& queries, std::size_t latency) :
+		queries (queries),
+		latency (latency),
+		frame (0),
+		clock (0),
+		stallsCount (0)
+	{
+
+	}
+
+	void* Create ()
+	{
+		Query* query = new Query ();
+
+		query->recordFrame = 0;
+		query->timestamp = 0;
+		query->isRecorded = false;
+
+		queries.push_back (query);
+
+		return query;
+	}
+
+	void Delete (void* query)
+	{
+		for (Query*& liveQuery : queries) {
+			if (liveQuery == query) {
+				liveQuery = nullptr;
+			}
+		}
+
+		delete (Query*) query;
+	}
+
+	void Record (void* query)
+	{
+		Query* recordedQuery = (Query*) query;
+
+		recordedQuery->recordFrame = frame;
+		recordedQuery->timestamp = clock;
+		recordedQuery->isRecorded = true;
+	}
+
+	bool IsAvailable (void* query)
+	{
+		Query* recordedQuery = (Query*) query;
+
+		return recordedQuery->isRecorded && frame >= recordedQuery->recordFrame + latency;
+	}
+
+	std::uint64_t GetTimestamp (void* query)
+	{
+		if (!IsAvailable (query)) {
+			stallsCount ++;
+		}
+
+		return ((Query*) query)->timestamp;
+	}
+};
+
+/*
+ * Each frame the timer measures (frame % 4 + 1) ms of GPU time
+*/
+
+static void RunFrame (GPUTimerRing& ring, TestTimerBackend* backend, std::size_t timer)
+{
+	ring.BeginFrame ();
+
+	ring.Begin (timer);
+	backend->clock += (backend->frame % 4 + 1) * 1000000;
+	ring.End (timer);
+
+	backend->frame ++;
+}
+
+static void TestOnTime ()
+{
+	std::vector<TestTimerBackend::Query*> queries;
+	TestTimerBackend* backend = new TestTimerBackend (queries, GPU_TIMER_FRAMES_COUNT - 1);
+
+	{
+		GPUTimerRing ring (backend);
+
+		std::size_t timer = ring.AddTimer ("Pass");
+
+		CHECK (ring.GetTimersCount () == 1);
+		CHECK (ring.GetStatistics (timer).name == "Pass");
+		CHECK (ring.GetStatistics (timer).samplesCount == 0);
+
+		/*
+		 * Results come back once the slot of their frame is reused
+		*/
+
+		for (std::size_t frame = 0; frame < GPU_TIMER_FRAMES_COUNT; frame++) {
+			RunFrame (ring, backend, timer);
+		}
+
+		CHECK (ring.GetStatistics (timer).samplesCount == 0);
+
+		RunFrame (ring, backend, timer);
+
+		CHECK (ring.GetStatistics (timer).samplesCount == 1);
+		CHECK (ring.GetStatistics (timer).last == 1.0);
+
+		for (std::size_t frame = 0; frame < 100; frame++) {
+			RunFrame (ring, backend, timer);
+		}
+
+		GPUTimerStatistics statistics = ring.GetStatistics (timer);
+
+		CHECK (statistics.samplesCount == 101);
+		CHECK (statistics.min == 1.0);
+		CHECK (statistics.max == 4.0);
+		CHECK (statistics.mean == 2.5);
+		CHECK (statistics.last == 101 % 4 * 1.0);
+
+		/*
+		 * The queries of a frame are given again, the pool stops at what
+		 * the frames in flight need
+		*/
+
+		CHECK (ring.GetLateSamplesCount () == 0);
+		CHECK (ring.GetQueriesCount () <= 2 * GPU_TIMER_FRAMES_COUNT);
+		CHECK (backend->stallsCount == 0);
+	}
+
+	/*
+	 * The ring deletes its queries
+	*/
+
+	for (TestTimerBackend::Query* query : queries) {
+		CHECK (query == nullptr);
+	}
+}
+
+static void TestLate ()
+{
+	std::vector<TestTimerBackend::Query*> queries;
+	TestTimerBackend* backend = new TestTimerBackend (queries, GPU_TIMER_FRAMES_COUNT + 2);
+
+	GPUTimerRing ring (backend);
+
+	std::size_t first = ring.AddTimer ("First");
+	std::size_t second = ring.AddTimer ("Second");
+
+	/*
+	 * The GPU is further behind than the ring, every sample is given up
+	 * instead of waited for
+	*/
+
+	for (std::size_t frame = 0; frame < 50; frame++) {
+		ring.BeginFrame ();
+
+		ring.Begin (first);
+		ring.Begin (second);
+		backend->clock += 1000000;
+		ring.End (second);
+		ring.End (first);
+
+		backend->frame ++;
+	}
+
+	CHECK (ring.GetStatistics (first).samplesCount == 0);
+	CHECK (ring.GetStatistics (second).samplesCount == 0);
+	CHECK (ring.GetLateSamplesCount () == 2 * (50 - GPU_TIMER_FRAMES_COUNT));
+	CHECK (ring.GetQueriesCount () <= 4 * GPU_TIMER_FRAMES_COUNT);
+	CHECK (backend->stallsCount == 0);
+
+	/*
+	 * Once the GPU catches up, the samples come back, the ones of the
+	 * frames in flight too
+	*/
+
+	backend->latency = 1;
+
+	for (std::size_t frame = 0; frame < 10; frame++) {
+		ring.BeginFrame ();
+
+		ring.Begin (first);
+		backend->clock += 2000000;
+		ring.End (first);
+
+		backend->frame ++;
+	}
+
+	CHECK (ring.GetStatistics (first).samplesCount == 10);
+	CHECK (ring.GetStatistics (first).min == 1.0);
+	CHECK (ring.GetStatistics (first).last == 2.0);
+	CHECK (ring.GetQueriesCount () <= 4 * GPU_TIMER_FRAMES_COUNT);
+	CHECK (backend->stallsCount == 0);
+}
+
+static void TestBeginEnd ()
+{
+	std::vector<TestTimerBackend::Query*> queries;
+	TestTimerBackend* backend = new TestTimerBackend (queries, 0);
+
+	GPUTimerRing ring (backend);
+
+	std::size_t timer = ring.AddTimer ("Pass");
+
+	/*
+	 * An end with no begin is ignored, a second begin moves the start
+	*/
+
+	ring.BeginFrame ();
+
+	ring.End (timer);
+	ring.Begin (timer);
+	backend->clock += 5000000;
+	ring.Begin (timer);
+	backend->clock += 3000000;
+	ring.End (timer);
+
+	/*
+	 * A timer begun and never ended gives its query back
+	*/
+
+	ring.Begin (timer);
+
+	std::size_t queriesCount = ring.GetQueriesCount ();
+
+	CHECK (queriesCount == 3);
+
+	for (std::size_t frame = 0; frame < GPU_TIMER_FRAMES_COUNT; frame++) {
+		ring.BeginFrame ();
+	}
+
+	CHECK (ring.GetStatistics (timer).samplesCount == 1);
+	CHECK (ring.GetStatistics (timer).last == 3.0);
+
+	ring.Begin (timer);
+	ring.End (timer);
+	ring.Begin (timer);
+	ring.End (timer);
+
+	CHECK (ring.GetQueriesCount () == queriesCount + 1);
+}
+
+int main ()
+{
+	TestOnTime ();
+	TestLate ();
+	TestBeginEnd ();
+
+	return TestResult ("GPUTimerRing");
+}
@@ -0,0 +1,119 @@
+#include "Renderer/IndirectDrawCommandBuilder.h"
+
+#include "TestCheck.h"
+
+/*
+ * Command buffer of the multi draw path, built from the visible set
+*/
+
+static void TestCommands ()
+{
+	IndirectDrawCommandBuilder builder;
+
+	CHECK (builder.IsEmpty ());
+
+	builder.Build ();
+
+	CHECK (builder.GetCommands ().empty ());
+	CHECK (builder.GetBatches ().empty ());
+
+	std::size_t first = builder.AddObject (glm::mat4 (1.0f));
+	std::size_t second = builder.AddObject (glm::mat4 (2.0f));
+
+	CHECK (first == 0);
+	CHECK (second == 1);
+	CHECK (builder.GetDrawsData ().size () == 2);
+	CHECK (builder.GetDrawsData () [1].modelMatrix == glm::mat4 (2.0f));
+	CHECK (builder.GetDrawsData () [1].normalMatrix == glm::mat4 (glm::mat3 (0.5f)));
+
+	builder.AddDraw (7, 0, first, 36, 120, 40);
+	builder.AddDraw (7, 1, second, 12, 0, -3);
+
+	CHECK (!builder.IsEmpty ());
+
+	builder.Build ();
+
+	const std::vector<DrawElementsIndirectCommand>& commands = builder.GetCommands ();
+
+	CHECK (commands.size () == 2);
+
+	/*
+	 * The base instance is the index of the object data of the draw
+	*/
+
+	CHECK (commands [0].count == 36);
+	CHECK (commands [0].instanceCount == 1);
+	CHECK (commands [0].firstIndex == 120);
+	CHECK (commands [0].baseVertex == 40);
+	CHECK (commands [0].baseInstance == first);
+
+	CHECK (commands [1].count == 12);
+	CHECK (commands [1].firstIndex == 0);
+	CHECK (commands [1].baseVertex == -3);
+	CHECK (commands [1].baseInstance == second);
+
+	CHECK (builder.GetBatches ().size () == 1);
+	CHECK (builder.GetBatches () [0].tag == 0);
+	CHECK (builder.GetBatches () [0].commandsCount == 2);
+
+	builder.Clear ();
+
+	CHECK (builder.IsEmpty ());
+	CHECK (builder.GetDrawsData ().empty ());
+	CHECK (builder.GetCommands ().empty ());
+}
+
+static void TestBatches ()
+{
+	IndirectDrawCommandBuilder builder;
+
+	std::size_t object = builder.AddObject (glm::mat4 (1.0f));
+
+	/*
+	 * Draws of the same state are grouped, in the order they were added
+	*/
+
+	builder.AddDraw (3, 30, object, 1, 0, 0);
+	builder.AddDraw (1, 10, object, 2, 0, 0);
+	builder.AddDraw (3, 31, object, 3, 0, 0);
+	builder.AddDraw (2, 20, object, 4, 0, 0);
+	builder.AddDraw (1, 11, object, 5, 0, 0);
+
+	builder.Build ();
+
+	const std::vector<DrawElementsIndirectCommand>& commands = builder.GetCommands ();
+	const std::vector<IndirectDrawBatch>& batches = builder.GetBatches ();
+
+	CHECK (commands.size () == 5);
+	CHECK (batches.size () == 3);
+
+	CHECK (batches [0].key == 1 && batches [0].tag == 10);
+	CHECK (batches [0].firstCommand == 0 && batches [0].commandsCount == 2);
+	CHECK (batches [1].key == 2 && batches [1].tag == 20);
+	CHECK (batches [1].firstCommand == 2 && batches [1].commandsCount == 1);
+	CHECK (batches [2].key == 3 && batches [2].tag == 30);
+	CHECK (batches [2].firstCommand == 3 && batches [2].commandsCount == 2);
+
+	CHECK (commands [0].count == 2);
+	CHECK (commands [1].count == 5);
+	CHECK (commands [2].count == 4);
+	CHECK (commands [3].count == 1);
+	CHECK (commands [4].count == 3);
+
+	/*
+	 * Building again gives the same batches
+	*/
+
+	builder.Build ();
+
+	CHECK (builder.GetCommands ().size () == 5);
+	CHECK (builder.GetBatches ().size () == 3);
+}
+
+int main ()
+{
+	TestCommands ();
+	TestBatches ();
+
+	return TestResult ("IndirectDrawCommandBuilder");
+}
@@ -0,0 +1,299 @@
+#include <vector>
+#include <thread>
+#include <atomic>
+#include <random>
+
+#include "Utils/Threads/JobSystem.h"
+#include "Utils/Threads/FrameGraph.h"
+
+#include "TestCheck.h"
+
+/*
+ * The scheduler under many small jobs, jobs that wait for jobs of their
+ * own and workers started and stopped between rounds. Then frame graphs
+ * whose nodes check that what they depend on is done before they start.
+*/
+
+#define TEST_WORKERS_COUNT 3
+#define TEST_JOBS_COUNT 20000
+#define TEST_ROUNDS_COUNT 5
+#define TEST_NODES_COUNT 40
+#define TEST_FRAMES_COUNT 200
+
+/*
+ * Each job of the tree submits two children and waits for them, so the
+ * workers have to run other jobs while they wait
+*/
+
+static void SubmitTree (std::size_t depth, std::atomic<std::size_t>& leavesCount)
+{
+	if (depth == 0) {
+		leavesCount.fetch_add (1);
+
+		return;
+	}
+
+	JobCounter counter;
+
+	for (std::size_t child = 0; child < 2; child++) {
+		JobSystem::Instance ()->Submit ([depth, &leavesCount] () {
+			SubmitTree (depth - 1, leavesCount);
+		}, &counter);
+	}
+
+	JobSystem::Instance ()->Wait (&counter);
+}
+
+static void TestStress ()
+{
+	JobSystem* jobSystem = JobSystem::Instance ();
+
+	for (std::size_t round = 0; round < TEST_ROUNDS_COUNT; round++) {
+		std::size_t workersCount = round % (TEST_WORKERS_COUNT + 1);
+
+		jobSystem->Start (workersCount);
+
+		CHECK (jobSystem->GetWorkersCount () == workersCount);
+
+		/*
+		 * Every job runs once, whichever thread takes it
+		*/
+
+		std::vector<std::atomic<std::size_t>> runsCounts (TEST_JOBS_COUNT);
+
+		for (std::atomic<std::size_t>& runsCount : runsCounts) {
+			runsCount = 0;
+		}
+
+		JobCounter counter;
+
+		for (std::size_t index = 0; index < TEST_JOBS_COUNT; index++) {
+			jobSystem->Submit ([&runsCounts, index] () { runsCounts [index].fetch_add (1); }, &counter);
+		}
+
+		jobSystem->Wait (&counter);
+
+		CHECK (counter.IsDone ());
+
+		bool isEveryJobRunOnce = true;
+
+		for (std::atomic<std::size_t>& runsCount : runsCounts) {
+			isEveryJobRunOnce &= runsCount.load () == 1;
+		}
+
+		CHECK (isEveryJobRunOnce);
+
+		/*
+		 * Nested waits
+		*/
+
+		std::atomic<std::size_t> leavesCount (0);
+
+		SubmitTree (10, leavesCount);
+
+		CHECK (leavesCount.load () == 1024);
+
+		/*
+		 * Every index of a parallel for is given once
+		*/
+
+		std::vector<std::atomic<std::size_t>> indicesCounts (TEST_JOBS_COUNT + 7);
+
+		for (std::atomic<std::size_t>& indexCount : indicesCounts) {
+			indexCount = 0;
+		}
+
+		jobSystem->ParallelFor (indicesCounts.size (), 64, [&indicesCounts] (std::size_t begin, std::size_t end) {
+			for (std::size_t index = begin; index < end; index++) {
+				indicesCounts [index].fetch_add (1);
+			}
+		});
+
+		bool isEveryIndexGivenOnce = true;
+
+		for (std::atomic<std::size_t>& indexCount : indicesCounts) {
+			isEveryIndexGivenOnce &= indexCount.load () == 1;
+		}
+
+		CHECK (isEveryIndexGivenOnce);
+
+		/*
+		 * Jobs submitted from threads that are not workers
+		*/
+
+		std::atomic<std::size_t> externalRunsCount (0);
+		JobCounter externalCounter;
+
+		std::thread external ([&externalRunsCount, &externalCounter, jobSystem] () {
+			for (std::size_t index = 0; index < 1000; index++) {
+				jobSystem->Submit ([&externalRunsCount] () { externalRunsCount.fetch_add (1); }, &externalCounter);
+			}
+
+			jobSystem->Wait (&externalCounter);
+		});
+
+		external.join ();
+
+		CHECK (externalRunsCount.load () == 1000);
+	}
+
+	/*
+	 * Jobs left when the workers stop are run by the thread that waits
+	 * for them
+	*/
+
+	jobSystem->Start (TEST_WORKERS_COUNT);
+	jobSystem->Stop ();
+
+	CHECK (jobSystem->GetWorkersCount () == 0);
+
+	std::atomic<std::size_t> runsCount (0);
+	JobCounter counter;
+
+	for (std::size_t index = 0; index < 100; index++) {
+		jobSystem->Submit ([&runsCount] () { runsCount.fetch_add (1); }, &counter);
+	}
+
+	jobSystem->Wait (&counter);
+
+	CHECK (runsCount.load () == 100);
+}
+
+/*
+ * Random graphs, a node depends only on nodes added before it. Every
+ * node takes a stamp when it starts and one when it is done, the stamps
+ * of the nodes it depends on have to be older than its start.
+*/
+
+static void TestFrameGraph ()
+{
+	JobSystem::Instance ()->Start (TEST_WORKERS_COUNT);
+
+	std::mt19937 generator (5);
+
+	for (std::size_t graphIndex = 0; graphIndex < 10; graphIndex++) {
+		FrameGraph graph;
+
+		std::atomic<std::size_t> clock (0);
+		std::vector<std::size_t> startStamps (TEST_NODES_COUNT);
+		std::vector<std::size_t> doneStamps (TEST_NODES_COUNT);
+		std::vector<std::vector<std::size_t>> dependencies (TEST_NODES_COUNT);
+		std::vector<bool> isMainThread (TEST_NODES_COUNT);
+		std::vector<std::thread::id> threads (TEST_NODES_COUNT);
+
+		for (std::size_t node = 0; node < TEST_NODES_COUNT; node++) {
+			isMainThread [node] = generator () % 5 == 0;
+
+			graph.AddNode ("Node " + std::to_string (node), [&, node] () {
+				startStamps [node] = clock.fetch_add (1);
+				threads [node] = std::this_thread::get_id ();
+
+				volatile std::size_t work = 0;
+
+				for (std::size_t index = 0; index < 1000; index++) {
+					work = work + index;
+				}
+
+				doneStamps [node] = clock.fetch_add (1);
+			}, isMainThread [node]);
+
+			for (std::size_t dependency = 0; dependency < node; dependency++) {
+				if (generator () % 8 == 0) {
+					graph.AddDependency (node, dependency);
+					dependencies [node].push_back (dependency);
+				}
+			}
+		}
+
+		CHECK (graph.GetNodesCount () == TEST_NODES_COUNT);
+
+		std::size_t outOfOrderCount = 0;
+		std::size_t wrongThreadCount = 0;
+
+		for (std::size_t frame = 0; frame < TEST_FRAMES_COUNT / 10; frame++) {
+			std::fill (startStamps.begin (), startStamps.end (), (std::size_t) -1);
+			std::fill (doneStamps.begin (), doneStamps.end (), (std::size_t) -1);
+
+			graph.Execute ();
+
+			/*
+			 * Execute returns with every node done
+			*/
+
+			for (std::size_t node = 0; node < TEST_NODES_COUNT; node++) {
+				if (doneStamps [node] == (std::size_t) -1) {
+					outOfOrderCount ++;
+				}
+
+				for (std::size_t dependency : dependencies [node]) {
+					if (doneStamps [dependency] >= startStamps [node]) {
+						outOfOrderCount ++;
+					}
+				}
+
+				if (isMainThread [node] && threads [node] != std::this_thread::get_id ()) {
+					wrongThreadCount ++;
+				}
+			}
+		}
+
+		CHECK (outOfOrderCount == 0);
+		CHECK (wrongThreadCount == 0);
+	}
+
+	JobSystem::Instance ()->Stop ();
+}
+
+/*
+ * A chain runs in order, the nodes next to it run meanwhile
+*/
+
+static void TestChain ()
+{
+	JobSystem::Instance ()->Start (TEST_WORKERS_COUNT);
+
+	FrameGraph graph;
+
+	std::vector<std::size_t> order;
+	std::atomic<std::size_t> sideNodesCount (0);
+
+	std::size_t lastNode = graph.AddNode ("Chain 0", [&order] () { order.push_back (0); }, false);
+
+	for (std::size_t node = 1; node < 10; node++) {
+		std::size_t chainNode = graph.AddNode ("Chain " + std::to_string (node),
+			[&order, node] () { order.push_back (node); }, node % 3 == 0);
+
+		graph.AddDependency (chainNode, lastNode);
+
+		lastNode = chainNode;
+
+		graph.AddNode ("Side " + std::to_string (node), [&sideNodesCount] () { sideNodesCount.fetch_add (1); }, false);
+	}
+
+	for (std::size_t frame = 0; frame < TEST_FRAMES_COUNT; frame++) {
+		order.clear ();
+		sideNodesCount = 0;
+
+		graph.Execute ();
+
+		bool isInOrder = order.size () == 10;
+
+		for (std::size_t index = 0; index < order.size (); index++) {
+			isInOrder &= order [index] == index;
+		}
+
+		CHECK (isInOrder);
+		CHECK (sideNodesCount.load () == 9);
+	}
+
+	JobSystem::Instance ()->Stop ();
+}
+
+int main ()
+{
+	TestStress ();
+	TestFrameGraph ();
+	TestChain ();
+
+	return TestResult ("JobSystem");
+}
@@ -0,0 +1,153 @@
+#include <vector>
+#include <cstring>
+#include <algorithm>
+
+#include "Wrappers/OpenGL/GL.h"
+#include "Wrappers/OpenGL/GLNullBackend.h"
+
+#include "SceneNodes/Model3DRenderer.h"
+#include "SceneNodes/NormalMapModel3DRenderer.h"
+
+#include "Settings/GeneralSettings.h"
+
+#include "TestCheck.h"
+
+/*
+ * Groups loaded from the mesh cache go to the static geometry arena of
+ * their renderer. The cache keeps the normal mapped layout, a plain
+ * renderer uploads only the part of every vertex that its arena reads.
+*/
+
+#define TEST_VERTICES_COUNT 4
+
+/*
+ * Keeps the vertices uploaded to the arenas
+*/
+
+class UploadBackend : public GLNullBackend
+{
+public:
+	std::vector<unsigned char> lastVertices;
+
+	void BufferSubData (GLenum target, GLintptr offset, GLsizeiptr size, const GLvoid *data)
+	{
+		GLNullBackend::BufferSubData (target, offset, size, data);
+
+		if (target == GL_ARRAY_BUFFER) {
+			lastVertices.assign ((const unsigned char*) data, (const unsigned char*) data + size);
+		}
+	}
+};
+
+/*
+ * A renderer that tells which arena its groups went to
+*/
+
+template <class T>
+class ArenaRenderer : public T
+{
+public:
+	using T::T;
+
+	StaticGeometryArena* GetGroupArena (std::size_t index) const
+	{
+		return this->_drawableObjects [index].ARENA;
+	}
+
+	StaticGeometryArena* GetRendererArena ()
+	{
+		return this->GetStaticGeometryArena ();
+	}
+};
+
+static Model* BuildCachedModel (const std::vector<NormalMapVertexData>& vertices,
+	const std::vector<unsigned short>& indices, MeshCacheGroup& meshCacheGroup)
+{
+	meshCacheGroup.vertices = vertices.data ();
+	meshCacheGroup.verticesCount = vertices.size ();
+	meshCacheGroup.vertexStride = sizeof (NormalMapVertexData);
+	meshCacheGroup.indices = indices.data ();
+	meshCacheGroup.indicesCount = indices.size ();
+	meshCacheGroup.indexSize = sizeof (unsigned short);
+
+	PolygonGroup* polyGroup = new PolygonGroup ("group");
+	polyGroup->SetMeshCacheGroup (&meshCacheGroup);
+
+	ObjectModel* objModel = new ObjectModel ("object");
+	objModel->AddPolygonGroup (polyGroup);
+
+	Model* model = new Model ();
+	model->AddObjectModel (objModel);
+
+	return model;
+}
+
+static void TestCachedGroups (UploadBackend* backend)
+{
+	std::vector<NormalMapVertexData> vertices (TEST_VERTICES_COUNT);
+
+	for (std::size_t i=0;i<TEST_VERTICES_COUNT;i++) {
+		for (std::size_t j=0;j<3;j++) {
+			vertices [i].position [j] = (float) (i * 10 + j);
+			vertices [i].normal [j] = (float) (i * 10 + j + 3);
+			vertices [i].tangent [j] = -1.0f;
+		}
+
+		vertices [i].texcoord [0] = (float) i;
+		vertices [i].texcoord [1] = (float) i + 0.5f;
+	}
+
+	std::vector<unsigned short> indices = { 0, 1, 2, 2, 3, 0 };
+
+	MeshCacheGroup meshCacheGroup;
+	Model* model = BuildCachedModel (vertices, indices, meshCacheGroup);
+
+	/*
+	 * The plain renderer drops the tangents on the way to its arena
+	*/
+
+	ArenaRenderer<Model3DRenderer> renderer;
+	renderer.Attach (model);
+
+	CHECK (renderer.IsStaticGeometry ());
+	CHECK (renderer.GetGroupArena (0) == renderer.GetRendererArena ());
+	CHECK (renderer.GetRendererArena ()->GetVertexStride () == sizeof (VertexData));
+
+	CHECK (backend->lastVertices.size () == sizeof (VertexData) * TEST_VERTICES_COUNT);
+
+	for (std::size_t i=0;i<TEST_VERTICES_COUNT && backend->lastVertices.size () == sizeof (VertexData) * TEST_VERTICES_COUNT;i++) {
+		CHECK (std::memcmp (backend->lastVertices.data () + i * sizeof (VertexData),
+			&vertices [i], sizeof (VertexData)) == 0);
+	}
+
+	/*
+	 * The normal mapped renderer uploads the vertices as they are
+	*/
+
+	ArenaRenderer<NormalMapModel3DRenderer> normalMapRenderer;
+	normalMapRenderer.Attach (model);
+
+	CHECK (normalMapRenderer.IsStaticGeometry ());
+	CHECK (normalMapRenderer.GetGroupArena (0) == normalMapRenderer.GetRendererArena ());
+	CHECK (normalMapRenderer.GetRendererArena () != renderer.GetRendererArena ());
+	CHECK (backend->lastVertices.size () == sizeof (NormalMapVertexData) * TEST_VERTICES_COUNT);
+	CHECK (std::memcmp (backend->lastVertices.data (), vertices.data (),
+		std::min (backend->lastVertices.size (), sizeof (NormalMapVertexData) * TEST_VERTICES_COUNT)) == 0);
+
+	delete model;
+}
+
+int main ()
+{
+	UploadBackend* backend = new UploadBackend ();
+
+	GL::SetBackend (backend);
+
+	GeneralSettings::Instance ()->SetIntValue (STATIC_GEOMETRY_SETTING, 1);
+
+	TestCachedGroups (backend);
+
+	GL::SetBackend (nullptr);
+
+	return TestResult ("MeshCacheArena");
+}
@@ -0,0 +1,377 @@
+#include <string>
+#include <vector>
+#include <fstream>
+#include <sstream>
+#include <cstdio>
+#include <cstring>
+#include <utime.h>
+
+#include "Resources/WavefrontObjectLoader.h"
+#include "Resources/MeshCacheLoader.h"
+#include "Resources/MeshCacheSaver.h"
+#include "Mesh/Model.h"
+#include "Mesh/ObjectModel.h"
+#include "Mesh/PolygonGroup.h"
+
+#include "SceneNodes/NormalMapModel3DRenderer.h"
+
+#include "Utils/MeshOptimizer/MeshOptimizer.h"
+
+#include "TestCheck.h"
+
+/*
+ * A model saved to the mesh cache and mapped again has to come back as
+ * it was: the same objects, groups and polygons, and final buffers that
+ * match the ones built from the source byte for byte. A cache of another
+ * version, of another source or cut short is rejected.
+*/
+
+#define TEST_FILENAME "./MeshCacheTest.obj"
+
+/*
+ * Two objects, the first with a group of quads and a triangle group
+*/
+
+static void WriteSource ()
+{
+	std::ofstream stream (TEST_FILENAME);
+
+	stream << "v 0 0 0\nv 1 0 0\nv 1 1 0\nv 0 1 0\nv 2 0 0\nv 2 1 0\n"
+		<< "v 0 0 1\nv 1 0 1\nv 0.5 1 1\n"
+		<< "vn 0 0 1\nvn 0 1 0\n"
+		<< "vt 0 0\nvt 1 0\nvt 1 1\nvt 0 1\n"
+		<< "o first\ng front\nusemtl stone\n"
+		<< "f 1/1/1 2/2/1 3/3/1 4/4/1\n"
+		<< "f 2/2/1 5/1/1 6/4/1 3/3/1\n"
+		<< "g top\nusemtl wood\n"
+		<< "f 4/1/2 3/2/2 6/3/2\n"
+		<< "o second\n"
+		<< "f 7/1/1 8/2/1 9/3/1\n";
+}
+
+static std::string ReadFile (const std::string& filename)
+{
+	std::ifstream stream (filename, std::ios::binary);
+	std::stringstream content;
+
+	content << stream.rdbuf ();
+
+	return content.str ();
+}
+
+static void WriteFile (const std::string& filename, const std::string& content)
+{
+	std::ofstream stream (filename, std::ios::binary | std::ios::trunc);
+
+	stream.write (content.data (), content.size ());
+}
+
+static Model* LoadSource ()
+{
+	WavefrontObjectLoader loader;
+	loader.SetLoadMaterials (false);
+
+	return (Model*) loader.Load (TEST_FILENAME);
+}
+
+static Model* LoadCache (const MeshCacheKey& key)
+{
+	MeshCacheLoader loader;
+	loader.SetKey (key);
+	loader.SetLoadMaterials (false);
+
+	return (Model*) loader.Load (TEST_FILENAME);
+}
+
+static bool IsSamePolygon (Polygon* first, Polygon* second)
+{
+	for (std::size_t index=0;index<Polygon::ATTRIBUTES_COUNT;index++) {
+		Polygon::PolygonAttribute attribute = (Polygon::PolygonAttribute) index;
+
+		std::size_t indicesCount = first->GetIndicesCount (attribute);
+
+		if (second->GetIndicesCount (attribute) != indicesCount) {
+			return false;
+		}
+
+		if (indicesCount > 0 && std::memcmp (first->GetIndices (attribute),
+			second->GetIndices (attribute), indicesCount * sizeof (int)) != 0) {
+			return false;
+		}
+	}
+
+	return true;
+}
+
+/*
+ * The buffers of the group, as the saver builds them from the source
+*/
+
+static bool IsSameGroupBuffers (Model* source, PolygonGroup* sourceGroup, const MeshCacheGroup* meshCacheGroup)
+{
+	std::vector<NormalMapVertexData> vertexBuffer;
+	std::vector<unsigned int> indexBuffer;
+
+	NormalMapModel3DRenderer::BuildVertexData (source, sourceGroup, vertexBuffer, indexBuffer);
+
+	MeshOptimizer::Optimize (vertexBuffer, indexBuffer);
+
+	if (meshCacheGroup == nullptr ||
+		meshCacheGroup->vertexStride != sizeof (NormalMapVertexData) ||
+		meshCacheGroup->verticesCount != vertexBuffer.size () ||
+		meshCacheGroup->indicesCount != indexBuffer.size () ||
+		meshCacheGroup->indexSize != MeshOptimizer::GetIndexSize (vertexBuffer.size ())) {
+		return false;
+	}
+
+	if (std::memcmp (meshCacheGroup->vertices, vertexBuffer.data (),
+		sizeof (NormalMapVertexData) * vertexBuffer.size ()) != 0) {
+		return false;
+	}
+
+	if (meshCacheGroup->indexSize == sizeof (unsigned short)) {
+		std::vector<unsigned short> shortBuffer (indexBuffer.begin (), indexBuffer.end ());
+
+		return std::memcmp (meshCacheGroup->indices, shortBuffer.data (),
+			sizeof (unsigned short) * shortBuffer.size ()) == 0;
+	}
+
+	return std::memcmp (meshCacheGroup->indices, indexBuffer.data (),
+		sizeof (unsigned int) * indexBuffer.size ()) == 0;
+}
+
+/*
+ * The buffers point into the mapped file, nothing was copied
+*/
+
+static bool IsMapped (MeshCache* meshCache, const void* data, std::size_t size)
+{
+	const char* begin = meshCache->GetFile ().GetData ();
+	const char* end = begin + meshCache->GetFile ().GetSize ();
+
+	return (const char*) data >= begin && (const char*) data + size <= end;
+}
+
+static void TestRoundTrip ()
+{
+	Model* source = LoadSource ();
+
+	MeshCacheKey key;
+
+	CHECK (MeshCache::ComputeKey (TEST_FILENAME, key));
+
+	MeshCacheSaver saver;
+
+	CHECK (saver.Save (source, TEST_FILENAME, key));
+	CHECK (MeshCacheLoader::IsValid (TEST_FILENAME, key));
+
+	Model* cached = LoadCache (key);
+
+	CHECK (cached != nullptr);
+
+	if (cached == nullptr) {
+		delete source;
+		return;
+	}
+
+	CHECK (cached->GetVertices () == source->GetVertices ());
+	CHECK (cached->GetNormals () == source->GetNormals ());
+	CHECK (cached->GetTexcoords () == source->GetTexcoords ());
+
+	BoundingBox* sourceBox = source->GetBoundingBox ();
+	BoundingBox* cachedBox = cached->GetBoundingBox ();
+
+	CHECK (std::memcmp (sourceBox, cachedBox, sizeof (BoundingBox)) == 0);
+
+	MeshCache* meshCache = cached->GetMeshCache ();
+
+	CHECK (meshCache != nullptr);
+	CHECK (cached->ObjectsCount () == source->ObjectsCount ());
+
+	std::size_t groupIndex = 0;
+
+	for (std::size_t i=0;i<source->ObjectsCount () && i<cached->ObjectsCount ();i++) {
+		ObjectModel* sourceObject = source->GetObject (i);
+		ObjectModel* cachedObject = cached->GetObject (i);
+
+		CHECK (cachedObject->GetName () == sourceObject->GetName ());
+		CHECK (cachedObject->GetPolygonCount () == sourceObject->GetPolygonCount ());
+
+		for (std::size_t j=0;j<sourceObject->GetPolygonCount () && j<cachedObject->GetPolygonCount ();j++) {
+			PolygonGroup* sourceGroup = sourceObject->GetPolygonGroup (j);
+			PolygonGroup* cachedGroup = cachedObject->GetPolygonGroup (j);
+
+			CHECK (cachedGroup->GetName () == sourceGroup->GetName ());
+			CHECK (cachedGroup->GetMaterialName () == sourceGroup->GetMaterialName ());
+			CHECK (cachedGroup->GetPolygonCount () == sourceGroup->GetPolygonCount ());
+
+			for (std::size_t k=0;k<sourceGroup->GetPolygonCount () && k<cachedGroup->GetPolygonCount ();k++) {
+				CHECK (IsSamePolygon (sourceGroup->GetPolygon (k), cachedGroup->GetPolygon (k)));
+			}
+
+			const MeshCacheGroup* meshCacheGroup = cachedGroup->GetMeshCacheGroup ();
+
+			CHECK (meshCacheGroup == meshCache->GetGroup (groupIndex ++));
+			CHECK (IsSameGroupBuffers (source, sourceGroup, meshCacheGroup));
+
+			if (meshCacheGroup != nullptr) {
+				CHECK (IsMapped (meshCache, meshCacheGroup->vertices, meshCacheGroup->verticesCount * meshCacheGroup->vertexStride));
+				CHECK (IsMapped (meshCache, meshCacheGroup->indices, meshCacheGroup->indicesCount * meshCacheGroup->indexSize));
+			}
+		}
+	}
+
+	CHECK (meshCache == nullptr || meshCache->GetGroupsCount () == groupIndex);
+
+	/*
+	 * The two quads of the first group, as four triangles
+	*/
+
+	PolygonGroup* frontGroup = cached->GetObject (1)->GetPolygonGroup (1);
+	const MeshCacheGroup* frontCacheGroup = frontGroup->GetMeshCacheGroup ();
+
+	CHECK (frontGroup->GetPolygonCount () == 4);
+	CHECK (frontCacheGroup != nullptr && frontCacheGroup->indicesCount == 12);
+
+	delete cached;
+	delete source;
+}
+
+/*
+ * A cache baked by another version, or from a source that changed since,
+ * is not loaded
+*/
+
+static void TestStaleCache ()
+{
+	std::string cacheFilename = MeshCache::GetCacheFilename (TEST_FILENAME);
+	std::string cache = ReadFile (cacheFilename);
+
+	MeshCacheKey key;
+
+	CHECK (MeshCache::ComputeKey (TEST_FILENAME, key));
+	CHECK (MeshCacheLoader::IsValid (TEST_FILENAME, key));
+
+	/*
+	 * The version follows the magic
+	*/
+
+	std::string oldVersionCache = cache;
+	uint32_t oldVersion = MESH_CACHE_VERSION - 1;
+
+	std::memcpy (&oldVersionCache [4], &oldVersion, sizeof (uint32_t));
+
+	WriteFile (cacheFilename, oldVersionCache);
+
+	CHECK (!MeshCacheLoader::IsValid (TEST_FILENAME, key));
+	CHECK (LoadCache (key) == nullptr);
+
+	WriteFile (cacheFilename, cache);
+
+	CHECK (MeshCacheLoader::IsValid (TEST_FILENAME, key));
+
+	/*
+	 * Any part of the key that differs
+	*/
+
+	MeshCacheKey otherKey = key;
+	otherKey.sourceModificationTime ++;
+
+	CHECK (!MeshCacheLoader::IsValid (TEST_FILENAME, otherKey));
+	CHECK (LoadCache (otherKey) == nullptr);
+
+	otherKey = key;
+	otherKey.sourceSize ++;
+
+	CHECK (LoadCache (otherKey) == nullptr);
+
+	otherKey = key;
+	otherKey.sourceHash ^= 1;
+
+	CHECK (LoadCache (otherKey) == nullptr);
+
+	/*
+	 * The source touched after the cache was baked
+	*/
+
+	struct utimbuf times;
+	times.actime = (time_t) key.sourceModificationTime + 10;
+	times.modtime = (time_t) key.sourceModificationTime + 10;
+
+	CHECK (utime (TEST_FILENAME, &times) == 0);
+
+	MeshCacheKey touchedKey;
+
+	CHECK (MeshCache::ComputeKey (TEST_FILENAME, touchedKey));
+	CHECK (touchedKey.sourceModificationTime != key.sourceModificationTime);
+	CHECK (!MeshCacheLoader::IsValid (TEST_FILENAME, touchedKey));
+	CHECK (LoadCache (touchedKey) == nullptr);
+}
+
+/*
+ * Every shorter file is rejected without reading past its end
+*/
+
+static void TestTruncatedCache ()
+{
+	/*
+	 * Baked again for the touched source
+	*/
+
+	std::string cacheFilename = MeshCache::GetCacheFilename (TEST_FILENAME);
+
+	MeshCacheKey key;
+
+	CHECK (MeshCache::ComputeKey (TEST_FILENAME, key));
+
+	Model* source = LoadSource ();
+
+	MeshCacheSaver saver;
+
+	CHECK (saver.Save (source, TEST_FILENAME, key));
+
+	delete source;
+
+	std::string cache = ReadFile (cacheFilename);
+
+	CHECK (!cache.empty ());
+
+	std::size_t acceptedCount = 0;
+
+	for (std::size_t size = 0; size < cache.size (); size++) {
+		WriteFile (cacheFilename, cache.substr (0, size));
+
+		Model* model = LoadCache (key);
+
+		if (model != nullptr) {
+			std::printf ("Cache cut to %zu of %zu bytes was loaded\n", size, cache.size ());
+
+			acceptedCount ++;
+			delete model;
+		}
+	}
+
+	CHECK (acceptedCount == 0);
+
+	WriteFile (cacheFilename, cache);
+
+	Model* model = LoadCache (key);
+
+	CHECK (model != nullptr);
+
+	delete model;
+}
+
+int main ()
+{
+	WriteSource ();
+
+	TestRoundTrip ();
+	TestStaleCache ();
+	TestTruncatedCache ();
+
+	std::remove (MeshCache::GetCacheFilename (TEST_FILENAME).c_str ());
+	std::remove (TEST_FILENAME);
+
+	return TestResult ("MeshCache");
+}
@@ -0,0 +1,250 @@
+#include <map>
+#include <string>
+#include <vector>
+#include <random>
+#include <algorithm>
+
+#include "Utils/MeshOptimizer/MeshOptimizer.h"
+
+#include "TestCheck.h"
+
+/*
+ * A grid expanded as the renderers expand their groups, one vertex for
+ * every corner, in a shuffled triangle order. After the optimizer every
+ * triangle has to keep the attributes of its corners, the triangles have
+ * to be the ones given, only in another order, and the cache has to miss
+ * no more often than with the welded triangles in their first order.
+*/
+
+#define TEST_GRID_SIZE 24
+#define TEST_SEAM_COLUMN 12
+
+struct TestVertex
+{
+	float position [3];
+	float normal [3];
+	float texcoord [2];
+};
+
+static std::string GetBytes (const TestVertex& vertex)
+{
+	return std::string ((const char*) &vertex, sizeof (TestVertex));
+}
+
+/*
+ * The corners of the column on the seam have their texcoords twice, the
+ * quads on its left end at 1 and the ones on its right start at 0
+*/
+
+static TestVertex GetGridVertex (std::size_t x, std::size_t y, bool isRightOfSeam)
+{
+	TestVertex vertex = {};
+
+	vertex.position [0] = (float) x;
+	vertex.position [1] = (float) y;
+	vertex.normal [2] = 1.0f;
+
+	float u = x < TEST_SEAM_COLUMN || (x == TEST_SEAM_COLUMN && !isRightOfSeam) ?
+		(float) x / TEST_SEAM_COLUMN : (float) (x - TEST_SEAM_COLUMN) / TEST_SEAM_COLUMN;
+
+	vertex.texcoord [0] = u;
+	vertex.texcoord [1] = (float) y / TEST_GRID_SIZE;
+
+	return vertex;
+}
+
+static void BuildGrid (std::vector<TestVertex>& vertices, std::vector<unsigned int>& indices)
+{
+	std::vector<TestVertex> triangles;
+
+	for (std::size_t y = 0; y < TEST_GRID_SIZE; y++) {
+		for (std::size_t x = 0; x < TEST_GRID_SIZE; x++) {
+			bool isRightOfSeam = x >= TEST_SEAM_COLUMN;
+
+			TestVertex corners [4] = {
+				GetGridVertex (x, y, isRightOfSeam),
+				GetGridVertex (x + 1, y, isRightOfSeam),
+				GetGridVertex (x + 1, y + 1, isRightOfSeam),
+				GetGridVertex (x, y + 1, isRightOfSeam)
+			};
+
+			triangles.insert (triangles.end (), { corners [0], corners [1], corners [2] });
+			triangles.insert (triangles.end (), { corners [0], corners [2], corners [3] });
+		}
+	}
+
+	std::vector<std::size_t> order (triangles.size () / 3);
+
+	for (std::size_t i = 0; i < order.size (); i++) {
+		order [i] = i;
+	}
+
+	std::shuffle (order.begin (), order.end (), std::mt19937 (7));
+
+	for (std::size_t triangle : order) {
+		for (std::size_t corner = 0; corner < 3; corner++) {
+			indices.push_back ((unsigned int) vertices.size ());
+			vertices.push_back (triangles [3 * triangle + corner]);
+		}
+	}
+}
+
+/*
+ * The bytes of every triangle, started at its smallest corner so the
+ * winding is kept, in sorted order
+*/
+
+static std::vector<std::string> GetTriangles (const std::vector<TestVertex>& vertices, const std::vector<unsigned int>& indices)
+{
+	std::vector<std::string> triangles;
+
+	for (std::size_t i = 0; i + 2 < indices.size (); i += 3) {
+		std::string corners [3];
+
+		for (std::size_t corner = 0; corner < 3; corner++) {
+			corners [corner] = GetBytes (vertices [indices [i + corner]]);
+		}
+
+		std::size_t first = std::min_element (corners, corners + 3) - corners;
+
+		triangles.push_back (corners [first] + corners [(first + 1) % 3] + corners [(first + 2) % 3]);
+	}
+
+	std::sort (triangles.begin (), triangles.end ());
+
+	return triangles;
+}
+
+static void TestGrid ()
+{
+	std::vector<TestVertex> vertices;
+	std::vector<unsigned int> indices;
+
+	BuildGrid (vertices, indices);
+
+	std::vector<TestVertex> inputVertices (vertices);
+	std::vector<unsigned int> inputIndices (indices);
+
+	MeshOptimizerStatistics statistics = MeshOptimizer::Optimize (vertices, indices);
+
+	/*
+	 * Every grid corner once, the seam column twice
+	*/
+
+	std::size_t uniqueCount = (TEST_GRID_SIZE + 1) * (TEST_GRID_SIZE + 1) + (TEST_GRID_SIZE + 1);
+
+	CHECK (vertices.size () == uniqueCount);
+	CHECK (indices.size () == inputIndices.size ());
+	CHECK (statistics.verticesBefore == inputVertices.size ());
+	CHECK (statistics.verticesAfter == uniqueCount);
+	CHECK (statistics.trianglesCount == inputIndices.size () / 3);
+
+	bool isInRange = true;
+
+	for (unsigned int index : indices) {
+		isInRange = isInRange && index < vertices.size ();
+	}
+
+	CHECK (isInRange);
+
+	if (!isInRange) {
+		return;
+	}
+
+	/*
+	 * No vertex twice, none left unused
+	*/
+
+	std::map<std::string, unsigned int> vertexIndices;
+
+	for (std::size_t i = 0; i < vertices.size (); i++) {
+		vertexIndices [GetBytes (vertices [i])] = (unsigned int) i;
+	}
+
+	CHECK (vertexIndices.size () == vertices.size ());
+
+	std::vector<bool> isUsed (vertices.size (), false);
+
+	for (unsigned int index : indices) {
+		isUsed [index] = true;
+	}
+
+	CHECK (std::find (isUsed.begin (), isUsed.end (), false) == isUsed.end ());
+
+	/*
+	 * The same triangles with the same corners, texcoords of the seam
+	 * included
+	*/
+
+	CHECK (GetTriangles (vertices, indices) == GetTriangles (inputVertices, inputIndices));
+
+	/*
+	 * The input welded in its own order is what the reordering has to
+	 * beat, or at least match
+	*/
+
+	std::vector<unsigned int> weldedIndices;
+
+	for (unsigned int index : inputIndices) {
+		weldedIndices.push_back (vertexIndices [GetBytes (inputVertices [index])]);
+	}
+
+	std::size_t weldedMisses = MeshOptimizer::CountCacheMisses (weldedIndices, vertices.size ());
+	std::size_t optimizedMisses = MeshOptimizer::CountCacheMisses (indices, vertices.size ());
+
+	CHECK (optimizedMisses <= weldedMisses);
+	CHECK (statistics.cacheMissesAfter == optimizedMisses);
+	CHECK (statistics.cacheMissesAfter <= statistics.cacheMissesBefore);
+	CHECK (statistics.cacheMissesBefore == inputIndices.size ());
+
+	/*
+	 * Vertices are in the order they are first fetched
+	*/
+
+	unsigned int nextIndex = 0;
+	bool isFetchOrdered = true;
+
+	for (unsigned int index : indices) {
+		if (index == nextIndex) {
+			nextIndex ++;
+		}
+		else if (index > nextIndex) {
+			isFetchOrdered = false;
+		}
+	}
+
+	CHECK (isFetchOrdered);
+
+	/*
+	 * Optimized once more, nothing changes
+	*/
+
+	std::vector<TestVertex> optimizedVertices (vertices);
+	std::vector<unsigned int> optimizedIndices (indices);
+
+	MeshOptimizer::Optimize (optimizedVertices, optimizedIndices);
+
+	CHECK (optimizedVertices.size () == vertices.size ());
+	CHECK (GetTriangles (optimizedVertices, optimizedIndices) == GetTriangles (vertices, indices));
+	CHECK (MeshOptimizer::CountCacheMisses (optimizedIndices, optimizedVertices.size ()) <= optimizedMisses);
+}
+
+static void TestEmpty ()
+{
+	std::vector<TestVertex> vertices;
+	std::vector<unsigned int> indices;
+
+	MeshOptimizerStatistics statistics = MeshOptimizer::Optimize (vertices, indices);
+
+	CHECK (vertices.empty ());
+	CHECK (indices.empty ());
+	CHECK (statistics.trianglesCount == 0);
+}
+
+int main ()
+{
+	TestGrid ();
+	TestEmpty ();
+
+	return TestResult ("MeshOptimizer");
+}
@@ -0,0 +1,311 @@
+#include <map>
+#include <vector>
+#include <cstring>
+
+#include "Wrappers/OpenGL/GL.h"
+#include "Wrappers/OpenGL/GLNullBackend.h"
+
+#include "Renderer/Pipeline.h"
+#include "Renderer/StreamingBuffer.h"
+#include "Renderer/IndirectDrawCommandBuilder.h"
+#include "Managers/MaterialManager.h"
+#include "Shader/Shader.h"
+
+#include "SceneGraph/Transform.h"
+#include "SceneGraph/TransformHierarchy.h"
+
+#include "TestCheck.h"
+
+/*
+ * Outside of a multi draw, the object matrices go to the object block in
+ * the streaming buffer and the materials to the material block. The
+ * programs get only the index of their entry, no matrix or material
+ * uniform is sent.
+*/
+
+#define TEST_OBJECTS_COUNT 3
+
+/*
+ * Keeps what the pipeline sends beside the index uniforms
+*/
+
+class BlocksBackend : public GLNullBackend
+{
+public:
+	std::map<GLint, GLint> intUniforms;
+	std::size_t matrixUniformsCount;
+	std::size_t materialUniformsCount;
+	std::size_t rangeBindsCount;
+	GLintptr lastRangeOffset;
+	std::size_t storageUploadsCount;
+	std::vector<unsigned char> lastStorageData;
+
+	BlocksBackend () :
+		matrixUniformsCount (0),
+		materialUniformsCount (0),
+		rangeBindsCount (0),
+		lastRangeOffset (0),
+		storageUploadsCount (0)
+	{
+
+	}
+
+	void Uniform1i (GLint location, GLint v0)
+	{
+		GLNullBackend::Uniform1i (location, v0);
+
+		intUniforms [location] = v0;
+	}
+
+	void Uniform1f (GLint location, GLfloat v0)
+	{
+		GLNullBackend::Uniform1f (location, v0);
+
+		materialUniformsCount ++;
+	}
+
+	void Uniform3fv (GLint location, GLsizei count, const GLfloat *value)
+	{
+		GLNullBackend::Uniform3fv (location, count, value);
+
+		materialUniformsCount ++;
+	}
+
+	void UniformMatrix3fv (GLint location, GLsizei count, GLboolean transpose, const GLfloat *value)
+	{
+		GLNullBackend::UniformMatrix3fv (location, count, transpose, value);
+
+		matrixUniformsCount ++;
+	}
+
+	void UniformMatrix4fv (GLint location, GLsizei count, GLboolean transpose, const GLfloat *value)
+	{
+		GLNullBackend::UniformMatrix4fv (location, count, transpose, value);
+
+		matrixUniformsCount ++;
+	}
+
+	void BindBufferRange (GLenum target, GLuint index, GLuint buffer, GLintptr offset, GLsizeiptr size)
+	{
+		GLNullBackend::BindBufferRange (target, index, buffer, offset, size);
+
+		if (target == GL_SHADER_STORAGE_BUFFER && index == PIPELINE_OBJECT_DATA_BINDING) {
+			rangeBindsCount ++;
+			lastRangeOffset = offset;
+		}
+	}
+
+	void BufferData (GLenum target, GLsizeiptr size, const GLvoid * data, GLenum usage)
+	{
+		GLNullBackend::BufferData (target, size, data, usage);
+
+		if (target == GL_SHADER_STORAGE_BUFFER) {
+			storageUploadsCount ++;
+			lastStorageData.assign ((const unsigned char*) data, (const unsigned char*) data + size);
+		}
+	}
+
+	const std::vector<unsigned char>& GetBufferData (GLuint buffer)
+	{
+		return _buffersData [buffer];
+	}
+};
+
+/*
+ * The entry the object index points to, in the region of the frame
+*/
+
+static bool IsObjectEntry (BlocksBackend* backend, int objectIndex, const glm::mat4& modelMatrix)
+{
+	StreamingBuffer* streamingBuffer = StreamingBuffer::Instance ();
+
+	const std::vector<unsigned char>& data = backend->GetBufferData (streamingBuffer->GetBuffer ());
+	std::size_t offset = streamingBuffer->GetRegionOffset () + objectIndex * sizeof (IndirectDrawData);
+
+	if (objectIndex < 0 || offset + sizeof (IndirectDrawData) > data.size ()) {
+		return false;
+	}
+
+	IndirectDrawData objectData;
+	std::memcpy (&objectData, data.data () + offset, sizeof (IndirectDrawData));
+
+	glm::mat4 normalMatrix = glm::mat4 (glm::transpose (glm::inverse (glm::mat3 (modelMatrix))));
+
+	return objectData.modelMatrix == modelMatrix && objectData.normalMatrix == normalMatrix;
+}
+
+static void TestObjectBlock (BlocksBackend* backend)
+{
+	StreamingBuffer* streamingBuffer = StreamingBuffer::Instance ();
+
+	Shader shader ("ObjectShader", GL::CreateProgram ());
+	int objectIndexLocation = shader.GetUniformLocation ("objectIndex");
+
+	std::vector<Transform*> transforms;
+
+	for (std::size_t index = 0; index < TEST_OBJECTS_COUNT; index++) {
+		transforms.push_back (new Transform ());
+		transforms.back ()->SetPosition (glm::vec3 ((float) index, 2.0f, -1.0f));
+		transforms.back ()->SetScale (glm::vec3 (1.0f + index));
+	}
+
+	TransformHierarchy::Instance ()->Update ();
+
+	/*
+	 * Every object gets the next entry of the frame
+	*/
+
+	streamingBuffer->BeginFrame ();
+
+	Pipeline::SetShader (&shader);
+
+	for (std::size_t index = 0; index < TEST_OBJECTS_COUNT; index++) {
+		Pipeline::SetObjectTransform (transforms [index]);
+		Pipeline::UpdateMatrices (&shader);
+
+		CHECK (backend->intUniforms [objectIndexLocation] == (int) index);
+		CHECK (IsObjectEntry (backend, backend->intUniforms [objectIndexLocation], transforms [index]->GetModelMatrix ()));
+	}
+
+	CHECK (backend->matrixUniformsCount == 0);
+	CHECK (backend->rangeBindsCount == 1);
+	CHECK (backend->lastRangeOffset == (GLintptr) streamingBuffer->GetRegionOffset ());
+
+	/*
+	 * An object drawn again in the same frame keeps its entry
+	*/
+
+	std::size_t availableSize = streamingBuffer->GetAvailableSize (1);
+
+	Pipeline::UpdateMatrices (&shader);
+
+	CHECK (streamingBuffer->GetAvailableSize (1) == availableSize);
+	CHECK (backend->intUniforms [objectIndexLocation] == TEST_OBJECTS_COUNT - 1);
+
+	streamingBuffer->EndFrame ();
+
+	/*
+	 * The next frame writes it again, in the region of that frame
+	*/
+
+	streamingBuffer->BeginFrame ();
+
+	Pipeline::UpdateMatrices (&shader);
+
+	CHECK (backend->rangeBindsCount == 2);
+	CHECK (backend->lastRangeOffset == (GLintptr) streamingBuffer->GetRegionOffset ());
+	CHECK (backend->intUniforms [objectIndexLocation] == 0);
+	CHECK (IsObjectEntry (backend, 0, transforms.back ()->GetModelMatrix ()));
+
+	streamingBuffer->EndFrame ();
+
+	CHECK (backend->matrixUniformsCount == 0);
+
+	for (Transform* transform : transforms) {
+		delete transform;
+	}
+}
+
+/*
+ * The entry of a material in the last upload of the material block
+*/
+
+static bool IsMaterialEntry (BlocksBackend* backend, Material* material)
+{
+	std::size_t offset = material->id * sizeof (MaterialBlockData);
+
+	if (offset + sizeof (MaterialBlockData) > backend->lastStorageData.size ()) {
+		return false;
+	}
+
+	MaterialBlockData materialData;
+	std::memcpy (&materialData, backend->lastStorageData.data () + offset, sizeof (MaterialBlockData));
+
+	return materialData.diffuseColor == glm::vec4 (material->diffuseColor, 1.0f) &&
+		materialData.specularColor == glm::vec4 (material->specularColor, material->shininess);
+}
+
+static Material* AddMaterial (const std::string& name, float value)
+{
+	Material* material = new Material ();
+
+	material->name = name;
+	material->diffuseColor = glm::vec3 (value, 0.5f, 0.25f);
+	material->specularColor = glm::vec3 (0.125f, value, 1.0f);
+	material->shininess = 10.0f * value;
+
+	MaterialManager::Instance ().AddMaterial (material);
+
+	return material;
+}
+
+static void TestMaterialBlock (BlocksBackend* backend)
+{
+	StreamingBuffer* streamingBuffer = StreamingBuffer::Instance ();
+	MaterialManager& materialManager = MaterialManager::Instance ();
+
+	Material* first = AddMaterial ("TestFirst", 0.5f);
+	Material* second = AddMaterial ("TestSecond", 0.75f);
+
+	CHECK (first->id != MATERIAL_DEFAULT_ID);
+	CHECK (second->id != first->id);
+	CHECK (materialManager.GetMaterial (second->id) == second);
+
+	Shader shader ("MaterialShader", GL::CreateProgram ());
+	int materialIndexLocation = shader.GetUniformLocation ("materialIndex");
+
+	streamingBuffer->BeginFrame ();
+
+	std::size_t uploadsCount = backend->storageUploadsCount;
+
+	/*
+	 * The block is uploaded once with every material loaded so far
+	*/
+
+	Pipeline::SendMaterial (first, &shader);
+
+	CHECK (backend->storageUploadsCount == uploadsCount + 1);
+	CHECK (backend->lastStorageData.size () == sizeof (MaterialBlockData) * materialManager.GetMaterialsCount ());
+	CHECK (backend->intUniforms [materialIndexLocation] == (int) first->id);
+	CHECK (IsMaterialEntry (backend, first));
+	CHECK (IsMaterialEntry (backend, second));
+	CHECK (IsMaterialEntry (backend, materialManager.Default ()));
+
+	Pipeline::SendMaterial (second, &shader);
+
+	CHECK (backend->storageUploadsCount == uploadsCount + 1);
+	CHECK (backend->intUniforms [materialIndexLocation] == (int) second->id);
+
+	/*
+	 * A material loaded later brings the block up to date
+	*/
+
+	Material* third = AddMaterial ("TestThird", 1.0f);
+
+	Pipeline::SendMaterial (second, &shader);
+
+	CHECK (backend->storageUploadsCount == uploadsCount + 2);
+	CHECK (IsMaterialEntry (backend, third));
+
+	streamingBuffer->EndFrame ();
+
+	CHECK (backend->materialUniformsCount == 0);
+	CHECK (backend->matrixUniformsCount == 0);
+}
+
+int main ()
+{
+	BlocksBackend* backend = new BlocksBackend ();
+
+	GL::SetBackend (backend);
+
+	TestObjectBlock (backend);
+	TestMaterialBlock (backend);
+
+	/*
+	 * The null backend stays, the streaming buffer deletes its buffer
+	 * when the program exits
+	*/
+
+	return TestResult ("PipelineBlocks");
+}
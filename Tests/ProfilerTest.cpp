@@ -0,0 +1,490 @@
+#include <string>
+#include <vector>
+#include <thread>
+#include <atomic>
+#include <fstream>
+#include <sstream>
+#include <cstdio>
+#include <cctype>
+#include <algorithm>
+
+#include "Debug/Profiler/ProfilerBuffer.h"
+#include "Debug/Profiler/ProfilerTrace.h"
+
+#include "TestCheck.h"
+
+/*
+ * Threads record nested scopes in buffers of their own while a flusher
+ * drains them, as the profiler does. Every scope has to come back whole,
+ * at its depth and inside the scope around it, with the events of each
+ * thread in the order they were recorded.
+*/
+
+#define TEST_THREADS_COUNT 4
+#define TEST_FRAMES_COUNT 20000
+#define TEST_DEPTH 3
+#define TEST_TRACE_FILENAME "ProfilerTest.json"
+
+/*
+ * The times of a thread are a counter, so the order they come back in
+ * is the order they were recorded in
+*/
+
+static void RecordScopes (ProfilerBuffer* buffer, std::uint64_t& time, std::size_t depth)
+{
+	while (!buffer->Push (time, (std::uint32_t) depth, PROFILER_EVENT_BEGIN)) {
+		std::this_thread::yield ();
+	}
+
+	time ++;
+
+	if (depth + 1 < TEST_DEPTH) {
+		RecordScopes (buffer, time, depth + 1);
+		RecordScopes (buffer, time, depth + 1);
+	}
+
+	while (!buffer->Push (time, (std::uint32_t) depth, PROFILER_EVENT_END)) {
+		std::this_thread::yield ();
+	}
+
+	time ++;
+}
+
+static void TestThreads ()
+{
+	std::vector<ProfilerBuffer*> buffers;
+
+	for (std::size_t thread = 0; thread < TEST_THREADS_COUNT; thread++) {
+		buffers.push_back (new ProfilerBuffer ((std::uint16_t) thread));
+	}
+
+	std::vector<std::string> names = {"Frame", "Pass", "Draw"};
+
+	ProfilerTrace trace (names);
+
+	std::atomic<std::size_t> runningThreadsCount (TEST_THREADS_COUNT);
+	std::vector<std::uint64_t> lastTimes (TEST_THREADS_COUNT, 0);
+	std::size_t unorderedEventsCount = 0;
+
+	std::thread flusher ([&] () {
+		std::vector<ProfilerEvent> events;
+
+		bool isLastFlush = false;
+
+		while (!isLastFlush) {
+			isLastFlush = runningThreadsCount.load () == 0;
+
+			events.clear ();
+
+			for (ProfilerBuffer* buffer : buffers) {
+				buffer->Pop (events);
+			}
+
+			for (const ProfilerEvent& event : events) {
+				if (event.time < lastTimes [event.thread]) {
+					unorderedEventsCount ++;
+				}
+
+				lastTimes [event.thread] = event.time;
+			}
+
+			trace.AddEvents (events);
+		}
+	});
+
+	std::vector<std::thread> threads;
+
+	for (std::size_t thread = 0; thread < TEST_THREADS_COUNT; thread++) {
+		threads.push_back (std::thread ([&buffers, &runningThreadsCount, thread] () {
+			std::uint64_t time = 1;
+
+			for (std::size_t frame = 0; frame < TEST_FRAMES_COUNT; frame++) {
+				RecordScopes (buffers [thread], time, 0);
+			}
+
+			runningThreadsCount.fetch_sub (1);
+		}));
+	}
+
+	for (std::thread& thread : threads) {
+		thread.join ();
+	}
+
+	flusher.join ();
+
+	CHECK (unorderedEventsCount == 0);
+	CHECK (trace.GetUnmatchedEventsCount () == 0);
+
+	/*
+	 * Every frame is a tree of 1 + 2 + 4 scopes
+	*/
+
+	const std::vector<ProfilerScope>& scopes = trace.GetScopes ();
+
+	std::size_t scopesPerFrame = (1 << TEST_DEPTH) - 1;
+
+	CHECK (scopes.size () == TEST_THREADS_COUNT * TEST_FRAMES_COUNT * scopesPerFrame);
+
+	std::vector<std::size_t> scopesCounts (TEST_THREADS_COUNT * TEST_DEPTH, 0);
+	std::size_t misplacedScopesCount = 0;
+
+	std::vector<std::vector<ProfilerScope>> openScopes (TEST_THREADS_COUNT);
+
+	for (const ProfilerScope& scope : scopes) {
+		scopesCounts [scope.thread * TEST_DEPTH + scope.depth] ++;
+
+		if (scope.name != scope.depth || scope.end <= scope.begin) {
+			misplacedScopesCount ++;
+		}
+
+		/*
+		 * Scopes are closed inner first, a scope holds the ones of the
+		 * next depth closed before it since its begin
+		*/
+
+		std::vector<ProfilerScope>& children = openScopes [scope.thread];
+
+		std::size_t childrenCount = 0;
+
+		while (!children.empty () && children.back ().depth == scope.depth + 1 &&
+			children.back ().begin > scope.begin) {
+			misplacedScopesCount += children.back ().end < scope.end ? 0 : 1;
+
+			children.pop_back ();
+			childrenCount ++;
+		}
+
+		if (scope.depth + 1 < TEST_DEPTH && childrenCount != 2) {
+			misplacedScopesCount ++;
+		}
+
+		children.push_back (scope);
+	}
+
+	CHECK (misplacedScopesCount == 0);
+
+	for (std::size_t thread = 0; thread < TEST_THREADS_COUNT; thread++) {
+		for (std::size_t depth = 0; depth < TEST_DEPTH; depth++) {
+			CHECK (scopesCounts [thread * TEST_DEPTH + depth] == TEST_FRAMES_COUNT * ((std::size_t) 1 << depth));
+		}
+	}
+
+	for (ProfilerBuffer* buffer : buffers) {
+		delete buffer;
+	}
+}
+
+/*
+ * A full buffer takes no more begins but keeps room for the ends of the
+ * scopes already begun
+*/
+
+static void TestFullBuffer ()
+{
+	ProfilerBuffer buffer (7);
+
+	std::size_t beginsCount = 0;
+
+	while (buffer.Push (beginsCount, 0, PROFILER_EVENT_BEGIN)) {
+		beginsCount ++;
+	}
+
+	CHECK (beginsCount == PROFILER_BUFFER_EVENTS_COUNT - PROFILER_BUFFER_RESERVED_EVENTS_COUNT + 1);
+	CHECK (buffer.GetDroppedEventsCount () == 1);
+	CHECK (!buffer.Push (0, 0, PROFILER_EVENT_FRAME));
+
+	for (std::size_t index = 0; index < PROFILER_BUFFER_RESERVED_EVENTS_COUNT - 1; index++) {
+		CHECK (buffer.Push (beginsCount + index, 0, PROFILER_EVENT_END));
+	}
+
+	CHECK (!buffer.Push (0, 0, PROFILER_EVENT_END));
+	CHECK (buffer.GetDroppedEventsCount () == 3);
+
+	std::vector<ProfilerEvent> events;
+
+	CHECK (buffer.Pop (events) == PROFILER_BUFFER_EVENTS_COUNT);
+	CHECK (events.front ().thread == 7);
+	CHECK (events.front ().type == PROFILER_EVENT_BEGIN);
+	CHECK (events.back ().type == PROFILER_EVENT_END);
+
+	/*
+	 * Drained, it takes begins again
+	*/
+
+	CHECK (buffer.Pop (events) == 0);
+	CHECK (buffer.Push (0, 0, PROFILER_EVENT_BEGIN));
+}
+
+/*
+ * Syntax check of the JSON of the trace. Counts the objects with a
+ * given "ph" value on the way.
+*/
+
+class JSONChecker
+{
+protected:
+	std::string _text;
+	std::size_t _position;
+	std::string _lastString;
+
+public:
+	std::size_t completeEventsCount;
+	std::size_t instantEventsCount;
+	std::vector<std::string> names;
+
+	JSONChecker (const std::string& text) :
+		_text (text),
+		_position (0),
+		_lastString (),
+		completeEventsCount (0),
+		instantEventsCount (0),
+		names ()
+	{
+
+	}
+
+	bool Check ()
+	{
+		if (!CheckValue ()) {
+			return false;
+		}
+
+		SkipSpaces ();
+
+		return _position == _text.size ();
+	}
+protected:
+	void SkipSpaces ()
+	{
+		while (_position < _text.size () && std::isspace ((unsigned char) _text [_position])) {
+			_position ++;
+		}
+	}
+
+	bool Expect (char character)
+	{
+		SkipSpaces ();
+
+		if (_position >= _text.size () || _text [_position] != character) {
+			return false;
+		}
+
+		_position ++;
+
+		return true;
+	}
+
+	bool CheckValue ()
+	{
+		SkipSpaces ();
+
+		if (_position >= _text.size ()) {
+			return false;
+		}
+
+		char character = _text [_position];
+
+		if (character == '{') {
+			return CheckObject ();
+		}
+
+		if (character == '[') {
+			return CheckArray ();
+		}
+
+		if (character == '"') {
+			return CheckString ();
+		}
+
+		if (_text.compare (_position, 4, "true") == 0 || _text.compare (_position, 4, "null") == 0) {
+			_position += 4;
+			return true;
+		}
+
+		if (_text.compare (_position, 5, "false") == 0) {
+			_position += 5;
+			return true;
+		}
+
+		return CheckNumber ();
+	}
+
+	bool CheckObject ()
+	{
+		Expect ('{');
+
+		if (Expect ('}')) {
+			return true;
+		}
+
+		do {
+			SkipSpaces ();
+
+			if (!CheckString ()) {
+				return false;
+			}
+
+			std::string key = _lastString;
+
+			if (!Expect (':') || !CheckValue ()) {
+				return false;
+			}
+
+			if (key == "ph") {
+				completeEventsCount += _lastString == "X" ? 1 : 0;
+				instantEventsCount += _lastString == "i" ? 1 : 0;
+			}
+
+			if (key == "name") {
+				names.push_back (_lastString);
+			}
+		} while (Expect (','));
+
+		return Expect ('}');
+	}
+
+	bool CheckArray ()
+	{
+		Expect ('[');
+
+		if (Expect (']')) {
+			return true;
+		}
+
+		do {
+			if (!CheckValue ()) {
+				return false;
+			}
+		} while (Expect (','));
+
+		return Expect (']');
+	}
+
+	bool CheckString ()
+	{
+		if (_position >= _text.size () || _text [_position] != '"') {
+			return false;
+		}
+
+		_lastString.clear ();
+
+		for (_position++; _position < _text.size (); _position++) {
+			char character = _text [_position];
+
+			if ((unsigned char) character < 0x20) {
+				return false;
+			}
+
+			if (character == '"') {
+				_position ++;
+				return true;
+			}
+
+			if (character == '\\') {
+				_position ++;
+
+				if (_position >= _text.size () || std::string ("\"\\/bfnrtu").find (_text [_position]) == std::string::npos) {
+					return false;
+				}
+
+				character = _text [_position];
+			}
+
+			_lastString += character;
+		}
+
+		return false;
+	}
+
+	bool CheckNumber ()
+	{
+		std::size_t start = _position;
+
+		if (_position < _text.size () && _text [_position] == '-') {
+			_position ++;
+		}
+
+		while (_position < _text.size () && (std::isdigit ((unsigned char) _text [_position]) ||
+			_text [_position] == '.' || _text [_position] == 'e' || _text [_position] == 'E' ||
+			_text [_position] == '+' || _text [_position] == '-')) {
+			_position ++;
+		}
+
+		return _position > start && std::isdigit ((unsigned char) _text [_position - 1]);
+	}
+};
+
+static std::string ExportTrace (const ProfilerTrace& trace)
+{
+	CHECK (trace.ExportChromeTrace (TEST_TRACE_FILENAME));
+
+	std::ifstream inStream (TEST_TRACE_FILENAME);
+	std::stringstream text;
+
+	text << inStream.rdbuf ();
+
+	std::remove (TEST_TRACE_FILENAME);
+
+	return text.str ();
+}
+
+static void TestChromeTrace ()
+{
+	/*
+	 * Names with what JSON has to escape
+	*/
+
+	std::vector<std::string> names = {"Render \"Pass\"", "C:\\Path", "Tab\there", "Plain"};
+
+	ProfilerTrace trace (names);
+
+	std::vector<ProfilerEvent> events = {
+		{ 1000, 0, 0, PROFILER_EVENT_BEGIN },
+		{ 2000, 1, 0, PROFILER_EVENT_BEGIN },
+		{ 2500, 1, 0, PROFILER_EVENT_END },
+		{ 2600, 2, 1, PROFILER_EVENT_BEGIN },
+		{ 2700, 3, 1, PROFILER_EVENT_END },
+		{ 2800, 2, 1, PROFILER_EVENT_END },
+		{ 3000, 1, 0, PROFILER_EVENT_FRAME },
+		{ 4000, 0, 0, PROFILER_EVENT_END },
+		{ 5000, 9, 0, PROFILER_EVENT_BEGIN },
+		{ 6000, 9, 0, PROFILER_EVENT_END },
+		{ 7000, 3, 2, PROFILER_EVENT_BEGIN }
+	};
+
+	trace.AddEvents (events);
+
+	CHECK (trace.GetScopes ().size () == 4);
+	CHECK (trace.GetFramesCount () == 1);
+	CHECK (trace.GetUnmatchedEventsCount () == 1);
+
+	JSONChecker checker (ExportTrace (trace));
+
+	CHECK (checker.Check ());
+	CHECK (checker.completeEventsCount == 4);
+	CHECK (checker.instantEventsCount == 1);
+
+	std::vector<std::string> expectedNames = {"Render \"Pass\"", "C:\\Path", "Tabhere", "Unknown"};
+
+	for (const std::string& name : expectedNames) {
+		CHECK (std::find (checker.names.begin (), checker.names.end (), name) != checker.names.end ());
+	}
+
+	/*
+	 * An empty trace is still a whole document
+	*/
+
+	JSONChecker emptyChecker (ExportTrace (ProfilerTrace (names)));
+
+	CHECK (emptyChecker.Check ());
+	CHECK (emptyChecker.completeEventsCount == 0);
+}
+
+int main ()
+{
+	TestThreads ();
+	TestFullBuffer ();
+	TestChromeTrace ();
+
+	return TestResult ("Profiler");
+}
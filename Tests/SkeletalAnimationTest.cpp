@@ -0,0 +1,190 @@
+#include <vector>
+#include <random>
+#include <cmath>
+#include <algorithm>
+
+#include "Mesh/AnimationModel.h"
+#include "Mesh/SkeletalAnimation.h"
+
+#include "../Benchmarks/SkeletalAnimationGenerator.h"
+
+#include "TestCheck.h"
+
+/*
+ * The flattened skeleton evaluation against the recursive evaluator it
+ * replaced, over time running forward across loops, random jumps back
+ * and forth and instances of the same model evaluated in turns.
+*/
+
+#define TEST_STEPS_COUNT 4000
+#define TEST_STEP_SECONDS (1.0f / 60.0f)
+#define TEST_JUMPS_COUNT 1000
+#define TEST_INSTANCES_COUNT 4
+#define TEST_TOLERANCE 1e-5f
+
+static float MaxDifference (const std::vector<glm::mat4>& first, const std::vector<glm::mat4>& second)
+{
+	float difference = 0.0f;
+
+	for (std::size_t index = 0; index < first.size (); index++) {
+		for (int column = 0; column < 4; column++) {
+			for (int row = 0; row < 4; row++) {
+				difference = std::max (difference, std::fabs (first [index][column][row] - second [index][column][row]));
+			}
+		}
+	}
+
+	return difference;
+}
+
+static void TestSkeleton (AnimationModel* animationModel)
+{
+	SkeletalAnimation* skeletalAnimation = animationModel->GetSkeletalAnimation ();
+
+	CHECK (skeletalAnimation->GetJointsCount () == SKELETAL_ANIMATION_NODES_COUNT);
+	CHECK (skeletalAnimation->GetBonesCount () == SKELETAL_ANIMATION_BONES_COUNT);
+
+	/*
+	 * Ticks of the looping animation
+	*/
+
+	float duration = SKELETAL_ANIMATION_DURATION / SKELETAL_ANIMATION_TICKS_PER_SECOND;
+
+	CHECK (skeletalAnimation->GetAnimationTime (0.0f) == 0.0f);
+	CHECK (std::fabs (skeletalAnimation->GetAnimationTime (duration * 2.5f) - SKELETAL_ANIMATION_DURATION * 0.5f) < 1e-3f);
+}
+
+/*
+ * Time goes forward over a few loops of the animation, so the cursors
+ * move forward and restart at every wrap
+*/
+
+static void TestForward (AnimationModel* animationModel)
+{
+	SkeletalAnimation* skeletalAnimation = animationModel->GetSkeletalAnimation ();
+	RecursiveSkeletalAnimation recursiveAnimation (animationModel);
+
+	SkeletalAnimationPose pose;
+	skeletalAnimation->InitPose (pose);
+
+	std::vector<glm::mat4> expected;
+
+	float maxDifference = 0.0f;
+	std::size_t wrapsCount = 0;
+	float lastTime = 0.0f;
+
+	for (std::size_t step = 0; step < TEST_STEPS_COUNT; step++) {
+		float animationTime = skeletalAnimation->GetAnimationTime (step * TEST_STEP_SECONDS);
+
+		if (animationTime < lastTime) {
+			wrapsCount ++;
+		}
+
+		lastTime = animationTime;
+
+		skeletalAnimation->Evaluate (animationTime, pose);
+		recursiveAnimation.Evaluate (animationTime, expected);
+
+		CHECK (pose.bonesTransforms.size () == expected.size ());
+
+		maxDifference = std::max (maxDifference, MaxDifference (pose.bonesTransforms, expected));
+	}
+
+	CHECK (wrapsCount >= 2);
+	CHECK (maxDifference <= TEST_TOLERANCE);
+}
+
+/*
+ * Random times, half of them before the previous one, and the times of
+ * the keys themselves
+*/
+
+static void TestJumps (AnimationModel* animationModel)
+{
+	SkeletalAnimation* skeletalAnimation = animationModel->GetSkeletalAnimation ();
+	RecursiveSkeletalAnimation recursiveAnimation (animationModel);
+
+	SkeletalAnimationPose pose;
+	skeletalAnimation->InitPose (pose);
+
+	std::vector<glm::mat4> expected;
+
+	std::mt19937 random (11);
+	std::uniform_real_distribution<float> time (0.0f, SKELETAL_ANIMATION_DURATION);
+
+	float maxDifference = 0.0f;
+
+	for (std::size_t jump = 0; jump < TEST_JUMPS_COUNT; jump++) {
+		float animationTime = jump % 5 == 0 ?
+			SKELETAL_ANIMATION_DURATION * (random () % (SKELETAL_ANIMATION_KEYS_COUNT - 1)) / (SKELETAL_ANIMATION_KEYS_COUNT - 1) :
+			time (random);
+
+		skeletalAnimation->Evaluate (animationTime, pose);
+		recursiveAnimation.Evaluate (animationTime, expected);
+
+		maxDifference = std::max (maxDifference, MaxDifference (pose.bonesTransforms, expected));
+	}
+
+	CHECK (maxDifference <= TEST_TOLERANCE);
+}
+
+/*
+ * Instances share the skeleton but not the cursors, each one is at its
+ * own time and they are evaluated in turns
+*/
+
+static void TestInstances (AnimationModel* animationModel)
+{
+	SkeletalAnimation* skeletalAnimation = animationModel->GetSkeletalAnimation ();
+	RecursiveSkeletalAnimation recursiveAnimation (animationModel);
+
+	std::vector<SkeletalAnimationPose> poses (TEST_INSTANCES_COUNT);
+
+	for (SkeletalAnimationPose& pose : poses) {
+		skeletalAnimation->InitPose (pose);
+	}
+
+	std::vector<glm::mat4> expected;
+
+	float maxDifference = 0.0f;
+
+	for (std::size_t step = 0; step < TEST_STEPS_COUNT / TEST_INSTANCES_COUNT; step++) {
+		for (std::size_t instance = 0; instance < TEST_INSTANCES_COUNT; instance++) {
+			float time = step * TEST_STEP_SECONDS * (instance + 1) + instance * 0.37f;
+			float animationTime = skeletalAnimation->GetAnimationTime (time);
+
+			skeletalAnimation->Evaluate (animationTime, poses [instance]);
+			recursiveAnimation.Evaluate (animationTime, expected);
+
+			maxDifference = std::max (maxDifference, MaxDifference (poses [instance].bonesTransforms, expected));
+		}
+	}
+
+	CHECK (maxDifference <= TEST_TOLERANCE);
+
+	/*
+	 * A pose never initialized is sized by its first evaluation
+	*/
+
+	SkeletalAnimationPose pose;
+
+	skeletalAnimation->Evaluate (1.0f, pose);
+	recursiveAnimation.Evaluate (1.0f, expected);
+
+	CHECK (pose.bonesTransforms.size () == SKELETAL_ANIMATION_BONES_COUNT);
+	CHECK (MaxDifference (pose.bonesTransforms, expected) <= TEST_TOLERANCE);
+}
+
+int main ()
+{
+	AnimationModel* animationModel = GenerateSkeletalAnimationModel ();
+
+	TestSkeleton (animationModel);
+	TestForward (animationModel);
+	TestJumps (animationModel);
+	TestInstances (animationModel);
+
+	delete animationModel;
+
+	return TestResult ("SkeletalAnimation");
+}
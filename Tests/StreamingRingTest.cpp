@@ -0,0 +1,254 @@
+#include <set>
+#include <vector>
+#include <cstdint>
+
+#include "Renderer/StreamingRing.h"
+
+#include "TestCheck.h"
+
+/*
+ * Fences of a GPU the test runs by hand. A fence is done once the test
+ * completes it, waiting on one that is not done blocks until the GPU
+ * gets to it. The ring owns its fences, the count of the fences alive
+ * is kept by the test.
+*/
+
+class TestFence : public StreamingFence
+{
+public:
+	std::set<std::size_t> inFlightFences;
+	std::vector<std::size_t> waitedFences;
+	std::size_t lastFence;
+	std::size_t& fencesCount;
+
+	TestFence (std::size_t& fencesCount) :
+		inFlightFences (),
+		waitedFences (),
+		lastFence (0),
+		fencesCount (fencesCount)
+	{
+
+	}
+
+	void* Insert ()
+	{
+		lastFence ++;
+		fencesCount ++;
+
+		inFlightFences.insert (lastFence);
+
+		return (void*) (std::uintptr_t) lastFence;
+	}
+
+	bool Wait (void* fence)
+	{
+		std::size_t id = (std::size_t) (std::uintptr_t) fence;
+
+		waitedFences.push_back (id);
+
+		return inFlightFences.erase (id) > 0;
+	}
+
+	void Delete (void* fence)
+	{
+		inFlightFences.erase ((std::size_t) (std::uintptr_t) fence);
+
+		fencesCount --;
+	}
+
+	void CompleteAll ()
+	{
+		inFlightFences.clear ();
+	}
+};
+
+#define TEST_REGION_SIZE 1024
+
+static void TestAllocate ()
+{
+	std::size_t fencesCount = 0;
+
+	TestFence* fence = new TestFence (fencesCount);
+	StreamingRing ring (TEST_REGION_SIZE, fence);
+
+	CHECK (ring.GetSize () == TEST_REGION_SIZE * STREAMING_RING_REGIONS_COUNT);
+
+	/*
+	 * Nothing is given outside of a frame
+	*/
+
+	CHECK (ring.Allocate (16, 4) == STREAMING_RING_INVALID_OFFSET);
+	CHECK (ring.GetAvailableSize (4) == 0);
+
+	ring.BeginFrame ();
+
+	CHECK (ring.GetAvailableSize (4) == TEST_REGION_SIZE);
+	CHECK (ring.GetAvailableSize (0) == 0);
+
+	CHECK (ring.GetRegion () == 0);
+	CHECK (ring.Allocate (16, 0) == STREAMING_RING_INVALID_OFFSET);
+
+	/*
+	 * Offsets are aligned from the start of the buffer
+	*/
+
+	CHECK (ring.Allocate (10, 4) == 0);
+	CHECK (ring.Allocate (12, 16) == 16);
+	CHECK (ring.Allocate (1, 1) == 28);
+	CHECK (ring.Allocate (64, 48) == 48);
+	CHECK (ring.GetRegionUsedSize () == 112);
+	CHECK (ring.GetAvailableSize (1) == TEST_REGION_SIZE - 112);
+	CHECK (ring.GetAvailableSize (96) == TEST_REGION_SIZE - 192);
+	CHECK (ring.GetAvailableSize (TEST_REGION_SIZE) == 0);
+
+	/*
+	 * A region never spills in the next one
+	*/
+
+	CHECK (ring.Allocate (TEST_REGION_SIZE, 1) == STREAMING_RING_INVALID_OFFSET);
+	CHECK (ring.Allocate (TEST_REGION_SIZE - 112, 1) == 112);
+	CHECK (ring.Allocate (1, 1) == STREAMING_RING_INVALID_OFFSET);
+	CHECK (ring.GetAvailableSize (1) == 0);
+
+	ring.EndFrame ();
+
+	CHECK (ring.Allocate (1, 1) == STREAMING_RING_INVALID_OFFSET);
+
+	ring.BeginFrame ();
+
+	CHECK (ring.GetRegion () == 1);
+	CHECK (ring.GetRegionUsedSize () == 0);
+
+	/*
+	 * 48 is not a power of two, the offset is still a multiple of it
+	*/
+
+	CHECK (ring.Allocate (4, 48) == 1056);
+	CHECK (ring.Allocate (4, 1000) == 2000);
+	CHECK (ring.Allocate (48, 48) == STREAMING_RING_INVALID_OFFSET);
+
+	ring.EndFrame ();
+}
+
+static void TestWrapAround ()
+{
+	std::size_t fencesCount = 0;
+
+	TestFence* fence = new TestFence (fencesCount);
+
+	{
+		StreamingRing ring (TEST_REGION_SIZE, fence);
+
+		/*
+		 * The GPU keeps up, the ring goes around with no stall
+		*/
+
+		for (std::size_t frame = 0; frame < 3 * STREAMING_RING_REGIONS_COUNT; frame++) {
+			ring.BeginFrame ();
+
+			CHECK (ring.GetRegion () == frame % STREAMING_RING_REGIONS_COUNT);
+			CHECK (ring.Allocate (100, 4) == ring.GetRegion () * TEST_REGION_SIZE);
+
+			ring.EndFrame ();
+
+			fence->CompleteAll ();
+		}
+
+		CHECK (ring.GetStallsCount () == 0);
+		CHECK (fence->waitedFences.size () == 2 * STREAMING_RING_REGIONS_COUNT);
+		CHECK (fence->fencesCount == STREAMING_RING_REGIONS_COUNT);
+
+		/*
+		 * A frame that allocates nothing puts no fence, the next frame
+		 * on its region does not wait
+		*/
+
+		std::size_t waitsCount = fence->waitedFences.size ();
+
+		ring.BeginFrame ();
+		ring.EndFrame ();
+
+		CHECK (fence->waitedFences.size () == waitsCount + 1);
+
+		for (std::size_t frame = 0; frame < STREAMING_RING_REGIONS_COUNT; frame++) {
+			ring.BeginFrame ();
+			ring.EndFrame ();
+		}
+
+		CHECK (fence->waitedFences.size () == waitsCount + STREAMING_RING_REGIONS_COUNT);
+		CHECK (fence->fencesCount == 0);
+	}
+}
+
+static void TestBlocking ()
+{
+	std::size_t fencesCount = 0;
+
+	TestFence* fence = new TestFence (fencesCount);
+
+	{
+		StreamingRing ring (TEST_REGION_SIZE, fence);
+
+		/*
+		 * The GPU is behind. Each region is fenced once, the frame that
+		 * comes back to a region still in flight blocks on its fence.
+		*/
+
+		for (std::size_t frame = 0; frame < STREAMING_RING_REGIONS_COUNT; frame++) {
+			ring.BeginFrame ();
+			ring.Allocate (8, 8);
+			ring.EndFrame ();
+		}
+
+		CHECK (fence->inFlightFences.size () == STREAMING_RING_REGIONS_COUNT);
+		CHECK (fence->waitedFences.empty ());
+
+		ring.BeginFrame ();
+
+		CHECK (ring.GetRegion () == 0);
+		CHECK (ring.GetStallsCount () == 1);
+		CHECK (fence->waitedFences.size () == 1 && fence->waitedFences [0] == 1);
+		CHECK (fence->inFlightFences.count (1) == 0);
+		CHECK (fence->inFlightFences.size () == STREAMING_RING_REGIONS_COUNT - 1);
+
+		/*
+		 * A frame begun without ending the last one ends it first
+		*/
+
+		ring.Allocate (8, 8);
+		ring.BeginFrame ();
+
+		CHECK (ring.GetRegion () == 1);
+		CHECK (ring.GetStallsCount () == 2);
+		CHECK (fence->inFlightFences.size () == STREAMING_RING_REGIONS_COUNT - 1);
+
+		/*
+		 * Regions the GPU is done with are written with no stall
+		*/
+
+		fence->CompleteAll ();
+
+		ring.EndFrame ();
+		ring.BeginFrame ();
+
+		CHECK (ring.GetRegion () == 2);
+		CHECK (ring.GetStallsCount () == 2);
+
+		ring.EndFrame ();
+	}
+
+	/*
+	 * The fences left are deleted with the ring
+	*/
+
+	CHECK (fencesCount == 0);
+}
+
+int main ()
+{
+	TestAllocate ();
+	TestWrapAround ();
+	TestBlocking ();
+
+	return TestResult ("StreamingRing");
+}
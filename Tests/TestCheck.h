@@ -0,0 +1,28 @@
+#ifndef TESTCHECK_H
+#define TESTCHECK_H
+
+#include <cstdio>
+
+/*
+ * Checks of the unit tests. A failed check prints where it failed and
+ * the test goes on, its main returns the failures count.
+*/
+
+static int testFailuresCount = 0;
+
+#define CHECK(condition) \
+	do { \
+		if (!(condition)) { \
+			std::printf ("%s:%d: check failed: %s\n", __FILE__, __LINE__, #condition); \
+			testFailuresCount ++; \
+		} \
+	} while (0)
+
+inline int TestResult (const char* testName)
+{
+	std::printf ("%s: %s\n", testName, testFailuresCount == 0 ? "passed" : "failed");
+
+	return testFailuresCount == 0 ? 0 : 1;
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,166 @@
+#include "Mesh/Model.h"
+#include "Mesh/ObjectModel.h"
+#include "Mesh/PolygonGroup.h"
+
+#include "Utils/Triangulation/Triangulation.h"
+
+#include "TestCheck.h"
+
+/*
+ * Fans of convex polygons written into the shared arrays of the group,
+ * for every mix of attributes the loader gives: "f v", "f v/vt",
+ * "f v//vn" and "f v/vt/vn"
+*/
+
+static Model* BuildModel (PolygonGroup* polyGroup)
+{
+	Model* model = new Model ();
+
+	ObjectModel* objModel = new ObjectModel ("object");
+	objModel->AddPolygonGroup (polyGroup);
+
+	model->AddObjectModel (objModel);
+
+	return model;
+}
+
+static void TestAttributes ()
+{
+	int vertices [5] = { 0, 1, 2, 3, 4 };
+	int normals [5] = { 10, 11, 12, 13, 14 };
+	int texcoords [5] = { 20, 21, 22, 23, 24 };
+
+	PolygonGroup* polyGroup = new PolygonGroup ("group");
+
+	polyGroup->AddPolygon (vertices, 4, nullptr, 0, nullptr, 0);
+	polyGroup->AddPolygon (vertices, 4, nullptr, 0, texcoords, 4);
+	polyGroup->AddPolygon (vertices, 5, normals, 5, nullptr, 0);
+	polyGroup->AddPolygon (vertices, 3, normals, 3, texcoords, 3);
+
+	Model* model = BuildModel (polyGroup);
+
+	Triangulation::ConvexTriangulation (model);
+
+	PolygonGroup* result = model->GetObject ((std::size_t) 0)->GetPolygonGroup (0);
+
+	CHECK (result->GetPolygonCount () == 2 + 2 + 3 + 1);
+
+	/*
+	 * Every fan starts at the first corner of its polygon
+	*/
+
+	for (std::size_t i=0;i<result->GetPolygonCount ();i++) {
+		Polygon* polygon = result->GetPolygon (i);
+
+		CHECK (polygon->VertexCount () == 3);
+		CHECK (polygon->GetVertex (0) == 0);
+		CHECK (polygon->GetVertex (2) == polygon->GetVertex (1) + 1);
+	}
+
+	/*
+	 * f v
+	*/
+
+	CHECK (!result->GetPolygon (0)->HaveNormals ());
+	CHECK (!result->GetPolygon (1)->HaveUV ());
+
+	/*
+	 * f v/vt
+	*/
+
+	CHECK (!result->GetPolygon (2)->HaveNormals ());
+	CHECK (result->GetPolygon (3)->TexcoordsCount () == 3);
+	CHECK (result->GetPolygon (3)->GetTexcoord (0) == 20);
+	CHECK (result->GetPolygon (3)->GetTexcoord (1) == 22);
+	CHECK (result->GetPolygon (3)->GetTexcoord (2) == 23);
+
+	/*
+	 * f v//vn
+	*/
+
+	for (std::size_t i=4;i<7;i++) {
+		CHECK (result->GetPolygon (i)->NormalsCount () == 3);
+		CHECK (!result->GetPolygon (i)->HaveUV ());
+	}
+
+	CHECK (result->GetPolygon (6)->GetNormal (0) == 10);
+	CHECK (result->GetPolygon (6)->GetNormal (1) == 13);
+	CHECK (result->GetPolygon (6)->GetNormal (2) == 14);
+
+	/*
+	 * f v/vt/vn
+	*/
+
+	CHECK (result->GetPolygon (7)->NormalsCount () == 3);
+	CHECK (result->GetPolygon (7)->TexcoordsCount () == 3);
+
+	CHECK (result->GetIndices (Polygon::VERTEX_ATTRIBUTE).size () == 8 * 3);
+	CHECK (result->GetIndices (Polygon::NORMAL_ATTRIBUTE).size () == 4 * 3);
+	CHECK (result->GetIndices (Polygon::TEXCOORD_ATTRIBUTE).size () == 3 * 3);
+
+	delete model;
+}
+
+/*
+ * A stream shorter than the corners is dropped, not read past its end
+*/
+
+static void TestShortStreams ()
+{
+	int vertices [6] = { 0, 1, 2, 3, 4, 5 };
+	int normals [2] = { 10, 11 };
+	int texcoords [1] = { 20 };
+
+	PolygonGroup* polyGroup = new PolygonGroup ("group");
+
+	polyGroup->AddPolygon (vertices, 6, normals, 2, texcoords, 1);
+
+	Model* model = BuildModel (polyGroup);
+
+	Triangulation::ConvexTriangulation (model);
+
+	PolygonGroup* result = model->GetObject ((std::size_t) 0)->GetPolygonGroup (0);
+
+	CHECK (result->GetPolygonCount () == 4);
+
+	for (std::size_t i=0;i<result->GetPolygonCount ();i++) {
+		CHECK (!result->GetPolygon (i)->HaveNormals ());
+		CHECK (!result->GetPolygon (i)->HaveUV ());
+	}
+
+	CHECK (result->GetIndices (Polygon::NORMAL_ATTRIBUTE).empty ());
+	CHECK (result->GetIndices (Polygon::TEXCOORD_ATTRIBUTE).empty ());
+
+	delete model;
+
+	/*
+	 * Same for a polygon out of a group
+	*/
+
+	Polygon polygon;
+
+	for (std::size_t i=0;i<4;i++) {
+		polygon.AddVertex ((int) i);
+	}
+
+	polygon.AddNormal (10);
+
+	std::vector<Polygon*> fans = Triangulation::ConvexTriangulation (&polygon);
+
+	CHECK (fans.size () == 2);
+
+	for (Polygon* fan : fans) {
+		CHECK (fan->VertexCount () == 3);
+		CHECK (!fan->HaveNormals ());
+
+		delete fan;
+	}
+}
+
+int main ()
+{
+	TestAttributes ();
+	TestShortStreams ();
+
+	return TestResult ("Triangulation");
+}
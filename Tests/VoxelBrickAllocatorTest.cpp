@@ -0,0 +1,294 @@
+#include <vector>
+
+#include "RenderPasses/VoxelBrickAllocator.h"
+
+#include "TestCheck.h"
+
+/*
+ * Bricks of the 64 voxels volume with 3 levels and 16 voxels bricks:
+ * 4x4x4 bricks on the first level, 2x2x2 on the second and one on the
+ * last. A region is marked on every level, the coarse ones get their
+ * slots first.
+*/
+
+#define TEST_VOLUME_SIZE 64
+#define TEST_LEVELS_COUNT 3
+#define TEST_BRICK_SIZE 16
+#define TEST_CAPACITY 100
+
+static std::size_t CountChanges (const VoxelBrickAllocator& allocator, bool isAllocated)
+{
+	std::size_t changesCount = 0;
+
+	for (const VoxelBrickChange& change : allocator.GetChanges ()) {
+		if (change.isAllocated == isAllocated) {
+			changesCount ++;
+		}
+	}
+
+	return changesCount;
+}
+
+static void TestAllocation ()
+{
+	VoxelBrickAllocator allocator;
+	allocator.Init (TEST_VOLUME_SIZE, TEST_LEVELS_COUNT, glm::ivec3 (TEST_BRICK_SIZE), TEST_CAPACITY);
+
+	CHECK (allocator.GetLevelsCount () == TEST_LEVELS_COUNT);
+	CHECK (allocator.GetBricksCount (0) == glm::ivec3 (4));
+	CHECK (allocator.GetBricksCount (1) == glm::ivec3 (2));
+	CHECK (allocator.GetBricksCount (2) == glm::ivec3 (1));
+	CHECK (allocator.GetAllocatedBricksCount () == 0);
+
+	/*
+	 * Nothing marked, nothing changes
+	*/
+
+	allocator.BeginUpdate ();
+
+	CHECK (allocator.EndUpdate ());
+	CHECK (allocator.GetChanges ().empty ());
+	CHECK (allocator.GetRegions (0).empty ());
+
+	/*
+	 * The first brick, its parents on the coarse levels come first
+	*/
+
+	allocator.BeginUpdate ();
+	allocator.MarkRegion (glm::vec3 (0.0f), glm::vec3 (15.0f));
+
+	CHECK (allocator.EndUpdate ());
+	CHECK (allocator.GetAllocatedBricksCount () == 3);
+	CHECK (allocator.GetDroppedBricksCount () == 0);
+	CHECK (CountChanges (allocator, true) == 3);
+	CHECK (CountChanges (allocator, false) == 0);
+
+	CHECK (allocator.GetSlot (2, glm::ivec3 (0)) == 0);
+	CHECK (allocator.GetSlot (1, glm::ivec3 (0)) == 1);
+	CHECK (allocator.GetSlot (0, glm::ivec3 (0)) == 2);
+	CHECK (allocator.GetSlot (0, glm::ivec3 (1, 0, 0)) == VOXEL_BRICK_EMPTY);
+
+	/*
+	 * Out of the page tables
+	*/
+
+	CHECK (allocator.GetSlot (0, glm::ivec3 (-1, 0, 0)) == VOXEL_BRICK_EMPTY);
+	CHECK (allocator.GetSlot (0, glm::ivec3 (4, 0, 0)) == VOXEL_BRICK_EMPTY);
+	CHECK (allocator.GetSlot (TEST_LEVELS_COUNT, glm::ivec3 (0)) == VOXEL_BRICK_EMPTY);
+
+	/*
+	 * The same region again keeps its slots
+	*/
+
+	allocator.BeginUpdate ();
+	allocator.MarkRegion (glm::vec3 (0.0f), glm::vec3 (15.0f));
+
+	CHECK (allocator.EndUpdate ());
+	CHECK (allocator.GetChanges ().empty ());
+	CHECK (allocator.GetSlot (0, glm::ivec3 (0)) == 2);
+
+	/*
+	 * Two neighbour bricks on a row make a single region
+	*/
+
+	allocator.BeginUpdate ();
+	allocator.MarkRegion (glm::vec3 (0.0f), glm::vec3 (31.0f, 15.0f, 15.0f));
+
+	CHECK (allocator.EndUpdate ());
+	CHECK (allocator.GetAllocatedBricksCount () == 4);
+	CHECK (CountChanges (allocator, true) == 1);
+	CHECK (allocator.GetSlot (0, glm::ivec3 (0)) == 2);
+	CHECK (allocator.GetSlot (0, glm::ivec3 (1, 0, 0)) == 3);
+
+	std::vector<VoxelBrickRegion> regions = allocator.GetRegions (0);
+
+	CHECK (regions.size () == 1);
+	CHECK (regions [0].level == 0);
+	CHECK (regions [0].offset == glm::ivec3 (0));
+	CHECK (regions [0].size == glm::ivec3 (32, 16, 16));
+
+	regions = allocator.GetRegions (2);
+
+	CHECK (regions.size () == 1);
+	CHECK (regions [0].size == glm::ivec3 (16));
+
+	CHECK (allocator.GetRegions (TEST_LEVELS_COUNT).empty ());
+}
+
+/*
+ * A region outside of the volume is clamped to its border bricks
+*/
+
+static void TestClamping ()
+{
+	VoxelBrickAllocator allocator;
+	allocator.Init (TEST_VOLUME_SIZE, TEST_LEVELS_COUNT, glm::ivec3 (TEST_BRICK_SIZE), TEST_CAPACITY);
+
+	allocator.BeginUpdate ();
+	allocator.MarkRegion (glm::vec3 (-100.0f), glm::vec3 (-50.0f));
+	allocator.MarkRegion (glm::vec3 (1000.0f), glm::vec3 (2000.0f));
+
+	CHECK (allocator.EndUpdate ());
+	CHECK (allocator.GetSlot (0, glm::ivec3 (0)) != VOXEL_BRICK_EMPTY);
+	CHECK (allocator.GetSlot (0, glm::ivec3 (3)) != VOXEL_BRICK_EMPTY);
+	CHECK (allocator.GetSlot (1, glm::ivec3 (0)) != VOXEL_BRICK_EMPTY);
+	CHECK (allocator.GetSlot (1, glm::ivec3 (1)) != VOXEL_BRICK_EMPTY);
+	CHECK (allocator.GetAllocatedBricksCount () == 2 + 2 + 1);
+}
+
+/*
+ * A brick of the first level marks the same bricks as the region of its
+ * voxels
+*/
+
+static void TestBricks ()
+{
+	VoxelBrickAllocator regionAllocator;
+	regionAllocator.Init (TEST_VOLUME_SIZE, TEST_LEVELS_COUNT, glm::ivec3 (TEST_BRICK_SIZE), TEST_CAPACITY);
+
+	VoxelBrickAllocator brickAllocator;
+	brickAllocator.Init (TEST_VOLUME_SIZE, TEST_LEVELS_COUNT, glm::ivec3 (TEST_BRICK_SIZE), TEST_CAPACITY);
+
+	std::vector<glm::ivec3> bricks = { glm::ivec3 (0), glm::ivec3 (3, 1, 0), glm::ivec3 (2, 3, 3) };
+
+	regionAllocator.BeginUpdate ();
+	brickAllocator.BeginUpdate ();
+
+	for (const glm::ivec3& brick : bricks) {
+		glm::vec3 minVoxel = glm::vec3 (brick * TEST_BRICK_SIZE);
+
+		regionAllocator.MarkRegion (minVoxel, minVoxel + glm::vec3 (TEST_BRICK_SIZE - 1));
+		brickAllocator.MarkBrick (brick);
+	}
+
+	CHECK (regionAllocator.EndUpdate ());
+	CHECK (brickAllocator.EndUpdate ());
+	CHECK (brickAllocator.GetAllocatedBricksCount () == 3 + 3 + 1);
+	CHECK (brickAllocator.GetAllocatedBricksCount () == regionAllocator.GetAllocatedBricksCount ());
+
+	for (std::size_t level=0;level<TEST_LEVELS_COUNT;level++) {
+		glm::ivec3 bricksCount = brickAllocator.GetBricksCount (level);
+
+		for (int z=0;z<bricksCount.z;z++) {
+			for (int y=0;y<bricksCount.y;y++) {
+				for (int x=0;x<bricksCount.x;x++) {
+					glm::ivec3 position (x, y, z);
+
+					CHECK (brickAllocator.GetSlot (level, position) == regionAllocator.GetSlot (level, position));
+				}
+			}
+		}
+	}
+}
+
+/*
+ * Bricks that are not marked anymore give their slots to the new ones
+*/
+
+static void TestReuse ()
+{
+	VoxelBrickAllocator allocator;
+	allocator.Init (TEST_VOLUME_SIZE, TEST_LEVELS_COUNT, glm::ivec3 (TEST_BRICK_SIZE), TEST_CAPACITY);
+
+	allocator.BeginUpdate ();
+	allocator.MarkRegion (glm::vec3 (0.0f), glm::vec3 (15.0f));
+
+	CHECK (allocator.EndUpdate ());
+
+	/*
+	 * The region moves to the other end of the row, the last level
+	 * still holds it
+	*/
+
+	allocator.BeginUpdate ();
+	allocator.MarkRegion (glm::vec3 (48.0f, 0.0f, 0.0f), glm::vec3 (63.0f, 15.0f, 15.0f));
+
+	CHECK (allocator.EndUpdate ());
+	CHECK (allocator.GetAllocatedBricksCount () == 3);
+	CHECK (CountChanges (allocator, false) == 2);
+	CHECK (CountChanges (allocator, true) == 2);
+
+	CHECK (allocator.GetSlot (0, glm::ivec3 (0)) == VOXEL_BRICK_EMPTY);
+	CHECK (allocator.GetSlot (1, glm::ivec3 (0)) == VOXEL_BRICK_EMPTY);
+
+	CHECK (allocator.GetSlot (2, glm::ivec3 (0)) == 0);
+	CHECK (allocator.GetSlot (1, glm::ivec3 (1, 0, 0)) == 1);
+	CHECK (allocator.GetSlot (0, glm::ivec3 (3, 0, 0)) == 2);
+
+	for (const VoxelBrickChange& change : allocator.GetChanges ()) {
+		if (!change.isAllocated) {
+			CHECK (change.position == glm::ivec3 (0));
+		}
+	}
+
+	/*
+	 * An empty update frees everything
+	*/
+
+	allocator.BeginUpdate ();
+
+	CHECK (allocator.EndUpdate ());
+	CHECK (allocator.GetAllocatedBricksCount () == 0);
+	CHECK (CountChanges (allocator, false) == 3);
+	CHECK (allocator.GetRegions (0).empty ());
+}
+
+/*
+ * A full pool keeps the coarse levels and drops the rest
+*/
+
+static void TestCapacity ()
+{
+	VoxelBrickAllocator allocator;
+	allocator.Init (TEST_VOLUME_SIZE, TEST_LEVELS_COUNT, glm::ivec3 (TEST_BRICK_SIZE), 2);
+
+	allocator.BeginUpdate ();
+	allocator.MarkRegion (glm::vec3 (0.0f), glm::vec3 (15.0f));
+
+	CHECK (!allocator.EndUpdate ());
+	CHECK (allocator.GetDroppedBricksCount () == 1);
+	CHECK (allocator.GetAllocatedBricksCount () == 2);
+	CHECK (allocator.GetSlot (2, glm::ivec3 (0)) != VOXEL_BRICK_EMPTY);
+	CHECK (allocator.GetSlot (1, glm::ivec3 (0)) != VOXEL_BRICK_EMPTY);
+	CHECK (allocator.GetSlot (0, glm::ivec3 (0)) == VOXEL_BRICK_EMPTY);
+
+	/*
+	 * Nothing is released, the brick is dropped again
+	*/
+
+	allocator.BeginUpdate ();
+	allocator.MarkRegion (glm::vec3 (0.0f), glm::vec3 (15.0f));
+
+	CHECK (!allocator.EndUpdate ());
+	CHECK (allocator.GetChanges ().empty ());
+
+	/*
+	 * With a single slot, a brick fits once the last one is released
+	*/
+
+	allocator.Init (TEST_VOLUME_SIZE, 1, glm::ivec3 (TEST_BRICK_SIZE), 1);
+
+	allocator.BeginUpdate ();
+	allocator.MarkRegion (glm::vec3 (0.0f), glm::vec3 (15.0f));
+
+	CHECK (allocator.EndUpdate ());
+	CHECK (allocator.GetSlot (0, glm::ivec3 (0)) == 0);
+
+	allocator.BeginUpdate ();
+	allocator.MarkRegion (glm::vec3 (16.0f, 0.0f, 0.0f), glm::vec3 (31.0f, 15.0f, 15.0f));
+
+	CHECK (allocator.EndUpdate ());
+	CHECK (allocator.GetSlot (0, glm::ivec3 (0)) == VOXEL_BRICK_EMPTY);
+	CHECK (allocator.GetSlot (0, glm::ivec3 (1, 0, 0)) == 0);
+}
+
+int main ()
+{
+	TestAllocation ();
+	TestClamping ();
+	TestBricks ();
+	TestReuse ();
+	TestCapacity ();
+
+	return TestResult ("VoxelBrickAllocator");
+}
@@ -0,0 +1,202 @@
+#include <vector>
+#include <random>
+
+#include "RenderPasses/VoxelClipmapCascade.h"
+
+#include "TestCheck.h"
+
+/*
+ * Snapping of the cascade window and the slabs voxelized when it moves.
+ * The 64 voxels volume with 4 levels snaps on 8 voxels, a quarter of a
+ * world unit each.
+*/
+
+#define TEST_VOLUME_SIZE 64
+#define TEST_SNAP_SIZE 8
+#define TEST_MOVES_COUNT 200
+
+static void TestSnapping ()
+{
+	VoxelClipmapCascade cascade;
+	cascade.Init (VoxelVolumeConfiguration (TEST_VOLUME_SIZE, 4, 2, 16), 0);
+
+	CHECK (cascade.GetVoxelSize () == 0.25f);
+
+	cascade.Update (glm::vec3 (0.0f));
+
+	CHECK (cascade.IsFullUpdate ());
+	CHECK (cascade.GetUpdateVoxelsCount () == TEST_VOLUME_SIZE * TEST_VOLUME_SIZE * TEST_VOLUME_SIZE);
+	CHECK (cascade.GetOrigin () == glm::ivec3 (-32));
+	CHECK (cascade.GetMinVertex () == glm::vec3 (-8.0f));
+	CHECK (cascade.GetMaxVertex () == glm::vec3 (8.0f));
+	CHECK (cascade.GetTextureOffset () == glm::ivec3 (32));
+
+	/*
+	 * Inside the same snap cell nothing moves
+	*/
+
+	cascade.Update (glm::vec3 (1.99f, 0.5f, 1.0f));
+
+	CHECK (!cascade.IsFullUpdate ());
+	CHECK (cascade.GetUpdateRegions ().empty ());
+	CHECK (cascade.GetOrigin () == glm::ivec3 (-32));
+
+	/*
+	 * One snap forward on x enters a slab of 8 voxels, split where it
+	 * wraps on y and z
+	*/
+
+	cascade.Update (glm::vec3 (2.0f, 0.0f, 0.0f));
+
+	CHECK (!cascade.IsFullUpdate ());
+	CHECK (cascade.GetOrigin () == glm::ivec3 (-24, -32, -32));
+	CHECK (cascade.GetTextureOffset () == glm::ivec3 (40, 32, 32));
+	CHECK (cascade.GetUpdateVoxelsCount () == TEST_SNAP_SIZE * TEST_VOLUME_SIZE * TEST_VOLUME_SIZE);
+	CHECK (cascade.GetUpdateRegions ().size () == 4);
+
+	for (const VoxelBrickRegion& region : cascade.GetUpdateRegions ()) {
+		CHECK (region.offset.x == 32 && region.size.x == TEST_SNAP_SIZE);
+	}
+
+	/*
+	 * Negative coordinates snap down, not toward zero
+	*/
+
+	cascade.Update (glm::vec3 (-0.01f, 0.0f, 0.0f));
+
+	CHECK (cascade.GetOrigin () == glm::ivec3 (-40, -32, -32));
+	CHECK (cascade.GetUpdateVoxelsCount () == 2 * TEST_SNAP_SIZE * TEST_VOLUME_SIZE * TEST_VOLUME_SIZE);
+
+	/*
+	 * A jump over the whole window voxelizes all of it again
+	*/
+
+	cascade.Update (glm::vec3 (100.0f, 0.0f, 0.0f));
+
+	CHECK (cascade.IsFullUpdate ());
+	CHECK (cascade.GetUpdateRegions ().size () == 1);
+}
+
+/*
+ * Every texel keeps the window voxel it holds. After each move the
+ * texels of the update regions are voxelized again, then every texel
+ * has to hold the voxel of the new window that maps to it.
+*/
+
+static void TestMoves ()
+{
+	VoxelClipmapCascade cascade;
+	cascade.Init (VoxelVolumeConfiguration (TEST_VOLUME_SIZE, 4, 1, 16), 0);
+
+	const int size = TEST_VOLUME_SIZE;
+
+	std::vector<glm::ivec3> texels (size * size * size);
+	std::vector<int> updatesCount (size * size * size);
+
+	std::mt19937 generator (7);
+	std::uniform_real_distribution<float> step (-6.0f, 6.0f);
+
+	glm::vec3 center (0.0f);
+
+	for (std::size_t move = 0; move < TEST_MOVES_COUNT; move++) {
+		glm::ivec3 lastOrigin = cascade.GetOrigin ();
+
+		center += glm::vec3 (step (generator), step (generator), step (generator)) * (move % 10 == 0 ? 4.0f : 1.0f);
+
+		cascade.Update (center);
+
+		glm::ivec3 origin = cascade.GetOrigin ();
+		glm::ivec3 offset = glm::abs (origin - lastOrigin);
+
+		if (move > 0 && !cascade.IsFullUpdate ()) {
+			glm::ivec3 overlap = glm::ivec3 (size) - offset;
+
+			CHECK (cascade.GetUpdateVoxelsCount () == (std::size_t) (size * size * size - overlap.x * overlap.y * overlap.z));
+		}
+
+		std::fill (updatesCount.begin (), updatesCount.end (), 0);
+
+		for (const VoxelBrickRegion& region : cascade.GetUpdateRegions ()) {
+			CHECK (glm::all (glm::greaterThanEqual (region.offset, glm::ivec3 (0))));
+			CHECK (glm::all (glm::lessThanEqual (region.offset + region.size, glm::ivec3 (size))));
+
+			for (int x = region.offset.x; x < region.offset.x + region.size.x; x++) {
+				for (int y = region.offset.y; y < region.offset.y + region.size.y; y++) {
+					for (int z = region.offset.z; z < region.offset.z + region.size.z; z++) {
+						glm::ivec3 texel (x, y, z);
+						glm::ivec3 voxel = origin + (texel - origin % size + size) % size;
+
+						texels [(x * size + y) * size + z] = voxel;
+						updatesCount [(x * size + y) * size + z] ++;
+					}
+				}
+			}
+		}
+
+		bool isCovered = true;
+		bool isOverlapping = false;
+
+		for (int x = 0; x < size; x++) {
+			for (int y = 0; y < size; y++) {
+				for (int z = 0; z < size; z++) {
+					glm::ivec3 voxel = texels [(x * size + y) * size + z];
+
+					isCovered &= glm::all (glm::greaterThanEqual (voxel, origin)) &&
+						glm::all (glm::lessThan (voxel, origin + size)) &&
+						((voxel % size + size) % size) == glm::ivec3 (x, y, z);
+					isOverlapping |= updatesCount [(x * size + y) * size + z] > 1;
+				}
+			}
+		}
+
+		CHECK (isCovered);
+		CHECK (!isOverlapping);
+
+		/*
+		 * The texture offset is the texel of the first window voxel
+		*/
+
+		CHECK (texels [((cascade.GetTextureOffset ().x * size) + cascade.GetTextureOffset ().y) * size + cascade.GetTextureOffset ().z] == origin);
+	}
+}
+
+static void TestTextureRegions ()
+{
+	VoxelClipmapCascade cascade;
+	cascade.Init (VoxelVolumeConfiguration (TEST_VOLUME_SIZE, 4, 1, 16), 0);
+
+	cascade.Update (glm::vec3 (0.0f));
+
+	/*
+	 * Boxes are clamped to the window, an empty box has no regions
+	*/
+
+	CHECK (cascade.GetTextureRegions (glm::ivec3 (10), glm::ivec3 (10)).empty ());
+	CHECK (cascade.GetTextureRegions (glm::ivec3 (-20), glm::ivec3 (0)).empty ());
+
+	std::vector<VoxelBrickRegion> regions = cascade.GetTextureRegions (glm::ivec3 (-10), glm::ivec3 (100));
+
+	std::size_t voxelsCount = 0;
+
+	for (const VoxelBrickRegion& region : regions) {
+		voxelsCount += (std::size_t) region.size.x * region.size.y * region.size.z;
+	}
+
+	CHECK (regions.size () == 8);
+	CHECK (voxelsCount == TEST_VOLUME_SIZE * TEST_VOLUME_SIZE * TEST_VOLUME_SIZE);
+
+	regions = cascade.GetTextureRegions (glm::ivec3 (0), glm::ivec3 (4));
+
+	CHECK (regions.size () == 1);
+	CHECK (regions [0].offset == glm::ivec3 (32));
+	CHECK (regions [0].size == glm::ivec3 (4));
+}
+
+int main ()
+{
+	TestSnapping ();
+	TestMoves ();
+	TestTextureRegions ();
+
+	return TestResult ("VoxelClipmapCascade");
+}
\ No newline at end of file
@@ -0,0 +1,215 @@
+#include <vector>
+
+#include "RenderPasses/VoxelDirtyRegions.h"
+
+#include "TestCheck.h"
+
+/*
+ * Dirty boxes of a 64 voxels volume, in voxels of the first level with
+ * the maximum voxel exclusive
+*/
+
+#define TEST_VOLUME_SIZE 64
+
+static void TestEmpty ()
+{
+	VoxelDirtyRegions dirtyRegions;
+	dirtyRegions.Init (TEST_VOLUME_SIZE);
+
+	CHECK (dirtyRegions.IsEmpty ());
+	CHECK (!dirtyRegions.IsFull ());
+	CHECK (dirtyRegions.GetVoxelsCount () == 0);
+	CHECK (dirtyRegions.GetRegions (0).empty ());
+	CHECK (dirtyRegions.GetRegions (3, 1).empty ());
+
+	/*
+	 * Boxes with no voxel inside the volume add nothing
+	*/
+
+	dirtyRegions.AddRegion (glm::ivec3 (4), glm::ivec3 (4));
+	dirtyRegions.AddRegion (glm::ivec3 (8, 0, 0), glm::ivec3 (4, 8, 8));
+	dirtyRegions.AddRegion (glm::ivec3 (-20), glm::ivec3 (-10));
+	dirtyRegions.AddRegion (glm::ivec3 (64), glm::ivec3 (80));
+
+	CHECK (dirtyRegions.IsEmpty ());
+
+	dirtyRegions.AddRegion (glm::ivec3 (0), glm::ivec3 (8));
+	dirtyRegions.Clear ();
+
+	CHECK (dirtyRegions.IsEmpty ());
+	CHECK (!dirtyRegions.IsFull ());
+}
+
+static void TestClamping ()
+{
+	VoxelDirtyRegions dirtyRegions;
+	dirtyRegions.Init (TEST_VOLUME_SIZE);
+
+	dirtyRegions.AddRegion (glm::ivec3 (-8, 10, 60), glm::ivec3 (4, 12, 100));
+
+	std::vector<VoxelBrickRegion> regions = dirtyRegions.GetRegions (0);
+
+	CHECK (regions.size () == 1);
+	CHECK (regions [0].level == 0);
+	CHECK (regions [0].offset == glm::ivec3 (0, 10, 60));
+	CHECK (regions [0].size == glm::ivec3 (4, 2, 4));
+	CHECK (dirtyRegions.GetVoxelsCount () == 4 * 2 * 4);
+
+	/*
+	 * A box over the whole volume makes it full, later boxes are ignored
+	*/
+
+	dirtyRegions.AddRegion (glm::ivec3 (-100), glm::ivec3 (100));
+
+	CHECK (dirtyRegions.IsFull ());
+	CHECK (dirtyRegions.GetVoxelsCount () == TEST_VOLUME_SIZE * TEST_VOLUME_SIZE * TEST_VOLUME_SIZE);
+
+	dirtyRegions.AddRegion (glm::ivec3 (0), glm::ivec3 (8));
+
+	CHECK (dirtyRegions.GetRegions (0).size () == 1);
+
+	dirtyRegions.Clear ();
+	dirtyRegions.AddAll ();
+
+	CHECK (dirtyRegions.IsFull ());
+	CHECK (dirtyRegions.GetRegions (0).size () == 1);
+	CHECK (dirtyRegions.GetRegions (0) [0].size == glm::ivec3 (TEST_VOLUME_SIZE));
+}
+
+static void TestMerging ()
+{
+	VoxelDirtyRegions dirtyRegions;
+	dirtyRegions.Init (TEST_VOLUME_SIZE);
+
+	/*
+	 * Overlapping boxes become the box around them
+	*/
+
+	dirtyRegions.AddRegion (glm::ivec3 (0), glm::ivec3 (8));
+	dirtyRegions.AddRegion (glm::ivec3 (4), glm::ivec3 (12));
+
+	std::vector<VoxelBrickRegion> regions = dirtyRegions.GetRegions (0);
+
+	CHECK (regions.size () == 1);
+	CHECK (regions [0].offset == glm::ivec3 (0));
+	CHECK (regions [0].size == glm::ivec3 (12));
+
+	/*
+	 * Boxes that only touch are kept apart
+	*/
+
+	dirtyRegions.AddRegion (glm::ivec3 (12, 0, 0), glm::ivec3 (16, 4, 4));
+
+	CHECK (dirtyRegions.GetRegions (0).size () == 2);
+
+	/*
+	 * A box over both of them merges all three, the merge goes on until
+	 * no two boxes overlap
+	*/
+
+	dirtyRegions.AddRegion (glm::ivec3 (40), glm::ivec3 (48));
+	dirtyRegions.AddRegion (glm::ivec3 (10, 2, 2), glm::ivec3 (14, 3, 3));
+
+	regions = dirtyRegions.GetRegions (0);
+
+	CHECK (regions.size () == 2);
+	CHECK (regions [0].offset == glm::ivec3 (0));
+	CHECK (regions [0].size == glm::ivec3 (16, 12, 12));
+	CHECK (regions [1].offset == glm::ivec3 (40));
+	CHECK (regions [1].size == glm::ivec3 (8));
+	CHECK (!dirtyRegions.IsFull ());
+}
+
+/*
+ * Boxes of the mipmap levels grow outwards while halving, padding is
+ * added on the level and clamped to it
+*/
+
+static void TestLevels ()
+{
+	VoxelDirtyRegions dirtyRegions;
+	dirtyRegions.Init (TEST_VOLUME_SIZE);
+
+	dirtyRegions.AddRegion (glm::ivec3 (3, 0, 60), glm::ivec3 (9, 1, 64));
+
+	std::vector<VoxelBrickRegion> regions = dirtyRegions.GetRegions (1);
+
+	CHECK (regions.size () == 1);
+	CHECK (regions [0].level == 1);
+	CHECK (regions [0].offset == glm::ivec3 (1, 0, 30));
+	CHECK (regions [0].size == glm::ivec3 (4, 1, 2));
+
+	regions = dirtyRegions.GetRegions (2, 1);
+
+	CHECK (regions.size () == 1);
+	CHECK (regions [0].offset == glm::ivec3 (0, 0, 14));
+	CHECK (regions [0].size == glm::ivec3 (4, 2, 2));
+
+	/*
+	 * The last level is a single voxel
+	*/
+
+	regions = dirtyRegions.GetRegions (6, 2);
+
+	CHECK (regions.size () == 1);
+	CHECK (regions [0].offset == glm::ivec3 (0));
+	CHECK (regions [0].size == glm::ivec3 (1));
+
+	/*
+	 * Boxes that touch on the first level may overlap on a coarse one
+	*/
+
+	dirtyRegions.Clear ();
+	dirtyRegions.AddRegion (glm::ivec3 (0), glm::ivec3 (3));
+	dirtyRegions.AddRegion (glm::ivec3 (3), glm::ivec3 (7));
+
+	CHECK (dirtyRegions.GetRegions (0).size () == 2);
+	CHECK (dirtyRegions.GetRegions (1).size () == 1);
+	CHECK (dirtyRegions.GetRegions (1) [0].offset == glm::ivec3 (0));
+	CHECK (dirtyRegions.GetRegions (1) [0].size == glm::ivec3 (4));
+}
+
+static void TestIntersection ()
+{
+	VoxelBrickRegion first;
+	first.level = 1;
+	first.offset = glm::ivec3 (0);
+	first.size = glm::ivec3 (8);
+
+	VoxelBrickRegion second;
+	second.level = 1;
+	second.offset = glm::ivec3 (4, 6, -2);
+	second.size = glm::ivec3 (8);
+
+	VoxelBrickRegion result;
+
+	CHECK (VoxelDirtyRegions::Intersect (first, second, result));
+	CHECK (result.level == 1);
+	CHECK (result.offset == glm::ivec3 (4, 6, 0));
+	CHECK (result.size == glm::ivec3 (4, 2, 6));
+
+	second.offset = glm::ivec3 (8, 0, 0);
+
+	CHECK (!VoxelDirtyRegions::Intersect (first, second, result));
+
+	std::vector<VoxelBrickRegion> firstRegions (1, first);
+	std::vector<VoxelBrickRegion> secondRegions (1, second);
+
+	CHECK (VoxelDirtyRegions::Intersect (firstRegions, secondRegions).empty ());
+	CHECK (VoxelDirtyRegions::Intersect (firstRegions, std::vector<VoxelBrickRegion> ()).empty ());
+
+	secondRegions.push_back (first);
+
+	CHECK (VoxelDirtyRegions::Intersect (firstRegions, secondRegions).size () == 1);
+}
+
+int main ()
+{
+	TestEmpty ();
+	TestClamping ();
+	TestMerging ();
+	TestLevels ();
+	TestIntersection ();
+
+	return TestResult ("VoxelDirtyRegions");
+}
@@ -0,0 +1,160 @@
+#include <algorithm>
+
+#include "RenderPasses/VoxelVolumeConfiguration.h"
+#include "Settings/GeneralSettings.h"
+
+#include "TestCheck.h"
+
+/*
+ * Validation of the voxel volume sizes, as they come from the settings
+*/
+
+static void TestClamping ()
+{
+	VoxelVolumeConfiguration configuration (256, 6);
+
+	CHECK (configuration.volumeSize == 256);
+	CHECK (configuration.mipmapLevels == 6);
+	CHECK (configuration.clipmapCascades == 0);
+	CHECK (configuration.GetCascadesCount () == 1);
+
+	/*
+	 * Sizes are rounded down to a power of two, inside the limits
+	*/
+
+	CHECK (VoxelVolumeConfiguration (300, 1).volumeSize == 256);
+	CHECK (VoxelVolumeConfiguration (511, 1).volumeSize == 256);
+	CHECK (VoxelVolumeConfiguration (512, 1).volumeSize == 512);
+	CHECK (VoxelVolumeConfiguration (1, 1).volumeSize == VOXEL_VOLUME_MIN_SIZE);
+	CHECK (VoxelVolumeConfiguration (0, 1).volumeSize == VOXEL_VOLUME_MIN_SIZE);
+	CHECK (VoxelVolumeConfiguration (100000, 1).volumeSize == VOXEL_VOLUME_MAX_SIZE);
+
+	/*
+	 * The mipmap chain stops at one voxel, 64 has 7 levels
+	*/
+
+	CHECK (VoxelVolumeConfiguration (64, 0).mipmapLevels == 1);
+	CHECK (VoxelVolumeConfiguration (64, 7).mipmapLevels == 7);
+	CHECK (VoxelVolumeConfiguration (64, 20).mipmapLevels == 7);
+	CHECK (VoxelVolumeConfiguration (64, 20).GetLevelSize (6) == 1);
+	CHECK (VoxelVolumeConfiguration (64, 20).GetLevelSize (10) == 1);
+
+	CHECK (VoxelVolumeConfiguration (64, 1, 100).clipmapCascades == VOXEL_CLIPMAP_MAX_CASCADES);
+	CHECK (VoxelVolumeConfiguration (64, 1, 2, 0).clipmapExtent == 1);
+}
+
+static void TestSizes ()
+{
+	VoxelVolumeConfiguration configuration (64, 2, 3, 16);
+
+	CHECK (configuration.GetLevelSize (0) == 64);
+	CHECK (configuration.GetLevelSize (1) == 32);
+
+	CHECK (configuration.GetCascadeVoxelSize (0) == 0.25f);
+	CHECK (configuration.GetCascadeVoxelSize (2) == 1.0f);
+
+	CHECK (configuration.GetMemorySize () == (64 * 64 * 64 + 32 * 32 * 32) * 4 * 3);
+
+	CHECK (VoxelVolumeConfiguration::GetWorkGroupsCount (glm::ivec3 (1, 4, 5)) == glm::ivec3 (1, 1, 2));
+
+	CHECK (configuration == VoxelVolumeConfiguration (64, 2, 3, 16));
+	CHECK (configuration != VoxelVolumeConfiguration (64, 2, 2, 16));
+}
+
+/*
+ * Every supported size keeps its whole mipmap chain, one work group
+ * covers 4x4x4 voxels and the last levels still take one group
+*/
+
+static void TestSupportedSizes ()
+{
+	std::size_t sizesCount = 0;
+
+	for (std::size_t size = VOXEL_VOLUME_MIN_SIZE; size <= VOXEL_VOLUME_MAX_SIZE; size *= 2) {
+		VoxelVolumeConfiguration configuration (size, 100);
+
+		std::size_t levelsCount = 1;
+
+		while ((size >> levelsCount) > 0) {
+			levelsCount ++;
+		}
+
+		CHECK (configuration.volumeSize == size);
+		CHECK (configuration.mipmapLevels == levelsCount);
+		CHECK (configuration.GetLevelSize (levelsCount - 1) == 1);
+
+		for (std::size_t level = 0; level < configuration.mipmapLevels; level++) {
+			int levelSize = (int) configuration.GetLevelSize (level);
+
+			CHECK (levelSize == (int) (size >> level));
+
+			int groupsCount = std::max (levelSize / VOXEL_VOLUME_WORK_GROUP_SIZE, 1);
+
+			CHECK (VoxelVolumeConfiguration::GetWorkGroupsCount (glm::ivec3 (levelSize)) == glm::ivec3 (groupsCount));
+			CHECK (groupsCount * VOXEL_VOLUME_WORK_GROUP_SIZE >= levelSize);
+		}
+
+		sizesCount ++;
+	}
+
+	CHECK (sizesCount == 5);
+}
+
+/*
+ * Sizes the volume does not support never reach it, they end on the
+ * supported size below them or on the limits
+*/
+
+static void TestUnsupportedSizes ()
+{
+	for (std::size_t size = VOXEL_VOLUME_MIN_SIZE; size <= VOXEL_VOLUME_MAX_SIZE; size *= 2) {
+		CHECK (VoxelVolumeConfiguration (size + 1, 1).volumeSize == size);
+		CHECK (VoxelVolumeConfiguration (size + size / 2, 1).volumeSize == size);
+		CHECK (VoxelVolumeConfiguration (size * 2 - 1, 1).volumeSize == size);
+	}
+
+	CHECK (VoxelVolumeConfiguration (VOXEL_VOLUME_MIN_SIZE / 2, 1).volumeSize == VOXEL_VOLUME_MIN_SIZE);
+	CHECK (VoxelVolumeConfiguration (VOXEL_VOLUME_MIN_SIZE - 1, 1).volumeSize == VOXEL_VOLUME_MIN_SIZE);
+	CHECK (VoxelVolumeConfiguration (VOXEL_VOLUME_MAX_SIZE * 2, 1).volumeSize == VOXEL_VOLUME_MAX_SIZE);
+	CHECK (VoxelVolumeConfiguration (VOXEL_VOLUME_MAX_SIZE + 1, 1).volumeSize == VOXEL_VOLUME_MAX_SIZE);
+
+	/*
+	 * Dispatches of regions that are not multiples of the work group
+	 * round up
+	*/
+
+	CHECK (VoxelVolumeConfiguration::GetWorkGroupsCount (glm::ivec3 (1, 4, 5)) == glm::ivec3 (1, 1, 2));
+	CHECK (VoxelVolumeConfiguration::GetWorkGroupsCount (glm::ivec3 (3, 7, 9)) == glm::ivec3 (1, 2, 3));
+}
+
+static void TestFromSettings ()
+{
+	GeneralSettings* settings = GeneralSettings::Instance ();
+
+	CHECK (VoxelVolumeConfiguration::FromSettings () == VoxelVolumeConfiguration ());
+
+	settings->SetIntValue (VOXEL_VOLUME_SIZE_SETTING, -5);
+	settings->SetIntValue (VOXEL_VOLUME_MIPMAP_LEVELS_SETTING, 0);
+	settings->SetIntValue (VOXEL_CLIPMAP_CASCADES_SETTING, -1);
+	settings->SetIntValue (VOXEL_CLIPMAP_EXTENT_SETTING, -16);
+
+	CHECK (VoxelVolumeConfiguration::FromSettings () == VoxelVolumeConfiguration ());
+
+	settings->SetIntValue (VOXEL_VOLUME_SIZE_SETTING, 128);
+	settings->SetIntValue (VOXEL_VOLUME_MIPMAP_LEVELS_SETTING, 3);
+	settings->SetIntValue (VOXEL_CLIPMAP_CASCADES_SETTING, 2);
+	settings->SetIntValue (VOXEL_CLIPMAP_EXTENT_SETTING, 32);
+
+	CHECK (VoxelVolumeConfiguration::FromSettings () == VoxelVolumeConfiguration (128, 3, 2, 32));
+}
+
+int main ()
+{
+	TestClamping ();
+	TestSizes ();
+	TestSupportedSizes ();
+	TestUnsupportedSizes ();
+	TestFromSettings ();
+
+	return TestResult ("VoxelVolumeConfiguration");
+}
\ No newline at end of file
@@ -0,0 +1,415 @@
+#include <cstdio>
+#include <string>
+#include <fstream>
+#include <limits>
+#include <cctype>
+#include <algorithm>
+
+#include "Resources/WavefrontObjectLoader.h"
+#include "Mesh/Model.h"
+#include "Mesh/ObjectModel.h"
+#include "Mesh/PolygonGroup.h"
+
+#include "Utils/Triangulation/Triangulation.h"
+#include "Utils/Extensions/StringExtend.h"
+#include "Utils/Files/FileSystem.h"
+#include "Utils/Threads/JobSystem.h"
+
+#include "TestCheck.h"
+
+#include "../Benchmarks/WavefrontModelGenerator.h"
+
+/*
+ * The memory mapped loader, on one thread and on the job system, against
+ * the stream loader it replaced, which is kept here. Both must build the
+ * same model: attributes, objects, groups, materials and the indices of
+ * every polygon after triangulation.
+*/
+
+#define TEST_FILENAME "./WavefrontObjectLoaderTest.obj"
+#define TEST_WORKERS_COUNT 3
+
+/*
+ * The stream loader as it was, without loading the material libraries
+*/
+
+class StreamWavefrontLoader
+{
+public:
+	Model* Load (const std::string& filename)
+	{
+		Model* model = new Model ();
+
+		ObjectModel* currentObjModel = new ObjectModel ("DEFAULT");
+		PolygonGroup* currentPolyGroup = new PolygonGroup ("DEFAULT");
+
+		model->AddObjectModel (currentObjModel);
+		currentObjModel->AddPolygonGroup (currentPolyGroup);
+
+		std::string currentMatName, lineType;
+		bool indexNormalization = false;
+
+		std::ifstream objFile (filename.c_str ());
+
+		model->SetName (filename);
+
+		while (objFile >> lineType) {
+			if (lineType == "mtllib") {
+				std::string mtlfilename;
+				std::getline (objFile, mtlfilename);
+				Extensions::StringExtend::Trim (mtlfilename);
+
+				model->SetMaterialLibrary (FileSystem::FormatFilename (FileSystem::GetDirectory (filename) + mtlfilename));
+			}
+			else if (lineType == "v" || lineType == "vn") {
+				float x, y, z;
+				objFile >> x >> y >> z;
+
+				if (lineType == "v") {
+					model->AddVertex (glm::vec3 (x, y, z));
+				} else {
+					model->AddNormal (glm::vec3 (x, y, z));
+				}
+			}
+			else if (lineType == "vt") {
+				float x, y;
+				objFile >> x >> y;
+				objFile.ignore (std::numeric_limits<std::streamsize>::max (), '\n');
+
+				model->AddTexcoord (glm::vec3 (x, 1.0f - y, 0.0f));
+			}
+			else if (lineType == "usemtl") {
+				std::getline (objFile, currentMatName);
+				Extensions::StringExtend::Trim (currentMatName);
+			}
+			else if (lineType == "f") {
+				ReadFace (objFile, model, currentPolyGroup, indexNormalization, currentMatName);
+			}
+			else if (lineType == "o") {
+				std::string objName;
+				std::getline (objFile, objName);
+
+				currentObjModel = new ObjectModel (objName);
+				model->AddObjectModel (currentObjModel);
+
+				currentPolyGroup = new PolygonGroup ("DEFAULT");
+				currentObjModel->AddPolygonGroup (currentPolyGroup);
+			}
+			else if (lineType == "g") {
+				std::string polyName;
+				std::getline (objFile, polyName);
+
+				currentPolyGroup = new PolygonGroup (polyName);
+				currentObjModel->AddPolygonGroup (currentPolyGroup);
+			} else {
+				objFile.ignore (std::numeric_limits<std::streamsize>::max (), '\n');
+			}
+		}
+
+		if (indexNormalization) {
+			IndexNormalization (model);
+		}
+
+		model->GenerateMissingNormals ();
+
+		Triangulation::ConvexTriangulation (model);
+
+		return model;
+	}
+
+protected:
+	void ReadFace (std::ifstream& file, Model* model, PolygonGroup* currentPolyGroup, bool& indexNormalization, const std::string& curMatName)
+	{
+		std::string line;
+		std::getline (file, line);
+
+		Polygon* face = new Polygon ();
+
+		for (std::size_t i=0;i<line.size ();i++) {
+			if (!isdigit (line [i]) && line [i] != '-') {
+				continue;
+			}
+
+			int vertexPosition = 0, vertexTexturePosition = 0, vertexNormalPosition = 0;
+			int vertexSign = 1, uvSign = 1, normalSign = 1;
+
+			if (line [i] == '-') {
+				vertexSign = -1;
+				indexNormalization = true;
+				i ++;
+			}
+
+			for (;isdigit (line [i]);i++) {
+				vertexPosition = vertexPosition * 10 + line [i] - '0';
+			}
+
+			vertexPosition *= vertexSign;
+
+			if (line [i] == '/') {
+				i ++;
+
+				if (line [i] == '-') {
+					uvSign = -1;
+					indexNormalization = true;
+					++ i;
+				}
+
+				for (;isdigit (line [i]);i++) {
+					vertexTexturePosition = vertexTexturePosition * 10 + line [i] - '0';
+				}
+
+				vertexTexturePosition *= uvSign;
+
+				if (line [i] == '/') {
+					i ++;
+
+					if (line [i] == '-') {
+						normalSign = -1;
+						indexNormalization = true;
+						++ i;
+					}
+
+					for (;isdigit (line [i]);i++) {
+						vertexNormalPosition = vertexNormalPosition * 10 + line [i] - '0';
+					}
+
+					vertexNormalPosition *= normalSign;
+				}
+			}
+
+			face->AddVertex (vertexPosition - 1);
+
+			if (vertexNormalPosition != 0) {
+				face->AddNormal (vertexNormalPosition - 1);
+			}
+
+			if (vertexTexturePosition != 0) {
+				face->AddTexcoord (vertexTexturePosition - 1);
+			}
+		}
+
+		currentPolyGroup->SetMaterialName (model->GetMaterialLibrary () + "::" + curMatName);
+
+		currentPolyGroup->AddPolygon (face);
+	}
+
+	void IndexNormalization (Model* model)
+	{
+		for (std::size_t i=0;i<model->ObjectsCount ();i++) {
+			ObjectModel* object = model->GetObject (i);
+
+			for (std::size_t j=0;j<object->GetPolygonCount ();j++) {
+				PolygonGroup* polyGroup = object->GetPolygonGroup (j);
+
+				for (std::size_t k=0;k<polyGroup->GetPolygonCount ();k++) {
+					Polygon* poly = polyGroup->GetPolygon (k);
+
+					for (std::size_t l=0;l<poly->VertexCount ();l++) {
+						if (poly->GetVertex (l) < 0) {
+							poly->SetVertex ((int) model->VertexCount () + poly->GetVertex (l) + 1, l);
+						}
+
+						if (poly->HaveNormals () && poly->GetNormal (l) < 0) {
+							poly->SetNormal ((int) model->NormalsCount () + poly->GetNormal (l) + 1, l);
+						}
+
+						if (poly->HaveUV () && poly->GetTexcoord (l) < 0) {
+							poly->SetTexcoord ((int) model->TexcoordsCount () + poly->GetTexcoord (l) + 1, l);
+						}
+					}
+				}
+			}
+		}
+	}
+};
+
+static bool CompareGroups (PolygonGroup* first, PolygonGroup* second)
+{
+	if (first->GetName () != second->GetName () ||
+		first->GetMaterialName () != second->GetMaterialName () ||
+		first->GetPolygonCount () != second->GetPolygonCount ()) {
+		return false;
+	}
+
+	for (std::size_t i=0;i<first->GetPolygonCount ();i++) {
+		for (std::size_t j=0;j<Polygon::ATTRIBUTES_COUNT;j++) {
+			Polygon::PolygonAttribute attribute = (Polygon::PolygonAttribute) j;
+
+			std::size_t indicesCount = first->GetPolygon (i)->GetIndicesCount (attribute);
+
+			if (indicesCount != second->GetPolygon (i)->GetIndicesCount (attribute)) {
+				return false;
+			}
+
+			const int* firstIndices = first->GetPolygon (i)->GetIndices (attribute);
+			const int* secondIndices = second->GetPolygon (i)->GetIndices (attribute);
+
+			if (!std::equal (firstIndices, firstIndices + indicesCount, secondIndices)) {
+				return false;
+			}
+		}
+	}
+
+	return true;
+}
+
+/*
+ * Values are compared exactly, the float parsing of the mapped loader
+ * gives the same values as the stream
+*/
+
+static bool CompareModels (Model* first, Model* second)
+{
+	if (first->GetVertices () != second->GetVertices () ||
+		first->GetNormals () != second->GetNormals () ||
+		first->GetTexcoords () != second->GetTexcoords () ||
+		first->GetMaterialLibrary () != second->GetMaterialLibrary () ||
+		first->ObjectsCount () != second->ObjectsCount ()) {
+		return false;
+	}
+
+	for (std::size_t i=0;i<first->ObjectsCount ();i++) {
+		ObjectModel* firstObject = first->GetObject (i);
+		ObjectModel* secondObject = second->GetObject (i);
+
+		if (firstObject->GetName () != secondObject->GetName () ||
+			firstObject->GetPolygonCount () != secondObject->GetPolygonCount ()) {
+			return false;
+		}
+
+		for (std::size_t j=0;j<firstObject->GetPolygonCount ();j++) {
+			if (!CompareGroups (firstObject->GetPolygonGroup (j), secondObject->GetPolygonGroup (j))) {
+				return false;
+			}
+		}
+	}
+
+	return true;
+}
+
+static bool CompareLoaders (const std::string& filename)
+{
+	StreamWavefrontLoader streamLoader;
+	Model* expected = streamLoader.Load (filename);
+
+	WavefrontObjectLoader loader;
+	loader.SetLoadMaterials (false);
+
+	Model* model = (Model*) loader.Load (filename);
+
+	bool isEqual = CompareModels (expected, model);
+
+	delete expected;
+	delete model;
+
+	return isEqual;
+}
+
+static bool CompareLoaders (const char* content)
+{
+	std::ofstream stream (TEST_FILENAME, std::ios::binary);
+	stream << content;
+	stream.close ();
+
+	return CompareLoaders (std::string (TEST_FILENAME));
+}
+
+static void TestGeneratedModel ()
+{
+	GenerateWavefrontModel (TEST_FILENAME);
+
+	CHECK (CompareLoaders (std::string (TEST_FILENAME)));
+
+	/*
+	 * Split in chunks parsed by the workers
+	*/
+
+	JobSystem::Instance ()->Start (TEST_WORKERS_COUNT);
+
+	CHECK (CompareLoaders (std::string (TEST_FILENAME)));
+
+	JobSystem::Instance ()->Stop ();
+}
+
+/*
+ * Negative indices count back from the last attribute read
+*/
+
+static void TestNegativeIndices ()
+{
+	CHECK (CompareLoaders (
+		"o first\n"
+		"v 0 0 0\nv 1 0 0\nv 1 1 0\nv 0 1 0\n"
+		"vt 0 0\nvt 1 0\nvt 1 1\nvt 0 1\n"
+		"vn 0 0 1\n"
+		"f 1/1/1 2/2/1 3/3/1 4/4/1\n"
+		"o second\n"
+		"v 0 0 1\nv 1 0 1\nv 1 1 1\n"
+		"vn 0 1 0\n"
+		"f -3/-4/-1 -2/-3/-1 -1/-2/-1\n"
+		"f -1 -2 -7\n"));
+}
+
+/*
+ * Corners without texcoords, without normals or with positions only
+*/
+
+static void TestMissingAttributes ()
+{
+	CHECK (CompareLoaders (
+		"v 0 0 0\nv 1 0 0\nv 1 1 0\nv 0 1 0\nv 0.5 2 0\n"
+		"vt 0 0\nvt 1 0\nvt 1 1\n"
+		"vn 0 0 1\nvn 0 0 -1\n"
+		"g normals\n"
+		"f 1//1 2//1 3//1 4//1\n"
+		"f 3//2 2//2 1//2\n"
+		"g texcoords\n"
+		"f 1/1 2/2 3/3\n"
+		"g positions\n"
+		"f 1 2 3 4 5\n"));
+}
+
+static void TestMissingLastNewline ()
+{
+	CHECK (CompareLoaders (
+		"# no line end after the last face\n"
+		"v 0 0 0\nv 1 0 0\nv 1 1 0\n"
+		"vn 0 0 1\n"
+		"usemtl last\n"
+		"f 1//1 2//1 3//1"));
+}
+
+/*
+ * Windows line ends, the names keep their carriage return in both
+*/
+
+static void TestCarriageReturns ()
+{
+	CHECK (CompareLoaders (
+		"# exported on windows\r\n"
+		"mtllib materials.mtl\r\n"
+		"o box\r\n"
+		"v -1.5 0 2e-1\r\nv 1.5 0 0.2\r\nv 1.5 3 0.2\r\nv -1.5 3 0.2\r\n"
+		"vt 0 0\r\nvt 1 0 0\r\nvt 1 1\r\nvt 0 1\r\n"
+		"vn 0 0 1\r\n"
+		"\r\n"
+		"g front\r\n"
+		"usemtl wood\r\n"
+		"f 1/1/1 2/2/1 3/3/1 4/4/1\r\n"
+		"g back\r\n"
+		"usemtl metal\r\n"
+		"f 4/4/1 3/3/1 2/2/1\r\n"));
+}
+
+int main ()
+{
+	TestGeneratedModel ();
+	TestNegativeIndices ();
+	TestMissingAttributes ();
+	TestMissingLastNewline ();
+	TestCarriageReturns ();
+
+	std::remove (TEST_FILENAME);
+
+	return TestResult ("WavefrontObjectLoader");
+}